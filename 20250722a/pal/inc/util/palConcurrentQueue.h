@@ -0,0 +1,1041 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palConcurrentQueue.h
+ * @brief PAL utility collection ConcurrentQueue and SegmentedConcurrentQueue class declarations.
+ ***********************************************************************************************************************
+ */
+
+#pragma once
+
+#include "palEvent.h"
+#include "palInlineFuncs.h"
+#include "palMutex.h"
+#include "palSysMemory.h"
+#include <atomic>
+#include <chrono>
+
+namespace Util
+{
+
+/**
+ ***********************************************************************************************************************
+ * @internal Lets consumers of a concurrent queue sleep on an Event until a producer publishes an element.
+ *
+ * Producers only touch the Event when a consumer is actually waiting, so the common non-blocking path costs one fence
+ * and one load.
+ ***********************************************************************************************************************
+ */
+class ConcurrentQueueWaiter
+{
+public:
+    ConcurrentQueueWaiter() : m_numWaiters(0) { }
+
+    /// Initializes the underlying auto-reset Event.
+    Result Init()
+    {
+        EventCreateFlags flags = {};
+        return m_event.Init(flags);
+    }
+
+    /// Called by producers after publishing one or more elements.
+    void Notify()
+    {
+        // Orders the publication before the waiter check.  Pairs with the fence in Wait().
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_numWaiters.load(std::memory_order_relaxed) != 0)
+        {
+            m_event.Set();
+        }
+    }
+
+    /// Calls tryFunc until it returns something other than NotReady, sleeping on the Event in between.
+    ///
+    /// @returns The last result of tryFunc, or Timeout if it still returned NotReady after timeout seconds.
+    template<typename TryFunc>
+    Result Wait(TryFunc tryFunc, fseconds timeout);
+
+private:
+    Event               m_event;
+    std::atomic<uint32> m_numWaiters;
+
+    PAL_DISALLOW_COPY_AND_ASSIGN(ConcurrentQueueWaiter);
+};
+
+// =====================================================================================================================
+template<typename TryFunc>
+Result ConcurrentQueueWaiter::Wait(
+    TryFunc  tryFunc,
+    fseconds timeout)
+{
+    Result result = tryFunc();
+
+    if (result == Result::NotReady)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        m_numWaiters.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        while (true)
+        {
+            // A producer that published before our increment was visible did not set the event, so always retry
+            // before sleeping.
+            result = tryFunc();
+            if (result != Result::NotReady)
+            {
+                break;
+            }
+
+            const fseconds elapsed =
+                std::chrono::duration_cast<fseconds>(std::chrono::steady_clock::now() - start);
+            if (elapsed >= timeout)
+            {
+                result = Result::Timeout;
+                break;
+            }
+            m_event.Wait(timeout - elapsed);
+        }
+
+        // Several publications can collapse into one Set(), so pass the wakeup on while others are still waiting.
+        if ((m_numWaiters.fetch_sub(1, std::memory_order_seq_cst) > 1) && (result == Result::Success))
+        {
+            m_event.Set();
+        }
+    }
+
+    return result;
+}
+
+/**
+ ***********************************************************************************************************************
+ * @brief  Bounded multi-producer, multi-consumer FIFO queue.
+ *
+ * A ring of power-of-two capacity in which every slot carries a sequence number.  A slot whose sequence equals the
+ * position a producer wants to write is free, and one whose sequence is one past the position a consumer wants to read
+ * holds a published element.  Producers and consumers claim positions with a single compare-and-swap on their own
+ * cache line, so they only contend with threads on the same side of the queue.
+ *
+ * Batch operations claim a run of consecutive slots with one compare-and-swap.  Pop() blocks on a Util::Event until an
+ * element arrives or the timeout expires.
+ *
+ * All members except Init() and the destructor are safe to call concurrently.  Elements are moved in and out, so T must
+ * be move-constructible.
+ ***********************************************************************************************************************
+ */
+template<typename T, typename Allocator>
+class ConcurrentQueue
+{
+public:
+    /// Constructor.
+    ///
+    /// @param [in] pAllocator The allocator that will allocate memory if required.
+    explicit ConcurrentQueue(Allocator*const pAllocator);
+    ~ConcurrentQueue();
+
+    /// Allocates the ring.  Must be called once before any other member.
+    ///
+    /// @param [in] capacity Minimum number of elements the queue can hold; rounded up to a power of two.
+    ///
+    /// @returns @ref Success, or @ref ErrorOutOfMemory if the ring could not be allocated.
+    Result Init(uint32 capacity);
+
+    /// Returns the number of elements the queue can hold.
+    uint32 Capacity() const { return static_cast<uint32>(m_mask + 1); }
+
+    ///@{
+    /// Pushes an item onto the back of the queue without blocking.
+    ///
+    /// @returns @ref Success, or @ref NotReady if the queue is full.
+    Result TryPush(const T& data) { return Emplace(data); }
+    Result TryPush(T&& data)      { return Emplace(Move(data)); }
+    ///@}
+
+    /// Pushes up to count items from pData onto the back of the queue without blocking.  The items pushed are
+    /// consecutive in the queue.
+    ///
+    /// @returns The number of items pushed, which is less than count if the queue filled up.
+    uint32 TryPushBatch(const T* pData, uint32 count);
+
+    /// Pops the item at the front of the queue without blocking.
+    ///
+    /// @returns @ref Success, or @ref NotReady if the queue is empty.
+    Result TryPop(T* pOut);
+
+    /// Pops up to count consecutive items from the front of the queue into pOut without blocking.
+    ///
+    /// @returns The number of items popped.
+    uint32 TryPopBatch(T* pOut, uint32 count);
+
+    /// Pops the item at the front of the queue, waiting up to timeout seconds for one to be pushed.
+    ///
+    /// @returns @ref Success, or @ref Timeout if the queue stayed empty.
+    Result Pop(T* pOut, fseconds timeout)
+        { return m_waiter.Wait([this, pOut]() { return TryPop(pOut); }, timeout); }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        alignas(T) uint8    storage[sizeof(T)];
+
+        T* Data() { return reinterpret_cast<T*>(&storage[0]); }
+    };
+
+    template<typename U>
+    Result Emplace(U&& data);
+
+    // Looks for up to count slots from pos on whose sequence is pos + offset + i.  Returns how many were found, or 0
+    // with *pStale set if pos is behind another thread and must be reloaded.
+    uint32 ScanSlots(size_t pos, size_t offset, uint32 count, bool* pStale) const;
+
+    Slot*                                     m_pSlots;
+    size_t                                    m_mask;
+    Allocator*const                           m_pAllocator;
+
+    alignas(PAL_CACHE_LINE_BYTES) std::atomic<size_t> m_pushPos; // Next position producers claim.
+    alignas(PAL_CACHE_LINE_BYTES) std::atomic<size_t> m_popPos;  // Next position consumers claim.
+    alignas(PAL_CACHE_LINE_BYTES) ConcurrentQueueWaiter m_waiter;
+
+    PAL_DISALLOW_COPY_AND_ASSIGN(ConcurrentQueue);
+};
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+ConcurrentQueue<T, Allocator>::ConcurrentQueue(
+    Allocator*const pAllocator)
+    :
+    m_pSlots(nullptr),
+    m_mask(0),
+    m_pAllocator(pAllocator),
+    m_pushPos(0),
+    m_popPos(0)
+{
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+ConcurrentQueue<T, Allocator>::~ConcurrentQueue()
+{
+    if (m_pSlots != nullptr)
+    {
+        if (std::is_trivially_destructible<T>::value == false)
+        {
+            const size_t end = m_pushPos.load(std::memory_order_relaxed);
+            for (size_t pos = m_popPos.load(std::memory_order_relaxed); pos != end; ++pos)
+            {
+                m_pSlots[pos & m_mask].Data()->~T();
+            }
+        }
+        PAL_SAFE_FREE(m_pSlots, m_pAllocator);
+    }
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+Result ConcurrentQueue<T, Allocator>::Init(
+    uint32 capacity)
+{
+    PAL_ASSERT(m_pSlots == nullptr);
+
+    const size_t numSlots = Pow2Pad(Max(capacity, 2u));
+    m_pSlots = static_cast<Slot*>(PAL_MALLOC_ALIGNED(numSlots * sizeof(Slot),
+                                                     Max(alignof(Slot), size_t(PAL_CACHE_LINE_BYTES)),
+                                                     m_pAllocator,
+                                                     AllocInternal));
+
+    Result result = Result::ErrorOutOfMemory;
+    if (m_pSlots != nullptr)
+    {
+        for (size_t i = 0; i < numSlots; ++i)
+        {
+            PAL_PLACEMENT_NEW(&m_pSlots[i].sequence) std::atomic<size_t>(i);
+        }
+        m_mask = numSlots - 1;
+        result = m_waiter.Init();
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+template<typename U>
+Result ConcurrentQueue<T, Allocator>::Emplace(
+    U&& data)
+{
+    size_t pos  = m_pushPos.load(std::memory_order_relaxed);
+    Slot* pSlot = nullptr;
+
+    while (true)
+    {
+        pSlot = &m_pSlots[pos & m_mask];
+        const size_t   sequence = pSlot->sequence.load(std::memory_order_acquire);
+        const intptr_t diff     = static_cast<intptr_t>(sequence - pos);
+
+        if (diff == 0)
+        {
+            if (m_pushPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // The slot still holds the element from one lap ago: the queue is full.
+            return Result::NotReady;
+        }
+        else
+        {
+            pos = m_pushPos.load(std::memory_order_relaxed);
+        }
+    }
+
+    PAL_PLACEMENT_NEW(pSlot->Data()) T(static_cast<U&&>(data));
+    pSlot->sequence.store(pos + 1, std::memory_order_release);
+    m_waiter.Notify();
+
+    return Result::Success;
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+uint32 ConcurrentQueue<T, Allocator>::ScanSlots(
+    size_t pos,
+    size_t offset,
+    uint32 count,
+    bool*  pStale
+    ) const
+{
+    uint32 found = 0;
+    *pStale      = false;
+
+    while (found < count)
+    {
+        const size_t   sequence = m_pSlots[(pos + found) & m_mask].sequence.load(std::memory_order_acquire);
+        const intptr_t diff     = static_cast<intptr_t>(sequence - (pos + found + offset));
+
+        if (diff != 0)
+        {
+            // A slot ahead of what we expected means another thread already claimed pos.
+            *pStale = (found == 0) && (diff > 0);
+            break;
+        }
+        ++found;
+    }
+
+    return found;
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+uint32 ConcurrentQueue<T, Allocator>::TryPushBatch(
+    const T* pData,
+    uint32   count)
+{
+    size_t pos   = m_pushPos.load(std::memory_order_relaxed);
+    uint32 found = 0;
+
+    while (count > 0)
+    {
+        bool stale = false;
+        found = ScanSlots(pos, 0, Min(count, Capacity()), &stale);
+
+        if (stale)
+        {
+            pos = m_pushPos.load(std::memory_order_relaxed);
+        }
+        else if ((found == 0) ||
+                 m_pushPos.compare_exchange_weak(pos, pos + found, std::memory_order_relaxed))
+        {
+            // Winning the compare-and-swap makes every scanned slot ours: other producers can only claim positions
+            // past pos + found, and consumers cannot read a slot before we publish it.
+            break;
+        }
+    }
+
+    for (uint32 i = 0; i < found; ++i)
+    {
+        Slot*const pSlot = &m_pSlots[(pos + i) & m_mask];
+        PAL_PLACEMENT_NEW(pSlot->Data()) T(pData[i]);
+        pSlot->sequence.store(pos + i + 1, std::memory_order_release);
+    }
+
+    if (found > 0)
+    {
+        m_waiter.Notify();
+    }
+
+    return found;
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+Result ConcurrentQueue<T, Allocator>::TryPop(
+    T* pOut)
+{
+    size_t pos  = m_popPos.load(std::memory_order_relaxed);
+    Slot* pSlot = nullptr;
+
+    while (true)
+    {
+        pSlot = &m_pSlots[pos & m_mask];
+        const size_t   sequence = pSlot->sequence.load(std::memory_order_acquire);
+        const intptr_t diff     = static_cast<intptr_t>(sequence - (pos + 1));
+
+        if (diff == 0)
+        {
+            if (m_popPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // Nothing has been published at pos yet: the queue is empty.
+            return Result::NotReady;
+        }
+        else
+        {
+            pos = m_popPos.load(std::memory_order_relaxed);
+        }
+    }
+
+    *pOut = Move(*pSlot->Data());
+    pSlot->Data()->~T();
+    pSlot->sequence.store(pos + m_mask + 1, std::memory_order_release);
+
+    return Result::Success;
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+uint32 ConcurrentQueue<T, Allocator>::TryPopBatch(
+    T*     pOut,
+    uint32 count)
+{
+    size_t pos   = m_popPos.load(std::memory_order_relaxed);
+    uint32 found = 0;
+
+    while (count > 0)
+    {
+        bool stale = false;
+        found = ScanSlots(pos, 1, Min(count, Capacity()), &stale);
+
+        if (stale)
+        {
+            pos = m_popPos.load(std::memory_order_relaxed);
+        }
+        else if ((found == 0) ||
+                 m_popPos.compare_exchange_weak(pos, pos + found, std::memory_order_relaxed))
+        {
+            break;
+        }
+    }
+
+    for (uint32 i = 0; i < found; ++i)
+    {
+        Slot*const pSlot = &m_pSlots[(pos + i) & m_mask];
+        pOut[i] = Move(*pSlot->Data());
+        pSlot->Data()->~T();
+        pSlot->sequence.store(pos + i + m_mask + 1, std::memory_order_release);
+    }
+
+    return found;
+}
+
+/**
+ ***********************************************************************************************************************
+ * @brief  Unbounded multi-producer, multi-consumer FIFO queue.
+ *
+ * Like Deque, elements live in a linked list of blocks that hold numElementsPerBlock elements each.  Producers claim a
+ * slot in the tail block with one fetch-and-add and link a new block once it fills up; consumers claim slots in the
+ * head block with a compare-and-swap and retire the block once every slot has been taken.  Each slot has its own ready
+ * flag and consumers only claim slots that are already published, so a consumer never waits on a producer that is
+ * still writing.
+ *
+ * Retired blocks may still be referenced by threads that loaded the head or tail pointer before the block was unlinked,
+ * so they are reclaimed with a two-epoch scheme: every operation registers itself in the current epoch, and a block
+ * retired in epoch e is only released once the epoch has reached e + 2, i.e. once no operation that might have seen it
+ * is still running.  Up to maxPooledBlocks released blocks are kept for reuse instead of being freed.
+ *
+ * All members except Init() and the destructor are safe to call concurrently.
+ ***********************************************************************************************************************
+ */
+template<typename T, typename Allocator>
+class SegmentedConcurrentQueue
+{
+public:
+    /// Constructor.
+    ///
+    /// @param [in] pAllocator          The allocator that will allocate memory if required.
+    /// @param [in] numElementsPerBlock Number of elements in each block.
+    /// @param [in] maxPooledBlocks     Number of released blocks kept for reuse.
+    SegmentedConcurrentQueue(Allocator*const pAllocator, uint32 numElementsPerBlock = 256, uint32 maxPooledBlocks = 4);
+    ~SegmentedConcurrentQueue();
+
+    /// Allocates the first block.  Must be called once before any other member.
+    ///
+    /// @returns @ref Success, or @ref ErrorOutOfMemory if the block could not be allocated.
+    Result Init();
+
+    ///@{
+    /// Pushes an item onto the back of the queue.
+    ///
+    /// @returns @ref Success, or @ref ErrorOutOfMemory if a new block was needed but could not be allocated.
+    Result Push(const T& data) { return Emplace(data); }
+    Result Push(T&& data)      { return Emplace(Move(data)); }
+    ///@}
+
+    /// Pushes count items from pData onto the back of the queue.  Each block the batch lands in is claimed with a
+    /// single fetch-and-add, but the batch may be interleaved with items from other producers at block boundaries.
+    ///
+    /// @returns @ref Success, or @ref ErrorOutOfMemory if not all items could be pushed.
+    Result PushBatch(const T* pData, uint32 count);
+
+    /// Pops the item at the front of the queue without blocking.
+    ///
+    /// @returns @ref Success, or @ref NotReady if the queue is empty.
+    Result TryPop(T* pOut);
+
+    /// Pops up to count items from the front of the queue into pOut without blocking.
+    ///
+    /// @returns The number of items popped.
+    uint32 TryPopBatch(T* pOut, uint32 count);
+
+    /// Pops the item at the front of the queue, waiting up to timeout seconds for one to be pushed.
+    ///
+    /// @returns @ref Success, or @ref Timeout if the queue stayed empty.
+    Result Pop(T* pOut, fseconds timeout)
+        { return m_waiter.Wait([this, pOut]() { return TryPop(pOut); }, timeout); }
+
+private:
+    struct Slot
+    {
+        std::atomic<uint32> ready;
+        alignas(T) uint8    storage[sizeof(T)];
+
+        T* Data() { return reinterpret_cast<T*>(&storage[0]); }
+    };
+
+    // Each block is a single allocation: this header followed by m_numElementsPerBlock slots.
+    struct Block
+    {
+        std::atomic<Block*> pNext;
+        std::atomic<uint32> pushIndex;   // Next slot producers claim; may overshoot the block size.
+        std::atomic<uint32> popIndex;    // Next slot consumers claim; never passes the block size.
+        Block*              pNextFree;   // Link in the retired or pooled list.
+        uint64              retireEpoch;
+
+        Slot* Slots() { return reinterpret_cast<Slot*>(VoidPtrInc(this, SlotsOffset)); }
+    };
+
+    static constexpr size_t SlotsOffset = Pow2Align(sizeof(Block), alignof(Slot));
+
+    template<typename U>
+    Result Emplace(U&& data);
+
+    // Claims up to count slots in the tail block, linking a new tail if it is full.  Returns the block and first index,
+    // or a null block if a new one could not be allocated.
+    Block* ClaimPushSlots(uint32 count, uint32* pFirst, uint32* pClaimed);
+
+    // Claims up to count published slots in the head block, retiring the block once all of its slots are claimed.
+    Block* ClaimPopSlots(uint32 count, uint32* pFirst, uint32* pClaimed);
+
+    uint64 EnterEpoch();
+    void   ExitEpoch(uint64 epoch) { m_activeOps[epoch & 1].fetch_sub(1, std::memory_order_release); }
+
+    Block* AllocateBlock();
+    void   RetireBlock(Block* pBlock);
+    void   ReleaseBlock(Block* pBlock);
+    void   Reclaim();
+
+    Allocator*const                     m_pAllocator;
+    const uint32                        m_numElementsPerBlock;
+    const uint32                        m_maxPooledBlocks;
+
+    alignas(PAL_CACHE_LINE_BYTES) std::atomic<Block*> m_pHead;
+    alignas(PAL_CACHE_LINE_BYTES) std::atomic<Block*> m_pTail;
+
+    alignas(PAL_CACHE_LINE_BYTES) std::atomic<uint64> m_epoch;
+    std::atomic<uint32>                 m_activeOps[2];    // Operations in flight, by epoch parity.
+
+    Mutex                               m_reclaimLock;     // Guards the lists below.
+    Block*                              m_pRetiredBlocks;  // Unlinked blocks waiting for their epoch to expire,
+    Block*                              m_pRetiredTail;    // oldest first.
+    Block*                              m_pPooledBlocks;   // Released blocks kept for reuse.
+    uint32                              m_numPooledBlocks;
+
+    alignas(PAL_CACHE_LINE_BYTES) ConcurrentQueueWaiter m_waiter;
+
+    PAL_DISALLOW_COPY_AND_ASSIGN(SegmentedConcurrentQueue);
+};
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+SegmentedConcurrentQueue<T, Allocator>::SegmentedConcurrentQueue(
+    Allocator*const pAllocator,
+    uint32          numElementsPerBlock,
+    uint32          maxPooledBlocks)
+    :
+    m_pAllocator(pAllocator),
+    m_numElementsPerBlock(Max(numElementsPerBlock, 1u)),
+    m_maxPooledBlocks(maxPooledBlocks),
+    m_pHead(nullptr),
+    m_pTail(nullptr),
+    m_epoch(0),
+    m_activeOps{},
+    m_pRetiredBlocks(nullptr),
+    m_pRetiredTail(nullptr),
+    m_pPooledBlocks(nullptr),
+    m_numPooledBlocks(0)
+{
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+SegmentedConcurrentQueue<T, Allocator>::~SegmentedConcurrentQueue()
+{
+    // No operation may be in flight, so every block can be released directly.
+    Block* pBlock = m_pHead.load(std::memory_order_relaxed);
+    while (pBlock != nullptr)
+    {
+        Block*const pNext = pBlock->pNext.load(std::memory_order_relaxed);
+
+        if (std::is_trivially_destructible<T>::value == false)
+        {
+            const uint32 end = Min(pBlock->pushIndex.load(std::memory_order_relaxed), m_numElementsPerBlock);
+            for (uint32 i = pBlock->popIndex.load(std::memory_order_relaxed); i < end; ++i)
+            {
+                pBlock->Slots()[i].Data()->~T();
+            }
+        }
+        PAL_FREE(pBlock, m_pAllocator);
+        pBlock = pNext;
+    }
+
+    for (Block* pList : { m_pRetiredBlocks, m_pPooledBlocks })
+    {
+        while (pList != nullptr)
+        {
+            Block*const pNext = pList->pNextFree;
+            PAL_FREE(pList, m_pAllocator);
+            pList = pNext;
+        }
+    }
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+Result SegmentedConcurrentQueue<T, Allocator>::Init()
+{
+    PAL_ASSERT(m_pHead.load(std::memory_order_relaxed) == nullptr);
+
+    Result result     = Result::ErrorOutOfMemory;
+    Block*const pFirst = AllocateBlock();
+
+    if (pFirst != nullptr)
+    {
+        m_pHead.store(pFirst, std::memory_order_relaxed);
+        m_pTail.store(pFirst, std::memory_order_relaxed);
+        result = m_waiter.Init();
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+typename SegmentedConcurrentQueue<T, Allocator>::Block* SegmentedConcurrentQueue<T, Allocator>::AllocateBlock()
+{
+    Block* pBlock = nullptr;
+
+    {
+        MutexAuto lock(&m_reclaimLock);
+        if (m_pPooledBlocks != nullptr)
+        {
+            pBlock          = m_pPooledBlocks;
+            m_pPooledBlocks = pBlock->pNextFree;
+            --m_numPooledBlocks;
+        }
+    }
+
+    if (pBlock == nullptr)
+    {
+        pBlock = static_cast<Block*>(PAL_MALLOC_ALIGNED(SlotsOffset + (m_numElementsPerBlock * sizeof(Slot)),
+                                                        Max(alignof(Slot), size_t(PAL_CACHE_LINE_BYTES)),
+                                                        m_pAllocator,
+                                                        AllocInternal));
+    }
+
+    if (pBlock != nullptr)
+    {
+        PAL_PLACEMENT_NEW(&pBlock->pNext) std::atomic<Block*>(nullptr);
+        PAL_PLACEMENT_NEW(&pBlock->pushIndex) std::atomic<uint32>(0);
+        PAL_PLACEMENT_NEW(&pBlock->popIndex) std::atomic<uint32>(0);
+        pBlock->pNextFree   = nullptr;
+        pBlock->retireEpoch = 0;
+
+        Slot*const pSlots = pBlock->Slots();
+        for (uint32 i = 0; i < m_numElementsPerBlock; ++i)
+        {
+            PAL_PLACEMENT_NEW(&pSlots[i].ready) std::atomic<uint32>(0);
+        }
+    }
+
+    return pBlock;
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+uint64 SegmentedConcurrentQueue<T, Allocator>::EnterEpoch()
+{
+    uint64 epoch = m_epoch.load(std::memory_order_seq_cst);
+
+    while (true)
+    {
+        m_activeOps[epoch & 1].fetch_add(1, std::memory_order_seq_cst);
+
+        // If the epoch moved on before we registered, Reclaim() may not have seen us; register in the new one instead.
+        const uint64 current = m_epoch.load(std::memory_order_seq_cst);
+        if (current == epoch)
+        {
+            break;
+        }
+        m_activeOps[epoch & 1].fetch_sub(1, std::memory_order_release);
+        epoch = current;
+    }
+
+    return epoch;
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+void SegmentedConcurrentQueue<T, Allocator>::RetireBlock(
+    Block* pBlock)
+{
+    MutexAuto lock(&m_reclaimLock);
+
+    pBlock->retireEpoch = m_epoch.load(std::memory_order_seq_cst);
+    pBlock->pNextFree   = nullptr;
+
+    if (m_pRetiredTail != nullptr)
+    {
+        m_pRetiredTail->pNextFree = pBlock;
+    }
+    else
+    {
+        m_pRetiredBlocks = pBlock;
+    }
+    m_pRetiredTail = pBlock;
+
+    Reclaim();
+}
+
+// =====================================================================================================================
+// Must be called with m_reclaimLock held.
+template<typename T, typename Allocator>
+void SegmentedConcurrentQueue<T, Allocator>::Reclaim()
+{
+    // Moving from epoch e to e + 1 requires every operation registered in e - 1 (same parity as e + 1) to be done.  Try
+    // twice so a block retired in the current epoch can be released without waiting for the next retirement.
+    for (uint32 i = 0; i < 2; ++i)
+    {
+        const uint64 epoch = m_epoch.load(std::memory_order_seq_cst);
+        if (m_activeOps[(epoch + 1) & 1].load(std::memory_order_seq_cst) != 0)
+        {
+            break;
+        }
+        m_epoch.store(epoch + 1, std::memory_order_seq_cst);
+    }
+
+    // Blocks are retired in epoch order, so everything that can be released is at the front of the list.
+    const uint64 epoch = m_epoch.load(std::memory_order_relaxed);
+    while ((m_pRetiredBlocks != nullptr) && ((m_pRetiredBlocks->retireEpoch + 2) <= epoch))
+    {
+        Block*const pBlock = m_pRetiredBlocks;
+        m_pRetiredBlocks   = pBlock->pNextFree;
+        ReleaseBlock(pBlock);
+    }
+
+    if (m_pRetiredBlocks == nullptr)
+    {
+        m_pRetiredTail = nullptr;
+    }
+}
+
+// =====================================================================================================================
+// Must be called with m_reclaimLock held.
+template<typename T, typename Allocator>
+void SegmentedConcurrentQueue<T, Allocator>::ReleaseBlock(
+    Block* pBlock)
+{
+    if (m_numPooledBlocks < m_maxPooledBlocks)
+    {
+        pBlock->pNextFree = m_pPooledBlocks;
+        m_pPooledBlocks   = pBlock;
+        ++m_numPooledBlocks;
+    }
+    else
+    {
+        PAL_FREE(pBlock, m_pAllocator);
+    }
+}
+
+// =====================================================================================================================
+// Must be called from within an epoch.
+template<typename T, typename Allocator>
+typename SegmentedConcurrentQueue<T, Allocator>::Block* SegmentedConcurrentQueue<T, Allocator>::ClaimPushSlots(
+    uint32  count,
+    uint32* pFirst,
+    uint32* pClaimed)
+{
+    Block* pResult = nullptr;
+
+    while (true)
+    {
+        Block*const pTail = m_pTail.load(std::memory_order_acquire);
+
+        // Check first so a full block's index only overshoots by one claim per producer.
+        if (pTail->pushIndex.load(std::memory_order_relaxed) < m_numElementsPerBlock)
+        {
+            const uint32 first = pTail->pushIndex.fetch_add(count, std::memory_order_acq_rel);
+            if (first < m_numElementsPerBlock)
+            {
+                *pFirst   = first;
+                *pClaimed = Min(count, m_numElementsPerBlock - first);
+                pResult   = pTail;
+                break;
+            }
+        }
+
+        Block* pNext = pTail->pNext.load(std::memory_order_acquire);
+        if (pNext == nullptr)
+        {
+            Block*const pNew = AllocateBlock();
+            if (pNew == nullptr)
+            {
+                break;
+            }
+
+            if (pTail->pNext.compare_exchange_strong(pNext, pNew, std::memory_order_acq_rel))
+            {
+                pNext = pNew;
+            }
+            else
+            {
+                // Another producer linked a block first.
+                MutexAuto lock(&m_reclaimLock);
+                ReleaseBlock(pNew);
+            }
+        }
+        Block* pExpected = pTail;
+        m_pTail.compare_exchange_strong(pExpected, pNext, std::memory_order_acq_rel);
+    }
+
+    return pResult;
+}
+
+// =====================================================================================================================
+// Must be called from within an epoch.
+template<typename T, typename Allocator>
+typename SegmentedConcurrentQueue<T, Allocator>::Block* SegmentedConcurrentQueue<T, Allocator>::ClaimPopSlots(
+    uint32  count,
+    uint32* pFirst,
+    uint32* pClaimed)
+{
+    Block* pResult = nullptr;
+
+    while (true)
+    {
+        Block*const  pHead = m_pHead.load(std::memory_order_acquire);
+        uint32       first = pHead->popIndex.load(std::memory_order_acquire);
+        const uint32 end   = Min(pHead->pushIndex.load(std::memory_order_acquire), m_numElementsPerBlock);
+
+        if (first < end)
+        {
+            // Only claim slots whose producers have finished writing them, so a consumer never waits on a producer.
+            Slot*const   pSlots  = pHead->Slots();
+            const uint32 limit   = Min(count, end - first);
+            uint32       claimed = 0;
+            while ((claimed < limit) && (pSlots[first + claimed].ready.load(std::memory_order_acquire) != 0))
+            {
+                ++claimed;
+            }
+
+            if (claimed == 0)
+            {
+                // The next element is still being written.
+                break;
+            }
+            if (pHead->popIndex.compare_exchange_weak(first, first + claimed, std::memory_order_acq_rel))
+            {
+                *pFirst   = first;
+                *pClaimed = claimed;
+                pResult   = pHead;
+                break;
+            }
+        }
+        else if (first < m_numElementsPerBlock)
+        {
+            // Nothing has been claimed past the slots already popped: the queue is empty.
+            break;
+        }
+        else
+        {
+            // Every slot of the head block has been claimed; move on to the next one if it is linked yet.
+            Block* pNext = pHead->pNext.load(std::memory_order_acquire);
+            if (pNext == nullptr)
+            {
+                break;
+            }
+
+            Block* pExpected = pHead;
+            if (m_pHead.compare_exchange_strong(pExpected, pNext, std::memory_order_acq_rel))
+            {
+                // The tail may still be lagging on this block; make sure nothing new can reach it before retiring.
+                pExpected = pHead;
+                m_pTail.compare_exchange_strong(pExpected, pNext, std::memory_order_acq_rel);
+                RetireBlock(pHead);
+            }
+        }
+    }
+
+    return pResult;
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+template<typename U>
+Result SegmentedConcurrentQueue<T, Allocator>::Emplace(
+    U&& data)
+{
+    const uint64 epoch = EnterEpoch();
+
+    uint32 first   = 0;
+    uint32 claimed = 0;
+    Block*const pBlock = ClaimPushSlots(1, &first, &claimed);
+
+    if (pBlock != nullptr)
+    {
+        Slot*const pSlot = &pBlock->Slots()[first];
+        PAL_PLACEMENT_NEW(pSlot->Data()) T(static_cast<U&&>(data));
+        pSlot->ready.store(1, std::memory_order_release);
+    }
+
+    ExitEpoch(epoch);
+
+    Result result = Result::ErrorOutOfMemory;
+    if (pBlock != nullptr)
+    {
+        m_waiter.Notify();
+        result = Result::Success;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+Result SegmentedConcurrentQueue<T, Allocator>::PushBatch(
+    const T* pData,
+    uint32   count)
+{
+    const uint64 epoch = EnterEpoch();
+
+    uint32 pushed = 0;
+    while (pushed < count)
+    {
+        uint32 first   = 0;
+        uint32 claimed = 0;
+        Block*const pBlock = ClaimPushSlots(count - pushed, &first, &claimed);
+        if (pBlock == nullptr)
+        {
+            break;
+        }
+
+        Slot*const pSlots = pBlock->Slots();
+        for (uint32 i = 0; i < claimed; ++i)
+        {
+            PAL_PLACEMENT_NEW(pSlots[first + i].Data()) T(pData[pushed + i]);
+            pSlots[first + i].ready.store(1, std::memory_order_release);
+        }
+        pushed += claimed;
+    }
+
+    ExitEpoch(epoch);
+
+    if (pushed > 0)
+    {
+        m_waiter.Notify();
+    }
+
+    return (pushed == count) ? Result::Success : Result::ErrorOutOfMemory;
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+uint32 SegmentedConcurrentQueue<T, Allocator>::TryPopBatch(
+    T*     pOut,
+    uint32 count)
+{
+    const uint64 epoch = EnterEpoch();
+
+    uint32 popped = 0;
+    while (popped < count)
+    {
+        uint32 first   = 0;
+        uint32 claimed = 0;
+        Block*const pBlock = ClaimPopSlots(count - popped, &first, &claimed);
+        if (pBlock == nullptr)
+        {
+            break;
+        }
+
+        Slot*const pSlots = pBlock->Slots();
+        for (uint32 i = 0; i < claimed; ++i)
+        {
+            Slot*const pSlot = &pSlots[first + i];
+            pOut[popped + i] = Move(*pSlot->Data());
+            pSlot->Data()->~T();
+        }
+        popped += claimed;
+    }
+
+    ExitEpoch(epoch);
+
+    return popped;
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+Result SegmentedConcurrentQueue<T, Allocator>::TryPop(
+    T* pOut)
+{
+    return (TryPopBatch(pOut, 1) == 1) ? Result::Success : Result::NotReady;
+}
+
+} // Util
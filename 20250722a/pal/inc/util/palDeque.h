@@ -40,7 +40,8 @@ namespace Util
 // Forward declarations.
 template<typename T, typename Allocator> class Deque;
 
-/// @internal Private structure used by Deque and its iterators to store chunks of data elements.
+/// @internal Private structure used by Deque and its iterators to store chunks of data elements.  The elements follow
+/// the header in the same allocation.
 struct DequeBlockHeader
 {
     DequeBlockHeader* pPrev;   ///< Pointer to the previous block.
@@ -97,9 +98,15 @@ private:
  *
  * This is meant for storing elements of an arbitrary (but uniform) type. Operations which this class supports are:
  *
- * - Insertion from the front and back.
+ * - Insertion from the front and back, one element or a run of elements at a time.
  * - Deletion from the front and back.
  * - Forwards and reverse iteration
+ * - Constant-time random access.
+ *
+ * Elements are stored in blocks of numElementsPerBlock elements.  Besides linking the blocks to each other, the deque
+ * keeps a circular array of block pointers, so At() can find the block holding any index directly.  Blocks that become
+ * empty are kept in a pool of up to maxFreeBlocks blocks for reuse, so a FIFO whose size varies by less than that many
+ * blocks stops calling the allocator once it has warmed up.
  *
  * @warning This class is not thread-safe for push, pop, or iteration!
  *
@@ -114,8 +121,10 @@ class Deque
 public:
     /// Constructor.
     ///
-    /// @param [in] pAllocator The allocator that will allocate memory if required.
-    Deque(Allocator*const pAllocator, size_t numElementsPerBlock = 256);
+    /// @param [in] pAllocator          The allocator that will allocate memory if required.
+    /// @param [in] numElementsPerBlock Number of elements in each block.
+    /// @param [in] maxFreeBlocks       Number of empty blocks kept for reuse instead of being freed.
+    Deque(Allocator*const pAllocator, size_t numElementsPerBlock = 256, size_t maxFreeBlocks = 1);
     ~Deque();
 
     /// Returns the number of elements in the deque.
@@ -206,6 +215,17 @@ public:
     template<typename... Args>
     Result EmplaceBack(Args&&... args);
 
+    /// Pushes copies of count items onto the back of the deque, in order.  Trivially copyable types are copied a block
+    /// at a time.
+    ///
+    /// @param [in] pData Items to be added to the back of the deque.
+    /// @param [in] count Number of items in pData.
+    ///
+    /// @returns @ref Success if the items were successfully added to the deque or @ref ErrorOutOfMemory if the
+    ///          operation failed because of an internal failure to allocate system memory, in which case the deque is
+    ///          left unchanged.
+    Result PushBack(const T* pData, size_t count);
+
     /// Pops the first item off the front of the deque, returning the popped value.
     ///
     /// @param [out] pOut Item popped off the front of the deque.
@@ -214,6 +234,16 @@ public:
     ///          is empty.
     Result PopFront(T* pOut);
 
+    /// Pops the first count items off the front of the deque, in order.  Trivially copyable types are copied a block at
+    /// a time.
+    ///
+    /// @param [out] pOut  Items popped off the front of the deque.
+    /// @param [in]  count Number of items to pop.
+    ///
+    /// @returns @ref Success if the items were successfully popped from the deque or @ref ErrorUnavailable if the deque
+    ///          holds fewer than count items, in which case nothing is popped.
+    Result PopFront(T* pOut, size_t count);
+
     /// Pops the first item off the back of the deque, returning the popped value.
     ///
     /// @param [out] pOut Item popped off the back of the deque.
@@ -225,8 +255,20 @@ public:
 private:
     Result AllocateFront(T**);
     Result AllocateBack(T**);
+    DequeBlockHeader* CreateBlock();
     DequeBlockHeader* AllocateNewBlock();
     void FreeUnusedBlock(DequeBlockHeader* pHeader);
+    Result ReserveBlocks(size_t numBlocks);
+    Result GrowBlockMap(size_t minBlocks);
+    void PushBackBlock(DequeBlockHeader* pHeader);
+    void PopFrontBlock();
+
+    // Returns the block which is the given number of blocks behind the front block.
+    DequeBlockHeader* BlockAt(size_t block) const
+        { return m_ppBlockMap[(m_frontBlock + block) & (m_blockMapSize - 1)]; }
+
+    // Returns the number of elements in the front block.
+    size_t FrontBlockElements() const;
 
     // A helper function to avoid duplication in const and non-const versions of At().
     T& InternalAt(uint32 index) const;
@@ -240,7 +282,14 @@ private:
     T*                m_pFront;              // First data element, null for empty deques.
     T*                m_pBack;               // Last data element, null for empty deques.
 
-    DequeBlockHeader* m_pLazyFreeHeader;     // Cached pointer to the most-recently freed block.
+    DequeBlockHeader** m_ppBlockMap;         // Circular array of pointers to the blocks in use, front to back.
+    size_t            m_blockMapSize;        // Capacity of m_ppBlockMap; zero or a power of two.
+    size_t            m_frontBlock;          // Index of the front block in m_ppBlockMap.
+    size_t            m_numBlocks;           // Number of blocks in use.
+
+    DequeBlockHeader* m_pFreeBlocks;         // Pool of empty blocks, linked through pNext.
+    size_t            m_numFreeBlocks;       // Number of blocks in the pool.
+    const size_t      m_maxFreeBlocks;       // Number of blocks the pool keeps before freeing the rest.
 
     Allocator*const   m_pAllocator;          // Pointer to the allocator for this deque.
 
@@ -256,7 +305,8 @@ private:
 template<typename T, typename Allocator>
 Deque<T, Allocator>::Deque(
     Allocator*const pAllocator,
-    size_t          numElementsPerBlock)
+    size_t          numElementsPerBlock,
+    size_t          maxFreeBlocks)
     :
     m_numElements(0),
     m_numElementsPerBlock(numElementsPerBlock),
@@ -264,7 +314,13 @@ Deque<T, Allocator>::Deque(
     m_pBackHeader(nullptr),
     m_pFront(nullptr),
     m_pBack(nullptr),
-    m_pLazyFreeHeader(nullptr),
+    m_ppBlockMap(nullptr),
+    m_blockMapSize(0),
+    m_frontBlock(0),
+    m_numBlocks(0),
+    m_pFreeBlocks(nullptr),
+    m_numFreeBlocks(0),
+    m_maxFreeBlocks(maxFreeBlocks),
     m_pAllocator(pAllocator)
 {
 }
@@ -310,10 +366,14 @@ Deque<T, Allocator>::~Deque()
         }
     }
 
-    if (m_pLazyFreeHeader != nullptr)
+    while (m_pFreeBlocks != nullptr)
     {
-        PAL_SAFE_FREE(m_pLazyFreeHeader, m_pAllocator);
+        DequeBlockHeader* pBlockToFree = m_pFreeBlocks;
+        m_pFreeBlocks = m_pFreeBlocks->pNext;
+        PAL_SAFE_FREE(pBlockToFree, m_pAllocator);
     }
+
+    PAL_SAFE_FREE(m_ppBlockMap, m_pAllocator);
 }
 
 } // Util
@@ -0,0 +1,672 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2014-2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palDequeImpl.h
+ * @brief PAL utility collection Deque and DequeIterator class implementations.
+ ***********************************************************************************************************************
+ */
+
+#pragma once
+
+#include "palDeque.h"
+#include "palInlineFuncs.h"
+#include <string.h>
+#include <type_traits>
+
+namespace Util
+{
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+DequeIterator<T, Allocator>::DequeIterator(
+    const Deque<T, Allocator>* pDeque,
+    DequeBlockHeader*          pHeader,
+    T*                         pCurrent)
+    :
+    m_pDeque(pDeque),
+    m_pCurrentHeader(pHeader),
+    m_pCurrent(pCurrent)
+{
+}
+
+// =====================================================================================================================
+// Moves to the next element, crossing into the next block when the end of this one is reached.
+template<typename T, typename Allocator>
+void DequeIterator<T, Allocator>::Next()
+{
+    if (m_pCurrent != nullptr)
+    {
+        if (m_pCurrent == m_pDeque->m_pBack)
+        {
+            m_pCurrent = nullptr;
+        }
+        else if (++m_pCurrent == m_pCurrentHeader->pEnd)
+        {
+            m_pCurrentHeader = m_pCurrentHeader->pNext;
+            m_pCurrent       = static_cast<T*>(m_pCurrentHeader->pStart);
+        }
+    }
+}
+
+// =====================================================================================================================
+// Moves to the previous element, crossing into the previous block when the start of this one is reached.
+template<typename T, typename Allocator>
+void DequeIterator<T, Allocator>::Prev()
+{
+    if (m_pCurrent != nullptr)
+    {
+        if (m_pCurrent == m_pDeque->m_pFront)
+        {
+            m_pCurrent = nullptr;
+        }
+        else if (m_pCurrent == m_pCurrentHeader->pStart)
+        {
+            m_pCurrentHeader = m_pCurrentHeader->pPrev;
+            m_pCurrent       = static_cast<T*>(m_pCurrentHeader->pEnd) - 1;
+        }
+        else
+        {
+            --m_pCurrent;
+        }
+    }
+}
+
+// =====================================================================================================================
+// Allocates a new block.  The elements start at the first suitably aligned address past the header.
+template<typename T, typename Allocator>
+DequeBlockHeader* Deque<T, Allocator>::CreateBlock()
+{
+    constexpr size_t HeaderSize = Pow2Align(sizeof(DequeBlockHeader), alignof(T));
+
+    DequeBlockHeader* pHeader =
+        static_cast<DequeBlockHeader*>(PAL_MALLOC_ALIGNED(HeaderSize + (sizeof(T) * m_numElementsPerBlock),
+                                                          Max(alignof(T), alignof(DequeBlockHeader)),
+                                                          m_pAllocator,
+                                                          AllocInternal));
+    if (pHeader != nullptr)
+    {
+        pHeader->pStart = VoidPtrInc(pHeader, HeaderSize);
+        pHeader->pEnd   = static_cast<T*>(pHeader->pStart) + m_numElementsPerBlock;
+    }
+
+    return pHeader;
+}
+
+// =====================================================================================================================
+// Takes a block from the free pool, or allocates a new one if the pool is empty.
+template<typename T, typename Allocator>
+DequeBlockHeader* Deque<T, Allocator>::AllocateNewBlock()
+{
+    DequeBlockHeader* pHeader = m_pFreeBlocks;
+
+    if (pHeader != nullptr)
+    {
+        m_pFreeBlocks = pHeader->pNext;
+        --m_numFreeBlocks;
+    }
+    else
+    {
+        pHeader = CreateBlock();
+    }
+
+    if (pHeader != nullptr)
+    {
+        pHeader->pPrev = nullptr;
+        pHeader->pNext = nullptr;
+    }
+
+    return pHeader;
+}
+
+// =====================================================================================================================
+// Returns a block which no longer holds any elements to the free pool, or frees it if the pool is full.
+template<typename T, typename Allocator>
+void Deque<T, Allocator>::FreeUnusedBlock(
+    DequeBlockHeader* pHeader)
+{
+    if (m_numFreeBlocks < m_maxFreeBlocks)
+    {
+        pHeader->pNext = m_pFreeBlocks;
+        m_pFreeBlocks  = pHeader;
+        ++m_numFreeBlocks;
+    }
+    else
+    {
+        PAL_FREE(pHeader, m_pAllocator);
+    }
+}
+
+// =====================================================================================================================
+// Makes sure numBlocks more blocks can be added without failing: the block map has room for them and the free pool
+// holds at least that many blocks.  On failure, any blocks allocated here beyond the pool limit are freed again.
+template<typename T, typename Allocator>
+Result Deque<T, Allocator>::ReserveBlocks(
+    size_t numBlocks)
+{
+    Result result = Result::Success;
+
+    if ((m_numBlocks + numBlocks) > m_blockMapSize)
+    {
+        result = GrowBlockMap(m_numBlocks + numBlocks);
+    }
+
+    while ((result == Result::Success) && (m_numFreeBlocks < numBlocks))
+    {
+        DequeBlockHeader* pHeader = CreateBlock();
+
+        if (pHeader != nullptr)
+        {
+            pHeader->pNext = m_pFreeBlocks;
+            m_pFreeBlocks  = pHeader;
+            ++m_numFreeBlocks;
+        }
+        else
+        {
+            result = Result::ErrorOutOfMemory;
+        }
+    }
+
+    while ((result != Result::Success) && (m_numFreeBlocks > m_maxFreeBlocks))
+    {
+        DequeBlockHeader* pBlockToFree = m_pFreeBlocks;
+        m_pFreeBlocks = m_pFreeBlocks->pNext;
+        --m_numFreeBlocks;
+        PAL_FREE(pBlockToFree, m_pAllocator);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Reallocates the block map so it can hold at least minBlocks block pointers.  The map grows geometrically, and the
+// blocks in use are unwrapped to the start of the new map.
+template<typename T, typename Allocator>
+Result Deque<T, Allocator>::GrowBlockMap(
+    size_t minBlocks)
+{
+    Result result  = Result::ErrorOutOfMemory;
+    size_t newSize = Max(m_blockMapSize * 2, size_t(8));
+
+    while (newSize < minBlocks)
+    {
+        newSize *= 2;
+    }
+
+    DequeBlockHeader** ppNewMap =
+        static_cast<DequeBlockHeader**>(PAL_MALLOC(newSize * sizeof(DequeBlockHeader*), m_pAllocator, AllocInternal));
+
+    if (ppNewMap != nullptr)
+    {
+        for (size_t i = 0; i < m_numBlocks; ++i)
+        {
+            ppNewMap[i] = BlockAt(i);
+        }
+
+        PAL_FREE(m_ppBlockMap, m_pAllocator);
+        m_ppBlockMap   = ppNewMap;
+        m_blockMapSize = newSize;
+        m_frontBlock   = 0;
+        result         = Result::Success;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Links a new block in after the back block.  The block map must have room for it.
+template<typename T, typename Allocator>
+void Deque<T, Allocator>::PushBackBlock(
+    DequeBlockHeader* pHeader)
+{
+    PAL_ASSERT(m_numBlocks < m_blockMapSize);
+
+    pHeader->pPrev = m_pBackHeader;
+    if (m_pBackHeader != nullptr)
+    {
+        m_pBackHeader->pNext = pHeader;
+    }
+    else
+    {
+        m_pFrontHeader = pHeader;
+    }
+    m_pBackHeader = pHeader;
+
+    m_ppBlockMap[(m_frontBlock + m_numBlocks) & (m_blockMapSize - 1)] = pHeader;
+    ++m_numBlocks;
+}
+
+// =====================================================================================================================
+// Unlinks the front block, which must no longer hold any elements, and releases it.
+template<typename T, typename Allocator>
+void Deque<T, Allocator>::PopFrontBlock()
+{
+    DequeBlockHeader* pBlockToFree = m_pFrontHeader;
+
+    m_pFrontHeader = pBlockToFree->pNext;
+    m_frontBlock   = (m_frontBlock + 1) & (m_blockMapSize - 1);
+    --m_numBlocks;
+
+    if (m_pFrontHeader != nullptr)
+    {
+        m_pFrontHeader->pPrev = nullptr;
+        m_pFront = static_cast<T*>(m_pFrontHeader->pStart);
+    }
+    else
+    {
+        m_pBackHeader = nullptr;
+        m_pFront      = nullptr;
+        m_pBack       = nullptr;
+    }
+
+    FreeUnusedBlock(pBlockToFree);
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+size_t Deque<T, Allocator>::FrontBlockElements() const
+{
+    const T*const pEnd = (m_pFrontHeader == m_pBackHeader) ? (m_pBack + 1)
+                                                           : static_cast<const T*>(m_pFrontHeader->pEnd);
+    return static_cast<size_t>(pEnd - m_pFront);
+}
+
+// =====================================================================================================================
+// Finds space for a new element in front of the current front element, adding a block if the front block is full.
+template<typename T, typename Allocator>
+Result Deque<T, Allocator>::AllocateFront(
+    T** ppAllocatedSpace)
+{
+    Result result = Result::Success;
+
+    if ((m_pFrontHeader == nullptr) || (m_pFront == m_pFrontHeader->pStart))
+    {
+        DequeBlockHeader* pHeader = nullptr;
+
+        if (m_numBlocks == m_blockMapSize)
+        {
+            result = GrowBlockMap(m_numBlocks + 1);
+        }
+
+        if (result == Result::Success)
+        {
+            pHeader = AllocateNewBlock();
+            result  = (pHeader != nullptr) ? Result::Success : Result::ErrorOutOfMemory;
+        }
+
+        if (result == Result::Success)
+        {
+            pHeader->pNext = m_pFrontHeader;
+            if (m_pFrontHeader != nullptr)
+            {
+                m_pFrontHeader->pPrev = pHeader;
+            }
+            else
+            {
+                m_pBackHeader = pHeader;
+                m_pBack       = static_cast<T*>(pHeader->pEnd) - 1;
+            }
+            m_pFrontHeader = pHeader;
+            m_pFront       = static_cast<T*>(pHeader->pEnd) - 1;
+
+            m_frontBlock = (m_frontBlock - 1) & (m_blockMapSize - 1);
+            m_ppBlockMap[m_frontBlock] = pHeader;
+            ++m_numBlocks;
+        }
+    }
+    else
+    {
+        --m_pFront;
+    }
+
+    if (result == Result::Success)
+    {
+        ++m_numElements;
+        *ppAllocatedSpace = m_pFront;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Finds space for a new element behind the current back element, adding a block if the back block is full.
+template<typename T, typename Allocator>
+Result Deque<T, Allocator>::AllocateBack(
+    T** ppAllocatedSpace)
+{
+    Result result = Result::Success;
+
+    if ((m_pBackHeader == nullptr) || ((m_pBack + 1) == m_pBackHeader->pEnd))
+    {
+        DequeBlockHeader* pHeader = nullptr;
+
+        if (m_numBlocks == m_blockMapSize)
+        {
+            result = GrowBlockMap(m_numBlocks + 1);
+        }
+
+        if (result == Result::Success)
+        {
+            pHeader = AllocateNewBlock();
+            result  = (pHeader != nullptr) ? Result::Success : Result::ErrorOutOfMemory;
+        }
+
+        if (result == Result::Success)
+        {
+            if (m_pFrontHeader == nullptr)
+            {
+                m_pFront = static_cast<T*>(pHeader->pStart);
+            }
+            PushBackBlock(pHeader);
+            m_pBack = static_cast<T*>(pHeader->pStart);
+        }
+    }
+    else
+    {
+        ++m_pBack;
+    }
+
+    if (result == Result::Success)
+    {
+        ++m_numElements;
+        *ppAllocatedSpace = m_pBack;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+Result Deque<T, Allocator>::PushFront(
+    const T& data)
+{
+    return EmplaceFront(data);
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+template<typename... Args>
+Result Deque<T, Allocator>::EmplaceFront(
+    Args&&... args)
+{
+    T* pAllocatedSpace = nullptr;
+    const Result result = AllocateFront(&pAllocatedSpace);
+
+    if (result == Result::Success)
+    {
+        PAL_PLACEMENT_NEW(pAllocatedSpace) T(static_cast<Args&&>(args)...);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+Result Deque<T, Allocator>::PushBack(
+    const T& data)
+{
+    return EmplaceBack(data);
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+template<typename... Args>
+Result Deque<T, Allocator>::EmplaceBack(
+    Args&&... args)
+{
+    T* pAllocatedSpace = nullptr;
+    const Result result = AllocateBack(&pAllocatedSpace);
+
+    if (result == Result::Success)
+    {
+        PAL_PLACEMENT_NEW(pAllocatedSpace) T(static_cast<Args&&>(args)...);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Reserves every block the items need up front, so the copy itself cannot fail, then fills the back block and as many
+// new blocks as needed one block at a time.
+template<typename T, typename Allocator>
+Result Deque<T, Allocator>::PushBack(
+    const T* pData,
+    size_t   count)
+{
+    const size_t backRoom = (m_pBackHeader != nullptr) ? (static_cast<T*>(m_pBackHeader->pEnd) - (m_pBack + 1)) : 0;
+    const size_t newBlocks = (count > backRoom) ? RoundUpQuotient(count - backRoom, m_numElementsPerBlock) : 0;
+
+    Result result = ReserveBlocks(newBlocks);
+
+    if (result == Result::Success)
+    {
+        T* pDst = (m_pBackHeader != nullptr) ? (m_pBack + 1) : nullptr;
+
+        while (count > 0)
+        {
+            if ((pDst == nullptr) || (pDst == m_pBackHeader->pEnd))
+            {
+                DequeBlockHeader*const pHeader = AllocateNewBlock();
+                PAL_ASSERT(pHeader != nullptr);
+
+                pDst = static_cast<T*>(pHeader->pStart);
+                if (m_pFrontHeader == nullptr)
+                {
+                    m_pFront = pDst;
+                }
+                PushBackBlock(pHeader);
+            }
+
+            const size_t numCopied = Min(count, static_cast<size_t>(static_cast<T*>(m_pBackHeader->pEnd) - pDst));
+
+            if (std::is_trivially_copyable<T>::value)
+            {
+                memcpy(static_cast<void*>(pDst), pData, numCopied * sizeof(T));
+            }
+            else
+            {
+                for (size_t i = 0; i < numCopied; ++i)
+                {
+                    PAL_PLACEMENT_NEW(pDst + i) T(pData[i]);
+                }
+            }
+
+            m_pBack        = pDst + numCopied - 1;
+            m_numElements += numCopied;
+            pDst          += numCopied;
+            pData         += numCopied;
+            count         -= numCopied;
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+Result Deque<T, Allocator>::PopFront(
+    T* pOut)
+{
+    Result result = Result::ErrorUnavailable;
+
+    if (m_numElements > 0)
+    {
+        PAL_ASSERT(pOut != nullptr);
+
+        *pOut = Move(*m_pFront);
+        m_pFront->~T();
+        --m_numElements;
+
+        if ((m_numElements == 0) || (++m_pFront == m_pFrontHeader->pEnd))
+        {
+            PopFrontBlock();
+        }
+
+        result = Result::Success;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Empties the front block one block at a time, releasing each block once its last element is gone.
+template<typename T, typename Allocator>
+Result Deque<T, Allocator>::PopFront(
+    T*     pOut,
+    size_t count)
+{
+    Result result = Result::ErrorUnavailable;
+
+    if (count <= m_numElements)
+    {
+        while (count > 0)
+        {
+            const size_t available = FrontBlockElements();
+            const size_t numCopied = Min(count, available);
+
+            if (std::is_trivially_copyable<T>::value)
+            {
+                memcpy(static_cast<void*>(pOut), m_pFront, numCopied * sizeof(T));
+            }
+            else
+            {
+                for (size_t i = 0; i < numCopied; ++i)
+                {
+                    pOut[i] = Move(m_pFront[i]);
+                    m_pFront[i].~T();
+                }
+            }
+
+            m_numElements -= numCopied;
+            pOut          += numCopied;
+            count         -= numCopied;
+
+            if (numCopied == available)
+            {
+                PopFrontBlock();
+            }
+            else
+            {
+                m_pFront += numCopied;
+            }
+        }
+
+        result = Result::Success;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+Result Deque<T, Allocator>::PopBack(
+    T* pOut)
+{
+    Result result = Result::ErrorUnavailable;
+
+    if (m_numElements > 0)
+    {
+        PAL_ASSERT(pOut != nullptr);
+
+        *pOut = Move(*m_pBack);
+        m_pBack->~T();
+        --m_numElements;
+
+        if (m_numElements == 0)
+        {
+            PopFrontBlock();
+        }
+        else if (m_pBack == m_pBackHeader->pStart)
+        {
+            DequeBlockHeader* pBlockToFree = m_pBackHeader;
+
+            m_pBackHeader        = pBlockToFree->pPrev;
+            m_pBackHeader->pNext = nullptr;
+            m_pBack              = static_cast<T*>(m_pBackHeader->pEnd) - 1;
+            --m_numBlocks;
+
+            FreeUnusedBlock(pBlockToFree);
+        }
+        else
+        {
+            --m_pBack;
+        }
+
+        result = Result::Success;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Finds the element's block through the block map: the front block may be partially empty, so the index is offset by
+// the front element's position within its block first.
+template<typename T, typename Allocator>
+T& Deque<T, Allocator>::InternalAt(
+    uint32 index
+    ) const
+{
+    PAL_ASSERT(index < m_numElements);
+
+    const size_t offset = static_cast<size_t>(m_pFront - static_cast<T*>(m_pFrontHeader->pStart)) + index;
+
+    return static_cast<T*>(BlockAt(offset / m_numElementsPerBlock)->pStart)[offset % m_numElementsPerBlock];
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+T& Deque<T, Allocator>::At(
+    uint32 index)
+{
+    return InternalAt(index);
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+const T& Deque<T, Allocator>::At(
+    uint32 index
+    ) const
+{
+    return InternalAt(index);
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+T& Deque<T, Allocator>::operator[](
+    uint32 index)
+{
+    return InternalAt(index);
+}
+
+// =====================================================================================================================
+template<typename T, typename Allocator>
+const T& Deque<T, Allocator>::operator[](
+    uint32 index
+    ) const
+{
+    return InternalAt(index);
+}
+
+} // Util
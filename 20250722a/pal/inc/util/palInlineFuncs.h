@@ -33,6 +33,7 @@
 
 #include "palAssert.h"
 #include "palStringUtil.h"
+#include "palWideBitfieldKernels.h"
 #include <cctype>
 #include <cstdlib>
 #include <cstring>
@@ -41,6 +42,7 @@
 #include <type_traits>
 #include <limits>
 
+
 namespace Util
 {
 
@@ -364,9 +366,17 @@ bool WideBitfieldIsAnyBitSet(
     const T(&bitfield)[N])
 {
     bool isBitSet = false;
-    for (uint32 i = 0; i < N; i++)
+
+    if constexpr (sizeof(bitfield) < WideBitfieldKernels::MinReduceBytes)
+    {
+        for (uint32 i = 0; i < N; i++)
+        {
+            isBitSet |= (bitfield[i] != 0);
+        }
+    }
+    else
     {
-        isBitSet |= (bitfield[i] != 0);
+        isBitSet = WideBitfieldKernels::IsAnyBitSet(bitfield, sizeof(bitfield));
     }
 
     return isBitSet;
@@ -416,25 +426,9 @@ void WideBitfieldSetRange(
     uint32 startingBit,
     uint32 numBits)
 {
-    constexpr uint32 SizeInBits = (sizeof(T) << 3);
-
-    PAL_ASSERT((startingBit + numBits) <= (SizeInBits * N));
-
-    uint32 index = (startingBit / SizeInBits);
-
-    startingBit &= (SizeInBits - 1);
-
-    while (numBits > 0)
-    {
-        const uint32 maxNumBits     = SizeInBits - startingBit;
-        const uint32 curNumBits     = (maxNumBits < numBits) ? maxNumBits : numBits;
-        const T      bitMask        = (curNumBits == SizeInBits) ? -1 : ((static_cast<T>(1) << curNumBits) - 1);
-
-        bitfield[index++] |= (bitMask << startingBit);
+    PAL_ASSERT((startingBit + numBits) <= ((sizeof(T) << 3) * N));
 
-        startingBit  = 0;
-        numBits     -= curNumBits;
-    }
+    WideBitfieldKernels::WriteRange(bitfield, startingBit, numBits, true);
 }
 
 /// XORs all of the bits in two "wide bitfields". A "wide bifield" is a bitfield which spans an array of integers
@@ -449,9 +443,19 @@ void WideBitfieldXorBits(
     const T (&bitfield2)[N],
     T*       pOut)
 {
-    for (uint32 i = 0; i < N; i++)
+    if constexpr (sizeof(bitfield1) < WideBitfieldKernels::MinCombineBytes)
+    {
+        for (uint32 i = 0; i < N; i++)
+        {
+            pOut[i] = (bitfield1[i] ^ bitfield2[i]);
+        }
+    }
+    else
     {
-        pOut[i] = (bitfield1[i] ^ bitfield2[i]);
+        WideBitfieldKernels::Combine<WideBitfieldKernels::BitOp::Xor>(pOut,
+                                                                      bitfield1,
+                                                                      bitfield2,
+                                                                      sizeof(bitfield1));
     }
 }
 
@@ -467,9 +471,19 @@ void WideBitfieldAndBits(
     const T (&bitfield2)[N],
     T*      pOut)
 {
-    for (uint32 i = 0; i < N; i++)
+    if constexpr (sizeof(bitfield1) < WideBitfieldKernels::MinCombineBytes)
     {
-        pOut[i] = (bitfield1[i] & bitfield2[i]);
+        for (uint32 i = 0; i < N; i++)
+        {
+            pOut[i] = (bitfield1[i] & bitfield2[i]);
+        }
+    }
+    else
+    {
+        WideBitfieldKernels::Combine<WideBitfieldKernels::BitOp::And>(pOut,
+                                                                      bitfield1,
+                                                                      bitfield2,
+                                                                      sizeof(bitfield1));
     }
 }
 
@@ -484,9 +498,17 @@ uint32 WideBitfieldCountSetBits(
     const T(&bitfield)[N])
 {
     uint32 count = 0;
-    for (uint32 i = 0; i < N; i++)
+
+    if constexpr (sizeof(bitfield) < WideBitfieldKernels::MinReduceBytes)
     {
-        count += CountSetBits(bitfield[i]);
+        for (uint32 i = 0; i < N; i++)
+        {
+            count += CountSetBits(bitfield[i]);
+        }
+    }
+    else
+    {
+        count = WideBitfieldKernels::CountSetBits(bitfield, sizeof(bitfield));
     }
 
     return count;
@@ -1206,6 +1228,7 @@ inline void StringToValueType(
 }
 
 /// Hashes the provided string using FNV1a hashing (http://www.isthe.com/chongo/tech/comp/fnv/) algorithm.
+/// Exactly strSize characters are hashed; the string need not be null-terminated and may be empty.
 ///
 /// @returns 32-bit hash generated from the provided string.
 template <class Char>
@@ -1213,7 +1236,7 @@ constexpr uint32 HashString(
     const Char* pStr,     ///< [in] String to be hashed.
     size_t      strSize)  ///< Size of the input string.
 {
-    PAL_CONSTEXPR_ASSERT((pStr != nullptr) && (strSize > 0));
+    PAL_CONSTEXPR_ASSERT((pStr != nullptr) || (strSize == 0));
 
     constexpr uint32 FnvPrime  = 16777619u;
     constexpr uint32 FnvOffset = 2166136261u;
@@ -1551,15 +1574,430 @@ template<typename ElementTy> int PAL_CDECL SortComparisonFunc(
            int(*static_cast<const ElementTy*>(pLhs) < *static_cast<const ElementTy*>(pRhs));
 }
 
-/// In-place sort of an array. Uses C library qsort, so is probably a non-order-preserving quicksort.
+/// Default ordering used by the Sort() family: the element type's operator<.
+struct SortLess
+{
+    /// @returns True if lhs orders before rhs.
+    template<typename ElementTy>
+    constexpr bool operator()(const ElementTy& lhs, const ElementTy& rhs) const { return (lhs < rhs); }
+};
+
+/// @internal Ranges at or below this many elements are finished with insertion sort.
+constexpr size_t SortInsertionThreshold = 16;
+
+/// @internal Straight insertion sort of [pStart,pEnd).  Stable.
+template<typename RandomIt, typename Compare>
+void InsertionSort(
+    RandomIt pStart,
+    RandomIt pEnd,
+    Compare  comp)
+{
+    using ElementTy = typename std::iterator_traits<RandomIt>::value_type;
+
+    if (pStart != pEnd)
+    {
+        for (RandomIt pCur = pStart + 1; pCur < pEnd; ++pCur)
+        {
+            if (comp(*pCur, *pStart))
+            {
+                // New minimum: shift the whole sorted prefix up by one without any further compares.
+                ElementTy value = Move(*pCur);
+                for (RandomIt pHole = pCur; pHole != pStart; --pHole)
+                {
+                    *pHole = Move(*(pHole - 1));
+                }
+                *pStart = Move(value);
+            }
+            else if (comp(*pCur, *(pCur - 1)))
+            {
+                // *pStart acts as a sentinel, so the scan needs no bounds check.
+                ElementTy value = Move(*pCur);
+                RandomIt  pHole = pCur;
+                do
+                {
+                    *pHole = Move(*(pHole - 1));
+                    --pHole;
+                }
+                while (comp(value, *(pHole - 1)));
+                *pHole = Move(value);
+            }
+        }
+    }
+}
+
+/// @internal Restores the max-heap property for the subtree rooted at index hole of the heap at pStart.
+template<typename RandomIt, typename Compare>
+void SiftDown(
+    RandomIt pStart,
+    size_t   hole,
+    size_t   count,
+    Compare  comp)
+{
+    using ElementTy = typename std::iterator_traits<RandomIt>::value_type;
+
+    ElementTy value = Move(pStart[hole]);
+    size_t    child = (2 * hole) + 1;
+
+    while (child < count)
+    {
+        if (((child + 1) < count) && comp(pStart[child], pStart[child + 1]))
+        {
+            ++child;
+        }
+        if (comp(value, pStart[child]) == false)
+        {
+            break;
+        }
+        pStart[hole] = Move(pStart[child]);
+        hole         = child;
+        child        = (2 * hole) + 1;
+    }
+    pStart[hole] = Move(value);
+}
+
+/// @internal Heap sort of [pStart,pEnd).  Used by IntroSortLoop() once partitioning degenerates.
+template<typename RandomIt, typename Compare>
+void HeapSort(
+    RandomIt pStart,
+    RandomIt pEnd,
+    Compare  comp)
+{
+    const size_t count = size_t(pEnd - pStart);
+
+    for (size_t idx = count / 2; idx > 0; --idx)
+    {
+        SiftDown(pStart, idx - 1, count, comp);
+    }
+    for (size_t last = count; last > 1; --last)
+    {
+        Swap(pStart[0], pStart[last - 1]);
+        SiftDown(pStart, 0, last - 1, comp);
+    }
+}
+
+/// @internal Sorts the three elements in place.
+template<typename RandomIt, typename Compare>
+void Sort3(
+    RandomIt pA,
+    RandomIt pB,
+    RandomIt pC,
+    Compare  comp)
+{
+    if (comp(*pB, *pA))
+    {
+        Swap(*pA, *pB);
+    }
+    if (comp(*pC, *pB))
+    {
+        Swap(*pB, *pC);
+        if (comp(*pB, *pA))
+        {
+            Swap(*pA, *pB);
+        }
+    }
+}
+
+/// @internal Median-of-three quicksort partition of [pStart,pEnd), which must hold more than SortInsertionThreshold
+/// elements.
+///
+/// @returns The pivot's final position pPivot: [pStart,pPivot) <= *pPivot <= (pPivot,pEnd).
+template<typename RandomIt, typename Compare>
+RandomIt SortPartition(
+    RandomIt pStart,
+    RandomIt pEnd,
+    Compare  comp)
+{
+    // Median of three goes to pStart and serves as the pivot; the other two act as partition sentinels.
+    RandomIt pMid = pStart + ((pEnd - pStart) / 2);
+    Sort3(pStart + 1, pMid, pEnd - 1, comp);
+    Swap(*pStart, *pMid);
+
+    RandomIt pLo = pStart + 1;
+    RandomIt pHi = pEnd - 1;
+    while (true)
+    {
+        do { ++pLo; } while (comp(*pLo, *pStart));
+        do { --pHi; } while (comp(*pStart, *pHi));
+        if (pLo >= pHi)
+        {
+            break;
+        }
+        Swap(*pLo, *pHi);
+    }
+    Swap(*pStart, *pHi);
+
+    return pHi;
+}
+
+/// @internal Introsort main loop: median-of-three quicksort which switches to heap sort when the recursion budget is
+/// spent, leaving ranges of SortInsertionThreshold or fewer elements for a final insertion sort pass.  Recurses into
+/// the smaller partition and loops on the larger one, so stack depth is O(log n).
+template<typename RandomIt, typename Compare>
+void IntroSortLoop(
+    RandomIt pStart,
+    RandomIt pEnd,
+    uint32   depthBudget,
+    Compare  comp)
+{
+    while (size_t(pEnd - pStart) > SortInsertionThreshold)
+    {
+        if (depthBudget == 0)
+        {
+            HeapSort(pStart, pEnd, comp);
+            break;
+        }
+        --depthBudget;
+
+        const RandomIt pHi = SortPartition(pStart, pEnd, comp);
+
+        // [pStart,pHi) <= pivot <= (pHi,pEnd)
+        if ((pHi - pStart) < (pEnd - pHi))
+        {
+            IntroSortLoop(pStart, pHi, depthBudget, comp);
+            pStart = pHi + 1;
+        }
+        else
+        {
+            IntroSortLoop(pHi + 1, pEnd, depthBudget, comp);
+            pEnd = pHi;
+        }
+    }
+}
+
+/// In-place sort of an array with a caller-provided ordering.  Not order-preserving for equal elements.
+/// Sorts the array given by the random iterator range [pStart,pEnd).
+///
+/// This is an introsort (quicksort bounded by heap sort, finished with insertion sort), so it runs in O(n log n)
+/// worst case without allocating, and the comparison is inlined rather than called through a function pointer.
+///
+/// @param [in] pStart Start of the range.
+/// @param [in] pEnd   End of the range (one past the last element).
+/// @param [in] comp   Strict weak ordering; comp(a, b) returns true if a must come before b.
+template<typename RandomIt, typename Compare> void Sort(
+    RandomIt pStart,
+    RandomIt pEnd,
+    Compare  comp)
+{
+    const size_t count = size_t(pEnd - pStart);
+
+    if (count > 1)
+    {
+        IntroSortLoop(pStart, pEnd, 2 * Log2(count), comp);
+        InsertionSort(pStart, pEnd, comp);
+    }
+}
+
+/// In-place sort of an array. Not order-preserving for equal elements.
 /// Sorts the array given by the random iterator range [pStart,pEnd).
 /// The element type (the type you get by dereferencing RandomIt) must have an operator<.
 template<typename RandomIt> void Sort(
     RandomIt pStart,
     RandomIt pEnd)
 {
-    using ElementTy = typename std::iterator_traits<RandomIt>::value_type;
-    qsort(&pStart[0], pEnd - pStart, sizeof(ElementTy), SortComparisonFunc<ElementTy>);
+    Sort(pStart, pEnd, SortLess{});
+}
+
+/// @internal Reverses [pStart,pEnd) in place.
+template<typename RandomIt>
+void ReverseRange(
+    RandomIt pStart,
+    RandomIt pEnd)
+{
+    while ((pStart != pEnd) && (pStart != --pEnd))
+    {
+        Swap(*pStart, *pEnd);
+        ++pStart;
+    }
+}
+
+/// @internal Merges the adjacent sorted ranges [pStart,pMid) and [pMid,pEnd) in place and stably, by splitting the
+/// larger run in half, binary searching the matching cut in the other run and rotating the middle pieces.
+template<typename RandomIt, typename Compare>
+void MergeInPlace(
+    RandomIt pStart,
+    RandomIt pMid,
+    RandomIt pEnd,
+    Compare  comp)
+{
+    while ((pStart != pMid) && (pMid != pEnd))
+    {
+        if ((pEnd - pStart) == 2)
+        {
+            if (comp(*pMid, *pStart))
+            {
+                Swap(*pStart, *pMid);
+            }
+            break;
+        }
+
+        RandomIt pCut1;
+        RandomIt pCut2;
+        if ((pMid - pStart) > (pEnd - pMid))
+        {
+            // Lower bound of *pCut1 in the right run.
+            pCut1 = pStart + ((pMid - pStart) / 2);
+            pCut2 = pMid;
+            for (auto len = pEnd - pMid; len > 0;)
+            {
+                const auto half = len / 2;
+                if (comp(pCut2[half], *pCut1))
+                {
+                    pCut2 += half + 1;
+                    len   -= half + 1;
+                }
+                else
+                {
+                    len = half;
+                }
+            }
+        }
+        else
+        {
+            // Upper bound of *pCut2 in the left run.
+            pCut2 = pMid + ((pEnd - pMid) / 2);
+            pCut1 = pStart;
+            for (auto len = pMid - pStart; len > 0;)
+            {
+                const auto half = len / 2;
+                if (comp(*pCut2, pCut1[half]))
+                {
+                    len = half;
+                }
+                else
+                {
+                    pCut1 += half + 1;
+                    len   -= half + 1;
+                }
+            }
+        }
+
+        // Rotate [pCut1,pMid,pCut2) so the right run's prefix moves in front of the left run's suffix.
+        ReverseRange(pCut1, pMid);
+        ReverseRange(pMid, pCut2);
+        ReverseRange(pCut1, pCut2);
+        const RandomIt pNewMid = pCut1 + (pCut2 - pMid);
+
+        // Recurse on the smaller half and loop on the larger one.
+        if ((pNewMid - pStart) < (pEnd - pNewMid))
+        {
+            MergeInPlace(pStart, pCut1, pNewMid, comp);
+            pStart = pNewMid;
+            pMid   = pCut2;
+        }
+        else
+        {
+            MergeInPlace(pNewMid, pCut2, pEnd, comp);
+            pEnd = pNewMid;
+            pMid = pCut1;
+        }
+    }
+}
+
+/// In-place stable sort of an array with a caller-provided ordering: equal elements keep their relative order.
+/// Sorts the array given by the random iterator range [pStart,pEnd).
+///
+/// Insertion sorts small runs and merges them bottom-up without a scratch buffer, so it runs in O(n log^2 n) and
+/// never allocates.  Prefer Sort() when stability is not needed.
+///
+/// @param [in] pStart Start of the range.
+/// @param [in] pEnd   End of the range (one past the last element).
+/// @param [in] comp   Strict weak ordering; comp(a, b) returns true if a must come before b.
+template<typename RandomIt, typename Compare> void StableSort(
+    RandomIt pStart,
+    RandomIt pEnd,
+    Compare  comp)
+{
+    const size_t count = size_t(pEnd - pStart);
+
+    for (size_t runStart = 0; runStart < count; runStart += SortInsertionThreshold)
+    {
+        InsertionSort(pStart + runStart, pStart + Min(runStart + SortInsertionThreshold, count), comp);
+    }
+    for (size_t width = SortInsertionThreshold; width < count; width *= 2)
+    {
+        for (size_t runStart = 0; (runStart + width) < count; runStart += 2 * width)
+        {
+            MergeInPlace(pStart + runStart,
+                         pStart + runStart + width,
+                         pStart + Min(runStart + (2 * width), count),
+                         comp);
+        }
+    }
+}
+
+/// In-place stable sort of an array using the element type's operator<.  See the overload taking a comparator.
+template<typename RandomIt> void StableSort(
+    RandomIt pStart,
+    RandomIt pEnd)
+{
+    StableSort(pStart, pEnd, SortLess{});
+}
+
+/// Sorts an array of integers into ascending order with an LSD radix sort, one byte per pass.  Stable, O(n) and
+/// branch-light, which beats comparison sorting for large arrays of integer keys.  Passes in which every key has the
+/// same byte are skipped.
+///
+/// @param [in,out] pStart   Start of the range.
+/// @param [in,out] pEnd     End of the range (one past the last element).
+/// @param [in]     pScratch Caller-provided scratch storage for at least (pEnd - pStart) elements.
+template<typename ElementTy> void RadixSort(
+    ElementTy* pStart,
+    ElementTy* pEnd,
+    ElementTy* pScratch)
+{
+    static_assert(std::is_integral<ElementTy>::value && (std::is_same<ElementTy, bool>::value == false),
+                  "RadixSort requires integer keys");
+
+    using KeyTy = typename std::make_unsigned<ElementTy>::type;
+
+    // Flipping the sign bit maps signed keys onto the same order as unsigned ones.
+    constexpr KeyTy SignFlip = std::is_signed<ElementTy>::value ? KeyTy(KeyTy(1) << ((sizeof(KeyTy) * 8) - 1)) : 0;
+
+    const size_t count = size_t(pEnd - pStart);
+    ElementTy*   pSrc  = pStart;
+    ElementTy*   pDst  = pScratch;
+
+    if (count > 1)
+    {
+        size_t histogram[sizeof(ElementTy)][256] = {};
+        for (size_t idx = 0; idx < count; ++idx)
+        {
+            const KeyTy key = KeyTy(KeyTy(pStart[idx]) ^ SignFlip);
+            for (uint32 pass = 0; pass < sizeof(ElementTy); ++pass)
+            {
+                ++histogram[pass][(key >> (pass * 8)) & 0xFF];
+            }
+        }
+
+        for (uint32 pass = 0; pass < sizeof(ElementTy); ++pass)
+        {
+            const uint32 shift = pass * 8;
+
+            if (histogram[pass][(KeyTy(KeyTy(pSrc[0]) ^ SignFlip) >> shift) & 0xFF] != count)
+            {
+                size_t offset = 0;
+                for (uint32 bucket = 0; bucket < 256; ++bucket)
+                {
+                    const size_t bucketCount  = histogram[pass][bucket];
+                    histogram[pass][bucket] = offset;
+                    offset                 += bucketCount;
+                }
+
+                for (size_t idx = 0; idx < count; ++idx)
+                {
+                    const KeyTy key = KeyTy(KeyTy(pSrc[idx]) ^ SignFlip);
+                    pDst[histogram[pass][(key >> shift) & 0xFF]++] = pSrc[idx];
+                }
+
+                Swap(pSrc, pDst);
+            }
+        }
+
+        if (pSrc != pStart)
+        {
+            memcpy(pStart, pSrc, sizeof(ElementTy) * count);
+        }
+    }
 }
 
 } // Util
@@ -0,0 +1,163 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palIntrusiveListImpl.h
+ * @brief PAL utility collection IntrusiveList class implementation.
+ ***********************************************************************************************************************
+ */
+
+#pragma once
+
+#include "palIntrusiveList.h"
+
+namespace Util
+{
+
+// =====================================================================================================================
+// The sentinel links to itself, which makes the list empty.
+template<typename T>
+IntrusiveList<T>::IntrusiveList()
+    :
+    m_sentinel(),
+    m_numElements(0)
+{
+    m_sentinel.m_pPrev = &m_sentinel;
+    m_sentinel.m_pNext = &m_sentinel;
+}
+
+// =====================================================================================================================
+template<typename T>
+void IntrusiveList<T>::PushFrontList(
+    IntrusiveList<T>* pSource)
+{
+    PAL_ASSERT((pSource != nullptr) && (pSource != this) && (pSource->IsEmpty() == false));
+
+    Node*const pFirst = pSource->m_sentinel.m_pNext;
+    Node*const pLast  = pSource->m_sentinel.m_pPrev;
+
+    pLast->m_pNext              = m_sentinel.m_pNext;
+    m_sentinel.m_pNext->m_pPrev = pLast;
+    pFirst->m_pPrev             = &m_sentinel;
+    m_sentinel.m_pNext          = pFirst;
+    m_numElements              += pSource->m_numElements;
+
+    pSource->InvalidateList();
+}
+
+// =====================================================================================================================
+template<typename T>
+void IntrusiveList<T>::PushBackList(
+    IntrusiveList<T>* pSource)
+{
+    PAL_ASSERT((pSource != nullptr) && (pSource != this) && (pSource->IsEmpty() == false));
+
+    Node*const pFirst = pSource->m_sentinel.m_pNext;
+    Node*const pLast  = pSource->m_sentinel.m_pPrev;
+
+    pFirst->m_pPrev             = m_sentinel.m_pPrev;
+    m_sentinel.m_pPrev->m_pNext = pFirst;
+    pLast->m_pNext              = &m_sentinel;
+    m_sentinel.m_pPrev          = pLast;
+    m_numElements              += pSource->m_numElements;
+
+    pSource->InvalidateList();
+}
+
+// =====================================================================================================================
+template<typename T>
+void IntrusiveList<T>::InsertBefore(
+    const Iter& iter,
+    Node*       pNode)
+{
+    PAL_ASSERT(iter.m_pSentinel == &m_sentinel);
+
+    InsertBefore(iter.m_pCurrent, pNode);
+}
+
+// =====================================================================================================================
+template<typename T>
+void IntrusiveList<T>::Erase(
+    Iter* pIter)
+{
+    PAL_ASSERT((pIter != nullptr) && (pIter->m_pSentinel == &m_sentinel) && pIter->IsValid());
+
+    Node*const pNode = pIter->m_pCurrent;
+    pIter->Next();
+    Unlink(pNode);
+}
+
+// =====================================================================================================================
+template<typename T>
+void IntrusiveList<T>::Erase(
+    Node* pNode)
+{
+    PAL_ASSERT((pNode != nullptr) && (pNode != &m_sentinel));
+
+    Unlink(pNode);
+}
+
+// =====================================================================================================================
+// Unlinks every node, so each one reports InList() == false afterwards.
+template<typename T>
+void IntrusiveList<T>::EraseAll()
+{
+    while (IsEmpty() == false)
+    {
+        Unlink(m_sentinel.m_pNext);
+    }
+}
+
+// =====================================================================================================================
+template<typename T>
+void IntrusiveList<T>::InsertBefore(
+    Node* pBeforeMe,
+    Node* pNode)
+{
+    PAL_ASSERT((pNode != nullptr) && (pNode->InList() == false));
+
+    pNode->m_pNext              = pBeforeMe;
+    pNode->m_pPrev              = pBeforeMe->m_pPrev;
+    pBeforeMe->m_pPrev->m_pNext = pNode;
+    pBeforeMe->m_pPrev          = pNode;
+    ++m_numElements;
+}
+
+// =====================================================================================================================
+// Links pNode's neighbors to each other and clears pNode's links, so InList() reports false.
+template<typename T>
+void IntrusiveList<T>::Unlink(
+    Node* pNode)
+{
+    PAL_ASSERT(pNode->InList() && (m_numElements > 0));
+
+    pNode->m_pPrev->m_pNext = pNode->m_pNext;
+    pNode->m_pNext->m_pPrev = pNode->m_pPrev;
+    pNode->m_pPrev          = nullptr;
+    pNode->m_pNext          = nullptr;
+    --m_numElements;
+}
+
+} // Util
@@ -0,0 +1,702 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palLruCache.h
+ * @brief PAL utility collection LruCache and ShardedLruCache class declarations and implementations.
+ ***********************************************************************************************************************
+ */
+
+#pragma once
+
+#include "palHashMapImpl.h"
+#include "palIntrusiveListImpl.h"
+#include "palMutex.h"
+#include <atomic>
+
+namespace Util
+{
+
+/// Replacement policies supported by LruCache.
+enum class LruCachePolicy : uint32
+{
+    Lru   = 0,  ///< Every hit moves the entry to the front of the recency list.
+    Clock = 1,  ///< A hit only sets the entry's reference flag.  Eviction walks the list from the back and gives
+                ///  entries whose flag is set a second chance, so hits never relink the list.
+};
+
+/// Specifies the limits and behavior of an LruCache.  A limit of zero means no limit.
+struct LruCacheCreateInfo
+{
+    uint64         maxBytes;    ///< Sum of the entry sizes passed to Insert() which the cache may hold.
+    uint32         maxEntries;  ///< Number of entries the cache may hold.
+    uint32         numBuckets;  ///< Number of buckets in the cache's hash map.
+    LruCachePolicy policy;      ///< Replacement policy.
+};
+
+/**
+ ***********************************************************************************************************************
+ * @brief Bounded key/value cache which evicts the least recently used entries.
+ *
+ * Entries are found through a HashMap and kept in an IntrusiveList ordered from most to least recently used.  The
+ * cache is bounded by the number of entries, by the total size of the entries as given by the caller, or both.  When an
+ * insertion would exceed a limit, entries are evicted from the back of the list until it fits.
+ *
+ * An optional eviction callback is invoked for every value that leaves the cache, whether it was evicted, erased,
+ * replaced by Insert(), cleared or destroyed with the cache, so the owner can release whatever the value refers to.
+ * The callback must not call back into the cache.
+ *
+ * Key must be usable as a HashMap key.  Value must be copy-constructible and copy-assignable.
+ *
+ * @warning This class is not thread-safe, except that in LruCachePolicy::Clock mode Find() only sets an atomic flag, so
+ *          concurrent Find() calls are safe as long as nothing else modifies the cache.  See ShardedLruCache.
+ ***********************************************************************************************************************
+ */
+template<typename Key,
+         typename Value,
+         typename Allocator,
+         template<typename> class HashFunc  = DefaultHashFunc,
+         template<typename> class EqualFunc = DefaultEqualFunc>
+class LruCache
+{
+public:
+    /// Called for each value that leaves the cache.
+    typedef void (*EvictFunc)(void* pUserData, const Key& key, Value* pValue);
+
+    /// Constructor.
+    ///
+    /// @param [in] createInfo Limits and policy of the cache.
+    /// @param [in] pAllocator The allocator that will allocate memory if required.
+    LruCache(const LruCacheCreateInfo& createInfo, Allocator*const pAllocator);
+    ~LruCache() { Clear(); }
+
+    /// Initializes the hash map.  Must be called before any other member.
+    ///
+    /// @returns @ref Success, or @ref ErrorOutOfMemory if the hash map could not be allocated.
+    Result Init() { return m_map.Init(); }
+
+    /// Sets the function called for each value that leaves the cache.
+    void SetEvictCallback(EvictFunc pfnEvict, void* pUserData)
+    {
+        m_pfnEvict       = pfnEvict;
+        m_pEvictUserData = pUserData;
+    }
+
+    /// Looks up a key and marks its entry as recently used.
+    ///
+    /// @param [in] key Key to search for.
+    ///
+    /// @returns A pointer to the cached value, valid until the cache is next modified, or null on a miss.
+    Value* Find(const Key& key);
+
+    /// Inserts a value, or replaces the value cached for the key, evicting other entries as needed to stay within the
+    /// cache's limits.
+    ///
+    /// @param [in] key   Key of the entry.
+    /// @param [in] value Value to cache.
+    /// @param [in] bytes Size charged against the cache's byte limit for this entry.
+    ///
+    /// @returns @ref Success, @ref ErrorInvalidMemorySize if bytes alone exceeds the byte limit, or
+    ///          @ref ErrorOutOfMemory if an internal allocation failed.  Nothing is inserted on failure, but entries
+    ///          may already have been evicted to make room.
+    Result Insert(const Key& key, const Value& value, uint64 bytes);
+
+    /// Removes the entry for a key.
+    ///
+    /// @returns True if the entry existed.
+    bool Erase(const Key& key);
+
+    /// Removes every entry.
+    void Clear();
+
+    /// Changes the cache's limits, evicting entries until the cache is within the new ones.
+    void SetLimits(uint64 maxBytes, uint32 maxEntries);
+
+    /// Returns the number of entries in the cache.
+    uint32 NumEntries() const { return static_cast<uint32>(m_list.NumElements()); }
+
+    /// Returns the sum of the sizes of the entries in the cache.
+    uint64 NumBytes() const { return m_numBytes; }
+
+    /// Returns the number of entries evicted to make room for others since the cache was created.
+    uint64 NumEvictions() const { return m_numEvictions; }
+
+    /// Returns the replacement policy.
+    LruCachePolicy Policy() const { return m_policy; }
+
+private:
+    struct Entry
+    {
+        Entry(const Key& key, const Value& value, uint64 bytes) :
+            key(key), value(value), bytes(bytes), referenced(0), node(this) { }
+
+        Key                     key;
+        Value                   value;
+        uint64                  bytes;
+        std::atomic<uint8>      referenced;  // Set by hits in Clock mode.
+        IntrusiveListNode<Entry> node;
+    };
+
+    typedef HashMap<Key, Entry*, Allocator, HashFunc, EqualFunc> EntryMap;
+
+    bool OverLimit(uint64 extraBytes, uint32 extraEntries) const
+    {
+        return ((m_maxBytes != 0) && ((m_numBytes + extraBytes) > m_maxBytes)) ||
+               ((m_maxEntries != 0) && ((NumEntries() + extraEntries) > m_maxEntries));
+    }
+
+    void Evict(uint64 extraBytes, uint32 extraEntries);
+    void Remove(Entry* pEntry);
+
+    const LruCachePolicy m_policy;
+    uint64               m_maxBytes;
+    uint32               m_maxEntries;
+    uint64               m_numBytes;
+    uint64               m_numEvictions;
+    EntryMap             m_map;
+    IntrusiveList<Entry> m_list;         // Most recently used (or inserted, in Clock mode) entry first.
+    EvictFunc            m_pfnEvict;
+    void*                m_pEvictUserData;
+    Allocator*const      m_pAllocator;
+
+    PAL_DISALLOW_DEFAULT_CTOR(LruCache);
+    PAL_DISALLOW_COPY_AND_ASSIGN(LruCache);
+};
+
+// =====================================================================================================================
+template<typename Key, typename Value, typename Allocator, template<typename> class HashFunc,
+         template<typename> class EqualFunc>
+LruCache<Key, Value, Allocator, HashFunc, EqualFunc>::LruCache(
+    const LruCacheCreateInfo& createInfo,
+    Allocator*const           pAllocator)
+    :
+    m_policy(createInfo.policy),
+    m_maxBytes(createInfo.maxBytes),
+    m_maxEntries(createInfo.maxEntries),
+    m_numBytes(0),
+    m_numEvictions(0),
+    m_map(createInfo.numBuckets, pAllocator),
+    m_pfnEvict(nullptr),
+    m_pEvictUserData(nullptr),
+    m_pAllocator(pAllocator)
+{
+}
+
+// =====================================================================================================================
+template<typename Key, typename Value, typename Allocator, template<typename> class HashFunc,
+         template<typename> class EqualFunc>
+Value* LruCache<Key, Value, Allocator, HashFunc, EqualFunc>::Find(
+    const Key& key)
+{
+    Entry*const* ppEntry = m_map.FindKey(key);
+    Value*       pValue  = nullptr;
+
+    if (ppEntry != nullptr)
+    {
+        Entry*const pEntry = *ppEntry;
+
+        if (m_policy == LruCachePolicy::Lru)
+        {
+            m_list.Erase(&pEntry->node);
+            m_list.PushFront(&pEntry->node);
+        }
+        else if (pEntry->referenced.load(std::memory_order_relaxed) == 0)
+        {
+            // Only write the flag when it changes, so hot entries do not keep dirtying their cache line.
+            pEntry->referenced.store(1, std::memory_order_relaxed);
+        }
+
+        pValue = &pEntry->value;
+    }
+
+    return pValue;
+}
+
+// =====================================================================================================================
+template<typename Key, typename Value, typename Allocator, template<typename> class HashFunc,
+         template<typename> class EqualFunc>
+Result LruCache<Key, Value, Allocator, HashFunc, EqualFunc>::Insert(
+    const Key&   key,
+    const Value& value,
+    uint64       bytes)
+{
+    Result result = Result::Success;
+
+    if ((m_maxBytes != 0) && (bytes > m_maxBytes))
+    {
+        result = Result::ErrorInvalidMemorySize;
+    }
+    else
+    {
+        Entry*const* ppExisting = m_map.FindKey(key);
+
+        if (ppExisting != nullptr)
+        {
+            Entry*const pEntry = *ppExisting;
+
+            if (m_pfnEvict != nullptr)
+            {
+                m_pfnEvict(m_pEvictUserData, pEntry->key, &pEntry->value);
+            }
+            pEntry->value = value;
+            m_numBytes    = m_numBytes - pEntry->bytes + bytes;
+            pEntry->bytes = bytes;
+
+            m_list.Erase(&pEntry->node);
+            m_list.PushFront(&pEntry->node);
+
+            // The replaced entry must survive the eviction below.  In Lru mode it is at the front, so it is only
+            // reached once every other entry is gone.  In Clock mode, entries given a second chance are pushed in front
+            // of it, so it could reach the back first; marking it referenced gives it a second chance too, and it is
+            // only reached again once every other entry is gone.  It fits alone, since bytes is within the byte limit.
+            if (m_policy == LruCachePolicy::Clock)
+            {
+                pEntry->referenced.store(1, std::memory_order_relaxed);
+            }
+            Evict(0, 0);
+        }
+        else
+        {
+            Entry*const pEntry  = PAL_NEW(Entry, m_pAllocator, AllocInternal)(key, value, bytes);
+            Entry**     ppSlot  = nullptr;
+            bool        existed = false;
+
+            if (pEntry != nullptr)
+            {
+                // Make room first: erasing from the hash map moves its entries, which would invalidate ppSlot.
+                Evict(bytes, 1);
+                result = m_map.FindAllocate(key, &existed, &ppSlot);
+            }
+            else
+            {
+                result = Result::ErrorOutOfMemory;
+            }
+
+            if (result == Result::Success)
+            {
+                *ppSlot     = pEntry;
+                m_numBytes += bytes;
+                m_list.PushFront(&pEntry->node);
+            }
+            else if (pEntry != nullptr)
+            {
+                PAL_DELETE(pEntry, m_pAllocator);
+            }
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Evicts entries from the back of the list until extraBytes and extraEntries more would fit.  In Clock mode, an entry
+// whose reference flag is set has the flag cleared and goes back to the front instead; every entry is visited at most
+// twice.
+template<typename Key, typename Value, typename Allocator, template<typename> class HashFunc,
+         template<typename> class EqualFunc>
+void LruCache<Key, Value, Allocator, HashFunc, EqualFunc>::Evict(
+    uint64 extraBytes,
+    uint32 extraEntries)
+{
+    while ((m_list.IsEmpty() == false) && OverLimit(extraBytes, extraEntries))
+    {
+        Entry*const pVictim = m_list.Back();
+
+        if ((m_policy == LruCachePolicy::Clock) && (pVictim->referenced.load(std::memory_order_relaxed) != 0))
+        {
+            pVictim->referenced.store(0, std::memory_order_relaxed);
+            m_list.Erase(&pVictim->node);
+            m_list.PushFront(&pVictim->node);
+        }
+        else
+        {
+            Remove(pVictim);
+            ++m_numEvictions;
+        }
+    }
+}
+
+// =====================================================================================================================
+template<typename Key, typename Value, typename Allocator, template<typename> class HashFunc,
+         template<typename> class EqualFunc>
+void LruCache<Key, Value, Allocator, HashFunc, EqualFunc>::Remove(
+    Entry* pEntry)
+{
+    m_map.Erase(pEntry->key);
+    m_list.Erase(&pEntry->node);
+    m_numBytes -= pEntry->bytes;
+
+    if (m_pfnEvict != nullptr)
+    {
+        m_pfnEvict(m_pEvictUserData, pEntry->key, &pEntry->value);
+    }
+
+    PAL_DELETE(pEntry, m_pAllocator);
+}
+
+// =====================================================================================================================
+template<typename Key, typename Value, typename Allocator, template<typename> class HashFunc,
+         template<typename> class EqualFunc>
+bool LruCache<Key, Value, Allocator, HashFunc, EqualFunc>::Erase(
+    const Key& key)
+{
+    Entry*const* ppEntry = m_map.FindKey(key);
+
+    if (ppEntry != nullptr)
+    {
+        Remove(*ppEntry);
+    }
+
+    return (ppEntry != nullptr);
+}
+
+// =====================================================================================================================
+template<typename Key, typename Value, typename Allocator, template<typename> class HashFunc,
+         template<typename> class EqualFunc>
+void LruCache<Key, Value, Allocator, HashFunc, EqualFunc>::Clear()
+{
+    while (m_list.IsEmpty() == false)
+    {
+        Remove(m_list.Back());
+    }
+}
+
+// =====================================================================================================================
+template<typename Key, typename Value, typename Allocator, template<typename> class HashFunc,
+         template<typename> class EqualFunc>
+void LruCache<Key, Value, Allocator, HashFunc, EqualFunc>::SetLimits(
+    uint64 maxBytes,
+    uint32 maxEntries)
+{
+    m_maxBytes   = maxBytes;
+    m_maxEntries = maxEntries;
+    Evict(0, 0);
+}
+
+/**
+ ***********************************************************************************************************************
+ * @brief LruCache split into NumShards independently locked shards for concurrent use.
+ *
+ * Each key belongs to one shard, chosen from its hash, and each shard is an LruCache with its own lock.  In
+ * LruCachePolicy::Lru mode every operation, including a hit, relinks the recency list, so each shard is guarded by a
+ * plain Mutex.  In LruCachePolicy::Clock mode a hit only sets a flag, so each shard is guarded by an RWLock which
+ * lookups take for reading, and concurrent hits on the same shard do not serialize.
+ *
+ * The limits are split between the shards and enforced per shard: the shares add up to exactly the given limits, but a
+ * shard evicts once it reaches its own share even if other shards have room.  An entry larger than one shard's share
+ * of the byte limit cannot be inserted.  Each nonzero limit must therefore be at least NumShards, and in practice
+ * should be many times larger.  Likewise, recency is tracked per shard, so the entry evicted is the least recently
+ * used one of its shard rather than of the whole cache.  The eviction callback may be called concurrently for entries
+ * of different shards.
+ ***********************************************************************************************************************
+ */
+template<typename Key,
+         typename Value,
+         typename Allocator,
+         template<typename> class HashFunc  = DefaultHashFunc,
+         template<typename> class EqualFunc = DefaultEqualFunc,
+         uint32 NumShards = 16>
+class ShardedLruCache
+{
+    static_assert(IsPowerOfTwo(NumShards), "NumShards must be a power of two.");
+
+public:
+    /// The cache type each shard holds.
+    typedef LruCache<Key, Value, Allocator, HashFunc, EqualFunc> Cache;
+
+    /// Constructor.
+    ///
+    /// @param [in] createInfo Limits and policy of the whole cache; each shard gets 1/NumShards of each limit and of
+    ///                        the hash buckets.  Nonzero limits must be at least NumShards.
+    /// @param [in] pAllocator The allocator that will allocate memory if required.
+    ShardedLruCache(const LruCacheCreateInfo& createInfo, Allocator*const pAllocator);
+    ~ShardedLruCache();
+
+    /// Initializes every shard.  Must be called before any other member.
+    Result Init();
+
+    /// Sets the function called for each value that leaves the cache.  Must not be called concurrently with other
+    /// members.
+    void SetEvictCallback(typename Cache::EvictFunc pfnEvict, void* pUserData);
+
+    /// Looks up a key, marks its entry as recently used and copies its value to pValue.
+    ///
+    /// @returns True on a hit.
+    bool Find(const Key& key, Value* pValue);
+
+    /// Inserts a value, or replaces the value cached for the key.  See LruCache::Insert().
+    Result Insert(const Key& key, const Value& value, uint64 bytes);
+
+    /// Removes the entry for a key.
+    ///
+    /// @returns True if the entry existed.
+    bool Erase(const Key& key);
+
+    /// Removes every entry.
+    void Clear();
+
+    /// Returns the number of entries in the cache.  Only exact if no other thread is modifying the cache.
+    uint32 NumEntries();
+
+    /// Returns the sum of the sizes of the entries in the cache.  Only exact if no other thread is modifying the cache.
+    uint64 NumBytes();
+
+private:
+    struct alignas(PAL_CACHE_LINE_BYTES) Shard
+    {
+        Shard(const LruCacheCreateInfo& createInfo, Allocator*const pAllocator) : cache(createInfo, pAllocator) { }
+
+        Mutex  mutex;   // Guards the cache in Lru mode.
+        RWLock rwLock;  // Guards the cache in Clock mode.
+        Cache  cache;
+    };
+
+    // Locks a shard with the lock its policy uses: the Mutex in Lru mode, or the RWLock in Clock mode, where readOnly
+    // selects a shared lock.
+    class ShardLockAuto
+    {
+    public:
+        ShardLockAuto(Shard* pShard, LruCachePolicy policy, bool readOnly)
+            :
+            m_pShard(pShard),
+            m_useMutex(policy == LruCachePolicy::Lru),
+            m_readOnly(readOnly)
+        {
+            if (m_useMutex)
+            {
+                m_pShard->mutex.Lock();
+            }
+            else if (m_readOnly)
+            {
+                m_pShard->rwLock.LockForRead();
+            }
+            else
+            {
+                m_pShard->rwLock.LockForWrite();
+            }
+        }
+
+        ~ShardLockAuto()
+        {
+            if (m_useMutex)
+            {
+                m_pShard->mutex.Unlock();
+            }
+            else if (m_readOnly)
+            {
+                m_pShard->rwLock.UnlockForRead();
+            }
+            else
+            {
+                m_pShard->rwLock.UnlockForWrite();
+            }
+        }
+
+    private:
+        Shard*const m_pShard;
+        const bool  m_useMutex;
+        const bool  m_readOnly;
+
+        PAL_DISALLOW_COPY_AND_ASSIGN(ShardLockAuto);
+    };
+
+    // Returns shard's share of limit: limit / NumShards, plus one for the first (limit % NumShards) shards, so the
+    // shares add up to limit.
+    template<typename T>
+    static T ShardLimit(T limit, uint32 shard)
+    {
+        return (limit / NumShards) + ((shard < (limit % NumShards)) ? 1 : 0);
+    }
+
+    Shard* GetShard(const Key& key)
+    {
+        // Remix the hash so the shard does not depend on the same low bits which pick the bucket within the shard.
+        const uint32 hash = m_hashFunc(&key, static_cast<uint32>(sizeof(Key))) * 0x9E3779B1u;
+        return &Shards()[(NumShards > 1) ? (hash >> (32 - Log2(NumShards))) : 0];
+    }
+
+    Shard* Shards() { return reinterpret_cast<Shard*>(&m_shardStorage[0]); }
+
+    const LruCachePolicy m_policy;
+    HashFunc<Key>        m_hashFunc;
+    alignas(Shard) uint8 m_shardStorage[sizeof(Shard) * NumShards];
+
+    PAL_DISALLOW_DEFAULT_CTOR(ShardedLruCache);
+    PAL_DISALLOW_COPY_AND_ASSIGN(ShardedLruCache);
+};
+
+// =====================================================================================================================
+template<typename Key, typename Value, typename Allocator, template<typename> class HashFunc,
+         template<typename> class EqualFunc, uint32 NumShards>
+ShardedLruCache<Key, Value, Allocator, HashFunc, EqualFunc, NumShards>::ShardedLruCache(
+    const LruCacheCreateInfo& createInfo,
+    Allocator*const           pAllocator)
+    :
+    m_policy(createInfo.policy)
+{
+    // A zero share would mean no limit for that shard.
+    PAL_ASSERT((createInfo.maxBytes == 0) || (createInfo.maxBytes >= NumShards));
+    PAL_ASSERT((createInfo.maxEntries == 0) || (createInfo.maxEntries >= NumShards));
+
+    LruCacheCreateInfo shardInfo = createInfo;
+    shardInfo.numBuckets = Max(RoundUpQuotient(createInfo.numBuckets, NumShards), 1u);
+
+    for (uint32 i = 0; i < NumShards; ++i)
+    {
+        shardInfo.maxBytes   = ShardLimit(createInfo.maxBytes, i);
+        shardInfo.maxEntries = ShardLimit(createInfo.maxEntries, i);
+        PAL_PLACEMENT_NEW(&Shards()[i]) Shard(shardInfo, pAllocator);
+    }
+}
+
+// =====================================================================================================================
+template<typename Key, typename Value, typename Allocator, template<typename> class HashFunc,
+         template<typename> class EqualFunc, uint32 NumShards>
+ShardedLruCache<Key, Value, Allocator, HashFunc, EqualFunc, NumShards>::~ShardedLruCache()
+{
+    for (uint32 i = 0; i < NumShards; ++i)
+    {
+        Shards()[i].~Shard();
+    }
+}
+
+// =====================================================================================================================
+template<typename Key, typename Value, typename Allocator, template<typename> class HashFunc,
+         template<typename> class EqualFunc, uint32 NumShards>
+Result ShardedLruCache<Key, Value, Allocator, HashFunc, EqualFunc, NumShards>::Init()
+{
+    Result result = Result::Success;
+
+    for (uint32 i = 0; (i < NumShards) && (result == Result::Success); ++i)
+    {
+        result = Shards()[i].cache.Init();
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template<typename Key, typename Value, typename Allocator, template<typename> class HashFunc,
+         template<typename> class EqualFunc, uint32 NumShards>
+void ShardedLruCache<Key, Value, Allocator, HashFunc, EqualFunc, NumShards>::SetEvictCallback(
+    typename Cache::EvictFunc pfnEvict,
+    void*                     pUserData)
+{
+    for (uint32 i = 0; i < NumShards; ++i)
+    {
+        Shards()[i].cache.SetEvictCallback(pfnEvict, pUserData);
+    }
+}
+
+// =====================================================================================================================
+template<typename Key, typename Value, typename Allocator, template<typename> class HashFunc,
+         template<typename> class EqualFunc, uint32 NumShards>
+bool ShardedLruCache<Key, Value, Allocator, HashFunc, EqualFunc, NumShards>::Find(
+    const Key& key,
+    Value*     pValue)
+{
+    Shard*const pShard = GetShard(key);
+    ShardLockAuto lock(pShard, m_policy, true);
+
+    const Value*const pFound = pShard->cache.Find(key);
+    if (pFound != nullptr)
+    {
+        *pValue = *pFound;
+    }
+
+    return (pFound != nullptr);
+}
+
+// =====================================================================================================================
+template<typename Key, typename Value, typename Allocator, template<typename> class HashFunc,
+         template<typename> class EqualFunc, uint32 NumShards>
+Result ShardedLruCache<Key, Value, Allocator, HashFunc, EqualFunc, NumShards>::Insert(
+    const Key&   key,
+    const Value& value,
+    uint64       bytes)
+{
+    Shard*const pShard = GetShard(key);
+    ShardLockAuto lock(pShard, m_policy, false);
+
+    return pShard->cache.Insert(key, value, bytes);
+}
+
+// =====================================================================================================================
+template<typename Key, typename Value, typename Allocator, template<typename> class HashFunc,
+         template<typename> class EqualFunc, uint32 NumShards>
+bool ShardedLruCache<Key, Value, Allocator, HashFunc, EqualFunc, NumShards>::Erase(
+    const Key& key)
+{
+    Shard*const pShard = GetShard(key);
+    ShardLockAuto lock(pShard, m_policy, false);
+
+    return pShard->cache.Erase(key);
+}
+
+// =====================================================================================================================
+template<typename Key, typename Value, typename Allocator, template<typename> class HashFunc,
+         template<typename> class EqualFunc, uint32 NumShards>
+void ShardedLruCache<Key, Value, Allocator, HashFunc, EqualFunc, NumShards>::Clear()
+{
+    for (uint32 i = 0; i < NumShards; ++i)
+    {
+        ShardLockAuto lock(&Shards()[i], m_policy, false);
+        Shards()[i].cache.Clear();
+    }
+}
+
+// =====================================================================================================================
+template<typename Key, typename Value, typename Allocator, template<typename> class HashFunc,
+         template<typename> class EqualFunc, uint32 NumShards>
+uint32 ShardedLruCache<Key, Value, Allocator, HashFunc, EqualFunc, NumShards>::NumEntries()
+{
+    uint32 numEntries = 0;
+
+    for (uint32 i = 0; i < NumShards; ++i)
+    {
+        ShardLockAuto lock(&Shards()[i], m_policy, true);
+        numEntries += Shards()[i].cache.NumEntries();
+    }
+
+    return numEntries;
+}
+
+// =====================================================================================================================
+template<typename Key, typename Value, typename Allocator, template<typename> class HashFunc,
+         template<typename> class EqualFunc, uint32 NumShards>
+uint64 ShardedLruCache<Key, Value, Allocator, HashFunc, EqualFunc, NumShards>::NumBytes()
+{
+    uint64 numBytes = 0;
+
+    for (uint32 i = 0; i < NumShards; ++i)
+    {
+        ShardLockAuto lock(&Shards()[i], m_policy, true);
+        numBytes += Shards()[i].cache.NumBytes();
+    }
+
+    return numBytes;
+}
+
+} // Util
@@ -36,6 +36,8 @@
 #include "palIntrusiveList.h"
 #include "palMutex.h"
 
+#include <atomic>
+
 namespace Util
 {
 
@@ -72,15 +74,36 @@ struct MemTrackerElem
     uint32          lineNumber; ///< Line number that requested allocation.
     void*           pClientMem; ///< Starting "client usable" data address.
     void*           pOrigMem;   ///< Original address of the allocation returned from our underlying allocator.
-    size_t          allocNum;   ///< The number of the memory allocation. 1 based.
+    size_t          allocNum;   ///< The number of the memory allocation. 1 based.  Counts sampled allocations only.
     MemTrackerList* pList;      ///< The list this struct is in. It helps check which MemTracker owns this struct.
 };
 
+/// @internal
+///
+/// Header placed in front of allocations which were not sampled by the MemTracker.  It carries just enough to free the
+/// block and keep the byte counts exact.  The tag is the last field so it sits directly in front of the client memory,
+/// where a sampled allocation has its underrun marker.
+struct MemTrackerUntrackedElem
+{
+    void*       pOrigMem;   ///< Original address of the allocation returned from our underlying allocator.
+    size_t      size;       ///< Size of allocation request.
+    MemBlkType  blockType;  ///< Memory block type (malloc, new, new array).
+    uint32      tag;        ///< MemTracker::UntrackedSentinel while the block is live.
+};
+
 /**
  ***********************************************************************************************************************
  * @brief Class responsible for tracking allocations and frees to notify the developer of memory leaks.
  *
  * Tracking is enabled/disabled via the PAL_MEMTRACK define.
+ *
+ * Active allocations are spread over a fixed number of shards, each with its own list and lock, so threads allocating
+ * concurrently rarely contend.  A thread always adds to the same shard; a free goes to whichever shard owns the block.
+ *
+ * The tracker can sample 1-in-N allocations instead of all of them.  Sampled allocations get the full treatment (leak
+ * list, file and line, underrun/overrun markers).  The others only get a small header and are counted, so the live
+ * byte and allocation totals stay exact, but they are not named in the leak report and are not freed on destruction.
+ * The rate comes from the constructor or, failing that, the AMDPAL_MEMTRACK_SAMPLE_RATE environment variable.
  ***********************************************************************************************************************
  */
 template <typename Allocator>
@@ -90,7 +113,9 @@ public:
     /// Constructor.
     ///
     /// @param [in] pAllocator The allocator that will allocate memory if required.
-    MemTracker(Allocator*const pAllocator);
+    /// @param [in] sampleRate Track one out of every sampleRate allocations.  1 tracks everything; 0 reads the rate
+    ///                        from AMDPAL_MEMTRACK_SAMPLE_RATE and tracks everything if that is not set.
+    MemTracker(Allocator*const pAllocator, uint32 sampleRate = 0);
     ~MemTracker();
 
     /// Performs any non-safe initialization that cannot be done in the constructor.
@@ -112,6 +137,19 @@ public:
     void Free(
         const FreeInfo& freeInfo);
 
+    /// Returns the number of allocations made through this tracker so far, sampled or not.
+    size_t NumAllocs() { return SumCounters().numAllocs; }
+
+    /// Returns the number of live allocations, sampled or not.  Only exact while no other thread allocates or frees.
+    size_t NumLiveAllocs() { return SumCounters().liveAllocs; }
+
+    /// Returns the client bytes held by live allocations, sampled or not.  Only exact while no other thread allocates
+    /// or frees.
+    size_t NumLiveBytes() { return SumCounters().liveBytes; }
+
+    /// Returns the sampling rate in use: one in this many allocations is tracked.
+    uint32 SampleRate() const { return m_sampleRate; }
+
 private:
     void* AddMemElement(
         void*       pMem,
@@ -123,6 +161,24 @@ private:
 
     void* RemoveMemElement(void* pMem, MemBlkType blockType);
 
+    void* AddUntrackedElement(void* pMem, size_t bytes, size_t align, MemBlkType blockType);
+    void* RemoveUntrackedElement(void* pClientMem, MemBlkType blockType);
+
+    static uint32 ThreadShard();
+    static bool   SampleThisAlloc(uint32 sampleRate);
+
+    // Totals over all shards, sampled and untracked allocations together.
+    struct Counters
+    {
+        size_t numAllocs;
+        size_t liveAllocs;
+        size_t liveBytes;
+        size_t untrackedAllocs;  // Live allocations which were not sampled.
+        size_t untrackedBytes;   // Bytes held by live allocations which were not sampled.
+    };
+
+    Counters SumCounters();
+
     void MemoryReport();
     void FreeLeakedMemory();
 
@@ -130,6 +186,11 @@ private:
     static constexpr uint32 UnderrunSentinel = 0xDEADBEEF;
     // Sentinel patterns used to detect memory overrun.
     static constexpr uint32 OverrunSentinel  = 0xCAFEBABE;
+    // Tag written in front of allocations which were not sampled.
+    static constexpr uint32 UntrackedSentinel = 0xFEEDFACE;
+
+    // Number of tracker shards.  Must be a power of two.
+    static constexpr uint32 NumShards = 16;
 
     // Size of markers for underruns/overruns.  Setting this to 0 disables this feature.
     static constexpr size_t MarkerSizeUints = PAL_CACHE_LINE_BYTES / sizeof(uint32);
@@ -137,8 +198,21 @@ private:
     // Size of underrun/overrun markers in bytes.
     static constexpr size_t MarkerSizeBytes = MarkerSizeUints * sizeof(uint32);
 
-    MemTrackerList     m_trackerList;      // The list of active allocations.
-    Mutex              m_mutex;            // Serializes access to list of active allocations.
+    // One slice of the tracker state.  Sampled allocations are counted under the shard lock, which they take anyway;
+    // the others are counted with atomics by whichever thread allocates or frees them.  The untracked byte count may
+    // therefore go negative (wrap) in one shard; only its sum across shards is meaningful.
+    struct alignas(PAL_CACHE_LINE_BYTES) Shard
+    {
+        MemTrackerList      trackerList;      // The sampled allocations added by threads mapped to this shard.
+        Mutex               mutex;            // Serializes access to trackerList and the tracked counters.
+        size_t              trackedAllocs;    // Sampled allocations added to this shard.
+        size_t              trackedBytes;     // Bytes held by the sampled allocations in trackerList.
+        std::atomic<size_t> untrackedAllocs;  // Unsampled allocations made by threads mapped to this shard.
+        std::atomic<size_t> untrackedFrees;   // Unsampled frees made by threads mapped to this shard.
+        std::atomic<size_t> untrackedBytes;   // Unsampled bytes allocated minus freed by threads mapped to this shard.
+    };
+
+    Shard              m_shards[NumShards];
 
     const size_t       m_markerSizeUints;  // Member variable copy of MarkerSizeUints.  Only used to prevent compiler
                                            //  warnings when MarkerSizeUints is 0.
@@ -147,8 +221,9 @@ private:
 
     Allocator*const    m_pAllocator;       // Allocator for performing the actual allocations.
 
-    size_t             m_nextAllocNum;     // The allocation number that the next allocated block will receive.
+    std::atomic<size_t> m_nextAllocNum;    // The allocation number that the next sampled block will receive.
     const size_t       m_breakOnAllocNum;  // The allocation number to trigger a debug break on.
+    uint32             m_sampleRate;       // One in this many allocations is tracked.
 
     PAL_DISALLOW_COPY_AND_ASSIGN(MemTracker);
 };
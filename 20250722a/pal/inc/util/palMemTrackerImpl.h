@@ -37,6 +37,7 @@
 #include "palMemTracker.h"
 #include "palSysMemory.h"
 
+#include <cstdlib>
 #include <cstring>
 
 namespace Util
@@ -53,14 +54,40 @@ constexpr const char* MemBlkTypeStr[] =
 // =====================================================================================================================
 template <typename Allocator>
 MemTracker<Allocator>::MemTracker(
-    Allocator*const pAllocator)
+    Allocator*const pAllocator,
+    uint32          sampleRate)
     :
     m_markerSizeUints(MarkerSizeUints),
     m_markerSizeBytes(MarkerSizeBytes),
     m_pAllocator(pAllocator),
     m_nextAllocNum(1),
-    m_breakOnAllocNum(0)
+    m_breakOnAllocNum(0),
+    m_sampleRate(sampleRate)
 {
+    static_assert(IsPowerOfTwo(NumShards), "NumShards must be a power of two.");
+
+    for (uint32 i = 0; i < NumShards; ++i)
+    {
+        m_shards[i].trackedAllocs = 0;
+        m_shards[i].trackedBytes  = 0;
+        m_shards[i].untrackedAllocs.store(0, std::memory_order_relaxed);
+        m_shards[i].untrackedFrees.store(0, std::memory_order_relaxed);
+        m_shards[i].untrackedBytes.store(0, std::memory_order_relaxed);
+    }
+
+    if (m_sampleRate == 0)
+    {
+        const char* pRate = getenv("AMDPAL_MEMTRACK_SAMPLE_RATE");
+
+        m_sampleRate = (pRate != nullptr) ? static_cast<uint32>(atoi(pRate)) : 1;
+    }
+
+    // Untracked blocks are told apart from tracked ones by the marker in front of the client memory, so sampling
+    // needs the markers.
+    if ((m_sampleRate == 0) || (m_markerSizeBytes == 0))
+    {
+        m_sampleRate = 1;
+    }
 }
 
 // =====================================================================================================================
@@ -68,9 +95,9 @@ template <typename Allocator>
 MemTracker<Allocator>::~MemTracker()
 {
     // Clean-up leaked memory if needed
-    if (m_trackerList.IsEmpty() == false)
+    if (NumLiveAllocs() != 0)
     {
-        // If the list isn't empty, we have a leak.  The leak could either be caused by an internal PAL leak,
+        // If anything is still live, we have a leak.  The leak could either be caused by an internal PAL leak,
         // a client leak, or even the application not destroying API objects.
         PAL_ALERT_ALWAYS();
 
@@ -88,6 +115,69 @@ Result MemTracker<Allocator>::Init()
     return Result::Success;
 }
 
+// =====================================================================================================================
+// Returns the shard used by the calling thread.  Threads are handed shards round-robin the first time they allocate.
+template <typename Allocator>
+uint32 MemTracker<Allocator>::ThreadShard()
+{
+    static std::atomic<uint32> nextShard { 0 };
+    thread_local const uint32  shard = nextShard.fetch_add(1, std::memory_order_relaxed) & (NumShards - 1);
+
+    return shard;
+}
+
+// =====================================================================================================================
+// Returns true if the calling thread's next allocation should be tracked.  Each thread counts down on its own, so the
+// decision costs no shared memory traffic.
+template <typename Allocator>
+bool MemTracker<Allocator>::SampleThisAlloc(
+    uint32 sampleRate)
+{
+    thread_local uint32 countdown = 1;
+
+    bool sampled = false;
+
+    if (--countdown == 0)
+    {
+        countdown = sampleRate;
+        sampled   = true;
+    }
+
+    return sampled;
+}
+
+// =====================================================================================================================
+// Adds up the per-shard counters.  Takes each shard lock in turn.
+template <typename Allocator>
+typename MemTracker<Allocator>::Counters MemTracker<Allocator>::SumCounters()
+{
+    Counters totals          = {};
+    size_t   untrackedAllocs = 0;
+    size_t   untrackedFrees  = 0;
+
+    for (uint32 i = 0; i < NumShards; ++i)
+    {
+        Shard*const pShard = &m_shards[i];
+
+        untrackedAllocs       += pShard->untrackedAllocs.load(std::memory_order_relaxed);
+        untrackedFrees        += pShard->untrackedFrees.load(std::memory_order_relaxed);
+        totals.untrackedBytes += pShard->untrackedBytes.load(std::memory_order_relaxed);
+
+        MutexAuto lock(&pShard->mutex);
+
+        totals.numAllocs  += pShard->trackedAllocs;
+        totals.liveAllocs += pShard->trackerList.NumElements();
+        totals.liveBytes  += pShard->trackedBytes;
+    }
+
+    totals.untrackedAllocs = untrackedAllocs - untrackedFrees;
+    totals.numAllocs      += untrackedAllocs;
+    totals.liveAllocs     += totals.untrackedAllocs;
+    totals.liveBytes      += totals.untrackedBytes;
+
+    return totals;
+}
+
 // =====================================================================================================================
 // Adds the newly allocated memory block to the list of blocks for tracking.
 //
@@ -129,24 +219,87 @@ void* MemTracker<Allocator>::AddMemElement(
     pNewElement->blockType  = blockType;
     pNewElement->pClientMem = pClientMem;
     pNewElement->pOrigMem   = pMem;
-    pNewElement->pList      = &m_trackerList;
-
-    MutexAuto lock(&m_mutex);
+    pNewElement->allocNum   = m_nextAllocNum.fetch_add(1, std::memory_order_relaxed);
 
     // Trigger an assert if we're about to allocate the break-on-allocation number.
-    if (m_nextAllocNum == m_breakOnAllocNum)
+    if (pNewElement->allocNum == m_breakOnAllocNum)
     {
         PAL_ASSERT_ALWAYS();
     }
 
-    pNewElement->allocNum = m_nextAllocNum;
-    ++m_nextAllocNum;
+    Shard*const pShard = &m_shards[ThreadShard()];
+
+    pNewElement->pList = &pShard->trackerList;
 
-    m_trackerList.PushFront(pNewNode);
+    MutexAuto lock(&pShard->mutex);
+
+    pShard->trackerList.PushFront(pNewNode);
+    pShard->trackedAllocs++;
+    pShard->trackedBytes += bytes;
 
     return pClientMem;
 }
 
+// =====================================================================================================================
+// Writes the small header used by allocations which were not sampled and returns the client memory pointer.
+//   (align1)(MemTrackerUntrackedElem)(client allocation)
+template <typename Allocator>
+void* MemTracker<Allocator>::AddUntrackedElement(
+    void*       pMem,        // [in,out] Original pointer allocated by MemTracker::Alloc.
+    size_t      bytes,       // Client requested allocation size in bytes.
+    size_t      align,       // The max of the client-requested alignment or the internal alignment, in bytes.
+    MemBlkType  blockType)   // Block type based on calling allocation routine.
+{
+    void*const pClientMem  = VoidPtrAlign(VoidPtrInc(pMem, sizeof(MemTrackerUntrackedElem)), align);
+    auto*const pNewElement = static_cast<MemTrackerUntrackedElem*>(
+                                 VoidPtrDec(pClientMem, sizeof(MemTrackerUntrackedElem)));
+
+    pNewElement->pOrigMem  = pMem;
+    pNewElement->size      = bytes;
+    pNewElement->blockType = blockType;
+    pNewElement->tag       = UntrackedSentinel;
+
+    Shard*const pShard = &m_shards[ThreadShard()];
+
+    pShard->untrackedAllocs.fetch_add(1, std::memory_order_relaxed);
+    pShard->untrackedBytes.fetch_add(bytes, std::memory_order_relaxed);
+
+    return pClientMem;
+}
+
+// =====================================================================================================================
+// Validates the free of an allocation which was not sampled and returns the pointer to the allocated memory, or null if
+// the free is invalid.
+template <typename Allocator>
+void* MemTracker<Allocator>::RemoveUntrackedElement(
+    void*       pClientMem,  // Pointer to client usable memory.
+    MemBlkType  blockType)   // Block type based on calling deallocation routine.
+{
+    void*      pOrigPtr = nullptr;
+    auto*const pCurrent = static_cast<MemTrackerUntrackedElem*>(
+                              VoidPtrDec(pClientMem, sizeof(MemTrackerUntrackedElem)));
+
+    if (pCurrent->blockType != blockType)
+    {
+        PAL_DPERROR("Trying to Free %s as %s.",
+                    MemBlkTypeStr[static_cast<uint32>(pCurrent->blockType)],
+                    MemBlkTypeStr[static_cast<uint32>(blockType)]);
+    }
+    else
+    {
+        // Clear the tag so that a double-free is not mistaken for a live untracked block.
+        pCurrent->tag = 0;
+        pOrigPtr      = pCurrent->pOrigMem;
+
+        Shard*const pShard = &m_shards[ThreadShard()];
+
+        pShard->untrackedFrees.fetch_add(1, std::memory_order_relaxed);
+        pShard->untrackedBytes.fetch_sub(pCurrent->size, std::memory_order_relaxed);
+    }
+
+    return pOrigPtr;
+}
+
 // =====================================================================================================================
 // Removes an allocated block from the list of blocks used for tracking.
 //
@@ -170,9 +323,13 @@ void* MemTracker<Allocator>::RemoveMemElement(
     uint32*    pOverrun     = static_cast<uint32*>(VoidPtrInc(pClientMem, Pow2Align(pCurrent->size, sizeof(uint32))));
 
     // We should not be trying to free something twice or trying to free something which has not been allocated
-    // by this MemTracker. We can verify both of these things by checking that the tracker's pList is equal to the
-    // MemTracker's list.
-    if (pCurrent->pList != &m_trackerList)
+    // by this MemTracker. We can verify both of these things by checking that the tracker's pList is one of the
+    // MemTracker's shard lists.
+    const size_t listOffset = reinterpret_cast<uintptr_t>(pCurrent->pList) -
+                              reinterpret_cast<uintptr_t>(&m_shards[0].trackerList);
+    const size_t shardIndex = listOffset / sizeof(Shard);
+
+    if ((shardIndex >= NumShards) || (pCurrent->pList != &m_shards[shardIndex].trackerList))
     {
         // A free was attempted on an unrecognized pointer.
         PAL_DPERROR("Invalid Free Attempted with ptr = : (%#x)", pClientMem);
@@ -196,9 +353,11 @@ void* MemTracker<Allocator>::RemoveMemElement(
         }
 
         // Remove our tracker from the list and set it's pList to null to detect a double-free in the future.
-        MutexAuto lock(&m_mutex);
+        Shard*const pOwner = &m_shards[shardIndex];
+        MutexAuto lock(&pOwner->mutex);
 
-        m_trackerList.Erase(pCurrentNode);
+        pOwner->trackerList.Erase(pCurrentNode);
+        pOwner->trackedBytes -= pCurrent->size;
 
         pCurrent->pList = nullptr;
         pOrigPtr        = pCurrent->pOrigMem;
@@ -219,6 +378,8 @@ void* MemTracker<Allocator>::Alloc(
 
     void* pMem = nullptr;
 
+    const bool sampled = ((m_sampleRate == 1) || SampleThisAlloc(m_sampleRate));
+
     // We want to allocate extra memory from the caller's allocator, in this layout:
     //   (align1)(MemTrackerList::Node)(MemTrackerElem)(underflow tracker)(client allocation)(align2)(overflow tracker)
     // Here's why we need each of those sections:
@@ -228,14 +389,19 @@ void* MemTracker<Allocator>::Alloc(
     //   4. The underflow and overflow trackers detect out of bounds writes. They are optional.
     //   5. The client allocation, which is actually returned to the caller.
     //   6. align2 is zero or more bytes needed to DWORD-align the overflow tracker.
-    constexpr size_t InternalAlignment = Max(alignof(MemTrackerList::Node), alignof(MemTrackerElem));
-    const size_t     paddedAlignBytes  = Max(allocInfo.alignment, InternalAlignment);
-    const size_t     paddedSizeBytes   = (paddedAlignBytes +                            // 1
-                                          sizeof(MemTrackerList::Node) +                // 2
-                                          sizeof(MemTrackerElem) +                      // 3
-                                          m_markerSizeBytes +                           // 4.a
-                                          Pow2Align(allocInfo.bytes, sizeof(uint32)) +  // 5 & 6
-                                          m_markerSizeBytes);                           // 4.b
+    // Allocations which are not sampled get this much smaller layout instead:
+    //   (align1)(MemTrackerUntrackedElem)(client allocation)
+    constexpr size_t InternalAlignment  = Max(alignof(MemTrackerList::Node), alignof(MemTrackerElem));
+    constexpr size_t UntrackedAlignment = alignof(MemTrackerUntrackedElem);
+
+    const size_t paddedAlignBytes = Max(allocInfo.alignment, sampled ? InternalAlignment : UntrackedAlignment);
+    const size_t paddedSizeBytes  = sampled ? (paddedAlignBytes +                            // 1
+                                               sizeof(MemTrackerList::Node) +                // 2
+                                               sizeof(MemTrackerElem) +                      // 3
+                                               m_markerSizeBytes +                           // 4.a
+                                               Pow2Align(allocInfo.bytes, sizeof(uint32)) +  // 5 & 6
+                                               m_markerSizeBytes)                            // 4.b
+                                            : (paddedAlignBytes + sizeof(MemTrackerUntrackedElem) + allocInfo.bytes);
 
     const AllocInfo memTrackerInfo(paddedSizeBytes, paddedAlignBytes, allocInfo.zeroMem, allocInfo.allocType,
                                    allocInfo.blockType, allocInfo.pFilename, allocInfo.lineNumber);
@@ -245,12 +411,19 @@ void* MemTracker<Allocator>::Alloc(
     if (pMem != nullptr)
     {
         // Don't bother adding a failed allocation to the Memtrack list.
-        pMem = AddMemElement(pMem,
-                             allocInfo.bytes,
-                             paddedAlignBytes,
-                             allocInfo.blockType,
-                             allocInfo.pFilename,
-                             allocInfo.lineNumber);
+        if (sampled)
+        {
+            pMem = AddMemElement(pMem,
+                                 allocInfo.bytes,
+                                 paddedAlignBytes,
+                                 allocInfo.blockType,
+                                 allocInfo.pFilename,
+                                 allocInfo.lineNumber);
+        }
+        else
+        {
+            pMem = AddUntrackedElement(pMem, allocInfo.bytes, paddedAlignBytes, allocInfo.blockType);
+        }
     }
 
     return pMem;
@@ -267,7 +440,23 @@ void MemTracker<Allocator>::Free(
     // Don't want to call RemoveMemElement if the ptr is null.
     if (freeInfo.pClientMem != nullptr)
     {
-        void* pMem = RemoveMemElement(freeInfo.pClientMem, freeInfo.blockType);
+        void* pMem = nullptr;
+
+        // With sampling on, the word in front of the client memory holds the untracked tag if the block was not
+        // sampled.  Anything else is treated as a tracked block, whose word there is the tail of the underrun marker:
+        // RemoveMemElement() tells an underrun into the marker apart from a double-free or a foreign pointer, and
+        // still frees the block in the first case.
+        const bool untracked = (m_sampleRate != 1) &&
+            (*static_cast<const uint32*>(VoidPtrDec(freeInfo.pClientMem, sizeof(uint32))) == UntrackedSentinel);
+
+        if (untracked)
+        {
+            pMem = RemoveUntrackedElement(freeInfo.pClientMem, freeInfo.blockType);
+        }
+        else
+        {
+            pMem = RemoveMemElement(freeInfo.pClientMem, freeInfo.blockType);
+        }
 
         // If this free call is valid (RemoveMemElement doesn't return nullptr), release the memory.
         if (pMem != nullptr)
@@ -280,23 +469,29 @@ void MemTracker<Allocator>::Free(
 // =====================================================================================================================
 // Frees all memory that has not been explicitly freed (in other words, memory that has leaked).  This function is only
 // expected to be called when the memory tracker is being destroyed.
+//
+// Only sampled allocations can be found again, so untracked leaks stay leaked.
 template <typename Allocator>
 void MemTracker<Allocator>::FreeLeakedMemory()
 {
-    for (MemTrackerList::Iter iter = m_trackerList.Begin(); iter.IsValid(); )
+    for (uint32 i = 0; i < NumShards; ++i)
     {
-        MemTrackerElem*const pCurrent = iter.Get();
+        for (MemTrackerList::Iter iter = m_shards[i].trackerList.Begin(); iter.IsValid(); )
+        {
+            MemTrackerElem*const pCurrent = iter.Get();
 
-        // Free will release the memory for tracking and the actual element. This will invalidate our list iterator
-        // unless we advance the iterator first.
-        iter.Next();
+            // Free will release the memory for tracking and the actual element. This will invalidate our list iterator
+            // unless we advance the iterator first.
+            iter.Next();
 
-        Free(FreeInfo(pCurrent->pClientMem, pCurrent->blockType));
+            Free(FreeInfo(pCurrent->pClientMem, pCurrent->blockType));
+        }
     }
 }
 
 // =====================================================================================================================
-// Outputs information about leaked memory by traversing the memory tracker list.
+// Outputs information about leaked memory by traversing the memory tracker lists.  Each shard list is ordered newest
+// first, so the shards are merged on allocation number to report the leaks in the same order as a single list would.
 template <typename Allocator>
 void MemTracker<Allocator>::MemoryReport()
 {
@@ -308,9 +503,36 @@ void MemTracker<Allocator>::MemoryReport()
     {
         PAL_DPWARN("================ List of Leaked Blocks ================");
 
-        for (MemTrackerList::Iter iter = m_trackerList.Begin(); iter.IsValid(); iter.Next())
+        // The iterators cannot be default constructed or assigned, so construct them in place.
+        alignas(MemTrackerList::Iter) uint8 iterStorage[NumShards][sizeof(MemTrackerList::Iter)];
+        MemTrackerList::Iter* pIters[NumShards];
+
+        for (uint32 i = 0; i < NumShards; ++i)
         {
-            MemTrackerElem*const pCurrent = iter.Get();
+            pIters[i] = PAL_PLACEMENT_NEW(&iterStorage[i][0]) MemTrackerList::Iter(m_shards[i].trackerList.Begin());
+        }
+
+        while (true)
+        {
+            MemTrackerList::Iter* pNewest = nullptr;
+
+            for (uint32 i = 0; i < NumShards; ++i)
+            {
+                if (pIters[i]->IsValid() &&
+                    ((pNewest == nullptr) || (pIters[i]->Get()->allocNum > pNewest->Get()->allocNum)))
+                {
+                    pNewest = pIters[i];
+                }
+            }
+
+            if (pNewest == nullptr)
+            {
+                break;
+            }
+
+            MemTrackerElem*const pCurrent = pNewest->Get();
+
+            pNewest->Next();
 
             PAL_DPWARN(
                 "ClientMem = 0x%p, AllocSize = %8d, MemBlkType = %s, File = %-15s, LineNumber = %8d, AllocNum = %8d",
@@ -322,6 +544,21 @@ void MemTracker<Allocator>::MemoryReport()
                 pCurrent->allocNum);
         }
 
+        const Counters totals = SumCounters();
+
+        if (totals.untrackedAllocs != 0)
+        {
+            PAL_DPWARN("%zu more leaked blocks (%zu bytes) were not sampled (1 in %u allocations is tracked).",
+                       totals.untrackedAllocs,
+                       totals.untrackedBytes,
+                       m_sampleRate);
+        }
+
+        for (uint32 i = 0; i < NumShards; ++i)
+        {
+            pIters[i]->~IntrusiveListIterator();
+        }
+
         PAL_DPWARN("================ End of List ===========================");
     }
 }
@@ -0,0 +1,704 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palProfiler.h
+ * @brief PAL utility collection Profiler and ProfileScope declarations and implementations.
+ ***********************************************************************************************************************
+ */
+
+#pragma once
+
+#include "palDbgPrint.h"
+#include "palFile.h"
+#include "palInlineFuncs.h"
+#include "palMutex.h"
+#include "palSysMemory.h"
+#include "palSysUtil.h"
+#include <algorithm>
+#include <atomic>
+
+#if defined(_WIN32)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace Util
+{
+
+/// Describes one profiling zone.  PAL_PROFILE_SCOPE creates one of these as a function-local constant per call site;
+/// events and statistics refer to zones by address.
+struct ProfileZone
+{
+    const char* pName;      ///< Zone name shown in reports and traces.
+    const char* pFilename;  ///< Source file of the call site.
+    uint32      lineNumber; ///< Source line of the call site.
+};
+
+/// Aggregated timings of one zone, as produced by Profiler::GetZoneStats().
+struct ProfileZoneStats
+{
+    const ProfileZone* pZone;    ///< The zone these statistics describe.
+    uint64             count;    ///< Number of recorded executions.
+    uint64             totalNs;  ///< Sum of all durations.
+    uint64             minNs;    ///< Shortest duration.
+    uint64             maxNs;    ///< Longest duration.
+    uint64             p50Ns;    ///< Median duration (nearest rank).
+    uint64             p99Ns;    ///< 99th percentile duration (nearest rank).
+};
+
+/// Reads the CPU tick counter used to timestamp profiling zones: the TSC on x86, the virtual counter on AArch64 and the
+/// performance counter elsewhere.  Ticks are converted to time with a rate calibrated against GetPerfCpuTime().
+inline uint64 ReadProfileTicks()
+{
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64 ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return static_cast<uint64>(GetPerfCpuTime());
+#endif
+}
+
+/**
+ ***********************************************************************************************************************
+ * @brief  Process-wide recorder for nested CPU timing zones.
+ *
+ * Code is instrumented with PAL_PROFILE_SCOPE("name"), which times the rest of the enclosing block.  While profiling is
+ * disabled a scope costs one relaxed load and a branch.  While it is enabled each scope reads the tick counter twice
+ * and appends one event to a buffer owned by the calling thread, with no locks or shared writes.  A thread's buffer
+ * is created on its first enabled scope; once full, further events are dropped and counted.  When a thread exits its
+ * buffer is retired: its events stay visible until Reset() discards them, after which the buffer is handed to the next
+ * thread that needs one.  Memory therefore grows with the number of threads that recorded between resets rather than
+ * with every thread the process has ever run.
+ *
+ * Events are kept as (zone, begin, end, depth) in ticks.  GetZoneStats() aggregates them per zone and
+ * ExportChromeTrace() writes them as Chrome trace-event JSON, viewable in chrome://tracing or Perfetto.  Both may run
+ * while other threads keep recording; they see the events completed so far.  Reset() and Destroy() must not race with
+ * open scopes.
+ ***********************************************************************************************************************
+ */
+class Profiler
+{
+public:
+    /// One completed zone execution.
+    struct Event
+    {
+        const ProfileZone* pZone;       ///< The zone that ran.
+        uint64             beginTicks;  ///< Tick count when the scope was entered.
+        uint64             endTicks;    ///< Tick count when the scope was left.
+        uint32             depth;       ///< Number of enclosing scopes open on the same thread.
+    };
+
+    /// @internal Per-thread event storage.  The events follow the header in the same allocation.
+    struct ThreadBuffer
+    {
+        std::atomic<uint32> numEvents;   // Completed events.  Written by the owning thread only.
+        uint32              capacity;    // Maximum number of events.
+        uint32              depth;       // Scopes currently open on the owning thread.
+        uint32              threadIndex; // Small integer identifying the thread in reports.
+        std::atomic<uint64> numDropped;  // Events lost because the buffer was full.  Written by the owner only.
+        const char*         pThreadName; // Optional name, see SetThreadName().
+        bool                retired;     // The owning thread has exited.  Guarded by GetBufferLock().
+        ThreadBuffer*       pNext;       // Next registered buffer.
+
+        Event* Events() { return reinterpret_cast<Event*>(this + 1); }
+    };
+
+    /// Prepares the profiler and starts the clock calibration.  Profiling stays disabled until SetEnabled(true).
+    ///
+    /// @param [in] maxEventsPerThread Capacity of each thread's event buffer.
+    ///
+    /// @returns Success, or ErrorInvalidValue if the profiler is already initialized or the capacity is zero.
+    static Result Init(uint32 maxEventsPerThread = 64 * 1024);
+
+    /// Frees all event buffers and returns the profiler to its uninitialized state.  Profiling must be disabled and no
+    /// scope may be open.
+    static void Destroy();
+
+    /// Turns recording on or off.  Scopes that are open when recording is turned off still record their event.
+    static void SetEnabled(bool enable)
+        { s_enabled.store(enable && (s_maxEventsPerThread != 0), std::memory_order_relaxed); }
+
+    /// Returns true if scopes are being recorded.
+    static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    /// Names the calling thread in exported traces.  The string must outlive the profiler.
+    static void SetThreadName(const char* pName);
+
+    /// Discards all recorded events and drop counts.  No scope may be open.
+    static void Reset();
+
+    /// Aggregates the recorded events per zone, ordered by total time, longest first.
+    ///
+    /// @param [out] pStats   Receives up to maxStats entries.  May be null to just count the zones.
+    /// @param [in]  maxStats Capacity of pStats.
+    ///
+    /// @returns The number of distinct zones recorded, which may exceed maxStats.
+    static uint32 GetZoneStats(ProfileZoneStats* pStats, uint32 maxStats);
+
+    /// Writes every recorded event to a file in Chrome trace-event JSON format, one complete ("X") event per zone
+    /// execution, with the thread name metadata and each event's file, line and depth as arguments.
+    ///
+    /// @param [in] pFilename The file to write.  It is truncated.
+    ///
+    /// @returns Success, or an error from opening or writing the file or allocating scratch memory.
+    static Result ExportChromeTrace(const char* pFilename);
+
+    /// Returns the number of events dropped because a thread's buffer was full.
+    static uint64 NumDropped();
+
+    /// Returns the calling thread's buffer, creating it if needed.  Returns null if the profiler is not initialized or
+    /// the buffer cannot be allocated.
+    static ThreadBuffer* GetThreadBuffer()
+    {
+        struct ThreadCache
+        {
+            ~ThreadCache() { RetireThreadBuffer(pBuffer, generation); }
+
+            uint64        generation;
+            ThreadBuffer* pBuffer;
+        };
+
+        thread_local ThreadCache cache = {};
+
+        const uint64 generation = s_generation.load(std::memory_order_acquire);
+
+        if (cache.generation != generation)
+        {
+            cache.pBuffer    = CreateThreadBuffer();
+            cache.generation = (cache.pBuffer != nullptr) ? generation : 0;
+        }
+
+        return cache.pBuffer;
+    }
+
+private:
+    // Serializes handing buffers between threads with Destroy() freeing them.  Readers walk s_pBuffers without it.
+    static Mutex* GetBufferLock()
+    {
+        static Mutex bufferLock;
+        return &bufferLock;
+    }
+
+    static ThreadBuffer* CreateThreadBuffer();
+    static void          RetireThreadBuffer(ThreadBuffer* pBuffer, uint64 generation);
+    static double        TicksPerNs();
+
+    static Result WriteJsonString(File* pFile, const char* pString);
+
+    static inline GenericAllocator            s_allocator;
+    static inline std::atomic<bool>           s_enabled          { false };
+    static inline std::atomic<uint64>         s_generation       { 1 };  // Bumped by Destroy() to orphan thread caches.
+    static inline std::atomic<ThreadBuffer*>  s_pBuffers         { nullptr };
+    static inline std::atomic<uint32>         s_nextThreadIndex  { 0 };
+    static inline uint32                      s_maxEventsPerThread = 0;
+    static inline uint64                      s_baseTicks        = 0;    // Tick count at Init().
+    static inline int64                       s_basePerfTime     = 0;    // GetPerfCpuTime() at Init().
+
+    PAL_DISALLOW_DEFAULT_CTOR(Profiler);
+    PAL_DISALLOW_COPY_AND_ASSIGN(Profiler);
+};
+
+/**
+ ***********************************************************************************************************************
+ * @brief  Times the enclosing block as one execution of a @ref ProfileZone.  Use through PAL_PROFILE_SCOPE.
+ ***********************************************************************************************************************
+ */
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const ProfileZone& zone) : m_pBuffer(nullptr)
+    {
+        if (Profiler::IsEnabled()) [[unlikely]]
+        {
+            Begin(zone);
+        }
+    }
+
+    ~ProfileScope()
+    {
+        if (m_pBuffer != nullptr) [[unlikely]]
+        {
+            End();
+        }
+    }
+
+private:
+    void Begin(const ProfileZone& zone);
+    void End();
+
+    Profiler::ThreadBuffer* m_pBuffer;
+    const ProfileZone*      m_pZone;
+    uint64                  m_beginTicks;
+
+    PAL_DISALLOW_COPY_AND_ASSIGN(ProfileScope);
+};
+
+// =====================================================================================================================
+inline void ProfileScope::Begin(
+    const ProfileZone& zone)
+{
+    m_pBuffer = Profiler::GetThreadBuffer();
+
+    if (m_pBuffer != nullptr)
+    {
+        m_pZone = &zone;
+        m_pBuffer->depth++;
+        m_beginTicks = ReadProfileTicks();
+    }
+}
+
+// =====================================================================================================================
+inline void ProfileScope::End()
+{
+    const uint64 endTicks = ReadProfileTicks();
+    const uint32 index    = m_pBuffer->numEvents.load(std::memory_order_relaxed);
+
+    m_pBuffer->depth--;
+
+    if (index < m_pBuffer->capacity)
+    {
+        Profiler::Event*const pEvent = &m_pBuffer->Events()[index];
+
+        pEvent->pZone      = m_pZone;
+        pEvent->beginTicks = m_beginTicks;
+        pEvent->endTicks   = endTicks;
+        pEvent->depth      = m_pBuffer->depth;
+
+        m_pBuffer->numEvents.store(index + 1, std::memory_order_release);
+    }
+    else
+    {
+        m_pBuffer->numDropped.store(m_pBuffer->numDropped.load(std::memory_order_relaxed) + 1,
+                                    std::memory_order_relaxed);
+    }
+}
+
+// =====================================================================================================================
+inline Result Profiler::Init(
+    uint32 maxEventsPerThread)
+{
+    Result result = Result::ErrorInvalidValue;
+
+    if ((s_maxEventsPerThread == 0) && (maxEventsPerThread != 0))
+    {
+        s_baseTicks          = ReadProfileTicks();
+        s_basePerfTime       = GetPerfCpuTime();
+        s_maxEventsPerThread = maxEventsPerThread;
+
+        // Let threads whose caches still point at buffers of an earlier session create new ones.
+        s_generation.fetch_add(1, std::memory_order_release);
+
+        result = Result::Success;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+inline void Profiler::Destroy()
+{
+    PAL_ASSERT(IsEnabled() == false);
+
+    MutexAuto lock(GetBufferLock());
+
+    s_generation.fetch_add(1, std::memory_order_release);
+
+    ThreadBuffer* pBuffer = s_pBuffers.exchange(nullptr, std::memory_order_acquire);
+
+    while (pBuffer != nullptr)
+    {
+        ThreadBuffer*const pNext = pBuffer->pNext;
+
+        pBuffer->~ThreadBuffer();
+        PAL_FREE(pBuffer, &s_allocator);
+        pBuffer = pNext;
+    }
+
+    s_nextThreadIndex.store(0, std::memory_order_relaxed);
+    s_maxEventsPerThread = 0;
+}
+
+// =====================================================================================================================
+inline Profiler::ThreadBuffer* Profiler::CreateThreadBuffer()
+{
+    ThreadBuffer* pBuffer = nullptr;
+
+    if (s_maxEventsPerThread != 0)
+    {
+        MutexAuto lock(GetBufferLock());
+
+        // Prefer a buffer whose thread has exited and whose events Reset() has already discarded.
+        for (pBuffer = s_pBuffers.load(std::memory_order_acquire); pBuffer != nullptr; pBuffer = pBuffer->pNext)
+        {
+            if (pBuffer->retired                                            &&
+                (pBuffer->numEvents.load(std::memory_order_relaxed) == 0)  &&
+                (pBuffer->numDropped.load(std::memory_order_relaxed) == 0))
+            {
+                break;
+            }
+        }
+
+        if (pBuffer == nullptr)
+        {
+            void*const pMem = PAL_MALLOC(sizeof(ThreadBuffer) + (s_maxEventsPerThread * sizeof(Event)),
+                                         &s_allocator,
+                                         AllocInternal);
+
+            if (pMem != nullptr)
+            {
+                pBuffer = PAL_PLACEMENT_NEW(pMem) ThreadBuffer();
+
+                pBuffer->numEvents.store(0, std::memory_order_relaxed);
+                pBuffer->capacity = s_maxEventsPerThread;
+                pBuffer->numDropped.store(0, std::memory_order_relaxed);
+                pBuffer->pNext    = s_pBuffers.load(std::memory_order_relaxed);
+
+                s_pBuffers.store(pBuffer, std::memory_order_release);
+            }
+        }
+
+        if (pBuffer != nullptr)
+        {
+            // A new index keeps the events of the buffer's next owner apart from those of any earlier one.
+            pBuffer->depth       = 0;
+            pBuffer->threadIndex = s_nextThreadIndex.fetch_add(1, std::memory_order_relaxed);
+            pBuffer->pThreadName = nullptr;
+            pBuffer->retired     = false;
+        }
+    }
+
+    return pBuffer;
+}
+
+// =====================================================================================================================
+// Called when a thread exits.  Buffers from before the last Destroy() are already gone and are left alone.
+inline void Profiler::RetireThreadBuffer(
+    ThreadBuffer* pBuffer,
+    uint64        generation)
+{
+    if (pBuffer != nullptr)
+    {
+        MutexAuto lock(GetBufferLock());
+
+        if (generation == s_generation.load(std::memory_order_relaxed))
+        {
+            pBuffer->retired = true;
+        }
+    }
+}
+
+// =====================================================================================================================
+inline void Profiler::SetThreadName(
+    const char* pName)
+{
+    ThreadBuffer*const pBuffer = GetThreadBuffer();
+
+    if (pBuffer != nullptr)
+    {
+        pBuffer->pThreadName = pName;
+    }
+}
+
+// =====================================================================================================================
+inline void Profiler::Reset()
+{
+    for (ThreadBuffer* pBuffer = s_pBuffers.load(std::memory_order_acquire);
+         pBuffer != nullptr;
+         pBuffer = pBuffer->pNext)
+    {
+        pBuffer->numEvents.store(0, std::memory_order_relaxed);
+        pBuffer->numDropped.store(0, std::memory_order_relaxed);
+    }
+}
+
+// =====================================================================================================================
+inline uint64 Profiler::NumDropped()
+{
+    uint64 total = 0;
+
+    for (ThreadBuffer* pBuffer = s_pBuffers.load(std::memory_order_acquire);
+         pBuffer != nullptr;
+         pBuffer = pBuffer->pNext)
+    {
+        total += pBuffer->numDropped.load(std::memory_order_relaxed);
+    }
+
+    return total;
+}
+
+// =====================================================================================================================
+// Returns the tick rate measured between Init() and now.  Waits until at least 10 ms have passed so that short
+// sessions still get a usable rate.
+inline double Profiler::TicksPerNs()
+{
+    const int64 perfFrequency = GetPerfFrequency();
+    const int64 minPerfTicks  = perfFrequency / 100;
+
+    int64  perfTime = GetPerfCpuTime();
+    uint64 ticks    = ReadProfileTicks();
+
+    while ((perfTime - s_basePerfTime) < minPerfTicks)
+    {
+        perfTime = GetPerfCpuTime();
+        ticks    = ReadProfileTicks();
+    }
+
+    const double elapsedNs = static_cast<double>(perfTime - s_basePerfTime) * 1e9 / static_cast<double>(perfFrequency);
+
+    return static_cast<double>(ticks - s_baseTicks) / elapsedNs;
+}
+
+// =====================================================================================================================
+inline uint32 Profiler::GetZoneStats(
+    ProfileZoneStats* pStats,
+    uint32            maxStats)
+{
+    struct Sample
+    {
+        const ProfileZone* pZone;
+        uint64             ticks;
+    };
+
+    uint64 numSamples = 0;
+
+    for (ThreadBuffer* pBuffer = s_pBuffers.load(std::memory_order_acquire);
+         pBuffer != nullptr;
+         pBuffer = pBuffer->pNext)
+    {
+        numSamples += pBuffer->numEvents.load(std::memory_order_acquire);
+    }
+
+    uint32 numZones = 0;
+
+    Sample*           pSamples  = static_cast<Sample*>(PAL_MALLOC(Max<uint64>(numSamples, 1) * sizeof(Sample),
+                                                                  &s_allocator,
+                                                                  AllocInternal));
+    ProfileZoneStats* pAllStats = static_cast<ProfileZoneStats*>(
+                                      PAL_MALLOC(Max<uint64>(numSamples, 1) * sizeof(ProfileZoneStats),
+                                                 &s_allocator,
+                                                 AllocInternal));
+
+    if ((pSamples != nullptr) && (pAllStats != nullptr))
+    {
+        // Other threads may have completed more events since we counted; only take what we made room for.
+        uint64 sampleIdx = 0;
+
+        for (ThreadBuffer* pBuffer = s_pBuffers.load(std::memory_order_acquire);
+             (pBuffer != nullptr) && (sampleIdx < numSamples);
+             pBuffer = pBuffer->pNext)
+        {
+            const uint32 numEvents = static_cast<uint32>(Min<uint64>(pBuffer->numEvents.load(std::memory_order_acquire),
+                                                                      numSamples - sampleIdx));
+            const Event* pEvents   = pBuffer->Events();
+
+            for (uint32 i = 0; i < numEvents; ++i)
+            {
+                pSamples[sampleIdx++] = { pEvents[i].pZone, pEvents[i].endTicks - pEvents[i].beginTicks };
+            }
+        }
+
+        numSamples = sampleIdx;
+
+        std::sort(pSamples, pSamples + numSamples, [](const Sample& lhs, const Sample& rhs)
+                  { return (lhs.pZone != rhs.pZone) ? (lhs.pZone < rhs.pZone) : (lhs.ticks < rhs.ticks); });
+
+        const double ticksPerNs = TicksPerNs();
+        const auto   ToNs       = [ticksPerNs](uint64 ticks) { return static_cast<uint64>(ticks / ticksPerNs); };
+
+        for (uint64 first = 0; first < numSamples; )
+        {
+            uint64 last  = first;
+            uint64 total = 0;
+
+            for (; (last < numSamples) && (pSamples[last].pZone == pSamples[first].pZone); ++last)
+            {
+                total += pSamples[last].ticks;
+            }
+
+            // Nearest-rank percentiles over the sorted durations of this zone.
+            const uint64 count = last - first;
+
+            ProfileZoneStats*const pZoneStats = &pAllStats[numZones++];
+
+            pZoneStats->pZone   = pSamples[first].pZone;
+            pZoneStats->count   = count;
+            pZoneStats->totalNs = ToNs(total);
+            pZoneStats->minNs   = ToNs(pSamples[first].ticks);
+            pZoneStats->maxNs   = ToNs(pSamples[last - 1].ticks);
+            pZoneStats->p50Ns   = ToNs(pSamples[first + RoundUpQuotient<uint64>(count * 50, 100) - 1].ticks);
+            pZoneStats->p99Ns   = ToNs(pSamples[first + RoundUpQuotient<uint64>(count * 99, 100) - 1].ticks);
+
+            first = last;
+        }
+
+        std::sort(pAllStats, pAllStats + numZones, [](const ProfileZoneStats& lhs, const ProfileZoneStats& rhs)
+                  { return lhs.totalNs > rhs.totalNs; });
+
+        if (pStats != nullptr)
+        {
+            memcpy(pStats, pAllStats, Min(numZones, maxStats) * sizeof(ProfileZoneStats));
+        }
+    }
+
+    PAL_SAFE_FREE(pSamples, &s_allocator);
+    PAL_SAFE_FREE(pAllStats, &s_allocator);
+
+    return numZones;
+}
+
+// =====================================================================================================================
+// Writes a JSON string literal, quotes included.
+inline Result Profiler::WriteJsonString(
+    File*       pFile,
+    const char* pString)
+{
+    char   buffer[256];
+    size_t length = 0;
+    Result result = Result::Success;
+
+    buffer[length++] = '"';
+
+    for (const char* pChar = (pString != nullptr) ? pString : "";
+         (*pChar != '\0') && (result == Result::Success);
+         ++pChar)
+    {
+        if ((length + 8) > sizeof(buffer))
+        {
+            result = pFile->Write(buffer, length);
+            length = 0;
+        }
+
+        const uint8 c = static_cast<uint8>(*pChar);
+
+        if ((c == '"') || (c == '\\'))
+        {
+            buffer[length++] = '\\';
+            buffer[length++] = static_cast<char>(c);
+        }
+        else if (c < 0x20)
+        {
+            length += Snprintf(&buffer[length], sizeof(buffer) - length, "\\u%04x", c);
+        }
+        else
+        {
+            buffer[length++] = static_cast<char>(c);
+        }
+    }
+
+    buffer[length++] = '"';
+
+    return (result == Result::Success) ? pFile->Write(buffer, length) : result;
+}
+
+// =====================================================================================================================
+inline Result Profiler::ExportChromeTrace(
+    const char* pFilename)
+{
+    File   file;
+    Result result = file.Open(pFilename, FileAccessWrite);
+
+    if (result == Result::Success)
+    {
+        const double ticksPerNs = TicksPerNs();
+        const auto   ToUs       = [ticksPerNs](uint64 ticks)
+                                  { return static_cast<double>(ticks) / ticksPerNs / 1000.0; };
+
+        char        line[256];
+        const char* pSeparator = "";
+
+        result = file.Write("{\"traceEvents\":[", 16);
+
+        for (ThreadBuffer* pBuffer = s_pBuffers.load(std::memory_order_acquire);
+             (pBuffer != nullptr) && (result == Result::Success);
+             pBuffer = pBuffer->pNext)
+        {
+            if (pBuffer->pThreadName != nullptr)
+            {
+                Snprintf(line, sizeof(line),
+                         "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+                         pSeparator,
+                         pBuffer->threadIndex);
+                result     = file.Write(line, strlen(line));
+                result     = (result == Result::Success) ? WriteJsonString(&file, pBuffer->pThreadName) : result;
+                result     = (result == Result::Success) ? file.Write("}}", 2) : result;
+                pSeparator = ",";
+            }
+
+            const uint32 numEvents = pBuffer->numEvents.load(std::memory_order_acquire);
+            const Event* pEvents   = pBuffer->Events();
+
+            for (uint32 i = 0; (i < numEvents) && (result == Result::Success); ++i)
+            {
+                const Event& event = pEvents[i];
+
+                Snprintf(line, sizeof(line), "%s\n{\"name\":", pSeparator);
+                result = file.Write(line, strlen(line));
+                result = (result == Result::Success) ? WriteJsonString(&file, event.pZone->pName) : result;
+
+                if (result == Result::Success)
+                {
+                    // Ticks are relative to Init(), so the trace starts near zero.
+                    Snprintf(line, sizeof(line),
+                             ",\"cat\":\"PAL\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u,"
+                             "\"args\":{\"depth\":%u,\"line\":%u,\"file\":",
+                             ToUs(event.beginTicks - s_baseTicks),
+                             ToUs(event.endTicks - event.beginTicks),
+                             pBuffer->threadIndex,
+                             event.depth,
+                             event.pZone->lineNumber);
+                    result = file.Write(line, strlen(line));
+                }
+
+                result     = (result == Result::Success) ? WriteJsonString(&file, event.pZone->pFilename) : result;
+                result     = (result == Result::Success) ? file.Write("}}", 2) : result;
+                pSeparator = ",";
+            }
+        }
+
+        if (result == Result::Success)
+        {
+            result = file.Write("\n],\"displayTimeUnit\":\"ns\"}\n", 27);
+        }
+    }
+
+    return result;
+}
+
+} // Util
+
+/// @internal Helpers to give each PAL_PROFILE_SCOPE in a block unique local names.
+#define PAL_PROFILE_CONCAT_INNER(_a, _b) _a##_b
+#define PAL_PROFILE_CONCAT(_a, _b)       PAL_PROFILE_CONCAT_INNER(_a, _b)
+
+/// Times the rest of the enclosing block as one execution of the zone _pName, which must be a string literal.
+#define PAL_PROFILE_SCOPE(_pName)                                                                  \
+    static constexpr ::Util::ProfileZone PAL_PROFILE_CONCAT(palProfileZone, __LINE__) =            \
+        { _pName, __FILE__, __LINE__ };                                                            \
+    ::Util::ProfileScope PAL_PROFILE_CONCAT(palProfileScope, __LINE__)(PAL_PROFILE_CONCAT(palProfileZone, __LINE__))
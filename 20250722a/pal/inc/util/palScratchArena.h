@@ -0,0 +1,361 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palScratchArena.h
+ * @brief PAL utility collection ScratchArena and ScratchArenaAuto class declarations and implementations.
+ ***********************************************************************************************************************
+ */
+
+#pragma once
+
+#include "palInlineFuncs.h"
+#include "palSysMemory.h"
+#include <type_traits>
+
+namespace Util
+{
+
+/**
+ ***********************************************************************************************************************
+ * @brief Stack-first bump allocator for temporary arrays.
+ *
+ * Where an @ref AutoBuffer holds a single variable-length array, a ScratchArena serves any number of them from one
+ * inline buffer of StackBytes bytes.  Each allocation is a pointer bump.  When the inline buffer is exhausted the arena
+ * chains heap blocks obtained from the allocator, each at least twice the size of the previous one.
+ *
+ * Memory is never freed individually.  Mark() records the current position and Rewind() returns to it, releasing
+ * everything allocated in between; @ref ScratchArenaAuto does this for a scope.  Rewound heap blocks stay in the chain
+ * and are reused by later allocations, so an arena that is kept around (see @ref ThreadScratchArena) stops touching
+ * the heap once it has grown to its working size.  Trim() frees the blocks that are not in use.
+ *
+ * Destructors of allocated objects are never run, so only trivially destructible types may be allocated.
+ *
+ * @warning This class is not thread-safe.
+ ***********************************************************************************************************************
+ */
+template <size_t StackBytes, typename Allocator>
+class ScratchArena
+{
+    static_assert(StackBytes > 0, "ScratchArena needs an inline buffer.");
+
+    struct Block;
+
+public:
+    /// A position in the arena, as returned by Mark().
+    struct Marker
+    {
+        Block* pBlock;   ///< Block holding the position, or null for the inline buffer.
+        uint8* pCurrent; ///< Next free byte.
+    };
+
+    /// Constructor.
+    ///
+    /// @param [in] pAllocator The allocator heap blocks are obtained from.
+    explicit ScratchArena(Allocator*const pAllocator)
+        :
+        m_pCurrent(m_stackBuffer),
+        m_pEnd(m_stackBuffer + StackBytes),
+        m_pBlock(nullptr),
+        m_pFirstBlock(nullptr),
+        m_heapBytes(0),
+        m_pAllocator(pAllocator)
+    {
+    }
+
+    /// Destructor.  Frees all heap blocks.
+    ~ScratchArena() { FreeBlocks(m_pFirstBlock); }
+
+    /// Allocates uninitialized memory.
+    ///
+    /// @param [in] bytes     Size of the allocation.
+    /// @param [in] alignment Required alignment; a power of two.
+    ///
+    /// @returns The memory, or null if a heap block was needed and could not be allocated.
+    void* Alloc(
+        size_t bytes,
+        size_t alignment = PAL_DEFAULT_MEM_ALIGN)
+    {
+        PAL_ASSERT(IsPowerOfTwo(alignment));
+
+        uint8*const pAligned = reinterpret_cast<uint8*>(Pow2Align(reinterpret_cast<size_t>(m_pCurrent), alignment));
+        void*       pMemory  = nullptr;
+
+        if ((pAligned <= m_pEnd) && (bytes <= size_t(m_pEnd - pAligned)))
+        {
+            m_pCurrent = pAligned + bytes;
+            pMemory    = pAligned;
+        }
+        else
+        {
+            pMemory = AllocSlow(bytes, alignment);
+        }
+
+        return pMemory;
+    }
+
+    /// Allocates an array of count default-initialized items.  Like @ref AutoBuffer, the memory of trivial types is
+    /// not cleared.
+    ///
+    /// @returns The array, or null if the allocation failed.
+    template <typename T>
+    T* AllocArray(
+        size_t count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "ScratchArena never runs destructors, so it only holds trivially destructible types.");
+
+        T* pArray = nullptr;
+
+        if (count <= (SIZE_MAX / sizeof(T)))
+        {
+            pArray = static_cast<T*>(Alloc(count * sizeof(T), alignof(T)));
+        }
+
+        if ((pArray != nullptr) && (std::is_trivially_default_constructible<T>::value == false))
+        {
+            for (size_t idx = 0; idx < count; ++idx)
+            {
+                PAL_PLACEMENT_NEW(pArray + idx) T();
+            }
+        }
+
+        return pArray;
+    }
+
+    /// Returns the current position, to be passed to Rewind() later.
+    Marker Mark() const { return { m_pBlock, m_pCurrent }; }
+
+    /// Releases everything allocated since marker was taken.  Markers must be rewound in last-in first-out order, and
+    /// rewinding to a marker invalidates all markers taken after it.
+    void Rewind(const Marker& marker)
+    {
+        m_pBlock   = marker.pBlock;
+        m_pCurrent = marker.pCurrent;
+        m_pEnd     = (m_pBlock != nullptr) ? m_pBlock->End() : (m_stackBuffer + StackBytes);
+    }
+
+    /// Releases every allocation.
+    void Reset() { Rewind({ nullptr, m_stackBuffer }); }
+
+    /// Frees the heap blocks that hold no allocations.
+    void Trim()
+    {
+        if (m_pBlock != nullptr)
+        {
+            FreeBlocks(m_pBlock->pNext);
+            m_pBlock->pNext = nullptr;
+        }
+        else
+        {
+            FreeBlocks(m_pFirstBlock);
+            m_pFirstBlock = nullptr;
+        }
+    }
+
+    /// Returns the total size of the heap blocks owned by the arena, in use or not.
+    size_t HeapBytes() const { return m_heapBytes; }
+
+    /// Allows the arena to serve as a PAL allocator, for example for PAL_NEW or a container.  See @ref Allocators.
+    void* Alloc(const AllocInfo& allocInfo)
+    {
+        void* pMemory = Alloc(allocInfo.bytes, Max<size_t>(allocInfo.alignment, 1));
+
+        if ((pMemory != nullptr) && allocInfo.zeroMem)
+        {
+            memset(pMemory, 0, allocInfo.bytes);
+        }
+
+        return pMemory;
+    }
+
+    /// Does nothing; memory is released by Rewind().
+    void Free(const FreeInfo& freeInfo) { }
+
+private:
+    // Header of a heap block.  The block's memory follows it.
+    struct Block
+    {
+        Block* pNext; // The next block in the chain.
+        size_t size;  // Size of the block's memory, excluding this header.
+
+        uint8* Begin() { return reinterpret_cast<uint8*>(this + 1); }
+        uint8* End()   { return Begin() + size; }
+    };
+
+    static constexpr size_t MinBlockBytes = Max<size_t>(StackBytes, 4096);
+
+    void* AllocSlow(size_t bytes, size_t alignment);
+    void  FreeBlocks(Block* pBlock);
+
+    uint8*            m_pCurrent;    // Next free byte of the current block.
+    uint8*            m_pEnd;        // End of the current block.
+    Block*            m_pBlock;      // The current heap block, or null while allocating from m_stackBuffer.
+    Block*            m_pFirstBlock; // First heap block of the chain.
+    size_t            m_heapBytes;   // Total size of all heap blocks.
+    Allocator*const   m_pAllocator;  // Allocator for heap blocks.
+
+    alignas(PAL_DEFAULT_MEM_ALIGN) uint8 m_stackBuffer[StackBytes];
+
+    PAL_DISALLOW_DEFAULT_CTOR(ScratchArena);
+    PAL_DISALLOW_COPY_AND_ASSIGN(ScratchArena);
+};
+
+// =====================================================================================================================
+// Moves on to the next heap block that can hold the allocation, adding a block to the chain if there is none.
+template <size_t StackBytes, typename Allocator>
+void* ScratchArena<StackBytes, Allocator>::AllocSlow(
+    size_t bytes,
+    size_t alignment)
+{
+    void*  pMemory = nullptr;
+    Block* pPrev   = m_pBlock;
+    Block* pNext   = (m_pBlock != nullptr) ? m_pBlock->pNext : m_pFirstBlock;
+
+    // Blocks are aligned to PAL_DEFAULT_MEM_ALIGN, so larger alignments may need padding at the start.
+    const size_t worstCase = bytes + ((alignment > PAL_DEFAULT_MEM_ALIGN) ? alignment : 0);
+
+    // Skip rewound blocks that are too small for this request; they stay in the chain for smaller ones.
+    while ((pNext != nullptr) && (pNext->size < worstCase))
+    {
+        pPrev = pNext;
+        pNext = pNext->pNext;
+    }
+
+    if ((pNext == nullptr) && (worstCase <= (SIZE_MAX - sizeof(Block))))
+    {
+        const size_t lastSize  = (pPrev != nullptr) ? pPrev->size : StackBytes;
+        const size_t blockSize = Max(Pow2Pad(worstCase), lastSize * 2, MinBlockBytes);
+
+        void*const pBlockMem = PAL_MALLOC(sizeof(Block) + blockSize, m_pAllocator, AllocInternalTemp);
+
+        if (pBlockMem != nullptr)
+        {
+            pNext        = static_cast<Block*>(pBlockMem);
+            pNext->pNext = nullptr;
+            pNext->size  = blockSize;
+            m_heapBytes += blockSize;
+
+            if (pPrev != nullptr)
+            {
+                pPrev->pNext = pNext;
+            }
+            else
+            {
+                m_pFirstBlock = pNext;
+            }
+        }
+    }
+
+    if (pNext != nullptr)
+    {
+        uint8*const pAligned =
+            reinterpret_cast<uint8*>(Pow2Align(reinterpret_cast<size_t>(pNext->Begin()), alignment));
+
+        m_pBlock   = pNext;
+        m_pCurrent = pAligned + bytes;
+        m_pEnd     = pNext->End();
+        pMemory    = pAligned;
+    }
+
+    return pMemory;
+}
+
+// =====================================================================================================================
+template <size_t StackBytes, typename Allocator>
+void ScratchArena<StackBytes, Allocator>::FreeBlocks(
+    Block* pBlock)
+{
+    while (pBlock != nullptr)
+    {
+        Block*const pNext = pBlock->pNext;
+
+        m_heapBytes -= pBlock->size;
+        PAL_FREE(pBlock, m_pAllocator);
+        pBlock = pNext;
+    }
+}
+
+/**
+ ***********************************************************************************************************************
+ * @brief A "resource acquisition is initialization" (RAII) wrapper for @ref ScratchArena.
+ *
+ * Marks the arena on construction and rewinds it on destruction, releasing every allocation made in between:
+ *
+ *     {
+ *         ScratchArenaAuto<decltype(arena)> scratch(&arena);
+ *         uint32* pIndices = scratch.AllocArray<uint32>(numIndices);
+ *         float*  pWeights = scratch.AllocArray<float>(numWeights);
+ *         ...
+ *     }
+ *     [both arrays are released]
+ ***********************************************************************************************************************
+ */
+template <typename Arena>
+class ScratchArenaAuto
+{
+public:
+    /// Marks the arena.
+    explicit ScratchArenaAuto(Arena* pArena) : m_pArena(pArena), m_marker(pArena->Mark()) { }
+
+    /// Rewinds the arena to where it was when this was constructed.
+    ~ScratchArenaAuto() { m_pArena->Rewind(m_marker); }
+
+    /// Allocates from the wrapped arena.  See ScratchArena::Alloc().
+    void* Alloc(size_t bytes, size_t alignment = PAL_DEFAULT_MEM_ALIGN) { return m_pArena->Alloc(bytes, alignment); }
+
+    /// Allocates an array from the wrapped arena.  See ScratchArena::AllocArray().
+    template <typename T>
+    T* AllocArray(size_t count) { return m_pArena->template AllocArray<T>(count); }
+
+    /// Returns the wrapped arena, for example to pass to a callee that opens a nested scope.
+    Arena* GetArena() const { return m_pArena; }
+
+private:
+    Arena*const                   m_pArena;
+    const typename Arena::Marker  m_marker;
+
+    PAL_DISALLOW_DEFAULT_CTOR(ScratchArenaAuto);
+    PAL_DISALLOW_COPY_AND_ASSIGN(ScratchArenaAuto);
+};
+
+/// Size of the inline buffer of the per-thread arena returned by @ref ThreadScratchArena.
+constexpr size_t ThreadScratchArenaBytes = 4096;
+
+/// The type of the per-thread arena.
+using ThreadScratchArenaType = ScratchArena<ThreadScratchArenaBytes, GenericAllocator>;
+
+/// Returns the calling thread's scratch arena.  Functions share it by opening a @ref ScratchArenaAuto on it, which
+/// nests naturally with those of their callers.  Its heap blocks are kept until the thread exits (or Trim() is called),
+/// so steady-state use does not allocate.
+inline ThreadScratchArenaType* ThreadScratchArena()
+{
+    static GenericAllocator  allocator;
+    thread_local ThreadScratchArenaType arena(&allocator);
+
+    return &arena;
+}
+
+} // Util
@@ -0,0 +1,94 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palSimd.h
+ * @brief PAL utility collection SIMD intrinsics and CPU feature checks.
+ ***********************************************************************************************************************
+ */
+
+#pragma once
+
+#include "palUtil.h"
+
+// SSE2 is part of x86-64, so PAL_SIMD_X86 code may use it unconditionally.  Functions using AVX2 are marked with
+// PAL_SIMD_AVX2_TARGET and must only be called when CpuSupportsAvx2() returns true.
+#if (defined(__x86_64__) || defined(_M_X64))
+#define PAL_SIMD_X86 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <immintrin.h>
+#define PAL_SIMD_AVX2_TARGET
+#else
+#include <cpuid.h>
+#include <immintrin.h>
+#define PAL_SIMD_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#else
+#define PAL_SIMD_X86 0
+#endif
+
+namespace Util
+{
+
+#if PAL_SIMD_X86
+/// Returns true if the CPU and OS support AVX2, so code built with PAL_SIMD_AVX2_TARGET may run.  The answer is
+/// computed once per process.
+inline bool CpuSupportsAvx2()
+{
+    static const bool SupportsAvx2 = []()
+    {
+        uint32 regs[4] = {};
+        bool   result  = false;
+
+#if defined(_MSC_VER) && !defined(__clang__)
+        __cpuid(reinterpret_cast<int*>(regs), 1);
+#else
+        __get_cpuid(1, &regs[0], &regs[1], &regs[2], &regs[3]);
+#endif
+
+        // AVX2 needs the OS to save the YMM state, which OSXSAVE and XCR0 report.
+        if ((regs[2] & (1u << 27)) != 0)
+        {
+#if defined(_MSC_VER) && !defined(__clang__)
+            const uint64 xcr0 = _xgetbv(0);
+            __cpuidex(reinterpret_cast<int*>(regs), 7, 0);
+#else
+            uint32 xcr0Lo = 0;
+            uint32 xcr0Hi = 0;
+            __asm__ volatile("xgetbv" : "=a"(xcr0Lo), "=d"(xcr0Hi) : "c"(0));
+            const uint64 xcr0 = (uint64(xcr0Hi) << 32) | xcr0Lo;
+            __get_cpuid_count(7, 0, &regs[0], &regs[1], &regs[2], &regs[3]);
+#endif
+            result = ((xcr0 & 0x6) == 0x6) && ((regs[1] & (1u << 5)) != 0);
+        }
+
+        return result;
+    }();
+
+    return SupportsAvx2;
+}
+#endif
+
+} // Util
@@ -33,6 +33,7 @@
 
 #include "palAssert.h"
 #include "palInlineFuncs.h"
+#include "palSimd.h"
 #include "palStringUtil.h"
 #include "palUtil.h"
 #include <type_traits>
@@ -40,6 +41,640 @@
 namespace Util
 {
 
+/// @internal Search kernels behind the StringView<char> search functions.  Positions are indices into pData; every
+/// kernel returns StringViewKernels::NotFound if there is no match.  On x86-64 they use SSE2, and AVX2 for longer
+/// strings when the CPU supports it.  Vector loads never read outside [pData, pData + length): the last partial block
+/// is handled with an overlapping load when the string is long enough, and with scalar code otherwise.
+namespace StringViewKernels
+{
+
+constexpr uint32 NotFound = UINT32_MAX;
+
+/// Strings at least this long are searched with AVX2 when it is available.
+constexpr uint32 Avx2MinLength = 64;
+
+// =====================================================================================================================
+// ASCII-only lowercase, the folding used by EqualsIgnoreCase().
+template<typename CharT>
+constexpr CharT FoldCase(
+    CharT c)
+{
+    return ((c >= 'A') && (c <= 'Z')) ? static_cast<CharT>(c | 0x20) : c;
+}
+
+#if PAL_SIMD_X86
+// =====================================================================================================================
+inline uint32 FindCharSse2(
+    const char* pData,
+    uint32      length,
+    uint32      pos,
+    char        c)
+{
+    const __m128i needle = _mm_set1_epi8(c);
+
+    uint32 result = NotFound;
+    uint32 bit    = 0;
+
+    // Skip 64 characters at a time while none of them match, then locate the match 16 at a time.
+    for (; (pos + 64) <= length; pos += 64)
+    {
+        const __m128i* pBlocks = reinterpret_cast<const __m128i*>(pData + pos);
+        const __m128i  matches = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(_mm_loadu_si128(pBlocks),     needle),
+                                                           _mm_cmpeq_epi8(_mm_loadu_si128(pBlocks + 1), needle)),
+                                              _mm_or_si128(_mm_cmpeq_epi8(_mm_loadu_si128(pBlocks + 2), needle),
+                                                           _mm_cmpeq_epi8(_mm_loadu_si128(pBlocks + 3), needle)));
+
+        if (_mm_movemask_epi8(matches) != 0)
+        {
+            break;
+        }
+    }
+
+    for (; (pos + 16) <= length; pos += 16)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + pos));
+
+        if (BitMaskScanForward(&bit, uint32(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)))))
+        {
+            result = pos + bit;
+            break;
+        }
+    }
+
+    if ((result == NotFound) && (pos < length))
+    {
+        if (length >= 16)
+        {
+            const uint32  base  = length - 16;
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + base));
+            const uint32  mask  = uint32(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle))) >> (pos - base);
+
+            result = BitMaskScanForward(&bit, mask) ? (pos + bit) : NotFound;
+        }
+        else
+        {
+            for (; (pos < length) && (pData[pos] != c); ++pos);
+            result = (pos < length) ? pos : NotFound;
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+inline PAL_SIMD_AVX2_TARGET uint32 FindCharAvx2(
+    const char* pData,
+    uint32      length,
+    uint32      pos,
+    char        c)
+{
+    PAL_ASSERT(length >= 32);
+
+    const __m256i needle = _mm256_set1_epi8(c);
+
+    uint32 result = NotFound;
+    uint32 bit    = 0;
+
+    // Skip 128 characters at a time while none of them match, then locate the match 32 at a time.
+    for (; (pos + 128) <= length; pos += 128)
+    {
+        const __m256i* pBlocks = reinterpret_cast<const __m256i*>(pData + pos);
+        const __m256i  matches =
+            _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256(pBlocks),     needle),
+                                            _mm256_cmpeq_epi8(_mm256_loadu_si256(pBlocks + 1), needle)),
+                            _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256(pBlocks + 2), needle),
+                                            _mm256_cmpeq_epi8(_mm256_loadu_si256(pBlocks + 3), needle)));
+
+        if (_mm256_testz_si256(matches, matches) == 0)
+        {
+            break;
+        }
+    }
+
+    for (; (pos + 32) <= length; pos += 32)
+    {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData + pos));
+
+        if (BitMaskScanForward(&bit, uint32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)))))
+        {
+            result = pos + bit;
+            break;
+        }
+    }
+
+    if ((result == NotFound) && (pos < length))
+    {
+        const uint32  base  = length - 32;
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData + base));
+        const uint32  mask  = uint32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle))) >> (pos - base);
+
+        result = BitMaskScanForward(&bit, mask) ? (pos + bit) : NotFound;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+inline uint32 RFindCharSse2(
+    const char* pData,
+    uint32      length,
+    char        c)
+{
+    const __m128i needle = _mm_set1_epi8(c);
+
+    uint32 result = NotFound;
+    uint32 bit    = 0;
+    uint32 end    = length;
+
+    for (; end >= 16; end -= 16)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + end - 16));
+
+        if (BitMaskScanReverse(&bit, uint32(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)))))
+        {
+            result = end - 16 + bit;
+            break;
+        }
+    }
+
+    if ((result == NotFound) && (end > 0))
+    {
+        if (length >= 16)
+        {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData));
+            const uint32  mask  = uint32(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle))) & ((1u << end) - 1);
+
+            result = BitMaskScanReverse(&bit, mask) ? bit : NotFound;
+        }
+        else
+        {
+            for (; (end > 0) && (pData[end - 1] != c); --end);
+            result = (end > 0) ? (end - 1) : NotFound;
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+inline PAL_SIMD_AVX2_TARGET uint32 RFindCharAvx2(
+    const char* pData,
+    uint32      length,
+    char        c)
+{
+    PAL_ASSERT(length >= 32);
+
+    const __m256i needle = _mm256_set1_epi8(c);
+
+    uint32 result = NotFound;
+    uint32 bit    = 0;
+    uint32 end    = length;
+
+    for (; end >= 32; end -= 32)
+    {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData + end - 32));
+
+        if (BitMaskScanReverse(&bit, uint32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)))))
+        {
+            result = end - 32 + bit;
+            break;
+        }
+    }
+
+    if ((result == NotFound) && (end > 0))
+    {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData));
+        const uint32  mask  = uint32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle))) & ((1u << end) - 1);
+
+        result = BitMaskScanReverse(&bit, mask) ? bit : NotFound;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Compares the first and last character of the needle at 16 positions at once and verifies the candidates with
+// memcmp.  Stops where fewer than 16 positions remain; *pPos receives the first position not examined.
+inline uint32 FindStringSse2(
+    const char* pData,
+    uint32      length,
+    uint32*     pPos,
+    const char* pNeedle,
+    uint32      needleLength)
+{
+    const __m128i first = _mm_set1_epi8(pNeedle[0]);
+    const __m128i last  = _mm_set1_epi8(pNeedle[needleLength - 1]);
+
+    uint32 result = NotFound;
+    uint32 pos    = *pPos;
+
+    for (; (result == NotFound) && ((pos + needleLength - 1 + 16) <= length); pos += 16)
+    {
+        const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + pos));
+        const __m128i blockLast  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + pos + needleLength - 1));
+
+        uint32 mask = uint32(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first),
+                                                             _mm_cmpeq_epi8(blockLast, last))));
+        uint32 bit  = 0;
+
+        for (; BitMaskScanForward(&bit, mask); mask = UnsetLeastBit(mask))
+        {
+            if (memcmp(pData + pos + bit + 1, pNeedle + 1, needleLength - 2) == 0)
+            {
+                result = pos + bit;
+                break;
+            }
+        }
+    }
+
+    *pPos = pos;
+
+    return result;
+}
+
+// =====================================================================================================================
+// The AVX2 version of FindStringSse2().
+inline PAL_SIMD_AVX2_TARGET uint32 FindStringAvx2(
+    const char* pData,
+    uint32      length,
+    uint32*     pPos,
+    const char* pNeedle,
+    uint32      needleLength)
+{
+    const __m256i first = _mm256_set1_epi8(pNeedle[0]);
+    const __m256i last  = _mm256_set1_epi8(pNeedle[needleLength - 1]);
+
+    uint32 result = NotFound;
+    uint32 pos    = *pPos;
+
+    // Skip 64 positions at a time while none of them is a candidate.
+    for (; (pos + needleLength - 1 + 64) <= length; pos += 64)
+    {
+        const char*const pFirst = pData + pos;
+        const char*const pLast  = pData + pos + needleLength - 1;
+
+        const __m256i candidates =
+            _mm256_or_si256(
+                _mm256_and_si256(
+                    _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pFirst)), first),
+                    _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pLast)), last)),
+                _mm256_and_si256(
+                    _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pFirst + 32)), first),
+                    _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pLast + 32)), last)));
+
+        if (_mm256_testz_si256(candidates, candidates) == 0)
+        {
+            break;
+        }
+    }
+
+    for (; (result == NotFound) && ((pos + needleLength - 1 + 32) <= length); pos += 32)
+    {
+        const __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData + pos));
+        const __m256i blockLast  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData + pos + needleLength - 1));
+
+        uint32 mask = uint32(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first),
+                                                                   _mm256_cmpeq_epi8(blockLast, last))));
+        uint32 bit  = 0;
+
+        for (; BitMaskScanForward(&bit, mask); mask = UnsetLeastBit(mask))
+        {
+            if (memcmp(pData + pos + bit + 1, pNeedle + 1, needleLength - 2) == 0)
+            {
+                result = pos + bit;
+                break;
+            }
+        }
+    }
+
+    *pPos = pos;
+
+    return result;
+}
+
+// =====================================================================================================================
+// Searches for any of up to 16 characters from *pPos on.  Stops where fewer than 16 characters remain; *pPos receives
+// the first position not examined.
+inline uint32 FindFirstOfSse2(
+    const char* pData,
+    uint32      length,
+    uint32*     pPos,
+    const char* pSet,
+    uint32      setLength)
+{
+    PAL_ASSERT(setLength <= 16);
+
+    __m128i set[16];
+    for (uint32 i = 0; i < setLength; ++i)
+    {
+        set[i] = _mm_set1_epi8(pSet[i]);
+    }
+
+    uint32 result = NotFound;
+    uint32 pos    = *pPos;
+
+    for (; (pos + 16) <= length; pos += 16)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + pos));
+
+        __m128i matches = _mm_setzero_si128();
+        for (uint32 i = 0; i < setLength; ++i)
+        {
+            matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, set[i]));
+        }
+
+        uint32 bit = 0;
+        if (BitMaskScanForward(&bit, uint32(_mm_movemask_epi8(matches))))
+        {
+            result = pos + bit;
+            break;
+        }
+    }
+
+    *pPos = pos;
+
+    return result;
+}
+
+// =====================================================================================================================
+// Folds ASCII uppercase letters to lowercase in 16 characters.  Bytes of 0x80 and up compare as negative, so they are
+// never treated as letters.
+inline __m128i FoldCaseSse2(
+    __m128i chars)
+{
+    const __m128i isUpper = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('A' - 1)),
+                                          _mm_cmplt_epi8(chars, _mm_set1_epi8('Z' + 1)));
+
+    return _mm_or_si128(chars, _mm_and_si128(isUpper, _mm_set1_epi8(0x20)));
+}
+
+// =====================================================================================================================
+// Compares two strings 16 characters at a time from *pPos on, ignoring ASCII case.  *pPos receives the first position
+// not compared.
+inline bool EqualsIgnoreCaseSse2(
+    const char* pA,
+    const char* pB,
+    uint32      length,
+    uint32*     pPos)
+{
+    bool   equal = true;
+    uint32 pos   = *pPos;
+
+    for (; equal && ((pos + 16) <= length); pos += 16)
+    {
+        const __m128i a = FoldCaseSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pA + pos)));
+        const __m128i b = FoldCaseSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pB + pos)));
+
+        equal = (_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) == 0xFFFF);
+    }
+
+    *pPos = pos;
+
+    return equal;
+}
+
+// =====================================================================================================================
+// The AVX2 version of FindFirstOfSse2().
+inline PAL_SIMD_AVX2_TARGET uint32 FindFirstOfAvx2(
+    const char* pData,
+    uint32      length,
+    uint32*     pPos,
+    const char* pSet,
+    uint32      setLength)
+{
+    PAL_ASSERT(setLength <= 16);
+
+    __m256i set[16];
+    for (uint32 i = 0; i < setLength; ++i)
+    {
+        set[i] = _mm256_set1_epi8(pSet[i]);
+    }
+
+    uint32 result = NotFound;
+    uint32 pos    = *pPos;
+
+    for (; (pos + 32) <= length; pos += 32)
+    {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData + pos));
+
+        __m256i matches = _mm256_setzero_si256();
+        for (uint32 i = 0; i < setLength; ++i)
+        {
+            matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(block, set[i]));
+        }
+
+        uint32 bit = 0;
+        if (BitMaskScanForward(&bit, uint32(_mm256_movemask_epi8(matches))))
+        {
+            result = pos + bit;
+            break;
+        }
+    }
+
+    *pPos = pos;
+
+    return result;
+}
+
+// =====================================================================================================================
+// The AVX2 version of FoldCaseSse2().
+inline PAL_SIMD_AVX2_TARGET __m256i FoldCaseAvx2(
+    __m256i chars)
+{
+    const __m256i isUpper = _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('A' - 1)),
+                                             _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), chars));
+
+    return _mm256_or_si256(chars, _mm256_and_si256(isUpper, _mm256_set1_epi8(0x20)));
+}
+
+// =====================================================================================================================
+// The AVX2 version of EqualsIgnoreCaseSse2().
+inline PAL_SIMD_AVX2_TARGET bool EqualsIgnoreCaseAvx2(
+    const char* pA,
+    const char* pB,
+    uint32      length,
+    uint32*     pPos)
+{
+    bool   equal = true;
+    uint32 pos   = *pPos;
+
+    for (; equal && ((pos + 32) <= length); pos += 32)
+    {
+        const __m256i a = FoldCaseAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pA + pos)));
+        const __m256i b = FoldCaseAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pB + pos)));
+
+        equal = (uint32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b))) == UINT32_MAX);
+    }
+
+    *pPos = pos;
+
+    return equal;
+}
+#endif
+
+/// Returns the index of the first c at or after pos.
+inline uint32 FindChar(
+    const char* pData,
+    uint32      length,
+    uint32      pos,
+    char        c)
+{
+#if PAL_SIMD_X86
+    return (((length - pos) >= Avx2MinLength) && CpuSupportsAvx2()) ? FindCharAvx2(pData, length, pos, c)
+                                                                    : FindCharSse2(pData, length, pos, c);
+#else
+    const void*const pFound = memchr(pData + pos, c, length - pos);
+    return (pFound != nullptr) ? uint32(static_cast<const char*>(pFound) - pData) : NotFound;
+#endif
+}
+
+/// Returns the index of the last c.
+inline uint32 RFindChar(
+    const char* pData,
+    uint32      length,
+    char        c)
+{
+    uint32 result = NotFound;
+
+#if PAL_SIMD_X86
+    result = ((length >= Avx2MinLength) && CpuSupportsAvx2()) ? RFindCharAvx2(pData, length, c)
+                                                              : RFindCharSse2(pData, length, c);
+#else
+    for (uint32 end = length; end > 0; --end)
+    {
+        if (pData[end - 1] == c)
+        {
+            result = end - 1;
+            break;
+        }
+    }
+#endif
+
+    return result;
+}
+
+/// Returns the index of the first occurrence of the needle at or after pos.  The needle must be at least 2
+/// characters long and fit in [pos, length).
+inline uint32 FindString(
+    const char* pData,
+    uint32      length,
+    uint32      pos,
+    const char* pNeedle,
+    uint32      needleLength)
+{
+    PAL_ASSERT((needleLength >= 2) && (needleLength <= (length - pos)));
+
+    uint32 result = NotFound;
+
+#if PAL_SIMD_X86
+    if (((length - pos) >= Avx2MinLength) && CpuSupportsAvx2())
+    {
+        result = FindStringAvx2(pData, length, &pos, pNeedle, needleLength);
+    }
+
+    if (result == NotFound)
+    {
+        result = FindStringSse2(pData, length, &pos, pNeedle, needleLength);
+    }
+#endif
+
+    const char firstChar = pNeedle[0];
+    const char lastChar  = pNeedle[needleLength - 1];
+
+    for (; (result == NotFound) && (pos <= (length - needleLength)); ++pos)
+    {
+        if ((pData[pos] == firstChar)                    &&
+            (pData[pos + needleLength - 1] == lastChar) &&
+            (memcmp(pData + pos + 1, pNeedle + 1, needleLength - 2) == 0))
+        {
+            result = pos;
+        }
+    }
+
+    return result;
+}
+
+/// Returns the index of the first character at or after pos that is in the set.
+inline uint32 FindFirstOf(
+    const char* pData,
+    uint32      length,
+    uint32      pos,
+    const char* pSet,
+    uint32      setLength)
+{
+    uint32 result = NotFound;
+
+#if PAL_SIMD_X86
+    if (setLength <= 16)
+    {
+        if (((length - pos) >= Avx2MinLength) && CpuSupportsAvx2())
+        {
+            result = FindFirstOfAvx2(pData, length, &pos, pSet, setLength);
+        }
+
+        if (result == NotFound)
+        {
+            result = FindFirstOfSse2(pData, length, &pos, pSet, setLength);
+        }
+    }
+#endif
+
+    if ((result == NotFound) && (pos < length))
+    {
+        // Test the rest against a 256-bit membership table.
+        uint64 table[4] = {};
+        for (uint32 i = 0; i < setLength; ++i)
+        {
+            const uint8 c = uint8(pSet[i]);
+            table[c >> 6] |= (1ull << (c & 63));
+        }
+
+        for (; pos < length; ++pos)
+        {
+            const uint8 c = uint8(pData[pos]);
+
+            if ((table[c >> 6] & (1ull << (c & 63))) != 0)
+            {
+                result = pos;
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
+/// Returns true if the two strings of the given length are equal, ignoring the case of ASCII letters.
+inline bool EqualsIgnoreCase(
+    const char* pA,
+    const char* pB,
+    uint32      length)
+{
+    uint32 pos   = 0;
+    bool   equal = true;
+
+#if PAL_SIMD_X86
+    if ((length >= Avx2MinLength) && CpuSupportsAvx2())
+    {
+        equal = EqualsIgnoreCaseAvx2(pA, pB, length, &pos);
+    }
+
+    equal = equal && EqualsIgnoreCaseSse2(pA, pB, length, &pos);
+#endif
+
+    for (; equal && (pos < length); ++pos)
+    {
+        equal = (FoldCase(pA[pos]) == FoldCase(pB[pos]));
+    }
+
+    return equal;
+}
+
+} // StringViewKernels
+
+template<typename CharT>
+class StringViewSplitIterator;
+
 /**
 ***********************************************************************************************************************
 * @brief String view.
@@ -147,6 +782,65 @@ public:
     /// @returns True if the view points to an empty or non-existing data storage.
     constexpr bool IsEmpty() const { return (m_length == 0); }
 
+    /// Returned by the search functions when there is no match.
+    static constexpr uint32 NotFound = StringViewKernels::NotFound;
+
+    /// Finds the first occurrence of a character.
+    ///
+    /// @param [in] c     Character to search for.
+    /// @param [in] start Index to start searching at.
+    ///
+    /// @returns The index of the character, or NotFound.
+    uint32 Find(CharT c, uint32 start = 0) const;
+
+    /// Finds the first occurrence of a substring.  An empty needle is found at start.
+    ///
+    /// @param [in] needle Substring to search for.
+    /// @param [in] start  Index to start searching at.
+    ///
+    /// @returns The index of the first character of the match, or NotFound.
+    uint32 Find(StringView needle, uint32 start = 0) const;
+
+    /// Finds the last occurrence of a character.
+    ///
+    /// @returns The index of the character, or NotFound.
+    uint32 RFind(CharT c) const;
+
+    /// Finds the last occurrence of a substring.  An empty needle is found at Length().
+    ///
+    /// @returns The index of the first character of the match, or NotFound.
+    uint32 RFind(StringView needle) const;
+
+    /// Finds the first character that is any of the characters in set.
+    ///
+    /// @param [in] set   Characters to search for.  Sets of up to 16 characters are searched fastest.
+    /// @param [in] start Index to start searching at.
+    ///
+    /// @returns The index of the character, or NotFound.
+    uint32 FindFirstOf(StringView set, uint32 start = 0) const;
+
+    /// Returns true if the view begins with prefix.
+    bool StartsWith(StringView prefix) const
+    {
+        return (prefix.Length() <= Length()) &&
+               ((prefix.Length() == 0) || (memcmp(Data(), prefix.Data(), prefix.Length() * sizeof(CharT)) == 0));
+    }
+
+    /// Returns true if the view ends with suffix.
+    bool EndsWith(StringView suffix) const
+    {
+        return (suffix.Length() <= Length()) &&
+               ((suffix.Length() == 0) ||
+                (memcmp(Data() + Length() - suffix.Length(), suffix.Data(), suffix.Length() * sizeof(CharT)) == 0));
+    }
+
+    /// Compares two views, treating ASCII letters of either case as equal.  Other characters must match exactly.
+    bool EqualsIgnoreCase(StringView other) const;
+
+    /// Returns an iterator over the pieces of the view between occurrences of delimiter.  A view containing N
+    /// delimiters has N + 1 pieces, some of which may be empty; an empty view has one empty piece.
+    StringViewSplitIterator<CharT> Split(CharT delimiter) const;
+
     ///@{
     /// @internal Satisfies concept `range_expression`, using CharT* as `iterator`.
     ///
@@ -163,6 +857,265 @@ private:
     uint32       m_length;
 };
 
+/**
+***********************************************************************************************************************
+* @brief Iterator over the pieces of a @ref StringView separated by a delimiter character.  See StringView::Split().
+***********************************************************************************************************************
+*/
+template<typename CharT>
+class StringViewSplitIterator
+{
+public:
+    /// Returns true while the iterator points at a piece.
+    bool IsValid() const { return (m_pieceStart != StringView<CharT>::NotFound); }
+
+    /// Returns the current piece, without its delimiter.
+    StringView<CharT> Get() const
+    {
+        PAL_ASSERT(IsValid());
+        return StringView<CharT>(m_string.Data() + m_pieceStart, m_pieceEnd - m_pieceStart);
+    }
+
+    /// Advances to the next piece.
+    void Next()
+    {
+        PAL_ASSERT(IsValid());
+
+        if (m_pieceEnd == m_string.Length())
+        {
+            m_pieceStart = StringView<CharT>::NotFound;
+        }
+        else
+        {
+            m_pieceStart = m_pieceEnd + 1;
+            FindPieceEnd();
+        }
+    }
+
+private:
+    StringViewSplitIterator(StringView<CharT> string, CharT delimiter)
+        :
+        m_string(string),
+        m_delimiter(delimiter),
+        m_pieceStart(0),
+        m_pieceEnd(0)
+    {
+        FindPieceEnd();
+    }
+
+    void FindPieceEnd()
+    {
+        const uint32 delimiterIndex = m_string.Find(m_delimiter, m_pieceStart);
+
+        m_pieceEnd = (delimiterIndex != StringView<CharT>::NotFound) ? delimiterIndex : m_string.Length();
+    }
+
+    StringView<CharT> m_string;     // The view being split.
+    CharT             m_delimiter;  // Character separating the pieces.
+    uint32            m_pieceStart; // Index of the current piece, or NotFound once the pieces are exhausted.
+    uint32            m_pieceEnd;   // Index just past the current piece.
+
+    friend class StringView<CharT>;
+};
+
+// =====================================================================================================================
+template<typename CharT>
+uint32 StringView<CharT>::Find(
+    CharT  c,
+    uint32 start
+    ) const
+{
+    uint32 result = NotFound;
+
+    if (start < Length())
+    {
+        if constexpr (std::is_same<CharT, char>::value)
+        {
+            result = StringViewKernels::FindChar(Data(), Length(), start, c);
+        }
+        else
+        {
+            for (uint32 i = start; i < Length(); ++i)
+            {
+                if (m_pData[i] == c)
+                {
+                    result = i;
+                    break;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template<typename CharT>
+uint32 StringView<CharT>::Find(
+    StringView needle,
+    uint32     start
+    ) const
+{
+    uint32 result = NotFound;
+
+    if ((start <= Length()) && (needle.Length() <= (Length() - start)))
+    {
+        if (needle.Length() == 0)
+        {
+            result = start;
+        }
+        else if (needle.Length() == 1)
+        {
+            result = Find(needle[0], start);
+        }
+        else if constexpr (std::is_same<CharT, char>::value)
+        {
+            result = StringViewKernels::FindString(Data(), Length(), start, needle.Data(), needle.Length());
+        }
+        else
+        {
+            for (uint32 i = start; i <= (Length() - needle.Length()); ++i)
+            {
+                if (memcmp(m_pData + i, needle.Data(), needle.Length() * sizeof(CharT)) == 0)
+                {
+                    result = i;
+                    break;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template<typename CharT>
+uint32 StringView<CharT>::RFind(
+    CharT c
+    ) const
+{
+    uint32 result = NotFound;
+
+    if constexpr (std::is_same<CharT, char>::value)
+    {
+        result = StringViewKernels::RFindChar(Data(), Length(), c);
+    }
+    else
+    {
+        for (uint32 end = Length(); end > 0; --end)
+        {
+            if (m_pData[end - 1] == c)
+            {
+                result = end - 1;
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template<typename CharT>
+uint32 StringView<CharT>::RFind(
+    StringView needle
+    ) const
+{
+    uint32 result = NotFound;
+
+    if (needle.Length() == 0)
+    {
+        result = Length();
+    }
+    else if (needle.Length() <= Length())
+    {
+        // Jump between occurrences of the needle's first character, last to first, and compare the rest at each.
+        const StringView candidates(m_pData, Length() - needle.Length() + 1);
+
+        for (uint32 pos = candidates.RFind(needle[0]); pos != NotFound; )
+        {
+            if (memcmp(m_pData + pos, needle.Data(), needle.Length() * sizeof(CharT)) == 0)
+            {
+                result = pos;
+                break;
+            }
+
+            pos = (pos > 0) ? StringView(m_pData, pos).RFind(needle[0]) : NotFound;
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template<typename CharT>
+uint32 StringView<CharT>::FindFirstOf(
+    StringView set,
+    uint32     start
+    ) const
+{
+    uint32 result = NotFound;
+
+    if ((start < Length()) && (set.IsEmpty() == false))
+    {
+        if constexpr (std::is_same<CharT, char>::value)
+        {
+            result = StringViewKernels::FindFirstOf(Data(), Length(), start, set.Data(), set.Length());
+        }
+        else
+        {
+            for (uint32 i = start; (result == NotFound) && (i < Length()); ++i)
+            {
+                for (uint32 j = 0; j < set.Length(); ++j)
+                {
+                    if (m_pData[i] == set[j])
+                    {
+                        result = i;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template<typename CharT>
+bool StringView<CharT>::EqualsIgnoreCase(
+    StringView other
+    ) const
+{
+    bool equal = (Length() == other.Length());
+
+    if (equal && (Data() != other.Data()))
+    {
+        if constexpr (std::is_same<CharT, char>::value)
+        {
+            equal = StringViewKernels::EqualsIgnoreCase(Data(), other.Data(), Length());
+        }
+        else
+        {
+            for (uint32 i = 0; equal && (i < Length()); ++i)
+            {
+                equal = (StringViewKernels::FoldCase(m_pData[i]) == StringViewKernels::FoldCase(other[i]));
+            }
+        }
+    }
+
+    return equal;
+}
+
+// =====================================================================================================================
+template<typename CharT>
+StringViewSplitIterator<CharT> StringView<CharT>::Split(
+    CharT delimiter
+    ) const
+{
+    return StringViewSplitIterator<CharT>(*this, delimiter);
+}
+
 // =====================================================================================================================
 template<typename CharT>
 constexpr bool operator==(
@@ -217,7 +1170,8 @@ bool operator>(StringView<CharT> x, StringView<CharT> y) { return y < x; }
 template<typename CharT>
 bool operator>=(StringView<CharT> x, StringView<CharT> y) { return (x < y) == false; }
 
-/// Specialization of @ref HashString(const char*,size_t) for @ref StringView.
+/// Specialization of @ref HashString(const char*,size_t) for @ref StringView.  Hashes the view's characters directly,
+/// without scanning for a terminator, and accepts empty views.
 template<typename T>
 constexpr uint32 HashString(
     StringView<T> sv)
@@ -781,6 +781,46 @@ void DeleteArray(T* p, Allocator* pAllocator)
     pAllocator->Free(info);
 }
 
+/// Reports whether objects of type T can be relocated (moved to new storage, leaving the old storage dead) with a
+/// plain memcpy instead of a move-construct plus destroy per object.
+///
+/// Every trivially copyable type qualifies.  Clients may specialize this to true_type for their own types which own
+/// resources through pointers but never hold pointers into themselves.
+template<typename T>
+struct IsTriviallyRelocatable : std::bool_constant<std::is_trivially_copyable<T>::value> { };
+
+/// @internal
+///
+/// Relocates an array of live objects into uninitialized, non-overlapping storage.  Trivially relocatable types are
+/// copied with a single memcpy; all other types are move-constructed into the destination and then destroyed in the
+/// source.  Either way the source objects must be treated as dead storage afterwards.
+///
+/// @param [out] pDst  Uninitialized storage for count objects.
+/// @param [in]  pSrc  Array of count live objects.
+/// @param [in]  count Number of objects to relocate.
+template<typename T>
+void RelocateArray(
+    T*     pDst,
+    T*     pSrc,
+    size_t count)
+{
+    if (IsTriviallyRelocatable<T>::value)
+    {
+        if (count > 0)
+        {
+            memcpy(static_cast<void*>(pDst), static_cast<const void*>(pSrc), sizeof(T) * count);
+        }
+    }
+    else
+    {
+        for (size_t idx = 0; idx < count; ++idx)
+        {
+            PAL_PLACEMENT_NEW(pDst + idx) T(Move(pSrc[idx]));
+            pSrc[idx].~T();
+        }
+    }
+}
+
 constexpr size_t FastMemCpyMaxSmallSize = 64;
 
 typedef void* (PAL_CDECL *FastMemCpySmallFunc)(void* pDst, const void* pSrc, size_t count);
@@ -0,0 +1,875 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palTaskPool.h
+ * @brief PAL utility collection TaskPool class and ParallelFor, ParallelReduce and ParallelSort declarations and
+ *        implementations.
+ ***********************************************************************************************************************
+ */
+
+#pragma once
+
+#include "palEvent.h"
+#include "palInlineFuncs.h"
+#include "palMutex.h"
+#include "palSpan.h"
+#include "palSysMemory.h"
+#include <atomic>
+#include <thread>
+
+namespace Util
+{
+
+/// Specifies the properties of a @ref TaskPool.
+struct TaskPoolCreateInfo
+{
+    uint32 numThreads;  ///< Threads tasks run on, counting the thread that enters the pool.  0 selects one per CPU.
+    uint32 queueDepth;  ///< Capacity of each thread's task deque.  Rounded up to a power of two; 0 selects 1024.
+};
+
+class TaskGroup;
+
+/// A unit of work for a @ref TaskPool.  Clients derive from this, set pfnExecute and keep the object alive until the
+/// group it was spawned into has been waited on.
+struct Task
+{
+    void      (*pfnExecute)(Task* pTask);  ///< Runs the task; called with this object.
+    TaskGroup*  pGroup;                    ///< Set by TaskPool::Spawn().
+};
+
+/**
+ ***********************************************************************************************************************
+ * @brief Counts the outstanding tasks spawned into it, so a @ref TaskPool can wait for all of them.
+ ***********************************************************************************************************************
+ */
+class TaskGroup
+{
+public:
+    TaskGroup() : m_numPending(0) { }
+
+    /// @returns True if every task spawned into this group has finished.
+    bool IsDone() const { return (m_numPending.load(std::memory_order_acquire) == 0); }
+
+private:
+    template <typename Allocator> friend class TaskPool;
+
+    std::atomic<uint32> m_numPending;
+
+    PAL_DISALLOW_COPY_AND_ASSIGN(TaskGroup);
+};
+
+/**
+ ***********************************************************************************************************************
+ * @brief Work-stealing thread pool for fork-join parallelism on the CPU.
+ *
+ * A pool of numThreads runs tasks on numThreads - 1 worker threads plus the thread that entered it.  Every one of those
+ * threads owns a fixed-size Chase-Lev deque: Spawn() pushes to the bottom of the calling thread's deque and the owner
+ * pops from the bottom again, so the most recently forked (and cache-warm) work runs first, while idle threads steal
+ * the oldest, typically largest, tasks from the top of other deques.  Wait() does not block: the waiting thread keeps
+ * running tasks until its group is done.  Workers that find nothing to steal sleep on an @ref Event and are woken by
+ * the next Spawn().
+ *
+ * Spawn() and Wait() must be called from a thread that is in the pool, either one of its workers (i.e., from inside a
+ * task) or a thread that has entered it with @ref TaskPoolAuto.  Only one outside thread is in the pool at a time;
+ * others wait in TaskPoolAuto's constructor.  The ParallelFor(), ParallelReduce() and ParallelSort() algorithms below
+ * enter the pool themselves.
+ *
+ * If a deque is full the spawned task runs immediately on the spawning thread, which is always correct for fork-join.
+ ***********************************************************************************************************************
+ */
+template <typename Allocator>
+class TaskPool
+{
+public:
+    /// Constructor.
+    ///
+    /// @param [in] pAllocator The allocator the deques and threads are allocated with.
+    explicit TaskPool(Allocator*const pAllocator);
+
+    /// Stops and joins the worker threads.  No tasks may be outstanding.
+    ~TaskPool();
+
+    /// Allocates the deques and starts the worker threads.
+    ///
+    /// @param [in] createInfo Pool properties; zeroed fields select the defaults.
+    ///
+    /// @returns Success if the pool is ready, ErrorOutOfMemory if an allocation failed, or the error from
+    ///          initializing the wake event.
+    Result Init(const TaskPoolCreateInfo& createInfo);
+
+    /// @returns The number of threads tasks run on, counting the thread in the pool.
+    uint32 NumThreads() const { return m_numSlots; }
+
+    /// @returns True if the calling thread is a worker of this pool or has entered it.
+    bool IsCurrentThreadInPool() const { return (CurrentBinding().pPool == this); }
+
+    /// Makes the calling thread the pool's outside thread, waiting while another thread is.  Use @ref TaskPoolAuto.
+    void Enter();
+
+    /// Undoes Enter().
+    void Leave();
+
+    /// Queues a task on the calling thread's deque.  The calling thread must be in the pool.
+    ///
+    /// @param [in] pGroup The group the task counts towards.
+    /// @param [in] pTask  The task; it must stay alive until pGroup is done.
+    void Spawn(TaskGroup* pGroup, Task* pTask);
+
+    /// Runs queued tasks on the calling thread until every task spawned into pGroup has finished.  The calling thread
+    /// must be in the pool.
+    void Wait(TaskGroup* pGroup);
+
+private:
+    // One Chase-Lev deque.  The owner writes bottom and thieves compete for top, so the two live on separate lines.
+    struct alignas(64) WorkDeque
+    {
+        std::atomic<int64>              top;
+        alignas(64) std::atomic<int64>  bottom;
+        std::atomic<Task*>*             pSlots;
+    };
+
+    // The pool, if any, the calling thread is in and the deque it owns there.
+    struct ThreadBinding
+    {
+        const void* pPool;
+        uint32      slot;
+    };
+
+    static ThreadBinding& CurrentBinding()
+    {
+        thread_local ThreadBinding binding = {};
+        return binding;
+    }
+
+    bool  Push(WorkDeque* pDeque, Task* pTask);
+    Task* Pop(WorkDeque* pDeque);
+    Task* Steal(WorkDeque* pDeque);
+    Task* FindTask(uint32 slot);
+    bool  HasQueuedTasks() const;
+    void  Execute(Task* pTask);
+    void  WorkerMain(uint32 slot);
+
+    // Steal rounds an idle worker makes, yielding between them, before it sleeps.
+    static constexpr uint32 IdleSpinCount = 64;
+
+    Allocator*const     m_pAllocator;
+    uint32              m_numSlots;       // Deques: slot 0 belongs to the outside thread, the rest to the workers.
+    int64               m_queueMask;
+    WorkDeque*          m_pDeques;
+    std::atomic<Task*>* m_pTaskSlots;
+    std::thread*        m_pWorkers;       // m_numSlots - 1 worker threads.
+
+    Mutex               m_enterLock;      // Held by the outside thread while it is in the pool.
+    ThreadBinding       m_savedBinding;   // The outside thread's binding from before Enter().
+
+    Event               m_wakeEvent;      // Set when work is queued while workers are asleep.
+    std::atomic<uint32> m_numSleeping;
+    std::atomic<bool>   m_stop;
+
+    PAL_DISALLOW_COPY_AND_ASSIGN(TaskPool);
+};
+
+// =====================================================================================================================
+template <typename Allocator>
+TaskPool<Allocator>::TaskPool(
+    Allocator*const pAllocator)
+    :
+    m_pAllocator(pAllocator),
+    m_numSlots(0),
+    m_queueMask(0),
+    m_pDeques(nullptr),
+    m_pTaskSlots(nullptr),
+    m_pWorkers(nullptr),
+    m_savedBinding(),
+    m_numSleeping(0),
+    m_stop(false)
+{
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+TaskPool<Allocator>::~TaskPool()
+{
+    if (m_pWorkers != nullptr)
+    {
+        // Each worker passes the wake on as it exits, so one Set() reaches all of them.
+        m_stop.store(true, std::memory_order_seq_cst);
+        m_wakeEvent.Set();
+
+        for (uint32 i = 0; i < (m_numSlots - 1); ++i)
+        {
+            if (m_pWorkers[i].joinable())
+            {
+                m_pWorkers[i].join();
+            }
+        }
+
+        PAL_SAFE_DELETE_ARRAY(m_pWorkers, m_pAllocator);
+    }
+
+    PAL_SAFE_FREE(m_pTaskSlots, m_pAllocator);
+    PAL_SAFE_FREE(m_pDeques, m_pAllocator);
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+Result TaskPool<Allocator>::Init(
+    const TaskPoolCreateInfo& createInfo)
+{
+    Result result = (m_pDeques == nullptr) ? Result::Success : Result::ErrorInvalidValue;
+
+    const uint32 numThreads = (createInfo.numThreads != 0) ? createInfo.numThreads
+                                                           : Max(std::thread::hardware_concurrency(), 1u);
+    const uint32 queueDepth = Pow2Pad((createInfo.queueDepth != 0) ? createInfo.queueDepth : 1024u);
+
+    if (result == Result::Success)
+    {
+        EventCreateFlags flags = {};
+        result = m_wakeEvent.Init(flags);
+    }
+
+    if (result == Result::Success)
+    {
+        m_pDeques    = static_cast<WorkDeque*>(PAL_MALLOC_ALIGNED(numThreads * sizeof(WorkDeque),
+                                                                  alignof(WorkDeque),
+                                                                  m_pAllocator,
+                                                                  AllocInternal));
+        m_pTaskSlots = static_cast<std::atomic<Task*>*>(PAL_MALLOC(size_t(numThreads) * queueDepth * sizeof(Task*),
+                                                                   m_pAllocator,
+                                                                   AllocInternal));
+        result       = ((m_pDeques != nullptr) && (m_pTaskSlots != nullptr)) ? Result::Success
+                                                                             : Result::ErrorOutOfMemory;
+    }
+
+    if (result == Result::Success)
+    {
+        for (uint32 slot = 0; slot < numThreads; ++slot)
+        {
+            WorkDeque*const pDeque = PAL_PLACEMENT_NEW(&m_pDeques[slot]) WorkDeque;
+
+            pDeque->top.store(0, std::memory_order_relaxed);
+            pDeque->bottom.store(0, std::memory_order_relaxed);
+            pDeque->pSlots = m_pTaskSlots + (size_t(slot) * queueDepth);
+
+            for (uint32 i = 0; i < queueDepth; ++i)
+            {
+                PAL_PLACEMENT_NEW(&pDeque->pSlots[i]) std::atomic<Task*>(nullptr);
+            }
+        }
+
+        m_numSlots  = numThreads;
+        m_queueMask = queueDepth - 1;
+
+        if (numThreads > 1)
+        {
+            m_pWorkers = PAL_NEW_ARRAY(std::thread, numThreads - 1, m_pAllocator, AllocInternal);
+            result     = (m_pWorkers != nullptr) ? Result::Success : Result::ErrorOutOfMemory;
+        }
+    }
+
+    if ((result == Result::Success) && (m_pWorkers != nullptr))
+    {
+        for (uint32 slot = 1; slot < numThreads; ++slot)
+        {
+            m_pWorkers[slot - 1] = std::thread([this, slot]() { WorkerMain(slot); });
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+void TaskPool<Allocator>::Enter()
+{
+    PAL_ASSERT(IsCurrentThreadInPool() == false);
+
+    m_enterLock.Lock();
+
+    ThreadBinding& binding = CurrentBinding();
+
+    m_savedBinding = binding;
+    binding.pPool  = this;
+    binding.slot   = 0;
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+void TaskPool<Allocator>::Leave()
+{
+    PAL_ASSERT((CurrentBinding().pPool == this) && (CurrentBinding().slot == 0));
+
+    CurrentBinding() = m_savedBinding;
+
+    m_enterLock.Unlock();
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+void TaskPool<Allocator>::Spawn(
+    TaskGroup* pGroup,
+    Task*      pTask)
+{
+    PAL_ASSERT(IsCurrentThreadInPool());
+
+    pTask->pGroup = pGroup;
+    pGroup->m_numPending.fetch_add(1, std::memory_order_relaxed);
+
+    if (Push(&m_pDeques[CurrentBinding().slot], pTask))
+    {
+        // Pairs with the sleeping worker's increment and re-check in WorkerMain(): either it sees the new task or this
+        // sees it asleep.
+        if (m_numSleeping.load(std::memory_order_seq_cst) != 0)
+        {
+            m_wakeEvent.Set();
+        }
+    }
+    else
+    {
+        Execute(pTask);
+    }
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+void TaskPool<Allocator>::Wait(
+    TaskGroup* pGroup)
+{
+    PAL_ASSERT(IsCurrentThreadInPool());
+
+    const uint32 slot = CurrentBinding().slot;
+
+    while (pGroup->IsDone() == false)
+    {
+        Task*const pTask = FindTask(slot);
+
+        if (pTask != nullptr)
+        {
+            Execute(pTask);
+        }
+        else
+        {
+            YieldThread();
+        }
+    }
+}
+
+// =====================================================================================================================
+// Pushes a task onto the bottom of the calling thread's own deque.  Returns false if the deque is full.
+template <typename Allocator>
+bool TaskPool<Allocator>::Push(
+    WorkDeque* pDeque,
+    Task*      pTask)
+{
+    const int64 bottom = pDeque->bottom.load(std::memory_order_relaxed);
+    const int64 top    = pDeque->top.load(std::memory_order_acquire);
+    const bool  hasRoom = ((bottom - top) <= m_queueMask);
+
+    if (hasRoom)
+    {
+        pDeque->pSlots[bottom & m_queueMask].store(pTask, std::memory_order_relaxed);
+        pDeque->bottom.store(bottom + 1, std::memory_order_seq_cst);
+    }
+
+    return hasRoom;
+}
+
+// =====================================================================================================================
+// Pops the most recently pushed task from the bottom of the calling thread's own deque.  Only the last task can be
+// contended by a thief; the top CAS decides who gets it.
+template <typename Allocator>
+Task* TaskPool<Allocator>::Pop(
+    WorkDeque* pDeque)
+{
+    const int64 bottom = pDeque->bottom.load(std::memory_order_relaxed) - 1;
+
+    pDeque->bottom.store(bottom, std::memory_order_seq_cst);
+
+    int64 top   = pDeque->top.load(std::memory_order_seq_cst);
+    Task* pTask = nullptr;
+
+    if (top <= bottom)
+    {
+        pTask = pDeque->pSlots[bottom & m_queueMask].load(std::memory_order_relaxed);
+
+        if (top == bottom)
+        {
+            if (pDeque->top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst) == false)
+            {
+                pTask = nullptr;
+            }
+            pDeque->bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+    }
+    else
+    {
+        pDeque->bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    return pTask;
+}
+
+// =====================================================================================================================
+// Takes the oldest task from the top of another thread's deque.  Returns null if the deque is empty or another thread
+// won the race for the task.
+template <typename Allocator>
+Task* TaskPool<Allocator>::Steal(
+    WorkDeque* pDeque)
+{
+    int64       top    = pDeque->top.load(std::memory_order_seq_cst);
+    const int64 bottom = pDeque->bottom.load(std::memory_order_seq_cst);
+    Task*       pTask  = nullptr;
+
+    if (top < bottom)
+    {
+        pTask = pDeque->pSlots[top & m_queueMask].load(std::memory_order_relaxed);
+
+        if (pDeque->top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst) == false)
+        {
+            pTask = nullptr;
+        }
+    }
+
+    return pTask;
+}
+
+// =====================================================================================================================
+// Pops from the given slot's own deque, or failing that makes one pass over the others trying to steal.
+template <typename Allocator>
+Task* TaskPool<Allocator>::FindTask(
+    uint32 slot)
+{
+    Task* pTask = Pop(&m_pDeques[slot]);
+
+    for (uint32 i = 1; (pTask == nullptr) && (i < m_numSlots); ++i)
+    {
+        const uint32 victim = slot + i;
+
+        pTask = Steal(&m_pDeques[(victim < m_numSlots) ? victim : (victim - m_numSlots)]);
+    }
+
+    return pTask;
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+bool TaskPool<Allocator>::HasQueuedTasks() const
+{
+    bool hasTasks = false;
+
+    for (uint32 slot = 0; (hasTasks == false) && (slot < m_numSlots); ++slot)
+    {
+        hasTasks = (m_pDeques[slot].bottom.load(std::memory_order_seq_cst) >
+                    m_pDeques[slot].top.load(std::memory_order_seq_cst));
+    }
+
+    return hasTasks;
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+void TaskPool<Allocator>::Execute(
+    Task* pTask)
+{
+    // The group may be destroyed as soon as the count drops, so read it first.
+    TaskGroup*const pGroup = pTask->pGroup;
+
+    pTask->pfnExecute(pTask);
+    pGroup->m_numPending.fetch_sub(1, std::memory_order_release);
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+void TaskPool<Allocator>::WorkerMain(
+    uint32 slot)
+{
+    ThreadBinding& binding = CurrentBinding();
+
+    binding.pPool = this;
+    binding.slot  = slot;
+
+    uint32 numIdleRounds = 0;
+
+    while (m_stop.load(std::memory_order_relaxed) == false)
+    {
+        Task*const pTask = FindTask(slot);
+
+        if (pTask != nullptr)
+        {
+            numIdleRounds = 0;
+            Execute(pTask);
+        }
+        else if (++numIdleRounds < IdleSpinCount)
+        {
+            YieldThread();
+        }
+        else
+        {
+            numIdleRounds = 0;
+            m_numSleeping.fetch_add(1, std::memory_order_seq_cst);
+
+            if ((HasQueuedTasks() == false) && (m_stop.load(std::memory_order_seq_cst) == false))
+            {
+                m_wakeEvent.Wait(fseconds { 1.0f });
+            }
+
+            m_numSleeping.fetch_sub(1, std::memory_order_seq_cst);
+
+            // Sets coalesce, so if there is more work than this thread can take, pass the wake on.
+            if ((m_numSleeping.load(std::memory_order_seq_cst) != 0) && HasQueuedTasks())
+            {
+                m_wakeEvent.Set();
+            }
+        }
+    }
+
+    m_wakeEvent.Set();
+}
+
+/**
+ ***********************************************************************************************************************
+ * @brief A "resource acquisition is initialization" (RAII) wrapper which puts the calling thread in a @ref TaskPool.
+ *
+ * Does nothing if the thread is already in the pool, so it nests, and task code can use it freely.
+ ***********************************************************************************************************************
+ */
+template <typename Pool>
+class TaskPoolAuto
+{
+public:
+    /// Enters the pool unless the calling thread is already in it.
+    explicit TaskPoolAuto(Pool* pPool)
+        :
+        m_pPool(pPool),
+        m_entered(pPool->IsCurrentThreadInPool() == false)
+    {
+        if (m_entered)
+        {
+            m_pPool->Enter();
+        }
+    }
+
+    /// Leaves the pool if the constructor entered it.
+    ~TaskPoolAuto()
+    {
+        if (m_entered)
+        {
+            m_pPool->Leave();
+        }
+    }
+
+private:
+    Pool*const m_pPool;
+    const bool m_entered;
+
+    PAL_DISALLOW_DEFAULT_CTOR(TaskPoolAuto);
+    PAL_DISALLOW_COPY_AND_ASSIGN(TaskPoolAuto);
+};
+
+namespace ParallelKernels
+{
+
+// =====================================================================================================================
+// Calls fn on each grain-sized chunk in [firstChunk,endChunk) by binary splitting: the upper half is spawned, the lower
+// half recursed into.
+template <typename Pool, typename T, typename Fn>
+void ForChunks(
+    Pool*   pPool,
+    Span<T> span,
+    size_t  grain,
+    size_t  firstChunk,
+    size_t  endChunk,
+    Fn*     pFn)
+{
+    if ((endChunk - firstChunk) > 1)
+    {
+        struct ForTask : Task
+        {
+            Pool*   pPool;
+            Span<T> span;
+            size_t  grain;
+            size_t  firstChunk;
+            size_t  endChunk;
+            Fn*     pFn;
+        };
+
+        const size_t midChunk = firstChunk + ((endChunk - firstChunk) / 2);
+
+        ForTask upper;
+        upper.pfnExecute = [](Task* pTask)
+        {
+            ForTask*const pThis = static_cast<ForTask*>(pTask);
+            ForChunks(pThis->pPool, pThis->span, pThis->grain, pThis->firstChunk, pThis->endChunk, pThis->pFn);
+        };
+        upper.pPool      = pPool;
+        upper.span       = span;
+        upper.grain      = grain;
+        upper.firstChunk = midChunk;
+        upper.endChunk   = endChunk;
+        upper.pFn        = pFn;
+
+        TaskGroup group;
+        pPool->Spawn(&group, &upper);
+        ForChunks(pPool, span, grain, firstChunk, midChunk, pFn);
+        pPool->Wait(&group);
+    }
+    else
+    {
+        const size_t offset = firstChunk * grain;
+
+        (*pFn)(span.Subspan(offset, Min(grain, span.NumElements() - offset)));
+    }
+}
+
+// =====================================================================================================================
+// Maps each chunk in [firstChunk,endChunk) and combines the results over the same split tree ForChunks() uses, so the
+// order of combination is fixed.
+template <typename Pool, typename T, typename R, typename MapFn, typename CombineFn>
+R ReduceChunks(
+    Pool*      pPool,
+    Span<T>    span,
+    size_t     grain,
+    size_t     firstChunk,
+    size_t     endChunk,
+    MapFn*     pMap,
+    CombineFn* pCombine)
+{
+    R result;
+
+    if ((endChunk - firstChunk) > 1)
+    {
+        struct ReduceTask : Task
+        {
+            Pool*      pPool;
+            Span<T>    span;
+            size_t     grain;
+            size_t     firstChunk;
+            size_t     endChunk;
+            MapFn*     pMap;
+            CombineFn* pCombine;
+            R          result;
+        };
+
+        const size_t midChunk = firstChunk + ((endChunk - firstChunk) / 2);
+
+        ReduceTask upper;
+        upper.pfnExecute = [](Task* pTask)
+        {
+            ReduceTask*const pThis = static_cast<ReduceTask*>(pTask);
+            pThis->result = ReduceChunks<Pool, T, R>(pThis->pPool,
+                                                     pThis->span,
+                                                     pThis->grain,
+                                                     pThis->firstChunk,
+                                                     pThis->endChunk,
+                                                     pThis->pMap,
+                                                     pThis->pCombine);
+        };
+        upper.pPool      = pPool;
+        upper.span       = span;
+        upper.grain      = grain;
+        upper.firstChunk = midChunk;
+        upper.endChunk   = endChunk;
+        upper.pMap       = pMap;
+        upper.pCombine   = pCombine;
+
+        TaskGroup group;
+        pPool->Spawn(&group, &upper);
+        const R lower = ReduceChunks<Pool, T, R>(pPool, span, grain, firstChunk, midChunk, pMap, pCombine);
+        pPool->Wait(&group);
+
+        result = (*pCombine)(lower, upper.result);
+    }
+    else
+    {
+        const size_t offset = firstChunk * grain;
+
+        result = (*pMap)(span.Subspan(offset, Min(grain, span.NumElements() - offset)));
+    }
+
+    return result;
+}
+
+// Ranges at or below this many elements are sorted on one thread.
+constexpr size_t ParallelSortGrain = 4096;
+
+// =====================================================================================================================
+// Quicksort whose partitions are sorted in parallel: the upper partition is spawned, the lower recursed into.  Falls
+// back to heap sort of the whole range when the depth budget runs out, like IntroSortLoop().
+template <typename Pool, typename T, typename Compare>
+void SortRange(
+    Pool*    pPool,
+    T*       pStart,
+    T*       pEnd,
+    uint32   depthBudget,
+    Compare* pComp)
+{
+    if (size_t(pEnd - pStart) <= ParallelSortGrain)
+    {
+        Sort(pStart, pEnd, *pComp);
+    }
+    else if (depthBudget == 0)
+    {
+        HeapSort(pStart, pEnd, *pComp);
+    }
+    else
+    {
+        struct SortTask : Task
+        {
+            Pool*    pPool;
+            T*       pStart;
+            T*       pEnd;
+            uint32   depthBudget;
+            Compare* pComp;
+        };
+
+        T*const pPivot = SortPartition(pStart, pEnd, *pComp);
+
+        SortTask upper;
+        upper.pfnExecute  = [](Task* pTask)
+        {
+            SortTask*const pThis = static_cast<SortTask*>(pTask);
+            SortRange(pThis->pPool, pThis->pStart, pThis->pEnd, pThis->depthBudget, pThis->pComp);
+        };
+        upper.pPool       = pPool;
+        upper.pStart      = pPivot + 1;
+        upper.pEnd        = pEnd;
+        upper.depthBudget = depthBudget - 1;
+        upper.pComp       = pComp;
+
+        TaskGroup group;
+        pPool->Spawn(&group, &upper);
+        SortRange(pPool, pStart, pPivot, depthBudget - 1, pComp);
+        pPool->Wait(&group);
+    }
+}
+
+} // ParallelKernels
+
+/// Calls fn on consecutive chunks of a span in parallel.
+///
+/// The span is cut into chunks of grain elements (the last may be shorter), and fn is called once per chunk with that
+/// chunk as a subspan.  The chunking depends only on the span's size and grain, never on the number of threads or on
+/// timing, though the order the chunks run in does.
+///
+/// @param [in] pPool The pool to run on.  The calling thread enters it for the duration of the call if it is not in it.
+/// @param [in] span  The elements to process.
+/// @param [in] grain Elements per chunk.  Pick it so a chunk is tens of microseconds of work; 0 is treated as 1.
+/// @param [in] fn    Called as fn(Span<T> chunk), concurrently from several threads.
+template <typename Pool, typename T, typename Fn>
+void ParallelFor(
+    Pool*   pPool,
+    Span<T> span,
+    size_t  grain,
+    Fn&&    fn)
+{
+    if (span.IsEmpty() == false)
+    {
+        TaskPoolAuto<Pool> inPool(pPool);
+
+        grain = Max<size_t>(grain, 1);
+        ParallelKernels::ForChunks(pPool, span, grain, 0, RoundUpQuotient(span.NumElements(), grain), &fn);
+    }
+}
+
+/// Reduces a span in parallel: maps each chunk to a value and combines the values pairwise.
+///
+/// The chunks are those of @ref ParallelFor, and their values are combined over a binary tree which also depends only
+/// on the span's size and grain, so the result is the same on any number of threads even if combine is not
+/// associative (floating-point addition, for example).
+///
+/// @param [in] pPool    The pool to run on.  The calling thread enters it for the duration of the call if it is not
+///                      in it.
+/// @param [in] span     The elements to reduce.
+/// @param [in] grain    Elements per chunk; 0 is treated as 1.
+/// @param [in] identity The result for an empty span.
+/// @param [in] map      Called as map(Span<T> chunk) and returns that chunk's value as an R.
+/// @param [in] combine  Called as combine(R lower, R upper), where lower comes from the chunks before upper's.
+///
+/// @returns The combined value.
+template <typename Pool, typename T, typename R, typename MapFn, typename CombineFn>
+R ParallelReduce(
+    Pool*       pPool,
+    Span<T>     span,
+    size_t      grain,
+    R           identity,
+    MapFn&&     map,
+    CombineFn&& combine)
+{
+    R result = identity;
+
+    if (span.IsEmpty() == false)
+    {
+        TaskPoolAuto<Pool> inPool(pPool);
+
+        grain  = Max<size_t>(grain, 1);
+        result = ParallelKernels::ReduceChunks<Pool, T, R>(pPool,
+                                                           span,
+                                                           grain,
+                                                           0,
+                                                           RoundUpQuotient(span.NumElements(), grain),
+                                                           &map,
+                                                           &combine);
+    }
+
+    return result;
+}
+
+/// In-place parallel sort of a span with a caller-provided ordering.  Not order-preserving for equal elements.
+///
+/// A quicksort which sorts the two sides of each partition in parallel and hands ranges of a few thousand elements to
+/// @ref Sort.  Each partition step is done on one thread, so the first levels limit scaling on very many cores.  The
+/// order of equal elements in the result depends only on the input, not on the number of threads.
+///
+/// @param [in]     pPool The pool to run on.  The calling thread enters it for the duration of the call if it is not
+///                       in it.
+/// @param [in,out] span  The elements to sort.
+/// @param [in]     comp  Strict weak ordering; comp(a, b) returns true if a must come before b.  Called concurrently.
+template <typename Pool, typename T, typename Compare>
+void ParallelSort(
+    Pool*   pPool,
+    Span<T> span,
+    Compare comp)
+{
+    const size_t count = span.NumElements();
+
+    if (count > 1)
+    {
+        TaskPoolAuto<Pool> inPool(pPool);
+
+        ParallelKernels::SortRange(pPool, span.Data(), span.Data() + count, 2 * Log2(count), &comp);
+    }
+}
+
+/// In-place parallel sort of a span using the element type's operator<.  See the overload taking a comparator.
+template <typename Pool, typename T>
+void ParallelSort(
+    Pool*   pPool,
+    Span<T> span)
+{
+    ParallelSort(pPool, span, SortLess{});
+}
+
+} // Util
@@ -0,0 +1,824 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palTraceLogger.h
+ * @brief PAL utility collection TraceLogger class declaration and implementation.
+ ***********************************************************************************************************************
+ */
+
+#pragma once
+
+#include "palDbgPrint.h"
+#include "palEvent.h"
+#include "palFile.h"
+#include "palInlineFuncs.h"
+#include "palMutex.h"
+#include "palSysMemory.h"
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace Util
+{
+
+/// Maximum number of arguments a single trace record can carry.
+constexpr uint32 MaxTraceArgs = 12;
+
+/// Describes one trace call site.  PAL_TRACE creates one of these as a function-local constant, so its address is
+/// fixed before the program runs and serves as the ID of the format string in the binary records.
+struct TraceFormat
+{
+    const char* pFormat;  ///< Printf-style format string.
+    uint32      numArgs;  ///< Number of argument words that follow the format ID in a record.
+};
+
+/// @internal Used in an unevaluated context by PAL_TRACE to count its arguments.
+template <typename... Args>
+std::integral_constant<uint32, sizeof...(Args)> TraceArgCount(Args... args);
+
+/// @internal Converts one trace argument to the raw word stored in the ring.  Integers are sign- or zero-extended to
+/// 64 bits, floating-point values are stored as the bits of a double, and pointers (including strings) as addresses.
+template <typename T>
+uint64 TraceArgWord(
+    T value)
+{
+    uint64 word = 0;
+
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        const double asDouble = static_cast<double>(value);
+        memcpy(&word, &asDouble, sizeof(word));
+    }
+    else if constexpr (std::is_pointer_v<T>)
+    {
+        word = reinterpret_cast<uintptr_t>(value);
+    }
+    else if constexpr (std::is_enum_v<T>)
+    {
+        word = TraceArgWord(static_cast<std::underlying_type_t<T>>(value));
+    }
+    else if constexpr (std::is_null_pointer_v<T>)
+    {
+        word = 0;
+    }
+    else
+    {
+        static_assert(std::is_integral_v<T>, "Trace arguments must be integers, enums, floats or pointers.");
+
+        if constexpr (std::is_signed_v<T>)
+        {
+            word = static_cast<uint64>(static_cast<int64>(value));
+        }
+        else
+        {
+            word = static_cast<uint64>(value);
+        }
+    }
+
+    return word;
+}
+
+/// Formats one trace record the way snprintf would format the original call.
+///
+/// The format string is walked one conversion at a time and each argument word is turned back into the type the
+/// conversion expects, honoring the length modifier, so "%hhx", "%zu" and friends truncate exactly as printf does.
+/// Long doubles were recorded as doubles and lose their extra precision.  "%n" consumes its argument and writes
+/// nothing.
+///
+/// @param [in]  format      The call site the record came from.
+/// @param [in]  pArgs       format.numArgs argument words.
+/// @param [out] pBuffer     Receives the null-terminated text, truncated to fit.
+/// @param [in]  bufferSize  Size of pBuffer in bytes.  Must be non-zero.
+///
+/// @returns The length of the text written to pBuffer.
+inline size_t FormatTraceRecord(
+    const TraceFormat& format,
+    const uint64*      pArgs,
+    char*              pBuffer,
+    size_t             bufferSize)
+{
+    size_t      length  = 0;
+    uint32      argIdx  = 0;
+    const char* pFormat = format.pFormat;
+
+    const auto NextArg = [&]() -> uint64 { return (argIdx < format.numArgs) ? pArgs[argIdx++] : 0; };
+
+    const auto Advance = [&](int32 written)
+    {
+        if (written > 0)
+        {
+            length = Min(length + static_cast<size_t>(written), bufferSize - 1);
+        }
+    };
+
+    while ((*pFormat != '\0') && (length + 1 < bufferSize))
+    {
+        if ((pFormat[0] != '%') || (pFormat[1] == '%'))
+        {
+            pBuffer[length++] = pFormat[0];
+            pFormat += (pFormat[0] == '%') ? 2 : 1;
+            continue;
+        }
+
+        // Rebuild the conversion specification without its length modifier, with any '*' replaced by the recorded
+        // value, then pass the argument as the widest type of its class.
+        const char* pSpecStart = pFormat++;
+        char        spec[48]   = "%";
+        size_t      specLength = 1;
+
+        const auto CopySpecChars = [&](const char* pChars)
+        {
+            while ((*pFormat != '\0') && (strchr(pChars, *pFormat) != nullptr) && (specLength + 1 < sizeof(spec) - 24))
+            {
+                spec[specLength++] = *pFormat++;
+            }
+        };
+
+        const auto CopyWidth = [&]()
+        {
+            if (*pFormat == '*')
+            {
+                pFormat++;
+
+                const int32 written = Snprintf(&spec[specLength], sizeof(spec) - 24 - specLength, "%d",
+                                               static_cast<int32>(NextArg()));
+                specLength = Min(specLength + static_cast<size_t>(Max(written, 0)), sizeof(spec) - 25);
+            }
+            else
+            {
+                CopySpecChars("0123456789");
+            }
+        };
+
+        CopySpecChars("-+ #0'");
+        CopyWidth();
+
+        if (*pFormat == '.')
+        {
+            spec[specLength++] = *pFormat++;
+            CopyWidth();
+        }
+
+        // Width in bits of the argument as printf will read it.
+        uint32 argBits = 32;
+
+        if ((pFormat[0] == 'h') && (pFormat[1] == 'h'))
+        {
+            argBits = 8;
+            pFormat += 2;
+        }
+        else if (pFormat[0] == 'h')
+        {
+            argBits = 16;
+            pFormat++;
+        }
+        else if ((pFormat[0] == 'l') && (pFormat[1] == 'l'))
+        {
+            argBits = 64;
+            pFormat += 2;
+        }
+        else if (pFormat[0] == 'l')
+        {
+            argBits = sizeof(long) * 8;
+            pFormat++;
+        }
+        else if ((pFormat[0] == 'j') || (pFormat[0] == 'q') || (pFormat[0] == 'L'))
+        {
+            argBits = 64;
+            pFormat++;
+        }
+        else if ((pFormat[0] == 'z') || (pFormat[0] == 't'))
+        {
+            argBits = sizeof(size_t) * 8;
+            pFormat++;
+        }
+
+        const char conversion = *pFormat;
+
+        if (conversion == '\0')
+        {
+            break;
+        }
+
+        pFormat++;
+
+        char*const   pOut    = &pBuffer[length];
+        const size_t outSize = bufferSize - length;
+        const uint64 lowMask = (argBits == 64) ? ~0ull : ((1ull << argBits) - 1);
+
+        switch (conversion)
+        {
+        case 'd':
+        case 'i':
+        {
+            const uint64 signBit = 1ull << (argBits - 1);
+            const int64  value   = static_cast<int64>(((NextArg() & lowMask) ^ signBit) - signBit);
+
+            memcpy(&spec[specLength], "lld", 4);
+            Advance(Snprintf(pOut, outSize, spec, static_cast<long long>(value)));
+            break;
+        }
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+        {
+            const char tail[4] = { 'l', 'l', conversion, '\0' };
+
+            memcpy(&spec[specLength], tail, sizeof(tail));
+            Advance(Snprintf(pOut, outSize, spec, static_cast<unsigned long long>(NextArg() & lowMask)));
+            break;
+        }
+        case 'c':
+        {
+            memcpy(&spec[specLength], "c", 2);
+            Advance(Snprintf(pOut, outSize, spec, static_cast<int32>(NextArg())));
+            break;
+        }
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+        {
+            const uint64 word  = NextArg();
+            double       value = 0.0;
+
+            memcpy(&value, &word, sizeof(value));
+            spec[specLength]     = conversion;
+            spec[specLength + 1] = '\0';
+            Advance(Snprintf(pOut, outSize, spec, value));
+            break;
+        }
+        case 's':
+        {
+            const char* pString = reinterpret_cast<const char*>(static_cast<uintptr_t>(NextArg()));
+
+            memcpy(&spec[specLength], "s", 2);
+            Advance(Snprintf(pOut, outSize, spec, (pString != nullptr) ? pString : "(null)"));
+            break;
+        }
+        case 'p':
+        {
+            memcpy(&spec[specLength], "p", 2);
+            Advance(Snprintf(pOut, outSize, spec, reinterpret_cast<void*>(static_cast<uintptr_t>(NextArg()))));
+            break;
+        }
+        case 'n':
+            NextArg();
+            break;
+        default:
+        {
+            // Not a conversion we understand; copy it through untouched.
+            const size_t rawLength = Min(static_cast<size_t>(pFormat - pSpecStart), outSize - 1);
+
+            memcpy(pOut, pSpecStart, rawLength);
+            length += rawLength;
+            break;
+        }
+        }
+    }
+
+    pBuffer[length] = '\0';
+
+    return length;
+}
+
+/// Specifies properties for @ref TraceLogger initialization.
+struct TraceLoggerCreateInfo
+{
+    uint32 ringBytes;        ///< Size of each thread's ring buffer.  Rounded up to a power of two; 0 selects 64 KiB.
+    uint32 flushIntervalMs;  ///< How often the flusher thread drains the rings.  0 selects 10 ms.
+};
+
+/**
+ ***********************************************************************************************************************
+ * @brief  Binary event logger for hot paths.
+ *
+ * A log call stores the address of its call site's @ref TraceFormat followed by one raw word per argument into a ring
+ * buffer owned by the calling thread.  Nothing is formatted on the hot path: there is no varargs walk, no lock and no
+ * shared cache line, just a thread-local lookup, a bounds check and a release store.  A background flusher thread
+ * drains every ring at a fixed interval, formats each record with @ref FormatTraceRecord and writes the text, one
+ * record per line, to a file through Util::File.
+ *
+ * When a thread's ring is full the record is dropped and counted.  The flusher writes a line noting each batch of drops
+ * in place, and NumDropped() reports the total.
+ *
+ * String arguments are stored as pointers and read when the record is formatted, so they must stay valid until the
+ * next flush; string literals are the intended use.
+ *
+ * Records from one thread come out in order.  Records from different threads are only ordered per flush interval.
+ * A thread gets a ring on its first record.  When the thread exits its rings are marked free, and the next thread
+ * that starts logging takes one over, along with any records still waiting in it, so there are never more rings than
+ * threads which have logged at the same time.  Rings are freed when the logger is destroyed.
+ *
+ * Use through PAL_TRACE:
+ *
+ *     PAL_TRACE(&logger, "submit queue=%u cmdBufs=%zu fence=%p", queueId, count, pFence);
+ ***********************************************************************************************************************
+ */
+template <typename Allocator>
+class TraceLogger
+{
+public:
+    /// Constructor.
+    ///
+    /// @param [in] pAllocator The allocator that will allocate the rings.
+    explicit TraceLogger(Allocator*const pAllocator);
+
+    /// Stops the flusher thread, writes out whatever is left in the rings and frees them.
+    ~TraceLogger();
+
+    /// Opens the output file and starts the flusher thread.
+    ///
+    /// @param [in] pFilename  File the formatted records are written to.  It is truncated.
+    /// @param [in] createInfo Ring size and flush interval.
+    ///
+    /// @returns Success if the logger is ready, otherwise an appropriate error.
+    Result Init(const char* pFilename, const TraceLoggerCreateInfo& createInfo);
+
+    /// Appends a record to the calling thread's ring, or counts it as dropped if the ring is full.  Does nothing before
+    /// Init() succeeds.  Prefer the PAL_TRACE macro, which builds the TraceFormat.
+    template <typename... Args>
+    void Log(const TraceFormat& format, Args... args);
+
+    /// Drains every ring on the calling thread and flushes the output file.
+    void Flush();
+
+    /// Returns the number of records dropped because a ring was full.
+    uint64 NumDropped() const;
+
+    /// Returns the number of records written to the output file so far.
+    uint64 NumWritten() const { return m_numWritten.load(std::memory_order_relaxed); }
+
+private:
+    // Single-producer, single-consumer ring owned by one thread.  The argument words follow the header in the same
+    // allocation.  Positions count words and are never wrapped; they are masked on access.
+    struct alignas(PAL_CACHE_LINE_BYTES) Ring
+    {
+        std::atomic<uint64>      head;           // Next word the owner writes.  Written by the owner only.
+        uint64                   cachedTail;     // Owner's copy of tail, refreshed when the ring looks full.
+        std::atomic<uint64>      numDropped;     // Records this ring dropped.  Written by the owner only.
+        std::atomic<const void*> pOwner;         // Identifies the owning thread, or null while the ring is free.
+        Ring*                    pNext;          // Next ring registered with the logger.
+
+        alignas(PAL_CACHE_LINE_BYTES)
+        std::atomic<uint64>      tail;           // Next word the flusher reads.  Written by the flusher only.
+        uint64                   reportedDrops;  // Drops the flusher has already written a line for.
+    };
+
+    // Identifies the logger a thread's cached ring belongs to, so a new logger at the same address is not confused
+    // with a destroyed one.
+    static uint64 NextLoggerId()
+    {
+        static std::atomic<uint64> nextId { 1 };
+        return nextId.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Every logger which is alive, so a thread exiting can find the rings it owns.
+    struct LiveLoggers
+    {
+        Mutex        lock;
+        TraceLogger* pHead = nullptr;
+    };
+
+    static LiveLoggers* GetLiveLoggers()
+    {
+        static LiveLoggers liveLoggers;
+        return &liveLoggers;
+    }
+
+    uint64* RingWords(Ring* pRing) const { return reinterpret_cast<uint64*>(pRing + 1); }
+
+    static void ReleaseThreadRings(const void* pOwner);
+
+    Ring* GetThreadRing();
+    Ring* FindOrCreateRing(const void* pOwner);
+    void  DrainRing(Ring* pRing);
+    void  WriteText(const char* pText, size_t length);
+    void  FlusherMain();
+
+    // Size of the staging buffer formatted text is collected in before it is written to the file.
+    static constexpr size_t OutBufferSize = 64 * 1024;
+    // Longest line a single record formats to; longer records are truncated.
+    static constexpr size_t MaxLineLength = 1024;
+
+    Allocator*const     m_pAllocator;
+    const uint64        m_id;
+    TraceLogger*        m_pNextLive;      // Next logger in GetLiveLoggers().  Guarded by its lock.
+    std::atomic<Ring*>  m_pRings;         // All rings, newest first.  Only ever pushed to until destruction.
+    uint64              m_ringMask;       // Words per ring minus one; zero until Init() succeeds.
+    uint32              m_flushIntervalMs;
+
+    Mutex               m_drainLock;      // Only one thread may drain the rings at a time.
+    File                m_file;
+    char*               m_pOutBuffer;
+    size_t              m_outBufferUsed;
+    std::atomic<uint64> m_numWritten;
+
+    Event               m_wakeEvent;      // Wakes the flusher early when the logger is being destroyed.
+    std::atomic<bool>   m_stop;
+    std::thread         m_flusher;
+
+    PAL_DISALLOW_COPY_AND_ASSIGN(TraceLogger);
+};
+
+// =====================================================================================================================
+template <typename Allocator>
+TraceLogger<Allocator>::TraceLogger(
+    Allocator*const pAllocator)
+    :
+    m_pAllocator(pAllocator),
+    m_id(NextLoggerId()),
+    m_pNextLive(nullptr),
+    m_pRings(nullptr),
+    m_ringMask(0),
+    m_flushIntervalMs(0),
+    m_pOutBuffer(nullptr),
+    m_outBufferUsed(0),
+    m_numWritten(0),
+    m_stop(false)
+{
+    LiveLoggers*const pLive = GetLiveLoggers();
+    MutexAuto lock(&pLive->lock);
+
+    m_pNextLive  = pLive->pHead;
+    pLive->pHead = this;
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+TraceLogger<Allocator>::~TraceLogger()
+{
+    {
+        // Once unlinked, threads exiting no longer touch this logger's rings.
+        LiveLoggers*const pLive = GetLiveLoggers();
+        MutexAuto lock(&pLive->lock);
+
+        TraceLogger** ppLink = &pLive->pHead;
+        while (*ppLink != this)
+        {
+            ppLink = &(*ppLink)->m_pNextLive;
+        }
+        *ppLink = m_pNextLive;
+    }
+
+    if (m_flusher.joinable())
+    {
+        m_stop.store(true, std::memory_order_relaxed);
+        m_wakeEvent.Set();
+        m_flusher.join();
+    }
+
+    if (m_pOutBuffer != nullptr)
+    {
+        Flush();
+    }
+
+    Ring* pRing = m_pRings.load(std::memory_order_acquire);
+
+    while (pRing != nullptr)
+    {
+        Ring*const pNext = pRing->pNext;
+
+        pRing->~Ring();
+        PAL_FREE(pRing, m_pAllocator);
+        pRing = pNext;
+    }
+
+    PAL_SAFE_FREE(m_pOutBuffer, m_pAllocator);
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+Result TraceLogger<Allocator>::Init(
+    const char*                  pFilename,
+    const TraceLoggerCreateInfo& createInfo)
+{
+    Result result = Result::ErrorInvalidValue;
+
+    if ((pFilename != nullptr) && (m_pOutBuffer == nullptr))
+    {
+        const uint32 ringBytes = (createInfo.ringBytes != 0) ? createInfo.ringBytes : (64 * 1024);
+        const uint64 ringWords = Pow2Pad(Max<uint64>(ringBytes / sizeof(uint64), 1 + MaxTraceArgs));
+
+        m_flushIntervalMs = (createInfo.flushIntervalMs != 0) ? createInfo.flushIntervalMs : 10;
+
+        result = m_file.Open(pFilename, FileAccessWrite);
+
+        if (result == Result::Success)
+        {
+            EventCreateFlags flags = {};
+            result = m_wakeEvent.Init(flags);
+        }
+
+        if (result == Result::Success)
+        {
+            m_pOutBuffer = static_cast<char*>(PAL_MALLOC(OutBufferSize, m_pAllocator, AllocInternal));
+            result       = (m_pOutBuffer != nullptr) ? Result::Success : Result::ErrorOutOfMemory;
+        }
+
+        if (result == Result::Success)
+        {
+            m_ringMask = ringWords - 1;
+            m_flusher  = std::thread([this]() { FlusherMain(); });
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+template <typename... Args>
+void TraceLogger<Allocator>::Log(
+    const TraceFormat& format,
+    Args...            args)
+{
+    static_assert(sizeof...(Args) <= MaxTraceArgs, "Too many trace arguments.");
+    constexpr uint64 NumWords = 1 + sizeof...(Args);
+
+    Ring*const pRing = GetThreadRing();
+
+    if (pRing != nullptr)
+    {
+        const uint64 head = pRing->head.load(std::memory_order_relaxed);
+
+        if ((head + NumWords - pRing->cachedTail) > (m_ringMask + 1))
+        {
+            pRing->cachedTail = pRing->tail.load(std::memory_order_acquire);
+        }
+
+        if ((head + NumWords - pRing->cachedTail) <= (m_ringMask + 1))
+        {
+            uint64*const pWords = RingWords(pRing);
+            uint64       pos    = head;
+
+            pWords[pos++ & m_ringMask] = reinterpret_cast<uintptr_t>(&format);
+            ((pWords[pos++ & m_ringMask] = TraceArgWord(args)), ...);
+
+            pRing->head.store(head + NumWords, std::memory_order_release);
+        }
+        else
+        {
+            pRing->numDropped.store(pRing->numDropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    }
+}
+
+// =====================================================================================================================
+// Returns the calling thread's ring, taking one on the thread's first record.  The address of the thread-local cache
+// identifies the thread, and the cache's destructor hands the thread's rings back when it exits.
+template <typename Allocator>
+typename TraceLogger<Allocator>::Ring* TraceLogger<Allocator>::GetThreadRing()
+{
+    struct ThreadCache
+    {
+        ~ThreadCache() { ReleaseThreadRings(this); }
+
+        uint64 loggerId;
+        Ring*  pRing;
+    };
+
+    thread_local ThreadCache cache = {};
+
+    if (cache.loggerId != m_id)
+    {
+        cache.pRing    = FindOrCreateRing(&cache);
+        cache.loggerId = (cache.pRing != nullptr) ? m_id : 0;
+    }
+
+    return cache.pRing;
+}
+
+// =====================================================================================================================
+// Marks every ring owned by an exiting thread free, in every live logger.
+template <typename Allocator>
+void TraceLogger<Allocator>::ReleaseThreadRings(
+    const void* pOwner)
+{
+    LiveLoggers*const pLive = GetLiveLoggers();
+    MutexAuto lock(&pLive->lock);
+
+    for (TraceLogger* pLogger = pLive->pHead; pLogger != nullptr; pLogger = pLogger->m_pNextLive)
+    {
+        for (Ring* pRing = pLogger->m_pRings.load(std::memory_order_acquire); pRing != nullptr; pRing = pRing->pNext)
+        {
+            if (pRing->pOwner.load(std::memory_order_relaxed) == pOwner)
+            {
+                // Publishes the owner's last writes to head and numDropped to whichever thread takes the ring next.
+                pRing->pOwner.store(nullptr, std::memory_order_release);
+            }
+        }
+    }
+}
+
+// =====================================================================================================================
+// Returns the ring pOwner already owns, else takes over a free ring, else allocates a new one.
+template <typename Allocator>
+typename TraceLogger<Allocator>::Ring* TraceLogger<Allocator>::FindOrCreateRing(
+    const void* pOwner)
+{
+    Ring* pRing = nullptr;
+
+    if (m_ringMask != 0)
+    {
+        Ring* pHead = m_pRings.load(std::memory_order_acquire);
+
+        // A thread which switches between loggers comes back here for a ring it already owns.  It must keep using that
+        // one, or its records would be split over two rings and could come out of order.
+        for (pRing = pHead;
+             (pRing != nullptr) && (pRing->pOwner.load(std::memory_order_relaxed) != pOwner);
+             pRing = pRing->pNext)
+        {
+        }
+
+        for (Ring* pFree = pHead; (pRing == nullptr) && (pFree != nullptr); pFree = pFree->pNext)
+        {
+            const void* pExpected = nullptr;
+
+            if ((pFree->pOwner.load(std::memory_order_relaxed) == nullptr) &&
+                pFree->pOwner.compare_exchange_strong(pExpected, pOwner, std::memory_order_acquire))
+            {
+                // Carry on from where the previous owner stopped.
+                pRing             = pFree;
+                pRing->cachedTail = pRing->tail.load(std::memory_order_acquire);
+            }
+        }
+
+        if (pRing == nullptr)
+        {
+            void*const pMem = PAL_MALLOC_ALIGNED(sizeof(Ring) + ((m_ringMask + 1) * sizeof(uint64)),
+                                                 alignof(Ring),
+                                                 m_pAllocator,
+                                                 AllocInternal);
+
+            if (pMem != nullptr)
+            {
+                pRing = PAL_PLACEMENT_NEW(pMem) Ring();
+
+                pRing->head.store(0, std::memory_order_relaxed);
+                pRing->cachedTail    = 0;
+                pRing->numDropped.store(0, std::memory_order_relaxed);
+                pRing->pOwner.store(pOwner, std::memory_order_relaxed);
+                pRing->tail.store(0, std::memory_order_relaxed);
+                pRing->reportedDrops = 0;
+                pRing->pNext         = pHead;
+
+                while (m_pRings.compare_exchange_weak(pRing->pNext, pRing, std::memory_order_release) == false)
+                {
+                }
+            }
+        }
+    }
+
+    return pRing;
+}
+
+// =====================================================================================================================
+// Formats and writes out everything the ring holds.  Must be called with m_drainLock held.
+template <typename Allocator>
+void TraceLogger<Allocator>::DrainRing(
+    Ring* pRing)
+{
+    const uint64*const pWords = RingWords(pRing);
+    const uint64       head   = pRing->head.load(std::memory_order_acquire);
+    uint64             tail   = pRing->tail.load(std::memory_order_relaxed);
+
+    char   line[MaxLineLength];
+    uint64 args[MaxTraceArgs];
+
+    while (tail != head)
+    {
+        const auto*const pFormat =
+            reinterpret_cast<const TraceFormat*>(static_cast<uintptr_t>(pWords[tail & m_ringMask]));
+
+        for (uint32 i = 0; i < pFormat->numArgs; ++i)
+        {
+            args[i] = pWords[(tail + 1 + i) & m_ringMask];
+        }
+
+        tail += 1 + pFormat->numArgs;
+
+        // Hand the space back before formatting so the owner can reuse it sooner.
+        pRing->tail.store(tail, std::memory_order_release);
+
+        size_t length = FormatTraceRecord(*pFormat, args, line, sizeof(line) - 1);
+        line[length++] = '\n';
+
+        WriteText(line, length);
+        m_numWritten.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const uint64 numDropped = pRing->numDropped.load(std::memory_order_relaxed);
+
+    if (numDropped != pRing->reportedDrops)
+    {
+        const int32 length = Snprintf(line, sizeof(line), "TraceLogger: %llu records dropped\n",
+                                      static_cast<unsigned long long>(numDropped - pRing->reportedDrops));
+
+        WriteText(line, Min(static_cast<size_t>(length), sizeof(line) - 1));
+        pRing->reportedDrops = numDropped;
+    }
+}
+
+// =====================================================================================================================
+// Appends text to the staging buffer, writing the buffer to the file whenever it fills up.
+template <typename Allocator>
+void TraceLogger<Allocator>::WriteText(
+    const char* pText,
+    size_t      length)
+{
+    if ((m_outBufferUsed + length) > OutBufferSize)
+    {
+        m_file.Write(m_pOutBuffer, m_outBufferUsed);
+        m_outBufferUsed = 0;
+    }
+
+    memcpy(m_pOutBuffer + m_outBufferUsed, pText, length);
+    m_outBufferUsed += length;
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+void TraceLogger<Allocator>::Flush()
+{
+    MutexAuto lock(&m_drainLock);
+
+    // Rings only exist once Init() has succeeded, so an uninitialized logger has nothing to drain.
+    for (Ring* pRing = m_pRings.load(std::memory_order_acquire); pRing != nullptr; pRing = pRing->pNext)
+    {
+        DrainRing(pRing);
+    }
+
+    if (m_outBufferUsed != 0)
+    {
+        m_file.Write(m_pOutBuffer, m_outBufferUsed);
+        m_outBufferUsed = 0;
+    }
+
+    m_file.Flush();
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+uint64 TraceLogger<Allocator>::NumDropped() const
+{
+    uint64 total = 0;
+
+    for (Ring* pRing = m_pRings.load(std::memory_order_acquire); pRing != nullptr; pRing = pRing->pNext)
+    {
+        total += pRing->numDropped.load(std::memory_order_relaxed);
+    }
+
+    return total;
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+void TraceLogger<Allocator>::FlusherMain()
+{
+    while (m_stop.load(std::memory_order_relaxed) == false)
+    {
+        m_wakeEvent.Wait(fseconds(m_flushIntervalMs / 1000.0f));
+        Flush();
+    }
+}
+
+} // Util
+
+/// Records a trace event in a @ref Util::TraceLogger.  The format string must be a string literal and the arguments
+/// integers, enums, floating-point values or pointers; at most @ref Util::MaxTraceArgs of them.
+#define PAL_TRACE(_pLogger, _pFormat, ...)                                                                    \
+do {                                                                                                          \
+    static constexpr ::Util::TraceFormat PalTraceFormat =                                                     \
+        { _pFormat, decltype(::Util::TraceArgCount(__VA_ARGS__))::value };                                    \
+    (_pLogger)->Log(PalTraceFormat, ##__VA_ARGS__);                                                           \
+} while (false)
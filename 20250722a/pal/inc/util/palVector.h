@@ -98,7 +98,8 @@ private:
  * @brief Vector container.
  *
  * Vector is a templated array based storage that starts with a default-size allocation in the stack. If more space is
- * needed it then resorts to dynamic allocation by doubling the size every time the capacity is exceeded.
+ * needed it then resorts to dynamic allocation, growing the capacity by the growth factor (2x unless
+ * SetGrowthFactor() overrides it) every time it is exceeded.
  * Operations which this class supports are:
  *
  * - Insertion at the end of the array.
@@ -115,7 +116,7 @@ public:
     /// A convenient shorthand for VectorIterator.
     typedef VectorIterator<T, defaultCapacity, Allocator> Iter;
 
-    /// When this allocates, it doubles the old size of memory
+    /// When this allocates, it doubles the old size of memory unless SetGrowthFactor() overrides it.
     static constexpr uint32 GrowthFactor = 2;
 
     /// Constructor.
@@ -154,6 +155,52 @@ public:
     /// @returns Result ErrorOutOfMemory if the operation failed.
     Result Grow(uint32 amount) { return Reserve(NumElements() + amount); }
 
+    /// Overrides the geometric growth factor used when this vector needs more space, expressed as the ratio
+    /// numerator / denominator.  Smaller ratios (e.g. 3/2) trade extra reallocations for less slack memory.
+    ///
+    /// @param [in] numerator   Numerator of the growth ratio.
+    /// @param [in] denominator Denominator of the growth ratio.  Must be less than numerator.
+    void SetGrowthFactor(uint16 numerator, uint16 denominator)
+    {
+        PAL_ASSERT((denominator > 0) && (numerator > denominator));
+        m_growthNumerator   = numerator;
+        m_growthDenominator = denominator;
+    }
+
+    /// Computes the capacity this vector grows to when it must hold at least minCapacity elements: the current
+    /// capacity scaled by the growth factor, or minCapacity if that is larger.
+    ///
+    /// @param [in] minCapacity Minimum number of elements which must fit.
+    ///
+    /// @returns The capacity to pass to Reserve().
+    uint32 GrowthCapacity(uint32 minCapacity) const
+    {
+        const uint64 grown = (uint64(m_maxCapacity) * m_growthNumerator) / m_growthDenominator;
+        return uint32(Min(Max(grown, uint64(minCapacity)), uint64(UINT32_MAX)));
+    }
+
+    /// Releases unused capacity.  If all elements fit in the default capacity they are moved back into the storage
+    /// inside the vector object and the dynamic allocation is freed, otherwise the elements are moved into an
+    /// allocation of exactly NumElements().
+    ///
+    /// @note All existing iterators remain valid.
+    ///
+    /// @warning All pointers and references to elements of a vector will be invalidated if storage is changed.
+    ///
+    /// @returns Result ErrorOutOfMemory if the operation failed, in which case the vector is left unchanged.
+    Result ShrinkToFit();
+
+    /// Copies a range of elements to the end of the vector.  Space for the whole range is reserved at most once, and
+    /// trivially copyable element types are copied with a single memcpy.
+    ///
+    /// @warning All pointers and references to elements of a vector will be invalidated,
+    ///          in case new storage is allocated.  The source range must therefore not point into this vector.
+    ///
+    /// @param [in] elements The elements to append.
+    ///
+    /// @returns Result ErrorOutOfMemory if the operation failed, in which case no elements are appended.
+    Result Append(Span<const T> elements);
+
     /// Set size to newSize.
     /// If size is decreased, elements at the end of the vector will be removed.
     /// If size is increased, new elements will be set to newVal.
@@ -354,8 +401,13 @@ private:
     T*               m_pData;                  // Pointer to the current data buffer.
     uint32           m_numElements;            // Number of elements present.
     uint32           m_maxCapacity;            // Maximum size it can hold.
+    uint16           m_growthNumerator;        // Growth ratio numerator, see SetGrowthFactor().
+    uint16           m_growthDenominator;      // Growth ratio denominator, see SetGrowthFactor().
     Allocator*const  m_pAllocator;             // Allocator for this Vector.
 
+    // Moves all elements to a new buffer that holds newCapacity elements, which may be the local buffer.
+    Result Reallocate(uint32 newCapacity);
+
     PAL_DISALLOW_COPY_AND_ASSIGN(Vector);
 
     // Although this is a transgression of coding standards, it prevents VectorIterator requiring a public constructor;
@@ -383,6 +435,8 @@ Vector<T, defaultCapacity, Allocator>::Vector(
     m_pData(reinterpret_cast<T*>(m_data)),
     m_numElements(0),
     m_maxCapacity(defaultCapacity),
+    m_growthNumerator(GrowthFactor),
+    m_growthDenominator(1),
     m_pAllocator(pAllocator)
  {
  }
@@ -410,15 +464,16 @@ Vector<T, defaultCapacity, Allocator>::~Vector()
 
 // =====================================================================================================================
 // Steals allocation from a dying vector, if data buffer uses storage from heap allocation.
-// Moves objects between local buffers of new and dying vectors (for non-trivial types) or
-// copies local buffer from a dying vector to a new vector (for trivial types),
-// if data buffer uses storage from local buffer.
+// Relocates objects from the local buffer of the dying vector into the local buffer of the new vector otherwise, using a
+// single memcpy for trivially relocatable types.
 template<typename T, uint32 defaultCapacity, typename Allocator>
 Vector<T, defaultCapacity, Allocator>::Vector(
     Vector&& vector)
     :
     m_numElements(vector.m_numElements),
     m_maxCapacity(vector.m_maxCapacity),
+    m_growthNumerator(vector.m_growthNumerator),
+    m_growthDenominator(vector.m_growthDenominator),
     m_pAllocator(vector.m_pAllocator)
 {
     if (vector.m_pData == reinterpret_cast<T*>(vector.m_data)) // Local buffer
@@ -426,19 +481,9 @@ Vector<T, defaultCapacity, Allocator>::Vector(
         // Data buffer will be using storage from local buffer.
         m_pData = reinterpret_cast<T*>(m_data);
 
-        if (std::is_trivial<T>::value)
-        {
-            // Optimize trivial types by copying local buffer.
-            std::memcpy(m_pData, vector.m_pData, sizeof(T) * m_numElements);
-        }
-        else
-        {
-            // Move objects from local buffer of a dying vector to local buffer of a new vector.
-            for (uint32 idx = 0; idx < m_numElements; ++idx)
-            {
-                PAL_PLACEMENT_NEW(m_pData + idx) T(Move(vector.m_pData[idx]));
-            }
-        }
+        // The dying vector's elements are dead after relocation, so it must not destroy them again.
+        RelocateArray(m_pData, vector.m_pData, m_numElements);
+        vector.m_numElements = 0;
     }
     else // Heap allocation
     {
@@ -452,4 +497,97 @@ Vector<T, defaultCapacity, Allocator>::Vector(
     }
 }
 
+// =====================================================================================================================
+template<typename T, uint32 defaultCapacity, typename Allocator>
+Result Vector<T, defaultCapacity, Allocator>::Reallocate(
+    uint32 newCapacity)
+{
+    PAL_ASSERT(newCapacity >= m_numElements);
+
+    Result result  = Result::_Success;
+    T*     pNewData = reinterpret_cast<T*>(m_data);
+
+    if (newCapacity > defaultCapacity)
+    {
+        pNewData = static_cast<T*>(PAL_MALLOC(sizeof(T) * newCapacity, m_pAllocator, AllocInternal));
+    }
+
+    if (pNewData == nullptr)
+    {
+        result = Result::ErrorOutOfMemory;
+    }
+    else if (pNewData != m_pData)
+    {
+        RelocateArray(pNewData, m_pData, m_numElements);
+
+        // A moved-from vector has no storage to free.
+        if ((m_pData != reinterpret_cast<T*>(m_data)) && (m_pData != nullptr))
+        {
+            PAL_FREE(m_pData, m_pAllocator);
+        }
+
+        m_pData       = pNewData;
+        m_maxCapacity = Max(newCapacity, defaultCapacity);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template<typename T, uint32 defaultCapacity, typename Allocator>
+Result Vector<T, defaultCapacity, Allocator>::ShrinkToFit()
+{
+    Result result = Result::_Success;
+
+    // Only a heap allocation with slack can shrink; a moved-from vector has no storage at all.
+    if ((m_pData != reinterpret_cast<T*>(m_data)) && (m_pData != nullptr) && (m_numElements < m_maxCapacity))
+    {
+        result = Reallocate(m_numElements);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template<typename T, uint32 defaultCapacity, typename Allocator>
+Result Vector<T, defaultCapacity, Allocator>::Append(
+    Span<const T> elements)
+{
+    Result       result = Result::_Success;
+    const size_t count  = elements.NumElements();
+
+    PAL_ASSERT((count == 0) ||
+               (elements.End() <= m_pData) || (elements.Begin() >= (m_pData + m_maxCapacity)));
+
+    if (count > (UINT32_MAX - m_numElements))
+    {
+        result = Result::ErrorOutOfMemory;
+    }
+    else if (count > (m_maxCapacity - m_numElements))
+    {
+        result = Reserve(GrowthCapacity(m_numElements + uint32(count)));
+    }
+
+    if ((result == Result::_Success) && (count > 0))
+    {
+        T*const pDst = m_pData + m_numElements;
+
+        if (std::is_trivially_copyable<T>::value)
+        {
+            memcpy(static_cast<void*>(pDst), elements.Data(), sizeof(T) * count);
+        }
+        else
+        {
+            for (size_t idx = 0; idx < count; ++idx)
+            {
+                PAL_PLACEMENT_NEW(pDst + idx) T(elements[idx]);
+            }
+        }
+
+        m_numElements += uint32(count);
+    }
+
+    return result;
+}
+
 } // Util
@@ -0,0 +1,280 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2015-2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  palVectorImpl.h
+* @brief PAL utility collection Vector and VectorIterator class implementations.
+***********************************************************************************************************************
+*/
+
+#pragma once
+
+#include "palVector.h"
+#include "palInlineFuncs.h"
+#include <string.h>
+#include <type_traits>
+#include <utility>
+
+namespace Util
+{
+
+// =====================================================================================================================
+// Grows the buffer to exactly newCapacity elements if it is currently smaller.  Callers which add elements one at a time
+// pass GrowthCapacity() so the configured growth policy applies.
+template<typename T, uint32 defaultCapacity, typename Allocator>
+Result Vector<T, defaultCapacity, Allocator>::Reserve(
+    uint32 newCapacity)
+{
+    Result result = Result::_Success;
+
+    if (newCapacity > m_maxCapacity)
+    {
+        result = Reallocate(newCapacity);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template<typename T, uint32 defaultCapacity, typename Allocator>
+Result Vector<T, defaultCapacity, Allocator>::Resize(
+    uint32   newSize,
+    const T& newVal)
+{
+    Result result = Result::_Success;
+
+    if (newSize < m_numElements)
+    {
+        if (std::is_trivially_destructible<T>::value == false)
+        {
+            for (uint32 idx = newSize; idx < m_numElements; ++idx)
+            {
+                m_pData[idx].~T();
+            }
+        }
+
+        m_numElements = newSize;
+    }
+    else if (newSize > m_numElements)
+    {
+        if (newSize > m_maxCapacity)
+        {
+            // newVal may be one of our own elements, so copy it before the buffer moves.
+            const T value(newVal);
+
+            result = Reserve(GrowthCapacity(newSize));
+
+            if (result == Result::_Success)
+            {
+                for (uint32 idx = m_numElements; idx < newSize; ++idx)
+                {
+                    PAL_PLACEMENT_NEW(m_pData + idx) T(value);
+                }
+            }
+        }
+        else
+        {
+            for (uint32 idx = m_numElements; idx < newSize; ++idx)
+            {
+                PAL_PLACEMENT_NEW(m_pData + idx) T(newVal);
+            }
+        }
+
+        if (result == Result::_Success)
+        {
+            m_numElements = newSize;
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template<typename T, uint32 defaultCapacity, typename Allocator>
+Result Vector<T, defaultCapacity, Allocator>::PushBack(
+    const T& data)
+{
+    return EmplaceBack(data);
+}
+
+// =====================================================================================================================
+template<typename T, uint32 defaultCapacity, typename Allocator>
+Result Vector<T, defaultCapacity, Allocator>::PushBack(
+    T&& data)
+{
+    return EmplaceBack(Move(data));
+}
+
+// =====================================================================================================================
+// Constructs the new element in place, growing the buffer by the configured growth factor if it is full.
+template<typename T, uint32 defaultCapacity, typename Allocator>
+template<typename... Args>
+Result Vector<T, defaultCapacity, Allocator>::EmplaceBack(
+    Args&&... args)
+{
+    Result result = Result::_Success;
+
+    if (m_numElements < m_maxCapacity)
+    {
+        PAL_PLACEMENT_NEW(m_pData + m_numElements) T(std::forward<Args>(args)...);
+        ++m_numElements;
+    }
+    else if (m_numElements == UINT32_MAX)
+    {
+        result = Result::ErrorOutOfMemory;
+    }
+    else
+    {
+        // The arguments may refer to one of our own elements, so build the value before the buffer moves.
+        T value(std::forward<Args>(args)...);
+
+        result = Reserve(GrowthCapacity(m_numElements + 1));
+
+        if (result == Result::_Success)
+        {
+            PAL_PLACEMENT_NEW(m_pData + m_numElements) T(Move(value));
+            ++m_numElements;
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template<typename T, uint32 defaultCapacity, typename Allocator>
+void Vector<T, defaultCapacity, Allocator>::PopBack(
+    T* pData)
+{
+    PAL_ASSERT(IsEmpty() == false);
+
+    --m_numElements;
+
+    if (pData != nullptr)
+    {
+        PAL_PLACEMENT_NEW(pData) T(Move(m_pData[m_numElements]));
+    }
+
+    m_pData[m_numElements].~T();
+}
+
+// =====================================================================================================================
+template<typename T, uint32 defaultCapacity, typename Allocator>
+void Vector<T, defaultCapacity, Allocator>::Clear()
+{
+    if (std::is_trivially_destructible<T>::value == false)
+    {
+        for (uint32 idx = 0; idx < m_numElements; ++idx)
+        {
+            m_pData[idx].~T();
+        }
+    }
+
+    m_numElements = 0;
+}
+
+// =====================================================================================================================
+template<typename T, uint32 defaultCapacity, typename Allocator>
+void Vector<T, defaultCapacity, Allocator>::Erase(
+    Iter it)
+{
+    Erase(it.Position());
+}
+
+// =====================================================================================================================
+template<typename T, uint32 defaultCapacity, typename Allocator>
+void Vector<T, defaultCapacity, Allocator>::Erase(
+    iterator it)
+{
+    Erase(uint32(it - m_pData));
+}
+
+// =====================================================================================================================
+// Shifts the elements after index down by one.  Trivially relocatable types are shifted with a single memmove.
+template<typename T, uint32 defaultCapacity, typename Allocator>
+void Vector<T, defaultCapacity, Allocator>::Erase(
+    uint32 index)
+{
+    PAL_ASSERT(index < m_numElements);
+
+    const uint32 numAfter = m_numElements - index - 1;
+
+    if (IsTriviallyRelocatable<T>::value)
+    {
+        m_pData[index].~T();
+
+        if (numAfter > 0)
+        {
+            memmove(static_cast<void*>(m_pData + index), static_cast<const void*>(m_pData + index + 1),
+                    sizeof(T) * numAfter);
+        }
+    }
+    else
+    {
+        for (uint32 idx = index; idx < (m_numElements - 1); ++idx)
+        {
+            m_pData[idx] = Move(m_pData[idx + 1]);
+        }
+
+        m_pData[m_numElements - 1].~T();
+    }
+
+    --m_numElements;
+}
+
+// =====================================================================================================================
+template<typename T, uint32 defaultCapacity, typename Allocator>
+void Vector<T, defaultCapacity, Allocator>::EraseAndSwapLast(
+    Iter it)
+{
+    EraseAndSwapLast(it.Position());
+}
+
+// =====================================================================================================================
+template<typename T, uint32 defaultCapacity, typename Allocator>
+void Vector<T, defaultCapacity, Allocator>::EraseAndSwapLast(
+    iterator it)
+{
+    EraseAndSwapLast(uint32(it - m_pData));
+}
+
+// =====================================================================================================================
+template<typename T, uint32 defaultCapacity, typename Allocator>
+void Vector<T, defaultCapacity, Allocator>::EraseAndSwapLast(
+    uint32 index)
+{
+    PAL_ASSERT(index < m_numElements);
+
+    const uint32 last = m_numElements - 1;
+
+    if (index != last)
+    {
+        m_pData[index] = Move(m_pData[last]);
+    }
+
+    m_pData[last].~T();
+    --m_numElements;
+}
+
+} // Util
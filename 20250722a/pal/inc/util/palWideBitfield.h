@@ -0,0 +1,272 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palWideBitfield.h
+ * @brief PAL utility collection WideBitfield class declaration and implementation.
+ ***********************************************************************************************************************
+ */
+
+#pragma once
+
+#include "palInlineFuncs.h"
+
+namespace Util
+{
+
+/**
+ ***********************************************************************************************************************
+ * @brief  Fixed-size set of NumBits flags stored as an array of 64-bit words.
+ *
+ * Intended for dirty-state tracking and similar masks with more flags than fit in one integer.  The bulk operations
+ * (and/or/xor, IsAnyBitSet, CountSetBits) use the vectorized kernels of palWideBitfieldKernels.h above the same
+ * size thresholds as the WideBitfield* functions in palInlineFuncs.h.  Set bits are visited with one bit scan per set
+ * bit, so sparse fields are cheap to walk.
+ *
+ * Bits at or above NumBits in the last word are always zero.
+ ***********************************************************************************************************************
+ */
+template <uint32 NumBits>
+class WideBitfield
+{
+    static_assert(NumBits > 0, "A WideBitfield must hold at least one bit.");
+
+public:
+    /// Number of 64-bit words backing the bitfield.
+    static constexpr uint32 NumWords = (NumBits + 63) / 64;
+
+    /// Constructs a bitfield with every bit cleared.
+    WideBitfield() : m_words{} { }
+
+    /// Returns true if the bit is set.
+    bool IsSet(uint32 bit) const
+    {
+        PAL_ASSERT(bit < NumBits);
+        return (m_words[bit / 64] & (1ull << (bit & 63))) != 0;
+    }
+
+    /// Sets one bit.
+    void SetBit(uint32 bit)
+    {
+        PAL_ASSERT(bit < NumBits);
+        m_words[bit / 64] |= (1ull << (bit & 63));
+    }
+
+    /// Clears one bit.
+    void ClearBit(uint32 bit)
+    {
+        PAL_ASSERT(bit < NumBits);
+        m_words[bit / 64] &= ~(1ull << (bit & 63));
+    }
+
+    /// Sets numBits consecutive bits starting at startBit.
+    void SetRange(uint32 startBit, uint32 numBits)
+    {
+        PAL_ASSERT((startBit <= NumBits) && (numBits <= (NumBits - startBit)));
+        WideBitfieldKernels::WriteRange(m_words, startBit, numBits, true);
+    }
+
+    /// Clears numBits consecutive bits starting at startBit.
+    void ClearRange(uint32 startBit, uint32 numBits)
+    {
+        PAL_ASSERT((startBit <= NumBits) && (numBits <= (NumBits - startBit)));
+        WideBitfieldKernels::WriteRange(m_words, startBit, numBits, false);
+    }
+
+    /// Sets every bit.
+    void SetAll() { SetRange(0, NumBits); }
+
+    /// Clears every bit.
+    void ClearAll() { memset(m_words, 0, sizeof(m_words)); }
+
+    /// Returns true if any bit is set.
+    bool IsAnyBitSet() const { return WideBitfieldIsAnyBitSet(m_words); }
+
+    /// Returns the number of set bits.
+    uint32 CountSetBits() const { return WideBitfieldCountSetBits(m_words); }
+
+    /// Finds the lowest set bit.
+    ///
+    /// @param [out] pIndex Receives the index of the bit.  Unchanged if no bit is set.
+    ///
+    /// @returns True if a set bit was found.
+    bool FindFirstSet(uint32* pIndex) const { return FindNextSet(0, pIndex); }
+
+    /// Finds the lowest set bit at or above startBit.
+    ///
+    /// @param [in]  startBit First bit to consider.  May be NumBits or more, in which case nothing is found.
+    /// @param [out] pIndex   Receives the index of the bit.  Unchanged if there is none.
+    ///
+    /// @returns True if a set bit was found.
+    bool FindNextSet(uint32 startBit, uint32* pIndex) const;
+
+    /// Finds the lowest clear bit.
+    ///
+    /// @param [out] pIndex Receives the index of the bit.  Unchanged if every bit is set.
+    ///
+    /// @returns True if a clear bit was found.
+    bool FindFirstClear(uint32* pIndex) const;
+
+    /// Calls callback(bitIndex) for every set bit, in increasing order.  The callback may modify the bitfield;
+    /// changes to words that have not been reached yet are seen by the walk.
+    template <typename Callback>
+    void ForEachSetBit(Callback callback) const;
+
+    WideBitfield& operator&=(const WideBitfield& other)
+    {
+        Combine<WideBitfieldKernels::BitOp::And>(other);
+        return *this;
+    }
+
+    WideBitfield& operator|=(const WideBitfield& other)
+    {
+        Combine<WideBitfieldKernels::BitOp::Or>(other);
+        return *this;
+    }
+
+    WideBitfield& operator^=(const WideBitfield& other)
+    {
+        Combine<WideBitfieldKernels::BitOp::Xor>(other);
+        return *this;
+    }
+
+    friend WideBitfield operator&(WideBitfield lhs, const WideBitfield& rhs) { return lhs &= rhs; }
+    friend WideBitfield operator|(WideBitfield lhs, const WideBitfield& rhs) { return lhs |= rhs; }
+    friend WideBitfield operator^(WideBitfield lhs, const WideBitfield& rhs) { return lhs ^= rhs; }
+
+    bool operator==(const WideBitfield& other) const { return memcmp(m_words, other.m_words, sizeof(m_words)) == 0; }
+    bool operator!=(const WideBitfield& other) const { return (*this == other) == false; }
+
+    /// Returns the backing words, least significant first.
+    const uint64* Words() const { return m_words; }
+
+private:
+    template <WideBitfieldKernels::BitOp Op>
+    void Combine(const WideBitfield& other);
+
+    uint64 m_words[NumWords];
+};
+
+// =====================================================================================================================
+// Small fields use a loop over the words, like WideBitfieldAndBits() and WideBitfieldXorBits().
+template <uint32 NumBits>
+template <WideBitfieldKernels::BitOp Op>
+void WideBitfield<NumBits>::Combine(
+    const WideBitfield& other)
+{
+    if constexpr (sizeof(m_words) < WideBitfieldKernels::MinCombineBytes)
+    {
+        for (uint32 i = 0; i < NumWords; i++)
+        {
+            m_words[i] = WideBitfieldKernels::Apply<Op>(m_words[i], other.m_words[i]);
+        }
+    }
+    else
+    {
+        WideBitfieldKernels::Combine<Op>(m_words, m_words, other.m_words, sizeof(m_words));
+    }
+}
+
+// =====================================================================================================================
+template <uint32 NumBits>
+bool WideBitfield<NumBits>::FindNextSet(
+    uint32  startBit,
+    uint32* pIndex
+    ) const
+{
+    bool found = false;
+
+    if (startBit < NumBits)
+    {
+        uint32 wordIdx = startBit / 64;
+        uint64 word    = m_words[wordIdx] & (~0ull << (startBit & 63));
+
+        while ((word == 0) && (++wordIdx < NumWords))
+        {
+            word = m_words[wordIdx];
+        }
+
+        if (word != 0)
+        {
+            uint32 bit = 0;
+            BitMaskScanForward(&bit, word);
+
+            *pIndex = (wordIdx * 64) + bit;
+            found   = true;
+        }
+    }
+
+    return found;
+}
+
+// =====================================================================================================================
+template <uint32 NumBits>
+bool WideBitfield<NumBits>::FindFirstClear(
+    uint32* pIndex
+    ) const
+{
+    bool found = false;
+
+    for (uint32 wordIdx = 0; wordIdx < NumWords; ++wordIdx)
+    {
+        uint32 bit = 0;
+
+        if (BitMaskScanForward(&bit, ~m_words[wordIdx]))
+        {
+            // The padding bits of the last word are clear but do not exist.
+            bit += wordIdx * 64;
+            found = (bit < NumBits);
+
+            if (found)
+            {
+                *pIndex = bit;
+            }
+            break;
+        }
+    }
+
+    return found;
+}
+
+// =====================================================================================================================
+template <uint32 NumBits>
+template <typename Callback>
+void WideBitfield<NumBits>::ForEachSetBit(
+    Callback callback
+    ) const
+{
+    for (uint32 wordIdx = 0; wordIdx < NumWords; ++wordIdx)
+    {
+        for (uint64 word = m_words[wordIdx]; word != 0; word = UnsetLeastBit(word))
+        {
+            uint32 bit = 0;
+            BitMaskScanForward(&bit, word);
+
+            callback((wordIdx * 64) + bit);
+        }
+    }
+}
+
+} // Util
@@ -0,0 +1,399 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palWideBitfieldKernels.h
+ * @brief PAL utility collection byte-level kernels for wide bitfields.
+ ***********************************************************************************************************************
+ */
+
+#pragma once
+
+#include "palSimd.h"
+#include <cstring>
+
+namespace Util
+{
+
+/// @internal Byte-level kernels behind the WideBitfield* functions in palInlineFuncs.h and @ref WideBitfield.  They
+/// work on the raw storage of a wide bitfield, so they serve any element type; bit i of a little-endian array of
+/// integers is bit (i % 8) of byte (i / 8).  On x86-64 they use SSE2, and AVX2 when the CPU and OS support it.
+namespace WideBitfieldKernels
+{
+
+/// Smallest bitfield, in bytes, for which callers use Combine() instead of a loop over the elements.  Below this the
+/// compiler vectorizes the fixed-count loop as well as the SSE2 kernel does, and only the AVX2 kernel is faster.
+constexpr size_t MinCombineBytes = 256;
+
+/// Smallest bitfield, in bytes, for which callers use IsAnyBitSet() and CountSetBits() instead of a loop over the
+/// elements.  These kernels read 64 bits at a time and beat the loop from one word up.
+constexpr size_t MinReduceBytes  = sizeof(uint64);
+
+/// Binary operations supported by @ref Combine.
+enum class BitOp : uint32
+{
+    And,
+    Or,
+    Xor,
+};
+
+// =====================================================================================================================
+template <BitOp Op>
+constexpr uint64 Apply(
+    uint64 a,
+    uint64 b)
+{
+    return (Op == BitOp::And) ? (a & b) : ((Op == BitOp::Or) ? (a | b) : (a ^ b));
+}
+
+// =====================================================================================================================
+// Handles whatever is left after the vector loops, 8 bytes and then 1 byte at a time.
+template <BitOp Op>
+PAL_FORCE_INLINE void CombineScalar(
+    uint8*       pOut,
+    const uint8* pA,
+    const uint8* pB,
+    size_t       bytes)
+{
+    size_t i = 0;
+
+    for (; (i + sizeof(uint64)) <= bytes; i += sizeof(uint64))
+    {
+        uint64 a;
+        uint64 b;
+        memcpy(&a, pA + i, sizeof(a));
+        memcpy(&b, pB + i, sizeof(b));
+
+        const uint64 result = Apply<Op>(a, b);
+        memcpy(pOut + i, &result, sizeof(result));
+    }
+
+    for (; i < bytes; ++i)
+    {
+        pOut[i] = static_cast<uint8>(Apply<Op>(pA[i], pB[i]));
+    }
+}
+
+// =====================================================================================================================
+// Counts the one bits of whatever is left after the vector loops.
+inline uint32 CountSetBitsScalar(
+    const uint8* pBits,
+    size_t       bytes)
+{
+    uint32 count = 0;
+
+    for (size_t i = 0; i < bytes; i += sizeof(uint64))
+    {
+        uint64 word = 0;
+        memcpy(&word, pBits + i, ((bytes - i) < sizeof(word)) ? (bytes - i) : sizeof(word));
+
+        // The SWAR reduction of Util::CountSetBits(uint64), which cannot be called here: palInlineFuncs.h includes
+        // this header before defining it.
+        word  = word - ((word >> 1) & 0x5555555555555555ull);
+        word  = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+        count += static_cast<uint32>((((word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full) * 0x0101010101010101ull) >> 56);
+    }
+
+    return count;
+}
+
+#if PAL_SIMD_X86
+// =====================================================================================================================
+template <BitOp Op>
+PAL_SIMD_AVX2_TARGET size_t CombineAvx2(
+    uint8*       pOut,
+    const uint8* pA,
+    const uint8* pB,
+    size_t       bytes)
+{
+    size_t i = 0;
+
+    for (; (i + sizeof(__m256i)) <= bytes; i += sizeof(__m256i))
+    {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pA + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pB + i));
+
+        __m256i result;
+        if constexpr (Op == BitOp::And)
+        {
+            result = _mm256_and_si256(a, b);
+        }
+        else if constexpr (Op == BitOp::Or)
+        {
+            result = _mm256_or_si256(a, b);
+        }
+        else
+        {
+            result = _mm256_xor_si256(a, b);
+        }
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pOut + i), result);
+    }
+
+    return i;
+}
+
+// =====================================================================================================================
+inline PAL_SIMD_AVX2_TARGET bool IsAnyBitSetAvx2(
+    const uint8* pBits,
+    size_t       bytes)
+{
+    bool   isBitSet = false;
+    size_t i        = 0;
+
+    for (; (i + sizeof(__m256i)) <= bytes; i += sizeof(__m256i))
+    {
+        const __m256i bits = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pBits + i));
+
+        if (_mm256_testz_si256(bits, bits) == 0)
+        {
+            isBitSet = true;
+            break;
+        }
+    }
+
+    if ((isBitSet == false) && (i < bytes))
+    {
+        // Recheck the tail with one unaligned load that ends at the last byte.  The overlap is harmless.
+        const __m256i bits = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pBits + bytes - sizeof(__m256i)));
+        isBitSet = (_mm256_testz_si256(bits, bits) == 0);
+    }
+
+    return isBitSet;
+}
+
+// =====================================================================================================================
+// Counts bits with a nibble lookup through VPSHUFB, summing the byte counts with VPSADBW.
+inline PAL_SIMD_AVX2_TARGET uint32 CountSetBitsAvx2(
+    const uint8* pBits,
+    size_t       bytes)
+{
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+    __m256i total = _mm256_setzero_si256();
+    size_t  i     = 0;
+
+    for (; (i + sizeof(__m256i)) <= bytes; i += sizeof(__m256i))
+    {
+        const __m256i bits   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pBits + i));
+        const __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, _mm256_and_si256(bits, nibble)),
+                                               _mm256_shuffle_epi8(lookup,
+                                                                   _mm256_and_si256(_mm256_srli_epi16(bits, 4),
+                                                                                    nibble)));
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+    }
+
+    const __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1));
+
+    return static_cast<uint32>(_mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1)) +
+           CountSetBitsScalar(pBits + i, bytes - i);
+}
+
+// =====================================================================================================================
+template <BitOp Op>
+PAL_FORCE_INLINE size_t CombineSse2(
+    uint8*       pOut,
+    const uint8* pA,
+    const uint8* pB,
+    size_t       bytes)
+{
+    size_t i = 0;
+
+    for (; (i + sizeof(__m128i)) <= bytes; i += sizeof(__m128i))
+    {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pA + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pB + i));
+
+        __m128i result;
+        if constexpr (Op == BitOp::And)
+        {
+            result = _mm_and_si128(a, b);
+        }
+        else if constexpr (Op == BitOp::Or)
+        {
+            result = _mm_or_si128(a, b);
+        }
+        else
+        {
+            result = _mm_xor_si128(a, b);
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i), result);
+    }
+
+    return i;
+}
+
+// =====================================================================================================================
+// Counts bits with the SWAR reduction of CountSetBits() on 16 bytes at a time, summing the byte counts with PSADBW.
+inline uint32 CountSetBitsSse2(
+    const uint8* pBits,
+    size_t       bytes)
+{
+    const __m128i m1 = _mm_set1_epi8(0x55);
+    const __m128i m2 = _mm_set1_epi8(0x33);
+    const __m128i m4 = _mm_set1_epi8(0x0F);
+
+    __m128i total = _mm_setzero_si128();
+    size_t  i     = 0;
+
+    for (; (i + sizeof(__m128i)) <= bytes; i += sizeof(__m128i))
+    {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBits + i));
+
+        x     = _mm_sub_epi8(x, _mm_and_si128(_mm_srli_epi64(x, 1), m1));
+        x     = _mm_add_epi8(_mm_and_si128(x, m2), _mm_and_si128(_mm_srli_epi64(x, 2), m2));
+        x     = _mm_and_si128(_mm_add_epi8(x, _mm_srli_epi64(x, 4)), m4);
+        total = _mm_add_epi64(total, _mm_sad_epu8(x, _mm_setzero_si128()));
+    }
+
+    return static_cast<uint32>(_mm_cvtsi128_si64(total) + _mm_cvtsi128_si64(_mm_unpackhi_epi64(total, total))) +
+           CountSetBitsScalar(pBits + i, bytes - i);
+}
+#endif
+
+/// Writes (bits of pA) Op (bits of pB) to pOut.  pOut may alias either input.
+template <BitOp Op>
+PAL_FORCE_INLINE void Combine(
+    void*       pOut,
+    const void* pA,
+    const void* pB,
+    size_t      bytes)
+{
+    uint8*const       pOutBytes = static_cast<uint8*>(pOut);
+    const uint8*const pABytes   = static_cast<const uint8*>(pA);
+    const uint8*const pBBytes   = static_cast<const uint8*>(pB);
+
+    size_t done = 0;
+
+#if PAL_SIMD_X86
+    if ((bytes >= 256) && CpuSupportsAvx2())
+    {
+        done = CombineAvx2<Op>(pOutBytes, pABytes, pBBytes, bytes);
+    }
+
+    done += CombineSse2<Op>(pOutBytes + done, pABytes + done, pBBytes + done, bytes - done);
+#endif
+
+    CombineScalar<Op>(pOutBytes + done, pABytes + done, pBBytes + done, bytes - done);
+}
+
+/// Returns true if any bit of the bytes is set.
+inline bool IsAnyBitSet(
+    const void* pBits,
+    size_t      bytes)
+{
+    const uint8*const pBytes = static_cast<const uint8*>(pBits);
+
+    bool isBitSet = false;
+
+#if PAL_SIMD_X86
+    if ((bytes >= 64) && CpuSupportsAvx2())
+    {
+        isBitSet = IsAnyBitSetAvx2(pBytes, bytes);
+    }
+    else
+#endif
+    {
+        size_t i = 0;
+
+#if PAL_SIMD_X86
+        for (; (isBitSet == false) && ((i + sizeof(__m128i)) <= bytes); i += sizeof(__m128i))
+        {
+            const __m128i bits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBytes + i));
+            isBitSet = (_mm_movemask_epi8(_mm_cmpeq_epi8(bits, _mm_setzero_si128())) != 0xFFFF);
+        }
+#endif
+
+        for (; (isBitSet == false) && (i < bytes); i += sizeof(uint64))
+        {
+            uint64 word = 0;
+            memcpy(&word, pBytes + i, ((bytes - i) < sizeof(word)) ? (bytes - i) : sizeof(word));
+            isBitSet = (word != 0);
+        }
+    }
+
+    return isBitSet;
+}
+
+/// Returns the number of one bits in the bytes.
+inline uint32 CountSetBits(
+    const void* pBits,
+    size_t      bytes)
+{
+    const uint8*const pBytes = static_cast<const uint8*>(pBits);
+
+#if PAL_SIMD_X86
+    return ((bytes >= 64) && CpuSupportsAvx2()) ? CountSetBitsAvx2(pBytes, bytes) : CountSetBitsSse2(pBytes, bytes);
+#else
+    return CountSetBitsScalar(pBytes, bytes);
+#endif
+}
+
+/// Sets or clears numBits consecutive bits starting at startBit.
+inline void WriteRange(
+    void*  pBits,
+    uint32 startBit,
+    uint32 numBits,
+    bool   value)
+{
+    uint8*const pBytes = static_cast<uint8*>(pBits);
+
+    uint32 bit = startBit;
+    uint32 end = startBit + numBits;
+
+    // Partial bytes at either end are masked; the whole bytes between them are filled with memset.
+    const auto WriteMask = [pBytes, value](uint32 index, uint32 mask)
+    {
+        pBytes[index] = static_cast<uint8>(value ? (pBytes[index] | mask) : (pBytes[index] & ~mask));
+    };
+
+    if ((bit & 7) != 0)
+    {
+        const uint32 headEnd = ((bit | 7) + 1 < end) ? ((bit | 7) + 1) : end;
+
+        WriteMask(bit >> 3, ((1u << (headEnd - bit)) - 1) << (bit & 7));
+        bit = headEnd;
+    }
+
+    if (bit < end)
+    {
+        const uint32 wholeBytes = (end - bit) >> 3;
+
+        memset(pBytes + (bit >> 3), value ? 0xFF : 0, wholeBytes);
+        bit += wholeBytes << 3;
+
+        if (bit < end)
+        {
+            WriteMask(bit >> 3, (1u << (end - bit)) - 1);
+        }
+    }
+}
+
+} // WideBitfieldKernels
+
+} // Util
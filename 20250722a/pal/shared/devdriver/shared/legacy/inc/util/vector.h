@@ -45,7 +45,7 @@ namespace DevDriver
 
         // Standard constructor
         explicit Vector(const AllocCb& allocCb)
-            : m_pData(m_data)
+            : m_pData(InlineData())
             , m_size(0)
             , m_capacity(defaultCapacity)
             , m_allocCb(allocCb)
@@ -54,24 +54,22 @@ namespace DevDriver
 
         // Move constructor
         Vector(Vector &&rhs)
-            : m_pData(m_data) // default initialize it to the default allocation
-            , m_size(Platform::Exchange(rhs.m_size, (size_t)0)) // move the rhs size value into ours
+            : m_pData(InlineData()) // default initialize it to the default allocation
+            , m_size(0)
             , m_capacity(defaultCapacity) // initialize the capacity to default
             , m_allocCb(rhs.m_allocCb) // copy the allocator callback
         {
-            // if the vector will fit inside the default allocation, move it into it
-            if (m_size <= defaultCapacity)
+            // if the rhs lives in its default allocation, relocate its elements into ours
+            if (rhs.IsUsingInlineData())
             {
-                for (size_t index = 0; index < m_size; index++)
-                {
-                    m_data[index] = Platform::Move(rhs.m_pData[index]);
-                }
+                Relocate(InlineData(), rhs.m_pData, rhs.m_size);
             }
             else // otherwise, we want to move the allocation + replace the capacity
             {
-                m_pData = Platform::Exchange(rhs.m_pData, rhs.m_data);
+                m_pData = Platform::Exchange(rhs.m_pData, rhs.InlineData());
                 m_capacity = Platform::Exchange(rhs.m_capacity, defaultCapacity);
             }
+            m_size = Platform::Exchange(rhs.m_size, (size_t)0); // move the rhs size value into ours
         }
 
         // Destructor
@@ -98,13 +96,11 @@ namespace DevDriver
         template <class... Args>
         bool PushBack(Args&&... args)
         {
-            bool result = false;
-            Reserve(m_size + 1);
-            if (m_size < m_capacity)
+            const bool result = Reserve(m_size + 1);
+            if (result)
             {
-                m_pData[m_size] = T(Platform::Forward<Args>(args)...);
+                new(&m_pData[m_size]) T(Platform::Forward<Args>(args)...);
                 ++m_size;
-                result = true;
             }
             return result;
         }
@@ -135,25 +131,27 @@ namespace DevDriver
                 DD_ASSERT(pTs != nullptr);
             }
 
-            // Pre-allocate all the new elements, since we know how many there are.
-            const size_t oldSize = Grow(countOfTs);
-
-            // Some types can be bulk-transferred with a memcpy.
-            // Instead of letting the compiler guess, we dictate when dealing with Pods.
-            if (Platform::IsPod<T>::Value)
-            {
-                memcpy(&m_pData[oldSize], pTs, (sizeof(T) * countOfTs));
-            }
-            else
+            // Pre-allocate space for all the new elements, since we know how many there are.
+            const bool result = Reserve(m_size + countOfTs);
+            if (result)
             {
-                for (size_t i = 0; i < countOfTs; ++i)
+                // Some types can be bulk-transferred with a memcpy.
+                // Instead of letting the compiler guess, we dictate when dealing with Pods.
+                if (Platform::IsPod<T>::Value)
+                {
+                    memcpy(reinterpret_cast<void*>(&m_pData[m_size]), pTs, (sizeof(T) * countOfTs));
+                }
+                else
                 {
-                    m_pData[oldSize + i] = pTs[i];
+                    for (size_t i = 0; i < countOfTs; ++i)
+                    {
+                        new(&m_pData[m_size + i]) T(pTs[i]);
+                    }
                 }
+                m_size += countOfTs;
             }
 
-            // Pretend Grow() cannot fail, since we cannot check allocation failure with it right now.
-            return true;
+            return result;
         }
 
         // Pop elements out of the Vector
@@ -167,6 +165,7 @@ namespace DevDriver
                 {
                     *pData = Platform::Move(m_pData[m_size]);
                 }
+                m_pData[m_size].~T();
             }
             return result;
         }
@@ -184,13 +183,11 @@ namespace DevDriver
 
                 --m_size;
 
-                if (m_size > 0)
+                for (size_t i = 0; i < m_size; i++)
                 {
-                    for (size_t i = 0; i < m_size; i++)
-                    {
-                        m_pData[i] = Platform::Move(m_pData[i + 1]);
-                    }
+                    m_pData[i] = Platform::Move(m_pData[i + 1]);
                 }
+                m_pData[m_size].~T();
             }
             return result;
         }
@@ -202,17 +199,14 @@ namespace DevDriver
 
             const size_t lastIndex = m_size - 1;
 
-            // If the index is the last index, we move the last element into it's place
+            // If the index is not the last index, we move the last element into it's place
             if (index != lastIndex)
             {
                 m_pData[index] = Platform::Move(m_pData[lastIndex]);
             }
-            // Otherwise, if it is the last element and not a POD we replace it with a default constructed object
-            else if (!Platform::IsPod<T>::Value)
-            {
-                m_pData[index] = T();
-            }
 
+            // The last element is no longer live either way.
+            m_pData[lastIndex].~T();
             --m_size;
         }
 
@@ -235,39 +229,19 @@ namespace DevDriver
         // Free all memory
         void Clear()
         {
-            if (m_pData != m_data)
+            Reset();
+            if (IsUsingInlineData() == false)
             {
-                // If the object is not a POD we explicitly destroy all objects prior to freeing the allocation.
-                if (!Platform::IsPod<T>::Value)
-                {
-                    for (size_t i = 0; i < m_capacity; i++)
-                    {
-                        m_pData[i].~T();
-                    }
-                }
                 DD_FREE(m_pData, m_allocCb);
-                m_pData = m_data;
+                m_pData = InlineData();
                 m_capacity = defaultCapacity;
-                m_size = 0;
-            }
-            else
-            {
-                Reset();
             }
         }
 
-        // Clears all objects stored, but doesn't free memory.
+        // Destroys all objects stored, but doesn't free memory.
         void Reset()
         {
-            // If the object is not a POD we need to destroy all instances and replace them with default constructed
-            // instances.
-            if (!Platform::IsPod<T>::Value)
-            {
-                for (size_t index = 0; index < m_size; index++)
-                {
-                    m_pData[index] = T();
-                }
-            }
+            Destroy(m_pData, m_size);
             m_size = 0;
         }
 
@@ -275,36 +249,40 @@ namespace DevDriver
         void Swap(Vector& rhs)
         {
             // If we can, we swap allocations directly
-            if ((m_pData != m_data) && (rhs.m_pData != rhs.m_data))
+            if ((IsUsingInlineData() == false) && (rhs.IsUsingInlineData() == false))
             {
                 m_pData = Platform::Exchange(rhs.m_pData, m_pData);
             }
             // Else if the other object is using the default allocation we move it's contents here
             // and give ownership of our allocation to it
-            else if (m_pData != m_data)
+            else if (IsUsingInlineData() == false)
             {
-                for (size_t index = 0; index < rhs.m_size; index++)
-                {
-                    m_data[index] = Platform::Move(rhs.m_data[index]);
-                }
-                rhs.m_pData = Platform::Exchange(m_pData, m_data);
+                Relocate(InlineData(), rhs.InlineData(), rhs.m_size);
+                rhs.m_pData = Platform::Exchange(m_pData, InlineData());
             }
             // Else if this object is using the default allocation we move our data into it's allocation
             // and take ownership of our allocation to it
-            else if (rhs.m_pData != rhs.m_data)
+            else if (rhs.IsUsingInlineData() == false)
             {
-                for (size_t index = 0; index < m_size; index++)
-                {
-                    rhs.m_data[index] = Platform::Move(m_data[index]);
-                }
-                m_pData = Platform::Exchange(rhs.m_pData, rhs.m_data);
+                Relocate(rhs.InlineData(), InlineData(), m_size);
+                m_pData = Platform::Exchange(rhs.m_pData, rhs.InlineData());
             }
-            // Otherwise we just exchange all the objects that we need to
+            // Otherwise we exchange the objects both sides hold, then relocate the tail of the longer one
             else
             {
-                for (size_t index = 0; index < Platform::Max(m_size, rhs.m_size); index++)
+                const size_t commonSize = Platform::Min(m_size, rhs.m_size);
+                for (size_t index = 0; index < commonSize; index++)
                 {
-                    m_data[index] = Platform::Exchange(rhs.m_data[index], m_data[index]);
+                    m_pData[index] = Platform::Exchange(rhs.m_pData[index], m_pData[index]);
+                }
+
+                if (m_size > commonSize)
+                {
+                    Relocate(&rhs.m_pData[commonSize], &m_pData[commonSize], (m_size - commonSize));
+                }
+                else if (rhs.m_size > commonSize)
+                {
+                    Relocate(&m_pData[commonSize], &rhs.m_pData[commonSize], (rhs.m_size - commonSize));
                 }
             }
 
@@ -330,100 +308,103 @@ namespace DevDriver
             return (Size() != 0) ? m_pData : nullptr;
         }
 
-        // Allocates enough memory to hold the specified number of elements
-        void Reserve(size_t newSize)
+        // Allocates enough memory to hold the specified number of elements. Only the live elements are relocated into
+        // the new allocation; the spare capacity is left unconstructed.
+        //
+        // Returns false if the allocation failed, in which case the vector is left unchanged.
+        bool Reserve(size_t newSize)
         {
+            bool result = true;
+
             if (m_capacity < newSize)
             {
                 const size_t newCapacity = Platform::Pow2Pad(Platform::Max(newSize, (size_t)1));
                 const size_t allocSize = sizeof(T) * newCapacity;
                 T* pData = static_cast<T*>(DD_MALLOC(allocSize, alignof(T), m_allocCb));
 
-                DD_ASSERT(pData != nullptr);
-
-                // If the struct is not a POD, then we need to construct objects
-                if (is_type_trivial() == false)
+                if (pData != nullptr)
                 {
-                    size_t i = 0;
-                    // First, we move all existing objects into the vector.
-                    for (; i < m_size; i++)
-                    {
-                        new(&pData[i]) T(Platform::Move(m_pData[i]));
-                    }
-                    // Then we construct new objects with the remaining memory.
-                    for (; i < newCapacity; i++)
+                    Relocate(pData, m_pData, m_size);
+
+                    if (IsUsingInlineData() == false)
                     {
-                        new(&pData[i]) T();
+                        DD_FREE(m_pData, m_allocCb);
                     }
+                    m_pData = pData;
+                    m_capacity = newCapacity;
                 }
-                // Otherwise, we just copy the existing data into the new vector and call it good.
                 else
                 {
-                    // Need to use reinterpret_cast here because gcc can't seem to evaluate
-                    // `is_trivial_v` at compile-time, thus generating a no-class-memaccess warning.
-                    // `if constexpr` fixes the issue, but AMDLOG's toolchain doesn't support c++17.
-                    std::memcpy(reinterpret_cast<void*>(pData), m_pData, m_size * sizeof(T));
+                    result = false;
                 }
-
-                if (m_pData != m_data)
-                {
-                    // If the object wasn't a POD we need to destroy all instances before freeing the memory.
-                    if (!Platform::IsPod<T>::Value)
-                    {
-                        for (size_t i = 0; i < m_capacity; i++)
-                        {
-                            m_pData[i].~T();
-                        }
-                    }
-                    DD_FREE(m_pData, m_allocCb);
-                }
-                m_pData = pData;
-                m_capacity = newCapacity;
             }
+
+            return result;
         }
 
-        // Resizes the vector. Implicitly destroys objects if newSize is smaller than the existing size.
-        void Resize(size_t newSize)
+        // Resizes the vector. Destroys objects if newSize is smaller than the existing size, and default constructs
+        // the new objects if it is larger.
+        //
+        // Returns false if the allocation failed, in which case the vector is left unchanged.
+        bool Resize(size_t newSize)
         {
-            // TODO: Reserve should return whether allocation failed
-            Reserve(newSize);
+            const bool result = Reserve(newSize);
 
-            // If the object isn't a POD and we are shrinking the size, we need to replace destroyed objects with
-            // default constructed instances.
-            if (!Platform::IsPod<T>::Value)
+            if (result)
             {
-                for (size_t i = newSize; i < m_size; i++)
+                if (newSize < m_size)
                 {
-                    m_pData[i] = T();
+                    Destroy(&m_pData[newSize], (m_size - newSize));
                 }
+                else
+                {
+                    for (size_t i = m_size; i < newSize; i++)
+                    {
+                        new(&m_pData[i]) T();
+                    }
+                }
+                m_size = newSize;
             }
-            m_size = newSize;
+
+            return result;
         }
 
         // Resizes the vector, zeroing additional elements
         //
         // Warning: This will break badly if your type cannot be safely memset() to 0!
-        void ResizeAndZero(size_t newSize)
+        //
+        // Returns false if the allocation failed, in which case the vector is left unchanged.
+        bool ResizeAndZero(size_t newSize)
         {
-            // TODO: Reserve should return whether allocation failed
-            Reserve(newSize);
+            const bool result = Reserve(newSize);
 
-            if (newSize > m_size)
+            if (result)
             {
-                memset(&m_pData[m_size], 0, (newSize - m_size) * sizeof(T));
+                if (newSize > m_size)
+                {
+                    memset(reinterpret_cast<void*>(&m_pData[m_size]), 0, (newSize - m_size) * sizeof(T));
+                }
+                else
+                {
+                    Destroy(&m_pData[newSize], (m_size - newSize));
+                }
+
+                m_size = newSize;
             }
 
-            m_size = newSize;
+            return result;
         }
 
-        // Grows the vector by the specified number of elements and returns the previous size
-        size_t Grow(size_t numElements)
+        // Grows the vector by the specified number of default constructed elements and returns the previous size
+        // through pOldSize, so callers can fill in the new range.
+        //
+        // Returns false if the allocation failed, in which case the vector is left unchanged.
+        bool Grow(size_t numElements, size_t* pOldSize)
         {
-            const size_t oldSize = m_size;
+            DD_ASSERT(pOldSize != nullptr);
+            *pOldSize = m_size;
 
-            Resize(m_size + numElements);
-
-            return oldSize;
+            return Resize(m_size + numElements);
         }
 
         // Iterator creation function
@@ -479,19 +460,44 @@ namespace DevDriver
         // Disallow copy construct.
         Vector(Vector& rhs) = delete;
 
-        // This indirection fixes the warning comparision of a constant with another constant. This should be
-        // replace with `if constexpr` once AMDLog upgrades to support C++17.
-        constexpr bool is_type_trivial()
+        // Returns the storage embedded in the object, which holds up to defaultCapacity elements.
+        T* InlineData() { return reinterpret_cast<T*>(m_data); }
+
+        bool IsUsingInlineData() const { return (m_pData == reinterpret_cast<const T*>(m_data)); }
+
+        // Moves count live objects from pSrc into the unconstructed storage at pDst. The source storage is left
+        // unconstructed afterwards. Pods are moved with a single memcpy.
+        static void Relocate(T* pDst, T* pSrc, size_t count)
         {
-#if !DD_PLATFORM_WINDOWS_KM
-            return std::is_trivial_v<T>;
-#else
-            // <type_traits> not available in kernel so treat every type as nontrivial
-            return false;
-#endif
+            if (Platform::IsPod<T>::Value)
+            {
+                // The void* cast keeps gcc's class-memaccess warning quiet, since the branch is not compile-time.
+                memcpy(reinterpret_cast<void*>(pDst), pSrc, (count * sizeof(T)));
+            }
+            else
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    new(&pDst[i]) T(Platform::Move(pSrc[i]));
+                    pSrc[i].~T();
+                }
+            }
+        }
+
+        // Destroys count live objects starting at pData.
+        static void Destroy(T* pData, size_t count)
+        {
+            if (Platform::IsTriviallyDestructible<T>::Value == false)
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    pData[i].~T();
+                }
+            }
         }
 
-        T m_data[defaultCapacity];
+        // Only the first m_size elements of the active storage are constructed.
+        alignas(T) char m_data[sizeof(T) * defaultCapacity];
         T* m_pData;
         size_t m_size;
         size_t m_capacity;
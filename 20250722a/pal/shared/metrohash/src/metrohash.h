@@ -20,5 +20,6 @@
 #include "metrohash64.h"
 #include "metrohash128.h"
 #include "metrohash128crc.h"
+#include "metrohash128tree.h"
 
 #endif // #ifndef METROHASH_METROHASH_H
@@ -0,0 +1,438 @@
+// metrohash128tree.cpp
+//
+// Copyright© 2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "metrohash128tree.h"
+#include "metrohash128crc.h"
+
+#if METROHASH_ENABLE_CRC
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace Util
+{
+
+// Out-of-line definitions; Finish() binds these to references when appending the trailer.
+const uint32_t MetroHash128Tree::version;
+const uint64_t MetroHash128Tree::leaf_size;
+
+const uint64_t MetroHash128Tree::test_length = (3 * MetroHash128Tree::leaf_size) + 12345;
+
+const uint8_t MetroHash128Tree::test_seed_0[16] =   {
+                                                    0x4C, 0x7E, 0xFB, 0x36, 0xA4, 0xFD, 0x4E, 0x0B,
+                                                    0x8F, 0xC4, 0xB7, 0x3A, 0xBD, 0x65, 0x0D, 0xE1
+                                                    };
+
+const uint8_t MetroHash128Tree::test_seed_1[16] =   {
+                                                    0x36, 0xA6, 0xDA, 0xB9, 0x8D, 0xCC, 0x46, 0x1A,
+                                                    0x0B, 0x3A, 0x3D, 0x8B, 0x6D, 0x01, 0xCC, 0x1F
+                                                    };
+
+
+static uint32_t ResolveThreadCount(const uint32_t thread_count)
+{
+    uint32_t count = thread_count;
+    if (count == 0)
+    {
+        count = std::thread::hardware_concurrency();
+    }
+    return (count > 0) ? count : 1;
+}
+
+
+// A batch is posted to all workers at once. Each worker, and the posting
+// thread, claims leaves from a shared counter until none are left; every leaf
+// writes its own slot, so the claim order does not affect the result.
+struct MetroHash128Tree::Workers
+{
+    explicit Workers(uint32_t count);
+    ~Workers();
+
+    // Hashes the first batch leaves of buffer into hashes on all threads. Returns when every leaf is done.
+    void Run(LeafFunction leaf_function, uint64_t seed, const uint8_t * buffer, uint32_t batch,
+             uint8_t (*hashes)[16]);
+
+    void HashClaimedLeaves();
+    void ThreadMain();
+
+    std::vector<std::thread> threads;
+    std::mutex               lock;
+    std::condition_variable  posted;      // Signaled when a batch is posted or the workers must stop.
+    std::condition_variable  finished;    // Signaled when the last worker leaves a batch.
+    uint64_t                 generation;  // Number of batches posted so far.
+    uint32_t                 busy;        // Workers that have not yet finished the current batch.
+    bool                     stop;
+
+    // The current batch. Written under the lock before it is posted.
+    LeafFunction             leaf_function;
+    uint64_t                 seed;
+    const uint8_t *          buffer;
+    uint32_t                 batch;
+    uint8_t                  (*hashes)[16];
+    std::atomic<uint32_t>    next_leaf;
+};
+
+
+MetroHash128Tree::Workers::Workers(const uint32_t count)
+    : generation(0), busy(0), stop(false), leaf_function(LeafFunction::MetroHash128), seed(0), buffer(nullptr),
+      batch(0), hashes(nullptr), next_leaf(0)
+{
+    threads.reserve(count);
+    for (uint32_t w = 0; w < count; ++w)
+    {
+        threads.emplace_back(&Workers::ThreadMain, this);
+    }
+}
+
+
+MetroHash128Tree::Workers::~Workers()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stop = true;
+    }
+    posted.notify_all();
+
+    for (std::thread & thread : threads)
+    {
+        thread.join();
+    }
+}
+
+
+void MetroHash128Tree::Workers::HashClaimedLeaves()
+{
+    for (uint32_t i = next_leaf.fetch_add(1); i < batch; i = next_leaf.fetch_add(1))
+    {
+        HashLeaf(leaf_function, seed, buffer + (i * leaf_size), leaf_size, hashes[i]);
+    }
+}
+
+
+void MetroHash128Tree::Workers::ThreadMain()
+{
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> guard(lock);
+
+    for (;;)
+    {
+        posted.wait(guard, [&]() { return stop || (generation != seen); });
+        if (stop)
+        {
+            break;
+        }
+        seen = generation;
+
+        guard.unlock();
+        HashClaimedLeaves();
+        guard.lock();
+
+        if (--busy == 0)
+        {
+            finished.notify_one();
+        }
+    }
+}
+
+
+void MetroHash128Tree::Workers::Run(
+    const LeafFunction leaf_function,
+    const uint64_t seed,
+    const uint8_t * const buffer,
+    const uint32_t batch,
+    uint8_t (*hashes)[16])
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        this->leaf_function = leaf_function;
+        this->seed          = seed;
+        this->buffer        = buffer;
+        this->batch         = batch;
+        this->hashes        = hashes;
+        next_leaf.store(0);
+        busy = static_cast<uint32_t>(threads.size());
+        ++generation;
+    }
+    posted.notify_all();
+
+    HashClaimedLeaves();
+
+    // The batch fields must stay untouched until every worker has left it.
+    std::unique_lock<std::mutex> guard(lock);
+    finished.wait(guard, [&]() { return busy == 0; });
+}
+
+
+MetroHash128Tree::MetroHash128Tree(const uint64_t seed, const LeafFunction leaf_function, const uint32_t thread_count)
+    : partial(nullptr), workers(nullptr)
+{
+    Initialize(seed, leaf_function, thread_count);
+}
+
+
+MetroHash128Tree::~MetroHash128Tree()
+{
+    delete workers;
+    delete[] partial;
+}
+
+
+void MetroHash128Tree::Initialize(const uint64_t seed, const LeafFunction leaf_function, const uint32_t thread_count)
+{
+    root.Initialize(seed);
+    this->seed = seed;
+    bytes = 0;
+
+    // Record the leaf function actually used, so the output never claims CRC leaves it did not compute.
+    this->leaf_function = ((leaf_function == LeafFunction::MetroHash128Crc) && CrcAvailable())
+                          ? LeafFunction::MetroHash128Crc
+                          : LeafFunction::MetroHash128;
+    this->thread_count = ResolveThreadCount(thread_count);
+
+    // Keep running workers across Initialize() unless the thread count changed.
+    if ((workers != nullptr) && ((workers->threads.size() + 1) != this->thread_count))
+    {
+        delete workers;
+        workers = nullptr;
+    }
+}
+
+
+void MetroHash128Tree::HashLeaf(
+    const LeafFunction leaf_function,
+    const uint64_t seed,
+    const uint8_t * const buffer,
+    const uint64_t length,
+    uint8_t * const hash)
+{
+#if METROHASH_ENABLE_CRC
+    if (leaf_function == LeafFunction::MetroHash128Crc)
+    {
+        // The CRC variant only takes a 32-bit seed.
+        metrohash128crc_1(buffer, length, static_cast<uint32_t>(seed), hash);
+        return;
+    }
+#else
+    (void)leaf_function;
+#endif
+    MetroHash128::Hash(buffer, length, hash, seed);
+}
+
+
+void MetroHash128Tree::HashLeaves(const uint8_t * buffer, uint64_t count)
+{
+    uint8_t hashes[leaf_batch][16];
+
+    while (count > 0)
+    {
+        const uint32_t batch = (count < leaf_batch) ? static_cast<uint32_t>(count) : leaf_batch;
+
+        if ((thread_count > 1) && (batch > 1))
+        {
+            if (workers == nullptr)
+            {
+                workers = new Workers(thread_count - 1);
+            }
+            workers->Run(leaf_function, seed, buffer, batch, hashes);
+        }
+        else
+        {
+            for (uint32_t i = 0; i < batch; ++i)
+            {
+                HashLeaf(leaf_function, seed, buffer + (i * leaf_size), leaf_size, hashes[i]);
+            }
+        }
+
+        // fold the leaf hashes into the root in input order
+        root.Update(&hashes[0][0], static_cast<uint64_t>(batch) * 16);
+
+        buffer += batch * leaf_size;
+        count  -= batch;
+    }
+}
+
+
+void MetroHash128Tree::Update(const uint8_t * const buffer, const uint64_t length)
+{
+    const uint8_t * ptr = buffer;
+    uint64_t remaining = length;
+
+    // partial leaf may be buffered
+    const uint64_t buffered = bytes % leaf_size;
+    if ((buffered != 0) && (remaining > 0))
+    {
+        uint64_t fill = leaf_size - buffered;
+        if (fill > remaining)
+            fill = remaining;
+
+        memcpy(partial + buffered, ptr, static_cast<size_t>(fill));
+        ptr       += fill;
+        remaining -= fill;
+        bytes     += fill;
+
+        if ((bytes % leaf_size) == 0)
+        {
+            HashLeaves(partial, 1);
+        }
+    }
+
+    // whole leaves are hashed directly from the source
+    const uint64_t leaves = remaining / leaf_size;
+    if (leaves > 0)
+    {
+        HashLeaves(ptr, leaves);
+        ptr       += leaves * leaf_size;
+        remaining -= leaves * leaf_size;
+        bytes     += leaves * leaf_size;
+    }
+
+    // store the trailing partial leaf
+    if (remaining > 0)
+    {
+        if (partial == nullptr)
+        {
+            partial = new uint8_t[leaf_size];
+        }
+        memcpy(partial, ptr, static_cast<size_t>(remaining));
+        bytes += remaining;
+    }
+}
+
+
+void MetroHash128Tree::Finish(const uint8_t * const tail, uint8_t * const hash)
+{
+    // The last leaf may be short. Empty input still hashes one empty leaf.
+    const uint64_t tail_length = bytes % leaf_size;
+    if ((tail_length != 0) || (bytes == 0))
+    {
+        uint8_t leaf_hash[16];
+        HashLeaf(leaf_function, seed, tail, tail_length, leaf_hash);
+        root.Update(leaf_hash, sizeof(leaf_hash));
+    }
+
+    // trailer
+    root.Update(bytes);
+    root.Update(version);
+    root.Update(static_cast<uint32_t>(leaf_function));
+    root.Update(leaf_size);
+
+    root.Finalize(hash);
+    bytes = 0;
+}
+
+
+void MetroHash128Tree::Finalize(uint8_t * const hash)
+{
+    Finish(partial, hash);
+}
+
+
+void MetroHash128Tree::Hash(
+    const uint8_t * const buffer,
+    const uint64_t length,
+    uint8_t * const hash,
+    const uint64_t seed,
+    const LeafFunction leaf_function,
+    const uint32_t thread_count)
+{
+    MetroHash128Tree tree(seed, leaf_function, thread_count);
+
+    // Only whole leaves go through Update(); the tail is hashed in place rather than copied.
+    tree.Update(buffer, length - (length % leaf_size));
+    tree.bytes = length;
+    tree.Finish(buffer + (length - (length % leaf_size)), hash);
+}
+
+
+bool MetroHash128Tree::CrcAvailable()
+{
+#if METROHASH_ENABLE_CRC
+    static const bool available = []()
+    {
+        unsigned int regs[4] = {};
+#if defined(_MSC_VER)
+        __cpuid(reinterpret_cast<int*>(regs), 1);
+#else
+        __get_cpuid(1, &regs[0], &regs[1], &regs[2], &regs[3]);
+#endif
+        // ECX bit 20 is SSE4.2.
+        return ((regs[2] >> 20) & 1) != 0;
+    }();
+    return available;
+#else
+    return false;
+#endif
+}
+
+
+MetroHash128Tree::LeafFunction MetroHash128Tree::FastestLeafFunction()
+{
+    return CrcAvailable() ? LeafFunction::MetroHash128Crc : LeafFunction::MetroHash128;
+}
+
+
+bool MetroHash128Tree::ImplementationVerified()
+{
+    uint8_t hash[16];
+    uint8_t * const key = new uint8_t[test_length];
+    for (uint64_t i = 0; i < test_length; i++)
+    {
+        key[i] = static_cast<uint8_t>((i * 131) + (i >> 9));
+    }
+
+    bool verified = true;
+    const uint8_t * const expected[2] = { test_seed_0, test_seed_1 };
+
+    for (uint64_t seed = 0; seed < 2; seed++)
+    {
+        // verify one-shot implementation, single and multi-threaded
+        MetroHash128Tree::Hash(key, test_length, hash, seed, LeafFunction::MetroHash128, 1);
+        verified = verified && (memcmp(hash, expected[seed], 16) == 0);
+
+        MetroHash128Tree::Hash(key, test_length, hash, seed, LeafFunction::MetroHash128, 4);
+        verified = verified && (memcmp(hash, expected[seed], 16) == 0);
+
+        // verify incremental implementation with chunks that straddle leaf boundaries
+        MetroHash128Tree tree(seed, LeafFunction::MetroHash128, 2);
+        const uint64_t chunk = (leaf_size / 3) + 7;
+        for (uint64_t offset = 0; offset < test_length; offset += chunk)
+        {
+            tree.Update(key + offset, ((test_length - offset) < chunk) ? (test_length - offset) : chunk);
+        }
+        tree.Finalize(hash);
+        verified = verified && (memcmp(hash, expected[seed], 16) == 0);
+    }
+
+    delete[] key;
+    return verified;
+}
+
+
+void metrohash128tree_1(const uint8_t * key, uint64_t len, uint32_t seed, uint8_t * out)
+{
+    MetroHash128Tree::Hash(key, len, out, seed, MetroHash128Tree::LeafFunction::MetroHash128, 1);
+}
+
+} // Util
@@ -0,0 +1,134 @@
+// metrohash128tree.h
+//
+// Copyright© 2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef METROHASH_METROHASH_128_TREE_H
+#define METROHASH_METROHASH_128_TREE_H
+
+#include <stdint.h>
+#include "metrohash128.h"
+
+namespace Util
+{
+
+// Tree hashing mode for very large inputs. The input is cut into fixed-size
+// leaves which are hashed independently (and therefore in parallel), and the
+// leaf hashes are folded in order into a MetroHash128 root together with a
+// trailer holding the format version, leaf function, leaf size and total
+// length. The result depends only on the input, seed and leaf function, never
+// on the thread count or on how the input was split across Update() calls.
+//
+// The output is NOT the same as MetroHash128 of the same input.
+class MetroHash128Tree
+{
+public:
+    static const uint32_t bits = 128;
+
+    // Format version recorded in every hash. Bump on any change to the layout.
+    static const uint32_t version = 1;
+
+    // Size of one leaf in bytes. Part of the format.
+    static const uint64_t leaf_size = 256 * 1024;
+
+    // Hash function applied to each leaf. Also part of the format, so hashes
+    // made with different leaf functions never compare equal.
+    enum class LeafFunction : uint32_t
+    {
+        MetroHash128    = 0, // Portable MetroHash128::Hash.
+        MetroHash128Crc = 1, // metrohash128crc_1; needs SSE4.2, see CrcAvailable().
+    };
+
+    // Constructor initializes the same as Initialize()
+    MetroHash128Tree(const uint64_t seed=0,
+                     const LeafFunction leaf_function=LeafFunction::MetroHash128,
+                     const uint32_t thread_count=1);
+    ~MetroHash128Tree();
+
+    // Initializes internal state for new hash. thread_count is the number of
+    // threads used to hash runs of whole leaves passed to Update(); zero means
+    // one per hardware thread.
+    void Initialize(const uint64_t seed=0,
+                    const LeafFunction leaf_function=LeafFunction::MetroHash128,
+                    const uint32_t thread_count=1);
+
+    // Update the hash state with the next chunk of input, e.g. as it arrives
+    // from I/O. Whole leaves are hashed straight from the argument buffer; a
+    // trailing partial leaf is buffered until the next call.
+    void Update(const uint8_t * buffer, const uint64_t length);
+
+    // Constructs the final hash and writes it to the argument buffer.
+    // After a hash is finalized, this instance must be Initialized()-ed
+    // again or the behavior of Update() and Finalize() is undefined.
+    void Finalize(uint8_t * const hash);
+
+    // A non-incremental implementation that hashes all leaves of the buffer
+    // on up to thread_count threads (zero means one per hardware thread).
+    static void Hash(const uint8_t * buffer, const uint64_t length, uint8_t * const hash, const uint64_t seed=0,
+                     const LeafFunction leaf_function=LeafFunction::MetroHash128, const uint32_t thread_count=0);
+
+    // Returns true if this build includes the CRC leaf function and the CPU
+    // supports SSE4.2. Queried once per process.
+    static bool CrcAvailable();
+
+    // Returns the fastest leaf function this machine can run. Only use this
+    // for hashes which never leave the machine: the choice is recorded in the
+    // output, so other machines may compute a different hash for the same data.
+    static LeafFunction FastestLeafFunction();
+
+    // Does implementation correctly execute test vectors?
+    static bool ImplementationVerified();
+
+    // test vectors -- Hash(test_buffer(test_length), seed=N) => test_seed_N,
+    // where test_buffer byte i is (i * 131 + (i >> 9)) & 0xFF
+    static const uint64_t test_length;
+    static const uint8_t test_seed_0[16];
+    static const uint8_t test_seed_1[16];
+
+private:
+    // Leaf hashes are computed this many at a time before being folded into the root.
+    static const uint32_t leaf_batch = 256;
+
+    // Hashes count whole leaves starting at buffer and folds them into the root.
+    void HashLeaves(const uint8_t * buffer, uint64_t count);
+
+    // Hashes the final partial leaf, if any, then appends the trailer and writes the hash.
+    void Finish(const uint8_t * const tail, uint8_t * const hash);
+
+    static void HashLeaf(LeafFunction leaf_function, uint64_t seed, const uint8_t * buffer, uint64_t length,
+                         uint8_t * const hash);
+
+    // Threads which help hash leaf batches. Started on the first batch with
+    // more than one leaf and reused until destruction or a thread count change.
+    struct Workers;
+
+    MetroHash128   root;
+    uint64_t       seed;
+    uint64_t       bytes;
+    LeafFunction   leaf_function;
+    uint32_t       thread_count;
+    uint8_t *      partial;       // Buffered partial leaf, allocated on first use.
+    Workers *      workers;       // thread_count - 1 helper threads, or null.
+
+    MetroHash128Tree(const MetroHash128Tree&) = delete;
+    MetroHash128Tree& operator=(const MetroHash128Tree&) = delete;
+};
+
+
+// Legacy-style entry point for testvector.h; portable leaves, single thread.
+void metrohash128tree_1(const uint8_t * key, uint64_t len, uint32_t seed, uint8_t * out);
+
+} // Util
+
+#endif // #ifndef METROHASH_METROHASH_128_TREE_H
@@ -0,0 +1,192 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  ddCrc32Bench.cpp
+ * @brief Throughput of the dd_crc32 paths against the original byte-at-a-time table.
+ *
+ * Columns, in GB/s for a buffer of each size:
+ *
+ * - table:    the original Sarwate loop, one table lookup per byte.
+ * - slice8:   CRC32SlicingBy8(), the portable fallback.
+ * - hardware: the PCLMULQDQ or ARMv8 kernel, if built and supported (tail bytes through the tables, as CRC32() does).
+ * - CRC32:    the dispatching entry point.
+ *
+ * The last line is the cost of one CRC32Combine() for a 1 MiB second half.  Best of five runs.
+ *
+ * Usage: ddCrc32Bench [bytes per run]
+ ***********************************************************************************************************************
+ */
+
+#include "palUtilTest.h"
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// dd_crc32.h is normally included through ddcPlatform.h, which supplies these.
+#ifndef DD_STATIC_CONST
+#define DD_STATIC_CONST static constexpr
+#endif
+#ifndef DD_RESTRICT
+#define DD_RESTRICT __restrict
+#endif
+#include "dd_crc32.h"
+
+using namespace Util;
+using namespace Util::Test;
+
+namespace
+{
+
+volatile uint32_t g_sink = 0;
+uint32_t          g_sarwateTable[256];
+
+// =====================================================================================================================
+uint32_t SarwateCrc32(
+    const void* pData,
+    size_t      length,
+    uint32_t    lastCRC)
+{
+    uint32_t             crc      = ~lastCRC;
+    const unsigned char* pCurrent = static_cast<const unsigned char*>(pData);
+    while (length--)
+    {
+        crc = (crc >> 8) ^ g_sarwateTable[(crc & 0xFF) ^ *pCurrent++];
+    }
+    return ~crc;
+}
+
+// =====================================================================================================================
+// Runs crc over the buffer until bytesPerRun bytes have been checksummed, five times.
+// @returns The best throughput in GB/s.
+template <typename Crc>
+double BestGBps(
+    const std::vector<unsigned char>& buffer,
+    size_t                            size,
+    size_t                            bytesPerRun,
+    Crc                               crc)
+{
+    const size_t numCalls = Max<size_t>(bytesPerRun / size, 1);
+    double       best     = 0;
+
+    for (uint32 rep = 0; rep < 5; ++rep)
+    {
+        uint32_t   value = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < numCalls; ++i)
+        {
+            value = crc(buffer.data(), size, value);
+        }
+        best   = Max(best, double(numCalls * size) / ElapsedSeconds(start) * 1e-9);
+        g_sink = value;
+    }
+
+    return best;
+}
+
+// =====================================================================================================================
+// The hardware kernel this build has, with the tail through the tables, as CRC32() does it without the CPU check.
+uint32_t HardwareCrc32(
+    const void* pData,
+    size_t      length,
+    uint32_t    lastCRC)
+{
+#if DD_CRC32_PCLMUL
+    const size_t foldLength = length & ~size_t(15);
+    if (foldLength >= 64)
+    {
+        const unsigned char* pBytes = static_cast<const unsigned char*>(pData);
+        lastCRC = ~CRC32FoldPclmul(pBytes, foldLength, ~lastCRC);
+        pData   = pBytes + foldLength;
+        length -= foldLength;
+    }
+    return CRC32SlicingBy8(pData, length, lastCRC);
+#elif DD_CRC32_ARMV8
+    return CRC32Armv8(pData, length, lastCRC);
+#else
+    return CRC32SlicingBy8(pData, length, lastCRC);
+#endif
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    const size_t bytesPerRun = (argc > 1) ? size_t(atoll(argv[1])) : (size_t(256) << 20);
+
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+        uint32_t entry = i;
+        for (uint32_t bit = 0; bit < 8; ++bit)
+        {
+            entry = (entry >> 1) ^ ((entry & 1) ? 0xEDB88320 : 0);
+        }
+        g_sarwateTable[i] = entry;
+    }
+
+    std::vector<unsigned char> buffer(size_t(1) << 20);
+    std::mt19937               random(1);
+    for (unsigned char& byte : buffer)
+    {
+        byte = static_cast<unsigned char>(random());
+    }
+
+#if DD_CRC32_PCLMUL
+    const bool hasHardware = CRC32HasPclmul();
+    printf("hardware path: PCLMULQDQ%s\n", hasHardware ? "" : " (not supported by this CPU)");
+#elif DD_CRC32_ARMV8
+    const bool hasHardware = true;
+    printf("hardware path: ARMv8 CRC32\n");
+#else
+    const bool hasHardware = false;
+    printf("hardware path: none\n");
+#endif
+
+    printf("    bytes |   table  slice8 hardware   CRC32   (GB/s)\n");
+    for (size_t size : { size_t(16), size_t(64), size_t(256), size_t(4096), size_t(65536), buffer.size() })
+    {
+        const double table    = BestGBps(buffer, size, bytesPerRun / 8, SarwateCrc32);
+        const double slice8   = BestGBps(buffer, size, bytesPerRun / 2, CRC32SlicingBy8);
+        const double hardware = hasHardware ? BestGBps(buffer, size, bytesPerRun, HardwareCrc32) : 0.0;
+        const double dispatch = BestGBps(buffer, size, bytesPerRun, CRC32);
+
+        printf("%9zu | %7.2f %7.2f %8.2f %7.2f\n", size, table, slice8, hardware, dispatch);
+    }
+
+    constexpr uint32 NumCombines = 100000;
+    uint32_t         crc         = 0;
+    const auto       start       = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < NumCombines; ++i)
+    {
+        crc = CRC32Combine(crc, i, buffer.size());
+    }
+    g_sink = crc;
+    printf("CRC32Combine, 1 MiB second half: %.0f ns/call\n", ElapsedSeconds(start) * 1e9 / NumCombines);
+
+    return 0;
+}
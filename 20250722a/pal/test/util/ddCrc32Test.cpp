@@ -0,0 +1,213 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  ddCrc32Test.cpp
+ * @brief Checks every dd_crc32 path bit-exact against the original byte-at-a-time table.
+ *
+ * Random lengths, misalignments and starting CRCs are run through CRC32(), the slicing-by-8 fallback and whichever of
+ * the PCLMULQDQ and ARMv8 kernels this build and CPU have, and CRC32Combine() is checked on random split points.
+ *
+ * Usage: ddCrc32Test [iterations]
+ ***********************************************************************************************************************
+ */
+
+#include "palUtilTest.h"
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// dd_crc32.h is normally included through ddcPlatform.h, which supplies these.
+#ifndef DD_STATIC_CONST
+#define DD_STATIC_CONST static constexpr
+#endif
+#ifndef DD_RESTRICT
+#define DD_RESTRICT __restrict
+#endif
+#include "dd_crc32.h"
+
+using namespace Util;
+using namespace Util::Test;
+
+namespace
+{
+
+uint32_t g_sarwateTable[256];
+
+// =====================================================================================================================
+// Builds the table the original CRC32() used, bit by bit from the reflected polynomial.
+void InitSarwateTable()
+{
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+        uint32_t entry = i;
+        for (uint32_t bit = 0; bit < 8; ++bit)
+        {
+            entry = (entry >> 1) ^ ((entry & 1) ? 0xEDB88320 : 0);
+        }
+        g_sarwateTable[i] = entry;
+    }
+}
+
+// =====================================================================================================================
+// The original byte-at-a-time CRC32(), the reference every path must match.
+uint32_t SarwateCrc32(
+    const void* pData,
+    size_t      length,
+    uint32_t    lastCRC = 0)
+{
+    uint32_t             crc      = ~lastCRC;
+    const unsigned char* pCurrent = static_cast<const unsigned char*>(pData);
+    while (length--)
+    {
+        crc = (crc >> 8) ^ g_sarwateTable[(crc & 0xFF) ^ *pCurrent++];
+    }
+    return ~crc;
+}
+
+// =====================================================================================================================
+// Lengths are mostly short, to cover every tail and alignment, with some large enough to run the hardware loops for a
+// while.
+size_t RandomLength(
+    std::mt19937* pRandom,
+    uint32        iteration,
+    size_t        maxLength)
+{
+    const size_t limit = ((iteration % 16) == 0) ? maxLength : 600;
+    return (*pRandom)() % (limit + 1);
+}
+
+// =====================================================================================================================
+void TestKnownValues()
+{
+    const char* pCheck = "123456789";
+
+    PAL_TEST_CHECK(SarwateCrc32(pCheck, 9) == 0xCBF43926);
+    PAL_TEST_CHECK(CRC32(pCheck, 9) == 0xCBF43926);
+    PAL_TEST_CHECK(CRC32SlicingBy8(pCheck, 9) == 0xCBF43926);
+    PAL_TEST_CHECK(CRC32(pCheck, 0) == 0);
+    PAL_TEST_CHECK(CRC32(pCheck, 0, 0x12345678) == 0x12345678);
+}
+
+// =====================================================================================================================
+void TestPaths(
+    const std::vector<unsigned char>& buffer,
+    uint32                            iterations)
+{
+    constexpr size_t MaxOffset = 64;
+    std::mt19937     random(1);
+
+#if DD_CRC32_PCLMUL
+    const bool hasPclmul = CRC32HasPclmul();
+    printf("PCLMULQDQ path: %s\n", hasPclmul ? "tested" : "not supported by this CPU");
+#else
+    printf("PCLMULQDQ path: not built\n");
+#endif
+#if DD_CRC32_ARMV8
+    printf("ARMv8 path: tested\n");
+#else
+    printf("ARMv8 path: not built\n");
+#endif
+
+    for (uint32 i = 0; i < iterations; ++i)
+    {
+        const size_t               offset   = random() % MaxOffset;
+        const size_t               length   = RandomLength(&random, i, buffer.size() - MaxOffset);
+        const uint32_t             seed     = (i % 4 == 0) ? 0 : uint32_t(random());
+        const unsigned char* const pData    = buffer.data() + offset;
+        const uint32_t             expected = SarwateCrc32(pData, length, seed);
+
+        PAL_TEST_CHECK(CRC32(pData, length, seed) == expected);
+        PAL_TEST_CHECK(CRC32SlicingBy8(pData, length, seed) == expected);
+
+#if DD_CRC32_PCLMUL
+        // The folding kernel takes the raw state and a length that is a multiple of 16 and at least 64.
+        const size_t foldLength = length & ~size_t(15);
+        if (hasPclmul && (foldLength >= 64))
+        {
+            const uint32_t folded = ~CRC32FoldPclmul(pData, foldLength, ~seed);
+            PAL_TEST_CHECK(folded == SarwateCrc32(pData, foldLength, seed));
+        }
+#endif
+#if DD_CRC32_ARMV8
+        PAL_TEST_CHECK(CRC32Armv8(pData, length, seed) == expected);
+#endif
+    }
+}
+
+// =====================================================================================================================
+// Checksums the two halves of a buffer separately and merges them, as a parallel checksum would.
+void TestCombine(
+    const std::vector<unsigned char>& buffer,
+    uint32                            iterations)
+{
+    std::mt19937 random(2);
+
+    for (uint32 i = 0; i < iterations; ++i)
+    {
+        const size_t               offset   = random() % 16;
+        const size_t               length   = RandomLength(&random, i, buffer.size() - 16);
+        const size_t               split    = (i % 8 == 0) ? ((i % 16 == 0) ? 0 : length) : (random() % (length + 1));
+        const unsigned char* const pData    = buffer.data() + offset;
+        const uint32_t             expected = SarwateCrc32(pData, length);
+
+        const uint32_t crcA = CRC32(pData, split);
+        const uint32_t crcB = CRC32(pData + split, length - split);
+        PAL_TEST_CHECK(CRC32Combine(crcA, crcB, length - split) == expected);
+
+        // Chaining through lastCRC must agree with combining.
+        PAL_TEST_CHECK(CRC32(pData + split, length - split, crcA) == expected);
+    }
+
+    // Lengths beyond 32 bits only exercise more squarings, but must not misbehave.
+    const uint32_t crcA = CRC32(buffer.data(), 100);
+    PAL_TEST_CHECK(CRC32Combine(crcA, 0, 0) == crcA);
+    PAL_TEST_CHECK(CRC32Combine(0, 0, uint64_t(1) << 40) == 0);
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    const uint32 iterations = (argc > 1) ? uint32(atoi(argv[1])) : 20000;
+
+    InitSarwateTable();
+
+    std::vector<unsigned char> buffer(256 * 1024);
+    std::mt19937               random(3);
+    for (unsigned char& byte : buffer)
+    {
+        byte = static_cast<unsigned char>(random());
+    }
+
+    TestKnownValues();
+    TestPaths(buffer, iterations);
+    TestCombine(buffer, iterations);
+
+    return Finish("ddCrc32Test");
+}
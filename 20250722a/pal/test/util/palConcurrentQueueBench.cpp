@@ -0,0 +1,149 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palConcurrentQueueBench.cpp
+ * @brief Throughput of ConcurrentQueue and SegmentedConcurrentQueue against a Deque guarded by a Mutex.
+ *
+ * Runs N producers and N consumers for N = 1, 2, 4, ... up to the given maximum and prints the best of three runs in
+ * millions of items per second.  Results above the machine's core count measure oversubscription, not scaling.
+ *
+ * Usage: palConcurrentQueueBench [items] [max threads per side]
+ ***********************************************************************************************************************
+ */
+
+#include "palUtilTest.h"
+#include "palConcurrentQueue.h"
+#include "palDequeImpl.h"
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace Util;
+using namespace Util::Test;
+
+namespace
+{
+
+// =====================================================================================================================
+// Returns millions of items per second moved from numThreads producers to numThreads consumers.
+template<typename PushFunc, typename PopFunc>
+double Run(
+    uint32   numThreads,
+    uint64   total,
+    PushFunc push,
+    PopFunc  pop)
+{
+    std::atomic<uint64> received{0};
+    std::vector<std::thread> threads;
+    const auto start = std::chrono::steady_clock::now();
+
+    for (uint32 p = 0; p < numThreads; ++p)
+    {
+        threads.emplace_back([&, p]()
+        {
+            for (uint64 i = p; i < total; i += numThreads)
+            {
+                while (push(i) == false)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (uint32 c = 0; c < numThreads; ++c)
+    {
+        threads.emplace_back([&]()
+        {
+            uint64 value;
+            while (received.load(std::memory_order_relaxed) < total)
+            {
+                if (pop(&value))
+                {
+                    received.fetch_add(1, std::memory_order_relaxed);
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    return total / ElapsedSeconds(start) / 1e6;
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    const uint64 total      = (argc > 1) ? uint64(atoll(argv[1])) : 2000000;
+    const uint32 maxThreads = (argc > 2) ? uint32(atoi(argv[2])) : 16;
+
+    printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    printf("%-8s %14s %14s %14s   (Mitems/s)\n", "threads", "Deque+Mutex", "Concurrent", "Segmented");
+
+    for (uint32 numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+    {
+        CountingAllocator allocator;
+        double locked     = 0;
+        double bounded    = 0;
+        double segmented  = 0;
+
+        for (uint32 rep = 0; rep < 3; ++rep)
+        {
+            {
+                Deque<uint64, CountingAllocator> deque(&allocator);
+                Mutex lock;
+                locked = Max(locked, Run(numThreads, total,
+                    [&](uint64 value) { MutexAuto guard(&lock); return deque.PushBack(value) == Result::Success; },
+                    [&](uint64* pValue) { MutexAuto guard(&lock); return deque.PopFront(pValue) == Result::Success; }));
+            }
+            {
+                ConcurrentQueue<uint64, CountingAllocator> queue(&allocator);
+                queue.Init(4096);
+                bounded = Max(bounded, Run(numThreads, total,
+                    [&](uint64 value) { return queue.TryPush(value) == Result::Success; },
+                    [&](uint64* pValue) { return queue.TryPop(pValue) == Result::Success; }));
+            }
+            {
+                SegmentedConcurrentQueue<uint64, CountingAllocator> queue(&allocator);
+                queue.Init();
+                segmented = Max(segmented, Run(numThreads, total,
+                    [&](uint64 value) { return queue.Push(value) == Result::Success; },
+                    [&](uint64* pValue) { return queue.TryPop(pValue) == Result::Success; }));
+            }
+        }
+        printf("%-8u %14.2f %14.2f %14.2f\n", numThreads, locked, bounded, segmented);
+    }
+    return 0;
+}
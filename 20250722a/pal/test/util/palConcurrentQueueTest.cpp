@@ -0,0 +1,312 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palConcurrentQueueTest.cpp
+ * @brief Functional and multi-threaded stress tests for ConcurrentQueue and SegmentedConcurrentQueue.
+ *
+ * The stress tests are meant to be run under ThreadSanitizer as well (PAL_UTIL_TESTS_TSAN).
+ *
+ * Usage: palConcurrentQueueTest [items per producer]
+ ***********************************************************************************************************************
+ */
+
+#include "palUtilTest.h"
+#include "palConcurrentQueue.h"
+#include <cstdlib>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace Util;
+using namespace Util::Test;
+
+namespace
+{
+
+// Number of Tracked objects alive, to catch elements that are leaked or destroyed twice.
+std::atomic<int32> g_liveElements{0};
+
+struct Tracked
+{
+    Tracked() : value(0) { ++g_liveElements; }
+    explicit Tracked(uint64 v) : value(v) { ++g_liveElements; }
+    Tracked(const Tracked& other) : value(other.value) { ++g_liveElements; }
+    Tracked& operator=(const Tracked& other) { value = other.value; return *this; }
+    ~Tracked() { --g_liveElements; }
+
+    uint64 value;
+};
+
+// =====================================================================================================================
+// Pushes from numProducers threads and pops from numConsumers threads with a mix of single, batch and blocking pops.
+// Producer p pushes (p << 32 | i) for i in [0, perProducer).  Every value must arrive exactly once and, as seen by any
+// one consumer, the values of each producer must arrive in order.
+template<typename Queue, typename PushFunc>
+void Stress(
+    Queue*   pQueue,
+    uint32   numProducers,
+    uint32   numConsumers,
+    uint32   perProducer,
+    PushFunc push)
+{
+    const uint64 total = uint64(numProducers) * perProducer;
+    std::vector<std::atomic<uint8>> seen(total);
+    std::atomic<uint64> received{0};
+    std::vector<std::thread> threads;
+
+    for (uint32 p = 0; p < numProducers; ++p)
+    {
+        threads.emplace_back([&, p]()
+        {
+            Tracked batch[7];
+            uint32 i = 0;
+            while (i < perProducer)
+            {
+                if (((i % 3) == 0) && (i + 7 <= perProducer))
+                {
+                    for (uint32 k = 0; k < 7; ++k)
+                    {
+                        batch[k].value = (uint64(p) << 32) | (i + k);
+                    }
+                    i += push(pQueue, batch, 7);
+                }
+                else
+                {
+                    Tracked item((uint64(p) << 32) | i);
+                    i += push(pQueue, &item, 1);
+                }
+            }
+        });
+    }
+
+    for (uint32 c = 0; c < numConsumers; ++c)
+    {
+        threads.emplace_back([&, c]()
+        {
+            std::vector<int64> last(numProducers, -1);
+            Tracked out[5];
+            while (received.load() < total)
+            {
+                uint32 count = 0;
+                switch (c % 3)
+                {
+                case 0:
+                    count = pQueue->TryPopBatch(out, 5);
+                    break;
+                case 1:
+                    count = (pQueue->TryPop(out) == Result::Success) ? 1 : 0;
+                    break;
+                default:
+                    count = (pQueue->Pop(out, fseconds(0.01f)) == Result::Success) ? 1 : 0;
+                    break;
+                }
+
+                for (uint32 k = 0; k < count; ++k)
+                {
+                    const uint32 producer = uint32(out[k].value >> 32);
+                    const uint32 index    = uint32(out[k].value);
+                    PAL_TEST_CHECK((producer < numProducers) && (index < perProducer));
+                    if ((producer < numProducers) && (index < perProducer))
+                    {
+                        PAL_TEST_CHECK(int64(index) > last[producer]);
+                        last[producer] = index;
+                        PAL_TEST_CHECK(seen[uint64(producer) * perProducer + index].fetch_add(1) == 0);
+                    }
+                }
+                received += count;
+                if (count == 0)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    PAL_TEST_CHECK(received.load() == total);
+}
+
+// =====================================================================================================================
+template<typename Queue>
+uint32 BoundedPush(
+    Queue*   pQueue,
+    Tracked* pItems,
+    uint32   count)
+{
+    const uint32 pushed = (count == 1) ? ((pQueue->TryPush(*pItems) == Result::Success) ? 1 : 0)
+                                       : pQueue->TryPushBatch(pItems, count);
+    if (pushed == 0)
+    {
+        std::this_thread::yield();
+    }
+    return pushed;
+}
+
+// =====================================================================================================================
+template<typename Queue>
+uint32 SegmentedPush(
+    Queue*   pQueue,
+    Tracked* pItems,
+    uint32   count)
+{
+    const Result result = (count == 1) ? pQueue->Push(*pItems) : pQueue->PushBatch(pItems, count);
+    PAL_TEST_CHECK(result == Result::Success);
+    return count;
+}
+
+// =====================================================================================================================
+void TestBoundedSingleThread()
+{
+    CountingAllocator allocator;
+    {
+        ConcurrentQueue<Tracked, CountingAllocator> queue(&allocator);
+        PAL_TEST_CHECK(queue.Init(5) == Result::Success);
+        PAL_TEST_CHECK(queue.Capacity() == 8);
+
+        Tracked item;
+        for (uint32 i = 0; i < 8; ++i)
+        {
+            PAL_TEST_CHECK(queue.TryPush(Tracked(i)) == Result::Success);
+        }
+        PAL_TEST_CHECK(queue.TryPush(item) == Result::NotReady);
+        PAL_TEST_CHECK((queue.TryPop(&item) == Result::Success) && (item.value == 0));
+
+        // Only one slot is free, so only one element of the batch fits.
+        Tracked batch[8];
+        PAL_TEST_CHECK(queue.TryPushBatch(batch, 8) == 1);
+        PAL_TEST_CHECK(queue.TryPopBatch(batch, 8) == 8);
+        PAL_TEST_CHECK((batch[0].value == 1) && (batch[6].value == 7) && (batch[7].value == 0));
+        PAL_TEST_CHECK(queue.TryPop(&item) == Result::NotReady);
+
+        PAL_TEST_CHECK(queue.TryPush(Tracked(42)) == Result::Success);
+        PAL_TEST_CHECK((queue.Pop(&item, fseconds(0.05f)) == Result::Success) && (item.value == 42));
+        const auto start = std::chrono::steady_clock::now();
+        PAL_TEST_CHECK(queue.Pop(&item, fseconds(0.05f)) == Result::Timeout);
+        PAL_TEST_CHECK(ElapsedSeconds(start) >= 0.04);
+
+        // Left for the destructor.
+        for (uint32 i = 0; i < 3; ++i)
+        {
+            queue.TryPush(Tracked(i));
+        }
+    }
+    PAL_TEST_CHECK(g_liveElements.load() == 0);
+    PAL_TEST_CHECK(allocator.Balanced());
+}
+
+// =====================================================================================================================
+void TestSegmentedSingleThread()
+{
+    CountingAllocator allocator;
+    {
+        // Two elements per block, so the pushes below cross several blocks.
+        SegmentedConcurrentQueue<Tracked, CountingAllocator> queue(&allocator, 2, 1);
+        PAL_TEST_CHECK(queue.Init() == Result::Success);
+
+        Tracked batch[5] = { Tracked(0), Tracked(1), Tracked(2), Tracked(3), Tracked(4) };
+        PAL_TEST_CHECK(queue.PushBatch(batch, 5) == Result::Success);
+        PAL_TEST_CHECK(queue.Push(Tracked(5)) == Result::Success);
+
+        // A batch pop stops at a block boundary, so keep popping until everything is out.
+        Tracked out[6];
+        uint32 popped = 0;
+        for (uint32 attempt = 0; (attempt < 16) && (popped < 6); ++attempt)
+        {
+            popped += queue.TryPopBatch(out + popped, 6 - popped);
+        }
+        PAL_TEST_CHECK(popped == 6);
+        for (uint32 i = 0; i < popped; ++i)
+        {
+            PAL_TEST_CHECK(out[i].value == i);
+        }
+
+        Tracked item;
+        PAL_TEST_CHECK(queue.TryPop(&item) == Result::NotReady);
+        PAL_TEST_CHECK(queue.Pop(&item, fseconds(0.01f)) == Result::Timeout);
+
+        // Left for the destructor.
+        for (uint32 i = 0; i < 9; ++i)
+        {
+            queue.Push(Tracked(i));
+        }
+    }
+    PAL_TEST_CHECK(g_liveElements.load() == 0);
+    PAL_TEST_CHECK(allocator.Balanced());
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    const uint32 perProducer = (argc > 1) ? uint32(atoi(argv[1])) : 20000;
+
+    TestBoundedSingleThread();
+    TestSegmentedSingleThread();
+
+    const std::pair<uint32, uint32> shapes[] = { { 1, 1 }, { 4, 1 }, { 1, 4 }, { 4, 4 }, { 8, 3 } };
+
+    CountingAllocator allocator;
+    for (uint32 round = 0; round < 3; ++round)
+    {
+        for (const auto& shape : shapes)
+        {
+            // A tiny ring makes producers and consumers wrap around constantly.
+            ConcurrentQueue<Tracked, CountingAllocator> queue(&allocator);
+            PAL_TEST_CHECK(queue.Init((round == 0) ? 4 : 64) == Result::Success);
+            Stress(&queue, shape.first, shape.second, perProducer, BoundedPush<decltype(queue)>);
+        }
+    }
+    PAL_TEST_CHECK(g_liveElements.load() == 0);
+
+    for (uint32 round = 0; round < 3; ++round)
+    {
+        for (const auto& shape : shapes)
+        {
+            // One-element blocks retire a block on every pop; round also varies the number of pooled blocks.
+            SegmentedConcurrentQueue<Tracked, CountingAllocator> queue(&allocator,
+                                                                       (round == 0) ? 1 : ((round == 1) ? 3 : 64),
+                                                                       round);
+            PAL_TEST_CHECK(queue.Init() == Result::Success);
+            Stress(&queue, shape.first, shape.second, perProducer, SegmentedPush<decltype(queue)>);
+
+            // Left for the destructor.
+            for (uint32 i = 0; i < 100; ++i)
+            {
+                queue.Push(Tracked(i));
+            }
+        }
+    }
+    PAL_TEST_CHECK(g_liveElements.load() == 0);
+    PAL_TEST_CHECK(allocator.Balanced());
+
+    return Finish("palConcurrentQueueTest");
+}
@@ -0,0 +1,366 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palDequeBench.cpp
+ * @brief Deque as a FIFO and for random access, against the previous linked-block design.
+ *
+ * LinkedDeque below reproduces the layout Deque had before its block map and free-block pool: blocks linked in a list,
+ * one cached free block, and At() walking the list from the front.  Each row reports:
+ *
+ * - steady: ns per PushBack + PopFront pair with the deque holding a constant number of elements, and the allocator
+ *   calls made while doing so.  Always element at a time.
+ * - burst:  ns per element to push the whole working set and pop it again, and the allocator calls made.
+ *
+ * The last line times At() at random indices.  Best of three runs.
+ *
+ * Usage: palDequeBench [elements in the working set]
+ ***********************************************************************************************************************
+ */
+
+#include "palUtilTest.h"
+#include "palDequeImpl.h"
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace Util;
+using namespace Util::Test;
+
+namespace
+{
+
+// =====================================================================================================================
+// The previous Deque layout, reduced to what the benchmark needs.
+template<typename T>
+class LinkedDeque
+{
+public:
+    LinkedDeque(CountingAllocator* pAllocator, size_t numElementsPerBlock = 256)
+        :
+        m_pAllocator(pAllocator),
+        m_numElementsPerBlock(numElementsPerBlock),
+        m_numElements(0),
+        m_pFrontHeader(nullptr),
+        m_pBackHeader(nullptr),
+        m_pLazyFreeHeader(nullptr),
+        m_pFront(nullptr),
+        m_pBack(nullptr)
+    { }
+
+    ~LinkedDeque()
+    {
+        while (m_pFrontHeader != nullptr)
+        {
+            Block* pNext = (m_pFrontHeader == m_pBackHeader) ? nullptr : m_pFrontHeader->pNext;
+            PAL_FREE(m_pFrontHeader, m_pAllocator);
+            m_pFrontHeader = pNext;
+        }
+        PAL_FREE(m_pLazyFreeHeader, m_pAllocator);
+    }
+
+    Result PushBack(const T& data)
+    {
+        if ((m_pBackHeader == nullptr) || (m_pBack + 1 == m_pBackHeader->pEnd))
+        {
+            Block* pHeader = AllocateBlock();
+            if (pHeader == nullptr)
+            {
+                return Result::ErrorOutOfMemory;
+            }
+            if (m_pBackHeader != nullptr)
+            {
+                m_pBackHeader->pNext = pHeader;
+            }
+            else
+            {
+                m_pFrontHeader = pHeader;
+                m_pFront       = pHeader->pStart;
+            }
+            m_pBackHeader = pHeader;
+            m_pBack       = pHeader->pStart;
+        }
+        else
+        {
+            ++m_pBack;
+        }
+        *m_pBack = data;
+        ++m_numElements;
+        return Result::Success;
+    }
+
+    Result PopFront(T* pOut)
+    {
+        if (m_numElements == 0)
+        {
+            return Result::ErrorUnavailable;
+        }
+        *pOut = *m_pFront;
+        if (--m_numElements == 0)
+        {
+            FreeBlock(m_pFrontHeader);
+            m_pFrontHeader = m_pBackHeader = nullptr;
+            m_pFront       = m_pBack       = nullptr;
+        }
+        else if (++m_pFront == m_pFrontHeader->pEnd)
+        {
+            Block* pOld    = m_pFrontHeader;
+            m_pFrontHeader = pOld->pNext;
+            m_pFront       = m_pFrontHeader->pStart;
+            FreeBlock(pOld);
+        }
+        return Result::Success;
+    }
+
+    T& At(uint32 index)
+    {
+        size_t offset  = (m_pFront - m_pFrontHeader->pStart) + index;
+        Block* pHeader = m_pFrontHeader;
+        while (offset >= m_numElementsPerBlock)
+        {
+            pHeader = pHeader->pNext;
+            offset -= m_numElementsPerBlock;
+        }
+        return pHeader->pStart[offset];
+    }
+
+private:
+    struct Block
+    {
+        Block* pNext;
+        T*     pStart;
+        T*     pEnd;
+    };
+
+    Block* AllocateBlock()
+    {
+        Block* pHeader = m_pLazyFreeHeader;
+        if (pHeader != nullptr)
+        {
+            m_pLazyFreeHeader = nullptr;
+        }
+        else
+        {
+            pHeader = static_cast<Block*>(PAL_MALLOC(sizeof(Block) + sizeof(T) * m_numElementsPerBlock,
+                                                     m_pAllocator,
+                                                     AllocInternal));
+            if (pHeader != nullptr)
+            {
+                pHeader->pStart = reinterpret_cast<T*>(pHeader + 1);
+                pHeader->pEnd   = pHeader->pStart + m_numElementsPerBlock;
+            }
+        }
+        if (pHeader != nullptr)
+        {
+            pHeader->pNext = nullptr;
+        }
+        return pHeader;
+    }
+
+    void FreeBlock(Block* pHeader)
+    {
+        if (m_pLazyFreeHeader == nullptr)
+        {
+            m_pLazyFreeHeader = pHeader;
+        }
+        else
+        {
+            PAL_FREE(pHeader, m_pAllocator);
+        }
+    }
+
+    CountingAllocator*const m_pAllocator;
+    const size_t            m_numElementsPerBlock;
+    size_t                  m_numElements;
+    Block*                  m_pFrontHeader;
+    Block*                  m_pBackHeader;
+    Block*                  m_pLazyFreeHeader;
+    T*                      m_pFront;
+    T*                      m_pBack;
+};
+
+// Keeps popped values live so the compiler cannot drop the loops.
+volatile uint64 g_sink = 0;
+
+// =====================================================================================================================
+// @returns Nanoseconds per op since start.
+double NsPer(
+    std::chrono::steady_clock::time_point start,
+    double                                numOps)
+{
+    return ElapsedSeconds(start) * 1e9 / numOps;
+}
+
+// =====================================================================================================================
+// Times one deque configuration and prints its row.  pushRun/popRun move the whole working set in and out.
+template<typename DequeType, typename PushRunFunc, typename PopRunFunc>
+void RunFifo(
+    const char*        pName,
+    DequeType*         pDeque,
+    CountingAllocator* pAllocator,
+    size_t             numElements,
+    PushRunFunc        pushRun,
+    PopRunFunc         popRun)
+{
+    double steadyNs = 1e30;
+    double burstNs  = 1e30;
+    uint32 steadyAllocs = 0;
+    uint32 burstAllocs  = 0;
+    uint64 value = 0;
+    uint64 sum   = 0;
+
+    for (uint32 rep = 0; rep < 3; ++rep)
+    {
+        pushRun(pDeque);
+
+        uint32 allocs = pAllocator->Allocs();
+        auto   start  = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < 8 * numElements; ++i)
+        {
+            pDeque->PushBack(i);
+            pDeque->PopFront(&value);
+            sum += value;
+        }
+        steadyNs     = Min(steadyNs, NsPer(start, 8.0 * numElements));
+        steadyAllocs = pAllocator->Allocs() - allocs;
+
+        popRun(pDeque);
+
+        allocs = pAllocator->Allocs();
+        start  = std::chrono::steady_clock::now();
+        for (uint32 round = 0; round < 8; ++round)
+        {
+            pushRun(pDeque);
+            popRun(pDeque);
+        }
+        burstNs     = Min(burstNs, NsPer(start, 8.0 * numElements));
+        burstAllocs = pAllocator->Allocs() - allocs;
+    }
+    g_sink = sum;
+
+    printf("%-30s %12.2f %12u %14.2f %12u\n", pName, steadyNs, steadyAllocs, burstNs, burstAllocs);
+}
+
+// =====================================================================================================================
+// @returns Best-of-three ns per At() call at the given indices.
+template<typename DequeType>
+double TimeAt(
+    DequeType*                 pDeque,
+    const std::vector<uint32>& indices)
+{
+    double best = 1e30;
+    uint64 sum  = 0;
+    for (uint32 rep = 0; rep < 3; ++rep)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32 index : indices)
+        {
+            sum += pDeque->At(index);
+        }
+        best = Min(best, NsPer(start, double(indices.size())));
+    }
+    g_sink = sum;
+    return best;
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    const size_t numElements = (argc > 1) ? size_t(atoll(argv[1])) : (size_t(1) << 20);
+    const size_t runLength   = 4096;
+    const size_t perBlock    = 256;
+    std::vector<uint64> buffer(numElements + runLength);
+
+    // Element at a time, as most callers use the deque.
+    auto pushEach = [&](auto* pDeque) { for (size_t i = 0; i < numElements; ++i) { pDeque->PushBack(i); } };
+    auto popEach  = [&](auto* pDeque) { uint64 v; for (size_t i = 0; i < numElements; ++i) { pDeque->PopFront(&v); } };
+
+    // runLength elements per call through the bulk overloads.
+    auto pushRuns = [&](auto* pDeque)
+    {
+        for (size_t i = 0; i < numElements; i += runLength)
+        {
+            pDeque->PushBack(&buffer[i], Min(runLength, numElements - i));
+        }
+    };
+    auto popRuns = [&](auto* pDeque)
+    {
+        for (size_t i = 0; i < numElements; i += runLength)
+        {
+            pDeque->PopFront(&buffer[i], Min(runLength, numElements - i));
+        }
+    };
+
+    printf("working set %zu uint64 elements, %zu per block\n", numElements, perBlock);
+    printf("%-30s %12s %12s %14s %12s\n", "", "steady ns/op", "steady alloc", "burst ns/elem", "burst alloc");
+    {
+        CountingAllocator allocator;
+        LinkedDeque<uint64> deque(&allocator, perBlock);
+        RunFifo("linked, 1 lazy block", &deque, &allocator, numElements, pushEach, popEach);
+    }
+    {
+        CountingAllocator allocator;
+        Deque<uint64, CountingAllocator> deque(&allocator, perBlock);
+        RunFifo("Deque, pool 1", &deque, &allocator, numElements, pushEach, popEach);
+    }
+    {
+        CountingAllocator allocator;
+        Deque<uint64, CountingAllocator> deque(&allocator, perBlock, numElements / perBlock);
+        RunFifo("Deque, pool = working set", &deque, &allocator, numElements, pushEach, popEach);
+    }
+    {
+        CountingAllocator allocator;
+        Deque<uint64, CountingAllocator> deque(&allocator, perBlock, numElements / perBlock);
+        RunFifo("Deque, pool = working set, bulk", &deque, &allocator, numElements, pushRuns, popRuns);
+    }
+
+    std::mt19937 rng(1);
+    std::vector<uint32> indices(1 << 16);
+    for (uint32& index : indices)
+    {
+        index = uint32(rng() % numElements);
+    }
+    double linkedNs = 0;
+    double dequeNs  = 0;
+    {
+        CountingAllocator allocator;
+        LinkedDeque<uint64> deque(&allocator, perBlock);
+        pushEach(&deque);
+        linkedNs = TimeAt(&deque, indices);
+    }
+    {
+        CountingAllocator allocator;
+        Deque<uint64, CountingAllocator> deque(&allocator, perBlock);
+        pushEach(&deque);
+        dequeNs = TimeAt(&deque, indices);
+    }
+    printf("At() at random indices: linked %.1f ns, Deque %.1f ns\n", linkedNs, dequeNs);
+
+    return 0;
+}
@@ -0,0 +1,223 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palDequeTest.cpp
+ * @brief Randomized test of Deque against std::deque.
+ *
+ * Runs random single and bulk pushes and pops, At(), and forward and reverse iteration over a range of block and pool
+ * sizes, with both a trivially copyable element and one that owns heap memory.
+ *
+ * Usage: palDequeTest [steps per configuration]
+ ***********************************************************************************************************************
+ */
+
+#include "palUtilTest.h"
+#include "palDequeImpl.h"
+#include <cstdlib>
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Util;
+using namespace Util::Test;
+
+namespace
+{
+
+// Number of Tracked objects alive, to catch elements that are leaked or destroyed twice.
+int32 g_liveElements = 0;
+
+// An element with a nontrivial copy, move and destructor.  The string is long enough to live on the heap.
+struct Tracked
+{
+    Tracked() { ++g_liveElements; }
+    explicit Tracked(uint32 v) : text(std::to_string(v) + "-long-enough-to-heap-allocate") { ++g_liveElements; }
+    Tracked(const Tracked& other) : text(other.text) { ++g_liveElements; }
+    Tracked(Tracked&& other) : text(std::move(other.text)) { ++g_liveElements; }
+    Tracked& operator=(const Tracked& other) = default;
+    Tracked& operator=(Tracked&& other) = default;
+    ~Tracked() { --g_liveElements; }
+
+    bool operator==(const Tracked& other) const { return text == other.text; }
+
+    std::string text;
+};
+
+// =====================================================================================================================
+// Applies numSteps random operations to a Deque and a std::deque and checks that they always agree.
+template<typename T, typename MakeFunc>
+void Fuzz(
+    size_t   elementsPerBlock,
+    size_t   maxFreeBlocks,
+    uint32   numSteps,
+    uint32   seed,
+    MakeFunc make)
+{
+    CountingAllocator allocator;
+    std::mt19937      rng(seed);
+    uint32            next = 0;
+    {
+        Deque<T, CountingAllocator> deque(&allocator, elementsPerBlock, maxFreeBlocks);
+        std::deque<T>  reference;
+        std::vector<T> buffer;
+        T              value = T();
+
+        for (uint32 step = 0; step < numSteps; ++step)
+        {
+            const uint32 op = rng() % 100;
+            if (op < 25)
+            {
+                const T item = make(next++);
+                PAL_TEST_CHECK(deque.PushBack(item) == Result::Success);
+                reference.push_back(item);
+            }
+            else if (op < 40)
+            {
+                const T item = make(next++);
+                PAL_TEST_CHECK(deque.PushFront(item) == Result::Success);
+                reference.push_front(item);
+            }
+            else if (op < 45)
+            {
+                // Bulk runs up to three blocks long, so they start and end mid-block and span whole blocks.
+                const size_t count = rng() % (3 * elementsPerBlock + 2);
+                buffer.clear();
+                for (size_t i = 0; i < count; ++i)
+                {
+                    buffer.push_back(make(next++));
+                }
+                PAL_TEST_CHECK(deque.PushBack(buffer.data(), count) == Result::Success);
+                reference.insert(reference.end(), buffer.begin(), buffer.end());
+            }
+            else if (op < 50)
+            {
+                const size_t count = rng() % (3 * elementsPerBlock + 2);
+                buffer.assign(count, T());
+                const Result result = deque.PopFront(buffer.data(), count);
+                if (count > reference.size())
+                {
+                    PAL_TEST_CHECK(result == Result::ErrorUnavailable);
+                }
+                else
+                {
+                    PAL_TEST_CHECK(result == Result::Success);
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        PAL_TEST_CHECK(buffer[i] == reference.front());
+                        reference.pop_front();
+                    }
+                }
+            }
+            else if (op < 70)
+            {
+                const Result result = deque.PopFront(&value);
+                PAL_TEST_CHECK((result == Result::Success) == (reference.empty() == false));
+                if (reference.empty() == false)
+                {
+                    PAL_TEST_CHECK(value == reference.front());
+                    reference.pop_front();
+                }
+            }
+            else if (op < 85)
+            {
+                const Result result = deque.PopBack(&value);
+                PAL_TEST_CHECK((result == Result::Success) == (reference.empty() == false));
+                if (reference.empty() == false)
+                {
+                    PAL_TEST_CHECK(value == reference.back());
+                    reference.pop_back();
+                }
+            }
+            else if (op < 95)
+            {
+                if (reference.empty() == false)
+                {
+                    const uint32 index = uint32(rng() % reference.size());
+                    const auto&  constDeque = deque;
+                    PAL_TEST_CHECK(deque.At(index) == reference[index]);
+                    PAL_TEST_CHECK(constDeque[index] == reference[index]);
+                }
+            }
+            else
+            {
+                size_t i = 0;
+                for (auto iter = deque.Begin(); iter.IsValid(); iter.Next(), ++i)
+                {
+                    PAL_TEST_CHECK((i < reference.size()) && (*iter.Get() == reference[i]));
+                }
+                PAL_TEST_CHECK(i == reference.size());
+                for (auto iter = deque.End(); iter.IsValid(); iter.Prev())
+                {
+                    PAL_TEST_CHECK((i > 0) && (*iter.Get() == reference[--i]));
+                }
+                PAL_TEST_CHECK(i == 0);
+            }
+
+            PAL_TEST_CHECK(deque.NumElements() == reference.size());
+            if (reference.empty() == false)
+            {
+                PAL_TEST_CHECK(deque.Front() == reference.front());
+                PAL_TEST_CHECK(deque.Back() == reference.back());
+            }
+
+            // Drain now and then, so the deque also runs through the empty state and its pooled blocks get reused.
+            if ((step % 10000) == 9999)
+            {
+                while (reference.empty() == false)
+                {
+                    PAL_TEST_CHECK((deque.PopFront(&value) == Result::Success) && (value == reference.front()));
+                    reference.pop_front();
+                }
+            }
+        }
+        // Anything left is freed by the destructor.
+    }
+    PAL_TEST_CHECK(allocator.Balanced());
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    const uint32 numSteps = (argc > 1) ? uint32(atoi(argv[1])) : 50000;
+
+    for (size_t elementsPerBlock : { 1, 2, 7, 256 })
+    {
+        for (size_t maxFreeBlocks : { 0, 1, 16 })
+        {
+            const uint32 seed = uint32(elementsPerBlock * 31 + maxFreeBlocks);
+            Fuzz<uint64>(elementsPerBlock, maxFreeBlocks, numSteps, seed, [](uint32 v) { return uint64(v); });
+            Fuzz<Tracked>(elementsPerBlock, maxFreeBlocks, numSteps, seed, [](uint32 v) { return Tracked(v); });
+        }
+    }
+    PAL_TEST_CHECK(g_liveElements == 0);
+
+    return Finish("palDequeTest");
+}
@@ -0,0 +1,392 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palLruCacheTest.cpp
+ * @brief Tests for LruCache and ShardedLruCache.
+ *
+ * LruCache is checked step by step against a simple std::list model of both policies, including the order in which
+ * values reach the eviction callback.  ShardedLruCache is checked for its limit split and under concurrent use; the
+ * concurrent test is meant to be run under ThreadSanitizer as well (PAL_UTIL_TESTS_TSAN).
+ *
+ * Usage: palLruCacheTest [steps per model configuration]
+ ***********************************************************************************************************************
+ */
+
+#include "palUtilTest.h"
+#include "palLruCache.h"
+#include <cstdlib>
+#include <iterator>
+#include <list>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace Util;
+using namespace Util::Test;
+
+namespace
+{
+
+typedef std::vector<std::pair<uint64, uint64>> EvictLog;
+typedef LruCache<uint64, uint64, CountingAllocator, JenkinsHashFunc> TestCache;
+
+// =====================================================================================================================
+void LogEviction(
+    void*         pUserData,
+    const uint64& key,
+    uint64*       pValue)
+{
+    static_cast<EvictLog*>(pUserData)->push_back({ key, *pValue });
+}
+
+// Reference implementation of both policies.  The front of the list is the most recently used entry.
+struct Model
+{
+    struct Entry
+    {
+        uint64 key;
+        uint64 value;
+        uint64 bytes;
+        bool   referenced;
+    };
+    typedef std::list<Entry>::iterator EntryIter;
+
+    bool OverLimit(uint64 extraBytes, uint32 extraEntries) const
+    {
+        return ((maxBytes != 0) && ((numBytes + extraBytes) > maxBytes)) ||
+               ((maxEntries != 0) && ((entries.size() + extraEntries) > maxEntries));
+    }
+
+    void Remove(EntryIter iter)
+    {
+        evicted.push_back({ iter->key, iter->value });
+        numBytes -= iter->bytes;
+        map.erase(iter->key);
+        entries.erase(iter);
+    }
+
+    void Evict(uint64 extraBytes, uint32 extraEntries)
+    {
+        while ((entries.empty() == false) && OverLimit(extraBytes, extraEntries))
+        {
+            const EntryIter victim = std::prev(entries.end());
+            if (clock && victim->referenced)
+            {
+                victim->referenced = false;
+                entries.splice(entries.begin(), entries, victim);
+            }
+            else
+            {
+                Remove(victim);
+            }
+        }
+    }
+
+    uint64* Find(uint64 key)
+    {
+        const auto found = map.find(key);
+        if (found == map.end())
+        {
+            return nullptr;
+        }
+        if (clock)
+        {
+            found->second->referenced = true;
+        }
+        else
+        {
+            entries.splice(entries.begin(), entries, found->second);
+        }
+        return &found->second->value;
+    }
+
+    Result Insert(uint64 key, uint64 value, uint64 bytes)
+    {
+        if ((maxBytes != 0) && (bytes > maxBytes))
+        {
+            return Result::ErrorInvalidMemorySize;
+        }
+
+        const auto found = map.find(key);
+        if (found != map.end())
+        {
+            // A replaced entry is never the one evicted to make room for its new size.
+            const EntryIter entry = found->second;
+            evicted.push_back({ key, entry->value });
+            entry->value      = value;
+            numBytes          = numBytes - entry->bytes + bytes;
+            entry->bytes      = bytes;
+            entry->referenced = clock;
+            entries.splice(entries.begin(), entries, entry);
+            Evict(0, 0);
+        }
+        else
+        {
+            Evict(bytes, 1);
+            entries.push_front({ key, value, bytes, false });
+            map[key]  = entries.begin();
+            numBytes += bytes;
+        }
+        return Result::Success;
+    }
+
+    void Clear()
+    {
+        while (entries.empty() == false)
+        {
+            Remove(std::prev(entries.end()));
+        }
+    }
+
+    bool                                 clock;
+    uint64                               maxBytes;
+    uint32                               maxEntries;
+    uint64                               numBytes;
+    std::list<Entry>                     entries;
+    std::unordered_map<uint64, EntryIter> map;
+    EvictLog                             evicted;
+};
+
+// =====================================================================================================================
+// Applies numSteps random operations to an LruCache and the model and checks that they agree after every step.
+void ModelCheck(
+    LruCachePolicy policy,
+    uint64         maxBytes,
+    uint32         maxEntries,
+    uint32         numSteps,
+    uint32         seed)
+{
+    CountingAllocator allocator;
+    EvictLog          log;
+    Model             model = { (policy == LruCachePolicy::Clock), maxBytes, maxEntries, 0 };
+    {
+        TestCache cache({ maxBytes, maxEntries, 64, policy }, &allocator);
+        PAL_TEST_CHECK(cache.Init() == Result::Success);
+        cache.SetEvictCallback(&LogEviction, &log);
+
+        std::mt19937_64 rng(seed);
+        for (uint32 step = 0; step < numSteps; ++step)
+        {
+            const uint64 key = rng() % 300;
+            const uint32 op  = rng() % 100;
+            if (op < 55)
+            {
+                const uint64* pFound    = cache.Find(key);
+                const uint64* pExpected = model.Find(key);
+                PAL_TEST_CHECK((pFound == nullptr) == (pExpected == nullptr));
+                PAL_TEST_CHECK((pFound == nullptr) || (pExpected == nullptr) || (*pFound == *pExpected));
+            }
+            else if (op < 90)
+            {
+                const uint64 value = rng();
+                const uint64 bytes = 1 + rng() % 200;
+                PAL_TEST_CHECK(cache.Insert(key, value, bytes) == model.Insert(key, value, bytes));
+            }
+            else if (op < 98)
+            {
+                const auto found  = model.map.find(key);
+                const bool exists = (found != model.map.end());
+                if (exists)
+                {
+                    model.Remove(found->second);
+                }
+                PAL_TEST_CHECK(cache.Erase(key) == exists);
+            }
+            else if (op < 99)
+            {
+                model.maxBytes   = (maxBytes != 0) ? (maxBytes / 2 + rng() % maxBytes) : 0;
+                model.maxEntries = (maxEntries != 0) ? uint32(maxEntries / 2 + rng() % maxEntries) : 0;
+                cache.SetLimits(model.maxBytes, model.maxEntries);
+                model.Evict(0, 0);
+            }
+            else
+            {
+                cache.Clear();
+                model.Clear();
+            }
+
+            PAL_TEST_CHECK(cache.NumEntries() == model.entries.size());
+            PAL_TEST_CHECK(cache.NumBytes() == model.numBytes);
+            PAL_TEST_CHECK((model.maxBytes == 0) || (model.numBytes <= model.maxBytes));
+            PAL_TEST_CHECK((model.maxEntries == 0) || (model.entries.size() <= model.maxEntries));
+            PAL_TEST_CHECK(log == model.evicted);
+            log.clear();
+            model.evicted.clear();
+        }
+
+        // The destructor hands the remaining values to the callback, least recently used first.
+        model.Clear();
+    }
+    PAL_TEST_CHECK(log == model.evicted);
+    PAL_TEST_CHECK(allocator.Balanced());
+}
+
+// =====================================================================================================================
+// Growing an entry in Clock mode must not evict the entry itself, even when every other entry has its reference flag
+// set and is given a second chance ahead of it.
+void TestClockReplaceKeepsEntry()
+{
+    CountingAllocator allocator;
+    {
+        TestCache cache({ 30, 0, 16, LruCachePolicy::Clock }, &allocator);
+        PAL_TEST_CHECK(cache.Init() == Result::Success);
+
+        PAL_TEST_CHECK(cache.Insert(1, 100, 10) == Result::Success);
+        PAL_TEST_CHECK(cache.Insert(2, 200, 10) == Result::Success);
+        PAL_TEST_CHECK(cache.Insert(3, 300, 10) == Result::Success);
+        PAL_TEST_CHECK(cache.Find(1) != nullptr);
+        PAL_TEST_CHECK(cache.Find(3) != nullptr);
+
+        PAL_TEST_CHECK(cache.Insert(2, 201, 20) == Result::Success);
+
+        const uint64* pValue = cache.Find(2);
+        PAL_TEST_CHECK((pValue != nullptr) && (*pValue == 201));
+        PAL_TEST_CHECK((cache.NumBytes() == 30) && (cache.NumEntries() == 2));
+        PAL_TEST_CHECK(cache.NumEvictions() == 1);
+    }
+    PAL_TEST_CHECK(allocator.Balanced());
+}
+
+// =====================================================================================================================
+// The shards' limits add up to the cache's limits, so a full cache never holds more than it was given.
+void TestShardLimits()
+{
+    CountingAllocator allocator;
+    for (LruCachePolicy policy : { LruCachePolicy::Lru, LruCachePolicy::Clock })
+    {
+        ShardedLruCache<uint64, uint64, CountingAllocator, JenkinsHashFunc, DefaultEqualFunc, 8>
+            cache({ 0, 21, 64, policy }, &allocator);
+        PAL_TEST_CHECK(cache.Init() == Result::Success);
+
+        for (uint64 key = 0; key < 1000; ++key)
+        {
+            PAL_TEST_CHECK(cache.Insert(key, key, 1) == Result::Success);
+            PAL_TEST_CHECK(cache.NumEntries() <= 21);
+        }
+        // Keys hash evenly enough that every shard fills up to its share of two or three entries.
+        PAL_TEST_CHECK(cache.NumEntries() == 21);
+    }
+    PAL_TEST_CHECK(allocator.Balanced());
+
+    for (LruCachePolicy policy : { LruCachePolicy::Lru, LruCachePolicy::Clock })
+    {
+        ShardedLruCache<uint64, uint64, CountingAllocator, JenkinsHashFunc, DefaultEqualFunc, 8>
+            cache({ 1003, 0, 64, policy }, &allocator);
+        PAL_TEST_CHECK(cache.Init() == Result::Success);
+
+        for (uint64 key = 0; key < 1000; ++key)
+        {
+            PAL_TEST_CHECK(cache.Insert(key, key, 1 + key % 50) == Result::Success);
+            PAL_TEST_CHECK(cache.NumBytes() <= 1003);
+        }
+        // 1003 / 8 rounds down to 125, so no shard can take an entry larger than that.
+        PAL_TEST_CHECK(cache.Insert(5000, 0, 126) == Result::ErrorInvalidMemorySize);
+    }
+    PAL_TEST_CHECK(allocator.Balanced());
+}
+
+// =====================================================================================================================
+// Threads look up, insert and erase overlapping keys.  A key's value is always key * 7 + 1, so any torn or stale value
+// shows up as a mismatch.
+void TestConcurrent(
+    LruCachePolicy policy)
+{
+    CountingAllocator   allocator;
+    std::atomic<uint64> numEvicted{0};
+    {
+        ShardedLruCache<uint64, uint64, CountingAllocator, JenkinsHashFunc, DefaultEqualFunc, 8>
+            cache({ 20000, 0, 256, policy }, &allocator);
+        PAL_TEST_CHECK(cache.Init() == Result::Success);
+        cache.SetEvictCallback([](void* pUserData, const uint64& key, uint64* pValue)
+        {
+            PAL_TEST_CHECK(*pValue == key * 7 + 1);
+            static_cast<std::atomic<uint64>*>(pUserData)->fetch_add(1, std::memory_order_relaxed);
+        }, &numEvicted);
+
+        std::vector<std::thread> threads;
+        for (uint32 t = 0; t < 8; ++t)
+        {
+            threads.emplace_back([&cache, t]()
+            {
+                std::mt19937_64 rng(t);
+                for (uint32 i = 0; i < 50000; ++i)
+                {
+                    const uint64 key = rng() % 2000;
+                    const uint32 op  = rng() % 10;
+                    uint64       value = 0;
+                    if (op < 6)
+                    {
+                        PAL_TEST_CHECK((cache.Find(key, &value) == false) || (value == key * 7 + 1));
+                    }
+                    else if (op < 9)
+                    {
+                        PAL_TEST_CHECK(cache.Insert(key, key * 7 + 1, 1 + key % 50) == Result::Success);
+                    }
+                    else
+                    {
+                        cache.Erase(key);
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        PAL_TEST_CHECK(cache.NumBytes() <= 20000);
+    }
+    PAL_TEST_CHECK(numEvicted.load() > 0);
+    PAL_TEST_CHECK(allocator.Balanced());
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    const uint32 numSteps = (argc > 1) ? uint32(atoi(argv[1])) : 100000;
+
+    const std::pair<uint64, uint32> limits[] = { { 0, 50 }, { 5000, 0 }, { 5000, 40 }, { 150, 0 } };
+    uint32 seed = 1;
+    for (LruCachePolicy policy : { LruCachePolicy::Lru, LruCachePolicy::Clock })
+    {
+        for (const auto& limit : limits)
+        {
+            ModelCheck(policy, limit.first, limit.second, numSteps, seed++);
+        }
+    }
+
+    TestClockReplaceKeepsEntry();
+    TestShardLimits();
+    TestConcurrent(LruCachePolicy::Lru);
+    TestConcurrent(LruCachePolicy::Clock);
+
+    return Finish("palLruCacheTest");
+}
@@ -0,0 +1,172 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palMemTrackerBench.cpp
+ * @brief Allocation throughput through MemTracker with many threads allocating at once.
+ *
+ * Each thread allocates 16 blocks of 64 bytes and frees them again, over and over.  The rows compare:
+ *
+ * - the underlying allocator alone;
+ * - MemTracker behind one process-wide Mutex, which serializes tracking the way a single tracker list and lock would;
+ * - MemTracker as it is (sharded lists), tracking every allocation and sampling 1 in 16 and 1 in 64.
+ *
+ * Prints millions of allocations plus frees per second, best of five runs.  Results above the machine's core count
+ * measure oversubscription, not contention between cores.
+ *
+ * Usage: palMemTrackerBench [iterations per thread] [max threads]
+ ***********************************************************************************************************************
+ */
+
+#ifndef PAL_MEMTRACK
+#define PAL_MEMTRACK 1
+#endif
+
+#include "palUtilTest.h"
+#include "palMemTrackerImpl.h"
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace Util;
+using namespace Util::Test;
+
+namespace
+{
+
+constexpr uint32 BatchSize  = 16;
+constexpr size_t BlockBytes = 64;
+
+// =====================================================================================================================
+// Serializes every call into a MemTracker behind one lock.
+class LockedTracker
+{
+public:
+    LockedTracker(GenericAllocator* pAllocator) : m_tracker(pAllocator, 1) { }
+
+    void* Alloc(const AllocInfo& allocInfo)
+    {
+        MutexAuto lock(&m_lock);
+        return m_tracker.Alloc(allocInfo);
+    }
+
+    void Free(const FreeInfo& freeInfo)
+    {
+        MutexAuto lock(&m_lock);
+        m_tracker.Free(freeInfo);
+    }
+
+private:
+    Mutex                        m_lock;
+    MemTracker<GenericAllocator> m_tracker;
+};
+
+// =====================================================================================================================
+// Returns millions of Alloc() plus Free() pairs per second over numThreads threads.
+template<typename AllocatorType>
+double Run(
+    AllocatorType* pAllocator,
+    uint32         numThreads,
+    uint32         iterations)
+{
+    std::vector<std::thread> threads;
+    const auto start = std::chrono::steady_clock::now();
+
+    for (uint32 t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([pAllocator, iterations]()
+        {
+            void* blocks[BatchSize];
+            for (uint32 i = 0; i < iterations; ++i)
+            {
+                for (uint32 j = 0; j < BatchSize; ++j)
+                {
+                    blocks[j] = pAllocator->Alloc(AllocInfo(BlockBytes, 8, false, AllocInternal, MemBlkType::Malloc,
+                                                            __FILE__, __LINE__));
+                }
+                for (uint32 j = 0; j < BatchSize; ++j)
+                {
+                    pAllocator->Free(FreeInfo(blocks[j], MemBlkType::Malloc));
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    return double(numThreads) * iterations * BatchSize / ElapsedSeconds(start) / 1e6;
+}
+
+// =====================================================================================================================
+template<typename AllocatorType>
+double Best(
+    AllocatorType* pAllocator,
+    uint32         numThreads,
+    uint32         iterations)
+{
+    double best = 0;
+    for (uint32 rep = 0; rep < 5; ++rep)
+    {
+        best = Max(best, Run(pAllocator, numThreads, iterations));
+    }
+    return best;
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    const uint32 iterations = (argc > 1) ? uint32(atoi(argv[1])) : 20000;
+    const uint32 maxThreads = (argc > 2) ? uint32(atoi(argv[2])) : 16;
+
+    GenericAllocator allocator;
+
+    printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    printf("%-8s %12s %14s %12s %12s %12s   (M alloc+free/s)\n",
+           "threads", "allocator", "one lock", "rate 1", "rate 16", "rate 64");
+
+    for (uint32 numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+    {
+        LockedTracker                locked(&allocator);
+        MemTracker<GenericAllocator> rate1(&allocator, 1);
+        MemTracker<GenericAllocator> rate16(&allocator, 16);
+        MemTracker<GenericAllocator> rate64(&allocator, 64);
+
+        const double base      = Best(&allocator, numThreads, iterations);
+        const double oneLock   = Best(&locked, numThreads, iterations);
+        const double sharded1  = Best(&rate1, numThreads, iterations);
+        const double sampled16 = Best(&rate16, numThreads, iterations);
+        const double sampled64 = Best(&rate64, numThreads, iterations);
+
+        printf("%-8u %12.2f %14.2f %12.2f %12.2f %12.2f\n",
+               numThreads, base, oneLock, sharded1, sampled16, sampled64);
+    }
+
+    return 0;
+}
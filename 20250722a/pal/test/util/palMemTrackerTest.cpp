@@ -0,0 +1,244 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palMemTrackerTest.cpp
+ * @brief Functional and multi-threaded tests for MemTracker, with and without sampling.
+ *
+ * MemTracker is only compiled in with PAL_MEMTRACK, so this test turns it on for itself.  The concurrent parts are
+ * meant to be run under ThreadSanitizer as well (PAL_UTIL_TESTS_TSAN).
+ *
+ * Usage: palMemTrackerTest
+ ***********************************************************************************************************************
+ */
+
+#ifndef PAL_MEMTRACK
+#define PAL_MEMTRACK 1
+#endif
+
+#include "palUtilTest.h"
+#include "palMemTrackerImpl.h"
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace Util;
+using namespace Util::Test;
+
+namespace
+{
+
+typedef MemTracker<CountingAllocator> Tracker;
+
+// =====================================================================================================================
+void* TrackerAlloc(
+    Tracker*   pTracker,
+    size_t     bytes,
+    size_t     alignment,
+    MemBlkType blockType)
+{
+    return pTracker->Alloc(AllocInfo(bytes, alignment, false, AllocInternal, blockType, __FILE__, __LINE__));
+}
+
+// =====================================================================================================================
+// Runs func on a new thread and waits for it.  Each thread's first allocation is always sampled, so this gives the
+// tests a tracked block at any sample rate.
+template<typename Func>
+void OnNewThread(
+    Func func)
+{
+    std::thread thread(func);
+    thread.join();
+}
+
+// =====================================================================================================================
+void TestAllocFree(
+    uint32 sampleRate)
+{
+    CountingAllocator allocator;
+    {
+        Tracker tracker(&allocator, sampleRate);
+        PAL_TEST_CHECK(tracker.Init() == Result::Success);
+        PAL_TEST_CHECK(tracker.SampleRate() == sampleRate);
+
+        // Every alignment up to 128 is honored and the whole block is writable.
+        std::vector<void*> blocks;
+        size_t             numBytes = 0;
+        for (uint32 i = 0; i < 1000; ++i)
+        {
+            const size_t bytes     = 1 + (i * 37) % 500;
+            const size_t alignment = size_t(1) << (i % 8);
+            void*const   pBlock    = TrackerAlloc(&tracker, bytes, alignment, MemBlkType::Malloc);
+            PAL_TEST_CHECK((pBlock != nullptr) && ((reinterpret_cast<uintptr_t>(pBlock) % alignment) == 0));
+            memset(pBlock, 0xAB, bytes);
+            blocks.push_back(pBlock);
+            numBytes += bytes;
+        }
+        PAL_TEST_CHECK(tracker.NumAllocs() == 1000);
+        PAL_TEST_CHECK(tracker.NumLiveAllocs() == 1000);
+        PAL_TEST_CHECK(tracker.NumLiveBytes() == numBytes);
+
+        // Blocks may be freed on other threads than the one which allocated them.
+        std::vector<std::thread> threads;
+        for (uint32 t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&tracker, &blocks, t]()
+            {
+                for (size_t i = t; i < blocks.size(); i += 4)
+                {
+                    tracker.Free(FreeInfo(blocks[i], MemBlkType::Malloc));
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        PAL_TEST_CHECK(tracker.NumLiveAllocs() == 0);
+        PAL_TEST_CHECK(tracker.NumLiveBytes() == 0);
+        PAL_TEST_CHECK(allocator.Balanced());
+
+        // Concurrent churn.
+        threads.clear();
+        for (uint32 t = 0; t < 8; ++t)
+        {
+            threads.emplace_back([&tracker]()
+            {
+                std::vector<void*> live;
+                for (uint32 i = 0; i < 20000; ++i)
+                {
+                    live.push_back(TrackerAlloc(&tracker, 24, 8, MemBlkType::New));
+                    if (live.size() > 50)
+                    {
+                        for (void* pBlock : live)
+                        {
+                            tracker.Free(FreeInfo(pBlock, MemBlkType::New));
+                        }
+                        live.clear();
+                    }
+                }
+                for (void* pBlock : live)
+                {
+                    tracker.Free(FreeInfo(pBlock, MemBlkType::New));
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        PAL_TEST_CHECK(tracker.NumLiveAllocs() == 0);
+        PAL_TEST_CHECK(allocator.Balanced());
+
+        // A free with the wrong block type is rejected and leaves the block live.
+        void* pBlock = nullptr;
+        OnNewThread([&]() { pBlock = TrackerAlloc(&tracker, 8, 8, MemBlkType::Malloc); });
+        tracker.Free(FreeInfo(pBlock, MemBlkType::New));
+        PAL_TEST_CHECK(tracker.NumLiveAllocs() == 1);
+        tracker.Free(FreeInfo(pBlock, MemBlkType::Malloc));
+        PAL_TEST_CHECK(tracker.NumLiveAllocs() == 0);
+        PAL_TEST_CHECK(allocator.Balanced());
+    }
+    PAL_TEST_CHECK(allocator.Balanced());
+}
+
+// =====================================================================================================================
+// An underrun that overwrites the word in front of a tracked block must not make the block look foreign: with sampling
+// on, that word is also where untracked blocks keep their tag.  The underrun is reported and the block still freed.
+void TestUnderrun(
+    uint32 sampleRate)
+{
+    CountingAllocator allocator;
+    {
+        Tracker tracker(&allocator, sampleRate);
+
+        uint32* pBlock = nullptr;
+        OnNewThread([&]() { pBlock = static_cast<uint32*>(TrackerAlloc(&tracker, 16, 4, MemBlkType::Malloc)); });
+        pBlock[-1] = 0;
+
+        tracker.Free(FreeInfo(pBlock, MemBlkType::Malloc));
+        PAL_TEST_CHECK(tracker.NumLiveAllocs() == 0);
+        PAL_TEST_CHECK(allocator.Balanced());
+    }
+    PAL_TEST_CHECK(allocator.Balanced());
+}
+
+// =====================================================================================================================
+// The destructor frees the sampled leaks; leaks which were not sampled cannot be found and stay with the allocator.
+void TestLeaks(
+    uint32 sampleRate)
+{
+    constexpr uint32 NumThreads      = 4;
+    constexpr uint32 LeaksPerThread  = 8;
+
+    CountingAllocator allocator;
+    {
+        Tracker tracker(&allocator, sampleRate);
+
+        std::vector<std::thread> threads;
+        for (uint32 t = 0; t < NumThreads; ++t)
+        {
+            threads.emplace_back([&tracker]()
+            {
+                for (uint32 i = 0; i < LeaksPerThread; ++i)
+                {
+                    TrackerAlloc(&tracker, 100, 8, MemBlkType::Malloc);
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        PAL_TEST_CHECK(tracker.NumLiveAllocs() == NumThreads * LeaksPerThread);
+    }
+
+    // Each new thread samples its 1st, (1 + rate)th, ... allocation.
+    const uint32 sampledPerThread = RoundUpQuotient(LeaksPerThread, sampleRate);
+    PAL_TEST_CHECK(allocator.Allocs() - allocator.Frees() == NumThreads * (LeaksPerThread - sampledPerThread));
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+#if PAL_ENABLE_PRINTS_ASSERTS
+    // Some cases below trigger the tracker's error reporting on purpose.
+    EnableAssertMode(AssertCatAssert, false);
+    EnableAssertMode(AssertCatAlert, false);
+#endif
+
+    for (uint32 sampleRate : { 1u, 4u, 16u })
+    {
+        TestAllocFree(sampleRate);
+        TestUnderrun(sampleRate);
+        TestLeaks(sampleRate);
+    }
+
+    return Finish("palMemTrackerTest");
+}
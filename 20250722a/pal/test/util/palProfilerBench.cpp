@@ -0,0 +1,158 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palProfilerBench.cpp
+ * @brief Overhead of PAL_PROFILE_SCOPE.
+ *
+ * Rows, in ns per call of a small function:
+ *
+ * - no instrumentation: the same function without a scope, as the baseline.
+ * - disabled: the scope compiled in, profiling off.  This is the cost every build that keeps the scopes pays.
+ * - enabled: each call reads the tick counter twice and appends one event to the thread's buffer.
+ *
+ * Then the cost of the first enabled scope on a new thread, which has to find a buffer: a fresh allocation while the
+ * earlier threads' events are kept, and a recycled buffer after Reset().  Thread start and join are included.
+ *
+ * Best of five runs.
+ *
+ * Usage: palProfilerBench [calls per run]
+ ***********************************************************************************************************************
+ */
+
+#include "palUtilTest.h"
+#include "palProfiler.h"
+#include <cstdlib>
+#include <thread>
+
+using namespace Util;
+using namespace Util::Test;
+
+namespace
+{
+
+volatile uint64 g_sink = 0;
+
+// =====================================================================================================================
+[[gnu::noinline]] void Plain(
+    uint64 value)
+{
+    g_sink = g_sink + value;
+}
+
+// =====================================================================================================================
+[[gnu::noinline]] void Instrumented(
+    uint64 value)
+{
+    PAL_PROFILE_SCOPE("work");
+    g_sink = g_sink + value;
+}
+
+// =====================================================================================================================
+// @returns The best ns per call of pfnWork over five runs, with the events of the previous run discarded each time.
+double BestNsPerCall(
+    void   (*pfnWork)(uint64),
+    uint32 numCalls)
+{
+    double best = 1e30;
+
+    for (uint32 rep = 0; rep < 5; ++rep)
+    {
+        Profiler::Reset();
+
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32 i = 0; i < numCalls; ++i)
+        {
+            pfnWork(i);
+        }
+        best = Min(best, ElapsedSeconds(start) * 1e9 / numCalls);
+    }
+
+    return best;
+}
+
+// =====================================================================================================================
+// @returns The mean µs to start a thread, run one enabled scope on it and join it.
+double ThreadStartUs(
+    bool   reset,
+    uint32 numThreads)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    for (uint32 t = 0; t < numThreads; ++t)
+    {
+        std::thread([]() { Instrumented(1); }).join();
+
+        if (reset)
+        {
+            Profiler::Reset();
+        }
+    }
+
+    return ElapsedSeconds(start) * 1e6 / numThreads;
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    const uint32 numCalls   = (argc > 1) ? uint32(atoi(argv[1])) : 1000000;
+    const uint32 numThreads = 200;
+
+    Profiler::Init(numCalls);
+
+    const double none     = BestNsPerCall(&Plain, numCalls);
+    const double disabled = BestNsPerCall(&Instrumented, numCalls);
+
+    Profiler::SetEnabled(true);
+    const double enabled = BestNsPerCall(&Instrumented, numCalls);
+
+    Profiler::SetEnabled(false);
+    Profiler::Destroy();
+
+    // Each thread phase gets its own session with the default buffer size.
+    Profiler::Init();
+    Profiler::SetEnabled(true);
+    const double freshUs = ThreadStartUs(false, numThreads);
+    Profiler::SetEnabled(false);
+    Profiler::Destroy();
+
+    Profiler::Init();
+    Profiler::SetEnabled(true);
+    const double recycledUs = ThreadStartUs(true, numThreads);
+    Profiler::SetEnabled(false);
+    Profiler::Destroy();
+
+    printf("no instrumentation   %8.2f ns/call\n", none);
+    printf("disabled             %8.2f ns/call\n", disabled);
+    printf("enabled              %8.2f ns/call\n", enabled);
+    printf("new thread, fresh    %8.2f us\n", freshUs);
+    printf("new thread, recycled %8.2f us\n", recycledUs);
+
+    return 0;
+}
@@ -0,0 +1,294 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palProfilerTest.cpp
+ * @brief Tests for Profiler and PAL_PROFILE_SCOPE.
+ *
+ * - Nothing is recorded while the profiler is disabled.
+ * - Nested scopes record one event each, innermost first, with their depth and with tick ranges that nest.
+ * - Events land in the buffer of the thread that ran them, each thread under its own index, and are aggregated
+ *   across threads by GetZoneStats().
+ * - A full buffer drops and counts events; Reset() clears events and drop counts.
+ * - Buffers of threads which exit keep their events until Reset(), then are reused by the next threads, so thread
+ *   churn does not grow the profiler.
+ *
+ * The trace is written to palProfilerTest.json in the current directory.  The threaded parts are meant to be run under
+ * ThreadSanitizer as well (PAL_UTIL_TESTS_TSAN).
+ *
+ * Usage: palProfilerTest
+ ***********************************************************************************************************************
+ */
+
+#include "palUtilTest.h"
+#include "palProfiler.h"
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Util;
+using namespace Util::Test;
+
+namespace
+{
+
+// =====================================================================================================================
+// Busy-waits so that zones have durations well above the timer resolution.
+void Spin(
+    uint32 microseconds)
+{
+    const auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < std::chrono::microseconds(microseconds))
+    {
+    }
+}
+
+// =====================================================================================================================
+void Leaf()
+{
+    PAL_PROFILE_SCOPE("leaf");
+    Spin(20);
+}
+
+// =====================================================================================================================
+// Records leaf, leaf, leaf, mid, outer, in that order.
+void Outer()
+{
+    PAL_PROFILE_SCOPE("outer");
+    Spin(10);
+    Leaf();
+    {
+        PAL_PROFILE_SCOPE("mid");
+        Leaf();
+        Leaf();
+    }
+}
+
+// =====================================================================================================================
+void TestNesting()
+{
+    PAL_TEST_CHECK(Profiler::Init(0) == Result::ErrorInvalidValue);
+    PAL_TEST_CHECK(Profiler::Init(1000) == Result::Success);
+    PAL_TEST_CHECK(Profiler::Init(1000) == Result::ErrorInvalidValue);
+
+    Outer();
+    PAL_TEST_CHECK(Profiler::GetZoneStats(nullptr, 0) == 0);
+
+    Profiler::SetEnabled(true);
+    Outer();
+
+    Profiler::ThreadBuffer*const pBuffer = Profiler::GetThreadBuffer();
+    PAL_TEST_CHECK(pBuffer->numEvents.load() == 5);
+
+    const char*const  pNames[] = { "leaf", "leaf", "leaf", "mid", "outer" };
+    const uint32      depths[] = { 1,      2,      2,      1,     0       };
+    const Profiler::Event* pEvents = pBuffer->Events();
+    for (uint32 i = 0; i < 5; ++i)
+    {
+        PAL_TEST_CHECK(strcmp(pEvents[i].pZone->pName, pNames[i]) == 0);
+        PAL_TEST_CHECK(pEvents[i].depth == depths[i]);
+        PAL_TEST_CHECK(pEvents[i].beginTicks <= pEvents[i].endTicks);
+    }
+
+    // outer contains the first leaf and mid; mid contains the other two leaves.
+    PAL_TEST_CHECK((pEvents[4].beginTicks <= pEvents[0].beginTicks) && (pEvents[0].endTicks <= pEvents[3].beginTicks));
+    PAL_TEST_CHECK(pEvents[3].endTicks <= pEvents[4].endTicks);
+    PAL_TEST_CHECK((pEvents[3].beginTicks <= pEvents[1].beginTicks) && (pEvents[1].endTicks <= pEvents[2].beginTicks));
+    PAL_TEST_CHECK(pEvents[2].endTicks <= pEvents[3].endTicks);
+    PAL_TEST_CHECK(pBuffer->depth == 0);
+}
+
+// =====================================================================================================================
+void TestThreads()
+{
+    constexpr uint32 NumThreads = 4;
+
+    Profiler::SetThreadName("main \"thread\"");
+
+    std::vector<std::thread> threads;
+    std::vector<uint32>      indices(NumThreads);
+    const uint32             mainIndex = Profiler::GetThreadBuffer()->threadIndex;
+
+    for (uint32 t = 0; t < NumThreads; ++t)
+    {
+        threads.emplace_back([t, &indices]()
+        {
+            for (uint32 i = 0; i <= t; ++i)
+            {
+                Leaf();
+            }
+
+            Profiler::ThreadBuffer*const pBuffer = Profiler::GetThreadBuffer();
+            PAL_TEST_CHECK(pBuffer->numEvents.load() == t + 1);
+            for (uint32 i = 0; i <= t; ++i)
+            {
+                PAL_TEST_CHECK(pBuffer->Events()[i].depth == 0);
+            }
+            indices[t] = pBuffer->threadIndex;
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (uint32 t = 0; t < NumThreads; ++t)
+    {
+        PAL_TEST_CHECK(indices[t] != mainIndex);
+        for (uint32 u = 0; u < t; ++u)
+        {
+            PAL_TEST_CHECK(indices[t] != indices[u]);
+        }
+    }
+
+    // The exited threads' events are still reported: 3 leaves from TestNesting plus 1 + 2 + 3 + 4.
+    ProfileZoneStats stats[8] = {};
+    const uint32     numZones = Profiler::GetZoneStats(stats, 8);
+    PAL_TEST_CHECK(numZones == 3);
+    for (uint32 i = 0; i < numZones; ++i)
+    {
+        PAL_TEST_CHECK((stats[i].minNs <= stats[i].p50Ns) && (stats[i].p50Ns <= stats[i].p99Ns));
+        PAL_TEST_CHECK(stats[i].p99Ns <= stats[i].maxNs);
+        PAL_TEST_CHECK((i == 0) || (stats[i - 1].totalNs >= stats[i].totalNs));
+    }
+    PAL_TEST_CHECK((strcmp(stats[0].pZone->pName, "leaf") == 0) && (stats[0].count == 13));
+    // Each leaf spins for 20 us.  The tick rate is calibrated over a few ms, so leave room for a preempted calibration.
+    PAL_TEST_CHECK(stats[0].minNs >= 10000);
+    PAL_TEST_CHECK(Profiler::GetZoneStats(stats, 1) == 3);
+
+    PAL_TEST_CHECK(Profiler::ExportChromeTrace("palProfilerTest.json") == Result::Success);
+
+    std::ifstream     file("palProfilerTest.json");
+    std::stringstream text;
+    text << file.rdbuf();
+    PAL_TEST_CHECK(text.str().find("\"main \\\"thread\\\"\"") != std::string::npos);
+
+    size_t numLeaves = 0;
+    for (size_t pos = text.str().find("\"leaf\""); pos != std::string::npos; pos = text.str().find("\"leaf\"", pos + 1))
+    {
+        numLeaves++;
+    }
+    PAL_TEST_CHECK(numLeaves == 13);
+}
+
+// =====================================================================================================================
+void TestDrops()
+{
+    // The buffer holds 1000 events and TestNesting left 5 in it.
+    for (uint32 i = 0; i < 1200; ++i)
+    {
+        PAL_PROFILE_SCOPE("many");
+    }
+    PAL_TEST_CHECK(Profiler::NumDropped() == 1200 - (1000 - 5));
+
+    Profiler::Reset();
+    PAL_TEST_CHECK(Profiler::NumDropped() == 0);
+    PAL_TEST_CHECK(Profiler::GetZoneStats(nullptr, 0) == 0);
+}
+
+// =====================================================================================================================
+void TestThreadChurn()
+{
+    constexpr uint32 NumWaves       = 50;
+    constexpr uint32 ThreadsPerWave = 4;
+
+    std::set<const Profiler::ThreadBuffer*> buffers;
+    std::set<uint32>                        indices;
+    std::vector<const Profiler::ThreadBuffer*> waveBuffers(ThreadsPerWave);
+    std::vector<uint32>                        waveIndices(ThreadsPerWave);
+
+    for (uint32 wave = 0; wave < NumWaves; ++wave)
+    {
+        std::vector<std::thread> threads;
+        for (uint32 t = 0; t < ThreadsPerWave; ++t)
+        {
+            threads.emplace_back([t, &waveBuffers, &waveIndices]()
+            {
+                Leaf();
+                waveBuffers[t] = Profiler::GetThreadBuffer();
+                waveIndices[t] = Profiler::GetThreadBuffer()->threadIndex;
+            });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        buffers.insert(waveBuffers.begin(), waveBuffers.end());
+        indices.insert(waveIndices.begin(), waveIndices.end());
+
+        // Until the events are discarded the buffers of exited threads are kept.
+        if ((wave % 2) == 0)
+        {
+            PAL_TEST_CHECK(Profiler::GetZoneStats(nullptr, 0) == 1);
+        }
+        else
+        {
+            ProfileZoneStats stats = {};
+            PAL_TEST_CHECK(Profiler::GetZoneStats(&stats, 1) == 1);
+            PAL_TEST_CHECK(stats.count == 2 * ThreadsPerWave);
+            Profiler::Reset();
+        }
+    }
+
+    // At most two waves' worth of buffers, but every thread is told apart in reports.
+    PAL_TEST_CHECK(buffers.size() <= 2 * ThreadsPerWave);
+    PAL_TEST_CHECK(indices.size() == NumWaves * ThreadsPerWave);
+
+    Profiler::SetEnabled(false);
+    Profiler::Destroy();
+
+    // A second session starts with fresh buffers of the new capacity.
+    PAL_TEST_CHECK(Profiler::Init(10) == Result::Success);
+    Profiler::SetEnabled(true);
+    Leaf();
+    PAL_TEST_CHECK(Profiler::GetThreadBuffer()->numEvents.load() == 1);
+    PAL_TEST_CHECK(Profiler::GetThreadBuffer()->capacity == 10);
+
+    std::thread([]() { Leaf(); }).join();
+    PAL_TEST_CHECK(Profiler::GetZoneStats(nullptr, 0) == 1);
+
+    Profiler::SetEnabled(false);
+    Profiler::Destroy();
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    TestNesting();
+    TestThreads();
+    TestDrops();
+    TestThreadChurn();
+
+    return Finish("palProfilerTest");
+}
@@ -0,0 +1,206 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palScratchArenaBench.cpp
+ * @brief Cost of a function's temporaries taken from a ScratchArena against one AutoBuffer per temporary.
+ *
+ * Each call needs six temporary arrays of mixed types.  The sizes are drawn up front: most fit in the AutoBuffers'
+ * inline capacity, and a given percentage are oversized (100..2099 elements) so they spill to the heap.  Columns, in
+ * ns per call and heap allocations per call:
+ *
+ * - AutoBuffers:  six AutoBuffers with 128..256 bytes of inline storage each, the pattern this replaces.
+ * - local arena:  one ScratchArena<4096> on the stack, released at the end of the call.
+ * - kept arena:   one ScratchArena<4096> kept across calls and rewound by a ScratchArenaAuto, as ThreadScratchArena()
+ *                 is used.  It counts heap allocations the same way the other two columns do.
+ * - thread arena: ThreadScratchArena() itself, timing only.
+ *
+ * Best of seven runs.
+ *
+ * Usage: palScratchArenaBench [calls per run]
+ ***********************************************************************************************************************
+ */
+
+#include "palUtilTest.h"
+#include "palAutoBuffer.h"
+#include "palScratchArena.h"
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace Util;
+using namespace Util::Test;
+
+namespace
+{
+
+constexpr uint32 NumTemps = 6;
+
+volatile uint64   g_sink = 0;
+CountingAllocator g_allocator;
+
+// =====================================================================================================================
+// Writes the first and last element so the temporary is really used, and makes the compiler assume its memory is read.
+template <typename T>
+uint64 Touch(
+    T*     pData,
+    uint32 count)
+{
+    uint64 sum = 0;
+    if (count > 0)
+    {
+        pData[0]         = T(1);
+        pData[count - 1] = T(count);
+#if defined(__GNUC__)
+        __asm__ volatile("" : : "r"(pData) : "memory");
+#endif
+        sum = uint64(pData[0]) + uint64(pData[count - 1]);
+    }
+    return sum;
+}
+
+// =====================================================================================================================
+[[gnu::noinline]] uint64 WithAutoBuffers(
+    const uint32* pSizes)
+{
+    AutoBuffer<uint32, 64,  CountingAllocator> a(pSizes[0], &g_allocator);
+    AutoBuffer<float,  64,  CountingAllocator> b(pSizes[1], &g_allocator);
+    AutoBuffer<uint64, 32,  CountingAllocator> c(pSizes[2], &g_allocator);
+    AutoBuffer<uint16, 128, CountingAllocator> d(pSizes[3], &g_allocator);
+    AutoBuffer<uint32, 64,  CountingAllocator> e(pSizes[4], &g_allocator);
+    AutoBuffer<uint8,  256, CountingAllocator> f(pSizes[5], &g_allocator);
+
+    return Touch(a.Data(), pSizes[0]) + Touch(b.Data(), pSizes[1]) + Touch(c.Data(), pSizes[2]) +
+           Touch(d.Data(), pSizes[3]) + Touch(e.Data(), pSizes[4]) + Touch(f.Data(), pSizes[5]);
+}
+
+// =====================================================================================================================
+// The same six temporaries, taken from pArena and released when the function returns.
+template <typename Arena>
+uint64 WithArena(
+    Arena*        pArena,
+    const uint32* pSizes)
+{
+    ScratchArenaAuto<Arena> scratch(pArena);
+
+    uint32* pA = scratch.template AllocArray<uint32>(pSizes[0]);
+    float*  pB = scratch.template AllocArray<float>(pSizes[1]);
+    uint64* pC = scratch.template AllocArray<uint64>(pSizes[2]);
+    uint16* pD = scratch.template AllocArray<uint16>(pSizes[3]);
+    uint32* pE = scratch.template AllocArray<uint32>(pSizes[4]);
+    uint8*  pF = scratch.template AllocArray<uint8>(pSizes[5]);
+
+    return Touch(pA, pSizes[0]) + Touch(pB, pSizes[1]) + Touch(pC, pSizes[2]) +
+           Touch(pD, pSizes[3]) + Touch(pE, pSizes[4]) + Touch(pF, pSizes[5]);
+}
+
+// =====================================================================================================================
+[[gnu::noinline]] uint64 WithLocalArena(
+    const uint32* pSizes)
+{
+    ScratchArena<4096, CountingAllocator> arena(&g_allocator);
+    return WithArena(&arena, pSizes);
+}
+
+// =====================================================================================================================
+[[gnu::noinline]] uint64 WithKeptArena(
+    const uint32* pSizes)
+{
+    static ScratchArena<ThreadScratchArenaBytes, CountingAllocator> arena(&g_allocator);
+    return WithArena(&arena, pSizes);
+}
+
+// =====================================================================================================================
+[[gnu::noinline]] uint64 WithThreadArena(
+    const uint32* pSizes)
+{
+    return WithArena(ThreadScratchArena(), pSizes);
+}
+
+// =====================================================================================================================
+// Runs numCalls calls of pfnCall, each on the next set of sizes, seven times.
+// @returns The best ns per call; pAllocsPerCall receives the heap allocations per call.
+double BestNsPerCall(
+    uint32                     numCalls,
+    const std::vector<uint32>& sizes,
+    uint64                     (*pfnCall)(const uint32*),
+    double*                    pAllocsPerCall)
+{
+    const uint32 numSets = uint32(sizes.size() / NumTemps);
+    const uint32 allocs  = g_allocator.Allocs();
+    double       best    = 1e30;
+
+    for (uint32 rep = 0; rep < 7; ++rep)
+    {
+        uint64     sum   = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32 i = 0; i < numCalls; ++i)
+        {
+            sum += pfnCall(&sizes[(i % numSets) * NumTemps]);
+        }
+        best   = Min(best, ElapsedSeconds(start) * 1e9 / numCalls);
+        g_sink = sum;
+    }
+    *pAllocsPerCall = double(g_allocator.Allocs() - allocs) / (7.0 * numCalls);
+
+    return best;
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    const uint32 numCalls = (argc > 1) ? uint32(atoi(argv[1])) : 1000000;
+
+    printf("oversized |   AutoBuffers  |  local arena   |   kept arena   | thread arena\n");
+    printf("          |     ns  allocs |     ns  allocs |     ns  allocs |     ns         (per call)\n");
+
+    for (uint32 percent : { 0, 1, 10, 30 })
+    {
+        std::mt19937        random(9);
+        std::vector<uint32> sizes(NumTemps * 100000);
+        for (uint32& size : sizes)
+        {
+            size = ((random() % 100) < percent) ? (100 + random() % 2000) : (random() % 32);
+        }
+
+        double autoAllocs  = 0;
+        double localAllocs = 0;
+        double keptAllocs  = 0;
+        double threadAllocs = 0;
+        const double autoNs   = BestNsPerCall(numCalls, sizes, WithAutoBuffers, &autoAllocs);
+        const double localNs  = BestNsPerCall(numCalls, sizes, WithLocalArena,  &localAllocs);
+        const double keptNs   = BestNsPerCall(numCalls, sizes, WithKeptArena,   &keptAllocs);
+        const double threadNs = BestNsPerCall(numCalls, sizes, WithThreadArena, &threadAllocs);
+
+        printf("%8u%% | %6.1f %7.3f | %6.1f %7.3f | %6.1f %7.3f | %6.1f\n",
+               percent, autoNs, autoAllocs, localNs, localAllocs, keptNs, keptAllocs, threadNs);
+    }
+
+    return 0;
+}
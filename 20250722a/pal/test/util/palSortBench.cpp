@@ -0,0 +1,198 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palSortBench.cpp
+ * @brief Sort, StableSort and RadixSort against the qsort-based Sort they replace and the standard library.
+ *
+ * Rows are uint32 arrays of each size, random or already sorted, and 16-byte key/value structs with 1000 distinct keys
+ * for the stable sorts.  Columns, in ns per element:
+ *
+ * - qsort:  qsort() with SortComparisonFunc, which is what Sort() used to be.
+ * - Sort:   Sort() with operator<.
+ * - std:    std::sort, or std::stable_sort for the stable rows.
+ * - Stable: StableSort().
+ * - Radix:  RadixSort() (uint32 rows only).
+ *
+ * Best of five runs; every run re-copies the unsorted input outside the timed region.
+ *
+ * Usage: palSortBench [elements sorted per run]
+ ***********************************************************************************************************************
+ */
+
+#include "palUtilTest.h"
+#include "palInlineFuncs.h"
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace Util;
+using namespace Util::Test;
+
+namespace
+{
+
+volatile uint64 g_sink = 0;
+
+struct KeyValue
+{
+    uint64 key;
+    uint64 value;
+
+    bool operator<(const KeyValue& other) const { return (key < other.key); }
+};
+
+// =====================================================================================================================
+// Sorts copies of input until about elementsPerRun elements have been sorted, five times.
+// @returns The best ns per element.
+template <typename T, typename SortFunc>
+double BestNsPerElement(
+    const std::vector<T>& input,
+    size_t                elementsPerRun,
+    SortFunc              sortFunc)
+{
+    const size_t   numSorts = Max<size_t>(elementsPerRun / input.size(), 1);
+    std::vector<T> work(input.size());
+    double         best     = 1e30;
+
+    for (uint32 rep = 0; rep < 5; ++rep)
+    {
+        double seconds = 0;
+        for (size_t i = 0; i < numSorts; ++i)
+        {
+            std::copy(input.begin(), input.end(), work.begin());
+
+            const auto start = std::chrono::steady_clock::now();
+            sortFunc(work.data(), work.data() + work.size());
+            seconds += ElapsedSeconds(start);
+        }
+        best   = Min(best, seconds * 1e9 / double(numSorts * input.size()));
+        g_sink = uint64(work[work.size() / 2] < work[0]);
+    }
+
+    return best;
+}
+
+// =====================================================================================================================
+void RunUint32(
+    const char*                pName,
+    const std::vector<uint32>& input,
+    size_t                     elementsPerRun)
+{
+    std::vector<uint32> scratch(input.size());
+
+    const double qsortNs = BestNsPerElement(input, elementsPerRun, [](uint32* pStart, uint32* pEnd)
+    {
+        qsort(pStart, size_t(pEnd - pStart), sizeof(uint32), SortComparisonFunc<uint32>);
+    });
+    const double sortNs   = BestNsPerElement(input, elementsPerRun, [](uint32* pStart, uint32* pEnd)
+    {
+        Sort(pStart, pEnd);
+    });
+    const double stdNs    = BestNsPerElement(input, elementsPerRun, [](uint32* pStart, uint32* pEnd)
+    {
+        std::sort(pStart, pEnd);
+    });
+    const double stableNs = BestNsPerElement(input, elementsPerRun, [](uint32* pStart, uint32* pEnd)
+    {
+        StableSort(pStart, pEnd);
+    });
+    const double radixNs  = BestNsPerElement(input, elementsPerRun, [&scratch](uint32* pStart, uint32* pEnd)
+    {
+        RadixSort(pStart, pEnd, scratch.data());
+    });
+
+    printf("%-24s %8zu | %6.1f %6.1f %6.1f %6.1f %6.1f\n",
+           pName, input.size(), qsortNs, sortNs, stdNs, stableNs, radixNs);
+}
+
+// =====================================================================================================================
+void RunKeyValue(
+    const std::vector<KeyValue>& input,
+    size_t                       elementsPerRun)
+{
+    const double qsortNs  = BestNsPerElement(input, elementsPerRun, [](KeyValue* pStart, KeyValue* pEnd)
+    {
+        qsort(pStart, size_t(pEnd - pStart), sizeof(KeyValue), SortComparisonFunc<KeyValue>);
+    });
+    const double sortNs   = BestNsPerElement(input, elementsPerRun, [](KeyValue* pStart, KeyValue* pEnd)
+    {
+        Sort(pStart, pEnd);
+    });
+    const double stdNs    = BestNsPerElement(input, elementsPerRun, [](KeyValue* pStart, KeyValue* pEnd)
+    {
+        std::stable_sort(pStart, pEnd);
+    });
+    const double stableNs = BestNsPerElement(input, elementsPerRun, [](KeyValue* pStart, KeyValue* pEnd)
+    {
+        StableSort(pStart, pEnd);
+    });
+
+    printf("%-24s %8zu | %6.1f %6.1f %6.1f %6.1f      -\n",
+           "key/value, 1000 keys", input.size(), qsortNs, sortNs, stdNs, stableNs);
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    const size_t elementsPerRun = (argc > 1) ? size_t(atoll(argv[1])) : 2000000;
+
+    std::mt19937 random(1);
+
+    printf("                                  |  qsort   Sort    std Stable  Radix   (ns/element)\n");
+
+    for (size_t count : { size_t(16), size_t(100), size_t(10000), size_t(1000000) })
+    {
+        std::vector<uint32> keys(count);
+        for (uint32& key : keys)
+        {
+            key = uint32(random());
+        }
+        RunUint32("uint32, random", keys, elementsPerRun);
+
+        if (count == 1000000)
+        {
+            std::sort(keys.begin(), keys.end());
+            RunUint32("uint32, sorted", keys, elementsPerRun);
+        }
+    }
+
+    for (size_t count : { size_t(10000), size_t(1000000) })
+    {
+        std::vector<KeyValue> pairs(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            pairs[i] = KeyValue{ random() % 1000, i };
+        }
+        RunKeyValue(pairs, elementsPerRun);
+    }
+
+    return 0;
+}
@@ -0,0 +1,252 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palSortTest.cpp
+ * @brief Tests for Sort, StableSort and RadixSort against std::sort and std::stable_sort.
+ *
+ * Each is run over sizes around the insertion sort threshold and up to 100000 elements, on random, sorted, reversed,
+ * constant, few-unique, organ-pipe and sawtooth inputs:
+ *
+ * - Sort must order the elements and keep them a permutation of the input within an O(n log n) comparison budget.
+ * - StableSort must match std::stable_sort exactly.
+ * - RadixSort must match std::sort for every integer width, signed and unsigned, including the extreme values.
+ *
+ * Usage: palSortTest
+ ***********************************************************************************************************************
+ */
+
+#include "palUtilTest.h"
+#include "palInlineFuncs.h"
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace Util;
+using namespace Util::Test;
+
+namespace
+{
+
+// A key with a payload recording the original position, so stability and lost or duplicated elements show.
+struct KeyValue
+{
+    uint32 key;
+    uint32 value;
+
+    bool operator<(const KeyValue& other) const { return (key < other.key); }
+    bool operator==(const KeyValue& other) const { return (key == other.key) && (value == other.value); }
+};
+
+enum class Pattern : uint32
+{
+    Random,
+    Sorted,
+    Reversed,
+    Constant,
+    FewUnique,
+    OrganPipe,
+    Sawtooth,
+    Count
+};
+
+constexpr size_t Sizes[] = { 0, 1, 2, 3, 15, 16, 17, 33, 100, 1000, 4097, 100000 };
+
+// =====================================================================================================================
+// @returns Keys of the given size and pattern.
+std::vector<uint32> MakeKeys(
+    Pattern       pattern,
+    size_t        count,
+    std::mt19937* pRandom)
+{
+    std::vector<uint32> keys(count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        switch (pattern)
+        {
+        case Pattern::Random:    keys[i] = uint32((*pRandom)());                                  break;
+        case Pattern::Sorted:    keys[i] = uint32(i);                                             break;
+        case Pattern::Reversed:  keys[i] = uint32(count - i);                                     break;
+        case Pattern::Constant:  keys[i] = 7;                                                     break;
+        case Pattern::FewUnique: keys[i] = uint32((*pRandom)() % 4);                              break;
+        case Pattern::OrganPipe: keys[i] = uint32((i < (count / 2)) ? i : (count - i));           break;
+        case Pattern::Sawtooth:  keys[i] = uint32(i % 64);                                        break;
+        default:                 PAL_TEST_CHECK(false);                                           break;
+        }
+    }
+
+    return keys;
+}
+
+// =====================================================================================================================
+// Sort with operator< and with comparators, on plain keys and on key/value pairs.
+void TestSort(
+    const std::vector<uint32>& keys)
+{
+    const size_t count = keys.size();
+
+    std::vector<uint32> expected = keys;
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<uint32> sorted = keys;
+    Sort(sorted.data(), sorted.data() + count);
+    PAL_TEST_CHECK(sorted == expected);
+
+    // A comparator reversing the order, through non-pointer iterators.
+    std::vector<uint32> descending = keys;
+    Sort(descending.begin(), descending.end(), [](uint32 lhs, uint32 rhs) { return (lhs > rhs); });
+    PAL_TEST_CHECK(std::equal(descending.begin(), descending.end(), expected.rbegin()));
+
+    // Ties between key/value pairs may end up in any order, but every pair must still be there.  The comparator counts
+    // its calls, which introsort bounds at O(n log n) on every input.
+    std::vector<KeyValue> pairs(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        pairs[i] = KeyValue{ keys[i], uint32(i) };
+    }
+    uint64 numCompares = 0;
+    Sort(pairs.data(), pairs.data() + count, [&numCompares](const KeyValue& lhs, const KeyValue& rhs)
+    {
+        ++numCompares;
+        return (lhs.key < rhs.key);
+    });
+
+    bool isSorted = true;
+    for (size_t i = 1; i < count; ++i)
+    {
+        isSorted &= ((pairs[i].key < pairs[i - 1].key) == false);
+    }
+    PAL_TEST_CHECK(isSorted);
+
+    std::vector<bool> seen(count, false);
+    bool              isPermutation = true;
+    for (const KeyValue& pair : pairs)
+    {
+        isPermutation &= (pair.value < count) && (seen[pair.value] == false) && (keys[pair.value] == pair.key);
+        if (pair.value < count)
+        {
+            seen[pair.value] = true;
+        }
+    }
+    PAL_TEST_CHECK(isPermutation);
+
+    const double bound = 8.0 * double(count) * double(Log2(uint64(Max<size_t>(count, 2)))) + 64.0;
+    PAL_TEST_CHECK(double(numCompares) <= bound);
+}
+
+// =====================================================================================================================
+void TestStableSort(
+    const std::vector<uint32>& keys)
+{
+    const size_t count = keys.size();
+
+    std::vector<KeyValue> pairs(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        pairs[i] = KeyValue{ keys[i], uint32(i) };
+    }
+
+    std::vector<KeyValue> expected = pairs;
+    std::stable_sort(expected.begin(), expected.end());
+
+    std::vector<KeyValue> sorted = pairs;
+    StableSort(sorted.data(), sorted.data() + count);
+    PAL_TEST_CHECK(sorted == expected);
+
+    // A comparator on the key's low byte only, so there are many ties even in random input.
+    const auto lowByte = [](const KeyValue& lhs, const KeyValue& rhs) { return ((lhs.key & 0xFF) < (rhs.key & 0xFF)); };
+
+    expected = pairs;
+    std::stable_sort(expected.begin(), expected.end(), lowByte);
+
+    sorted = pairs;
+    StableSort(sorted.begin(), sorted.end(), lowByte);
+    PAL_TEST_CHECK(sorted == expected);
+}
+
+// =====================================================================================================================
+template <typename T>
+void TestRadixSort(
+    const std::vector<uint32>& keys,
+    std::mt19937*              pRandom)
+{
+    const size_t   count = keys.size();
+    std::vector<T> values(count);
+    std::vector<T> scratch(count);
+
+    // Spread the keys over the whole range of T, and plant its extremes.
+    for (size_t i = 0; i < count; ++i)
+    {
+        const uint64 wide = (uint64(keys[i]) << 32) | ((*pRandom)() & 0xFFFFFFFF);
+        values[i] = (sizeof(T) == 8) ? T(wide) : T(keys[i] * 2654435761u);
+    }
+    if (count >= 4)
+    {
+        values[0]         = std::numeric_limits<T>::max();
+        values[count / 3] = std::numeric_limits<T>::min();
+        values[count / 2] = T(0);
+        values[count - 1] = T(-1);
+    }
+
+    std::vector<T> expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    RadixSort(values.data(), values.data() + count, scratch.data());
+    PAL_TEST_CHECK(values == expected);
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    std::mt19937 random(7);
+
+    for (uint32 pattern = 0; pattern < uint32(Pattern::Count); ++pattern)
+    {
+        for (size_t count : Sizes)
+        {
+            const std::vector<uint32> keys = MakeKeys(Pattern(pattern), count, &random);
+
+            TestSort(keys);
+            TestStableSort(keys);
+
+            TestRadixSort<uint8>(keys, &random);
+            TestRadixSort<int8>(keys, &random);
+            TestRadixSort<uint16>(keys, &random);
+            TestRadixSort<int16>(keys, &random);
+            TestRadixSort<uint32>(keys, &random);
+            TestRadixSort<int32>(keys, &random);
+            TestRadixSort<uint64>(keys, &random);
+            TestRadixSort<int64>(keys, &random);
+        }
+    }
+
+    return Finish("palSortTest");
+}
@@ -0,0 +1,165 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palStringViewBench.cpp
+ * @brief StringView<char> search functions against the C library functions doing the same job.
+ *
+ * For each haystack length, in ns per call, with the match (if any) at the end of the haystack:
+ *
+ * - Find(char) against memchr, and RFind(char) against memrchr (glibc only).
+ * - Find(StringView) against strstr, and memmem (glibc only).
+ * - FindFirstOf against strcspn.
+ * - EqualsIgnoreCase against strncasecmp (_strnicmp on Windows), on strings that differ only in case.
+ *
+ * strstr and strcspn stop at a terminator instead of taking a length, which is the reason StringView exists, but they
+ * are the nearest libc equivalents.  Best of seven runs.
+ *
+ * Usage: palStringViewBench [calls per run]
+ ***********************************************************************************************************************
+ */
+
+#include "palUtilTest.h"
+#include "palStringView.h"
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#if !defined(_WIN32)
+#include <strings.h>
+#endif
+
+using namespace Util;
+using namespace Util::Test;
+
+namespace
+{
+
+volatile uint64 g_sink = 0;
+
+// =====================================================================================================================
+// @returns The best ns per call of work over seven runs.
+template <typename Work>
+double BestNsPerCall(
+    uint32 numCalls,
+    Work   work)
+{
+    double best = 1e30;
+
+    for (uint32 rep = 0; rep < 7; ++rep)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32 i = 0; i < numCalls; ++i)
+        {
+            g_sink = g_sink + uint64(work());
+        }
+        best = Min(best, ElapsedSeconds(start) * 1e9 / numCalls);
+    }
+
+    return best;
+}
+
+// =====================================================================================================================
+int CompareIgnoreCase(
+    const char* pA,
+    const char* pB,
+    size_t      length)
+{
+#if defined(_WIN32)
+    return _strnicmp(pA, pB, length);
+#else
+    return strncasecmp(pA, pB, length);
+#endif
+}
+
+// =====================================================================================================================
+void Run(
+    uint32 length,
+    uint32 numCalls)
+{
+    // Lowercase text without '#', ';', '!' or 'Q', ending in the needle "#QZ".
+    std::string text(length, 'x');
+    for (uint32 i = 0; i < length; ++i)
+    {
+        text[i] = "abcdefghijklmnop"[(i * 7) % 16];
+    }
+    text.replace(length - 3, 3, "#QZ");
+
+    std::string upper = text;
+    for (char& c : upper)
+    {
+        c = char(toupper(static_cast<unsigned char>(c)));
+    }
+
+    const char*const       pText = text.c_str();
+    const StringView<char> view(pText, length);
+    const StringView<char> upperView(upper.c_str(), length);
+    const StringView<char> needle("#QZ");
+    const StringView<char> set(";#!");
+
+    printf("%5u chars              StringView       libc\n", length);
+    printf("  Find(char)      %10.1f %10.1f  memchr\n",
+           BestNsPerCall(numCalls, [&]() { return view.Find('#'); }),
+           BestNsPerCall(numCalls, [&]() { return uintptr_t(memchr(pText, '#', length)); }));
+#if defined(__GLIBC__)
+    printf("  RFind(char)     %10.1f %10.1f  memrchr\n",
+           BestNsPerCall(numCalls, [&]() { return view.RFind('a'); }),
+           BestNsPerCall(numCalls, [&]() { return uintptr_t(memrchr(pText, 'a', length)); }));
+#endif
+    printf("  Find(view)      %10.1f %10.1f  strstr\n",
+           BestNsPerCall(numCalls, [&]() { return view.Find(needle); }),
+           BestNsPerCall(numCalls, [&]() { return uintptr_t(strstr(pText, "#QZ")); }));
+#if defined(__GLIBC__)
+    printf("                  %10s %10.1f  memmem\n", "",
+           BestNsPerCall(numCalls, [&]() { return uintptr_t(memmem(pText, length, "#QZ", 3)); }));
+#endif
+    printf("  FindFirstOf     %10.1f %10.1f  strcspn\n",
+           BestNsPerCall(numCalls, [&]() { return view.FindFirstOf(set); }),
+           BestNsPerCall(numCalls, [&]() { return strcspn(pText, ";#!"); }));
+    printf("  EqualsIgnoreCase%10.1f %10.1f  strncasecmp\n",
+           BestNsPerCall(numCalls, [&]() { return view.EqualsIgnoreCase(upperView); }),
+           BestNsPerCall(numCalls, [&]() { return CompareIgnoreCase(pText, upper.c_str(), length); }));
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    const uint32 numCalls = (argc > 1) ? uint32(atoi(argv[1])) : 200000;
+
+#if PAL_SIMD_X86
+    printf("AVX2 %s\n", CpuSupportsAvx2() ? "available" : "not available");
+#endif
+
+    Run(16, numCalls);
+    Run(64, numCalls);
+    Run(256, numCalls);
+    Run(4096, numCalls / 20);
+
+    return 0;
+}
@@ -0,0 +1,336 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palStringViewTest.cpp
+ * @brief Randomized tests for the StringView search functions and their SIMD kernels.
+ *
+ * - For char and wchar_t, every search, comparison and split must match a scalar reference built on
+ *   std::basic_string, on random strings over small alphabets so that matches, near misses and repeats are common.
+ * - The SSE2 and AVX2 kernels are also called directly, so both are covered whichever one the dispatcher picks here.
+ *
+ * Each haystack is copied to a heap buffer of exactly its length, so reads past the end are caught when the test is
+ * built with AddressSanitizer.
+ *
+ * Usage: palStringViewTest [iterations]
+ ***********************************************************************************************************************
+ */
+
+#include "palUtilTest.h"
+#include "palStringView.h"
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Util;
+using namespace Util::Test;
+
+namespace
+{
+
+std::mt19937 g_random(7);
+
+// =====================================================================================================================
+// Characters are drawn from the first alphabetSize entries: mixed-case letters first, then punctuation, a high-bit
+// character and NUL, which none of the functions may treat specially.
+template<typename CharT>
+std::basic_string<CharT> RandomString(
+    uint32 length,
+    uint32 alphabetSize)
+{
+    static const char Alphabet[] = "aAzZbB@[`{#!,. \x01\xE1";
+
+    std::basic_string<CharT> string(length, CharT(0));
+
+    for (CharT& c : string)
+    {
+        const uint32 index = g_random() % alphabetSize;
+        c = (index < (sizeof(Alphabet) - 1)) ? CharT(static_cast<unsigned char>(Alphabet[index])) : CharT(0);
+    }
+
+    return string;
+}
+
+// =====================================================================================================================
+template<typename CharT>
+uint32 ToIndex(
+    size_t position)
+{
+    return (position == std::basic_string<CharT>::npos) ? StringView<CharT>::NotFound : uint32(position);
+}
+
+// =====================================================================================================================
+template<typename CharT>
+CharT FoldCase(
+    CharT c)
+{
+    return ((c >= 'A') && (c <= 'Z')) ? CharT(c + ('a' - 'A')) : c;
+}
+
+// =====================================================================================================================
+// Owns a copy of a string in a heap buffer of exactly its length.
+template<typename CharT>
+class ExactBuffer
+{
+public:
+    explicit ExactBuffer(const std::basic_string<CharT>& string)
+        :
+        m_pData(static_cast<CharT*>(malloc(Max<size_t>(string.size(), 1) * sizeof(CharT)))),
+        m_length(uint32(string.size()))
+    {
+        memcpy(m_pData, string.data(), string.size() * sizeof(CharT));
+    }
+
+    ~ExactBuffer() { free(m_pData); }
+
+    StringView<CharT> View() const { return StringView<CharT>(m_pData, m_length); }
+
+private:
+    CharT* m_pData;
+    uint32 m_length;
+
+    PAL_DISALLOW_COPY_AND_ASSIGN(ExactBuffer);
+};
+
+// =====================================================================================================================
+template<typename CharT>
+void TestRandom(
+    uint32 numIterations)
+{
+    using String = std::basic_string<CharT>;
+
+    for (uint32 iter = 0; iter < numIterations; ++iter)
+    {
+        // Mostly short strings, which exercise the scalar tails, with some spanning several AVX2 blocks.
+        const uint32 length       = ((iter % 4) == 0) ? (g_random() % 300) : (g_random() % 70);
+        const uint32 alphabetSize = 2 + (g_random() % 16);
+
+        const String            reference = RandomString<CharT>(length, alphabetSize);
+        const ExactBuffer<CharT> haystackBuffer(reference);
+        const StringView<CharT> haystack = haystackBuffer.View();
+
+        const CharT  c     = RandomString<CharT>(1, alphabetSize)[0];
+        const uint32 start = g_random() % (length + 2);
+
+        PAL_TEST_CHECK(haystack.Find(c, start) ==
+                       ((start < length) ? ToIndex<CharT>(reference.find(c, start)) : StringView<CharT>::NotFound));
+        PAL_TEST_CHECK(haystack.RFind(c) == ToIndex<CharT>(reference.rfind(c)));
+
+        // Half the needles are taken from the haystack so that they are found.
+        const uint32 needleLength = ((iter % 10) == 0) ? (g_random() % 40) : (g_random() % 6);
+        const String needleString = ((length > 0) && ((g_random() % 2) == 0))
+                                    ? reference.substr(g_random() % length, needleLength)
+                                    : RandomString<CharT>(needleLength, alphabetSize);
+
+        const ExactBuffer<CharT> needleBuffer(needleString);
+        const StringView<CharT> needle = needleBuffer.View();
+
+        PAL_TEST_CHECK(haystack.Find(needle, start) ==
+                       ((start <= length) ? ToIndex<CharT>(reference.find(needleString, start))
+                                          : StringView<CharT>::NotFound));
+        PAL_TEST_CHECK(haystack.RFind(needle) == ToIndex<CharT>(reference.rfind(needleString)));
+        PAL_TEST_CHECK(haystack.FindFirstOf(needle, start) ==
+                       (((start < length) && (needleString.empty() == false))
+                        ? ToIndex<CharT>(reference.find_first_of(needleString, start))
+                        : StringView<CharT>::NotFound));
+
+        PAL_TEST_CHECK(haystack.StartsWith(needle) == (reference.compare(0, needleString.size(), needleString) == 0));
+        PAL_TEST_CHECK(haystack.EndsWith(needle) ==
+                       ((needleString.size() <= length) &&
+                        (reference.compare(length - needleString.size(), needleString.size(), needleString) == 0)));
+
+        // Flip the case of random letters, and sometimes change one character for real.
+        String other = reference;
+        for (CharT& ch : other)
+        {
+            const bool isLetter = ((ch >= 'a') && (ch <= 'z')) || ((ch >= 'A') && (ch <= 'Z'));
+            if (isLetter && ((g_random() % 2) == 0))
+            {
+                ch = CharT(ch ^ 0x20);
+            }
+        }
+        if ((length > 0) && ((g_random() % 3) == 0))
+        {
+            other[g_random() % length] = RandomString<CharT>(1, alphabetSize)[0];
+        }
+
+        bool equalIgnoringCase = true;
+        for (uint32 i = 0; i < length; ++i)
+        {
+            equalIgnoringCase &= (FoldCase(reference[i]) == FoldCase(other[i]));
+        }
+
+        const ExactBuffer<CharT> otherBuffer(other);
+        PAL_TEST_CHECK(haystack.EqualsIgnoreCase(otherBuffer.View()) == equalIgnoringCase);
+        if (length > 0)
+        {
+            PAL_TEST_CHECK(haystack.EqualsIgnoreCase(StringView<CharT>(otherBuffer.View().Data(), length - 1)) ==
+                           false);
+        }
+
+        std::vector<String> expectedPieces;
+        for (size_t pieceStart = 0; ; )
+        {
+            const size_t pieceEnd = reference.find(c, pieceStart);
+            expectedPieces.push_back(reference.substr(pieceStart, pieceEnd - pieceStart));
+
+            if (pieceEnd == String::npos)
+            {
+                break;
+            }
+            pieceStart = pieceEnd + 1;
+        }
+
+        std::vector<String> pieces;
+        for (StringViewSplitIterator<CharT> it = haystack.Split(c); it.IsValid(); it.Next())
+        {
+            pieces.emplace_back(it.Get().Data(), it.Get().Length());
+        }
+        PAL_TEST_CHECK(pieces == expectedPieces);
+    }
+
+    const StringView<CharT> empty;
+    uint32 numPieces = 0;
+    for (StringViewSplitIterator<CharT> it = empty.Split(CharT(',')); it.IsValid(); it.Next())
+    {
+        PAL_TEST_CHECK(it.Get().IsEmpty());
+        numPieces++;
+    }
+    PAL_TEST_CHECK(numPieces == 1);
+    PAL_TEST_CHECK(empty.Find(CharT('a')) == StringView<CharT>::NotFound);
+    PAL_TEST_CHECK(empty.Find(empty) == 0);
+    PAL_TEST_CHECK(empty.RFind(empty) == 0);
+    PAL_TEST_CHECK(HashString(empty) == HashString(StringView<CharT>()));
+}
+
+#if PAL_SIMD_X86
+// =====================================================================================================================
+// Calls the SSE2 and AVX2 kernels directly.  The partial kernels stop early and report where; a match they return
+// must be the first one, and if they return none there must be none before the position they stopped at.
+void TestKernels(
+    uint32 numIterations)
+{
+    using namespace StringViewKernels;
+
+    const bool hasAvx2 = CpuSupportsAvx2();
+
+    for (uint32 iter = 0; iter < numIterations; ++iter)
+    {
+        const uint32 length       = 1 + (g_random() % 200);
+        const uint32 alphabetSize = 2 + (g_random() % 16);
+
+        const std::string        reference = RandomString<char>(length, alphabetSize);
+        const ExactBuffer<char> buffer(reference);
+        const char*const         pData = buffer.View().Data();
+
+        const char   c   = RandomString<char>(1, alphabetSize)[0];
+        const uint32 pos = g_random() % length;
+
+        PAL_TEST_CHECK(FindCharSse2(pData, length, pos, c) == ToIndex<char>(reference.find(c, pos)));
+        PAL_TEST_CHECK(RFindCharSse2(pData, length, c) == ToIndex<char>(reference.rfind(c)));
+
+        if (hasAvx2 && (length >= 32))
+        {
+            PAL_TEST_CHECK(FindCharAvx2(pData, length, pos, c) == ToIndex<char>(reference.find(c, pos)));
+            PAL_TEST_CHECK(RFindCharAvx2(pData, length, c) == ToIndex<char>(reference.rfind(c)));
+        }
+
+        const uint32      setLength = 1 + (g_random() % 16);
+        const std::string set       = RandomString<char>(setLength, alphabetSize);
+        const uint32      firstOf   = ToIndex<char>(reference.find_first_of(set, pos));
+
+        const std::string needle = reference.substr(g_random() % length, 2 + (g_random() % 6));
+        const uint32      found  = ToIndex<char>(reference.find(needle, pos));
+
+        const auto CheckPartial = [](uint32 result, uint32 stoppedAt, uint32 expected)
+        {
+            PAL_TEST_CHECK((result == NotFound) ? ((expected == NotFound) || (expected >= stoppedAt))
+                                                : (result == expected));
+        };
+
+        uint32 stoppedAt = pos;
+        CheckPartial(FindFirstOfSse2(pData, length, &stoppedAt, set.data(), setLength), stoppedAt, firstOf);
+
+        if (needle.size() >= 2)
+        {
+            stoppedAt = pos;
+            CheckPartial(FindStringSse2(pData, length, &stoppedAt, needle.data(), uint32(needle.size())),
+                         stoppedAt,
+                         found);
+        }
+
+        if (hasAvx2)
+        {
+            stoppedAt = pos;
+            CheckPartial(FindFirstOfAvx2(pData, length, &stoppedAt, set.data(), setLength), stoppedAt, firstOf);
+
+            if (needle.size() >= 2)
+            {
+                stoppedAt = pos;
+                CheckPartial(FindStringAvx2(pData, length, &stoppedAt, needle.data(), uint32(needle.size())),
+                             stoppedAt,
+                             found);
+            }
+        }
+
+        std::string upper = reference;
+        for (char& ch : upper)
+        {
+            ch = ((ch >= 'a') && (ch <= 'z')) ? char(ch - ('a' - 'A')) : ch;
+        }
+        const ExactBuffer<char> upperBuffer(upper);
+
+        uint32 compared = 0;
+        PAL_TEST_CHECK(EqualsIgnoreCaseSse2(pData, upperBuffer.View().Data(), length, &compared));
+        PAL_TEST_CHECK(compared <= length);
+
+        if (hasAvx2)
+        {
+            compared = 0;
+            PAL_TEST_CHECK(EqualsIgnoreCaseAvx2(pData, upperBuffer.View().Data(), length, &compared));
+            PAL_TEST_CHECK(compared <= length);
+        }
+    }
+}
+#endif
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    const uint32 numIterations = (argc > 1) ? uint32(atoi(argv[1])) : 40000;
+
+    TestRandom<char>(numIterations);
+    TestRandom<wchar_t>(numIterations);
+#if PAL_SIMD_X86
+    TestKernels(numIterations);
+#endif
+
+    return Finish("palStringViewTest");
+}
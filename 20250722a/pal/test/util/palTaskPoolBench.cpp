@@ -0,0 +1,186 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palTaskPoolBench.cpp
+ * @brief How ParallelFor, ParallelReduce and ParallelSort scale from one thread to many.
+ *
+ * Three workloads over 4M uint32s:
+ *
+ * - hash:   ParallelFor with 16 rounds of a multiplicative hash per element, 16K elements per chunk (compute bound).
+ * - reduce: ParallelReduce of the sum of squares, 64K elements per chunk (memory bound).
+ * - sort:   ParallelSort of random values.
+ *
+ * Each is timed serially without a pool, then on pools of 1, 2, 4, ... up to the given number of threads.  The speedup
+ * columns are against the 1-thread pool, so they show scaling, not the pool's overhead, which is the first row against
+ * the serial one.  Thread counts above the number of CPUs (printed first) only measure oversubscription.  Best of five
+ * runs.
+ *
+ * Usage: palTaskPoolBench [max threads]
+ ***********************************************************************************************************************
+ */
+
+#include "palUtilTest.h"
+#include "palTaskPool.h"
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace Util;
+using namespace Util::Test;
+
+namespace
+{
+
+constexpr size_t NumElements = size_t(4) << 20;
+
+volatile uint64 g_sink = 0;
+
+// =====================================================================================================================
+// @returns The best ms of work over five runs.
+template <typename Work>
+double BestMs(
+    Work work)
+{
+    double best = 1e30;
+
+    for (uint32 rep = 0; rep < 5; ++rep)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        work();
+        best = Min(best, ElapsedSeconds(start) * 1e3);
+    }
+
+    return best;
+}
+
+// =====================================================================================================================
+// The workloads are kept out of line so the serial and the pooled runs execute the same code.
+[[gnu::noinline]] void Hash(
+    Span<uint32> values)
+{
+    for (uint32& value : values)
+    {
+        uint32 hash = value;
+        for (uint32 i = 0; i < 16; ++i)
+        {
+            hash = (hash * 2654435761u) + 0x9e3779b9u;
+        }
+        value = hash;
+    }
+}
+
+// =====================================================================================================================
+[[gnu::noinline]] uint64 SumOfSquares(
+    Span<const uint32> values)
+{
+    uint64 sum = 0;
+    for (uint32 value : values)
+    {
+        sum += uint64(value) * value;
+    }
+    return sum;
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    const uint32 maxThreads = (argc > 1) ? uint32(atoi(argv[1])) : Max(std::thread::hardware_concurrency(), 1u);
+
+    std::mt19937        random(1);
+    std::vector<uint32> data(NumElements);
+    std::vector<uint32> work(NumElements);
+    for (uint32& value : data)
+    {
+        value = uint32(random());
+    }
+
+    const double serialHash   = BestMs([&work]() { Hash(Span<uint32>(work.data(), NumElements)); });
+    const double serialReduce = BestMs([&data]()
+    {
+        g_sink = SumOfSquares(Span<const uint32>(data.data(), NumElements));
+    });
+    const double serialSort   = BestMs([&data, &work]()
+    {
+        work = data;
+        Sort(work.data(), work.data() + NumElements);
+    });
+
+    printf("CPUs: %u\n", std::thread::hardware_concurrency());
+    printf("         |       hash        |      reduce       |       sort\n");
+    printf("threads  |     ms    speedup |     ms    speedup |     ms    speedup\n");
+    printf("serial   | %7.2f           | %7.2f           | %7.2f\n", serialHash, serialReduce, serialSort);
+
+    GenericAllocator allocator;
+    double           baseHash   = 0;
+    double           baseReduce = 0;
+    double           baseSort   = 0;
+
+    for (uint32 numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+    {
+        TaskPool<GenericAllocator> pool(&allocator);
+        if (pool.Init(TaskPoolCreateInfo{ numThreads, 0 }) != Result::Success)
+        {
+            fprintf(stderr, "TaskPool::Init failed for %u threads\n", numThreads);
+            return 1;
+        }
+
+        const double hash = BestMs([&pool, &work]()
+        {
+            ParallelFor(&pool, Span<uint32>(work.data(), NumElements), 16384, Hash);
+        });
+        const double reduce = BestMs([&pool, &data]()
+        {
+            g_sink = ParallelReduce(&pool,
+                                    Span<const uint32>(data.data(), NumElements),
+                                    65536,
+                                    uint64(0),
+                                    SumOfSquares,
+                                    [](uint64 lower, uint64 upper) { return lower + upper; });
+        });
+        const double sort = BestMs([&pool, &data, &work]()
+        {
+            work = data;
+            ParallelSort(&pool, Span<uint32>(work.data(), NumElements));
+        });
+
+        if (numThreads == 1)
+        {
+            baseHash   = hash;
+            baseReduce = reduce;
+            baseSort   = sort;
+        }
+
+        printf("%7u  | %7.2f %7.2fx  | %7.2f %7.2fx  | %7.2f %7.2fx\n",
+               numThreads, hash, baseHash / hash, reduce, baseReduce / reduce, sort, baseSort / sort);
+    }
+
+    return 0;
+}
@@ -0,0 +1,428 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palTaskPoolTest.cpp
+ * @brief Tests for TaskPool, ParallelFor, ParallelReduce and ParallelSort.
+ *
+ * The algorithms are run on pools of 1 to N threads, and once more on a pool whose deques hold only two tasks so most
+ * spawns fall back to running inline.  Their results must not depend on that: a float sum must be bitwise identical on
+ * every pool, and the order ParallelSort leaves equal elements in must be the same.  The tests are meant to be run
+ * under ThreadSanitizer as well (PAL_UTIL_TESTS_TSAN).
+ *
+ * Usage: palTaskPoolTest [max threads]
+ ***********************************************************************************************************************
+ */
+
+#include "palUtilTest.h"
+#include "palTaskPool.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace Util;
+using namespace Util::Test;
+
+namespace
+{
+
+using Pool = TaskPool<CountingAllocator>;
+
+constexpr size_t NumElements = 300000;
+
+// A sort key with a payload, so the order equal keys end up in is visible.
+struct KeyValue
+{
+    uint32 key;
+    uint32 value;
+
+    bool operator<(const KeyValue& other) const { return (key < other.key); }
+};
+
+// Inputs shared by every pool, and the results of the first pool, which every other pool must reproduce exactly.
+struct Inputs
+{
+    std::vector<float>    floats;
+    std::vector<uint32>   ints;
+    std::vector<uint32>   sortedInts;
+    std::vector<KeyValue> keyValues;
+
+    bool                  haveReference;
+    float                 floatSum;
+    std::vector<KeyValue> sortedKeyValues;
+};
+
+// =====================================================================================================================
+void TestParallelFor(
+    Pool* pPool)
+{
+    // Every element is visited exactly once, including those of a short last chunk.
+    std::vector<uint32> hits(NumElements + 7, 0);
+    ParallelFor(pPool, Span<uint32>(hits.data(), hits.size()), 1000, [](Span<uint32> chunk)
+    {
+        PAL_TEST_CHECK(chunk.NumElements() <= 1000);
+        for (uint32& hit : chunk)
+        {
+            ++hit;
+        }
+    });
+    bool allOnce = true;
+    for (uint32 hit : hits)
+    {
+        allOnce &= (hit == 1);
+    }
+    PAL_TEST_CHECK(allOnce);
+
+    std::atomic<uint32> numCalls{0};
+    ParallelFor(pPool, Span<uint32>(hits.data(), 0), 10, [&numCalls](Span<uint32>) { ++numCalls; });
+    PAL_TEST_CHECK(numCalls.load() == 0);
+
+    // A grain of 0 is treated as 1.
+    ParallelFor(pPool, Span<uint32>(hits.data(), 5), 0, [&numCalls](Span<uint32> chunk)
+    {
+        PAL_TEST_CHECK(chunk.NumElements() == 1);
+        ++numCalls;
+    });
+    PAL_TEST_CHECK(numCalls.load() == 5);
+}
+
+// =====================================================================================================================
+void TestParallelReduce(
+    Pool*   pPool,
+    Inputs* pInputs)
+{
+    // Floating-point addition is not associative, so this only matches across pools if the combine tree does.
+    const float floatSum = ParallelReduce(pPool,
+                                          Span<const float>(pInputs->floats.data(), NumElements),
+                                          777,
+                                          0.0f,
+                                          [](Span<const float> chunk)
+                                          {
+                                              float sum = 0;
+                                              for (float value : chunk)
+                                              {
+                                                  sum += value;
+                                              }
+                                              return sum;
+                                          },
+                                          [](float lower, float upper) { return lower + upper; });
+    if (pInputs->haveReference)
+    {
+        PAL_TEST_CHECK(memcmp(&floatSum, &pInputs->floatSum, sizeof(float)) == 0);
+    }
+    else
+    {
+        double serialSum = 0;
+        for (float value : pInputs->floats)
+        {
+            serialSum += value;
+        }
+        PAL_TEST_CHECK(fabs(double(floatSum) - serialSum) < 1.0);
+        pInputs->floatSum = floatSum;
+    }
+
+    uint64 serialSum = 0;
+    for (uint32 value : pInputs->ints)
+    {
+        serialSum += value;
+    }
+    const uint64 intSum = ParallelReduce(pPool,
+                                         Span<const uint32>(pInputs->ints.data(), NumElements),
+                                         100,
+                                         uint64(0),
+                                         [](Span<const uint32> chunk)
+                                         {
+                                             uint64 sum = 0;
+                                             for (uint32 value : chunk)
+                                             {
+                                                 sum += value;
+                                             }
+                                             return sum;
+                                         },
+                                         [](uint64 lower, uint64 upper) { return lower + upper; });
+    PAL_TEST_CHECK(intSum == serialSum);
+
+    const uint64 empty = ParallelReduce(pPool,
+                                        Span<const uint32>(),
+                                        10,
+                                        uint64(42),
+                                        [](Span<const uint32>) { return uint64(0); },
+                                        [](uint64 lower, uint64 upper) { return lower + upper; });
+    PAL_TEST_CHECK(empty == 42);
+
+    // Each chunk maps to its [first, last] range; combine gets its arguments in order, so neighbours must touch.
+    struct Range
+    {
+        uint32 first;
+        uint32 last;
+    };
+    std::vector<uint32> indices(1000);
+    for (uint32 i = 0; i < 1000; ++i)
+    {
+        indices[i] = i;
+    }
+    const Range range = ParallelReduce(pPool,
+                                       Span<const uint32>(indices.data(), indices.size()),
+                                       7,
+                                       Range{ 0, 0 },
+                                       [](Span<const uint32> chunk)
+                                       {
+                                           return Range{ chunk.Data()[0], chunk.Data()[chunk.NumElements() - 1] };
+                                       },
+                                       [](Range lower, Range upper)
+                                       {
+                                           PAL_TEST_CHECK((lower.last + 1) == upper.first);
+                                           return Range{ lower.first, upper.last };
+                                       });
+    PAL_TEST_CHECK((range.first == 0) && (range.last == 999));
+}
+
+// =====================================================================================================================
+template <typename T>
+bool IsSorted(
+    const std::vector<T>& values)
+{
+    bool isSorted = true;
+    for (size_t i = 1; i < values.size(); ++i)
+    {
+        isSorted &= ((values[i] < values[i - 1]) == false);
+    }
+    return isSorted;
+}
+
+// =====================================================================================================================
+void TestParallelSort(
+    Pool*   pPool,
+    Inputs* pInputs)
+{
+    std::vector<uint32> ints = pInputs->ints;
+    ParallelSort(pPool, Span<uint32>(ints.data(), NumElements));
+    PAL_TEST_CHECK(ints == pInputs->sortedInts);
+
+    // Sorting sorted, reversed and all-equal input hits the partitioning's worst cases.
+    ParallelSort(pPool, Span<uint32>(ints.data(), NumElements));
+    PAL_TEST_CHECK(ints == pInputs->sortedInts);
+
+    ParallelSort(pPool, Span<uint32>(ints.data(), NumElements), [](uint32 a, uint32 b) { return (a > b); });
+    bool isReversed = true;
+    for (size_t i = 0; i < NumElements; ++i)
+    {
+        isReversed &= (ints[i] == pInputs->sortedInts[NumElements - 1 - i]);
+    }
+    PAL_TEST_CHECK(isReversed);
+
+    ParallelSort(pPool, Span<uint32>(ints.data(), NumElements));
+    PAL_TEST_CHECK(ints == pInputs->sortedInts);
+
+    std::vector<uint32> equal(NumElements, 7);
+    ParallelSort(pPool, Span<uint32>(equal.data(), NumElements));
+    PAL_TEST_CHECK(equal == std::vector<uint32>(NumElements, 7));
+
+    // Only 1000 distinct keys, so most elements tie.  The sort is not stable, but which order the ties end up in must
+    // not depend on the pool.
+    std::vector<KeyValue> keyValues = pInputs->keyValues;
+    ParallelSort(pPool, Span<KeyValue>(keyValues.data(), NumElements));
+    PAL_TEST_CHECK(IsSorted(keyValues));
+    if (pInputs->haveReference)
+    {
+        PAL_TEST_CHECK(memcmp(keyValues.data(), pInputs->sortedKeyValues.data(), NumElements * sizeof(KeyValue)) == 0);
+    }
+    else
+    {
+        pInputs->sortedKeyValues = keyValues;
+    }
+}
+
+// =====================================================================================================================
+// ParallelFor called from inside a ParallelFor task, while a second outside thread runs a ParallelSort on the same
+// pool and has to wait its turn to enter it.
+void TestNesting(
+    Pool*         pPool,
+    const Inputs& inputs)
+{
+    constexpr uint32 Size = 256;
+    std::vector<uint32> grid(Size * Size, 0);
+
+    std::thread other([pPool, &inputs]()
+    {
+        std::vector<uint32> ints = inputs.ints;
+        ParallelSort(pPool, Span<uint32>(ints.data(), NumElements));
+        PAL_TEST_CHECK(ints == inputs.sortedInts);
+    });
+
+    ParallelFor(pPool, Span<uint32>(grid.data(), Size), 1, [pPool, &grid](Span<uint32> rows)
+    {
+        const uint32 row = uint32(rows.Data() - grid.data());
+        PAL_TEST_CHECK(pPool->IsCurrentThreadInPool());
+        ParallelFor(pPool, Span<uint32>(grid.data() + (row * Size), Size), 16, [row](Span<uint32> chunk)
+        {
+            for (uint32& cell : chunk)
+            {
+                cell += row;
+            }
+        });
+    });
+    other.join();
+
+    bool isCorrect = true;
+    for (uint32 i = 0; i < (Size * Size); ++i)
+    {
+        isCorrect &= (grid[i] == (i / Size));
+    }
+    PAL_TEST_CHECK(isCorrect);
+}
+
+// =====================================================================================================================
+// Spawn() and Wait() used directly, with tasks that spawn more tasks into a second group.
+void TestSpawnWait(
+    Pool* pPool)
+{
+    struct CountTask : Task
+    {
+        Pool*                pPool;
+        TaskGroup*           pChildGroup;
+        CountTask*           pChild;
+        std::atomic<uint32>* pCounter;
+    };
+
+    constexpr uint32 NumTasks = 100;
+    std::vector<CountTask> parents(NumTasks);
+    std::vector<CountTask> children(NumTasks);
+    std::atomic<uint32>    counter{0};
+    TaskGroup              group;
+    TaskGroup              childGroup;
+
+    PAL_TEST_CHECK(pPool->IsCurrentThreadInPool() == false);
+    {
+        TaskPoolAuto<Pool> inPool(pPool);
+        PAL_TEST_CHECK(pPool->IsCurrentThreadInPool());
+
+        {
+            TaskPoolAuto<Pool> nested(pPool);
+            PAL_TEST_CHECK(pPool->IsCurrentThreadInPool());
+        }
+        PAL_TEST_CHECK(pPool->IsCurrentThreadInPool());
+
+        for (uint32 i = 0; i < NumTasks; ++i)
+        {
+            children[i].pfnExecute = [](Task* pTask) { static_cast<CountTask*>(pTask)->pCounter->fetch_add(1000); };
+            children[i].pCounter   = &counter;
+
+            parents[i].pfnExecute  = [](Task* pTask)
+            {
+                CountTask*const pThis = static_cast<CountTask*>(pTask);
+                pThis->pPool->Spawn(pThis->pChildGroup, pThis->pChild);
+                pThis->pCounter->fetch_add(1);
+            };
+            parents[i].pPool       = pPool;
+            parents[i].pChildGroup = &childGroup;
+            parents[i].pChild      = &children[i];
+            parents[i].pCounter    = &counter;
+
+            pPool->Spawn(&group, &parents[i]);
+        }
+
+        pPool->Wait(&group);
+        PAL_TEST_CHECK(group.IsDone());
+        pPool->Wait(&childGroup);
+        PAL_TEST_CHECK(childGroup.IsDone());
+    }
+    PAL_TEST_CHECK(pPool->IsCurrentThreadInPool() == false);
+    PAL_TEST_CHECK(counter.load() == (NumTasks * 1001));
+}
+
+// =====================================================================================================================
+void TestPool(
+    uint32  numThreads,
+    uint32  queueDepth,
+    Inputs* pInputs)
+{
+    CountingAllocator allocator;
+    {
+        Pool pool(&allocator);
+        PAL_TEST_CHECK(pool.Init(TaskPoolCreateInfo{ numThreads, queueDepth }) == Result::Success);
+        PAL_TEST_CHECK(pool.NumThreads() == numThreads);
+
+        TestParallelFor(&pool);
+        TestParallelReduce(&pool, pInputs);
+        TestParallelSort(&pool, pInputs);
+        TestNesting(&pool, *pInputs);
+        TestSpawnWait(&pool);
+
+        pInputs->haveReference = true;
+    }
+    PAL_TEST_CHECK(allocator.Balanced());
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    const uint32 maxThreads = (argc > 1) ? uint32(atoi(argv[1])) : 8;
+
+    std::mt19937 random(5);
+    Inputs       inputs = {};
+
+    inputs.floats.resize(NumElements);
+    inputs.ints.resize(NumElements);
+    inputs.keyValues.resize(NumElements);
+    for (size_t i = 0; i < NumElements; ++i)
+    {
+        inputs.floats[i]    = std::uniform_real_distribution<float>(-1000.0f, 1000.0f)(random);
+        inputs.ints[i]      = uint32(random());
+        inputs.keyValues[i] = KeyValue{ uint32(random() % 1000), uint32(i) };
+    }
+    inputs.sortedInts = inputs.ints;
+    Sort(inputs.sortedInts.data(), inputs.sortedInts.data() + NumElements);
+
+    for (uint32 numThreads = 1; numThreads <= maxThreads; ++numThreads)
+    {
+        TestPool(numThreads, 0, &inputs);
+    }
+    TestPool(Max(maxThreads, 2u), 2, &inputs);
+
+    // Destroying a pool that was never initialized, one with the default thread count, and one initialized twice.
+    CountingAllocator allocator;
+    {
+        Pool uninitialized(&allocator);
+        Pool defaults(&allocator);
+        PAL_TEST_CHECK(defaults.Init(TaskPoolCreateInfo{}) == Result::Success);
+        PAL_TEST_CHECK(defaults.NumThreads() >= 1);
+
+        Pool twice(&allocator);
+        PAL_TEST_CHECK(twice.Init(TaskPoolCreateInfo{ 4, 0 }) == Result::Success);
+        PAL_TEST_CHECK(twice.Init(TaskPoolCreateInfo{ 2, 0 }) == Result::ErrorInvalidValue);
+        PAL_TEST_CHECK(twice.NumThreads() == 4);
+    }
+    PAL_TEST_CHECK(allocator.Balanced());
+
+    return Finish("palTaskPoolTest");
+}
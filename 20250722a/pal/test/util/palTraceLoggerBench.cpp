@@ -0,0 +1,181 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palTraceLoggerBench.cpp
+ * @brief Cost of a PAL_TRACE call against formatting each message on the spot.
+ *
+ * Rows, in ns per call on the logging thread:
+ *
+ * - PAL_TRACE, accepted: bursts which fit in the ring, drained between bursts outside the timed region.  The cost of
+ *   formatting and writing each record on the flusher is printed alongside.
+ * - PAL_TRACE, ring full: the drop path, with nothing draining the ring.
+ * - vsnprintf + lock + write: what DbgPrintf does in file mode, with and without flushing after every message.
+ *
+ * Best of three runs.
+ *
+ * Usage: palTraceLoggerBench [calls per run]
+ ***********************************************************************************************************************
+ */
+
+#include "palUtilTest.h"
+#include "palTraceLogger.h"
+#include <cstdarg>
+#include <cstdlib>
+
+using namespace Util;
+using namespace Util::Test;
+
+namespace
+{
+
+Mutex g_printLock;
+File  g_printFile;
+bool  g_flushEach = true;
+
+// =====================================================================================================================
+// Formats with varargs and writes the line under a lock, the way DbgPrintf does when it prints to a file.
+void PrintNow(
+    const char* pFormat,
+    ...)
+{
+    char    line[1024];
+    va_list args;
+    va_start(args, pFormat);
+    int32 length = vsnprintf(line, sizeof(line) - 1, pFormat, args);
+    va_end(args);
+    length = Min(length, int32(sizeof(line) - 2));
+    line[length++] = '\n';
+
+    MutexAuto lock(&g_printLock);
+    g_printFile.Write(line, length);
+    if (g_flushEach)
+    {
+        g_printFile.Flush();
+    }
+}
+
+// =====================================================================================================================
+// @returns Nanoseconds per call since start.
+double NsPer(
+    std::chrono::steady_clock::time_point start,
+    double                                numCalls)
+{
+    return ElapsedSeconds(start) * 1e9 / numCalls;
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    const uint32 numCalls  = (argc > 1) ? uint32(atoi(argv[1])) : 2000000;
+    const uint32 burstSize = 20000;
+
+    GenericAllocator allocator;
+    uint32           sink = 0;
+
+    double accepted     = 1e30;
+    double formatting   = 1e30;
+    double ringFull     = 1e30;
+    double printFlush   = 1e30;
+    double printNoFlush = 1e30;
+
+    for (uint32 rep = 0; rep < 3; ++rep)
+    {
+        {
+            TraceLogger<GenericAllocator> logger(&allocator);
+
+            // A 1 MiB ring holds 32768 records of four words, so a burst never drops.
+            logger.Init("palTraceLoggerBench.trace.log", TraceLoggerCreateInfo{ 1 << 20, 1 });
+
+            double timedNs = 0;
+            double flushNs = 0;
+            for (uint32 burst = 0; burst < numCalls / burstSize; ++burst)
+            {
+                auto start = std::chrono::steady_clock::now();
+                for (uint32 i = 0; i < burstSize; ++i)
+                {
+                    PAL_TRACE(&logger, "submit queue=%u count=%u fence=%p", i & 7, i, &sink);
+                }
+                timedNs += NsPer(start, 1);
+
+                start = std::chrono::steady_clock::now();
+                logger.Flush();
+                flushNs += NsPer(start, 1);
+            }
+            const double numTimed = double((numCalls / burstSize) * burstSize);
+            accepted   = Min(accepted, timedNs / numTimed);
+            formatting = Min(formatting, flushNs / numTimed);
+
+            // Fill the ring, then time calls that only count the drop.
+            for (uint32 i = 0; i < (1 << 20); ++i)
+            {
+                PAL_TRACE(&logger, "fill %u", i);
+            }
+            const auto start = std::chrono::steady_clock::now();
+            for (uint32 i = 0; i < numCalls; ++i)
+            {
+                PAL_TRACE(&logger, "submit queue=%u count=%u fence=%p", i & 7, i, &sink);
+            }
+            ringFull = Min(ringFull, NsPer(start, numCalls));
+        }
+
+        for (bool flushEach : { true, false })
+        {
+            g_flushEach = flushEach;
+            g_printFile.Open("palTraceLoggerBench.print.log", FileAccessWrite);
+
+            // Flushing every line is slow enough that a tenth of the calls gives a stable number.
+            const uint32 numPrints = flushEach ? (numCalls / 10) : numCalls;
+            const auto   start     = std::chrono::steady_clock::now();
+            for (uint32 i = 0; i < numPrints; ++i)
+            {
+                PrintNow("submit queue=%u count=%u fence=%p", i & 7, i, &sink);
+            }
+            const double ns = NsPer(start, numPrints);
+            g_printFile.Close();
+
+            if (flushEach)
+            {
+                printFlush = Min(printFlush, ns);
+            }
+            else
+            {
+                printNoFlush = Min(printNoFlush, ns);
+            }
+        }
+    }
+
+    printf("PAL_TRACE, accepted            %8.1f ns/call  (formatting + write on the flusher: %.1f ns/record)\n",
+           accepted, formatting);
+    printf("PAL_TRACE, ring full           %8.1f ns/call\n", ringFull);
+    printf("vsnprintf + lock + write       %8.1f ns/call\n", printNoFlush);
+    printf("vsnprintf + lock + write+flush %8.1f ns/call\n", printFlush);
+
+    return 0;
+}
@@ -0,0 +1,290 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palTraceLoggerTest.cpp
+ * @brief Tests for TraceLogger and FormatTraceRecord.
+ *
+ * - Every record must decode to exactly the text snprintf, which DbgPrintf formats with, gives for the same call.
+ * - Records logged from several threads must all reach the file, each thread's in order.
+ * - A full ring drops and counts records and notes the drops in the file.
+ * - Rings of threads which exit are reused by the next threads, so thread churn does not grow the logger.
+ *
+ * The output files are written to the current directory.  The threaded parts are meant to be run under
+ * ThreadSanitizer as well (PAL_UTIL_TESTS_TSAN).
+ *
+ * Usage: palTraceLoggerTest
+ ***********************************************************************************************************************
+ */
+
+#include "palUtilTest.h"
+#include "palTraceLogger.h"
+#include <climits>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Util;
+using namespace Util::Test;
+
+namespace
+{
+
+enum class SmallEnum : uint8
+{
+    Value = 3
+};
+
+// =====================================================================================================================
+// Checks that one record decodes to the text snprintf produces for the same format and arguments.
+template <typename... Args>
+void CheckDecode(
+    const char* pFormat,
+    Args...     args)
+{
+    const TraceFormat format = { pFormat, sizeof...(Args) };
+    const uint64      words[MaxTraceArgs + 1] = { TraceArgWord(args)..., 0 };
+
+    char decoded[256];
+    char expected[256];
+    FormatTraceRecord(format, words, decoded, sizeof(decoded));
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-security"
+#pragma GCC diagnostic ignored "-Wformat"
+#pragma GCC diagnostic ignored "-Wformat-extra-args"
+    snprintf(expected, sizeof(expected), pFormat, args...);
+#pragma GCC diagnostic pop
+
+    if (strcmp(decoded, expected) != 0)
+    {
+        fprintf(stderr, "format \"%s\": decoded \"%s\", snprintf \"%s\"\n", pFormat, decoded, expected);
+        PAL_TEST_CHECK(false);
+    }
+}
+
+// =====================================================================================================================
+void TestDecode()
+{
+    CheckDecode("plain text");
+    CheckDecode("100%% done");
+    CheckDecode("%d %i", -5, 7);
+    CheckDecode("%u", 4000000000u);
+    CheckDecode("%x %X %o", -1, 255, 8);
+    CheckDecode("%hhd %hhu %hd %hu", 300, 300, 70000, -1);
+    CheckDecode("%ld %lu %lld %llu", LONG_MIN, ULONG_MAX, LLONG_MIN, ULLONG_MAX);
+    CheckDecode("%zu %zd %td", size_t(12345678901), ptrdiff_t(-3), ptrdiff_t(9));
+    CheckDecode("%jd", intmax_t(-99));
+    CheckDecode("%5d|%-5d|%05d|%+d|% d", 42, 42, 42, 42, 42);
+    CheckDecode("%*d|%-*d|%.*f", 6, 1, 6, 2, 3, 3.14159);
+    CheckDecode("%f %.2f %10.3e %g %G %a", 1.5, 2.345, 12345.678, 0.0001, 1e20, 1.0);
+    CheckDecode("%f", 1.25f);
+    CheckDecode("%s and %.3s and %8s|%-8s|", "abc", "abcdef", "r", "l");
+    CheckDecode("%p %p", reinterpret_cast<void*>(0x1234), static_cast<void*>(nullptr));
+    CheckDecode("%c%c%c", 'a', 'b', 'c');
+    CheckDecode("%#x %#o", 255, 8);
+    CheckDecode("%d %d", true, SmallEnum::Value);
+    CheckDecode("%d", static_cast<unsigned char>(200));
+    CheckDecode("x=%lx", 0xDEADBEEFCAFEull);
+    CheckDecode("%hhx", -1);
+    CheckDecode("%lf %Lf", 2.5, 3.5L);
+    CheckDecode("%d %d %d %d %d %d %d %d %d %d %d %d", 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12);
+}
+
+// =====================================================================================================================
+std::string ReadFile(
+    const char* pFilename)
+{
+    std::ifstream     file(pFilename);
+    std::stringstream text;
+    text << file.rdbuf();
+    return text.str();
+}
+
+// =====================================================================================================================
+// Several threads log at once through a small ring which the flusher drains every millisecond.  Whatever was not
+// dropped must reach the file with the exact text, each thread's records in order.
+void TestThreads()
+{
+    constexpr uint32 NumThreads       = 4;
+    constexpr uint32 RecordsPerThread = 20000;
+    const char*const pFilename        = "palTraceLoggerTest.log";
+
+    CountingAllocator allocator;
+    std::vector<std::vector<std::string>> expected(NumThreads);
+    {
+        TraceLogger<CountingAllocator> logger(&allocator);
+
+        // Records logged before Init() are ignored.
+        PAL_TRACE(&logger, "before init %d", 1);
+        PAL_TEST_CHECK(logger.Init(pFilename, TraceLoggerCreateInfo{ 4096, 1 }) == Result::Success);
+
+        std::vector<std::thread> threads;
+        for (uint32 t = 0; t < NumThreads; ++t)
+        {
+            threads.emplace_back([&logger, &expected, t]()
+            {
+                for (uint32 i = 0; i < RecordsPerThread; ++i)
+                {
+                    PAL_TRACE(&logger, "t%u i=%u x=%08x f=%.3f s=%s", t, i, i * 2654435761u, i / 7.0, "lit");
+
+                    char line[128];
+                    snprintf(line, sizeof(line), "t%u i=%u x=%08x f=%.3f s=%s", t, i, i * 2654435761u, i / 7.0, "lit");
+                    expected[t].push_back(line);
+                    if ((i % 64) == 0)
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        logger.Flush();
+        PAL_TEST_CHECK(logger.NumWritten() + logger.NumDropped() == NumThreads * RecordsPerThread);
+    }
+    PAL_TEST_CHECK(allocator.Balanced());
+
+    // Each thread's lines must be a subsequence of what it logged, since some records may have been dropped.
+    std::istringstream text(ReadFile(pFilename));
+    std::string        line;
+    std::vector<size_t> next(NumThreads, 0);
+    while (std::getline(text, line))
+    {
+        if (line.rfind("TraceLogger:", 0) == 0)
+        {
+            continue;
+        }
+        const uint32 t = uint32(line[1] - '0');
+        PAL_TEST_CHECK(t < NumThreads);
+        if (t < NumThreads)
+        {
+            while ((next[t] < expected[t].size()) && (expected[t][next[t]] != line))
+            {
+                ++next[t];
+            }
+            PAL_TEST_CHECK(next[t] < expected[t].size());
+            ++next[t];
+        }
+    }
+}
+
+// =====================================================================================================================
+// A ring which is never drained fills up; the rest of the records are dropped, counted and noted in the file.
+void TestDrops()
+{
+    const char*const pFilename = "palTraceLoggerTest.drops.log";
+
+    CountingAllocator allocator;
+    {
+        TraceLogger<CountingAllocator> logger(&allocator);
+
+        // 256 bytes is 32 words, which holds 10 records of 3 words.  The flusher only runs at the end.
+        PAL_TEST_CHECK(logger.Init(pFilename, TraceLoggerCreateInfo{ 256, 100000 }) == Result::Success);
+        for (uint32 i = 0; i < 1000; ++i)
+        {
+            PAL_TRACE(&logger, "%u %u", i, i);
+        }
+        logger.Flush();
+
+        PAL_TEST_CHECK(logger.NumWritten() == 10);
+        PAL_TEST_CHECK(logger.NumDropped() == 990);
+    }
+    PAL_TEST_CHECK(allocator.Balanced());
+    PAL_TEST_CHECK(ReadFile(pFilename).find("TraceLogger: 990 records dropped") != std::string::npos);
+}
+
+// =====================================================================================================================
+// Threads which exit hand their rings back.  Short-lived threads, one wave after another, must keep reusing the same
+// few rings, including a thread which logs to two loggers.
+void TestThreadChurn()
+{
+    constexpr uint32 NumWaves       = 50;
+    constexpr uint32 ThreadsPerWave = 4;
+
+    CountingAllocator allocatorA;
+    CountingAllocator allocatorB;
+    {
+        TraceLogger<CountingAllocator> loggerA(&allocatorA);
+        TraceLogger<CountingAllocator> loggerB(&allocatorB);
+        PAL_TEST_CHECK(loggerA.Init("palTraceLoggerTest.churnA.log", TraceLoggerCreateInfo{ 1 << 16, 1 }) ==
+                       Result::Success);
+        PAL_TEST_CHECK(loggerB.Init("palTraceLoggerTest.churnB.log", TraceLoggerCreateInfo{ 1 << 16, 1 }) ==
+                       Result::Success);
+
+        for (uint32 wave = 0; wave < NumWaves; ++wave)
+        {
+            std::vector<std::thread> threads;
+            for (uint32 t = 0; t < ThreadsPerWave; ++t)
+            {
+                threads.emplace_back([&loggerA, &loggerB, wave, t]()
+                {
+                    PAL_TRACE(&loggerA, "wave %u thread %u first", wave, t);
+                    if ((t % 2) == 0)
+                    {
+                        PAL_TRACE(&loggerB, "wave %u thread %u", wave, t);
+                    }
+                    PAL_TRACE(&loggerA, "wave %u thread %u second", wave, t);
+                });
+            }
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+        }
+
+        // One output buffer each, plus at most one ring per thread of a wave.
+        PAL_TEST_CHECK(allocatorA.Allocs() <= 1 + ThreadsPerWave);
+        PAL_TEST_CHECK(allocatorB.Allocs() <= 1 + ThreadsPerWave / 2);
+
+        loggerA.Flush();
+        loggerB.Flush();
+        PAL_TEST_CHECK(loggerA.NumWritten() == NumWaves * ThreadsPerWave * 2);
+        PAL_TEST_CHECK(loggerB.NumWritten() == NumWaves * ThreadsPerWave / 2);
+    }
+    PAL_TEST_CHECK(allocatorA.Balanced());
+    PAL_TEST_CHECK(allocatorB.Balanced());
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    TestDecode();
+    TestThreads();
+    TestDrops();
+    TestThreadChurn();
+
+    return Finish("palTraceLoggerTest");
+}
@@ -0,0 +1,122 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palUtilTest.h
+ * @brief Helpers shared by the PAL utility tests and benchmarks.
+ ***********************************************************************************************************************
+ */
+
+#pragma once
+
+#include "palSysMemory.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+
+namespace Util
+{
+namespace Test
+{
+
+/// Number of failed PAL_TEST_CHECKs in this process.
+inline std::atomic<uint32> g_failures{0};
+
+/// Records a failure and keeps going, so one run reports every broken check.  Safe to use from any thread.
+#define PAL_TEST_CHECK(cond)                                                                  \
+    do                                                                                        \
+    {                                                                                         \
+        if (!(cond))                                                                          \
+        {                                                                                     \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);          \
+            Util::Test::g_failures.fetch_add(1, std::memory_order_relaxed);                   \
+        }                                                                                     \
+    } while (false)
+
+/// Prints the outcome of a test program and returns its exit code.
+inline int Finish(
+    const char* pName)
+{
+    const uint32 failures = g_failures.load();
+    if (failures != 0)
+    {
+        fprintf(stderr, "%s: %u checks failed\n", pName, failures);
+    }
+    else
+    {
+        printf("%s: passed\n", pName);
+    }
+    return (failures != 0) ? 1 : 0;
+}
+
+/// @returns Seconds elapsed since start.
+inline double ElapsedSeconds(
+    std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ ***********************************************************************************************************************
+ * @brief Thread-safe allocator that forwards to GenericAllocator and counts calls, so tests can check for leaks.
+ ***********************************************************************************************************************
+ */
+class CountingAllocator
+{
+public:
+    CountingAllocator() : m_allocs(0), m_frees(0) { }
+
+    void* Alloc(const AllocInfo& allocInfo)
+    {
+        void* pMemory = GenericAllocator::Alloc(allocInfo);
+        if (pMemory != nullptr)
+        {
+            m_allocs.fetch_add(1, std::memory_order_relaxed);
+        }
+        return pMemory;
+    }
+
+    void Free(const FreeInfo& freeInfo)
+    {
+        if (freeInfo.pClientMem != nullptr)
+        {
+            m_frees.fetch_add(1, std::memory_order_relaxed);
+            GenericAllocator::Free(freeInfo);
+        }
+    }
+
+    uint32 Allocs() const { return m_allocs.load(); }
+    uint32 Frees()  const { return m_frees.load(); }
+
+    /// @returns True if every allocation was freed.
+    bool Balanced() const { return Allocs() == Frees(); }
+
+private:
+    std::atomic<uint32> m_allocs;
+    std::atomic<uint32> m_frees;
+};
+
+} // Test
+} // Util
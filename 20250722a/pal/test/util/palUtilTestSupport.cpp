@@ -0,0 +1,372 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palUtilTestSupport.cpp
+ * @brief POSIX implementations of the palUtil library functions the utility headers declare but do not define.
+ *
+ * The prebuilt libraries under pal/lib are Windows-only, so on other hosts the tests and benchmarks link this instead.
+ * It covers only what the utility headers call: GenericAllocator, Mutex, RWLock, Event, File, Snprintf, YieldThread
+ * and the performance counter.
+ ***********************************************************************************************************************
+ */
+
+#include "palDbgPrint.h"
+#include "palEvent.h"
+#include "palFile.h"
+#include "palMutex.h"
+#include "palSysMemory.h"
+#include "palSysUtil.h"
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <poll.h>
+#include <sched.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+// =====================================================================================================================
+void* PAL_CDECL operator new(
+    size_t      size,
+    void*       pObjMem,
+    Util::Dummy dummy
+    ) noexcept
+{
+    return pObjMem;
+}
+
+// =====================================================================================================================
+void PAL_CDECL operator delete(
+    void*       pObj,
+    void*       pObjMem,
+    Util::Dummy dummy
+    ) noexcept
+{
+}
+
+namespace Util
+{
+
+// =====================================================================================================================
+void* GenericAllocator::Alloc(
+    const AllocInfo& allocInfo)
+{
+    // aligned_alloc() wants a size that is a multiple of the alignment, which must itself be at least sizeof(void*).
+    const size_t alignment = Max(allocInfo.alignment, sizeof(void*));
+    void*const   pMemory   = aligned_alloc(alignment, Pow2Align(Max<size_t>(allocInfo.bytes, 1), alignment));
+
+    if ((pMemory != nullptr) && allocInfo.zeroMem)
+    {
+        memset(pMemory, 0, allocInfo.bytes);
+    }
+
+    return pMemory;
+}
+
+// =====================================================================================================================
+void GenericAllocator::Free(
+    const FreeInfo& freeInfo)
+{
+    free(freeInfo.pClientMem);
+}
+
+// =====================================================================================================================
+void Mutex::Lock()
+{
+    pthread_mutex_lock(&m_osMutex);
+}
+
+// =====================================================================================================================
+bool Mutex::TryLock()
+{
+    return (pthread_mutex_trylock(&m_osMutex) == 0);
+}
+
+// =====================================================================================================================
+void Mutex::Unlock()
+{
+    pthread_mutex_unlock(&m_osMutex);
+}
+
+// =====================================================================================================================
+void RWLock::LockForRead()
+{
+    pthread_rwlock_rdlock(&m_osRWLock);
+}
+
+// =====================================================================================================================
+void RWLock::LockForWrite()
+{
+    pthread_rwlock_wrlock(&m_osRWLock);
+}
+
+// =====================================================================================================================
+bool RWLock::TryLockForRead()
+{
+    return (pthread_rwlock_tryrdlock(&m_osRWLock) == 0);
+}
+
+// =====================================================================================================================
+bool RWLock::TryLockForWrite()
+{
+    return (pthread_rwlock_trywrlock(&m_osRWLock) == 0);
+}
+
+// =====================================================================================================================
+void RWLock::UnlockForRead()
+{
+    pthread_rwlock_unlock(&m_osRWLock);
+}
+
+// =====================================================================================================================
+void RWLock::UnlockForWrite()
+{
+    pthread_rwlock_unlock(&m_osRWLock);
+}
+
+const Event::EventHandle Event::InvalidEvent = -1;
+
+// =====================================================================================================================
+Event::Event()
+    :
+    m_hEvent(InvalidEvent),
+    m_isReference(false)
+{
+}
+
+// =====================================================================================================================
+Event::~Event()
+{
+    if (m_hEvent != InvalidEvent)
+    {
+        close(m_hEvent);
+    }
+}
+
+// =====================================================================================================================
+// The event is an eventfd: set means its counter is non-zero, and a wait that sees it set reads it back to zero.  Only
+// auto-reset events are implemented, which is all the utility headers create.
+Result Event::Init(
+    const EventCreateFlags& flags)
+{
+    Result result = (flags.manualReset == 0) ? Result::Success : Result::Unsupported;
+
+    if (result == Result::Success)
+    {
+        int eventFlags = EFD_NONBLOCK;
+        eventFlags |= flags.semaphore      ? EFD_SEMAPHORE : 0;
+        eventFlags |= flags.closeOnExecute ? EFD_CLOEXEC   : 0;
+
+        m_hEvent = eventfd(flags.initiallySignaled ? 1 : 0, eventFlags);
+        result   = (m_hEvent != InvalidEvent) ? Result::Success : Result::ErrorUnknown;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+Result Event::Set() const
+{
+    Result result = Result::ErrorUnavailable;
+
+    if (m_hEvent != InvalidEvent)
+    {
+        const uint64 one = 1;
+        result = (write(m_hEvent, &one, sizeof(one)) == sizeof(one)) ? Result::Success : Result::ErrorUnknown;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+Result Event::Reset() const
+{
+    Result result = Result::ErrorUnavailable;
+
+    if (m_hEvent != InvalidEvent)
+    {
+        // Fails with EAGAIN if the event is already reset, which is fine.
+        uint64 value = 0;
+        result = ((read(m_hEvent, &value, sizeof(value)) >= 0) || (errno == EAGAIN)) ? Result::Success
+                                                                                    : Result::ErrorUnknown;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+Result Event::Wait(
+    fseconds timeout) const
+{
+    Result result = Result::ErrorUnavailable;
+
+    if (timeout.count() < 0.0f)
+    {
+        result = Result::ErrorInvalidValue;
+    }
+    else if (m_hEvent != InvalidEvent)
+    {
+        pollfd    pollInfo  = { m_hEvent, POLLIN, 0 };
+        const int timeoutMs = int(Min(timeout.count() * 1000.0f, float(INT32_MAX)));
+        const int ready     = poll(&pollInfo, 1, timeoutMs);
+
+        if (ready > 0)
+        {
+            // Another waiter may have consumed the set first; then this one timed out as far as it is concerned.
+            uint64 value = 0;
+            result = (read(m_hEvent, &value, sizeof(value)) == sizeof(value)) ? Result::Success : Result::Timeout;
+        }
+        else
+        {
+            result = (ready == 0) ? Result::Timeout : Result::ErrorUnknown;
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+Result File::Open(
+    const char* pFilename,
+    uint32      accessFlags)
+{
+    const char* pMode = nullptr;
+
+    switch (accessFlags & (FileAccessRead | FileAccessWrite | FileAccessAppend))
+    {
+    case FileAccessRead:
+        pMode = "rb";
+        break;
+    case FileAccessWrite:
+        pMode = (accessFlags & FileAccessNoDiscard) ? "r+b" : "wb";
+        break;
+    case FileAccessAppend:
+    case (FileAccessWrite | FileAccessAppend):
+        pMode = "ab";
+        break;
+    case (FileAccessRead | FileAccessWrite):
+        pMode = (accessFlags & FileAccessNoDiscard) ? "r+b" : "w+b";
+        break;
+    case (FileAccessRead | FileAccessAppend):
+    case (FileAccessRead | FileAccessWrite | FileAccessAppend):
+        pMode = "a+b";
+        break;
+    default:
+        break;
+    }
+
+    Result result = ((pMode != nullptr) && (m_pFileHandle == nullptr)) ? Result::Success : Result::ErrorInvalidValue;
+
+    if (result == Result::Success)
+    {
+        m_pFileHandle = fopen(pFilename, pMode);
+        m_ownsHandle  = true;
+        result        = (m_pFileHandle != nullptr) ? Result::Success : Result::ErrorUnknown;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+void File::Close()
+{
+    if ((m_pFileHandle != nullptr) && m_ownsHandle)
+    {
+        fclose(m_pFileHandle);
+    }
+    m_pFileHandle = nullptr;
+    m_ownsHandle  = false;
+}
+
+// =====================================================================================================================
+Result File::Write(
+    const void* pBuffer,
+    size_t      bufferSize)
+{
+    Result result = (m_pFileHandle != nullptr) ? Result::Success : Result::ErrorUnavailable;
+
+    if ((result == Result::Success) && (fwrite(pBuffer, 1, bufferSize, m_pFileHandle) != bufferSize))
+    {
+        result = Result::ErrorUnknown;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+Result File::Flush() const
+{
+    Result result = (m_pFileHandle != nullptr) ? Result::Success : Result::ErrorUnavailable;
+
+    if ((result == Result::Success) && (fflush(m_pFileHandle) != 0))
+    {
+        result = Result::ErrorUnknown;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+int32 Snprintf(
+    char*       pOutput,
+    size_t      bufSize,
+    const char* pFormat,
+    ...)
+{
+    va_list argList;
+    va_start(argList, pFormat);
+    const int32 length = vsnprintf(pOutput, bufSize, pFormat, argList);
+    va_end(argList);
+
+    return length;
+}
+
+// =====================================================================================================================
+void YieldThread()
+{
+    sched_yield();
+}
+
+// =====================================================================================================================
+// The counter is CLOCK_MONOTONIC in nanoseconds.
+int64 GetPerfFrequency()
+{
+    return 1000000000;
+}
+
+// =====================================================================================================================
+int64 GetPerfCpuTime(
+    bool raw)
+{
+    timespec now = {};
+    clock_gettime(raw ? CLOCK_MONOTONIC_RAW : CLOCK_MONOTONIC, &now);
+
+    return (int64(now.tv_sec) * 1000000000) + now.tv_nsec;
+}
+
+} // Util
@@ -0,0 +1,196 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palWideBitfieldBench.cpp
+ * @brief Cost of the WideBitfield* functions against a loop over the elements and against the kernels alone.
+ *
+ * For each field size, in ns per call:
+ *
+ * - loop:   the per-element loop the WideBitfield* functions used before the kernels existed.
+ * - kernel: the WideBitfieldKernels entry point, with its runtime CPU dispatch.
+ * - func:   the WideBitfield* function, which picks one of the two by size at compile time.
+ *
+ * Operations are AND of two fields, IsAnyBitSet of an all-zero field (the worst case) and CountSetBits.  Best of
+ * seven runs.
+ *
+ * Usage: palWideBitfieldBench [calls per run]
+ ***********************************************************************************************************************
+ */
+
+#include "palUtilTest.h"
+#include "palWideBitfield.h"
+#include <cstdlib>
+#include <random>
+
+using namespace Util;
+using namespace Util::Test;
+
+namespace
+{
+
+volatile uint64 g_sink = 0;
+
+// =====================================================================================================================
+// Makes the compiler assume the memory behind pData is read and written, so loops cannot be hoisted or removed.
+inline void Clobber(
+    const void* pData)
+{
+#if defined(__GNUC__)
+    __asm__ volatile("" : : "r"(pData) : "memory");
+#else
+    g_sink = g_sink + reinterpret_cast<uintptr_t>(pData);
+#endif
+}
+
+// =====================================================================================================================
+// @returns The best ns per call of work over seven runs.
+template <typename Work>
+double BestNsPerCall(
+    uint32 numCalls,
+    Work   work)
+{
+    double best = 1e30;
+
+    for (uint32 rep = 0; rep < 7; ++rep)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32 i = 0; i < numCalls; ++i)
+        {
+            work();
+        }
+        best = Min(best, ElapsedSeconds(start) * 1e9 / numCalls);
+    }
+
+    return best;
+}
+
+// =====================================================================================================================
+template <typename T, size_t N>
+void Run(
+    uint32 numCalls)
+{
+    static T a[N];
+    static T b[N];
+    static T out[N];
+    static T zero[N];
+
+    std::mt19937_64 random(3);
+    for (size_t i = 0; i < N; ++i)
+    {
+        a[i] = T(random());
+        b[i] = T(random());
+    }
+
+    using namespace WideBitfieldKernels;
+
+    const double andLoop = BestNsPerCall(numCalls, []()
+    {
+        Clobber(a);
+        for (size_t i = 0; i < N; ++i)
+        {
+            out[i] = a[i] & b[i];
+        }
+        Clobber(out);
+    });
+    const double andKernel = BestNsPerCall(numCalls, []()
+    {
+        Clobber(a);
+        Combine<BitOp::And>(out, a, b, sizeof(a));
+        Clobber(out);
+    });
+    const double andFunc = BestNsPerCall(numCalls, []()
+    {
+        Clobber(a);
+        WideBitfieldAndBits(a, b, out);
+        Clobber(out);
+    });
+
+    const double anyLoop = BestNsPerCall(numCalls, []()
+    {
+        Clobber(zero);
+        bool isBitSet = false;
+        for (size_t i = 0; i < N; ++i)
+        {
+            isBitSet |= (zero[i] != 0);
+        }
+        g_sink = isBitSet;
+    });
+    const double anyKernel = BestNsPerCall(numCalls, []() { Clobber(zero); g_sink = IsAnyBitSet(zero, sizeof(zero)); });
+    const double anyFunc   = BestNsPerCall(numCalls, []() { Clobber(zero); g_sink = WideBitfieldIsAnyBitSet(zero); });
+
+    const double countLoop = BestNsPerCall(numCalls, []()
+    {
+        Clobber(a);
+        uint32 count = 0;
+        for (size_t i = 0; i < N; ++i)
+        {
+            count += Util::CountSetBits(a[i]);
+        }
+        g_sink = count;
+    });
+    const double countKernel = BestNsPerCall(numCalls, []()
+    {
+        Clobber(a);
+        g_sink = WideBitfieldKernels::CountSetBits(a, sizeof(a));
+    });
+    const double countFunc = BestNsPerCall(numCalls, []() { Clobber(a); g_sink = WideBitfieldCountSetBits(a); });
+
+    printf("%2u x %4u %5u B | %6.1f %6.1f %6.1f | %6.1f %6.1f %6.1f | %6.1f %6.1f %6.1f\n",
+           uint32(sizeof(T) * 8), uint32(N), uint32(sizeof(a)),
+           andLoop, andKernel, andFunc, anyLoop, anyKernel, anyFunc, countLoop, countKernel, countFunc);
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    const uint32 numCalls = (argc > 1) ? uint32(atoi(argv[1])) : 100000;
+
+#if PAL_SIMD_X86
+    printf("AVX2 %s\n", CpuSupportsAvx2() ? "available" : "not available");
+#endif
+    printf("                 |          and         |       any (zero)     |       popcount\n");
+    printf("field            |   loop kernel   func |   loop kernel   func |   loop kernel   func   (ns/call)\n");
+
+    Run<uint16, 2>(numCalls);
+    Run<uint32, 2>(numCalls);
+    Run<uint32, 4>(numCalls);
+    Run<uint32, 8>(numCalls);
+    Run<uint32, 32>(numCalls);
+    Run<uint32, 64>(numCalls);
+    Run<uint64, 8>(numCalls);
+    Run<uint64, 16>(numCalls);
+    Run<uint64, 31>(numCalls);
+    Run<uint64, 32>(numCalls);
+    Run<uint64, 48>(numCalls);
+    Run<uint64, 64>(numCalls);
+    Run<uint64, 256>(numCalls);
+
+    return 0;
+}
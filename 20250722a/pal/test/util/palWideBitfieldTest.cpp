@@ -0,0 +1,368 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palWideBitfieldTest.cpp
+ * @brief Tests for WideBitfield, the WideBitfield* functions and the kernels of palWideBitfieldKernels.h.
+ *
+ * - Every WideBitfield operation must match std::bitset on random fields of various sizes and densities, and the
+ *   padding bits above NumBits must stay clear.
+ * - The WideBitfield* functions must match a per-element reference for each element type, on both sides of the
+ *   MinCombineBytes and MinReduceBytes thresholds.
+ * - Each kernel (scalar, SSE2 and, where the CPU has it, AVX2) must be right for every length up to a few vectors.
+ *
+ * Usage: palWideBitfieldTest
+ ***********************************************************************************************************************
+ */
+
+#include "palUtilTest.h"
+#include "palWideBitfield.h"
+#include <bitset>
+#include <random>
+#include <vector>
+
+using namespace Util;
+using namespace Util::Test;
+
+namespace
+{
+
+std::mt19937_64 g_random(1);
+
+// =====================================================================================================================
+template <uint32 N>
+bool Matches(
+    const WideBitfield<N>&        field,
+    const std::bitset<size_t(N)>& reference)
+{
+    bool matches = true;
+
+    for (uint32 i = 0; i < N; ++i)
+    {
+        matches &= (field.IsSet(i) == reference[i]);
+    }
+
+    // Padding bits must stay clear.
+    if ((N % 64) != 0)
+    {
+        matches &= ((field.Words()[WideBitfield<N>::NumWords - 1] >> (N % 64)) == 0);
+    }
+
+    return matches;
+}
+
+// =====================================================================================================================
+// Sets each bit with the given percent probability.
+template <uint32 N>
+void Fill(
+    WideBitfield<N>*        pField,
+    std::bitset<size_t(N)>* pReference,
+    uint32                  density)
+{
+    pField->ClearAll();
+    pReference->reset();
+
+    for (uint32 i = 0; i < N; ++i)
+    {
+        if ((g_random() % 100) < density)
+        {
+            pField->SetBit(i);
+            pReference->set(i);
+        }
+    }
+}
+
+// =====================================================================================================================
+// @returns The lowest index at or above start whose bit equals value, or N.
+template <uint32 N>
+uint32 FindReference(
+    const std::bitset<size_t(N)>& reference,
+    uint32                        start,
+    bool                          value)
+{
+    uint32 i = start;
+    while ((i < N) && (reference[i] != value))
+    {
+        ++i;
+    }
+    return (i < N) ? i : N;
+}
+
+// =====================================================================================================================
+template <uint32 N>
+void TestWideBitfield()
+{
+    constexpr uint32 Densities[] = { 0, 1, 10, 50, 99, 100 };
+
+    for (uint32 iter = 0; iter < 300; ++iter)
+    {
+        WideBitfield<N>        a;
+        WideBitfield<N>        b;
+        std::bitset<size_t(N)> refA;
+        std::bitset<size_t(N)> refB;
+
+        Fill<N>(&a, &refA, Densities[iter % 6]);
+        Fill<N>(&b, &refB, uint32(g_random() % 101));
+
+        PAL_TEST_CHECK(Matches<N>(a, refA));
+        PAL_TEST_CHECK(a.CountSetBits() == refA.count());
+        PAL_TEST_CHECK(a.IsAnyBitSet() == refA.any());
+        PAL_TEST_CHECK(Matches<N>(a & b, refA & refB));
+        PAL_TEST_CHECK(Matches<N>(a | b, refA | refB));
+        PAL_TEST_CHECK(Matches<N>(a ^ b, refA ^ refB));
+
+        WideBitfield<N> cleared = a;
+        cleared ^= a;
+        PAL_TEST_CHECK(cleared.IsAnyBitSet() == false);
+        PAL_TEST_CHECK(cleared == WideBitfield<N>());
+        PAL_TEST_CHECK((refA.any() == false) || (a != cleared));
+
+        uint32 index = 0;
+        uint32 want  = FindReference<N>(refA, 0, true);
+        PAL_TEST_CHECK(a.FindFirstSet(&index) == (want < N));
+        PAL_TEST_CHECK((want == N) || (index == want));
+
+        const uint32 start = uint32(g_random() % (N + 2));
+        want = FindReference<N>(refA, start, true);
+        PAL_TEST_CHECK(a.FindNextSet(start, &index) == (want < N));
+        PAL_TEST_CHECK((want == N) || (index == want));
+
+        want = FindReference<N>(refA, 0, false);
+        PAL_TEST_CHECK(a.FindFirstClear(&index) == (want < N));
+        PAL_TEST_CHECK((want == N) || (index == want));
+
+        std::vector<uint32> seen;
+        a.ForEachSetBit([&seen](uint32 bit) { seen.push_back(bit); });
+        std::vector<uint32> expected;
+        for (uint32 bit = FindReference<N>(refA, 0, true); bit < N; bit = FindReference<N>(refA, bit + 1, true))
+        {
+            expected.push_back(bit);
+        }
+        PAL_TEST_CHECK(seen == expected);
+
+        const uint32 rangeStart = uint32(g_random() % (N + 1));
+        const uint32 rangeBits  = uint32(g_random() % (N - rangeStart + 1));
+
+        WideBitfield<N>        ranged    = a;
+        std::bitset<size_t(N)> refRanged = refA;
+        ranged.SetRange(rangeStart, rangeBits);
+        for (uint32 i = rangeStart; i < rangeStart + rangeBits; ++i)
+        {
+            refRanged.set(i);
+        }
+        PAL_TEST_CHECK(Matches<N>(ranged, refRanged));
+
+        ranged    = a;
+        refRanged = refA;
+        ranged.ClearRange(rangeStart, rangeBits);
+        for (uint32 i = rangeStart; i < rangeStart + rangeBits; ++i)
+        {
+            refRanged.reset(i);
+        }
+        PAL_TEST_CHECK(Matches<N>(ranged, refRanged));
+    }
+
+    WideBitfield<N> all;
+    all.SetAll();
+    uint32 index = 0;
+    PAL_TEST_CHECK(all.CountSetBits() == N);
+    PAL_TEST_CHECK(all.FindFirstClear(&index) == false);
+}
+
+// =====================================================================================================================
+// Compares the WideBitfield* functions on T[Count] with per-element results.
+template <typename T, size_t Count>
+void TestFunctions()
+{
+    constexpr uint32 NumBits = uint32(Count * sizeof(T) * 8);
+
+    for (uint32 iter = 0; iter < 300; ++iter)
+    {
+        T a[Count];
+        T b[Count];
+        T out[Count];
+
+        uint32 count = 0;
+        bool   any   = false;
+
+        for (size_t i = 0; i < Count; ++i)
+        {
+            // Every fifth field is empty, and the rest are sparse enough that single set bits are common.
+            a[i] = ((iter % 5) == 0) ? T(0) : T(g_random() & g_random() & g_random());
+            b[i] = T(g_random());
+
+            count += CountSetBits(uint64(a[i]));
+            any   |= (a[i] != 0);
+        }
+
+        PAL_TEST_CHECK(WideBitfieldCountSetBits(a) == count);
+        PAL_TEST_CHECK(WideBitfieldIsAnyBitSet(a) == any);
+
+        WideBitfieldXorBits(a, b, out);
+        for (size_t i = 0; i < Count; ++i)
+        {
+            PAL_TEST_CHECK(out[i] == T(a[i] ^ b[i]));
+        }
+
+        WideBitfieldAndBits(a, b, out);
+        for (size_t i = 0; i < Count; ++i)
+        {
+            PAL_TEST_CHECK(out[i] == T(a[i] & b[i]));
+        }
+
+        // The output may alias an input.
+        memcpy(out, a, sizeof(a));
+        WideBitfieldXorBits(out, b, out);
+        for (size_t i = 0; i < Count; ++i)
+        {
+            PAL_TEST_CHECK(out[i] == T(a[i] ^ b[i]));
+        }
+
+        const uint32 start   = uint32(g_random() % (NumBits + 1));
+        const uint32 numBits = uint32(g_random() % (NumBits - start + 1));
+
+        memcpy(out, a, sizeof(a));
+        WideBitfieldSetRange(out, start, numBits);
+        for (uint32 i = 0; i < NumBits; ++i)
+        {
+            const bool inRange = (i >= start) && (i < (start + numBits));
+            PAL_TEST_CHECK(WideBitfieldIsSet(out, i) == (inRange || WideBitfieldIsSet(a, i)));
+        }
+    }
+}
+
+// =====================================================================================================================
+// Calls each kernel directly for every length up to a few AVX2 vectors, whatever the dispatcher would pick.
+void TestKernels()
+{
+    using namespace WideBitfieldKernels;
+
+    for (size_t bytes = 0; bytes < 300; ++bytes)
+    {
+        std::vector<uint8> a(bytes);
+        std::vector<uint8> b(bytes);
+        std::vector<uint8> out(bytes);
+        uint32             count = 0;
+
+        for (size_t i = 0; i < bytes; ++i)
+        {
+            a[i]   = uint8(g_random());
+            b[i]   = uint8(g_random());
+            count += CountSetBits(uint32(a[i]));
+        }
+
+        PAL_TEST_CHECK(WideBitfieldKernels::CountSetBits(a.data(), bytes) == count);
+        PAL_TEST_CHECK(CountSetBitsScalar(a.data(), bytes) == count);
+
+        CombineScalar<BitOp::Or>(out.data(), a.data(), b.data(), bytes);
+        for (size_t i = 0; i < bytes; ++i)
+        {
+            PAL_TEST_CHECK(out[i] == uint8(a[i] | b[i]));
+        }
+
+        Combine<BitOp::Xor>(out.data(), a.data(), b.data(), bytes);
+        for (size_t i = 0; i < bytes; ++i)
+        {
+            PAL_TEST_CHECK(out[i] == uint8(a[i] ^ b[i]));
+        }
+
+#if PAL_SIMD_X86
+        PAL_TEST_CHECK(CountSetBitsSse2(a.data(), bytes) == count);
+
+        size_t done = CombineSse2<BitOp::And>(out.data(), a.data(), b.data(), bytes);
+        CombineScalar<BitOp::And>(out.data() + done, a.data() + done, b.data() + done, bytes - done);
+        for (size_t i = 0; i < bytes; ++i)
+        {
+            PAL_TEST_CHECK(out[i] == uint8(a[i] & b[i]));
+        }
+
+        if (CpuSupportsAvx2())
+        {
+            PAL_TEST_CHECK(CountSetBitsAvx2(a.data(), bytes) == count);
+
+            done = CombineAvx2<BitOp::Or>(out.data(), a.data(), b.data(), bytes);
+            CombineScalar<BitOp::Or>(out.data() + done, a.data() + done, b.data() + done, bytes - done);
+            for (size_t i = 0; i < bytes; ++i)
+            {
+                PAL_TEST_CHECK(out[i] == uint8(a[i] | b[i]));
+            }
+        }
+#endif
+
+        // One set bit anywhere must be found, including in the tail after the last whole vector.
+        std::vector<uint8> single(bytes);
+        PAL_TEST_CHECK(IsAnyBitSet(single.data(), bytes) == false);
+        for (size_t i = 0; i < bytes; ++i)
+        {
+            single[i] = uint8(1u << (i % 8));
+            PAL_TEST_CHECK(IsAnyBitSet(single.data(), bytes));
+#if PAL_SIMD_X86
+            if ((bytes >= 32) && CpuSupportsAvx2())
+            {
+                PAL_TEST_CHECK(IsAnyBitSetAvx2(single.data(), bytes));
+            }
+#endif
+            single[i] = 0;
+        }
+    }
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    TestWideBitfield<1>();
+    TestWideBitfield<7>();
+    TestWideBitfield<63>();
+    TestWideBitfield<64>();
+    TestWideBitfield<65>();
+    TestWideBitfield<200>();
+    TestWideBitfield<257>();
+    TestWideBitfield<1000>();
+    TestWideBitfield<2047>();   // 256 bytes of words, the first size on the Combine() kernels.
+    TestWideBitfield<4096>();
+
+    TestFunctions<uint8, 1>();
+    TestFunctions<uint8, 7>();
+    TestFunctions<uint8, 8>();
+    TestFunctions<uint8, 37>();
+    TestFunctions<uint16, 9>();
+    TestFunctions<uint16, 3>();
+    TestFunctions<uint32, 1>();
+    TestFunctions<uint32, 3>();
+    TestFunctions<uint32, 63>();
+    TestFunctions<uint32, 64>();
+    TestFunctions<uint64, 2>();
+    TestFunctions<uint64, 31>();
+    TestFunctions<uint64, 32>();
+    TestFunctions<uint64, 67>();
+
+    TestKernels();
+
+    return Finish("palWideBitfieldTest");
+}
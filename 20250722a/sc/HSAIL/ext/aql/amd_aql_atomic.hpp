@@ -0,0 +1,171 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef AMD_AQL_ATOMIC_HPP
+#define AMD_AQL_ATOMIC_HPP
+
+#include <atomic>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace amd {
+namespace hsa {
+namespace aql {
+namespace atomic {
+
+// Queue fields, packet headers and signal values are shared with agents that
+// are not C++ threads, so they are plain (volatile) memory accessed with
+// compiler atomics rather than std::atomic objects.
+
+template<class T>
+inline T load_relaxed(const volatile T *ptr)
+{
+#if defined(__clang__) || defined(__GNUC__)
+  return __atomic_load_n(ptr, __ATOMIC_RELAXED);
+#elif defined(_MSC_VER)
+  return *ptr;
+#else
+  #error "Unknown compiler."
+#endif
+}
+
+template<class T>
+inline T load_acquire(const volatile T *ptr)
+{
+#if defined(__clang__) || defined(__GNUC__)
+  return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#elif defined(_MSC_VER)
+  T val = *ptr;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return val;
+#else
+  #error "Unknown compiler."
+#endif
+}
+
+template<class T>
+inline void store_relaxed(volatile T *ptr, T val)
+{
+#if defined(__clang__) || defined(__GNUC__)
+  __atomic_store_n(ptr, val, __ATOMIC_RELAXED);
+#elif defined(_MSC_VER)
+  *ptr = val;
+#else
+  #error "Unknown compiler."
+#endif
+}
+
+template<class T>
+inline void store_release(volatile T *ptr, T val)
+{
+#if defined(__clang__) || defined(__GNUC__)
+  __atomic_store_n(ptr, val, __ATOMIC_RELEASE);
+#elif defined(_MSC_VER)
+  std::atomic_thread_fence(std::memory_order_release);
+  *ptr = val;
+#else
+  #error "Unknown compiler."
+#endif
+}
+
+// 64-bit compare-and-swap with acquire-release ordering. Updates *expected
+// with the current value on failure.
+template<class T>
+inline bool cas(volatile T *ptr, T *expected, T desired)
+{
+  static_assert(sizeof(T) == sizeof(int64_t), "64-bit CAS only");
+#if defined(__clang__) || defined(__GNUC__)
+  return __atomic_compare_exchange_n(ptr, expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#elif defined(_MSC_VER)
+  const T prev = static_cast<T>(_InterlockedCompareExchange64(
+    reinterpret_cast<volatile long long*>(ptr), static_cast<long long>(desired), static_cast<long long>(*expected)));
+  const bool swapped = (prev == *expected);
+  *expected = prev;
+  return swapped;
+#else
+  #error "Unknown compiler."
+#endif
+}
+
+// 32- or 64-bit fetch-and-add with acquire-release ordering.
+template<class T>
+inline T fetch_add(volatile T *ptr, T val)
+{
+  static_assert(sizeof(T) == sizeof(int32_t) || sizeof(T) == sizeof(int64_t), "32- or 64-bit add only");
+#if defined(__clang__) || defined(__GNUC__)
+  return __atomic_fetch_add(ptr, val, __ATOMIC_ACQ_REL);
+#elif defined(_MSC_VER)
+  if (sizeof(T) == sizeof(int32_t)) {
+    return static_cast<T>(_InterlockedExchangeAdd(reinterpret_cast<volatile long*>(ptr), static_cast<long>(val)));
+  }
+  return static_cast<T>(_InterlockedExchangeAdd64(reinterpret_cast<volatile long long*>(ptr),
+                                                  static_cast<long long>(val)));
+#else
+  #error "Unknown compiler."
+#endif
+}
+
+inline void fence_seq_cst()
+{
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+inline void cpu_relax()
+{
+#if defined(__i386__) || defined(__x86_64__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  __asm__ __volatile__("yield");
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+  _mm_pause();
+#endif
+}
+
+} // namespace atomic
+} // namespace aql
+} // namespace hsa
+} // namespace amd
+
+#endif // AMD_AQL_ATOMIC_HPP
@@ -0,0 +1,398 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "amd_aql_queue.hpp"
+
+#include <cassert>
+#include <cstring>
+#include "amd_aql_atomic.hpp"
+#include "amd_hsa_code_util.hpp"
+#include "amd_signal_wait.hpp"
+
+namespace amd {
+namespace hsa {
+namespace aql {
+
+namespace {
+
+using namespace atomic;
+
+// Spins briefly before giving up the time slice, so a waiter on an idle
+// queue does not burn a core.
+class Backoff final {
+public:
+  Backoff(): spins_(0) {}
+
+  void Pause()
+  {
+    if (spins_ < kSpinLimit) {
+      ++spins_;
+      cpu_relax();
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  void Reset() { spins_ = 0; }
+
+private:
+  static const uint32_t kSpinLimit = 64;
+  uint32_t spins_;
+};
+
+// The first 32 bits of every packet are the header and the setup field (or
+// reserved bits), written together so the packet processor never sees a
+// valid type with a stale setup.
+inline volatile uint32_t *HeaderWord(void *slot)
+{
+  return static_cast<volatile uint32_t*>(slot);
+}
+
+inline uint16_t HeaderType(uint32_t header)
+{
+  return (header >> HSA_PACKET_HEADER_TYPE) & ((1 << HSA_PACKET_HEADER_WIDTH_TYPE) - 1);
+}
+
+inline amd_signal_t *SignalFromHandle(hsa_signal_t signal)
+{
+  return reinterpret_cast<amd_signal_t*>(static_cast<uintptr_t>(signal.handle));
+}
+
+// Completion signals live at the same offset in every architected packet.
+static_assert(offsetof(hsa_kernel_dispatch_packet_t, completion_signal) ==
+              offsetof(hsa_barrier_and_packet_t, completion_signal), "completion signal offset");
+static_assert(offsetof(hsa_kernel_dispatch_packet_t, completion_signal) ==
+              offsetof(hsa_agent_dispatch_packet_t, completion_signal), "completion signal offset");
+static_assert(sizeof(hsa_kernel_dispatch_packet_t) == kPacketBytes, "AQL packet size");
+
+} // namespace anonymous
+
+uint32_t MakeHeader(hsa_packet_type_t type, uint16_t setup, bool barrier)
+{
+  uint32_t header = static_cast<uint32_t>(type) << HSA_PACKET_HEADER_TYPE;
+  header |= (barrier ? 1u : 0u) << HSA_PACKET_HEADER_BARRIER;
+  header |= static_cast<uint32_t>(HSA_FENCE_SCOPE_SYSTEM) << HSA_PACKET_HEADER_SCACQUIRE_FENCE_SCOPE;
+  header |= static_cast<uint32_t>(HSA_FENCE_SCOPE_SYSTEM) << HSA_PACKET_HEADER_SCRELEASE_FENCE_SCOPE;
+  return header | (static_cast<uint32_t>(setup) << 16);
+}
+
+//===----------------------------------------------------------------------===//
+// Producer.                                                                  //
+//===----------------------------------------------------------------------===//
+
+Producer::Producer(amd_queue_t *queue):
+  queue_(queue),
+  ring_(static_cast<uint8_t*>(queue->hsa_queue.base_address)),
+  mask_(queue->hsa_queue.size - 1),
+  size_(queue->hsa_queue.size),
+  doorbell_(SignalFromHandle(queue->hsa_queue.doorbell_signal)),
+  doorbell_rung_(0),
+  doorbell_writes_(0)
+{
+  assert(size_ != 0 && (size_ & (size_ - 1)) == 0);
+  assert(doorbell_->kind == AMD_SIGNAL_KIND_USER || doorbell_->kind == AMD_SIGNAL_KIND_DOORBELL);
+}
+
+bool Producer::TryReserve(uint32_t count, uint64_t *first_id)
+{
+  assert(count != 0 && count <= size_);
+  uint64_t write_id = load_acquire(&queue_->write_dispatch_id);
+  for (;;) {
+    const uint64_t read_id = load_acquire(&queue_->read_dispatch_id);
+    if (write_id + count - read_id > size_) {
+      return false;
+    }
+    if (cas(&queue_->write_dispatch_id, &write_id, write_id + count)) {
+      *first_id = write_id;
+      return true;
+    }
+  }
+}
+
+uint64_t Producer::Reserve(uint32_t count)
+{
+  uint64_t first_id = 0;
+  Backoff backoff;
+  while (!TryReserve(count, &first_id)) {
+    backoff.Pause();
+  }
+  return first_id;
+}
+
+void Producer::Publish(uint64_t first_id, uint32_t count, const uint32_t *headers)
+{
+  // Later headers only need to be ordered before the first one: the packet
+  // processor does not look at packet N + 1 until it has acquired packet N.
+  for (uint32_t i = 1; i < count; ++i) {
+    store_relaxed(HeaderWord(Slot(first_id + i)), headers[i]);
+  }
+  store_release(HeaderWord(Slot(first_id)), headers[0]);
+}
+
+void Producer::RingDoorbell(uint64_t last_id)
+{
+  uint64_t rung = doorbell_rung_.load(std::memory_order_relaxed);
+  do {
+    if (rung > last_id) {
+      return;
+    }
+  } while (!doorbell_rung_.compare_exchange_weak(rung, last_id + 1, std::memory_order_acq_rel));
+
+  WriteDoorbell(last_id);
+}
+
+void Producer::WriteDoorbell(uint64_t value)
+{
+  doorbell_writes_.fetch_add(1, std::memory_order_relaxed);
+
+  if (doorbell_->kind == AMD_SIGNAL_KIND_DOORBELL) {
+    // Hardware doorbells accept any value on multi-producer queues.
+    store_release(doorbell_->hardware_doorbell_ptr, value);
+    return;
+  }
+
+  // User signal doorbells are kept monotonic, because a CPU packet processor
+  // uses the value to decide how far it may run.
+  int64_t current = load_acquire(&doorbell_->value);
+  while (current < static_cast<int64_t>(value)) {
+    if (cas(&doorbell_->value, &current, static_cast<int64_t>(value))) {
+      break;
+    }
+  }
+}
+
+uint64_t Producer::Submit(const hsa_kernel_dispatch_packet_t *packets, uint32_t count)
+{
+  const uint64_t first_id = Reserve(count);
+
+  uint32_t headers_inline[16];
+  uint32_t *headers = (count <= 16) ? headers_inline : new uint32_t[count];
+
+  for (uint32_t i = 0; i < count; ++i) {
+    uint8_t *slot = static_cast<uint8_t*>(Slot(first_id + i));
+    const uint8_t *packet = reinterpret_cast<const uint8_t*>(&packets[i]);
+    memcpy(slot + sizeof(uint32_t), packet + sizeof(uint32_t), kPacketBytes - sizeof(uint32_t));
+    headers[i] = packets[i].header | (static_cast<uint32_t>(packets[i].setup) << 16);
+  }
+
+  Publish(first_id, count, headers);
+  RingDoorbell(first_id + count - 1);
+
+  if (headers != headers_inline) {
+    delete[] headers;
+  }
+  return first_id;
+}
+
+//===----------------------------------------------------------------------===//
+// HostQueue.                                                                 //
+//===----------------------------------------------------------------------===//
+
+HostQueue *HostQueue::Create(uint32_t size)
+{
+  if (size == 0 || (size & (size - 1)) != 0) {
+    return nullptr;
+  }
+
+  HostQueue *host = new HostQueue();
+  host->queue_ = static_cast<amd_queue_t*>(alignedMalloc(sizeof(amd_queue_t), AMD_QUEUE_ALIGN_BYTES));
+  host->doorbell_ = static_cast<amd_signal_t*>(alignedMalloc(sizeof(amd_signal_t), AMD_SIGNAL_ALIGN_BYTES));
+  host->ring_ = alignedMalloc(size_t(size) * kPacketBytes, kPacketBytes);
+  if (!host->queue_ || !host->doorbell_ || !host->ring_) {
+    delete host;
+    return nullptr;
+  }
+
+  memset(host->doorbell_, 0, sizeof(amd_signal_t));
+  host->doorbell_->kind = AMD_SIGNAL_KIND_USER;
+  host->doorbell_->value = -1;
+
+  uint8_t *ring = static_cast<uint8_t*>(host->ring_);
+  memset(ring, 0, size_t(size) * kPacketBytes);
+  for (uint32_t i = 0; i < size; ++i) {
+    *HeaderWord(ring + size_t(i) * kPacketBytes) = static_cast<uint32_t>(HSA_PACKET_TYPE_INVALID) << HSA_PACKET_HEADER_TYPE;
+  }
+
+  amd_queue_t *queue = host->queue_;
+  memset(queue, 0, sizeof(amd_queue_t));
+  queue->hsa_queue.type = HSA_QUEUE_TYPE_MULTI;
+  queue->hsa_queue.base_address = host->ring_;
+  queue->hsa_queue.doorbell_signal.handle = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(host->doorbell_));
+  queue->hsa_queue.size = size;
+  queue->hsa_queue.id = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(queue));
+  host->doorbell_->queue_ptr = queue;
+  return host;
+}
+
+void HostQueue::Destroy(HostQueue *queue)
+{
+  delete queue;
+}
+
+HostQueue::~HostQueue()
+{
+  alignedFree(ring_);
+  alignedFree(doorbell_);
+  alignedFree(queue_);
+}
+
+//===----------------------------------------------------------------------===//
+// CpuPacketProcessor.                                                        //
+//===----------------------------------------------------------------------===//
+
+CpuPacketProcessor::CpuPacketProcessor(amd_queue_t *queue, DispatchCallback callback, void *data):
+  queue_(queue), callback_(callback), data_(data), stop_(false), packets_processed_(0)
+{
+  assert(SignalFromHandle(queue->hsa_queue.doorbell_signal)->kind == AMD_SIGNAL_KIND_USER);
+}
+
+CpuPacketProcessor::~CpuPacketProcessor()
+{
+  Stop();
+}
+
+void CpuPacketProcessor::Start()
+{
+  assert(!thread_.joinable());
+  stop_.store(false, std::memory_order_relaxed);
+  thread_ = std::thread(&CpuPacketProcessor::Run, this);
+}
+
+void CpuPacketProcessor::Stop()
+{
+  if (thread_.joinable()) {
+    stop_.store(true, std::memory_order_release);
+    thread_.join();
+  }
+}
+
+void CpuPacketProcessor::Run()
+{
+  const amd_signal_t *doorbell = SignalFromHandle(queue_->hsa_queue.doorbell_signal);
+  uint8_t *ring = static_cast<uint8_t*>(queue_->hsa_queue.base_address);
+  const uint64_t mask = queue_->hsa_queue.size - 1;
+  uint64_t read_id = load_acquire(&queue_->read_dispatch_id);
+  Backoff backoff;
+
+  for (;;) {
+    // Only run as far as the doorbell says; its value is the last announced id.
+    const int64_t rung = load_acquire(&doorbell->value);
+    if (rung < 0 || static_cast<uint64_t>(rung) < read_id) {
+      if (stop_.load(std::memory_order_acquire)) {
+        break;
+      }
+      backoff.Pause();
+      continue;
+    }
+    backoff.Reset();
+
+    while (read_id <= static_cast<uint64_t>(rung)) {
+      uint8_t *slot = ring + (read_id & mask) * kPacketBytes;
+
+      // The doorbell may run ahead of a slow producer's publication.
+      uint32_t header = load_acquire(HeaderWord(slot));
+      while (HeaderType(header) == HSA_PACKET_TYPE_INVALID) {
+        backoff.Pause();
+        header = load_acquire(HeaderWord(slot));
+      }
+      backoff.Reset();
+
+      Process(slot, HeaderType(header));
+
+      const hsa_signal_t completion = reinterpret_cast<hsa_kernel_dispatch_packet_t*>(slot)->completion_signal;
+      if (completion.handle != 0) {
+        SignalSubtract(SignalFromHandle(completion), 1);
+      }
+
+      // Hand the slot back: invalidate it before producers can see it is free.
+      store_relaxed(HeaderWord(slot), static_cast<uint32_t>(HSA_PACKET_TYPE_INVALID) << HSA_PACKET_HEADER_TYPE);
+      ++read_id;
+      store_release(&queue_->read_dispatch_id, read_id);
+      packets_processed_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+void CpuPacketProcessor::Process(uint8_t *slot, uint16_t type)
+{
+  switch (type) {
+  case HSA_PACKET_TYPE_KERNEL_DISPATCH:
+  case HSA_PACKET_TYPE_AGENT_DISPATCH:
+    if (callback_) {
+      callback_(reinterpret_cast<const hsa_kernel_dispatch_packet_t*>(slot), data_);
+    }
+    break;
+
+  case HSA_PACKET_TYPE_BARRIER_AND:
+  case HSA_PACKET_TYPE_BARRIER_OR: {
+    const hsa_barrier_and_packet_t *barrier = reinterpret_cast<const hsa_barrier_and_packet_t*>(slot);
+    amd_signal_t *deps[5];
+    hsa_signal_condition_t conditions[5];
+    hsa_signal_value_t zeros[5];
+    uint32_t count = 0;
+    for (size_t i = 0; i < sizeof(barrier->dep_signal) / sizeof(barrier->dep_signal[0]); ++i) {
+      if (barrier->dep_signal[i].handle != 0) {
+        deps[count] = SignalFromHandle(barrier->dep_signal[i]);
+        conditions[count] = HSA_SIGNAL_CONDITION_EQ;
+        zeros[count] = 0;
+        ++count;
+      }
+    }
+    if (type == HSA_PACKET_TYPE_BARRIER_AND) {
+      for (uint32_t i = 0; i < count; ++i) {
+        SignalWait(deps[i], HSA_SIGNAL_CONDITION_EQ, 0, UINT64_MAX, HSA_WAIT_STATE_BLOCKED);
+      }
+    } else if (count != 0) {
+      SignalWaitAny(count, deps, conditions, zeros, UINT64_MAX, HSA_WAIT_STATE_BLOCKED, nullptr);
+    }
+    break;
+  }
+
+  default:
+    // Vendor-specific packets are not understood here and complete as no-ops.
+    break;
+  }
+}
+
+} // namespace aql
+} // namespace hsa
+} // namespace amd
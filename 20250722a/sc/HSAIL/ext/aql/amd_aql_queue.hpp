@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef AMD_AQL_QUEUE_HPP
+#define AMD_AQL_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include "hsa.h"
+#include "amd_hsa_queue.h"
+#include "amd_hsa_signal.h"
+
+namespace amd {
+namespace hsa {
+namespace aql {
+
+// Size of one AQL packet slot in bytes.
+static const uint32_t kPacketBytes = 64;
+
+// Returns the header word (header | setup << 16) for a packet of the given
+// type with system-scope acquire and release fences.
+uint32_t MakeHeader(hsa_packet_type_t type, uint16_t setup = 0, bool barrier = false);
+
+/// @brief Lock-free multi-producer submission to an AQL queue.
+///
+/// Producers reserve runs of packet slots with a CAS on write_dispatch_id, fill
+/// the packet bodies, and publish the whole run with a single release store of
+/// the first packet's header. The packet processor consumes in id order, so it
+/// cannot observe the later headers of a run before the first one.
+///
+/// Doorbell writes are coalesced: a producer only writes the doorbell if no
+/// other producer has already rung it with the same or a later packet id.
+///
+/// One Producer is shared by all threads submitting to the queue. The queue
+/// must be a multi-producer queue whose doorbell is either a user signal or a
+/// hardware doorbell.
+class Producer final {
+public:
+  explicit Producer(amd_queue_t *queue);
+
+  ~Producer() {}
+
+  // Reserves @p count consecutive packet slots and returns the id of the
+  // first one. Waits while the ring does not have @p count free slots.
+  // @p count must not exceed the queue size.
+  uint64_t Reserve(uint32_t count);
+
+  // As Reserve(), but returns false instead of waiting if the ring is full.
+  bool TryReserve(uint32_t count, uint64_t *first_id);
+
+  // Returns the slot for packet @p id, so the caller can write the packet
+  // body in place. The header must be left alone; Publish() writes it.
+  void *Slot(uint64_t id) const
+  {
+    return ring_ + (id & mask_) * kPacketBytes;
+  }
+
+  // Makes the @p count reserved packets starting at @p first_id visible to
+  // the packet processor. @p headers holds one header word per packet, as
+  // returned by MakeHeader(). Does not ring the doorbell.
+  void Publish(uint64_t first_id, uint32_t count, const uint32_t *headers);
+
+  // Tells the packet processor that packets up to and including @p last_id
+  // are published. Skipped if a doorbell covering @p last_id was already
+  // written.
+  void RingDoorbell(uint64_t last_id);
+
+  // Reserves slots for @p count packets, copies the packets (whose header
+  // fields are used as the header words), publishes them and rings the
+  // doorbell once. Returns the id of the first packet.
+  uint64_t Submit(const hsa_kernel_dispatch_packet_t *packets, uint32_t count);
+
+  amd_queue_t *Queue() const { return queue_; }
+
+  // Number of doorbell writes actually performed.
+  uint64_t DoorbellWrites() const { return doorbell_writes_.load(std::memory_order_relaxed); }
+
+private:
+  Producer(const Producer&);
+  Producer& operator=(const Producer&);
+
+  void WriteDoorbell(uint64_t value);
+
+  amd_queue_t *queue_;
+  uint8_t *ring_;
+  uint64_t mask_;
+  uint32_t size_;
+  amd_signal_t *doorbell_;
+
+  // Highest packet id any producer has rung the doorbell with, plus one.
+  std::atomic<uint64_t> doorbell_rung_;
+  std::atomic<uint64_t> doorbell_writes_;
+};
+
+/// @brief Queue in host memory with a user-signal doorbell.
+///
+/// Stands in for a runtime-allocated queue so that Producer and
+/// CpuPacketProcessor can be exercised without a GPU. The ring slots start
+/// out as invalid packets.
+class HostQueue final {
+public:
+  // @p size is the number of packet slots and must be a power of two.
+  static HostQueue *Create(uint32_t size);
+  static void Destroy(HostQueue *queue);
+
+  amd_queue_t *Queue() { return queue_; }
+
+private:
+  HostQueue(): queue_(nullptr), doorbell_(nullptr), ring_(nullptr) {}
+  ~HostQueue();
+  HostQueue(const HostQueue&);
+  HostQueue& operator=(const HostQueue&);
+
+  amd_queue_t *queue_;
+  amd_signal_t *doorbell_;
+  void *ring_;
+};
+
+/// @brief CPU thread acting as the packet processor of a host queue.
+///
+/// Consumes packets in id order once their headers are valid. Kernel and
+/// agent dispatch packets are handed to a callback; barrier-AND and
+/// barrier-OR packets wait on their dependency signals. The completion
+/// signal of every packet is decremented, then the slot is invalidated and
+/// read_dispatch_id advanced so producers can reuse it.
+///
+/// Signals are amd_signal_t objects in host memory whose address is the
+/// hsa_signal_t handle. Completion signals are decremented with
+/// SignalSubtract(), so SignalWait() sleepers are woken.
+class CpuPacketProcessor final {
+public:
+  typedef void (*DispatchCallback)(const hsa_kernel_dispatch_packet_t *packet, void *data);
+
+  // @p callback may be null, in which case dispatches complete immediately.
+  CpuPacketProcessor(amd_queue_t *queue, DispatchCallback callback = nullptr, void *data = nullptr);
+
+  // Stops the thread if it is still running.
+  ~CpuPacketProcessor();
+
+  void Start();
+
+  // Stops once all packets the doorbell has announced are processed.
+  void Stop();
+
+  uint64_t PacketsProcessed() const { return packets_processed_.load(std::memory_order_relaxed); }
+
+private:
+  CpuPacketProcessor(const CpuPacketProcessor&);
+  CpuPacketProcessor& operator=(const CpuPacketProcessor&);
+
+  void Run();
+  void Process(uint8_t *slot, uint16_t type);
+
+  amd_queue_t *queue_;
+  DispatchCallback callback_;
+  void *data_;
+  std::thread thread_;
+  std::atomic<bool> stop_;
+  std::atomic<uint64_t> packets_processed_;
+};
+
+} // namespace aql
+} // namespace hsa
+} // namespace amd
+
+#endif // AMD_AQL_QUEUE_HPP
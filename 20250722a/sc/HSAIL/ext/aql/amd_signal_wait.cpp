@@ -0,0 +1,313 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "amd_signal_wait.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <thread>
+#include "amd_aql_atomic.hpp"
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace amd {
+namespace hsa {
+namespace aql {
+
+namespace {
+
+using namespace atomic;
+
+typedef std::chrono::steady_clock Clock;
+
+std::atomic<uint32_t> g_spin_ns(2000);
+std::atomic<uint32_t> g_yield_ns(20000);
+std::atomic<uint32_t> g_sleep_quantum_ns(1000000);
+
+// A wait-any sleeper cannot sleep on the words of several signals at once, so
+// those sleepers share one process-wide word that every notify bumps.
+volatile uint32_t g_any_epoch = 0;
+volatile uint32_t g_any_sleepers = 0;
+
+inline volatile uint32_t *SleepWord(amd_signal_t *signal)
+{
+  return &signal->event_id;
+}
+
+inline volatile uint32_t *SleeperCount(amd_signal_t *signal)
+{
+  return &signal->reserved1;
+}
+
+// Sleeps until *word is no longer @p expected, a wake, or @p timeout_ns.
+void SleepOn(volatile uint32_t *word, uint32_t expected, uint64_t timeout_ns, bool process_private)
+{
+#if defined(__linux__)
+  struct timespec timeout;
+  timeout.tv_sec = static_cast<time_t>(timeout_ns / 1000000000);
+  timeout.tv_nsec = static_cast<long>(timeout_ns % 1000000000);
+  syscall(SYS_futex, const_cast<uint32_t*>(word), process_private ? FUTEX_WAIT_PRIVATE : FUTEX_WAIT,
+          expected, &timeout, nullptr, 0);
+#else
+  (void)word;
+  (void)expected;
+  (void)process_private;
+  std::this_thread::sleep_for(std::chrono::nanoseconds((std::min)(timeout_ns, uint64_t(50000))));
+#endif
+}
+
+void WakeAll(volatile uint32_t *word, bool process_private)
+{
+#if defined(__linux__)
+  syscall(SYS_futex, const_cast<uint32_t*>(word), process_private ? FUTEX_WAKE_PRIVATE : FUTEX_WAKE,
+          INT_MAX, nullptr, nullptr, 0);
+#else
+  (void)word;
+  (void)process_private;
+#endif
+}
+
+// Called after every value update. The fence pairs with the one a waiter
+// issues after registering as a sleeper: either the waiter sees the new value
+// or this sees the sleeper.
+void Notify(amd_signal_t *signal)
+{
+  fence_seq_cst();
+  if (load_relaxed(SleeperCount(signal)) != 0) {
+    fetch_add(SleepWord(signal), 1u);
+    // Signals may live in memory shared with another process.
+    WakeAll(SleepWord(signal), false);
+  }
+  if (load_relaxed(&g_any_sleepers) != 0) {
+    fetch_add(&g_any_epoch, 1u);
+    WakeAll(&g_any_epoch, true);
+  }
+}
+
+// Runs the spin, yield and sleep phases until @p check returns true or the
+// timeout passes. Returns the result of the last check.
+template<class Check>
+bool WaitPhases(Check check, uint64_t timeout_ns, hsa_wait_state_t wait_state_hint,
+                volatile uint32_t *sleep_word, volatile uint32_t *sleepers, bool process_private)
+{
+  if (check()) {
+    return true;
+  }
+
+  const WaitPolicy policy = GetWaitPolicy();
+  const bool forever = (timeout_ns == UINT64_MAX);
+  const Clock::time_point start = Clock::now();
+  const auto elapsed_ns = [&start]() {
+    return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+  };
+
+  // Spin. The iteration count comes from calibration, so the clock is only
+  // read occasionally, for the timeout.
+  const uint64_t spins = uint64_t(policy.spin_ns) * PausesPerMicrosecond() / 1000;
+  for (uint64_t i = 1; i <= spins; ++i) {
+    cpu_relax();
+    if (check()) {
+      return true;
+    }
+    if ((i % 256) == 0 && !forever && elapsed_ns() >= timeout_ns) {
+      return false;
+    }
+  }
+
+  // Pause and yield. Active waits stay here until the condition or timeout.
+  const uint64_t active_ns = uint64_t(policy.spin_ns) + policy.yield_ns;
+  for (;;) {
+    cpu_relax();
+    std::this_thread::yield();
+    if (check()) {
+      return true;
+    }
+    const uint64_t elapsed = elapsed_ns();
+    if (!forever && elapsed >= timeout_ns) {
+      return false;
+    }
+    if (wait_state_hint == HSA_WAIT_STATE_BLOCKED && elapsed >= active_ns) {
+      break;
+    }
+  }
+
+  // Sleep. The sequence word is read before the value, so a notify that
+  // lands in between makes the sleep return at once.
+  fetch_add(sleepers, 1u);
+  fence_seq_cst();
+  bool met = false;
+  for (;;) {
+    const uint32_t sequence = load_acquire(sleep_word);
+    if (check()) {
+      met = true;
+      break;
+    }
+    const uint64_t elapsed = elapsed_ns();
+    if (!forever && elapsed >= timeout_ns) {
+      break;
+    }
+    uint64_t quantum = policy.sleep_quantum_ns;
+    if (!forever) {
+      quantum = (std::min)(quantum, timeout_ns - elapsed);
+    }
+    SleepOn(sleep_word, sequence, quantum, process_private);
+  }
+  fetch_add(sleepers, ~0u);
+  return met;
+}
+
+} // namespace anonymous
+
+WaitPolicy GetWaitPolicy()
+{
+  WaitPolicy policy;
+  policy.spin_ns = g_spin_ns.load(std::memory_order_relaxed);
+  policy.yield_ns = g_yield_ns.load(std::memory_order_relaxed);
+  policy.sleep_quantum_ns = g_sleep_quantum_ns.load(std::memory_order_relaxed);
+  return policy;
+}
+
+void SetWaitPolicy(const WaitPolicy &policy)
+{
+  g_spin_ns.store(policy.spin_ns, std::memory_order_relaxed);
+  g_yield_ns.store(policy.yield_ns, std::memory_order_relaxed);
+  g_sleep_quantum_ns.store((std::max)(policy.sleep_quantum_ns, 1000u), std::memory_order_relaxed);
+}
+
+uint32_t PausesPerMicrosecond()
+{
+  static const uint32_t pauses_per_us = []() {
+    // Best of a few short runs, to filter out preemption.
+    const uint32_t pauses = 10000;
+    uint64_t best_ns = UINT64_MAX;
+    for (int run = 0; run < 3; ++run) {
+      const Clock::time_point start = Clock::now();
+      for (uint32_t i = 0; i < pauses; ++i) {
+        cpu_relax();
+      }
+      const uint64_t ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+      best_ns = (std::min)(best_ns, ns);
+    }
+    return static_cast<uint32_t>((std::max)(uint64_t(1), uint64_t(pauses) * 1000 / (std::max)(best_ns, uint64_t(1))));
+  }();
+  return pauses_per_us;
+}
+
+bool SignalConditionMet(hsa_signal_condition_t condition, hsa_signal_value_t value,
+                        hsa_signal_value_t compare_value)
+{
+  switch (condition) {
+  case HSA_SIGNAL_CONDITION_EQ:  return value == compare_value;
+  case HSA_SIGNAL_CONDITION_NE:  return value != compare_value;
+  case HSA_SIGNAL_CONDITION_LT:  return value < compare_value;
+  case HSA_SIGNAL_CONDITION_GTE: return value >= compare_value;
+  default:                       return false;
+  }
+}
+
+void SignalStore(amd_signal_t *signal, hsa_signal_value_t value)
+{
+  store_release(&signal->value, static_cast<int64_t>(value));
+  Notify(signal);
+}
+
+void SignalAdd(amd_signal_t *signal, hsa_signal_value_t value)
+{
+  fetch_add(&signal->value, static_cast<int64_t>(value));
+  Notify(signal);
+}
+
+void SignalSubtract(amd_signal_t *signal, hsa_signal_value_t value)
+{
+  fetch_add(&signal->value, -static_cast<int64_t>(value));
+  Notify(signal);
+}
+
+hsa_signal_value_t SignalWait(amd_signal_t *signal, hsa_signal_condition_t condition,
+                              hsa_signal_value_t compare_value, uint64_t timeout_ns,
+                              hsa_wait_state_t wait_state_hint)
+{
+  hsa_signal_value_t value = 0;
+  const auto check = [&]() {
+    value = static_cast<hsa_signal_value_t>(load_acquire(&signal->value));
+    return SignalConditionMet(condition, value, compare_value);
+  };
+  WaitPhases(check, timeout_ns, wait_state_hint, SleepWord(signal), SleeperCount(signal), false);
+  return value;
+}
+
+uint32_t SignalWaitAny(uint32_t count, amd_signal_t *const *signals,
+                       const hsa_signal_condition_t *conditions,
+                       const hsa_signal_value_t *compare_values, uint64_t timeout_ns,
+                       hsa_wait_state_t wait_state_hint, hsa_signal_value_t *satisfying_value)
+{
+  uint32_t index = UINT32_MAX;
+  hsa_signal_value_t value = 0;
+  const auto check = [&]() {
+    for (uint32_t i = 0; i < count; ++i) {
+      value = static_cast<hsa_signal_value_t>(load_acquire(&signals[i]->value));
+      if (SignalConditionMet(conditions[i], value, compare_values[i])) {
+        index = i;
+        return true;
+      }
+    }
+    return false;
+  };
+  if (WaitPhases(check, timeout_ns, wait_state_hint, &g_any_epoch, &g_any_sleepers, true) &&
+      satisfying_value != nullptr) {
+    *satisfying_value = value;
+  }
+  return index;
+}
+
+} // namespace aql
+} // namespace hsa
+} // namespace amd
@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef AMD_SIGNAL_WAIT_HPP
+#define AMD_SIGNAL_WAIT_HPP
+
+#include <cstdint>
+#include "hsa.h"
+#include "amd_hsa_signal.h"
+
+namespace amd {
+namespace hsa {
+namespace aql {
+
+/// @brief Host-side wait engine for user signals in host memory.
+///
+/// A wait polls the signal value in three phases: a spin calibrated to the
+/// cost of the pause instruction, then pause and yield, then (for
+/// HSA_WAIT_STATE_BLOCKED only) a sleep on a futex on Linux or a short sleep
+/// elsewhere. HSA_WAIT_STATE_ACTIVE waits never leave the second phase.
+///
+/// Sleeping waiters are only woken by writers that use the SignalStore(),
+/// SignalAdd() and SignalSubtract() functions below. Writers that update the
+/// value directly (for example an agent) wake them no later than the sleep
+/// quantum of the third phase.
+///
+/// Host signals have no event mailbox, so the engine uses the event_id field
+/// as the futex sequence word and reserved1 as the count of sleeping waiters.
+/// Signals with an event mailbox must not be used with these functions.
+
+struct WaitPolicy {
+  // Length of the pure polling phase.
+  uint32_t spin_ns;
+  // Length of the pause-and-yield phase that follows.
+  uint32_t yield_ns;
+  // Longest single sleep of the blocked phase. Bounds the wakeup latency of
+  // writers that do not notify.
+  uint32_t sleep_quantum_ns;
+};
+
+// Process-wide policy used by SignalWait() and SignalWaitAny().
+WaitPolicy GetWaitPolicy();
+void SetWaitPolicy(const WaitPolicy &policy);
+
+// Number of pause instructions per microsecond, measured once per process.
+uint32_t PausesPerMicrosecond();
+
+// Returns true if @p value satisfies @p condition against @p compare_value.
+bool SignalConditionMet(hsa_signal_condition_t condition, hsa_signal_value_t value,
+                        hsa_signal_value_t compare_value);
+
+// Updates the value with release ordering and wakes sleeping waiters.
+void SignalStore(amd_signal_t *signal, hsa_signal_value_t value);
+void SignalAdd(amd_signal_t *signal, hsa_signal_value_t value);
+void SignalSubtract(amd_signal_t *signal, hsa_signal_value_t value);
+
+// Waits with acquire ordering until the signal value satisfies @p condition
+// or @p timeout_ns nanoseconds have passed (UINT64_MAX waits forever).
+// Returns the last value observed, which might not satisfy the condition.
+hsa_signal_value_t SignalWait(amd_signal_t *signal, hsa_signal_condition_t condition,
+                              hsa_signal_value_t compare_value, uint64_t timeout_ns,
+                              hsa_wait_state_t wait_state_hint);
+
+// Waits until any of @p count signals satisfies its condition. Returns the
+// index of that signal and stores its value in @p satisfying_value (if not
+// null), or returns UINT32_MAX on timeout.
+uint32_t SignalWaitAny(uint32_t count, amd_signal_t *const *signals,
+                       const hsa_signal_condition_t *conditions,
+                       const hsa_signal_value_t *compare_values, uint64_t timeout_ns,
+                       hsa_wait_state_t wait_state_hint, hsa_signal_value_t *satisfying_value);
+
+} // namespace aql
+} // namespace hsa
+} // namespace amd
+
+#endif // AMD_SIGNAL_WAIT_HPP
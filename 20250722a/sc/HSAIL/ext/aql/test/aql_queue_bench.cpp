@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+
+// Multi-producer submission throughput: several threads submit kernel
+// dispatches in batches through one Producer while a CpuPacketProcessor
+// drains the queue. Reports packets per second and doorbell writes per
+// packet, which shows how much doorbell coalescing saves as producers are
+// added.
+//
+// Usage: aql_queue_bench [packets] [queue size]
+
+#include "aql_test.hpp"
+
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace amd::hsa::aql;
+using namespace amd::hsa::aql::test;
+
+int main(int argc, char **argv)
+{
+  const uint64_t packets = argc > 1 ? strtoull(argv[1], nullptr, 10) : 2000000;
+  const uint32_t queue_size = argc > 2 ? uint32_t(atoi(argv[2])) : 1024;
+
+  printf("%u hardware threads, queue size %u\n", std::thread::hardware_concurrency(), queue_size);
+  printf("%6s %10s %12s %12s %16s\n", "batch", "producers", "packets", "Mpackets/s", "doorbells/packet");
+  for (uint32_t batch : { 1u, 8u, 32u }) {
+    for (uint32_t producers : { 1u, 2u, 4u, 8u }) {
+      HostQueue *host = HostQueue::Create(queue_size);
+      if (host == nullptr || batch > queue_size) {
+        fprintf(stderr, "aql_queue_bench: bad queue size %u\n", queue_size);
+        return 1;
+      }
+      const uint64_t rounds = packets / producers / batch;
+      const uint64_t total = rounds * producers * batch;
+      UserSignal done(static_cast<hsa_signal_value_t>(total));
+      CpuPacketProcessor processor(host->Queue());
+      Producer producer(host->Queue());
+      processor.Start();
+
+      const auto start = std::chrono::steady_clock::now();
+      std::vector<std::thread> threads;
+      for (uint32_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&]() {
+          const std::vector<hsa_kernel_dispatch_packet_t> batch_packets(batch, DispatchPacket(done.Handle()));
+          for (uint64_t r = 0; r < rounds; ++r) {
+            producer.Submit(batch_packets.data(), batch);
+          }
+        });
+      }
+      for (std::thread &thread : threads) {
+        thread.join();
+      }
+      SignalWait(done.Get(), HSA_SIGNAL_CONDITION_EQ, 0, UINT64_MAX, HSA_WAIT_STATE_ACTIVE);
+      const double us = ElapsedUs(start);
+      processor.Stop();
+
+      printf("%6u %10u %12llu %12.2f %16.3f\n", batch, producers, static_cast<unsigned long long>(total),
+             total / us, double(producer.DoorbellWrites()) / total);
+      HostQueue::Destroy(host);
+    }
+  }
+  return 0;
+}
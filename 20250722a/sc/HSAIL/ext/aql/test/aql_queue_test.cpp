@@ -0,0 +1,281 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+
+// Checks Producer and CpuPacketProcessor: with several producers racing on a
+// small ring every packet is processed exactly once and in each producer's
+// order, completion signals reach zero, a full ring refuses reservations,
+// doorbell writes are coalesced, and barrier packets hold back the packets
+// behind them until their dependencies are met.
+//
+// Usage: aql_queue_test
+
+#include "aql_test.hpp"
+
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace amd::hsa::aql;
+using namespace amd::hsa::aql::test;
+
+namespace {
+
+// Packets carry (producer << 32 | sequence number) in kernarg_address.
+struct Tracker {
+  explicit Tracker(uint32_t producers) : next(producers, 0), out_of_order(0), unknown(0), dispatches(0) {}
+
+  std::vector<uint64_t> next;
+  uint64_t out_of_order;
+  uint64_t unknown;
+  uint64_t dispatches;
+};
+
+void Track(const hsa_kernel_dispatch_packet_t *packet, void *data)
+{
+  // Runs on the packet processor thread only.
+  Tracker *tracker = static_cast<Tracker*>(data);
+  const uint64_t tag = reinterpret_cast<uint64_t>(packet->kernarg_address);
+  const uint32_t producer = static_cast<uint32_t>(tag >> 32);
+  ++tracker->dispatches;
+  if (producer >= tracker->next.size()) {
+    ++tracker->unknown;
+  } else if (static_cast<uint32_t>(tag) != tracker->next[producer]++) {
+    ++tracker->out_of_order;
+  }
+}
+
+void TestProducers(uint32_t queue_size, uint32_t producers, uint32_t packets_per_producer)
+{
+  HostQueue *host = HostQueue::Create(queue_size);
+  AQL_CHECK(host != nullptr);
+  if (!host) { return; }
+  amd_queue_t *queue = host->Queue();
+
+  Tracker tracker(producers);
+  CpuPacketProcessor processor(queue, Track, &tracker);
+  Producer producer(queue);
+
+  // Even-numbered packets complete on their producer's signal, odd ones on
+  // a signal shared by all producers.
+  const uint64_t total = uint64_t(producers) * packets_per_producer;
+  UserSignal all_done(static_cast<hsa_signal_value_t>(producers * (packets_per_producer / 2)));
+  std::vector<UserSignal*> done;
+  for (uint32_t p = 0; p < producers; ++p) {
+    done.push_back(new UserSignal(packets_per_producer - packets_per_producer / 2));
+  }
+
+  processor.Start();
+  std::vector<std::thread> threads;
+  for (uint32_t p = 0; p < producers; ++p) {
+    threads.emplace_back([&, p]() {
+      std::mt19937 random(p + 1);
+      const uint32_t max_batch = std::min<uint32_t>(16, queue_size);
+      std::vector<hsa_kernel_dispatch_packet_t> packets;
+      std::vector<uint32_t> headers;
+      uint32_t sent = 0;
+      while (sent < packets_per_producer) {
+        const uint32_t batch = std::min<uint32_t>(1 + random() % max_batch, packets_per_producer - sent);
+        packets.clear();
+        for (uint32_t i = 0; i < batch; ++i) {
+          hsa_kernel_dispatch_packet_t packet = DispatchPacket((sent + i) % 2 ? all_done.Handle() : done[p]->Handle());
+          packet.kernarg_address = reinterpret_cast<void*>((uint64_t(p) << 32) | (sent + i));
+          packets.push_back(packet);
+        }
+
+        // Even producers use Submit(); odd ones the reserve/fill/publish path.
+        if (p % 2 == 0) {
+          producer.Submit(packets.data(), batch);
+        } else {
+          const uint64_t first_id = producer.Reserve(batch);
+          headers.clear();
+          for (uint32_t i = 0; i < batch; ++i) {
+            uint8_t *slot = static_cast<uint8_t*>(producer.Slot(first_id + i));
+            memcpy(slot + sizeof(uint32_t), reinterpret_cast<const uint8_t*>(&packets[i]) + sizeof(uint32_t),
+                   kPacketBytes - sizeof(uint32_t));
+            headers.push_back(packets[i].header | (uint32_t(packets[i].setup) << 16));
+          }
+          producer.Publish(first_id, batch, headers.data());
+          producer.RingDoorbell(first_id + batch - 1);
+        }
+        sent += batch;
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  const uint64_t kTimeoutNs = 30000000000ull;
+  for (uint32_t p = 0; p < producers; ++p) {
+    AQL_CHECK(SignalWait(done[p]->Get(), HSA_SIGNAL_CONDITION_EQ, 0, kTimeoutNs, HSA_WAIT_STATE_BLOCKED) == 0);
+  }
+  AQL_CHECK(SignalWait(all_done.Get(), HSA_SIGNAL_CONDITION_EQ, 0, kTimeoutNs, HSA_WAIT_STATE_BLOCKED) == 0);
+  processor.Stop();
+
+  AQL_CHECK(processor.PacketsProcessed() == total);
+  AQL_CHECK(tracker.dispatches == total);
+  AQL_CHECK(tracker.out_of_order == 0);
+  AQL_CHECK(tracker.unknown == 0);
+  for (uint32_t p = 0; p < producers; ++p) {
+    AQL_CHECK(tracker.next[p] == packets_per_producer);
+  }
+  AQL_CHECK(queue->write_dispatch_id == total);
+  AQL_CHECK(queue->read_dispatch_id == total);
+  AQL_CHECK(producer.DoorbellWrites() >= 1 && producer.DoorbellWrites() <= total);
+
+  // Every slot is handed back invalid.
+  const uint8_t *ring = static_cast<const uint8_t*>(queue->hsa_queue.base_address);
+  for (uint32_t i = 0; i < queue_size; ++i) {
+    uint32_t header;
+    memcpy(&header, ring + size_t(i) * kPacketBytes, sizeof(header));
+    AQL_CHECK(((header >> HSA_PACKET_HEADER_TYPE) & 0xff) == HSA_PACKET_TYPE_INVALID);
+  }
+
+  for (UserSignal *signal : done) {
+    delete signal;
+  }
+  HostQueue::Destroy(host);
+}
+
+void TestRingFull()
+{
+  HostQueue *host = HostQueue::Create(8);
+  Producer producer(host->Queue());
+  uint64_t first_id = ~0ull;
+  AQL_CHECK(producer.TryReserve(5, &first_id) && first_id == 0);
+  AQL_CHECK(!producer.TryReserve(4, &first_id));
+  AQL_CHECK(producer.TryReserve(3, &first_id) && first_id == 5);
+  AQL_CHECK(!producer.TryReserve(1, &first_id));
+
+  // Publish everything without completion signals and drain the ring.
+  std::vector<uint32_t> headers(8, MakeHeader(HSA_PACKET_TYPE_KERNEL_DISPATCH));
+  producer.Publish(0, 8, headers.data());
+  producer.RingDoorbell(7);
+  CpuPacketProcessor processor(host->Queue());
+  processor.Start();
+  while (processor.PacketsProcessed() != 8) {
+    std::this_thread::yield();
+  }
+  AQL_CHECK(producer.TryReserve(8, &first_id) && first_id == 8);
+  processor.Stop();
+  HostQueue::Destroy(host);
+}
+
+void TestDoorbellCoalescing()
+{
+  HostQueue *host = HostQueue::Create(16);
+  Producer producer(host->Queue());
+  const amd_signal_t *doorbell =
+    reinterpret_cast<const amd_signal_t*>(static_cast<uintptr_t>(host->Queue()->hsa_queue.doorbell_signal.handle));
+  producer.RingDoorbell(5);
+  AQL_CHECK(producer.DoorbellWrites() == 1 && doorbell->value == 5);
+  producer.RingDoorbell(3);
+  producer.RingDoorbell(5);
+  AQL_CHECK(producer.DoorbellWrites() == 1 && doorbell->value == 5);
+  producer.RingDoorbell(6);
+  AQL_CHECK(producer.DoorbellWrites() == 2 && doorbell->value == 6);
+  HostQueue::Destroy(host);
+}
+
+void TestBarriers()
+{
+  HostQueue *host = HostQueue::Create(16);
+  Tracker tracker(1);
+  CpuPacketProcessor processor(host->Queue(), Track, &tracker);
+  Producer producer(host->Queue());
+  UserSignal dep_a(1), dep_b(1), done(4);
+  processor.Start();
+
+  for (hsa_packet_type_t type : { HSA_PACKET_TYPE_BARRIER_AND, HSA_PACKET_TYPE_BARRIER_OR }) {
+    const uint64_t processed = processor.PacketsProcessed();
+    SignalStore(dep_a.Get(), 1);
+    SignalStore(dep_b.Get(), 1);
+
+    // A barrier on both signals, then a dispatch that must wait behind it.
+    const uint64_t id = producer.Reserve(2);
+    hsa_barrier_and_packet_t *barrier = static_cast<hsa_barrier_and_packet_t*>(producer.Slot(id));
+    memset(reinterpret_cast<uint8_t*>(barrier) + sizeof(uint32_t), 0, kPacketBytes - sizeof(uint32_t));
+    barrier->dep_signal[1] = dep_a.Handle();
+    barrier->dep_signal[3] = dep_b.Handle();
+    barrier->completion_signal = done.Handle();
+    hsa_kernel_dispatch_packet_t dispatch = DispatchPacket(done.Handle());
+    dispatch.kernarg_address = reinterpret_cast<void*>(static_cast<uintptr_t>(tracker.next[0]));
+    memcpy(static_cast<uint8_t*>(producer.Slot(id + 1)) + sizeof(uint32_t),
+           reinterpret_cast<const uint8_t*>(&dispatch) + sizeof(uint32_t), kPacketBytes - sizeof(uint32_t));
+    const uint32_t headers[2] = { MakeHeader(type), MakeHeader(HSA_PACKET_TYPE_KERNEL_DISPATCH) };
+    producer.Publish(id, 2, headers);
+    producer.RingDoorbell(id + 1);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    AQL_CHECK(processor.PacketsProcessed() == processed);
+    SignalStore(dep_b.Get(), 0);
+    if (type == HSA_PACKET_TYPE_BARRIER_AND) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      AQL_CHECK(processor.PacketsProcessed() == processed);
+      SignalStore(dep_a.Get(), 0);
+    }
+    const hsa_signal_value_t expected = done.Load() - 2;
+    AQL_CHECK(SignalWait(done.Get(), HSA_SIGNAL_CONDITION_EQ, expected, 30000000000ull, HSA_WAIT_STATE_BLOCKED) ==
+              expected);
+    AQL_CHECK(processor.PacketsProcessed() == processed + 2);
+  }
+  processor.Stop();
+  AQL_CHECK(tracker.dispatches == 2 && tracker.out_of_order == 0);
+  HostQueue::Destroy(host);
+}
+
+} // namespace
+
+int main()
+{
+  TestRingFull();
+  TestDoorbellCoalescing();
+  TestBarriers();
+  TestProducers(1024, 1, 20000);
+  TestProducers(64, 4, 20000);
+  TestProducers(16, 8, 4999);
+  if (failures != 0) {
+    fprintf(stderr, "aql_queue_test: %d checks failed\n", failures);
+    return 1;
+  }
+  printf("aql_queue_test: passed\n");
+  return 0;
+}
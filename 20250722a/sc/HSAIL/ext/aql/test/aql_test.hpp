@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+
+// Helpers shared by the AQL tests and benchmarks: a check macro, timing and
+// user signals in host memory.
+
+#ifndef AMD_AQL_TEST_HPP
+#define AMD_AQL_TEST_HPP
+
+#include "amd_aql_queue.hpp"
+#include "amd_signal_wait.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace amd {
+namespace hsa {
+namespace aql {
+namespace test {
+
+static int failures = 0;
+
+#define AQL_CHECK(cond)                                                         \
+  do {                                                                          \
+    if (!(cond)) {                                                              \
+      fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);  \
+      ++amd::hsa::aql::test::failures;                                          \
+    }                                                                           \
+  } while (false)
+
+inline double ElapsedUs(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// @brief User signal in host memory, usable with the functions in
+/// amd_signal_wait.hpp and as a packet completion or dependency signal.
+class UserSignal final {
+public:
+  explicit UserSignal(hsa_signal_value_t value = 0)
+  {
+    memset(&signal_, 0, sizeof(signal_));
+    signal_.kind = AMD_SIGNAL_KIND_USER;
+    signal_.value = value;
+  }
+
+  amd_signal_t *Get() { return &signal_; }
+
+  hsa_signal_t Handle() const
+  {
+    hsa_signal_t handle = { static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&signal_)) };
+    return handle;
+  }
+
+  hsa_signal_value_t Load() const { return __atomic_load_n(&signal_.value, __ATOMIC_ACQUIRE); }
+
+private:
+  UserSignal(const UserSignal&);
+  UserSignal& operator=(const UserSignal&);
+
+  amd_signal_t signal_;
+};
+
+/// @brief Returns a kernel dispatch packet whose header field holds the
+/// header word for Producer::Submit(), completing on @p completion.
+inline hsa_kernel_dispatch_packet_t DispatchPacket(hsa_signal_t completion)
+{
+  hsa_kernel_dispatch_packet_t packet;
+  memset(&packet, 0, sizeof(packet));
+  const uint32_t header = MakeHeader(HSA_PACKET_TYPE_KERNEL_DISPATCH);
+  packet.header = static_cast<uint16_t>(header);
+  packet.setup = static_cast<uint16_t>(header >> 16);
+  packet.grid_size_x = 1;
+  packet.completion_signal = completion;
+  return packet;
+}
+
+} // namespace test
+} // namespace aql
+} // namespace hsa
+} // namespace amd
+
+#endif // AMD_AQL_TEST_HPP
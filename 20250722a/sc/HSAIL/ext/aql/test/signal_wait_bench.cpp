@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+
+// Wake-up latency and CPU burn of SignalWait(): a waiter thread waits on a
+// signal that another thread satisfies after a delay, for every condition
+// and for ACTIVE and BLOCKED waits. Latency is measured from the store to
+// the waiter's return; CPU burn is the waiter's CPU time as a share of the
+// wall time of the wait.
+//
+// Usage: signal_wait_bench [iterations]
+//
+// Short delays end in the spin phase, long ones in the yield phase (ACTIVE)
+// or on the futex (BLOCKED).
+
+#include "aql_test.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <initializer_list>
+#include <thread>
+
+#if defined(__linux__)
+#include <time.h>
+#endif
+
+using namespace amd::hsa::aql;
+using namespace amd::hsa::aql::test;
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// CPU time of the calling thread in microseconds, or 0 where unavailable.
+double ThreadCpuUs()
+{
+#if defined(__linux__)
+  struct timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+#else
+  return 0;
+#endif
+}
+
+struct ConditionCase {
+  const char *name;
+  hsa_signal_condition_t condition;
+  hsa_signal_value_t compare, initial, met;
+};
+
+const ConditionCase kConditions[] = {
+  { "EQ",  HSA_SIGNAL_CONDITION_EQ,  0, 1, 0 },
+  { "NE",  HSA_SIGNAL_CONDITION_NE,  1, 1, 0 },
+  { "LT",  HSA_SIGNAL_CONDITION_LT,  1, 1, 0 },
+  { "GTE", HSA_SIGNAL_CONDITION_GTE, 1, 0, 1 },
+};
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  const int iterations = argc > 1 ? atoi(argv[1]) : 200;
+  const WaitPolicy policy = GetWaitPolicy();
+
+  printf("%u hardware threads, %u pauses/us, spin %u ns, yield %u ns, sleep quantum %u ns\n",
+         std::thread::hardware_concurrency(), PausesPerMicrosecond(), policy.spin_ns, policy.yield_ns,
+         policy.sleep_quantum_ns);
+  printf("%10s %8s %5s %14s %14s %10s\n", "delay us", "state", "cond", "mean wake us", "max wake us", "cpu %");
+  for (uint32_t delay_us : { 1u, 10u, 100u, 2000u }) {
+    for (hsa_wait_state_t wait_state : { HSA_WAIT_STATE_ACTIVE, HSA_WAIT_STATE_BLOCKED }) {
+      for (const ConditionCase &c : kConditions) {
+        // Keep each row to roughly the same wall time.
+        const int runs = delay_us >= 1000 ? (std::max)(iterations / 10, 1) : iterations;
+        double wake_us = 0, max_wake_us = 0, cpu_us = 0, wall_us = 0;
+        for (int run = 0; run < runs; ++run) {
+          UserSignal signal(c.initial);
+          std::atomic<bool> started(false);
+          Clock::time_point began, woke;
+          double waiter_cpu_us = 0;
+          std::thread waiter([&]() {
+            const double cpu_start = ThreadCpuUs();
+            began = Clock::now();
+            started.store(true, std::memory_order_release);
+            SignalWait(signal.Get(), c.condition, c.compare, UINT64_MAX, wait_state);
+            woke = Clock::now();
+            waiter_cpu_us = ThreadCpuUs() - cpu_start;
+          });
+          while (!started.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+          }
+          const Clock::time_point start = Clock::now();
+          while (ElapsedUs(start) < delay_us) {
+            std::this_thread::yield();
+          }
+          const Clock::time_point stored = Clock::now();
+          SignalStore(signal.Get(), c.met);
+          waiter.join();
+
+          const double us = std::chrono::duration<double, std::micro>(woke - stored).count();
+          wake_us += us;
+          max_wake_us = (std::max)(max_wake_us, us);
+          cpu_us += waiter_cpu_us;
+          wall_us += std::chrono::duration<double, std::micro>(woke - began).count();
+        }
+        printf("%10u %8s %5s %14.1f %14.1f %10.1f\n", delay_us,
+               wait_state == HSA_WAIT_STATE_ACTIVE ? "ACTIVE" : "BLOCKED", c.name, wake_us / runs, max_wake_us,
+               100 * cpu_us / wall_us);
+      }
+    }
+  }
+  return 0;
+}
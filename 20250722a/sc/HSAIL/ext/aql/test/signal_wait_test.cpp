@@ -0,0 +1,282 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+
+// Checks the signal wait engine: every condition is met in both wait states,
+// timeouts expire and return the last value, a notifying writer wakes a
+// waiter asleep on the futex long before the sleep quantum ends, and
+// SignalWaitAny reports the first satisfied signal.
+//
+// Usage: signal_wait_test
+
+#include "aql_test.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace amd::hsa::aql;
+using namespace amd::hsa::aql::test;
+
+namespace {
+
+const uint64_t kForeverNs = UINT64_MAX;
+const hsa_wait_state_t kWaitStates[] = { HSA_WAIT_STATE_ACTIVE, HSA_WAIT_STATE_BLOCKED };
+
+// Per condition: a starting value that does not satisfy it, an intermediate
+// value that still does not, and a final value that does.
+struct ConditionCase {
+  hsa_signal_condition_t condition;
+  hsa_signal_value_t compare, initial, still_unmet, met;
+};
+
+const ConditionCase kConditions[] = {
+  { HSA_SIGNAL_CONDITION_EQ,  0,  5,  1,  0 },
+  { HSA_SIGNAL_CONDITION_NE,  7,  7,  7,  -3 },
+  { HSA_SIGNAL_CONDITION_LT,  1,  1,  4,  0 },
+  { HSA_SIGNAL_CONDITION_GTE, 10, 9,  -1, 10 },
+};
+
+void TestConditionMet()
+{
+  AQL_CHECK(SignalConditionMet(HSA_SIGNAL_CONDITION_EQ, 3, 3));
+  AQL_CHECK(!SignalConditionMet(HSA_SIGNAL_CONDITION_EQ, 3, 4));
+  AQL_CHECK(SignalConditionMet(HSA_SIGNAL_CONDITION_NE, 3, 4));
+  AQL_CHECK(!SignalConditionMet(HSA_SIGNAL_CONDITION_NE, 3, 3));
+  AQL_CHECK(SignalConditionMet(HSA_SIGNAL_CONDITION_LT, -1, 0));
+  AQL_CHECK(!SignalConditionMet(HSA_SIGNAL_CONDITION_LT, 0, 0));
+  AQL_CHECK(SignalConditionMet(HSA_SIGNAL_CONDITION_GTE, 0, 0));
+  AQL_CHECK(SignalConditionMet(HSA_SIGNAL_CONDITION_GTE, INT64_MAX, INT64_MIN));
+  AQL_CHECK(!SignalConditionMet(HSA_SIGNAL_CONDITION_GTE, -1, 0));
+}
+
+void TestConditions()
+{
+  for (const ConditionCase &c : kConditions) {
+    for (hsa_wait_state_t wait_state : kWaitStates) {
+      // Already satisfied: returns at once with the value.
+      UserSignal ready(c.met);
+      AQL_CHECK(SignalWait(ready.Get(), c.condition, c.compare, 0, wait_state) == c.met);
+
+      // Satisfied later by another thread, after an update that is not enough.
+      UserSignal signal(c.initial);
+      std::atomic<bool> started(false);
+      hsa_signal_value_t observed = c.initial;
+      std::thread waiter([&]() {
+        started.store(true);
+        observed = SignalWait(signal.Get(), c.condition, c.compare, kForeverNs, wait_state);
+      });
+      while (!started.load()) {
+        std::this_thread::yield();
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      SignalStore(signal.Get(), c.still_unmet);
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      SignalStore(signal.Get(), c.met);
+      waiter.join();
+      AQL_CHECK(observed == c.met);
+    }
+  }
+
+  // Add and subtract notify as well.
+  UserSignal counter(3);
+  std::thread waiter([&]() {
+    AQL_CHECK(SignalWait(counter.Get(), HSA_SIGNAL_CONDITION_EQ, 0, kForeverNs, HSA_WAIT_STATE_BLOCKED) == 0);
+  });
+  for (int i = 0; i < 3; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    SignalSubtract(counter.Get(), 2);
+    SignalAdd(counter.Get(), 1);
+  }
+  waiter.join();
+}
+
+void TestTimeouts()
+{
+  const uint64_t kTimeoutNs = 20000000;
+  for (const ConditionCase &c : kConditions) {
+    for (hsa_wait_state_t wait_state : kWaitStates) {
+      UserSignal signal(c.initial);
+      AQL_CHECK(SignalWait(signal.Get(), c.condition, c.compare, 0, wait_state) == c.initial);
+
+      const auto start = std::chrono::steady_clock::now();
+      AQL_CHECK(SignalWait(signal.Get(), c.condition, c.compare, kTimeoutNs, wait_state) == c.initial);
+      const double us = ElapsedUs(start);
+      AQL_CHECK(us >= kTimeoutNs / 1000);
+      // Generous, for loaded machines; a missed timeout waits forever.
+      AQL_CHECK(us < 2000000);
+    }
+  }
+}
+
+// With no spin or yield phase and a long sleep quantum, a waiter only wakes
+// early if the writer's notify reaches its futex.
+void TestNotifyWakesSleeper()
+{
+  const WaitPolicy saved = GetWaitPolicy();
+  WaitPolicy policy = { 0, 0, 4000000000u };
+  SetWaitPolicy(policy);
+
+  for (int notify = 0; notify < 2; ++notify) {
+    UserSignal signal(1);
+    std::atomic<bool> woke(false);
+    std::thread waiter([&]() {
+      SignalWait(signal.Get(), HSA_SIGNAL_CONDITION_EQ, 0, kForeverNs, HSA_WAIT_STATE_BLOCKED);
+      woke.store(true);
+    });
+
+    // The sleeper count goes up just before the futex wait.
+    while (__atomic_load_n(&signal.Get()->reserved1, __ATOMIC_ACQUIRE) == 0) {
+      std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    AQL_CHECK(!woke.load());
+
+    const auto start = std::chrono::steady_clock::now();
+    if (notify) {
+      SignalStore(signal.Get(), 0);
+      waiter.join();
+      AQL_CHECK(ElapsedUs(start) < 1000000);
+      AQL_CHECK(__atomic_load_n(&signal.Get()->reserved1, __ATOMIC_ACQUIRE) == 0);
+    } else {
+      // A writer that bypasses SignalStore() does not wake the sleeper; the
+      // next notify does.
+      __atomic_store_n(&signal.Get()->value, 0, __ATOMIC_RELEASE);
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      AQL_CHECK(!woke.load());
+      SignalAdd(signal.Get(), 0);
+      waiter.join();
+    }
+  }
+
+  // Several sleepers on one signal are all woken by one store.
+  UserSignal shared(1);
+  std::atomic<int> woken(0);
+  std::vector<std::thread> waiters;
+  for (int i = 0; i < 4; ++i) {
+    waiters.emplace_back([&]() {
+      if (SignalWait(shared.Get(), HSA_SIGNAL_CONDITION_LT, 1, kForeverNs, HSA_WAIT_STATE_BLOCKED) < 1) {
+        woken.fetch_add(1);
+      }
+    });
+  }
+  while (__atomic_load_n(&shared.Get()->reserved1, __ATOMIC_ACQUIRE) != 4) {
+    std::this_thread::yield();
+  }
+  const auto start = std::chrono::steady_clock::now();
+  SignalStore(shared.Get(), 0);
+  for (std::thread &waiter : waiters) {
+    waiter.join();
+  }
+  AQL_CHECK(woken.load() == 4);
+  AQL_CHECK(ElapsedUs(start) < 1000000);
+
+  SetWaitPolicy(saved);
+}
+
+void TestWaitAny()
+{
+  const WaitPolicy saved = GetWaitPolicy();
+  for (int sleep_first = 0; sleep_first < 2; ++sleep_first) {
+    if (sleep_first) {
+      // As above: only a notify on the shared wait-any word wakes it early.
+      WaitPolicy policy = { 0, 0, 4000000000u };
+      SetWaitPolicy(policy);
+    }
+    for (hsa_wait_state_t wait_state : kWaitStates) {
+      if (sleep_first && wait_state == HSA_WAIT_STATE_ACTIVE) {
+        continue;
+      }
+      UserSignal signals[4];
+      amd_signal_t *pointers[4];
+      hsa_signal_condition_t conditions[4];
+      hsa_signal_value_t compares[4];
+      for (int i = 0; i < 4; ++i) {
+        const ConditionCase &c = kConditions[i];
+        SignalStore(signals[i].Get(), c.initial);
+        pointers[i] = signals[i].Get();
+        conditions[i] = c.condition;
+        compares[i] = c.compare;
+      }
+
+      // Nothing satisfied: times out and leaves the value alone.
+      hsa_signal_value_t value = 12345;
+      AQL_CHECK(SignalWaitAny(4, pointers, conditions, compares, 5000000, wait_state, &value) == UINT32_MAX);
+      AQL_CHECK(value == 12345);
+
+      uint32_t index = UINT32_MAX;
+      std::thread waiter([&]() {
+        index = SignalWaitAny(4, pointers, conditions, compares, kForeverNs, wait_state, &value);
+      });
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      const auto start = std::chrono::steady_clock::now();
+      SignalStore(signals[2].Get(), kConditions[2].met);
+      waiter.join();
+      AQL_CHECK(index == 2 && value == kConditions[2].met);
+      AQL_CHECK(ElapsedUs(start) < 1000000);
+
+      // With several satisfied, the lowest index wins.
+      SignalStore(signals[3].Get(), kConditions[3].met);
+      SignalStore(signals[1].Get(), kConditions[1].met);
+      AQL_CHECK(SignalWaitAny(4, pointers, conditions, compares, 0, wait_state, &value) == 1);
+      AQL_CHECK(value == kConditions[1].met);
+      AQL_CHECK(SignalWaitAny(4, pointers, conditions, compares, 0, wait_state, nullptr) == 1);
+    }
+  }
+  SetWaitPolicy(saved);
+}
+
+} // namespace
+
+int main()
+{
+  AQL_CHECK(PausesPerMicrosecond() >= 1);
+  TestConditionMet();
+  TestConditions();
+  TestTimeouts();
+  TestNotifyWakesSleeper();
+  TestWaitAny();
+  if (failures != 0) {
+    fprintf(stderr, "signal_wait_test: %d checks failed\n", failures);
+    return 1;
+  }
+  printf("signal_wait_test: passed\n");
+  return 0;
+}
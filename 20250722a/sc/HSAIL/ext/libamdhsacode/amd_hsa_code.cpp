@@ -46,6 +46,7 @@
 #include <algorithm>
 #include "amd_hsa_code.hpp"
 #include "amd_hsa_code_util.hpp"
+#include "amd_hsa_target.hpp"
 #include <libelf.h>
 #include "amd_hsa_elf.h"
 #include <fstream>
@@ -556,58 +557,12 @@ namespace code {
 
     // TODO: Move isa registry into the loader.
     static bool GetMachInfo(unsigned mach, std::string &name, bool &sramecc_supported, bool &xnack_supported) {
-      switch (mach) {
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX700:  name = "gfx700";  xnack_supported = false; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX701:  name = "gfx701";  xnack_supported = false; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX702:  name = "gfx702";  xnack_supported = false; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX703:  name = "gfx703";  xnack_supported = false; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX704:  name = "gfx704";  xnack_supported = false; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX801:  name = "gfx801";  xnack_supported = true;  sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX802:  name = "gfx802";  xnack_supported = false; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX803:  name = "gfx803";  xnack_supported = false; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX810:  name = "gfx810";  xnack_supported = true;  sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX900:  name = "gfx900";  xnack_supported = true;  sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX902:  name = "gfx902";  xnack_supported = true;  sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX904:  name = "gfx904";  xnack_supported = true;  sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX906:  name = "gfx906";  xnack_supported = true;  sramecc_supported = true;  break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX908:  name = "gfx908";  xnack_supported = true;  sramecc_supported = true;  break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX90C:  name = "gfx90c";  xnack_supported = true;  sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX1000: name = "gfx1000"; xnack_supported = true;  sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX1010: name = "gfx1010"; xnack_supported = true;  sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX1011: name = "gfx1011"; xnack_supported = true;  sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX1012: name = "gfx1012"; xnack_supported = true;  sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX1030: name = "gfx1030"; xnack_supported = false; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX1031: name = "gfx1031"; xnack_supported = false; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX1032: name = "gfx1032"; xnack_supported = false; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX1033: name = "gfx1033"; xnack_supported = false; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX1034: name = "gfx1034"; xnack_supported = false; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX1035: name = "gfx1035"; xnack_supported = false; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX1036: name = "gfx1036"; xnack_supported = false; sramecc_supported = false; break;
-#if defined(GFX40_BUILD)
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX4000: name = "gfx4000"; xnack_supported = false; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX4010: name = "gfx4010"; xnack_supported = false; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX4020: name = "gfx4020"; xnack_supported = false; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX4030: name = "gfx4030"; xnack_supported = false; sramecc_supported = false; break;
-#endif // GFX40_BUILD
-#if defined(GFX11_BUILD)
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX1100: name = "gfx1100"; xnack_supported = false; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX1101: name = "gfx1101"; xnack_supported = false; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX1102: name = "gfx1102"; xnack_supported = false; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX1103: name = "gfx1103"; xnack_supported = false; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX1150: name = "gfx1150"; xnack_supported = false; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX1151: name = "gfx1151"; xnack_supported = false; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX1152: name = "gfx1152"; xnack_supported = false; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX11_GENERIC: name = "gfx11-generic"; xnack_supported = false; sramecc_supported = false; break;
-#endif // GFX11_BUILD
-#if defined(GFX12_BUILD)
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX1200: name = "gfx1200"; xnack_supported = false; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX1201: name = "gfx1201"; xnack_supported = false; sramecc_supported = false; break;
-#endif // GFX12_BUILD
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX9_GENERIC:    name = "gfx9-generic";    xnack_supported = true; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX10_1_GENERIC: name = "gfx10-1-generic"; xnack_supported = true; sramecc_supported = false; break;
-      case ELF::EF_AMDGPU_MACH_AMDGCN_GFX10_3_GENERIC: name = "gfx10-3-generic"; xnack_supported = false; sramecc_supported = false; break;
-      default: return false;
-      }
+      const TargetProcessor *processor = FindTargetProcessorByMach(mach);
+      if (!processor)
+        return false;
+      name = processor->name;
+      sramecc_supported = processor->sramecc_supported;
+      xnack_supported = processor->xnack_supported;
       return true;
     }
 
@@ -615,128 +570,12 @@ namespace code {
     static std::string ConvertOldTargetNameToNew(const std::string &old_name, bool is_finalizer, uint32_t e_flags) {
       assert(!old_name.empty() && "Expecting non-empty old name");
 
-      unsigned mach = 0;
-      if (old_name == "AMD:AMDGPU:7:0:0")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX700;
-      else if (old_name == "AMD:AMDGPU:7:0:1")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX701;
-      else if (old_name == "AMD:AMDGPU:7:0:2")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX702;
-      else if (old_name == "AMD:AMDGPU:7:0:3")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX703;
-      else if (old_name == "AMD:AMDGPU:7:0:4")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX704;
-      else if (old_name == "AMD:AMDGPU:8:0:1")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX801;
-      else if (old_name == "AMD:AMDGPU:8:0:0" || old_name == "AMD:AMDGPU:8:0:2")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX802;
-      else if (old_name == "AMD:AMDGPU:8:0:3" || old_name == "AMD:AMDGPU:8:0:4")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX803;
-      else if (old_name == "AMD:AMDGPU:8:1:0")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX810;
-      else if (old_name == "AMD:AMDGPU:9:0:0" || old_name == "AMD:AMDGPU:9:0:1")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX900;
-      else if (old_name == "AMD:AMDGPU:9:0:2" || old_name == "AMD:AMDGPU:9:0:3")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX902;
-      else if (old_name == "AMD:AMDGPU:9:0:4" || old_name == "AMD:AMDGPU:9:0:5")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX904;
-      else if (old_name == "AMD:AMDGPU:9:0:6" || old_name == "AMD:AMDGPU:9:0:7")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX906;
-      else if (old_name == "AMD:AMDGPU:9:0:12" || old_name == "AMD:AMDGPU:9:0:13")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX90C;
-      else if (is_finalizer && old_name == "AMD:AMDGPU:10:0:0")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX1000;
-      else if (is_finalizer && old_name == "AMD:AMDGPU:10:1:0")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX1010;
-      else if (is_finalizer && old_name == "AMD:AMDGPU:10:1:1")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX1011;
-      else if (is_finalizer && old_name == "AMD:AMDGPU:10:1:2")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX1012;
-      else if (is_finalizer && old_name == "AMD:AMDGPU:10:3:0")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX1030;
-      else if (is_finalizer && old_name == "AMD:AMDGPU:10:3:1")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX1031;
-      else if (is_finalizer && old_name == "AMD:AMDGPU:10:3:2")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX1032;
-      else if (is_finalizer && old_name == "AMD:AMDGPU:10:3:3")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX1033;
-      else if (is_finalizer && old_name == "AMD:AMDGPU:10:3:4")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX1034;
-      else if (is_finalizer && old_name == "AMD:AMDGPU:10:3:5")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX1035;
-      else if (is_finalizer && old_name == "AMD:AMDGPU:10:3:6")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX1036;
-#if defined(GFX40_BUILD)
-      else if (is_finalizer && old_name == "AMD:AMDGPU:40:0:0")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX4000;
-      else if (is_finalizer && old_name == "AMD:AMDGPU:40:1:0")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX4010;
-      else if (is_finalizer && old_name == "AMD:AMDGPU:40:2:0")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX4020;
-      else if (is_finalizer && old_name == "AMD:AMDGPU:40:3:0")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX4030;
-#endif // GFX40_BUILD
-#if defined(GFX11_BUILD)
-      else if (is_finalizer && old_name == "AMD:AMDGPU:11:0:0")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX1100;
-      else if (is_finalizer && old_name == "AMD:AMDGPU:11:0:1")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX1101;
-      else if (is_finalizer && old_name == "AMD:AMDGPU:11:0:2")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX1102;
-      else if (is_finalizer && old_name == "AMD:AMDGPU:11:0:3")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX1103;
-      else if (is_finalizer && old_name == "AMD:AMDGPU:11:5:0")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX1150;
-      else if (is_finalizer && old_name == "AMD:AMDGPU:11:5:1")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX1151;
-#endif // GFX11_BUILD
-#if defined(GFX12_BUILD)
-      else if (is_finalizer && old_name == "AMD:AMDGPU:12:0:0")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX1200;
-      else if (is_finalizer && old_name == "AMD:AMDGPU:12:0:1")
-        mach = ELF::EF_AMDGPU_MACH_AMDGCN_GFX1201;
-#endif // GFX12_BUILD
-      else {
-        // Code object v2 is still supported by the finalizer for GFX10+, but
-        // NOT the lightning compiler.
+      // Code object v2 is still supported by the finalizer for GFX10+, but
+      // NOT the lightning compiler.
+      TargetId id;
+      if (!ParseLegacyTargetName(old_name, is_finalizer, e_flags, &id))
         return "";
-      }
-      std::string name;
-      bool sramecc_supported = false;
-      bool xnack_supported = false;
-      if (!GetMachInfo(mach, name, sramecc_supported, xnack_supported))
-        return "";
-
-      // Only "AMD:AMDGPU:9:0:6" and "AMD:AMDGPU:9:0:7" supports SRAMECC for
-      // code object V2, and it must be OFF.
-      if (sramecc_supported)
-        name += ":sramecc-";
-
-      if (is_finalizer) {
-        if (e_flags & ELF::EF_AMDGPU_FEATURE_XNACK_V2)
-          name += ":xnack+";
-        else if (xnack_supported)
-          name += ":xnack-";
-      } else {
-        if (old_name == "AMD:AMDGPU:8:0:1")
-          name += ":xnack+";
-        else if (old_name == "AMD:AMDGPU:8:1:0")
-          name += ":xnack+";
-        else if (old_name == "AMD:AMDGPU:9:0:1")
-          name += ":xnack+";
-        else if (old_name == "AMD:AMDGPU:9:0:3")
-          name += ":xnack+";
-        else if (old_name == "AMD:AMDGPU:9:0:5")
-          name += ":xnack+";
-        else if (old_name == "AMD:AMDGPU:9:0:7")
-          name += ":xnack+";
-        else if (old_name == "AMD:AMDGPU:9:0:13")
-          name += ":xnack+";
-        else if (xnack_supported)
-          name += ":xnack-";
-      }
-
-      return name;
+      return TargetIdToString(id);
     }
 
     bool AmdHsaCode::GetIsa(std::string& isa_name, unsigned *genericVersion)
@@ -1284,6 +1123,95 @@ namespace code {
       out << "AMD HSA Code Object End" << std::endl;
     }
 
+    void AmdHsaCode::PrintParallel(std::ostream& out, PrintTaskRunner& runner, size_t max_parts)
+    {
+      if (!HasHsaText() || max_parts < 2) {
+        Print(out);
+        return;
+      }
+
+      std::ostringstream head;
+      head.copyfmt(out);
+      PrintNotes(head);
+      head << std::endl;
+      PrintSegments(head);
+      head << std::endl;
+      PrintSections(head);
+      head << std::endl;
+      PrintSymbols(head);
+      head << std::endl;
+      head << std::dec;
+
+      // The parts must not touch the image, so copy out everything they read.
+      struct KernelCode {
+        std::string name;
+        amd_kernel_code_t code;
+      };
+      std::vector<KernelCode> kernels;
+      for (size_t i = 0; i < SymbolCount(); ++i) {
+        Symbol* sym = GetSymbol(i);
+        if (sym->IsKernelSymbol() && sym->IsDefinition()) {
+          kernels.push_back(KernelCode());
+          kernels.back().name = sym->Name();
+          memset(&kernels.back().code, 0, sizeof(amd_kernel_code_t));
+          HsaText()->getData(sym->SectionOffset(), &kernels.back().code, sizeof(amd_kernel_code_t));
+        }
+      }
+      std::vector<uint8_t> isa(HsaText()->size(), 0);
+      HsaText()->getData(0, isa.data(), HsaText()->size());
+
+      // Every part sets the stream state it relies on, so each can start from
+      // the state at the end of the head.
+      size_t kernel_parts = std::min(max_parts, kernels.size());
+#if defined(NO_SI_SP3)
+      size_t rows = (isa.size() + 15) / 16;
+      size_t isa_parts = std::max<size_t>(1, std::min(max_parts, rows));
+#else
+      // sp3 lists the whole section in one pass.
+      size_t isa_parts = 1;
+#endif
+      std::vector<std::ostringstream> parts(kernel_parts + isa_parts);
+      for (std::ostringstream& part : parts) {
+        part.copyfmt(head);
+      }
+
+      for (size_t p = 0; p < kernel_parts; ++p) {
+        size_t first = kernels.size() * p / kernel_parts;
+        size_t last = kernels.size() * (p + 1) / kernel_parts;
+        std::ostringstream* part = &parts[p];
+        runner.Spawn([part, &kernels, first, last]() {
+          for (size_t i = first; i < last; ++i) {
+            PrintKernelCode(*part, kernels[i].name, kernels[i].code);
+          }
+        });
+      }
+
+      std::ostringstream* isa_head = &parts[kernel_parts];
+      *isa_head << "Disassembly:" << std::endl;
+#if defined(NO_SI_SP3)
+      for (size_t p = 0; p < isa_parts; ++p) {
+        size_t begin = rows * p / isa_parts * 16;
+        size_t end = rows * (p + 1) / isa_parts * 16;
+        std::ostringstream* part = &parts[kernel_parts + p];
+        runner.Spawn([part, &isa, begin, end]() {
+          PrintRawData(*part, isa.data(), isa.size(), begin, end);
+        });
+      }
+      runner.Wait();
+#else
+      PrintDisassembly(*isa_head, isa.data(), isa.size(), 0);
+      runner.Wait();
+#endif
+
+      out << head.str();
+      for (const std::ostringstream& part : parts) {
+        out << part.str();
+      }
+      out << std::endl << std::dec;
+      out << std::endl;
+      out << "AMD HSA Code Object End" << std::endl;
+    }
+
     void AmdHsaCode::PrintNotes(std::ostream& out)
     {
       {
@@ -1370,9 +1298,7 @@ namespace code {
           if (sym->IsKernelSymbol() && sym->IsDefinition()) {
             amd_kernel_code_t kernel_code;
             HsaText()->getData(sym->SectionOffset(), &kernel_code, sizeof(amd_kernel_code_t));
-            out << "AMD Kernel Code for " << sym->Name() << ": " << std::endl << std::dec;
-            PrintAmdKernelCode(out, &kernel_code);
-            out << std::endl;
+            PrintKernelCode(out, sym->Name(), kernel_code);
           }
         }
 
@@ -1446,8 +1372,15 @@ namespace code {
 
     void AmdHsaCode::PrintRawData(std::ostream& out, const unsigned char *data, size_t size)
     {
+      PrintRawData(out, data, size, 0, size);
+    }
+
+    void AmdHsaCode::PrintRawData(std::ostream& out, const unsigned char *data, size_t size, size_t begin, size_t end)
+    {
+      assert(begin % 16 == 0);
+      end = std::min(end, size);
       out << std::hex << std::right << std::setfill('0');
-      for (size_t i = 0; i < size; i += 16) {
+      for (size_t i = begin; i < end; i += 16) {
         out << "      " << std::setw(7) << i << ":";
 
         for (size_t j = 0; j < 16; j += 1) {
@@ -1484,6 +1417,13 @@ namespace code {
       out << std::dec;
     }
 
+    void AmdHsaCode::PrintKernelCode(std::ostream& out, const std::string& name, const amd_kernel_code_t& kernel_code)
+    {
+      out << "AMD Kernel Code for " << name << ": " << std::endl << std::dec;
+      PrintAmdKernelCode(out, &kernel_code);
+      out << std::endl;
+    }
+
     void AmdHsaCode::PrintSymbol(std::ostream& out, Symbol* sym)
     {
       out << "  Symbol " << sym->Name() << " (Index " << sym->Index() << "):" << std::endl;
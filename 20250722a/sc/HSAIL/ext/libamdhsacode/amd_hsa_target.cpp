@@ -0,0 +1,361 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "amd_hsa_target.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include "amd_hsa_elf.h"
+
+namespace amd {
+namespace hsa {
+
+namespace {
+
+// Known processors, sorted by name (strcmp order) for binary search. Keep
+// the order when adding entries; TargetProcessors() asserts it.
+const TargetProcessor kProcessors[] = {
+  { "gfx10-1-generic", ELF::EF_AMDGPU_MACH_AMDGCN_GFX10_1_GENERIC, true,  false },
+  { "gfx10-3-generic", ELF::EF_AMDGPU_MACH_AMDGCN_GFX10_3_GENERIC, false, false },
+  { "gfx1000",         ELF::EF_AMDGPU_MACH_AMDGCN_GFX1000,         true,  false },
+  { "gfx1010",         ELF::EF_AMDGPU_MACH_AMDGCN_GFX1010,         true,  false },
+  { "gfx1011",         ELF::EF_AMDGPU_MACH_AMDGCN_GFX1011,         true,  false },
+  { "gfx1012",         ELF::EF_AMDGPU_MACH_AMDGCN_GFX1012,         true,  false },
+  { "gfx1030",         ELF::EF_AMDGPU_MACH_AMDGCN_GFX1030,         false, false },
+  { "gfx1031",         ELF::EF_AMDGPU_MACH_AMDGCN_GFX1031,         false, false },
+  { "gfx1032",         ELF::EF_AMDGPU_MACH_AMDGCN_GFX1032,         false, false },
+  { "gfx1033",         ELF::EF_AMDGPU_MACH_AMDGCN_GFX1033,         false, false },
+  { "gfx1034",         ELF::EF_AMDGPU_MACH_AMDGCN_GFX1034,         false, false },
+  { "gfx1035",         ELF::EF_AMDGPU_MACH_AMDGCN_GFX1035,         false, false },
+  { "gfx1036",         ELF::EF_AMDGPU_MACH_AMDGCN_GFX1036,         false, false },
+#if defined(GFX11_BUILD)
+  { "gfx11-generic",   ELF::EF_AMDGPU_MACH_AMDGCN_GFX11_GENERIC,   false, false },
+  { "gfx1100",         ELF::EF_AMDGPU_MACH_AMDGCN_GFX1100,         false, false },
+  { "gfx1101",         ELF::EF_AMDGPU_MACH_AMDGCN_GFX1101,         false, false },
+  { "gfx1102",         ELF::EF_AMDGPU_MACH_AMDGCN_GFX1102,         false, false },
+  { "gfx1103",         ELF::EF_AMDGPU_MACH_AMDGCN_GFX1103,         false, false },
+  { "gfx1150",         ELF::EF_AMDGPU_MACH_AMDGCN_GFX1150,         false, false },
+  { "gfx1151",         ELF::EF_AMDGPU_MACH_AMDGCN_GFX1151,         false, false },
+  { "gfx1152",         ELF::EF_AMDGPU_MACH_AMDGCN_GFX1152,         false, false },
+#endif // GFX11_BUILD
+#if defined(GFX12_BUILD)
+  { "gfx1200",         ELF::EF_AMDGPU_MACH_AMDGCN_GFX1200,         false, false },
+  { "gfx1201",         ELF::EF_AMDGPU_MACH_AMDGCN_GFX1201,         false, false },
+#endif // GFX12_BUILD
+#if defined(GFX40_BUILD)
+  { "gfx4000",         ELF::EF_AMDGPU_MACH_AMDGCN_GFX4000,         false, false },
+  { "gfx4010",         ELF::EF_AMDGPU_MACH_AMDGCN_GFX4010,         false, false },
+  { "gfx4020",         ELF::EF_AMDGPU_MACH_AMDGCN_GFX4020,         false, false },
+  { "gfx4030",         ELF::EF_AMDGPU_MACH_AMDGCN_GFX4030,         false, false },
+#endif // GFX40_BUILD
+  { "gfx700",          ELF::EF_AMDGPU_MACH_AMDGCN_GFX700,          false, false },
+  { "gfx701",          ELF::EF_AMDGPU_MACH_AMDGCN_GFX701,          false, false },
+  { "gfx702",          ELF::EF_AMDGPU_MACH_AMDGCN_GFX702,          false, false },
+  { "gfx703",          ELF::EF_AMDGPU_MACH_AMDGCN_GFX703,          false, false },
+  { "gfx704",          ELF::EF_AMDGPU_MACH_AMDGCN_GFX704,          false, false },
+  { "gfx801",          ELF::EF_AMDGPU_MACH_AMDGCN_GFX801,          true,  false },
+  { "gfx802",          ELF::EF_AMDGPU_MACH_AMDGCN_GFX802,          false, false },
+  { "gfx803",          ELF::EF_AMDGPU_MACH_AMDGCN_GFX803,          false, false },
+  { "gfx810",          ELF::EF_AMDGPU_MACH_AMDGCN_GFX810,          true,  false },
+  { "gfx9-generic",    ELF::EF_AMDGPU_MACH_AMDGCN_GFX9_GENERIC,    true,  false },
+  { "gfx900",          ELF::EF_AMDGPU_MACH_AMDGCN_GFX900,          true,  false },
+  { "gfx902",          ELF::EF_AMDGPU_MACH_AMDGCN_GFX902,          true,  false },
+  { "gfx904",          ELF::EF_AMDGPU_MACH_AMDGCN_GFX904,          true,  false },
+  { "gfx906",          ELF::EF_AMDGPU_MACH_AMDGCN_GFX906,          true,  true  },
+  { "gfx908",          ELF::EF_AMDGPU_MACH_AMDGCN_GFX908,          true,  true  },
+  { "gfx90c",          ELF::EF_AMDGPU_MACH_AMDGCN_GFX90C,          true,  false },
+};
+
+const size_t kProcessorCount = sizeof(kProcessors) / sizeof(kProcessors[0]);
+
+// Code object v2 target names, sorted by name (strcmp order).
+struct LegacyTarget {
+  const char *name;
+  uint32_t mach;
+  bool finalizer_only;  // Only the finalizer produces this name.
+  bool xnack_on;        // The name itself implies xnack+.
+};
+
+const LegacyTarget kLegacyTargets[] = {
+  { "AMD:AMDGPU:10:0:0", ELF::EF_AMDGPU_MACH_AMDGCN_GFX1000,         true,  false },
+  { "AMD:AMDGPU:10:1:0", ELF::EF_AMDGPU_MACH_AMDGCN_GFX1010,         true,  false },
+  { "AMD:AMDGPU:10:1:1", ELF::EF_AMDGPU_MACH_AMDGCN_GFX1011,         true,  false },
+  { "AMD:AMDGPU:10:1:2", ELF::EF_AMDGPU_MACH_AMDGCN_GFX1012,         true,  false },
+  { "AMD:AMDGPU:10:3:0", ELF::EF_AMDGPU_MACH_AMDGCN_GFX1030,         true,  false },
+  { "AMD:AMDGPU:10:3:1", ELF::EF_AMDGPU_MACH_AMDGCN_GFX1031,         true,  false },
+  { "AMD:AMDGPU:10:3:2", ELF::EF_AMDGPU_MACH_AMDGCN_GFX1032,         true,  false },
+  { "AMD:AMDGPU:10:3:3", ELF::EF_AMDGPU_MACH_AMDGCN_GFX1033,         true,  false },
+  { "AMD:AMDGPU:10:3:4", ELF::EF_AMDGPU_MACH_AMDGCN_GFX1034,         true,  false },
+  { "AMD:AMDGPU:10:3:5", ELF::EF_AMDGPU_MACH_AMDGCN_GFX1035,         true,  false },
+  { "AMD:AMDGPU:10:3:6", ELF::EF_AMDGPU_MACH_AMDGCN_GFX1036,         true,  false },
+#if defined(GFX11_BUILD)
+  { "AMD:AMDGPU:11:0:0", ELF::EF_AMDGPU_MACH_AMDGCN_GFX1100,         true,  false },
+  { "AMD:AMDGPU:11:0:1", ELF::EF_AMDGPU_MACH_AMDGCN_GFX1101,         true,  false },
+  { "AMD:AMDGPU:11:0:2", ELF::EF_AMDGPU_MACH_AMDGCN_GFX1102,         true,  false },
+  { "AMD:AMDGPU:11:0:3", ELF::EF_AMDGPU_MACH_AMDGCN_GFX1103,         true,  false },
+  { "AMD:AMDGPU:11:5:0", ELF::EF_AMDGPU_MACH_AMDGCN_GFX1150,         true,  false },
+  { "AMD:AMDGPU:11:5:1", ELF::EF_AMDGPU_MACH_AMDGCN_GFX1151,         true,  false },
+#endif // GFX11_BUILD
+#if defined(GFX12_BUILD)
+  { "AMD:AMDGPU:12:0:0", ELF::EF_AMDGPU_MACH_AMDGCN_GFX1200,         true,  false },
+  { "AMD:AMDGPU:12:0:1", ELF::EF_AMDGPU_MACH_AMDGCN_GFX1201,         true,  false },
+#endif // GFX12_BUILD
+#if defined(GFX40_BUILD)
+  { "AMD:AMDGPU:40:0:0", ELF::EF_AMDGPU_MACH_AMDGCN_GFX4000,         true,  false },
+  { "AMD:AMDGPU:40:1:0", ELF::EF_AMDGPU_MACH_AMDGCN_GFX4010,         true,  false },
+  { "AMD:AMDGPU:40:2:0", ELF::EF_AMDGPU_MACH_AMDGCN_GFX4020,         true,  false },
+  { "AMD:AMDGPU:40:3:0", ELF::EF_AMDGPU_MACH_AMDGCN_GFX4030,         true,  false },
+#endif // GFX40_BUILD
+  { "AMD:AMDGPU:7:0:0",  ELF::EF_AMDGPU_MACH_AMDGCN_GFX700,          false, false },
+  { "AMD:AMDGPU:7:0:1",  ELF::EF_AMDGPU_MACH_AMDGCN_GFX701,          false, false },
+  { "AMD:AMDGPU:7:0:2",  ELF::EF_AMDGPU_MACH_AMDGCN_GFX702,          false, false },
+  { "AMD:AMDGPU:7:0:3",  ELF::EF_AMDGPU_MACH_AMDGCN_GFX703,          false, false },
+  { "AMD:AMDGPU:7:0:4",  ELF::EF_AMDGPU_MACH_AMDGCN_GFX704,          false, false },
+  { "AMD:AMDGPU:8:0:0",  ELF::EF_AMDGPU_MACH_AMDGCN_GFX802,          false, false },
+  { "AMD:AMDGPU:8:0:1",  ELF::EF_AMDGPU_MACH_AMDGCN_GFX801,          false, true  },
+  { "AMD:AMDGPU:8:0:2",  ELF::EF_AMDGPU_MACH_AMDGCN_GFX802,          false, false },
+  { "AMD:AMDGPU:8:0:3",  ELF::EF_AMDGPU_MACH_AMDGCN_GFX803,          false, false },
+  { "AMD:AMDGPU:8:0:4",  ELF::EF_AMDGPU_MACH_AMDGCN_GFX803,          false, false },
+  { "AMD:AMDGPU:8:1:0",  ELF::EF_AMDGPU_MACH_AMDGCN_GFX810,          false, true  },
+  { "AMD:AMDGPU:9:0:0",  ELF::EF_AMDGPU_MACH_AMDGCN_GFX900,          false, false },
+  { "AMD:AMDGPU:9:0:1",  ELF::EF_AMDGPU_MACH_AMDGCN_GFX900,          false, true  },
+  { "AMD:AMDGPU:9:0:12", ELF::EF_AMDGPU_MACH_AMDGCN_GFX90C,          false, false },
+  { "AMD:AMDGPU:9:0:13", ELF::EF_AMDGPU_MACH_AMDGCN_GFX90C,          false, true  },
+  { "AMD:AMDGPU:9:0:2",  ELF::EF_AMDGPU_MACH_AMDGCN_GFX902,          false, false },
+  { "AMD:AMDGPU:9:0:3",  ELF::EF_AMDGPU_MACH_AMDGCN_GFX902,          false, true  },
+  { "AMD:AMDGPU:9:0:4",  ELF::EF_AMDGPU_MACH_AMDGCN_GFX904,          false, false },
+  { "AMD:AMDGPU:9:0:5",  ELF::EF_AMDGPU_MACH_AMDGCN_GFX904,          false, true  },
+  { "AMD:AMDGPU:9:0:6",  ELF::EF_AMDGPU_MACH_AMDGCN_GFX906,          false, false },
+  { "AMD:AMDGPU:9:0:7",  ELF::EF_AMDGPU_MACH_AMDGCN_GFX906,          false, true  },
+
+};
+
+const size_t kLegacyTargetCount = sizeof(kLegacyTargets) / sizeof(kLegacyTargets[0]);
+
+const char kTriple[] = "amdgcn-amd-amdhsa--";
+
+// strcmp() of @p entry against the @p size bytes at @p name.
+int CompareName(const char *entry, const char *name, size_t size)
+{
+  const int cmp = strncmp(entry, name, size);
+  if (cmp != 0) { return cmp; }
+  return entry[size] == '\0' ? 0 : 1;
+}
+
+template <typename T>
+const T *FindByName(const T *table, size_t count, const char *name, size_t size)
+{
+  const T *end = table + count;
+  const T *it = std::lower_bound(table, end, name, [size](const T &entry, const char *key) {
+    return CompareName(entry.name, key, size) < 0;
+  });
+  return (it != end && CompareName(it->name, name, size) == 0) ? it : nullptr;
+}
+
+// Returns the entry by mach value, built once from kProcessors.
+const TargetProcessor *const *ProcessorsByMach()
+{
+  static const TargetProcessor *const *table = []() {
+    static const TargetProcessor *by_mach[ELF::EF_AMDGPU_MACH + 1] = {};
+    for (size_t i = 0; i < kProcessorCount; ++i) {
+      assert(kProcessors[i].mach <= ELF::EF_AMDGPU_MACH && !by_mach[kProcessors[i].mach]);
+      by_mach[kProcessors[i].mach] = &kProcessors[i];
+    }
+    return by_mach;
+  }();
+  return table;
+}
+
+bool ParseLegacy(const char *name, size_t size, bool is_finalizer, bool use_e_flags, uint32_t e_flags, TargetId *id)
+{
+  const LegacyTarget *legacy = FindByName(kLegacyTargets, kLegacyTargetCount, name, size);
+  if (!legacy || (legacy->finalizer_only && !is_finalizer)) { return false; }
+  const TargetProcessor *processor = FindTargetProcessorByMach(legacy->mach);
+  if (!processor) { return false; }
+
+  id->processor = processor;
+  // Code object v2 only supports SRAMECC off.
+  id->sramecc = processor->sramecc_supported ? TARGET_FEATURE_OFF : TARGET_FEATURE_UNSUPPORTED;
+  const bool xnack_on = use_e_flags ? (e_flags & ELF::EF_AMDGPU_FEATURE_XNACK_V2) != 0 : legacy->xnack_on;
+  if (xnack_on) {
+    id->xnack = TARGET_FEATURE_ON;
+  } else {
+    id->xnack = processor->xnack_supported ? TARGET_FEATURE_OFF : TARGET_FEATURE_UNSUPPORTED;
+  }
+  return true;
+}
+
+} // namespace anonymous
+
+const TargetProcessor *TargetProcessors(size_t *count)
+{
+#ifndef NDEBUG
+  static const bool sorted = []() {
+    for (size_t i = 1; i < kProcessorCount; ++i) {
+      if (strcmp(kProcessors[i - 1].name, kProcessors[i].name) >= 0) { return false; }
+    }
+    for (size_t i = 1; i < kLegacyTargetCount; ++i) {
+      if (strcmp(kLegacyTargets[i - 1].name, kLegacyTargets[i].name) >= 0) { return false; }
+    }
+    return true;
+  }();
+  assert(sorted && "target tables must be sorted by name");
+#endif // NDEBUG
+  *count = kProcessorCount;
+  return kProcessors;
+}
+
+const TargetProcessor *FindTargetProcessor(const char *name, size_t size)
+{
+  return FindByName(kProcessors, kProcessorCount, name, size);
+}
+
+const TargetProcessor *FindTargetProcessorByMach(uint32_t mach)
+{
+  return mach <= ELF::EF_AMDGPU_MACH ? ProcessorsByMach()[mach] : nullptr;
+}
+
+bool ParseLegacyTargetName(const std::string &name, bool is_finalizer, uint32_t e_flags, TargetId *id)
+{
+  // The finalizer records xnack in e_flags; for the lightning compiler it is
+  // part of the name.
+  return ParseLegacy(name.c_str(), name.size(), is_finalizer, is_finalizer, e_flags, id);
+}
+
+bool ParseTargetId(const char *name, TargetId *id)
+{
+  assert(name && id);
+  if (strncmp(name, "AMD:AMDGPU:", 11) == 0) {
+    return ParseLegacy(name, strlen(name), true, false, 0, id);
+  }
+  if (strncmp(name, kTriple, sizeof(kTriple) - 1) == 0) {
+    name += sizeof(kTriple) - 1;
+  }
+
+  const char *colon = strchr(name, ':');
+  const size_t processor_size = colon ? size_t(colon - name) : strlen(name);
+  const TargetProcessor *processor = FindTargetProcessor(name, processor_size);
+  if (!processor) { return false; }
+
+  TargetId result;
+  result.processor = processor;
+  result.sramecc = processor->sramecc_supported ? TARGET_FEATURE_ANY : TARGET_FEATURE_UNSUPPORTED;
+  result.xnack = processor->xnack_supported ? TARGET_FEATURE_ANY : TARGET_FEATURE_UNSUPPORTED;
+
+  // Each feature may appear once, sramecc before xnack.
+  bool seen_sramecc = false, seen_xnack = false;
+  for (const char *feature = colon; feature; feature = strchr(feature + 1, ':')) {
+    const char *begin = feature + 1;
+    const char *end = strchr(begin, ':');
+    const size_t size = end ? size_t(end - begin) : strlen(begin);
+    if (size < 2 || (begin[size - 1] != '+' && begin[size - 1] != '-')) { return false; }
+    const TargetFeatureSetting setting = begin[size - 1] == '+' ? TARGET_FEATURE_ON : TARGET_FEATURE_OFF;
+    if (size - 1 == 7 && strncmp(begin, "sramecc", 7) == 0 && !seen_sramecc && !seen_xnack) {
+      if (!processor->sramecc_supported) { return false; }
+      result.sramecc = setting;
+      seen_sramecc = true;
+    } else if (size - 1 == 5 && strncmp(begin, "xnack", 5) == 0 && !seen_xnack) {
+      if (!processor->xnack_supported) { return false; }
+      result.xnack = setting;
+      seen_xnack = true;
+    } else {
+      return false;
+    }
+  }
+  *id = result;
+  return true;
+}
+
+std::string TargetIdToString(const TargetId &id)
+{
+  assert(id.processor);
+  std::string name = id.processor->name;
+  if (id.sramecc == TARGET_FEATURE_ON) {
+    name += ":sramecc+";
+  } else if (id.sramecc == TARGET_FEATURE_OFF) {
+    name += ":sramecc-";
+  }
+  if (id.xnack == TARGET_FEATURE_ON) {
+    name += ":xnack+";
+  } else if (id.xnack == TARGET_FEATURE_OFF) {
+    name += ":xnack-";
+  }
+  return name;
+}
+
+bool TargetIdCache::Find(const char *name, TargetId *id)
+{
+  assert(name && id);
+  const size_t count = count_.load(std::memory_order_acquire);
+  for (size_t i = 0; i < count; ++i) {
+    if (strcmp(entries_[i].name, name) == 0) {
+      *id = entries_[i].id;
+      return entries_[i].valid;
+    }
+  }
+
+  TargetId parsed = TargetId();
+  const bool valid = ParseTargetId(name, &parsed);
+  *id = parsed;
+
+  const size_t size = strlen(name);
+  if (count < kEntries && size <= kMaxNameSize) {
+    std::lock_guard<std::mutex> lock(insert_lock_);
+    const size_t published = count_.load(std::memory_order_relaxed);
+    bool present = false;
+    for (size_t i = count; i < published && !present; ++i) {
+      present = strcmp(entries_[i].name, name) == 0;
+    }
+    if (!present && published < kEntries) {
+      Entry &entry = entries_[published];
+      memcpy(entry.name, name, size + 1);
+      entry.valid = valid;
+      entry.id = parsed;
+      count_.store(published + 1, std::memory_order_release);
+    }
+  }
+  return valid;
+}
+
+} // namespace hsa
+} // namespace amd
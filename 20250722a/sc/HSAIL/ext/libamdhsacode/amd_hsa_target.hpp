@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef AMD_HSA_TARGET_HPP_
+#define AMD_HSA_TARGET_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace amd {
+namespace hsa {
+
+// Setting of a target feature (sramecc, xnack) in a target ID. The values
+// match the EF_AMDGPU_FEATURE_*_V4 encodings shifted down to bit 0.
+enum TargetFeatureSetting : uint8_t {
+  TARGET_FEATURE_UNSUPPORTED = 0, // The processor does not have the feature.
+  TARGET_FEATURE_ANY = 1,         // Not specified; the code runs either way.
+  TARGET_FEATURE_OFF = 2,
+  TARGET_FEATURE_ON = 3,
+};
+
+// Entry of the known target processor table.
+struct TargetProcessor {
+  const char *name;        // e.g. "gfx906".
+  uint32_t mach;           // ELF::EF_AMDGPU_MACH_*.
+  bool xnack_supported;
+  bool sramecc_supported;
+};
+
+// Parsed target ID, e.g. "amdgcn-amd-amdhsa--gfx906:sramecc-:xnack+".
+struct TargetId {
+  const TargetProcessor *processor;
+  TargetFeatureSetting sramecc;
+  TargetFeatureSetting xnack;
+};
+
+// Returns the known processors, sorted by name, and their number in @p count.
+const TargetProcessor *TargetProcessors(size_t *count);
+
+// Returns the processor named by @p size bytes at @p name, or null.
+const TargetProcessor *FindTargetProcessor(const char *name, size_t size);
+
+// Returns the processor with ELF::EF_AMDGPU_MACH_* value @p mach, or null.
+const TargetProcessor *FindTargetProcessorByMach(uint32_t mach);
+
+// Converts a code object v2 target name ("AMD:AMDGPU:9:0:6") to a target
+// ID. Names of GFX10 and later are only known to the finalizer, which also
+// records xnack in @p e_flags rather than in the name.
+bool ParseLegacyTargetName(const std::string &name, bool is_finalizer, uint32_t e_flags, TargetId *id);
+
+// Parses "[amdgcn-amd-amdhsa--]processor[:sramecc(+|-)][:xnack(+|-)]" or a
+// code object v2 target name. Features the processor supports but the name
+// does not mention are TARGET_FEATURE_ANY. @p id is only written on success.
+bool ParseTargetId(const char *name, TargetId *id);
+
+// Returns "processor[:sramecc(+|-)][:xnack(+|-)]" for @p id.
+std::string TargetIdToString(const TargetId &id);
+
+// Remembers the first few target ID strings parsed, so that the handful of
+// distinct targets a process sees are only parsed once. Thread safe.
+//
+// Entries are never replaced once published, so lookups read them without
+// locking; only adding an entry takes the lock. Names beyond the first
+// kEntries, or longer than kMaxNameSize, are parsed on every call.
+class TargetIdCache final {
+public:
+  TargetIdCache() : count_(0) {}
+
+  // As ParseTargetId(), but served from the cache when possible. On failure
+  // @p id is value-initialized.
+  bool Find(const char *name, TargetId *id);
+
+private:
+  TargetIdCache(const TargetIdCache&);
+  TargetIdCache& operator=(const TargetIdCache&);
+
+  static const size_t kEntries = 8;
+  static const size_t kMaxNameSize = 63;
+
+  struct Entry {
+    char name[kMaxNameSize + 1];
+    bool valid;
+    TargetId id;
+  };
+
+  std::mutex insert_lock_;     // Serializes adding entries.
+  std::atomic<size_t> count_;  // entries_[0, count_) are published.
+  Entry entries_[kEntries];
+};
+
+} // namespace hsa
+} // namespace amd
+
+#endif // AMD_HSA_TARGET_HPP_
@@ -0,0 +1,235 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "dump_pipeline.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <fstream>
+#include "amd_hsa_code.hpp"
+
+namespace amd {
+namespace hsa {
+namespace loader {
+
+namespace {
+
+// Workers are I/O and formatting bound and share the process with the
+// application, so only a few are started.
+const size_t kMaxWorkers = 4;
+
+std::atomic<bool> pipeline_started(false);
+
+} // namespace anonymous
+
+/// @brief Parts of one listing. Waiting runs the group's queued parts on the
+/// waiting thread, so a listing completes even when every worker is busy.
+class DumpPipeline::TaskGroup final : public amd::hsa::code::PrintTaskRunner {
+public:
+  explicit TaskGroup(DumpPipeline *pipeline): pipeline_(pipeline), pending_(0) {}
+
+  void Spawn(std::function<void()> task) override
+  {
+    pipeline_->Submit(this, std::move(task));
+  }
+
+  void Wait() override;
+
+private:
+  friend class DumpPipeline;
+
+  DumpPipeline *pipeline_;
+  // Parts queued or running. Guarded by the pipeline's mutex.
+  size_t pending_;
+};
+
+void DumpPipeline::TaskGroup::Wait()
+{
+  std::unique_lock<std::mutex> lock(pipeline_->mutex_);
+  while (pending_ != 0) {
+    std::deque<Task> &tasks = pipeline_->tasks_;
+    auto it = std::find_if(tasks.begin(), tasks.end(), [this](const Task &t) { return t.group == this; });
+    if (it == tasks.end()) {
+      pipeline_->done_cv_.wait(lock);
+      continue;
+    }
+    std::function<void()> run = std::move(it->run);
+    tasks.erase(it);
+    lock.unlock();
+    run();
+    lock.lock();
+    --pending_;
+  }
+}
+
+DumpPipeline& DumpPipeline::Instance()
+{
+  // Deliberately leaked, see the class comment.
+  static DumpPipeline *pipeline = new DumpPipeline(
+    std::max<size_t>(1, std::min<size_t>(kMaxWorkers, std::thread::hardware_concurrency())));
+  pipeline_started.store(true, std::memory_order_release);
+  return *pipeline;
+}
+
+void DumpPipeline::Flush()
+{
+  if (pipeline_started.load(std::memory_order_acquire)) {
+    Instance().Drain();
+  }
+}
+
+void DumpPipeline::Shutdown()
+{
+  if (pipeline_started.load(std::memory_order_acquire)) {
+    Instance().Stop();
+  }
+}
+
+DumpPipeline::DumpPipeline(size_t workers)
+  : pending_dumps_(0), generation_(0), worker_count_(workers)
+{
+}
+
+DumpPipeline::~DumpPipeline()
+{
+  assert(workers_.empty());
+}
+
+void DumpPipeline::SaveCode(const std::string &filename, const char *elf, size_t size)
+{
+  std::shared_ptr<std::vector<char>> data = std::make_shared<std::vector<char>>(elf, elf + size);
+  Submit(nullptr, [filename, data]() {
+    std::ofstream out(filename, std::ios::binary);
+    if (out.fail()) { return; }
+    out.write(data->data(), data->size());
+  });
+}
+
+void DumpPipeline::PrintCode(const std::string &filename, const char *elf, size_t size)
+{
+  std::shared_ptr<std::vector<char>> data = std::make_shared<std::vector<char>>(elf, elf + size);
+  Submit(nullptr, [this, filename, data]() {
+    amd::hsa::code::AmdHsaCode code;
+    if (!code.InitAsBuffer(data->data(), data->size())) { return; }
+    std::ofstream out(filename);
+    if (out.fail()) { return; }
+    TaskGroup group(this);
+    code.PrintParallel(out, group, worker_count_ + 1);
+  });
+}
+
+void DumpPipeline::WriteText(const std::string &filename, std::string &&text)
+{
+  std::shared_ptr<std::string> data = std::make_shared<std::string>(std::move(text));
+  Submit(nullptr, [filename, data]() {
+    std::ofstream out(filename);
+    if (out.fail()) { return; }
+    out << *data;
+  });
+}
+
+void DumpPipeline::Drain()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [this]() { return pending_dumps_ == 0; });
+}
+
+void DumpPipeline::Stop()
+{
+  std::vector<std::thread> workers;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    workers.swap(workers_);
+    ++generation_;
+  }
+  work_cv_.notify_all();
+  // Stopped workers finish the queue before they exit.
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+}
+
+void DumpPipeline::Submit(TaskGroup *group, std::function<void()> run)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (group) {
+      ++group->pending_;
+    } else {
+      ++pending_dumps_;
+    }
+    tasks_.push_back(Task{group, std::move(run)});
+    // Parts of a listing need no workers of their own: the listing waits for
+    // them and runs them itself if nobody else does.
+    if (!group && workers_.empty()) {
+      for (size_t i = 0; i < worker_count_; ++i) {
+        workers_.push_back(std::thread(&DumpPipeline::Run, this, generation_));
+      }
+    }
+  }
+  work_cv_.notify_one();
+}
+
+void DumpPipeline::Run(size_t generation)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    work_cv_.wait(lock, [this, generation]() { return generation != generation_ || !tasks_.empty(); });
+    if (tasks_.empty()) { return; }
+    Task task = std::move(tasks_.front());
+    tasks_.pop_front();
+    lock.unlock();
+    task.run();
+    lock.lock();
+    if (task.group) {
+      --task.group->pending_;
+    } else {
+      --pending_dumps_;
+    }
+    done_cv_.notify_all();
+  }
+}
+
+} // namespace loader
+} // namespace hsa
+} // namespace amd
@@ -0,0 +1,134 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef HSA_RUNTIME_CORE_LOADER_DUMP_PIPELINE_HPP_
+#define HSA_RUNTIME_CORE_LOADER_DUMP_PIPELINE_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace amd {
+namespace hsa {
+namespace loader {
+
+/// @brief Background workers that write the loader's dump files.
+///
+/// Loading hands each dump over with a private copy of its data and carries
+/// on; the files are written by the workers. Code object listings are
+/// rendered with AmdHsaCode::PrintParallel(), whose parts run on the same
+/// workers, and are byte-identical to AmdHsaCode::PrintToFile().
+///
+/// Dumps are best effort, like the synchronous ones: write failures are
+/// ignored.
+///
+/// The pipeline is never destroyed. Its workers are stopped by Shutdown(),
+/// not at process exit, where joining threads can deadlock (on Windows static
+/// destructors run under the loader lock).
+class DumpPipeline {
+public:
+  /// @returns Process-wide pipeline. Workers are started when a dump is queued.
+  static DumpPipeline& Instance();
+
+  /// @brief Waits for all dumps queued so far, if the pipeline was started.
+  static void Flush();
+
+  /// @brief Writes all dumps queued so far and joins the workers, if the
+  /// pipeline was started. Later dumps start new workers.
+  static void Shutdown();
+
+  /// @brief Writes the @p size byte code object at @p elf to @p filename.
+  void SaveCode(const std::string &filename, const char *elf, size_t size);
+
+  /// @brief Writes the listing of the @p size byte code object at @p elf to
+  /// @p filename.
+  void PrintCode(const std::string &filename, const char *elf, size_t size);
+
+  /// @brief Writes @p text to @p filename.
+  void WriteText(const std::string &filename, std::string &&text);
+
+  /// @brief Waits until all dumps queued so far are written.
+  void Drain();
+
+  /// @brief Writes all dumps queued so far and joins the workers.
+  void Stop();
+
+private:
+  class TaskGroup;
+
+  struct Task {
+    TaskGroup *group;
+    std::function<void()> run;
+  };
+
+  explicit DumpPipeline(size_t workers);
+  DumpPipeline(const DumpPipeline&);
+  DumpPipeline& operator=(const DumpPipeline&);
+  ~DumpPipeline();
+
+  void Submit(TaskGroup *group, std::function<void()> run);
+  void Run(size_t generation);
+
+  std::mutex mutex_;
+  std::condition_variable work_cv_;
+  std::condition_variable done_cv_;
+  std::deque<Task> tasks_;
+  // Dumps queued or in progress.
+  size_t pending_dumps_;
+  // Number of worker sets stopped so far. Workers of an older generation
+  // exit once the queue is empty.
+  size_t generation_;
+  size_t worker_count_;
+  std::vector<std::thread> workers_;
+};
+
+} // namespace loader
+} // namespace hsa
+} // namespace amd
+
+#endif // HSA_RUNTIME_CORE_LOADER_DUMP_PIPELINE_HPP_
@@ -51,12 +51,14 @@
 #include <iomanip>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include "amd_hsa_elf.h"
 #include "amd_hsa_kernel_code.h"
 #include "amd_hsa_code.hpp"
 #include "amd_hsa_code_util.hpp"
 #include "amd_options.hpp"
 #include "AMDHSAKernelDescriptor.h"
+#include "dump_pipeline.hpp"
 
 #include <atomic>
 
@@ -147,7 +149,12 @@ public:
   const amd::options::NoArgOption* DumpExec() const { return &dump_exec; }
   const amd::options::NoArgOption* DumpAll() const { return &dump_all; }
   const amd::options::ValueOption<std::string>* DumpDir() const { return &dump_dir; }
+  const amd::options::NoArgOption* DumpSync() const { return &dump_sync; }
   const amd::options::PrefixOption* Substitute() const { return &substitute; }
+  const amd::options::ValueOption<std::string>* PrelinkCacheDir() const { return &prelink_cache_dir; }
+  const amd::options::NoArgOption* LazyUpload() const { return &lazy_upload; }
+  const amd::options::NoArgOption* UploadAtFreeze() const { return &upload_at_freeze; }
+  const amd::options::NoArgOption* SuballocateSegments() const { return &suballocate_segments; }
 
   bool ParseOptions(const std::string& options);
   void Reset();
@@ -166,7 +173,12 @@ private:
   amd::options::NoArgOption dump_exec;
   amd::options::NoArgOption dump_all;
   amd::options::ValueOption<std::string> dump_dir;
+  amd::options::NoArgOption dump_sync;
   amd::options::PrefixOption substitute;
+  amd::options::ValueOption<std::string> prelink_cache_dir;
+  amd::options::NoArgOption lazy_upload;
+  amd::options::NoArgOption upload_at_freeze;
+  amd::options::NoArgOption suballocate_segments;
   amd::options::OptionParser option_parser;
 };
 
@@ -177,7 +189,14 @@ LoaderOptions::LoaderOptions(std::ostream& error) :
   dump_exec("dump-exec", "Dump executable to text file"),
   dump_all("dump-all", "Dump all finalizer input and output (as above)"),
   dump_dir("dump-dir", "Dump directory"),
+  dump_sync("dump-sync", "Write dump files before loading continues"),
   substitute("substitute", "Substitute code object with given index or index range on loading from file"),
+  prelink_cache_dir("prelink-cache-dir", "Cache relocated code object segments in this directory"),
+  lazy_upload("lazy-upload", "Upload code object segments on first symbol query instead of at load. "
+    "Segment descriptors and the debugger's r_debug map list a segment before its upload, while it holds zeros"),
+  upload_at_freeze("upload-at-freeze", "With -lazy-upload, upload remaining segments when the executable is frozen, "
+    "before it is added to the r_debug map"),
+  suballocate_segments("suballocate-segments", "Executable option: place small segments in slabs reused across executables"),
   option_parser(false, error)
 {
   option_parser.AddOption(&help);
@@ -186,7 +205,12 @@ LoaderOptions::LoaderOptions(std::ostream& error) :
   option_parser.AddOption(&dump_exec);
   option_parser.AddOption(&dump_all);
   option_parser.AddOption(&dump_dir);
+  option_parser.AddOption(&dump_sync);
   option_parser.AddOption(&substitute);
+  option_parser.AddOption(&prelink_cache_dir);
+  option_parser.AddOption(&lazy_upload);
+  option_parser.AddOption(&upload_at_freeze);
+  option_parser.AddOption(&suballocate_segments);
 }
 
 bool LoaderOptions::ParseOptions(const std::string& options)
@@ -217,6 +241,7 @@ void Loader::Destroy(Loader *loader)
   _amdgpu_r_debug.r_map = nullptr;
   _amdgpu_r_debug.r_state = r_debug::RT_CONSISTENT;
   r_debug_tail = nullptr;
+  DumpPipeline::Shutdown();
   delete loader;
 }
 
@@ -225,7 +250,25 @@ Executable* AmdHsaCodeLoader::CreateExecutable(
 {
   WriterLockGuard<ReaderWriterLock> writer_lock(rw_lock_);
 
-  executables.push_back(new ExecutableImpl(profile, context, executables.size(), default_float_rounding_mode));
+  // Executable options used to be ignored, so ones the loader does not know
+  // are still ignored quietly.
+  bool suballocate = false;
+  const char *options_append = getenv("LOADER_OPTIONS_APPEND");
+  for (const char *o : { options, options_append }) {
+    if (o && *o) {
+      std::ostringstream ignored;
+      LoaderOptions loaderOptions(ignored);
+      if (loaderOptions.ParseOptions(o) && loaderOptions.SuballocateSegments()->is_set()) {
+        suballocate = true;
+      }
+    }
+  }
+  if (suballocate && !slab_pool_) {
+    slab_pool_ = std::make_shared<SegmentSlabPool>(context);
+  }
+
+  executables.push_back(new ExecutableImpl(profile, context, this, executables.size(), default_float_rounding_mode,
+                                           suballocate ? slab_pool_ : nullptr));
   return executables.back();
 }
 
@@ -295,7 +338,9 @@ void AmdHsaCodeLoader::DestroyExecutable(Executable *executable) {
   atomic::store_release(&_amdgpu_r_debug.r_state, r_debug::RT_CONSISTENT);
   _loader_debug_state();
 
-  executables[((ExecutableImpl*)executable)->id()] = nullptr;
+  const size_t id = ((ExecutableImpl*)executable)->id();
+  UpdateSegments(id, std::vector<hsa_ven_amd_loader_segment_descriptor_t>());
+  executables[id] = nullptr;
   delete executable;
 }
 
@@ -332,34 +377,65 @@ hsa_status_t AmdHsaCodeLoader::QuerySegmentDescriptors(
     return HSA_STATUS_ERROR_INVALID_ARGUMENT;
   }
 
-  this->EnableReadOnlyMode();
-
-  size_t actual_num_segment_descriptors = 0;
-  for (auto &executable : executables) {
-    if (executable) {
-      actual_num_segment_descriptors += executable->GetNumSegmentDescriptors();
-    }
-  }
+  // Both the counting and the filling call are served from whatever snapshot
+  // is current, so neither blocks, or is blocked by, a concurrent load. A load
+  // in between the two calls shows up as a count mismatch, as it did before.
+  std::shared_ptr<const SegmentSnapshot> snapshot = GetSegmentSnapshot();
+  const std::vector<hsa_ven_amd_loader_segment_descriptor_t> &descriptors = snapshot->Descriptors();
 
   if (*num_segment_descriptors == 0) {
-    *num_segment_descriptors = actual_num_segment_descriptors;
-    this->DisableReadOnlyMode();
+    *num_segment_descriptors = descriptors.size();
     return HSA_STATUS_SUCCESS;
   }
-  if (*num_segment_descriptors != actual_num_segment_descriptors) {
-    this->DisableReadOnlyMode();
+  if (*num_segment_descriptors != descriptors.size()) {
     return HSA_STATUS_ERROR_INCOMPATIBLE_ARGUMENTS;
   }
 
-  size_t i = 0;
-  for (auto &executable : executables) {
-    if (executable) {
-      i += executable->QuerySegmentDescriptors(segment_descriptors, actual_num_segment_descriptors, i);
-    }
+  std::copy(descriptors.begin(), descriptors.end(), segment_descriptors);
+  return HSA_STATUS_SUCCESS;
+}
+
+std::shared_ptr<const SegmentSnapshot> AmdHsaCodeLoader::GetSegmentSnapshot() const
+{
+  return std::atomic_load(&segment_snapshot_);
+}
+
+uint64_t AmdHsaCodeLoader::SegmentGeneration() const
+{
+  return segment_generation_.load(std::memory_order_acquire);
+}
+
+void AmdHsaCodeLoader::UpdateSegments(
+  size_t id, std::vector<hsa_ven_amd_loader_segment_descriptor_t> &&descriptors)
+{
+  std::lock_guard<std::mutex> lock(snapshot_mutex_);
+  if (descriptors.empty()) {
+    executable_segments_.erase(id);
+  } else {
+    executable_segments_[id] = std::move(descriptors);
   }
+  PublishSegmentSnapshot();
+}
 
-  this->DisableReadOnlyMode();
-  return HSA_STATUS_SUCCESS;
+void AmdHsaCodeLoader::PublishSegmentSnapshot()
+{
+  size_t count = 0;
+  for (auto &segments : executable_segments_) {
+    count += segments.second.size();
+  }
+
+  std::vector<hsa_ven_amd_loader_segment_descriptor_t> descriptors;
+  descriptors.reserve(count);
+  for (auto &segments : executable_segments_) {
+    descriptors.insert(descriptors.end(), segments.second.begin(), segments.second.end());
+  }
+
+  // The snapshot is stored before the generation is bumped, so a reader that
+  // sees the new generation also gets the new snapshot.
+  const uint64_t generation = segment_generation_.load(std::memory_order_relaxed) + 1;
+  std::atomic_store(&segment_snapshot_,
+    std::shared_ptr<const SegmentSnapshot>(std::make_shared<SegmentSnapshot>(generation, std::move(descriptors))));
+  segment_generation_.store(generation, std::memory_order_release);
 }
 
 uint64_t AmdHsaCodeLoader::FindHostAddress(uint64_t device_address)
@@ -385,26 +461,6 @@ void AmdHsaCodeLoader::PrintHelp(std::ostream& out)
   LoaderOptions().PrintHelp(out);
 }
 
-void AmdHsaCodeLoader::EnableReadOnlyMode()
-{
-  rw_lock_.ReaderLock();
-  for (auto &executable : executables) {
-    if (executable) {
-      ((ExecutableImpl*)executable)->EnableReadOnlyMode();
-    }
-  }
-}
-
-void AmdHsaCodeLoader::DisableReadOnlyMode()
-{
-  rw_lock_.ReaderUnlock();
-  for (auto &executable : executables) {
-    if (executable) {
-      ((ExecutableImpl*)executable)->DisableReadOnlyMode();
-    }
-  }
-}
-
 //===----------------------------------------------------------------------===//
 // SymbolImpl.                                                                    //
 //===----------------------------------------------------------------------===//
@@ -493,6 +549,10 @@ bool SymbolImpl::GetInfo(hsa_symbol_info32_t symbol_info, void *value) {
       if (!is_loaded) {
         return false;
       }
+      // The address is only handed out once the contents are in place.
+      if (load_segment && !load_segment->Upload()) {
+        return false;
+      }
       *((uint64_t*)value) = address;
       break;
     }
@@ -725,9 +785,52 @@ void* Segment::Address(uint64_t addr)
 
 bool Segment::Freeze()
 {
+  if (IsUploadDeferred()) {
+    std::lock_guard<std::mutex> lock(upload_lock);
+    if (staged) {
+      const bool upload_now = upload_mode == SEGMENT_UPLOAD_AT_FREEZE;
+      if (!upload_now || !UploadLocked()) {
+        // Frozen by a later Upload().
+        freeze_on_upload = true;
+        return !upload_now;
+      }
+    }
+  }
   return !frozen ? (frozen = owner->context()->SegmentFreeze(segment, agent, ptr, size)) : true;
 }
 
+void Segment::DeferUpload(SegmentUploadMode mode)
+{
+  assert(!frozen && !staged);
+  if (mode == SEGMENT_UPLOAD_AT_LOAD) { return; }
+  staged.reset(new std::vector<uint8_t>(size, 0));
+  upload_mode = mode;
+  upload_deferred.store(true, std::memory_order_release);
+  owner->AddDeferredUpload();
+}
+
+bool Segment::Upload()
+{
+  if (!IsUploadDeferred()) { return true; }
+  std::lock_guard<std::mutex> lock(upload_lock);
+  return UploadLocked();
+}
+
+bool Segment::UploadLocked()
+{
+  if (!staged) { return true; }
+  if (!owner->context()->SegmentCopy(segment, agent, ptr, 0, staged->data(), staged->size())) {
+    return false;
+  }
+  staged.reset();
+  if (freeze_on_upload) {
+    frozen = owner->context()->SegmentFreeze(segment, agent, ptr, size);
+  }
+  upload_deferred.store(false, std::memory_order_release);
+  owner->RemoveDeferredUpload();
+  return true;
+}
+
 bool Segment::IsAddressInSegment(uint64_t addr)
 {
   return vaddr <= addr && addr < vaddr + size;
@@ -739,7 +842,11 @@ void Segment::Copy(uint64_t addr, const void* src, size_t size)
   assert(!frozen);
 
   if (size > 0) {
-    owner->context()->SegmentCopy(segment, agent, ptr, Offset(addr), src, size);
+    if (staged) {
+      memcpy(staged->data() + Offset(addr), src, size);
+    } else {
+      owner->context()->SegmentCopy(segment, agent, ptr, Offset(addr), src, size);
+    }
   }
 }
 
@@ -765,30 +872,41 @@ void Segment::Destroy()
 ExecutableImpl::ExecutableImpl(
     const hsa_profile_t &_profile,
     Context *context,
+    AmdHsaCodeLoader *loader,
     size_t id,
-    hsa_default_float_rounding_mode_t default_float_rounding_mode)
+    hsa_default_float_rounding_mode_t default_float_rounding_mode,
+    std::shared_ptr<SegmentSlabPool> slab_pool)
   : Executable()
   , profile_(_profile)
   , context_(context)
+  , suballocator_(slab_pool ? new SuballocatingContext(slab_pool) : nullptr)
+  , loader_(loader)
   , id_(id)
   , default_float_rounding_mode_(default_float_rounding_mode)
   , state_(HSA_EXECUTABLE_STATE_UNFROZEN)
   , program_allocation_segment(nullptr)
+  , prelink_fixups_(nullptr)
+  , prelink_cacheable_(false)
+  , deferred_uploads_(0)
 {
+  if (suballocator_) {
+    context_ = suballocator_.get();
+  }
 }
 
 ExecutableImpl::~ExecutableImpl() {
+  // Objects and symbols live in arena_, which frees their memory in bulk.
   for (ExecutableObject* o : objects) {
     o->Destroy();
-    delete o;
+    ObjectArena::Delete(o);
   }
   objects.clear();
 
   for (auto &symbol_entry : program_symbols_) {
-    delete symbol_entry.second;
+    ObjectArena::Delete(symbol_entry.second);
   }
   for (auto &symbol_entry : agent_symbols_) {
-    delete symbol_entry.second;
+    ObjectArena::Delete(symbol_entry.second);
   }
 }
 
@@ -802,26 +920,35 @@ hsa_status_t ExecutableImpl::DefineProgramExternalVariable(
     return HSA_STATUS_ERROR_FROZEN_EXECUTABLE;
   }
 
-  auto symbol_entry = program_symbols_.find(std::string(name));
+  InternedString symbol_name = symbol_names_.Intern(name, strlen(name));
+  if (symbol_name.IsNull()) {
+    return HSA_STATUS_ERROR_OUT_OF_RESOURCES;
+  }
+
+  auto symbol_entry = program_symbols_.find(symbol_name);
   if (symbol_entry != program_symbols_.end()) {
     return HSA_STATUS_ERROR_VARIABLE_ALREADY_DEFINED;
   }
 
-  program_symbols_.insert(
-    std::make_pair(std::string(name),
-                   new VariableSymbol(true,
-                                      "", // Only program linkage symbols can be
-                                          // defined.
-                                      std::string(name),
-                                      HSA_SYMBOL_LINKAGE_PROGRAM,
-                                      true,
-                                      HSA_VARIABLE_ALLOCATION_PROGRAM,
-                                      HSA_VARIABLE_SEGMENT_GLOBAL,
-                                      0,     // TODO: size.
-                                      0,     // TODO: align.
-                                      false, // TODO: const.
-                                      true,
-                                      reinterpret_cast<uint64_t>(address))));
+  VariableSymbol *symbol =
+    arena_.New<VariableSymbol>(true,
+                               symbol_names_.Intern(""), // Only program linkage symbols can be
+                                                         // defined.
+                               symbol_name,
+                               HSA_SYMBOL_LINKAGE_PROGRAM,
+                               true,
+                               HSA_VARIABLE_ALLOCATION_PROGRAM,
+                               HSA_VARIABLE_SEGMENT_GLOBAL,
+                               0,     // TODO: size.
+                               0,     // TODO: align.
+                               false, // TODO: const.
+                               true,
+                               reinterpret_cast<uint64_t>(address));
+  if (!symbol) {
+    return HSA_STATUS_ERROR_OUT_OF_RESOURCES;
+  }
+
+  program_symbols_.insert(std::make_pair(symbol_name, symbol));
   return HSA_STATUS_SUCCESS;
 }
 
@@ -838,26 +965,36 @@ hsa_status_t ExecutableImpl::DefineAgentExternalVariable(
     return HSA_STATUS_ERROR_FROZEN_EXECUTABLE;
   }
 
-  auto symbol_entry = agent_symbols_.find(std::make_pair(std::string(name), agent));
+  InternedString symbol_name = symbol_names_.Intern(name, strlen(name));
+  if (symbol_name.IsNull()) {
+    return HSA_STATUS_ERROR_OUT_OF_RESOURCES;
+  }
+
+  auto symbol_entry = agent_symbols_.find(std::make_pair(symbol_name, agent));
   if (symbol_entry != agent_symbols_.end()) {
     return HSA_STATUS_ERROR_VARIABLE_ALREADY_DEFINED;
   }
 
+  VariableSymbol *symbol =
+    arena_.New<VariableSymbol>(true,
+                               symbol_names_.Intern(""), // Only program linkage symbols can be
+                                                         // defined.
+                               symbol_name,
+                               HSA_SYMBOL_LINKAGE_PROGRAM,
+                               true,
+                               HSA_VARIABLE_ALLOCATION_AGENT,
+                               segment,
+                               0,     // TODO: size.
+                               0,     // TODO: align.
+                               false, // TODO: const.
+                               true,
+                               reinterpret_cast<uint64_t>(address));
+  if (!symbol) {
+    return HSA_STATUS_ERROR_OUT_OF_RESOURCES;
+  }
+
   auto insert_status = agent_symbols_.insert(
-    std::make_pair(std::make_pair(std::string(name), agent),
-                   new VariableSymbol(true,
-                                      "", // Only program linkage symbols can be
-                                          // defined.
-                                      std::string(name),
-                                      HSA_SYMBOL_LINKAGE_PROGRAM,
-                                      true,
-                                      HSA_VARIABLE_ALLOCATION_AGENT,
-                                      segment,
-                                      0,     // TODO: size.
-                                      0,     // TODO: align.
-                                      false, // TODO: const.
-                                      true,
-                                      reinterpret_cast<uint64_t>(address))));
+    std::make_pair(std::make_pair(symbol_name, agent), symbol));
   assert(insert_status.second);
   insert_status.first->second->agent = agent;
 
@@ -868,7 +1005,8 @@ bool ExecutableImpl::IsProgramSymbol(const char *symbol_name) {
   assert(symbol_name);
 
   ReaderLockGuard<ReaderWriterLock> reader_lock(rw_lock_);
-  return program_symbols_.find(std::string(symbol_name)) != program_symbols_.end();
+  InternedString name = symbol_names_.Find(symbol_name);
+  return !name.IsNull() && program_symbols_.find(name) != program_symbols_.end();
 }
 
 Symbol* ExecutableImpl::GetSymbol(
@@ -876,7 +1014,21 @@ Symbol* ExecutableImpl::GetSymbol(
   const hsa_agent_t *agent)
 {
   ReaderLockGuard<ReaderWriterLock> reader_lock(rw_lock_);
-  return this->GetSymbolInternal(symbol_name, agent);
+  Symbol *symbol = this->GetSymbolInternal(symbol_name, agent);
+  if (symbol && deferred_uploads_.load(std::memory_order_acquire) != 0 &&
+      !UploadSymbolSegment(static_cast<SymbolImpl*>(symbol))) {
+    return nullptr;
+  }
+  return symbol;
+}
+
+bool ExecutableImpl::UploadSymbolSegment(SymbolImpl *symbol)
+{
+  if (!symbol->load_segment || symbol->load_segment->Upload()) {
+    return true;
+  }
+  logger_ << "LoaderError: failed to upload the segment of symbol \"" << symbol->symbol_name.c_str() << "\"\n";
+  return false;
 }
 
 Symbol* ExecutableImpl::GetSymbolInternal(
@@ -885,8 +1037,10 @@ Symbol* ExecutableImpl::GetSymbolInternal(
 {
   assert(symbol_name);
 
-  std::string mangled_name = std::string(symbol_name);
-  if (mangled_name.empty()) {
+  // Names that were never interned cannot name a symbol, so most misses end
+  // here without touching the symbol maps.
+  InternedString mangled_name = symbol_names_.Find(symbol_name);
+  if (mangled_name.IsNull() || mangled_name.empty()) {
     return nullptr;
   }
 
@@ -999,7 +1153,7 @@ hsa_status_t ExecutableImpl::IterateLoadedCodeObjects(
 
 size_t ExecutableImpl::GetNumSegmentDescriptors()
 {
-  // assuming we are in readonly mode.
+  ReaderLockGuard<ReaderWriterLock> reader_lock(rw_lock_);
   size_t actual_num_segment_descriptors = 0;
   for (auto &obj : loaded_code_objects) {
     actual_num_segment_descriptors += obj->LoadedSegments().size();
@@ -1012,27 +1166,45 @@ size_t ExecutableImpl::QuerySegmentDescriptors(
   size_t total_num_segment_descriptors,
   size_t first_empty_segment_descriptor)
 {
-  // assuming we are in readonly mode.
   assert(segment_descriptors);
   assert(first_empty_segment_descriptor < total_num_segment_descriptors);
 
-  size_t i = first_empty_segment_descriptor;
+  ReaderLockGuard<ReaderWriterLock> reader_lock(rw_lock_);
+  std::vector<hsa_ven_amd_loader_segment_descriptor_t> descriptors;
+  AppendSegmentDescriptors(descriptors);
+  assert(descriptors.size() <= total_num_segment_descriptors - first_empty_segment_descriptor);
+
+  std::copy(descriptors.begin(), descriptors.end(), segment_descriptors + first_empty_segment_descriptor);
+  return descriptors.size();
+}
+
+void ExecutableImpl::AppendSegmentDescriptors(
+  std::vector<hsa_ven_amd_loader_segment_descriptor_t> &descriptors)
+{
   for (auto &obj : loaded_code_objects) {
-    assert(i < total_num_segment_descriptors);
     for (auto &seg : obj->LoadedSegments()) {
-      segment_descriptors[i].agent = seg->Agent();
-      segment_descriptors[i].executable = Executable::Handle(seg->Owner());
-      segment_descriptors[i].code_object_storage_type = HSA_VEN_AMD_LOADER_CODE_OBJECT_STORAGE_TYPE_MEMORY;
-      segment_descriptors[i].code_object_storage_base = obj->ElfData();
-      segment_descriptors[i].code_object_storage_size = obj->ElfSize();
-      segment_descriptors[i].code_object_storage_offset = seg->StorageOffset();
-      segment_descriptors[i].segment_base = seg->Address(seg->VAddr());
-      segment_descriptors[i].segment_size = seg->Size();
-      ++i;
+      hsa_ven_amd_loader_segment_descriptor_t descriptor;
+      descriptor.agent = seg->Agent();
+      descriptor.executable = Executable::Handle(seg->Owner());
+      descriptor.code_object_storage_type = HSA_VEN_AMD_LOADER_CODE_OBJECT_STORAGE_TYPE_MEMORY;
+      descriptor.code_object_storage_base = obj->ElfData();
+      descriptor.code_object_storage_size = obj->ElfSize();
+      descriptor.code_object_storage_offset = seg->StorageOffset();
+      descriptor.segment_base = seg->Address(seg->VAddr());
+      descriptor.segment_size = seg->Size();
+      descriptors.push_back(descriptor);
     }
   }
+}
 
-  return i - first_empty_segment_descriptor;
+void ExecutableImpl::PublishSegments()
+{
+  if (!loader_) {
+    return;
+  }
+  std::vector<hsa_ven_amd_loader_segment_descriptor_t> descriptors;
+  AppendSegmentDescriptors(descriptors);
+  loader_->UpdateSegments(id_, std::move(descriptors));
 }
 
 hsa_agent_t LoadedCodeObjectImpl::getAgent() const {
@@ -1100,6 +1272,7 @@ uint64_t ExecutableImpl::FindHostAddress(uint64_t device_address)
       assert(seg);
       uint64_t paddr = (uint64_t)(uintptr_t)seg->Address(seg->VAddr());
       if (paddr <= device_address && device_address < paddr + seg->Size()) {
+        if (!seg->Upload()) { return 0; }
         void *haddr = context_->SegmentHostAddress(
           seg->ElfSegment(), seg->Agent(), seg->Ptr(), device_address - paddr);
         return nullptr == haddr ? 0 : (uint64_t)(uintptr_t)haddr;
@@ -1109,16 +1282,6 @@ uint64_t ExecutableImpl::FindHostAddress(uint64_t device_address)
   return 0;
 }
 
-void ExecutableImpl::EnableReadOnlyMode()
-{
-  rw_lock_.ReaderLock();
-}
-
-void ExecutableImpl::DisableReadOnlyMode()
-{
-  rw_lock_.ReaderUnlock();
-}
-
 #define HSAERRCHECK(hsc)                                                       \
   if (hsc != HSA_STATUS_SUCCESS) {                                             \
     assert(false);                                                             \
@@ -1155,6 +1318,28 @@ hsa_status_t ExecutableImpl::GetInfo(
   return HSA_STATUS_SUCCESS;
 }
 
+// Size of the single load segment of a v2+ code object.
+static uint64_t LoadSegmentSizeV2(const code::AmdHsaCode *c)
+{
+  const code::Segment *last = c->DataSegment(c->DataSegmentCount() - 1);
+  return last->vaddr() + last->memSize();
+}
+
+// Builds the load segment image of @p c with the relocations in
+// @p prelinked->fixups applied for base address 0.
+static void BuildPrelinkedImage(const code::AmdHsaCode *c, PrelinkedSegment *prelinked)
+{
+  const uint64_t vaddr = c->DataSegment(0)->vaddr();
+  prelinked->image.assign(LoadSegmentSizeV2(c), 0);
+  for (size_t i = 0; i < c->DataSegmentCount(); ++i) {
+    const code::Segment *s = c->DataSegment(i);
+    if (s->imageSize() != 0) {
+      memcpy(prelinked->image.data() + (s->vaddr() - vaddr), s->data(), s->imageSize());
+    }
+  }
+  prelinked->Rebase(0, prelinked->image.data());
+}
+
 static uint32_t NextCodeObjectNum()
 {
   static std::atomic_uint_fast32_t dumpN(1);
@@ -1262,13 +1447,22 @@ hsa_status_t ExecutableImpl::LoadCodeObject(
     }
   }
 
+  // Dumps are written in the background from a copy of the code object,
+  // unless -dump-sync asks for them to be on disk before loading goes on.
+  bool dump_sync = loaderOptions.DumpSync()->is_set();
   if (loaderOptions.DumpAll()->is_set() || loaderOptions.DumpCode()->is_set()) {
-    if (!code->SaveToFile(amd::hsa::DumpFileName(loaderOptions.DumpDir()->value(), LOADER_DUMP_PREFIX, "hsaco", codeNum))) {
+    std::string filename = amd::hsa::DumpFileName(loaderOptions.DumpDir()->value(), LOADER_DUMP_PREFIX, "hsaco", codeNum);
+    if (!dump_sync) {
+      DumpPipeline::Instance().SaveCode(filename, code->ElfData(), code->ElfSize());
+    } else if (!code->SaveToFile(filename)) {
       // Ignore error.
     }
   }
   if (loaderOptions.DumpAll()->is_set() || loaderOptions.DumpIsa()->is_set()) {
-    if (!code->PrintToFile(amd::hsa::DumpFileName(loaderOptions.DumpDir()->value(), LOADER_DUMP_PREFIX, "isa", codeNum))) {
+    std::string filename = amd::hsa::DumpFileName(loaderOptions.DumpDir()->value(), LOADER_DUMP_PREFIX, "isa", codeNum);
+    if (!dump_sync) {
+      DumpPipeline::Instance().PrintCode(filename, code->ElfData(), code->ElfSize());
+    } else if (!code->PrintToFile(filename)) {
       // Ignore error.
     }
   }
@@ -1321,10 +1515,42 @@ hsa_status_t ExecutableImpl::LoadCodeObject(
 
   hsa_status_t status;
 
-  objects.push_back(new LoadedCodeObjectImpl(this, agent, code->ElfData(), code->ElfSize()));
+  LoadedCodeObjectImpl *loaded = arena_.New<LoadedCodeObjectImpl>(this, agent, code->ElfData(), code->ElfSize());
+  if (!loaded) { return HSA_STATUS_ERROR_OUT_OF_RESOURCES; }
+  objects.push_back(loaded);
   loaded_code_objects.push_back((LoadedCodeObjectImpl*)objects.back());
 
-  status = LoadSegments(agent, code.get(), majorVersion);
+  // Segments stay loaded even if a later step fails, so publish them on every
+  // way out, while the writer lock is still held.
+  struct SegmentPublisher {
+    ExecutableImpl *executable;
+    ~SegmentPublisher() { executable->PublishSegments(); }
+  } segment_publisher = { this };
+
+  // With a prelinked segment cache, a hit replaces the per-relocation
+  // segment writes with a single copy of the rebased image. Symbols are
+  // still loaded as usual.
+  std::unique_ptr<PrelinkedSegmentCache> prelink_cache;
+  std::string prelink_key;
+  PrelinkedSegment prelinked;
+  bool prelinked_hit = false;
+  if (loaderOptions.PrelinkCacheDir()->is_set() && majorVersion >= 2 && code->DataSegmentCount() != 0) {
+    prelink_cache.reset(new PrelinkedSegmentCache(loaderOptions.PrelinkCacheDir()->value()));
+    prelink_key = PrelinkedSegmentCache::Key(code->ElfData(), code->ElfSize(), codeIsa);
+    prelinked_hit = prelink_cache->Load(prelink_key, code->ElfData(), code->ElfSize(), codeIsa,
+                                        LoadSegmentSizeV2(code.get()), &prelinked);
+  }
+
+  // Lazy upload stages the segment in host memory, where relocations are
+  // applied as usual, and writes it to the agent with a single copy when
+  // first needed.
+  SegmentUploadMode upload_mode = SEGMENT_UPLOAD_AT_LOAD;
+  if (loaderOptions.LazyUpload()->is_set()) {
+    upload_mode = loaderOptions.UploadAtFreeze()->is_set() ? SEGMENT_UPLOAD_AT_FREEZE : SEGMENT_UPLOAD_ON_QUERY;
+  }
+
+  status = prelinked_hit ? LoadSegmentsV2(agent, code.get(), upload_mode, &prelinked)
+                         : LoadSegments(agent, code.get(), majorVersion, upload_mode);
   if (status != HSA_STATUS_SUCCESS) return status;
 
   for (size_t i = 0; i < code->SymbolCount(); ++i) {
@@ -1337,13 +1563,32 @@ hsa_status_t ExecutableImpl::LoadCodeObject(
     if (status != HSA_STATUS_SUCCESS) { return status; }
   }
 
-  status = ApplyRelocations(agent, code.get());
-  if (status != HSA_STATUS_SUCCESS) { return status; }
+  if (!prelinked_hit) {
+    prelink_fixups_ = prelink_cache ? &prelinked.fixups : nullptr;
+    prelink_cacheable_ = true;
+    status = ApplyRelocations(agent, code.get());
+    prelink_fixups_ = nullptr;
+    if (status != HSA_STATUS_SUCCESS) { return status; }
+
+    if (prelink_cache && prelink_cacheable_) {
+      BuildPrelinkedImage(code.get(), &prelinked);
+      if (!prelink_cache->Store(prelink_key, code->ElfData(), code->ElfSize(), codeIsa, prelinked)) {
+        // Ignore error.
+      }
+    }
+  }
 
   code.reset();
 
   if (loaderOptions.DumpAll()->is_set() || loaderOptions.DumpExec()->is_set()) {
-    if (!PrintToFile(amd::hsa::DumpFileName(loaderOptions.DumpDir()->value(), LOADER_DUMP_PREFIX, "exec", codeNum))) {
+    std::string filename = amd::hsa::DumpFileName(loaderOptions.DumpDir()->value(), LOADER_DUMP_PREFIX, "exec", codeNum);
+    if (!dump_sync) {
+      // The executable can change once the lock is dropped, so only the
+      // file write is deferred.
+      std::ostringstream text;
+      Print(text);
+      DumpPipeline::Instance().WriteText(filename, text.str());
+    } else if (!PrintToFile(filename)) {
       // Ignore error.
     }
   }
@@ -1361,11 +1606,13 @@ hsa_status_t ExecutableImpl::LoadCodeObject(
 
 hsa_status_t ExecutableImpl::LoadSegments(hsa_agent_t agent,
                                           const code::AmdHsaCode *c,
-                                          uint32_t majorVersion) {
+                                          uint32_t majorVersion,
+                                          SegmentUploadMode upload_mode) {
+  // Code object v1 segments are always uploaded at load.
   if (majorVersion < 2)
     return LoadSegmentsV1(agent, c);
   else
-    return LoadSegmentsV2(agent, c);
+    return LoadSegmentsV2(agent, c, upload_mode);
 }
 
 hsa_status_t ExecutableImpl::LoadSegmentsV1(hsa_agent_t agent,
@@ -1380,27 +1627,39 @@ hsa_status_t ExecutableImpl::LoadSegmentsV1(hsa_agent_t agent,
 }
 
 hsa_status_t ExecutableImpl::LoadSegmentsV2(hsa_agent_t agent,
-                                            const code::AmdHsaCode *c) {
+                                            const code::AmdHsaCode *c,
+                                            SegmentUploadMode upload_mode,
+                                            const PrelinkedSegment *prelinked) {
   assert(c->Machine() == ELF::EM_AMDGPU && "Program code objects are not supported");
 
   if (!c->DataSegmentCount()) return HSA_STATUS_ERROR_INVALID_CODE_OBJECT;
 
   uint64_t vaddr = c->DataSegment(0)->vaddr();
-  uint64_t size = c->DataSegment(c->DataSegmentCount() - 1)->vaddr() +
-                  c->DataSegment(c->DataSegmentCount() - 1)->memSize();
+  uint64_t size = LoadSegmentSizeV2(c);
 
   void *ptr = context_->SegmentAlloc(AMDGPU_HSA_SEGMENT_CODE_AGENT, agent, size,
       AMD_ISA_ALIGN_BYTES, true);
   if (!ptr) return HSA_STATUS_ERROR_OUT_OF_RESOURCES;
 
-  Segment *load_segment = new Segment(this, agent, AMDGPU_HSA_SEGMENT_CODE_AGENT,
+  Segment *load_segment = arena_.New<Segment>(this, agent, AMDGPU_HSA_SEGMENT_CODE_AGENT,
       ptr, size, vaddr, c->DataSegment(0)->offset());
-  if (!load_segment) return HSA_STATUS_ERROR_OUT_OF_RESOURCES;
+  if (!load_segment) {
+    context_->SegmentFree(AMDGPU_HSA_SEGMENT_CODE_AGENT, agent, ptr, size);
+    return HSA_STATUS_ERROR_OUT_OF_RESOURCES;
+  }
+  load_segment->DeferUpload(upload_mode);
 
   hsa_status_t status = HSA_STATUS_SUCCESS;
-  for (size_t i = 0; i < c->DataSegmentCount(); ++i) {
-    status = LoadSegmentV2(c->DataSegment(i), load_segment);
-    if (status != HSA_STATUS_SUCCESS) return status;
+  if (prelinked) {
+    assert(prelinked->image.size() == size);
+    std::vector<uint8_t> image(prelinked->image);
+    prelinked->Rebase(reinterpret_cast<uint64_t>(load_segment->Address(vaddr)), image.data());
+    load_segment->Copy(vaddr, image.data(), image.size());
+  } else {
+    for (size_t i = 0; i < c->DataSegmentCount(); ++i) {
+      status = LoadSegmentV2(c->DataSegment(i), load_segment);
+      if (status != HSA_STATUS_SUCCESS) return status;
+    }
   }
 
   objects.push_back(load_segment);
@@ -1424,7 +1683,11 @@ hsa_status_t ExecutableImpl::LoadSegmentV1(hsa_agent_t agent,
   if (need_alloc) {
     void* ptr = context_->SegmentAlloc(segment, agent, s->memSize(), s->align(), true);
     if (!ptr) { return HSA_STATUS_ERROR_OUT_OF_RESOURCES; }
-    new_seg = new Segment(this, agent, segment, ptr, s->memSize(), s->vaddr(), s->offset());
+    new_seg = arena_.New<Segment>(this, agent, segment, ptr, s->memSize(), s->vaddr(), s->offset());
+    if (!new_seg) {
+      context_->SegmentFree(segment, agent, ptr, s->memSize());
+      return HSA_STATUS_ERROR_OUT_OF_RESOURCES;
+    }
     new_seg->Copy(s->vaddr(), s->data(), s->imageSize());
     objects.push_back(new_seg);
 
@@ -1473,14 +1736,20 @@ hsa_status_t ExecutableImpl::LoadDefinitionSymbol(hsa_agent_t agent,
   if (majorVersion >= 2) {
     isAgent = agent.handle != 0;
   }
+  InternedString name = symbol_names_.Intern(sym->Name());
+  InternedString module_name = symbol_names_.Intern(sym->GetModuleName());
+  InternedString symbol_name = symbol_names_.Intern(sym->GetSymbolName());
+  if (name.IsNull() || module_name.IsNull() || symbol_name.IsNull()) {
+    return HSA_STATUS_ERROR_OUT_OF_RESOURCES;
+  }
   if (isAgent) {
-    auto agent_symbol = agent_symbols_.find(std::make_pair(sym->Name(), agent));
+    auto agent_symbol = agent_symbols_.find(std::make_pair(name, agent));
     if (agent_symbol != agent_symbols_.end()) {
       // TODO(spec): this is not spec compliant.
       return HSA_STATUS_ERROR_VARIABLE_ALREADY_DEFINED;
     }
   } else {
-    auto program_symbol = program_symbols_.find(sym->Name());
+    auto program_symbol = program_symbols_.find(name);
     if (program_symbol != program_symbols_.end()) {
       // TODO(spec): this is not spec compliant.
       return HSA_STATUS_ERROR_VARIABLE_ALREADY_DEFINED;
@@ -1489,7 +1758,7 @@ hsa_status_t ExecutableImpl::LoadDefinitionSymbol(hsa_agent_t agent,
 
   uint64_t address = SymbolAddress(agent, sym);
   SymbolImpl *symbol = nullptr;
-  if (string_ends_with(sym->GetSymbolName(), ".kd")) {
+  if (string_ends_with(symbol_name.str(), ".kd")) {
     // V3+.
     llvm::amdhsa::kernel_descriptor_t kd;
     sym->GetSection()->getData(sym->SectionOffset(), &kd, sizeof(kd));
@@ -1504,9 +1773,12 @@ hsa_status_t ExecutableImpl::LoadDefinitionSymbol(hsa_agent_t agent,
 
     uint64_t size = sym->Size();
 
-    KernelSymbol *kernel_symbol = new KernelSymbol(true,
-                                    sym->GetModuleName(),
-                                    sym->GetSymbolName(),
+    InternedString full_name = KernelFullName(module_name, symbol_name);
+    if (full_name.IsNull()) { return HSA_STATUS_ERROR_OUT_OF_RESOURCES; }
+    KernelSymbol *kernel_symbol = arena_.New<KernelSymbol>(true,
+                                    module_name,
+                                    symbol_name,
+                                    full_name,
                                     sym->Linkage(),
                                     true, // sym->IsDefinition()
                                     kernarg_segment_size,
@@ -1517,11 +1789,12 @@ hsa_status_t ExecutableImpl::LoadDefinitionSymbol(hsa_agent_t agent,
                                     size,
                                     64,
                                     address);
+    if (!kernel_symbol) { return HSA_STATUS_ERROR_OUT_OF_RESOURCES; }
     symbol = kernel_symbol;
   } else if (sym->IsVariableSymbol()) {
-    symbol = new VariableSymbol(true,
-                       sym->GetModuleName(),
-                       sym->GetSymbolName(),
+    symbol = arena_.New<VariableSymbol>(true,
+                       module_name,
+                       symbol_name,
                        sym->Linkage(),
                        true, // sym->IsDefinition()
                        sym->Allocation(),
@@ -1531,6 +1804,7 @@ hsa_status_t ExecutableImpl::LoadDefinitionSymbol(hsa_agent_t agent,
                        sym->IsConst(),
                        false,
                        address);
+    if (!symbol) { return HSA_STATUS_ERROR_OUT_OF_RESOURCES; }
   } else if (sym->IsKernelSymbol()) {
       amd_kernel_code_t akc;
       sym->GetSection()->getData(sym->SectionOffset(), &akc, sizeof(akc));
@@ -1553,9 +1827,12 @@ hsa_status_t ExecutableImpl::LoadDefinitionSymbol(hsa_agent_t agent,
         // calculate end of segment - symbol value.
         size = sym->GetSection()->size() - sym->SectionOffset();
       }
-      KernelSymbol *kernel_symbol = new KernelSymbol(true,
-                                      sym->GetModuleName(),
-                                      sym->GetSymbolName(),
+      InternedString full_name = KernelFullName(module_name, symbol_name);
+      if (full_name.IsNull()) { return HSA_STATUS_ERROR_OUT_OF_RESOURCES; }
+      KernelSymbol *kernel_symbol = arena_.New<KernelSymbol>(true,
+                                      module_name,
+                                      symbol_name,
+                                      full_name,
                                       sym->Linkage(),
                                       true, // sym->IsDefinition()
                                       kernarg_segment_size,
@@ -1566,6 +1843,7 @@ hsa_status_t ExecutableImpl::LoadDefinitionSymbol(hsa_agent_t agent,
                                       size,
                                       256,
                                       address);
+      if (!kernel_symbol) { return HSA_STATUS_ERROR_OUT_OF_RESOURCES; }
       kernel_symbol->debug_info.elf_raw = code->ElfData();
       kernel_symbol->debug_info.elf_size = code->ElfSize();
       kernel_symbol->debug_info.kernel_name = kernel_symbol->full_name.c_str();
@@ -1583,24 +1861,34 @@ hsa_status_t ExecutableImpl::LoadDefinitionSymbol(hsa_agent_t agent,
   }
 
   assert(symbol);
+  symbol->load_segment = SymbolSegment(agent, sym);
   if (isAgent) {
     symbol->agent = agent;
-    agent_symbols_.insert(std::make_pair(std::make_pair(sym->Name(), agent), symbol));
+    agent_symbols_.insert(std::make_pair(std::make_pair(name, agent), symbol));
   } else {
-    program_symbols_.insert(std::make_pair(sym->Name(), symbol));
+    program_symbols_.insert(std::make_pair(name, symbol));
   }
   return HSA_STATUS_SUCCESS;
 }
 
+InternedString ExecutableImpl::KernelFullName(const InternedString &module_name,
+                                              const InternedString &symbol_name)
+{
+  if (module_name.empty()) { return symbol_name; }
+  return symbol_names_.Intern(module_name.str() + "::" + symbol_name.str());
+}
+
 hsa_status_t ExecutableImpl::LoadDeclarationSymbol(hsa_agent_t agent,
                                                    code::Symbol* sym,
                                                    uint32_t majorVersion)
 {
-  auto program_symbol = program_symbols_.find(sym->Name());
+  std::string sym_name = sym->Name();
+  InternedString name = symbol_names_.Find(sym_name);
+  auto program_symbol = program_symbols_.find(name);
   if (program_symbol == program_symbols_.end()) {
-    auto agent_symbol = agent_symbols_.find(std::make_pair(sym->Name(), agent));
+    auto agent_symbol = agent_symbols_.find(std::make_pair(name, agent));
     if (agent_symbol == agent_symbols_.end()) {
-      logger_ << "LoaderError: symbol \"" << sym->Name() << "\" is undefined\n";
+      logger_ << "LoaderError: symbol \"" << sym_name << "\" is undefined\n";
 
       // TODO(spec): this is not spec compliant.
       return HSA_STATUS_ERROR_VARIABLE_UNDEFINED;
@@ -1678,6 +1966,8 @@ hsa_status_t ExecutableImpl::ApplyStaticRelocationSection(hsa_agent_t agent, amd
 {
   // Skip link-time relocations (if any).
   if (!(sec->targetSection()->flags() & SHF_ALLOC)) { return HSA_STATUS_SUCCESS; }
+  // Static relocations may create samplers and images, which cannot be cached.
+  if (sec->relocationCount() != 0) { prelink_cacheable_ = false; }
   hsa_status_t status = HSA_STATUS_SUCCESS;
   for (size_t i = 0; i < sec->relocationCount(); ++i) {
     status = ApplyStaticRelocation(agent, sec->relocation(i));
@@ -1718,6 +2008,7 @@ hsa_status_t ExecutableImpl::ApplyStaticRelocation(hsa_agent_t agent, amd::hsa::
             logger_ << "LoaderError: symbol \"" << sym->name() << "\" is undefined\n";
             return HSA_STATUS_ERROR_VARIABLE_UNDEFINED;
           }
+          if (!UploadSymbolSegment(esym)) { return HSA_STATUS_ERROR; }
           addr = esym->address;
           break;
         }
@@ -1867,6 +2158,7 @@ hsa_status_t ExecutableImpl::ApplyDynamicRelocation(hsa_agent_t agent, amd::hsa:
     {
       Segment* symSeg = VirtualAddressSegment(rel->symbol()->value());
       symAddr = reinterpret_cast<uint64_t>(symSeg->Address(rel->symbol()->value()));
+      if (symSeg != relSeg) { prelink_cacheable_ = false; }
       break;
     }
 
@@ -1876,9 +2168,16 @@ hsa_status_t ExecutableImpl::ApplyDynamicRelocation(hsa_agent_t agent, amd::hsa:
       // TODO: Only agent allocation variables are supported in v2.1. How will
       // we distinguish between program allocation and agent allocation
       // variables?
-      auto agent_symbol = agent_symbols_.find(std::make_pair(rel->symbol()->name(), agent));
-      if (agent_symbol != agent_symbols_.end())
+      InternedString name = symbol_names_.Find(rel->symbol()->name());
+      auto agent_symbol = agent_symbols_.find(std::make_pair(name, agent));
+      if (agent_symbol != agent_symbols_.end()) {
+        // The referencing code object may be uploaded before the one
+        // defining the symbol is ever queried.
+        if (!UploadSymbolSegment(agent_symbol->second)) { return HSA_STATUS_ERROR; }
         symAddr = agent_symbol->second->address;
+      }
+      // R_AMDGPU_RELATIVE64 refers to the null symbol and does not use it.
+      if (rel->type() != R_AMDGPU_RELATIVE64) { prelink_cacheable_ = false; }
       break;
     }
 
@@ -1898,6 +2197,7 @@ hsa_status_t ExecutableImpl::ApplyDynamicRelocation(hsa_agent_t agent, amd::hsa:
 
       uint32_t symAddr32 = uint32_t((symAddr >> 32) & 0xFFFFFFFF);
       relSeg->Copy(rel->offset(), &symAddr32, sizeof(symAddr32));
+      RecordFixup(relSeg, rel->offset(), rel->type(), symAddr);
       break;
     }
 
@@ -1910,6 +2210,7 @@ hsa_status_t ExecutableImpl::ApplyDynamicRelocation(hsa_agent_t agent, amd::hsa:
 
       uint32_t symAddr32 = uint32_t(symAddr & 0xFFFFFFFF);
       relSeg->Copy(rel->offset(), &symAddr32, sizeof(symAddr32));
+      RecordFixup(relSeg, rel->offset(), rel->type(), symAddr);
       break;
     }
 
@@ -1921,6 +2222,7 @@ hsa_status_t ExecutableImpl::ApplyDynamicRelocation(hsa_agent_t agent, amd::hsa:
       }
 
       relSeg->Copy(rel->offset(), &symAddr, sizeof(symAddr));
+      RecordFixup(relSeg, rel->offset(), rel->type(), symAddr);
       break;
     }
 
@@ -1929,6 +2231,7 @@ hsa_status_t ExecutableImpl::ApplyDynamicRelocation(hsa_agent_t agent, amd::hsa:
       int64_t baseDelta = reinterpret_cast<uint64_t>(relSeg->Address(0)) - relSeg->VAddr();
       uint64_t relocatedAddr = baseDelta + rel->addend();
       relSeg->Copy(rel->offset(), &relocatedAddr, sizeof(relocatedAddr));
+      RecordFixup(relSeg, rel->offset(), rel->type(), relocatedAddr);
       break;
     }
 
@@ -1938,6 +2241,14 @@ hsa_status_t ExecutableImpl::ApplyDynamicRelocation(hsa_agent_t agent, amd::hsa:
   return HSA_STATUS_SUCCESS;
 }
 
+void ExecutableImpl::RecordFixup(Segment *seg, uint64_t offset, uint32_t type, uint64_t value)
+{
+  if (!prelink_fixups_ || !prelink_cacheable_) { return; }
+  const uint64_t base = reinterpret_cast<uint64_t>(seg->Address(seg->VAddr()));
+  SegmentFixup fixup = { seg->Offset(offset), type, 0, value - base };
+  prelink_fixups_->push_back(fixup);
+}
+
 hsa_status_t ExecutableImpl::Freeze(const char *options) {
   amd::hsa::common::WriterLockGuard<amd::hsa::common::ReaderWriterLock> writer_lock(rw_lock_);
   if (HSA_EXECUTABLE_STATE_FROZEN == state_) {
@@ -1951,6 +2262,7 @@ hsa_status_t ExecutableImpl::Freeze(const char *options) {
   }
 
   state_ = HSA_EXECUTABLE_STATE_FROZEN;
+  PublishSegments();
   return HSA_STATUS_SUCCESS;
 }
 
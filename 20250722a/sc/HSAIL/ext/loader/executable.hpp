@@ -44,12 +44,16 @@
 #define HSA_RUNTIME_CORE_LOADER_EXECUTABLE_HPP_
 
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cstdint>
 #include <iostream>
 #include <libelf.h>
 #include <limits.h>
 #include <list>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -61,6 +65,10 @@
 #include "amd_hsa_code.hpp"
 #include "amd_hsa_kernel_code.h"
 #include "amd_hsa_locks.hpp"
+#include "object_arena.hpp"
+#include "segment_cache.hpp"
+#include "segment_suballocator.hpp"
+#include "string_interner.hpp"
 
 #if defined(_WIN32) || defined(_WIN64)
 #if _WIN64
@@ -136,6 +144,7 @@ class SymbolImpl;
 class KernelSymbol;
 class VariableSymbol;
 class ExecutableImpl;
+class Segment;
 
 //===----------------------------------------------------------------------===//
 // SymbolImpl.                                                                //
@@ -156,12 +165,14 @@ public:
 
   bool is_loaded;
   hsa_symbol_kind_t kind;
-  std::string module_name;
-  std::string symbol_name;
+  InternedString module_name;
+  InternedString symbol_name;
   hsa_symbol_linkage_t linkage;
   bool is_definition;
   uint64_t address;
   hsa_agent_t agent;
+  // Load segment holding the definition, or null for external definitions.
+  Segment *load_segment;
 
   hsa_agent_t GetAgent() override {
     return agent;
@@ -170,8 +181,8 @@ public:
 protected:
   SymbolImpl(const bool &_is_loaded,
              const hsa_symbol_kind_t &_kind,
-             const std::string &_module_name,
-             const std::string &_symbol_name,
+             const InternedString &_module_name,
+             const InternedString &_symbol_name,
              const hsa_symbol_linkage_t &_linkage,
              const bool &_is_definition,
              const uint64_t &_address = 0)
@@ -181,7 +192,8 @@ protected:
     , symbol_name(_symbol_name)
     , linkage(_linkage)
     , is_definition(_is_definition)
-    , address(_address) {}
+    , address(_address)
+    , load_segment(nullptr) {}
 
   virtual bool GetInfo(hsa_symbol_info32_t symbol_info, void* value) override;
 
@@ -197,8 +209,9 @@ private:
 class KernelSymbol final: public SymbolImpl {
 public:
   KernelSymbol(const bool &_is_loaded,
-               const std::string &_module_name,
-               const std::string &_symbol_name,
+               const InternedString &_module_name,
+               const InternedString &_symbol_name,
+               const InternedString &_full_name,
                const hsa_symbol_linkage_t &_linkage,
                const bool &_is_definition,
                const uint32_t &_kernarg_segment_size,
@@ -216,7 +229,7 @@ public:
                  _linkage,
                  _is_definition,
                  _address)
-    , full_name(_module_name.empty() ? _symbol_name : _module_name + "::" + _symbol_name)
+    , full_name(_full_name)
     , kernarg_segment_size(_kernarg_segment_size)
     , kernarg_segment_alignment(_kernarg_segment_alignment)
     , group_segment_size(_group_segment_size)
@@ -229,7 +242,8 @@ public:
 
   bool GetInfo(hsa_symbol_info32_t symbol_info, void *value);
 
-  std::string full_name;
+  // module_name::symbol_name, or symbol_name if there is no module name.
+  InternedString full_name;
   uint32_t kernarg_segment_size;
   uint32_t kernarg_segment_alignment;
   uint32_t group_segment_size;
@@ -251,8 +265,8 @@ private:
 class VariableSymbol final: public SymbolImpl {
 public:
   VariableSymbol(const bool &_is_loaded,
-                 const std::string &_module_name,
-                 const std::string &_symbol_name,
+                 const InternedString &_module_name,
+                 const InternedString &_symbol_name,
                  const hsa_symbol_linkage_t &_linkage,
                  const bool &_is_definition,
                  const hsa_variable_allocation_t &_allocation,
@@ -332,6 +346,7 @@ private:
 // Executable.                                                                //
 //===----------------------------------------------------------------------===//
 
+class AmdHsaCodeLoader;
 class ExecutableImpl;
 class LoadedCodeObjectImpl;
 class Segment;
@@ -398,6 +413,18 @@ public:
   link_map r_debug_info;
 };
 
+// When the contents of a loaded segment are written to its memory.
+enum SegmentUploadMode {
+  // Copied and relocated in place while loading.
+  SEGMENT_UPLOAD_AT_LOAD,
+  // Staged in host memory while loading and uploaded with a single copy the
+  // first time a symbol in the segment is queried.
+  SEGMENT_UPLOAD_ON_QUERY,
+  // As SEGMENT_UPLOAD_ON_QUERY, but uploaded when the executable is frozen
+  // at the latest.
+  SEGMENT_UPLOAD_AT_FREEZE
+};
+
 class Segment : public LoadedSegment, public ExecutableObject {
 private:
   amdgpu_hsa_elf_segment_t segment;
@@ -407,10 +434,21 @@ private:
   bool frozen;
   size_t storage_offset;
 
+  // Deferred upload state. staged holds the segment contents until they are
+  // uploaded; upload_deferred lets queries skip upload_lock once they are.
+  std::mutex upload_lock;
+  std::atomic<bool> upload_deferred;
+  std::unique_ptr<std::vector<uint8_t>> staged;
+  SegmentUploadMode upload_mode;
+  bool freeze_on_upload;
+
+  bool UploadLocked();
+
 public:
   Segment(ExecutableImpl *owner_, hsa_agent_t agent_, amdgpu_hsa_elf_segment_t segment_, void* ptr_, size_t size_, uint64_t vaddr_, size_t storage_offset_)
     : ExecutableObject(owner_, agent_), segment(segment_),
-      ptr(ptr_), size(size_), vaddr(vaddr_), frozen(false), storage_offset(storage_offset_) { }
+      ptr(ptr_), size(size_), vaddr(vaddr_), frozen(false), storage_offset(storage_offset_),
+      upload_deferred(false), upload_mode(SEGMENT_UPLOAD_AT_LOAD), freeze_on_upload(false) { }
 
   amdgpu_hsa_elf_segment_t ElfSegment() const { return segment; }
   void* Ptr() const { return ptr; }
@@ -426,6 +464,17 @@ public:
 
   bool Freeze();
 
+  // Makes Copy() write to a zero-filled host staging copy of the segment
+  // until Upload(). Must be called before the first Copy().
+  void DeferUpload(SegmentUploadMode mode);
+
+  // Writes the staged contents to the segment, and freezes it if Freeze()
+  // was called meanwhile. Does nothing if the upload was not deferred or is
+  // done. Thread safe.
+  bool Upload();
+
+  bool IsUploadDeferred() const { return upload_deferred.load(std::memory_order_acquire); }
+
   bool IsAddressInSegment(uint64_t addr);
   void Copy(uint64_t addr, const void* src, size_t size);
   void Print(std::ostream& out) override;
@@ -454,10 +503,11 @@ public:
   void Destroy() override;
 };
 
-typedef std::string ProgramSymbol;
-typedef std::unordered_map<ProgramSymbol, SymbolImpl*> ProgramSymbolMap;
+// Symbol names are interned by the executable, so maps are keyed by handle.
+typedef InternedString ProgramSymbol;
+typedef std::unordered_map<ProgramSymbol, SymbolImpl*, InternedStringHash> ProgramSymbolMap;
 
-typedef std::pair<std::string, hsa_agent_t> AgentSymbol;
+typedef std::pair<InternedString, hsa_agent_t> AgentSymbol;
 struct ASC {
   bool operator()(const AgentSymbol &las, const AgentSymbol &ras) const {
     return las.first == ras.first && las.second.handle == ras.second.handle;
@@ -465,7 +515,7 @@ struct ASC {
 };
 struct ASH {
   size_t operator()(const AgentSymbol &as) const {
-    size_t h = std::hash<std::string>()(as.first);
+    size_t h = InternedStringHash()(as.first);
     size_t i = std::hash<uint64_t>()(as.second.handle);
     return h ^ (i << 1);
   }
@@ -485,8 +535,10 @@ public:
   ExecutableImpl(
       const hsa_profile_t &_profile,
       Context *context,
+      AmdHsaCodeLoader *loader,
       size_t id,
-      hsa_default_float_rounding_mode_t default_float_rounding_mode);
+      hsa_default_float_rounding_mode_t default_float_rounding_mode,
+      std::shared_ptr<SegmentSlabPool> slab_pool = nullptr);
 
   ~ExecutableImpl();
 
@@ -581,15 +633,16 @@ public:
 
   uint64_t FindHostAddress(uint64_t device_address) override;
 
-  void EnableReadOnlyMode();
-  void DisableReadOnlyMode();
-
   void Print(std::ostream& out) override;
   bool PrintToFile(const std::string& filename) override;
 
   Context* context() { return context_; }
   size_t id() { return id_; }
 
+  // Track segments whose upload is deferred and still pending.
+  void AddDeferredUpload() { deferred_uploads_.fetch_add(1, std::memory_order_relaxed); }
+  void RemoveDeferredUpload() { deferred_uploads_.fetch_sub(1, std::memory_order_release); }
+
 private:
   ExecutableImpl(const ExecutableImpl &e);
   ExecutableImpl& operator=(const ExecutableImpl &e);
@@ -600,10 +653,24 @@ private:
     const char *symbol_name,
     const hsa_agent_t *agent);
 
+  // Uploads the load segment of @p symbol if its upload was deferred, so
+  // that the symbol's address can be handed out.
+  bool UploadSymbolSegment(SymbolImpl *symbol);
+
+  // Appends the descriptors of all loaded segments, including those whose
+  // deferred upload is still pending (see -lazy-upload). Requires rw_lock_.
+  void AppendSegmentDescriptors(std::vector<hsa_ven_amd_loader_segment_descriptor_t> &descriptors);
+
+  // Hands the current segment descriptors to the loader's snapshot. Requires
+  // the writer lock.
+  void PublishSegments();
+
   hsa_status_t LoadSegments(hsa_agent_t agent, const code::AmdHsaCode *c,
-                            uint32_t majorVersion);
+                            uint32_t majorVersion, SegmentUploadMode upload_mode);
   hsa_status_t LoadSegmentsV1(hsa_agent_t agent, const code::AmdHsaCode *c);
-  hsa_status_t LoadSegmentsV2(hsa_agent_t agent, const code::AmdHsaCode *c);
+  hsa_status_t LoadSegmentsV2(hsa_agent_t agent, const code::AmdHsaCode *c,
+                              SegmentUploadMode upload_mode,
+                              const PrelinkedSegment *prelinked = nullptr);
   hsa_status_t LoadSegmentV1(hsa_agent_t agent, const code::Segment *s);
   hsa_status_t LoadSegmentV2(const code::Segment *data_segment,
                              loader::Segment *load_segment);
@@ -612,12 +679,20 @@ private:
   hsa_status_t LoadDefinitionSymbol(hsa_agent_t agent, amd::hsa::code::Symbol* sym, uint32_t majorVersion);
   hsa_status_t LoadDeclarationSymbol(hsa_agent_t agent, amd::hsa::code::Symbol* sym, uint32_t majorVersion);
 
+  // Interns module_name::symbol_name, or returns @p symbol_name if there is
+  // no module name.
+  InternedString KernelFullName(const InternedString &module_name, const InternedString &symbol_name);
+
   hsa_status_t ApplyRelocations(hsa_agent_t agent, amd::hsa::code::AmdHsaCode *c);
   hsa_status_t ApplyStaticRelocationSection(hsa_agent_t agent, amd::hsa::code::RelocationSection* sec);
   hsa_status_t ApplyStaticRelocation(hsa_agent_t agent, amd::hsa::code::Relocation *rel);
   hsa_status_t ApplyDynamicRelocationSection(hsa_agent_t agent, amd::hsa::code::RelocationSection* sec);
   hsa_status_t ApplyDynamicRelocation(hsa_agent_t agent, amd::hsa::code::Relocation *rel);
 
+  // Records a relocation written at @p offset of @p seg for the prelinked
+  // segment cache, if one is being built.
+  void RecordFixup(Segment *seg, uint64_t offset, uint32_t type, uint64_t value);
+
   Segment* VirtualAddressSegment(uint64_t vaddr);
   uint64_t SymbolAddress(hsa_agent_t agent, amd::hsa::code::Symbol* sym);
   uint64_t SymbolAddress(hsa_agent_t agent, amd::elf::Symbol* sym);
@@ -626,17 +701,34 @@ private:
 
   amd::hsa::common::ReaderWriterLock rw_lock_;
   hsa_profile_t profile_;
+  // The loader's context, or suballocator_ if the executable has one.
   Context *context_;
+  std::unique_ptr<SuballocatingContext> suballocator_;
+  AmdHsaCodeLoader *loader_;
   Logger logger_;
   const size_t id_;
   hsa_default_float_rounding_mode_t default_float_rounding_mode_;
   hsa_executable_state_t state_;
 
+  // Names of all symbols, their modules and kernels' full names.
+  StringInterner symbol_names_;
   ProgramSymbolMap program_symbols_;
   AgentSymbolMap agent_symbols_;
+  // Backs every object in objects and every symbol in the symbol maps.
+  ObjectArena arena_;
   std::vector<ExecutableObject*> objects;
   Segment *program_allocation_segment;
   std::vector<LoadedCodeObjectImpl*> loaded_code_objects;
+
+  // Fixups of the code object being loaded, when the prelinked segment cache
+  // is enabled and missed. Cleared if a relocation depends on anything but
+  // the load segment's own address.
+  std::vector<SegmentFixup> *prelink_fixups_;
+  bool prelink_cacheable_;
+
+  // Number of segments with a pending deferred upload. While it is zero,
+  // symbol queries need not look at the symbol's segment.
+  std::atomic<uint32_t> deferred_uploads_;
 };
 
 class AmdHsaCodeLoader : public Loader {
@@ -644,10 +736,28 @@ private:
   Context* context;
   std::vector<Executable*> executables;
   amd::hsa::common::ReaderWriterLock rw_lock_;
+  // Slabs for executables created with -suballocate-segments. Created on
+  // first use and shared with those executables, which may outlive the
+  // loader.
+  std::shared_ptr<SegmentSlabPool> slab_pool_;
+
+  // Serializes snapshot publication; readers of the snapshot never take it.
+  std::mutex snapshot_mutex_;
+  // Segment descriptors of each executable with segments, by executable id.
+  std::map<size_t, std::vector<hsa_ven_amd_loader_segment_descriptor_t>> executable_segments_;
+  // Only accessed through std::atomic_load and std::atomic_store.
+  std::shared_ptr<const SegmentSnapshot> segment_snapshot_;
+  std::atomic<uint64_t> segment_generation_;
+
+  // Builds and publishes a new snapshot. Requires snapshot_mutex_.
+  void PublishSegmentSnapshot();
 
 public:
   AmdHsaCodeLoader(Context* context_)
-    : context(context_) { assert(context); }
+    : context(context_),
+      segment_snapshot_(std::make_shared<SegmentSnapshot>(
+        0, std::vector<hsa_ven_amd_loader_segment_descriptor_t>())),
+      segment_generation_(0) { assert(context); }
 
   Context* GetContext() const override { return context; }
 
@@ -675,8 +785,13 @@ public:
 
   void PrintHelp(std::ostream& out) override;
 
-  void EnableReadOnlyMode();
-  void DisableReadOnlyMode();
+  std::shared_ptr<const SegmentSnapshot> GetSegmentSnapshot() const override;
+
+  uint64_t SegmentGeneration() const override;
+
+  // Replaces the segment descriptors of executable @p id and publishes a new
+  // snapshot.
+  void UpdateSegments(size_t id, std::vector<hsa_ven_amd_loader_segment_descriptor_t> &&descriptors);
 };
 
 } // namespace loader
@@ -40,6 +40,7 @@
 //
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <cstring>
 #include <cassert>
 #include "loaders.hpp"
@@ -78,113 +79,72 @@ namespace loader {
   OfflineLoaderContext::OfflineLoaderContext()
     : out(std::cout)
   {
-    invalid.handle = 0;
-    gfx700.handle = 700;
-    gfx701.handle = 701;
-    gfx800.handle = 800;
-    gfx801.handle = 801;
-    gfx802.handle = 802;
-    gfx803.handle = 803;
-    gfx804.handle = 804;
-    gfx810.handle = 810;
-    gfx900.handle = 900;
-    gfx901.handle = 901;
-    gfx902.handle = 902;
-    gfx903.handle = 903;
-    gfx904.handle = 904;
-    gfx905.handle = 905;
-    gfx906.handle = 906;
-    gfx907.handle = 907;
-    gfx1000.handle = 1000;
-    gfx1001.handle = 1001;
-    gfx1010.handle = 1010;
-    gfx1011.handle = 1011;
-    gfx1012.handle = 1012;
-    gfx1030.handle = 1030;
-    gfx4000.handle = 4000;
+  }
+
+  namespace {
+
+  // Handles for code object v2 names, sorted by name (strcmp order). Each
+  // name keeps its own handle, even where names map to the same processor.
+  struct LegacyIsa {
+    const char *name;
+    uint64_t handle;
+  };
+
+  const LegacyIsa kLegacyIsas[] = {
+    { "AMD:AMDGPU:10:0:0", 1000 },
+    { "AMD:AMDGPU:10:0:1", 1001 },
+    { "AMD:AMDGPU:10:1:0", 1010 },
+    { "AMD:AMDGPU:10:1:1", 1011 },
+    { "AMD:AMDGPU:10:1:2", 1012 },
+    { "AMD:AMDGPU:10:3:0", 1030 },
 #if defined(GFX11_BUILD)
-    gfx1100.handle = 1100;
-    gfx1101.handle = 1101;
-    gfx1102.handle = 1102;
-    gfx1103.handle = 1103;
-    gfx1150.handle = 1150;
-    gfx1151.handle = 1151;
+    { "AMD:AMDGPU:11:0:0", 1100 },
+    { "AMD:AMDGPU:11:0:1", 1101 },
+    { "AMD:AMDGPU:11:0:2", 1102 },
+    { "AMD:AMDGPU:11:0:3", 1103 },
+    { "AMD:AMDGPU:11:5:0", 1150 },
+    { "AMD:AMDGPU:11:5:1", 1151 },
 #endif // GFX11_BUILD
-  }
+    { "AMD:AMDGPU:40:0:0", 4000 },
+    { "AMD:AMDGPU:7:0:0",  700 },
+    { "AMD:AMDGPU:7:0:1",  701 },
+    { "AMD:AMDGPU:8:0:0",  800 },
+    { "AMD:AMDGPU:8:0:1",  801 },
+    { "AMD:AMDGPU:8:0:2",  802 },
+    { "AMD:AMDGPU:8:0:3",  803 },
+    { "AMD:AMDGPU:8:0:4",  804 },
+    { "AMD:AMDGPU:8:1:0",  810 },
+    { "AMD:AMDGPU:9:0:0",  900 },
+    { "AMD:AMDGPU:9:0:1",  901 },
+    { "AMD:AMDGPU:9:0:2",  902 },
+    { "AMD:AMDGPU:9:0:3",  903 },
+    { "AMD:AMDGPU:9:0:4",  904 },
+    { "AMD:AMDGPU:9:0:5",  905 },
+    { "AMD:AMDGPU:9:0:6",  906 },
+    { "AMD:AMDGPU:9:0:7",  907 },
+  };
+
+  } // namespace anonymous
 
   hsa_isa_t OfflineLoaderContext::IsaFromName(const char *name)
   {
-    std::string sname(name);
-    if (sname == "AMD:AMDGPU:7:0:0") {
-      return gfx700;
-    } else if (sname == "AMD:AMDGPU:7:0:1") {
-      return gfx701;
-    } else if (sname == "AMD:AMDGPU:8:0:0") {
-      return gfx800;
-    } else if (sname == "AMD:AMDGPU:8:0:1") {
-      return gfx801;
-    } else if (sname == "AMD:AMDGPU:8:0:2") {
-      return gfx802;
-    } else if (sname == "AMD:AMDGPU:8:0:3") {
-      return gfx803;
-    } else if (sname == "AMD:AMDGPU:8:0:4") {
-      return gfx804;
-    } else if (sname == "AMD:AMDGPU:8:1:0") {
-      return gfx810;
-    } else if (sname == "AMD:AMDGPU:9:0:0") {
-      return gfx900;
-    } else if (sname == "AMD:AMDGPU:9:0:1") {
-      return gfx901;
-    } else if (sname == "AMD:AMDGPU:9:0:2") {
-      return gfx902;
-    } else if (sname == "AMD:AMDGPU:9:0:3") {
-      return gfx903;
-    }
-      else if (sname == "AMD:AMDGPU:9:0:4") {
-      return gfx904;
-    } else if (sname == "AMD:AMDGPU:9:0:5") {
-      return gfx905;
-    }
-      else if (sname == "AMD:AMDGPU:9:0:6") {
-      return gfx906;
-    } else if (sname == "AMD:AMDGPU:9:0:7") {
-      return gfx907;
+    hsa_isa_t isa = {0};
+    const LegacyIsa *legacy_end = kLegacyIsas + sizeof(kLegacyIsas) / sizeof(kLegacyIsas[0]);
+    const LegacyIsa *legacy = std::lower_bound(kLegacyIsas, legacy_end, name,
+      [](const LegacyIsa &entry, const char *key) { return strcmp(entry.name, key) < 0; });
+    if (legacy != legacy_end && strcmp(legacy->name, name) == 0) {
+      isa.handle = legacy->handle;
+      return isa;
     }
-      else if (sname == "AMD:AMDGPU:10:0:0") {
-      return gfx1000;
-    } else if (sname == "AMD:AMDGPU:10:0:1") {
-      return gfx1001;
-    } else if (sname == "AMD:AMDGPU:10:1:0") {
-      return gfx1010;
-    } else if (sname == "AMD:AMDGPU:10:1:1") {
-      return gfx1011;
-    } else if (sname == "AMD:AMDGPU:10:1:2") {
-      return gfx1012;
-    }
-      else if (sname == "AMD:AMDGPU:10:3:0") {
-      return gfx1030;
-    }
-      else if (sname == "AMD:AMDGPU:40:0:0") {
-      return gfx4000;
-    }
-#if defined(GFX11_BUILD)
-      else if (sname == "AMD:AMDGPU:11:0:0") {
-      return gfx1100;
-    } else if (sname == "AMD:AMDGPU:11:0:1") {
-      return gfx1101;
-    } else if (sname == "AMD:AMDGPU:11:0:2") {
-      return gfx1102;
-    } else if (sname == "AMD:AMDGPU:11:0:3") {
-      return gfx1103;
-    } else if (sname == "AMD:AMDGPU:11:5:0") {
-      return gfx1150;
-    } else if (sname == "AMD:AMDGPU:11:5:1") {
-      return gfx1151;
-    }
-#endif // GFX11_BUILD
 
-    assert(0);
-    return invalid;
+    // Other names get a handle encoding the processor and feature settings,
+    // so equal targets get equal handles. The lowest mach value shifted up
+    // is above every legacy handle. Zero means the name is not recognized.
+    amd::hsa::TargetId id;
+    if (targets.Find(name, &id)) {
+      isa.handle = (uint64_t(id.processor->mach) << 8) | (uint64_t(id.sramecc) << 4) | id.xnack;
+    }
+    return isa;
   }
 
   bool OfflineLoaderContext::IsaSupportedByAgent(hsa_agent_t agent, hsa_isa_t isa)
@@ -44,6 +44,7 @@
 #define LOADERS_HPP_
 
 #include "amd_hsa_loader.hpp"
+#include "amd_hsa_target.hpp"
 #include <set>
 #include <iostream>
 
@@ -53,17 +54,7 @@ namespace loader {
 
   class OfflineLoaderContext : public amd::hsa::loader::Context {
   private:
-    hsa_isa_t invalid;
-    hsa_isa_t gfx700, gfx701, gfx800, gfx801, gfx802, gfx803, gfx804, gfx810;
-    hsa_isa_t gfx900, gfx901, gfx902, gfx903;
-    hsa_isa_t gfx904, gfx905;
-    hsa_isa_t gfx906, gfx907;
-    hsa_isa_t gfx1000, gfx1001, gfx1010, gfx1011, gfx1012;
-    hsa_isa_t gfx1030;
-    hsa_isa_t gfx4000;
-#if defined(GFX11_BUILD)
-    hsa_isa_t gfx1100, gfx1101, gfx1102, gfx1103, gfx1150, gfx1151;
-#endif // GFX11_BUILD
+    amd::hsa::TargetIdCache targets;
     std::ostream& out;
     typedef std::set<void*> PointerSet;
     PointerSet pointers;
@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "object_arena.hpp"
+
+#include <cassert>
+#include <cstdlib>
+
+namespace amd {
+namespace hsa {
+namespace loader {
+
+ObjectArena::ObjectArena(size_t initial_block_bytes, size_t max_block_bytes)
+  : blocks_(nullptr)
+  , cursor_(0)
+  , end_(0)
+  , next_block_bytes_(initial_block_bytes)
+  , max_block_bytes_(max_block_bytes < initial_block_bytes ? initial_block_bytes : max_block_bytes)
+  , resident_bytes_(0)
+  , block_count_(0)
+{
+}
+
+ObjectArena::~ObjectArena()
+{
+  while (blocks_) {
+    Block *next = blocks_->next;
+    free(blocks_);
+    blocks_ = next;
+  }
+}
+
+void *ObjectArena::AllocateSlow(size_t size, size_t align)
+{
+  assert(align != 0 && (align & (align - 1)) == 0 && align <= alignof(std::max_align_t));
+
+  // malloc returns max_align_t aligned memory, so reserving align bytes past
+  // the header is always enough.
+  const size_t header = (sizeof(Block) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+  size_t block_bytes = next_block_bytes_;
+  if (header + size + align > block_bytes) {
+    block_bytes = header + size + align;
+  } else if (next_block_bytes_ < max_block_bytes_) {
+    next_block_bytes_ *= 2;
+    if (next_block_bytes_ > max_block_bytes_) { next_block_bytes_ = max_block_bytes_; }
+  }
+
+  Block *block = static_cast<Block*>(malloc(block_bytes));
+  if (!block) { return nullptr; }
+  block->size = block_bytes;
+  block->next = blocks_;
+  blocks_ = block;
+  resident_bytes_ += block_bytes;
+  ++block_count_;
+
+  const uintptr_t base = reinterpret_cast<uintptr_t>(block);
+  const uintptr_t start = (base + header + (align - 1)) & ~uintptr_t(align - 1);
+  const uintptr_t end = base + block_bytes;
+  // Keep the bump pointer in whichever block has more room left, so one
+  // oversized request does not waste the rest of the current block.
+  if (end - (start + size) >= end_ - cursor_) {
+    cursor_ = start + size;
+    end_ = end;
+  }
+  return reinterpret_cast<void*>(start);
+}
+
+} // namespace loader
+} // namespace hsa
+} // namespace amd
@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef HSA_RUNTIME_CORE_LOADER_OBJECT_ARENA_HPP_
+#define HSA_RUNTIME_CORE_LOADER_OBJECT_ARENA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace amd {
+namespace hsa {
+namespace loader {
+
+/// @brief Bump allocator whose memory is released all at once.
+///
+/// Along the lines of PAL's VirtualLinearAllocator: allocations are carved
+/// from a chain of blocks, never freed individually, and the blocks are
+/// freed when the arena is destroyed. Blocks double in size from
+/// @p initial_block_bytes up to @p max_block_bytes, so small arenas stay
+/// small and large ones need few mallocs. Requests larger than a block get
+/// a block of their own.
+///
+/// Objects made with New() must be destroyed with Delete() (or not at all,
+/// if their destructor is trivial) before the arena goes away; the arena
+/// does not track them.
+///
+/// Not thread safe.
+class ObjectArena final {
+public:
+  explicit ObjectArena(size_t initial_block_bytes = 4 * 1024, size_t max_block_bytes = 64 * 1024);
+  ~ObjectArena();
+
+  /// @returns @p size bytes aligned to @p align, which must be a power of
+  /// two no larger than alignof(std::max_align_t), or null if out of memory.
+  void *Allocate(size_t size, size_t align);
+
+  /// @returns A new T constructed from @p args, or null if out of memory.
+  template <typename T, typename... Args>
+  T *New(Args&&... args) {
+    void *storage = Allocate(sizeof(T), alignof(T));
+    return storage ? new (storage) T(std::forward<Args>(args)...) : nullptr;
+  }
+
+  /// @brief Runs the destructor of @p object, which must come from New().
+  /// Its memory is reclaimed with the arena.
+  template <typename T>
+  static void Delete(T *object) {
+    if (object) { object->~T(); }
+  }
+
+  /// @returns Bytes held in blocks, whether used or not.
+  size_t ResidentBytes() const { return resident_bytes_; }
+
+  /// @returns Number of blocks allocated, i.e. mallocs made.
+  size_t BlockCount() const { return block_count_; }
+
+private:
+  ObjectArena(const ObjectArena&);
+  ObjectArena& operator=(const ObjectArena&);
+
+  // Blocks are chained through a header at their start.
+  struct Block {
+    Block *next;
+    size_t size;
+  };
+
+  void *AllocateSlow(size_t size, size_t align);
+
+  Block *blocks_;
+  uintptr_t cursor_;
+  uintptr_t end_;
+  size_t next_block_bytes_;
+  const size_t max_block_bytes_;
+  size_t resident_bytes_;
+  size_t block_count_;
+};
+
+inline void *ObjectArena::Allocate(size_t size, size_t align)
+{
+  const uintptr_t start = (cursor_ + (align - 1)) & ~uintptr_t(align - 1);
+  if (start < end_ && end_ - start >= size) {
+    cursor_ = start + size;
+    return reinterpret_cast<void*>(start);
+  }
+  return AllocateSlow(size, align);
+}
+
+} // namespace loader
+} // namespace hsa
+} // namespace amd
+
+#endif // HSA_RUNTIME_CORE_LOADER_OBJECT_ARENA_HPP_
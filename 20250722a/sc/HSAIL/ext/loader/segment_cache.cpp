@@ -0,0 +1,269 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "segment_cache.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include "amd_hsa_elf.h"
+
+namespace amd {
+namespace hsa {
+namespace loader {
+
+namespace {
+
+const char kEntryMagic[8] = { 'A', 'M', 'D', 'P', 'L', 'N', 'K', '\0' };
+const uint32_t kEntryVersion = 2;
+
+struct EntryHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t isa_size;
+  uint64_t elf_size;
+  uint64_t image_size;
+  uint64_t fixup_count;
+  uint64_t checksum;
+};
+
+// 64-bit multiply-xorshift hash; stable across processes and builds, which
+// std::hash is not.
+class Hasher {
+public:
+  Hasher() : h_(0x9E3779B97F4A7C15ull) {}
+
+  void Update(const void *data, size_t size)
+  {
+    const uint8_t *p = static_cast<const uint8_t*>(data);
+    while (size >= sizeof(uint64_t)) {
+      uint64_t word;
+      memcpy(&word, p, sizeof(word));
+      Mix(word);
+      p += sizeof(word);
+      size -= sizeof(word);
+    }
+    uint64_t tail = 0;
+    memcpy(&tail, p, size);
+    Mix(tail ^ (uint64_t(size) << 56));
+  }
+
+  uint64_t Digest() const
+  {
+    uint64_t h = h_;
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    return h;
+  }
+
+private:
+  void Mix(uint64_t word)
+  {
+    h_ = (h_ ^ word) * 0x100000001B3ull;
+    h_ ^= h_ >> 29;
+  }
+
+  uint64_t h_;
+};
+
+uint64_t EntryChecksum(const std::string &isa, const PrelinkedSegment &segment)
+{
+  Hasher hasher;
+  hasher.Update(isa.data(), isa.size());
+  if (!segment.fixups.empty()) {
+    hasher.Update(segment.fixups.data(), segment.fixups.size() * sizeof(SegmentFixup));
+  }
+  if (!segment.image.empty()) {
+    hasher.Update(segment.image.data(), segment.image.size());
+  }
+  return hasher.Digest();
+}
+
+std::string ToHex(uint64_t value)
+{
+  static const char digits[] = "0123456789abcdef";
+  std::string hex(16, '0');
+  for (int i = 15; i >= 0; --i, value >>= 4) {
+    hex[i] = digits[value & 0xF];
+  }
+  return hex;
+}
+
+} // namespace anonymous
+
+void PrelinkedSegment::Rebase(uint64_t base, uint8_t *image) const
+{
+  for (const SegmentFixup &fixup : fixups) {
+    const uint64_t address = base + fixup.value;
+    switch (fixup.type) {
+      case R_AMDGPU_32_LOW: {
+        const uint32_t address32 = uint32_t(address & 0xFFFFFFFF);
+        memcpy(image + fixup.offset, &address32, sizeof(address32));
+        break;
+      }
+      case R_AMDGPU_32_HIGH: {
+        const uint32_t address32 = uint32_t((address >> 32) & 0xFFFFFFFF);
+        memcpy(image + fixup.offset, &address32, sizeof(address32));
+        break;
+      }
+      default:
+        memcpy(image + fixup.offset, &address, sizeof(address));
+        break;
+    }
+  }
+}
+
+std::string PrelinkedSegmentCache::Key(const void *elf_data, size_t elf_size, const std::string &isa)
+{
+  Hasher code_hasher;
+  code_hasher.Update(elf_data, elf_size);
+  Hasher isa_hasher;
+  isa_hasher.Update(isa.data(), isa.size());
+  return ToHex(uint64_t(elf_size)) + ToHex(code_hasher.Digest()) + ToHex(isa_hasher.Digest());
+}
+
+std::string PrelinkedSegmentCache::EntryPath(const std::string &key) const
+{
+  return dir_ + "/" + key + ".prelink";
+}
+
+bool PrelinkedSegmentCache::Load(const std::string &key, const void *elf_data, size_t elf_size,
+                                 const std::string &isa, uint64_t image_size, PrelinkedSegment *segment) const
+{
+  std::ifstream in(EntryPath(key), std::ios::binary);
+  if (!in) { return false; }
+
+  EntryHeader header;
+  if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) { return false; }
+  if (memcmp(header.magic, kEntryMagic, sizeof(kEntryMagic)) != 0 ||
+      header.version != kEntryVersion ||
+      header.isa_size != isa.size() ||
+      header.elf_size != elf_size ||
+      header.image_size != image_size) {
+    return false;
+  }
+
+  // Bound the fixup count by what the image can hold before allocating.
+  if (header.fixup_count > image_size / sizeof(uint32_t)) { return false; }
+
+  std::string entry_isa(header.isa_size, '\0');
+  if (header.isa_size != 0 && !in.read(&entry_isa[0], header.isa_size)) { return false; }
+  if (entry_isa != isa) { return false; }
+
+  // The key is only a 64-bit hash, so the entry must be for these exact bytes.
+  const char *elf = static_cast<const char*>(elf_data);
+  char chunk[4096];
+  for (uint64_t offset = 0; offset < elf_size; offset += sizeof(chunk)) {
+    const size_t size = size_t(std::min<uint64_t>(sizeof(chunk), elf_size - offset));
+    if (!in.read(chunk, size) || memcmp(chunk, elf + offset, size) != 0) { return false; }
+  }
+
+  segment->fixups.resize(header.fixup_count);
+  if (header.fixup_count != 0 &&
+      !in.read(reinterpret_cast<char*>(segment->fixups.data()), header.fixup_count * sizeof(SegmentFixup))) {
+    return false;
+  }
+  segment->image.resize(header.image_size);
+  if (header.image_size != 0 &&
+      !in.read(reinterpret_cast<char*>(segment->image.data()), header.image_size)) {
+    return false;
+  }
+
+  for (const SegmentFixup &fixup : segment->fixups) {
+    const uint64_t width = (fixup.type == R_AMDGPU_32_LOW || fixup.type == R_AMDGPU_32_HIGH) ? 4 : 8;
+    if (fixup.offset > image_size || image_size - fixup.offset < width) { return false; }
+  }
+
+  return EntryChecksum(isa, *segment) == header.checksum;
+}
+
+bool PrelinkedSegmentCache::Store(const std::string &key, const void *elf_data, size_t elf_size,
+                                  const std::string &isa, const PrelinkedSegment &segment) const
+{
+  EntryHeader header;
+  memcpy(header.magic, kEntryMagic, sizeof(kEntryMagic));
+  header.version = kEntryVersion;
+  header.isa_size = uint32_t(isa.size());
+  header.elf_size = elf_size;
+  header.image_size = segment.image.size();
+  header.fixup_count = segment.fixups.size();
+  header.checksum = EntryChecksum(isa, segment);
+
+  const std::string path = EntryPath(key);
+  const std::string temp_path = path + "." +
+    ToHex(std::hash<std::thread::id>()(std::this_thread::get_id()) ^
+          uint64_t(std::chrono::steady_clock::now().time_since_epoch().count())) + ".tmp";
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    if (!out) { return false; }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(isa.data(), isa.size());
+    out.write(static_cast<const char*>(elf_data), elf_size);
+    if (!segment.fixups.empty()) {
+      out.write(reinterpret_cast<const char*>(segment.fixups.data()), segment.fixups.size() * sizeof(SegmentFixup));
+    }
+    if (!segment.image.empty()) {
+      out.write(reinterpret_cast<const char*>(segment.image.data()), segment.image.size());
+    }
+    if (!out.flush()) {
+      out.close();
+      std::remove(temp_path.c_str());
+      return false;
+    }
+  }
+
+  if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+    // Another process may have stored the same entry first.
+    std::remove(temp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+} // namespace loader
+} // namespace hsa
+} // namespace amd
@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef HSA_RUNTIME_CORE_LOADER_SEGMENT_CACHE_HPP_
+#define HSA_RUNTIME_CORE_LOADER_SEGMENT_CACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace amd {
+namespace hsa {
+namespace loader {
+
+/// @brief One relocation applied to a load segment, recorded independently of
+/// where the segment was placed.
+struct SegmentFixup {
+  uint64_t offset;   // Byte offset within the load segment.
+  uint32_t type;     // R_AMDGPU_32_LOW, R_AMDGPU_32_HIGH, R_AMDGPU_64 or R_AMDGPU_RELATIVE64.
+  uint32_t reserved;
+  uint64_t value;    // Relocated address minus the segment base address.
+};
+
+/// @brief Load segment image with all relocations applied for base address 0.
+struct PrelinkedSegment {
+  std::vector<uint8_t> image;
+  std::vector<SegmentFixup> fixups;
+
+  /// @brief Rewrites every fixup in @p image (of image.size() bytes) for a
+  /// segment at @p base.
+  void Rebase(uint64_t base, uint8_t *image) const;
+};
+
+/// @brief On-disk cache of prelinked load segments.
+///
+/// Entries are keyed by the size and a 64-bit hash of the code object and a
+/// hash of its ISA. Each entry holds the ISA name, a copy of the code object,
+/// the segment image and the fixup list. A hit compares the stored code object
+/// with the one being loaded, so hash collisions cannot alias, and the rest of
+/// the entry is protected by a checksum. Only code objects whose relocations all resolve within
+/// their own load segment can be cached, so an entry is valid for any base.
+///
+/// Entries are written to a temporary file and renamed into place, so
+/// concurrent processes sharing a directory never read a partial entry.
+class PrelinkedSegmentCache {
+public:
+  explicit PrelinkedSegmentCache(const std::string &dir) : dir_(dir) {}
+
+  /// @returns Cache key for the code object in @p elf_data.
+  static std::string Key(const void *elf_data, size_t elf_size, const std::string &isa);
+
+  /// @brief Reads the entry for @p key into @p segment. Fails if there is no
+  /// entry, or if it is corrupt, for a different code object or ISA, or not
+  /// @p image_size bytes long.
+  bool Load(const std::string &key, const void *elf_data, size_t elf_size, const std::string &isa,
+            uint64_t image_size, PrelinkedSegment *segment) const;
+
+  /// @brief Writes the entry for @p key. Failures are not fatal to loading
+  /// and are only reported through the return value.
+  bool Store(const std::string &key, const void *elf_data, size_t elf_size, const std::string &isa,
+             const PrelinkedSegment &segment) const;
+
+private:
+  std::string EntryPath(const std::string &key) const;
+
+  const std::string dir_;
+};
+
+} // namespace loader
+} // namespace hsa
+} // namespace amd
+
+#endif // HSA_RUNTIME_CORE_LOADER_SEGMENT_CACHE_HPP_
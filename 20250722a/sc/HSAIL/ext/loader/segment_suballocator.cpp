@@ -0,0 +1,418 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "segment_suballocator.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace amd {
+namespace hsa {
+namespace loader {
+
+namespace {
+
+bool IsPowerOfTwo(size_t n)
+{
+  return n != 0 && (n & (n - 1)) == 0;
+}
+
+int Log2(size_t n)
+{
+  int log = 0;
+  while (n > 1) { n >>= 1; ++log; }
+  return log;
+}
+
+// Source of SegmentCopy() when zeroing a reused block.
+const size_t kZeroChunkSize = 4096;
+const char kZeroChunk[kZeroChunkSize] = {};
+
+} // namespace anonymous
+
+//===----------------------------------------------------------------------===//
+// SegmentSlabPool.                                                           //
+//===----------------------------------------------------------------------===//
+
+SegmentSlabPool::SegmentSlabPool(
+  Context *base, size_t slab_size, size_t max_idle_slabs, bool reuse_frozen_slabs)
+  : base_(base),
+    slab_size_(slab_size),
+    max_idle_slabs_(max_idle_slabs),
+    reuse_frozen_slabs_(reuse_frozen_slabs),
+    slabs_(0)
+{
+  assert(base_);
+  assert(IsPowerOfTwo(slab_size_));
+}
+
+SegmentSlabPool::~SegmentSlabPool()
+{
+  for (auto &idle : idle_) {
+    for (void *slab : idle.second) {
+      base_->SegmentFree(idle.first.first, hsa_agent_t{idle.first.second}, slab, slab_size_);
+      --slabs_;
+    }
+  }
+  assert(slabs_ == 0 && "slabs are still lent out");
+}
+
+void* SegmentSlabPool::Acquire(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<void*> &idle = idle_[PoolKey(segment, agent.handle)];
+    if (!idle.empty()) {
+      void *slab = idle.back();
+      idle.pop_back();
+      return slab;
+    }
+  }
+  void *slab = base_->SegmentAlloc(segment, agent, slab_size_, slab_size_, false);
+  if (slab) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++slabs_;
+  }
+  return slab;
+}
+
+void SegmentSlabPool::Release(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent, void *slab, bool frozen)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<void*> &idle = idle_[PoolKey(segment, agent.handle)];
+    if ((!frozen || reuse_frozen_slabs_) && idle.size() < max_idle_slabs_) {
+      idle.push_back(slab);
+      return;
+    }
+    --slabs_;
+  }
+  base_->SegmentFree(segment, agent, slab, slab_size_);
+}
+
+size_t SegmentSlabPool::SlabBytes()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return slabs_ * slab_size_;
+}
+
+//===----------------------------------------------------------------------===//
+// SuballocatingContext.                                                      //
+//===----------------------------------------------------------------------===//
+
+SuballocatingContext::SuballocatingContext(
+  std::shared_ptr<SegmentSlabPool> pool, size_t min_block_size)
+  : pool_(pool),
+    base_(pool->Base()),
+    slab_size_(pool->SlabSize()),
+    min_block_size_(min_block_size),
+    max_order_(Log2(pool->SlabSize() / min_block_size))
+{
+  assert(IsPowerOfTwo(min_block_size_));
+  assert(min_block_size_ <= slab_size_);
+}
+
+SuballocatingContext::~SuballocatingContext()
+{
+  for (auto &entry : slabs_) {
+    Slab *slab = entry.second.get();
+    assert(slab->allocated_blocks == 0 && "segments are still allocated");
+    pool_->Release(slab->segment, slab->agent, slab->ptr, slab->frozen);
+  }
+}
+
+hsa_isa_t SuballocatingContext::IsaFromName(const char *name)
+{
+  return base_->IsaFromName(name);
+}
+
+bool SuballocatingContext::IsaSupportedByAgent(hsa_agent_t agent, hsa_isa_t isa)
+{
+  return base_->IsaSupportedByAgent(agent, isa);
+}
+
+bool SuballocatingContext::IsaSupportedByAgent(hsa_agent_t agent, hsa_isa_t isa, unsigned genericVersion)
+{
+  return base_->IsaSupportedByAgent(agent, isa, genericVersion);
+}
+
+int SuballocatingContext::BlockOrder(size_t size, size_t align) const
+{
+  size_t block = std::max(std::max(size, align), min_block_size_);
+  if (block > slab_size_) { return -1; }
+  int order = 0;
+  while ((min_block_size_ << order) < block) { ++order; }
+  return order;
+}
+
+size_t SuballocatingContext::AllocateBlock(Slab *slab, int order)
+{
+  int k = order;
+  while (k <= max_order_ && slab->free_blocks[k].empty()) { ++k; }
+  if (k > max_order_) { return SIZE_MAX; }
+
+  // Lowest free block first, so that live segments pack towards the start of
+  // the slab and the top stays free for larger requests.
+  size_t offset = *slab->free_blocks[k].begin();
+  slab->free_blocks[k].erase(slab->free_blocks[k].begin());
+  while (k > order) {
+    --k;
+    slab->free_blocks[k].insert(offset + (min_block_size_ << k));
+  }
+  slab->allocated[offset / min_block_size_] = static_cast<int8_t>(order);
+  ++slab->allocated_blocks;
+  return offset;
+}
+
+void SuballocatingContext::FreeBlock(Slab *slab, size_t offset)
+{
+  const size_t index = offset / min_block_size_;
+  int8_t &allocated = slab->allocated[index];
+  assert(allocated >= 0);
+  int k = allocated;
+  allocated = -1;
+  --slab->allocated_blocks;
+  if (slab->block_frozen[index]) {
+    slab->block_frozen[index] = false;
+    --slab->frozen_blocks;
+  }
+
+  while (k < max_order_) {
+    size_t buddy = offset ^ (min_block_size_ << k);
+    auto it = slab->free_blocks[k].find(buddy);
+    if (it == slab->free_blocks[k].end()) { break; }
+    slab->free_blocks[k].erase(it);
+    offset = std::min(offset, buddy);
+    ++k;
+  }
+  slab->free_blocks[k].insert(offset);
+}
+
+bool SuballocatingContext::FreezeIfComplete(Slab *slab)
+{
+  if (slab->frozen || slab->allocated_blocks == 0 || slab->frozen_blocks != slab->allocated_blocks) {
+    return true;
+  }
+  slab->frozen = base_->SegmentFreeze(slab->segment, slab->agent, slab->ptr, slab_size_);
+  return slab->frozen;
+}
+
+SuballocatingContext::Slab* SuballocatingContext::FindSlab(const void *ptr)
+{
+  uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+  auto it = slabs_.upper_bound(address);
+  if (it == slabs_.begin()) { return nullptr; }
+  --it;
+  return address - it->first < slab_size_ ? it->second.get() : nullptr;
+}
+
+void* SuballocatingContext::Translate(void *seg, size_t *offset)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  Slab *slab = FindSlab(seg);
+  if (!slab) { return seg; }
+  *offset += static_cast<char*>(seg) - slab->ptr;
+  return slab->ptr;
+}
+
+void* SuballocatingContext::SegmentAlloc(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent, size_t size, size_t align, bool zero)
+{
+  int order = BlockOrder(size, align);
+  if (order < 0) {
+    return base_->SegmentAlloc(segment, agent, size, align, zero);
+  }
+
+  Slab *slab = nullptr;
+  size_t offset = SIZE_MAX;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &entry : slabs_) {
+      Slab *s = entry.second.get();
+      if (s->segment != segment || s->agent.handle != agent.handle || s->frozen) { continue; }
+      offset = AllocateBlock(s, order);
+      if (offset != SIZE_MAX) {
+        slab = s;
+        break;
+      }
+    }
+    if (!slab) {
+      void *ptr = pool_->Acquire(segment, agent);
+      if (!ptr) {
+        // The wrapped context may still be able to serve the segment itself.
+        return base_->SegmentAlloc(segment, agent, size, align, zero);
+      }
+      std::unique_ptr<Slab> s(new Slab());
+      s->segment = segment;
+      s->agent = agent;
+      s->ptr = static_cast<char*>(ptr);
+      s->free_blocks.resize(max_order_ + 1);
+      s->free_blocks[max_order_].insert(0);
+      s->allocated.assign(slab_size_ / min_block_size_, -1);
+      s->block_frozen.assign(slab_size_ / min_block_size_, false);
+      s->allocated_blocks = 0;
+      s->frozen_blocks = 0;
+      s->frozen = false;
+      slab = s.get();
+      slabs_[reinterpret_cast<uintptr_t>(ptr)] = std::move(s);
+      offset = AllocateBlock(slab, order);
+    }
+  }
+
+  if (zero) {
+    for (size_t done = 0; done < size; done += kZeroChunkSize) {
+      if (!base_->SegmentCopy(segment, agent, slab->ptr, offset + done, kZeroChunk,
+                              std::min(kZeroChunkSize, size - done))) {
+        SegmentFree(segment, agent, slab->ptr + offset, size);
+        return nullptr;
+      }
+    }
+  }
+  return slab->ptr + offset;
+}
+
+bool SuballocatingContext::SegmentCopy(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent, void* dst, size_t offset, const void* src, size_t size)
+{
+  void *ptr = Translate(dst, &offset);
+  return base_->SegmentCopy(segment, agent, ptr, offset, src, size);
+}
+
+void SuballocatingContext::SegmentFree(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent, void* seg, size_t size)
+{
+  std::unique_ptr<Slab> released;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Slab *slab = FindSlab(seg);
+    if (slab) {
+      FreeBlock(slab, static_cast<char*>(seg) - slab->ptr);
+      if (slab->allocated_blocks == 0) {
+        auto it = slabs_.find(reinterpret_cast<uintptr_t>(slab->ptr));
+        released = std::move(it->second);
+        slabs_.erase(it);
+      } else {
+        // The freed block may have been the last one holding up the freeze.
+        FreezeIfComplete(slab);
+        return;
+      }
+    }
+  }
+  if (released) {
+    pool_->Release(released->segment, released->agent, released->ptr, released->frozen);
+  } else {
+    base_->SegmentFree(segment, agent, seg, size);
+  }
+}
+
+void* SuballocatingContext::SegmentAddress(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent, void* seg, size_t offset)
+{
+  void *ptr = Translate(seg, &offset);
+  return base_->SegmentAddress(segment, agent, ptr, offset);
+}
+
+void* SuballocatingContext::SegmentHostAddress(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent, void* seg, size_t offset)
+{
+  void *ptr = Translate(seg, &offset);
+  return base_->SegmentHostAddress(segment, agent, ptr, offset);
+}
+
+bool SuballocatingContext::SegmentFreeze(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent, void* seg, size_t size)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Slab *slab = FindSlab(seg);
+    if (slab) {
+      const size_t index = (static_cast<char*>(seg) - slab->ptr) / min_block_size_;
+      assert(slab->allocated[index] >= 0);
+      if (!slab->block_frozen[index]) {
+        slab->block_frozen[index] = true;
+        ++slab->frozen_blocks;
+      }
+      return FreezeIfComplete(slab);
+    }
+  }
+  return base_->SegmentFreeze(segment, agent, seg, size);
+}
+
+bool SuballocatingContext::ImageExtensionSupported()
+{
+  return base_->ImageExtensionSupported();
+}
+
+hsa_status_t SuballocatingContext::ImageCreate(
+  hsa_agent_t agent,
+  hsa_access_permission_t image_permission,
+  const hsa_ext_image_descriptor_t *image_descriptor,
+  const void *image_data,
+  hsa_ext_image_t *image_handle)
+{
+  return base_->ImageCreate(agent, image_permission, image_descriptor, image_data, image_handle);
+}
+
+hsa_status_t SuballocatingContext::ImageDestroy(
+  hsa_agent_t agent, hsa_ext_image_t image_handle)
+{
+  return base_->ImageDestroy(agent, image_handle);
+}
+
+hsa_status_t SuballocatingContext::SamplerCreate(
+  hsa_agent_t agent,
+  const hsa_ext_sampler_descriptor_t *sampler_descriptor,
+  hsa_ext_sampler_t *sampler_handle)
+{
+  return base_->SamplerCreate(agent, sampler_descriptor, sampler_handle);
+}
+
+hsa_status_t SuballocatingContext::SamplerDestroy(
+  hsa_agent_t agent, hsa_ext_sampler_t sampler_handle)
+{
+  return base_->SamplerDestroy(agent, sampler_handle);
+}
+
+size_t SuballocatingContext::SlabBytes()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return slabs_.size() * slab_size_;
+}
+
+} // namespace loader
+} // namespace hsa
+} // namespace amd
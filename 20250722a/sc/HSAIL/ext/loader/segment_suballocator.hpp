@@ -0,0 +1,248 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef HSA_RUNTIME_CORE_LOADER_SEGMENT_SUBALLOCATOR_HPP_
+#define HSA_RUNTIME_CORE_LOADER_SEGMENT_SUBALLOCATOR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+#include "amd_hsa_loader.hpp"
+
+namespace amd {
+namespace hsa {
+namespace loader {
+
+/// @brief Slabs shared by the SuballocatingContexts of a loader.
+///
+/// Each slab is one SegmentAlloc() of the wrapped context, aligned to its own
+/// size. A slab is lent to one SuballocatingContext at a time and comes back
+/// when that context no longer has segments in it. Returned slabs are kept
+/// for reuse, up to @p max_idle_slabs per segment type and agent; the rest
+/// go back to the wrapped context.
+///
+/// Slabs that were frozen go back to the wrapped context unless
+/// @p reuse_frozen_slabs is set, which requires a wrapped context that
+/// accepts SegmentCopy() to memory it froze before.
+class SegmentSlabPool final {
+public:
+  static const size_t kDefaultSlabSize = 2 * 1024 * 1024;
+
+  /// @p slab_size must be a power of two.
+  explicit SegmentSlabPool(
+    Context *base,
+    size_t slab_size = kDefaultSlabSize,
+    size_t max_idle_slabs = 1,
+    bool reuse_frozen_slabs = false);
+
+  /// @brief Returns the idle slabs to the wrapped context. Lent slabs must
+  /// have been returned.
+  ~SegmentSlabPool();
+
+  Context* Base() const { return base_; }
+  size_t SlabSize() const { return slab_size_; }
+
+  /// @returns An idle or new slab, or nullptr if the wrapped context has no
+  /// memory for one.
+  void* Acquire(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent);
+
+  /// @brief Takes back a slab that holds no segments. @p frozen tells
+  /// whether the wrapped context froze it.
+  void Release(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent, void *slab, bool frozen);
+
+  /// @returns Bytes currently held in slabs, whether lent or idle.
+  size_t SlabBytes();
+
+private:
+  SegmentSlabPool(const SegmentSlabPool&);
+  SegmentSlabPool& operator=(const SegmentSlabPool&);
+
+  typedef std::pair<amdgpu_hsa_elf_segment_t, uint64_t> PoolKey;
+
+  Context *base_;
+  const size_t slab_size_;
+  const size_t max_idle_slabs_;
+  const bool reuse_frozen_slabs_;
+
+  std::mutex mutex_;
+  std::map<PoolKey, std::vector<void*>> idle_;
+  size_t slabs_;
+};
+
+/// @brief Context decorator that carves one executable's segments out of
+/// slabs borrowed from a SegmentSlabPool.
+///
+/// Each slab is split into power-of-two blocks the way a buddy allocator
+/// does: a request is rounded up to the smallest block that covers both its
+/// size and its alignment, larger free blocks are halved until one fits, and
+/// a freed block is merged with its buddy whenever that is free too. Free
+/// blocks are kept in one list per block size. A slab that no longer holds
+/// segments goes back to the pool, so a workload that keeps creating and
+/// destroying executables with similar code objects reuses the same slabs.
+/// Segments larger than a slab are passed straight through.
+///
+/// Every other call is forwarded. Pointers into a slab are forwarded as the
+/// slab pointer plus an offset, so the wrapped context only ever sees the
+/// allocations it made.
+///
+/// Slabs are never shared between contexts, so SegmentFreeze() cannot
+/// affect another executable. The wrapped context can only freeze whole
+/// slabs: a slab is frozen once every segment in it has been frozen, and
+/// takes no new segments after that.
+class SuballocatingContext final : public Context {
+public:
+  static const size_t kDefaultMinBlockSize = 256;
+
+  /// @p min_block_size must be a power of two no larger than the pool's
+  /// slab size.
+  explicit SuballocatingContext(
+    std::shared_ptr<SegmentSlabPool> pool,
+    size_t min_block_size = kDefaultMinBlockSize);
+
+  /// @brief Returns all slabs to the pool.
+  ~SuballocatingContext();
+
+  hsa_isa_t IsaFromName(const char *name) override;
+
+  bool IsaSupportedByAgent(hsa_agent_t agent, hsa_isa_t isa) override;
+
+  bool IsaSupportedByAgent(hsa_agent_t agent, hsa_isa_t isa, unsigned genericVersion) override;
+
+  void* SegmentAlloc(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent, size_t size, size_t align, bool zero) override;
+
+  bool SegmentCopy(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent, void* dst, size_t offset, const void* src, size_t size) override;
+
+  void SegmentFree(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent, void* seg, size_t size = 0) override;
+
+  void* SegmentAddress(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent, void* seg, size_t offset) override;
+
+  void* SegmentHostAddress(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent, void* seg, size_t offset) override;
+
+  bool SegmentFreeze(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent, void* seg, size_t size) override;
+
+  bool ImageExtensionSupported() override;
+
+  hsa_status_t ImageCreate(
+    hsa_agent_t agent,
+    hsa_access_permission_t image_permission,
+    const hsa_ext_image_descriptor_t *image_descriptor,
+    const void *image_data,
+    hsa_ext_image_t *image_handle) override;
+
+  hsa_status_t ImageDestroy(
+    hsa_agent_t agent, hsa_ext_image_t image_handle) override;
+
+  hsa_status_t SamplerCreate(
+    hsa_agent_t agent,
+    const hsa_ext_sampler_descriptor_t *sampler_descriptor,
+    hsa_ext_sampler_t *sampler_handle) override;
+
+  hsa_status_t SamplerDestroy(
+    hsa_agent_t agent, hsa_ext_sampler_t sampler_handle) override;
+
+  /// @returns Bytes in slabs borrowed by this context.
+  size_t SlabBytes();
+
+private:
+  SuballocatingContext(const SuballocatingContext&);
+  SuballocatingContext& operator=(const SuballocatingContext&);
+
+  struct Slab {
+    amdgpu_hsa_elf_segment_t segment;
+    hsa_agent_t agent;
+    char *ptr;
+    // free_blocks[k] holds the offsets of free blocks of min_block_size << k.
+    std::vector<std::set<size_t>> free_blocks;
+    // Order of the block allocated at each min_block_size offset, or -1.
+    std::vector<int8_t> allocated;
+    // Whether the block at each min_block_size offset was frozen.
+    std::vector<bool> block_frozen;
+    size_t allocated_blocks;
+    size_t frozen_blocks;
+    // Set once the wrapped context froze the slab.
+    bool frozen;
+  };
+
+  /// @returns Order of the smallest block holding @p size bytes at
+  /// @p align, or -1 if that is larger than a slab.
+  int BlockOrder(size_t size, size_t align) const;
+
+  /// @returns Offset of a new block of order @p order in @p slab, or
+  /// SIZE_MAX if there is no free block large enough. Requires mutex_.
+  size_t AllocateBlock(Slab *slab, int order);
+
+  /// @brief Frees the block at @p offset and merges it with free buddies.
+  /// Requires mutex_.
+  void FreeBlock(Slab *slab, size_t offset);
+
+  /// @brief Freezes @p slab if every block in it was frozen. Requires
+  /// mutex_.
+  bool FreezeIfComplete(Slab *slab);
+
+  /// @returns The slab containing @p ptr, or nullptr. Requires mutex_.
+  Slab* FindSlab(const void *ptr);
+
+  /// @returns @p seg, or if it is in a slab the slab pointer with the offset
+  /// of @p seg added to @p offset.
+  void* Translate(void *seg, size_t *offset);
+
+  std::shared_ptr<SegmentSlabPool> pool_;
+  Context *base_;
+  const size_t slab_size_;
+  const size_t min_block_size_;
+  const int max_order_;
+
+  std::mutex mutex_;
+  // Slabs by start address.
+  std::map<uintptr_t, std::unique_ptr<Slab>> slabs_;
+};
+
+} // namespace loader
+} // namespace hsa
+} // namespace amd
+
+#endif // HSA_RUNTIME_CORE_LOADER_SEGMENT_SUBALLOCATOR_HPP_
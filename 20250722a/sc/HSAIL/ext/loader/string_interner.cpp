@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "string_interner.hpp"
+
+#include <cassert>
+
+namespace amd {
+namespace hsa {
+namespace loader {
+
+namespace {
+
+const size_t kInitialSlots = 64;
+
+} // namespace anonymous
+
+StringInterner::StringInterner()
+  : count_(0)
+{
+  Slot empty = { 0, nullptr, 0 };
+  slots_.assign(kInitialSlots, empty);
+}
+
+StringInterner::~StringInterner()
+{
+}
+
+uint64_t StringInterner::Hash(const char *data, size_t size)
+{
+  // Word-at-a-time multiply-xorshift; mangled names are long enough that a
+  // byte-at-a-time hash shows up in profiles.
+  uint64_t h = 0x9E3779B97F4A7C15ull ^ (uint64_t(size) * 0xC2B2AE3D27D4EB4Full);
+  while (size >= sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, data, sizeof(word));
+    h = (h ^ word) * 0x9FB21C651E98DF25ull;
+    h ^= h >> 32;
+    data += sizeof(word);
+    size -= sizeof(word);
+  }
+  uint64_t tail = 0;
+  memcpy(&tail, data, size);
+  h ^= tail;
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDull;
+  h ^= h >> 33;
+  return h;
+}
+
+size_t StringInterner::Probe(uint64_t hash, const char *data, size_t size) const
+{
+  const size_t mask = slots_.size() - 1;
+  for (size_t i = size_t(hash) & mask; ; i = (i + 1) & mask) {
+    const Slot &slot = slots_[i];
+    if (!slot.data ||
+        (slot.hash == hash && slot.size == size && memcmp(slot.data, data, size) == 0)) {
+      return i;
+    }
+  }
+}
+
+void StringInterner::Grow()
+{
+  std::vector<Slot> old;
+  old.swap(slots_);
+  Slot empty = { 0, nullptr, 0 };
+  slots_.assign(old.size() * 2, empty);
+  const size_t mask = slots_.size() - 1;
+  for (const Slot &slot : old) {
+    if (!slot.data) { continue; }
+    size_t i = size_t(slot.hash) & mask;
+    while (slots_[i].data) { i = (i + 1) & mask; }
+    slots_[i] = slot;
+  }
+}
+
+InternedString StringInterner::Intern(const char *data, size_t size)
+{
+  assert(data || !size);
+  assert(size <= UINT32_MAX);
+  const uint64_t hash = Hash(data, size);
+  size_t i = Probe(hash, data, size);
+  if (slots_[i].data) {
+    return InternedString(slots_[i].data, slots_[i].size);
+  }
+
+  // Keep the load factor at or below one half.
+  if ((count_ + 1) * 2 > slots_.size()) {
+    Grow();
+    i = Probe(hash, data, size);
+  }
+
+  char *stored = static_cast<char*>(arena_.Allocate(size + 1, 1));
+  if (!stored) { return InternedString(); }
+  memcpy(stored, data, size);
+  stored[size] = '\0';
+  Slot slot = { hash, stored, uint32_t(size) };
+  slots_[i] = slot;
+  ++count_;
+  return InternedString(stored, uint32_t(size));
+}
+
+InternedString StringInterner::Find(const char *data, size_t size) const
+{
+  assert(data || !size);
+  const Slot &slot = slots_[Probe(Hash(data, size), data, size)];
+  return slot.data ? InternedString(slot.data, slot.size) : InternedString();
+}
+
+size_t StringInterner::ResidentBytes() const
+{
+  return slots_.capacity() * sizeof(Slot) + arena_.ResidentBytes();
+}
+
+} // namespace loader
+} // namespace hsa
+} // namespace amd
@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef HSA_RUNTIME_CORE_LOADER_STRING_INTERNER_HPP_
+#define HSA_RUNTIME_CORE_LOADER_STRING_INTERNER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "object_arena.hpp"
+
+namespace amd {
+namespace hsa {
+namespace loader {
+
+class StringInterner;
+
+/// @brief Handle to a string owned by a StringInterner.
+///
+/// Handles from the same interner are equal if and only if their strings are
+/// equal, so they compare and hash by address. A default-constructed handle
+/// is null and refers to no string. The characters stay valid, and
+/// nul-terminated, until the interner is destroyed.
+class InternedString {
+public:
+  InternedString() : data_(nullptr), size_(0) {}
+
+  bool IsNull() const { return data_ == nullptr; }
+  const char *c_str() const { return data_ ? data_ : ""; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  std::string str() const { return std::string(c_str(), size_); }
+
+  bool operator==(const InternedString &other) const { return data_ == other.data_; }
+  bool operator!=(const InternedString &other) const { return data_ != other.data_; }
+
+private:
+  friend class StringInterner;
+  friend struct InternedStringHash;
+
+  InternedString(const char *data, uint32_t size) : data_(data), size_(size) {}
+
+  const char *data_;
+  uint32_t size_;
+};
+
+struct InternedStringHash {
+  size_t operator()(const InternedString &s) const {
+    // Arena addresses are at least byte aligned and mostly distinct in the
+    // upper bits; fold them so unordered_map buckets are spread evenly.
+    uint64_t h = reinterpret_cast<uintptr_t>(s.data_);
+    h ^= h >> 29;
+    h *= 0xBF58476D1CE4E5B9ull;
+    return size_t(h ^ (h >> 32));
+  }
+};
+
+/// @brief Owns one copy of each distinct string it is given.
+///
+/// Strings are packed into an ObjectArena and indexed by an
+/// open-addressing hash table, so interning a string already present costs
+/// one hash and no allocation, and Find() never allocates. All memory is
+/// released when the interner is destroyed.
+///
+/// Not thread safe: Intern() needs exclusive access, Find() may run
+/// concurrently with other Find() calls.
+class StringInterner final {
+public:
+  StringInterner();
+  ~StringInterner();
+
+  /// @returns Handle for @p size bytes at @p data, adding them if needed.
+  InternedString Intern(const char *data, size_t size);
+  InternedString Intern(const std::string &s) { return Intern(s.data(), s.size()); }
+
+  /// @returns Handle for the string, or a null handle if it was never interned.
+  InternedString Find(const char *data, size_t size) const;
+  InternedString Find(const char *s) const { return Find(s, strlen(s)); }
+  InternedString Find(const std::string &s) const { return Find(s.data(), s.size()); }
+
+  /// @returns Number of distinct strings.
+  size_t Count() const { return count_; }
+
+  /// @returns Bytes held in the arena and the index.
+  size_t ResidentBytes() const;
+
+private:
+  StringInterner(const StringInterner&);
+  StringInterner& operator=(const StringInterner&);
+
+  struct Slot {
+    uint64_t hash;
+    const char *data;  // Null for an empty slot.
+    uint32_t size;
+  };
+
+  static uint64_t Hash(const char *data, size_t size);
+
+  // Returns the slot holding the string, or the empty slot where it belongs.
+  size_t Probe(uint64_t hash, const char *data, size_t size) const;
+  void Grow();
+
+  std::vector<Slot> slots_;
+  size_t count_;
+
+  ObjectArena arena_;
+};
+
+} // namespace loader
+} // namespace hsa
+} // namespace amd
+
+#endif // HSA_RUNTIME_CORE_LOADER_STRING_INTERNER_HPP_
@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+// Replaces the global operator new and delete of a benchmark to count calls
+// and live bytes. Include it from exactly one source file of the program.
+
+#ifndef HSA_RUNTIME_CORE_LOADER_TEST_ALLOC_COUNTER_HPP_
+#define HSA_RUNTIME_CORE_LOADER_TEST_ALLOC_COUNTER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace amd {
+namespace hsa {
+namespace loader {
+namespace test {
+
+static std::atomic<uint64_t> allocations(0);
+static std::atomic<int64_t> live_bytes(0);
+
+// Each block is preceded by its size so operator delete can account for it.
+static const size_t kAllocHeader = alignof(std::max_align_t);
+
+} // namespace test
+} // namespace loader
+} // namespace hsa
+} // namespace amd
+
+void* operator new(size_t size)
+{
+  using namespace amd::hsa::loader::test;
+  char *p = static_cast<char*>(malloc(size + kAllocHeader));
+  if (p == nullptr) { throw std::bad_alloc(); }
+  memcpy(p, &size, sizeof(size));
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  live_bytes.fetch_add(int64_t(size), std::memory_order_relaxed);
+  return p + kAllocHeader;
+}
+
+void operator delete(void *ptr) noexcept
+{
+  using namespace amd::hsa::loader::test;
+  if (ptr == nullptr) { return; }
+  char *p = static_cast<char*>(ptr) - kAllocHeader;
+  size_t size;
+  memcpy(&size, p, sizeof(size));
+  live_bytes.fetch_sub(int64_t(size), std::memory_order_relaxed);
+  free(p);
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete[](void *ptr) noexcept { operator delete(ptr); }
+void operator delete(void *ptr, size_t) noexcept { operator delete(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { operator delete(ptr); }
+
+#endif // HSA_RUNTIME_CORE_LOADER_TEST_ALLOC_COUNTER_HPP_
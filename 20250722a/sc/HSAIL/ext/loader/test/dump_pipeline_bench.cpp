@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+
+// Dump cost on the loading thread: loads code objects with -dump-all, once
+// with -dump-sync and once through the background pipeline, and reports the
+// load time and the time until DumpPipeline::Flush() returns, next to a load
+// without dumps. Then times AmdHsaCode::Print() against PrintParallel() with
+// a thread per part, for several part counts.
+//
+// Usage: dump_pipeline_bench [reps] [dump directory]
+
+#include "loader_test.hpp"
+#include "dump_pipeline.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+using namespace amd::hsa::loader;
+using namespace amd::hsa::loader::test;
+using amd::hsa::code::AmdHsaCode;
+
+namespace {
+
+const unsigned kLoads = 10;
+const size_t kMaxParts[] = { 2, 4, 8 };
+
+struct Object {
+  const char *name;
+  std::vector<char> elf;
+};
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  QuietStdout();
+  const int reps = argc > 1 ? atoi(argv[1]) : 5;
+  const std::string dir = argc > 2 ? argv[2] : ".";
+  const hsa_agent_t agent = { 1 };
+
+  std::vector<Object> objects;
+  objects.push_back(Object{ "v1 100x512", BuildHsaTextCodeObject(100, 512, 1) });
+  objects.push_back(Object{ "v4 500", BuildCodeObject(500, 1) });
+
+  printf("%u loads per run, best of %d\n", kLoads, reps);
+  printf("%12s %10s %12s %12s\n", "object", "dumps", "load us", "flushed us");
+  for (const Object &object : objects) {
+    const hsa_code_object_t handle = { uint64_t(object.elf.data()) };
+    const std::string dump_options = "-dump-all -dump-dir=" + dir;
+    const std::string sync_options = dump_options + " -dump-sync";
+    const std::pair<const char*, std::string> modes[] = {
+      { "none", "" }, { "sync", sync_options }, { "pipeline", dump_options }
+    };
+    for (const auto &mode : modes) {
+      double best_load_us = 1e30, best_flushed_us = 1e30;
+      for (int rep = 0; rep < reps; ++rep) {
+        TestLoaderContext context;
+        Loader *loader = Loader::Create(&context);
+        std::vector<Executable*> executables;
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned i = 0; i < kLoads; ++i) {
+          Executable *executable = loader->CreateExecutable(HSA_PROFILE_FULL, nullptr);
+          if (executable->LoadCodeObject(agent, handle, object.elf.size(), mode.second.c_str(), nullptr) !=
+              HSA_STATUS_SUCCESS) {
+            fprintf(stderr, "dump_pipeline_bench: load failed\n");
+            return 1;
+          }
+          executables.push_back(executable);
+        }
+        best_load_us = std::min(best_load_us, ElapsedUs(start));
+        DumpPipeline::Flush();
+        best_flushed_us = std::min(best_flushed_us, ElapsedUs(start));
+
+        for (Executable *executable : executables) {
+          loader->DestroyExecutable(executable);
+        }
+        Loader::Destroy(loader);
+      }
+      printf("%12s %10s %12.1f %12.1f\n", object.name, mode.first, best_load_us, best_flushed_us);
+    }
+  }
+
+  printf("\n%12s %10s %12s %10s\n", "object", "parts", "print us", "speedup");
+  for (const Object &object : objects) {
+    AmdHsaCode code;
+    if (!code.InitAsBuffer(object.elf.data(), object.elf.size())) {
+      fprintf(stderr, "dump_pipeline_bench: invalid code object\n");
+      return 1;
+    }
+    double serial_us = 1e30;
+    for (int rep = 0; rep < reps; ++rep) {
+      std::ostringstream out;
+      const auto start = std::chrono::steady_clock::now();
+      code.Print(out);
+      serial_us = std::min(serial_us, ElapsedUs(start));
+    }
+    printf("%12s %10s %12.1f %10s\n", object.name, "Print", serial_us, "");
+    for (size_t max_parts : kMaxParts) {
+      double parallel_us = 1e30;
+      for (int rep = 0; rep < reps; ++rep) {
+        ThreadPrintRunner runner;
+        std::ostringstream out;
+        const auto start = std::chrono::steady_clock::now();
+        code.PrintParallel(out, runner, max_parts);
+        parallel_us = std::min(parallel_us, ElapsedUs(start));
+      }
+      printf("%12s %10zu %12.1f %9.2fx\n", object.name, max_parts, parallel_us, serial_us / parallel_us);
+    }
+  }
+  return 0;
+}
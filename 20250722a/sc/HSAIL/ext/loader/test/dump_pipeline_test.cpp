@@ -0,0 +1,165 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+
+// Checks that dumps written by the background pipeline match -dump-sync, and
+// that AmdHsaCode::PrintParallel() prints the same listing as
+// AmdHsaCode::Print() and PrintToFile() for any number of parts, on code
+// objects v1 (.hsatext) and v4 (.text).
+//
+// Usage: dump_pipeline_test <dump directory>
+
+#include "loader_test.hpp"
+#include "dump_pipeline.hpp"
+#include "amd_hsa_code_util.hpp"
+
+#include <fstream>
+#include <sstream>
+
+using namespace amd::hsa::loader;
+using namespace amd::hsa::loader::test;
+using amd::hsa::code::AmdHsaCode;
+using amd::hsa::code::PrintTaskRunner;
+
+namespace {
+
+const size_t kMaxParts[] = { 1, 2, 3, 4, 8, 64 };
+
+/// @brief Runs every part on the calling thread, in order.
+class SerialRunner : public PrintTaskRunner {
+public:
+  void Spawn(std::function<void()> task) override { task(); }
+  void Wait() override {}
+};
+
+std::string ReadFile(const std::string &filename)
+{
+  std::ifstream in(filename, std::ios::binary);
+  std::ostringstream text;
+  text << in.rdbuf();
+  return text.str();
+}
+
+void TestPrintParallel(const std::string &dir, const std::vector<char> &code_object)
+{
+  AmdHsaCode code;
+  LOADER_CHECK(code.InitAsBuffer(code_object.data(), code_object.size()));
+  LOADER_CHECK(code.HasHsaText());
+
+  std::ostringstream expected;
+  code.Print(expected);
+  const std::string filename = dir + "/print_to_file.isa";
+  code.PrintToFile(filename);
+  LOADER_CHECK(ReadFile(filename) == expected.str());
+
+  for (size_t max_parts : kMaxParts) {
+    SerialRunner serial;
+    std::ostringstream serial_out;
+    code.PrintParallel(serial_out, serial, max_parts);
+    LOADER_CHECK(serial_out.str() == expected.str());
+
+    ThreadPrintRunner threads;
+    std::ostringstream threads_out;
+    code.PrintParallel(threads_out, threads, max_parts);
+    LOADER_CHECK(threads_out.str() == expected.str());
+  }
+}
+
+/// Loads each object once with -dump-sync and once through the pipeline,
+/// then compares the files after DumpPipeline::Flush().
+void TestDumpsMatch(const std::string &dir, const std::vector<std::vector<char>> &code_objects)
+{
+  TestLoaderContext context;
+  std::unique_ptr<Loader> loader(Loader::Create(&context));
+  const std::string sync_options = "-dump-all -dump-sync -dump-dir=" + dir;
+  const std::string async_options = "-dump-all -dump-dir=" + dir;
+
+  // Every LoadCodeObject() takes the next dump number, starting at 1.
+  unsigned code_num = 0;
+  for (const std::vector<char> &code_object : code_objects) {
+    Executable *sync = LoadExecutable(loader.get(), code_object, sync_options.c_str());
+    const unsigned sync_num = ++code_num;
+    Executable *async = LoadExecutable(loader.get(), code_object, async_options.c_str());
+    const unsigned async_num = ++code_num;
+    LOADER_CHECK(sync != nullptr && async != nullptr);
+    DumpPipeline::Flush();
+
+    for (const char *ext : { "hsaco", "isa", "exec" }) {
+      const std::string sync_text = ReadFile(amd::hsa::DumpFileName(dir, "amdcode", ext, sync_num));
+      const std::string async_text = ReadFile(amd::hsa::DumpFileName(dir, "amdcode", ext, async_num));
+      LOADER_CHECK(!sync_text.empty());
+      // The executable listings hold load addresses, which differ.
+      if (strcmp(ext, "exec") != 0) {
+        LOADER_CHECK(async_text == sync_text);
+      } else {
+        LOADER_CHECK(!async_text.empty());
+      }
+    }
+    LOADER_CHECK(ReadFile(amd::hsa::DumpFileName(dir, "amdcode", "hsaco", async_num)) ==
+                 std::string(code_object.begin(), code_object.end()));
+
+    loader->DestroyExecutable(sync);
+    loader->DestroyExecutable(async);
+  }
+}
+
+} // namespace anonymous
+
+int main(int argc, char **argv)
+{
+  QuietStdout();
+  const std::string dir = argc > 1 ? argv[1] : ".";
+  const std::vector<std::vector<char>> code_objects = {
+    BuildHsaTextCodeObject(1, 64, 1),
+    BuildHsaTextCodeObject(7, 200, 2),
+    BuildHsaTextCodeObject(100, 512, 3),
+    BuildCodeObject(16, 4),
+  };
+  for (const std::vector<char> &code_object : code_objects) {
+    TestPrintParallel(dir, code_object);
+  }
+  TestDumpsMatch(dir, code_objects);
+  if (failures != 0) {
+    fprintf(stderr, "dump_pipeline_test: %d checks failed\n", failures);
+    return 1;
+  }
+  printf("dump_pipeline_test: passed\n");
+  return 0;
+}
@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+// Load/destroy churn: each cycle creates an executable, loads and freezes a
+// code object, and destroys the executable. Reports operator new calls and
+// wall time per cycle.
+//
+// Usage: executable_churn_bench [cycles]
+
+#include "loader_test.hpp"
+#include "alloc_counter.hpp"
+
+using namespace amd::hsa::loader;
+using namespace amd::hsa::loader::test;
+
+int main(int argc, char **argv)
+{
+  QuietStdout();
+  const int cycles = argc > 1 ? atoi(argv[1]) : 50;
+
+  printf("%8s %16s %12s %12s\n", "kernels", "allocs/cycle", "load us", "destroy us");
+  for (unsigned kernels : { 10u, 500u, 5000u }) {
+    const std::vector<char> code_object = BuildCodeObject(kernels, kernels);
+    TestLoaderContext context;
+    Loader *loader = Loader::Create(&context);
+
+    double load_us = 0, destroy_us = 0;
+    const uint64_t allocations_before = allocations.load();
+    for (int i = 0; i < cycles; ++i) {
+      auto start = std::chrono::steady_clock::now();
+      Executable *executable = LoadExecutable(loader, code_object);
+      load_us += ElapsedUs(start);
+      if (executable == nullptr) {
+        fprintf(stderr, "executable_churn_bench: load failed\n");
+        return 1;
+      }
+      start = std::chrono::steady_clock::now();
+      loader->DestroyExecutable(executable);
+      destroy_us += ElapsedUs(start);
+    }
+    const uint64_t cycle_allocations = (allocations.load() - allocations_before) / cycles;
+    Loader::Destroy(loader);
+
+    printf("%8u %16llu %12.1f %12.1f\n", kernels, (unsigned long long)cycle_allocations,
+           load_us / cycles, destroy_us / cycles);
+  }
+  return 0;
+}
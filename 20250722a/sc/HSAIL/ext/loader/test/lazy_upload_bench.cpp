@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+
+// Lazy upload with many kernels and few used: 500 kernels are loaded, as one
+// code object or as 100 objects of 5, and 5 of them are queried. Reports the
+// load and freeze time, the time of the 5 symbol queries, and the
+// SegmentCopy calls and bytes that reached the agent, with and without
+// -lazy-upload.
+//
+// Usage: lazy_upload_bench [reps] [copy us]
+//
+// Segments live in host memory. Pass a cost in microseconds per SegmentCopy
+// call to model copies to agent memory.
+
+#include "loader_test.hpp"
+
+#include <algorithm>
+
+using namespace amd::hsa::loader;
+using namespace amd::hsa::loader::test;
+
+namespace {
+
+const unsigned kKernels = 500;
+const unsigned kUsed[] = { 0, 123, 250, 377, 499 };
+
+class BenchLoaderContext : public TestLoaderContext {
+public:
+  explicit BenchLoaderContext(double copy_us) : bytes(0), copy_us_(copy_us) {}
+
+  bool SegmentCopy(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent, void *dst, size_t offset, const void *src,
+                   size_t size) override
+  {
+    const auto start = std::chrono::steady_clock::now();
+    bytes += size;
+    const bool result = TestLoaderContext::SegmentCopy(segment, agent, dst, offset, src, size);
+    while (ElapsedUs(start) < copy_us_) {}
+    return result;
+  }
+
+  size_t bytes;
+
+private:
+  const double copy_us_;
+};
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  QuietStdout();
+  const int reps = argc > 1 ? atoi(argv[1]) : 5;
+  const double copy_us = argc > 2 ? atof(argv[2]) : 0;
+  const hsa_agent_t agent = { 1 };
+
+  printf("SegmentCopy cost: %.1f us, %u kernels loaded, %zu queried\n", copy_us, kKernels,
+         sizeof(kUsed) / sizeof(kUsed[0]));
+  printf("%8s %8s %8s %12s %12s %10s %10s\n", "objects", "kernels", "mode", "load us", "query us", "copies",
+         "KB copied");
+  for (unsigned per_object : { kKernels, 5u }) {
+    const unsigned objects = kKernels / per_object;
+    std::vector<std::vector<char>> code_objects;
+    for (unsigned o = 0; o < objects; ++o) {
+      code_objects.push_back(BuildCodeObject(per_object, o, "o" + std::to_string(o) + "k"));
+    }
+    for (const char *options : { "", "-lazy-upload" }) {
+      double best_load_us = 1e30, best_query_us = 1e30;
+      size_t copies = 0, bytes = 0;
+      for (int rep = 0; rep < reps; ++rep) {
+        BenchLoaderContext context(copy_us);
+        Loader *loader = Loader::Create(&context);
+        auto start = std::chrono::steady_clock::now();
+        Executable *executable = loader->CreateExecutable(HSA_PROFILE_FULL, nullptr);
+        for (const std::vector<char> &code_object : code_objects) {
+          const hsa_code_object_t handle = { uint64_t(code_object.data()) };
+          if (executable->LoadCodeObject(agent, handle, code_object.size(), options, nullptr) != HSA_STATUS_SUCCESS) {
+            fprintf(stderr, "lazy_upload_bench: load failed\n");
+            return 1;
+          }
+        }
+        if (executable->Freeze(nullptr) != HSA_STATUS_SUCCESS) {
+          fprintf(stderr, "lazy_upload_bench: freeze failed\n");
+          return 1;
+        }
+        best_load_us = std::min(best_load_us, ElapsedUs(start));
+
+        start = std::chrono::steady_clock::now();
+        for (unsigned used : kUsed) {
+          const std::string name =
+            "o" + std::to_string(used / per_object) + "k" + std::to_string(used % per_object) + ".kd";
+          if (executable->GetSymbol(name.c_str(), &agent) == nullptr) {
+            fprintf(stderr, "lazy_upload_bench: %s not found\n", name.c_str());
+            return 1;
+          }
+        }
+        best_query_us = std::min(best_query_us, ElapsedUs(start));
+        copies = context.copies;
+        bytes = context.bytes;
+
+        loader->DestroyExecutable(executable);
+        Loader::Destroy(loader);
+      }
+      printf("%8u %8u %8s %12.1f %12.1f %10zu %10.1f\n", objects, per_object, *options ? "lazy" : "eager",
+             best_load_us, best_query_us, copies, bytes / 1024.0);
+    }
+  }
+  return 0;
+}
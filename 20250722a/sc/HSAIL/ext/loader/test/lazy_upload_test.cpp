@@ -0,0 +1,299 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+
+// Checks -lazy-upload: segments stay zero on the agent until a symbol query
+// (or the freeze, with -upload-at-freeze) uploads them with a single copy,
+// and the final images match an eager load, including prelinked segment
+// cache hits in either direction and relocations against another code
+// object of the executable.
+//
+// Usage: lazy_upload_test <cache directory>
+
+#include "loader_test.hpp"
+#include "segment_cache.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <thread>
+
+using namespace amd::hsa::loader;
+using namespace amd::hsa::loader::test;
+
+namespace {
+
+const char kIsa[] = "amdgcn-amd-amdhsa--gfx900";
+const hsa_agent_t kAgent = { 1 };
+const char *const kModes[] = { "", "-lazy-upload", "-lazy-upload -upload-at-freeze" };
+
+std::string EntryPath(const std::string &dir, const std::vector<char> &code_object)
+{
+  return dir + "/" + PrelinkedSegmentCache::Key(code_object.data(), code_object.size(), kIsa) + ".prelink";
+}
+
+std::vector<Segment*> Segments(Executable *executable)
+{
+  std::vector<Segment*> segments;
+  executable->IterateLoadedCodeObjects(
+    [](hsa_executable_t, hsa_loaded_code_object_t object, void *data) -> hsa_status_t {
+      return LoadedCodeObject::Object(object)->IterateLoadedSegments(
+        [](amd_loaded_segment_t handle, void *data) -> hsa_status_t {
+          static_cast<std::vector<Segment*>*>(data)->push_back(static_cast<Segment*>(LoadedSegment::Object(handle)));
+          return HSA_STATUS_SUCCESS;
+        }, data);
+    }, &segments);
+  return segments;
+}
+
+bool AllZero(const Segment *segment)
+{
+  const uint8_t *bytes = static_cast<const uint8_t*>(segment->Ptr());
+  return std::all_of(bytes, bytes + segment->Size(), [](uint8_t b) { return b == 0; });
+}
+
+/// Uploads every segment and returns its contents with each 64-bit word that
+/// points into any segment of the executable rewritten as (segment index + 1)
+/// << 48 | offset, so cross-object pointers compare equal across loads.
+std::vector<std::vector<uint8_t>> ExecutableImages(Executable *executable)
+{
+  const std::vector<Segment*> segments = Segments(executable);
+  std::vector<std::vector<uint8_t>> images;
+  for (Segment *segment : segments) {
+    LOADER_CHECK(segment->Upload());
+    const uint8_t *base = static_cast<const uint8_t*>(segment->Ptr());
+    images.push_back(std::vector<uint8_t>(base, base + segment->Size()));
+  }
+  for (std::vector<uint8_t> &image : images) {
+    for (size_t i = 0; i + sizeof(uint64_t) <= image.size(); i += sizeof(uint64_t)) {
+      uint64_t word;
+      memcpy(&word, &image[i], sizeof(word));
+      for (size_t s = 0; s < segments.size(); ++s) {
+        const uint64_t base = uint64_t(segments[s]->Ptr());
+        if (word >= base && word < base + segments[s]->Size()) {
+          word = (uint64_t(s + 1) << 48) | (word - base);
+          memcpy(&image[i], &word, sizeof(word));
+          break;
+        }
+      }
+    }
+  }
+  return images;
+}
+
+uint64_t KernelObject(Executable *executable, const char *name)
+{
+  uint64_t object = 0;
+  Symbol *symbol = executable->GetSymbol(name, &kAgent);
+  LOADER_CHECK(symbol != nullptr);
+  if (symbol != nullptr) {
+    LOADER_CHECK(symbol->GetInfo(HSA_EXECUTABLE_SYMBOL_INFO_KERNEL_OBJECT, &object));
+  }
+  return object;
+}
+
+/// Loads each of @p code_objects with @p options into one executable and
+/// freezes it. Returns nullptr on failure.
+Executable* LoadAll(Loader *loader, const std::vector<const std::vector<char>*> &code_objects,
+                    const std::string &options)
+{
+  Executable *executable = loader->CreateExecutable(HSA_PROFILE_FULL, nullptr);
+  if (executable == nullptr) { return nullptr; }
+  for (const std::vector<char> *code_object : code_objects) {
+    const hsa_code_object_t handle = { uint64_t(code_object->data()) };
+    if (executable->LoadCodeObject(kAgent, handle, code_object->size(), options.c_str(), nullptr) !=
+        HSA_STATUS_SUCCESS) {
+      loader->DestroyExecutable(executable);
+      return nullptr;
+    }
+  }
+  if (executable->Freeze(nullptr) != HSA_STATUS_SUCCESS) {
+    loader->DestroyExecutable(executable);
+    return nullptr;
+  }
+  return executable;
+}
+
+void TestDeferral()
+{
+  const std::vector<char> code_object = BuildCodeObject(8, 21);
+  TestLoaderContext context;
+  Loader *loader = Loader::Create(&context);
+  Executable *eager = LoadExecutable(loader, code_object);
+  LOADER_CHECK(eager != nullptr);
+  if (eager == nullptr) { Loader::Destroy(loader); return; }
+  const std::vector<std::vector<uint8_t>> reference = ExecutableImages(eager);
+
+  for (bool at_freeze : { false, true }) {
+    Executable *executable = loader->CreateExecutable(HSA_PROFILE_FULL, nullptr);
+    const hsa_code_object_t handle = { uint64_t(code_object.data()) };
+    context.copies = 0;
+    LOADER_CHECK(executable->LoadCodeObject(kAgent, handle, code_object.size(),
+                                            at_freeze ? kModes[2] : kModes[1], nullptr) == HSA_STATUS_SUCCESS);
+    const std::vector<Segment*> segments = Segments(executable);
+    LOADER_CHECK(segments.size() == 1);
+    if (segments.size() != 1) { loader->DestroyExecutable(executable); continue; }
+    Segment *segment = segments[0];
+
+    // Relocations went to the staging copy; nothing reached the agent.
+    LOADER_CHECK(segment->IsUploadDeferred());
+    LOADER_CHECK(context.copies == 0);
+    LOADER_CHECK(AllZero(segment));
+
+    LOADER_CHECK(executable->Freeze(nullptr) == HSA_STATUS_SUCCESS);
+    if (at_freeze) {
+      LOADER_CHECK(!segment->IsUploadDeferred());
+      LOADER_CHECK(context.copies == 1);
+    } else {
+      LOADER_CHECK(segment->IsUploadDeferred());
+      LOADER_CHECK(context.copies == 0 && AllZero(segment));
+
+      // Racing first queries upload once.
+      std::vector<std::thread> threads;
+      std::vector<uint64_t> objects(4, 0);
+      for (size_t t = 0; t < objects.size(); ++t) {
+        threads.emplace_back([&, t]() {
+          Symbol *symbol = executable->GetSymbol(("k" + std::to_string(t) + ".kd").c_str(), &kAgent);
+          if (symbol != nullptr) { symbol->GetInfo(HSA_EXECUTABLE_SYMBOL_INFO_KERNEL_OBJECT, &objects[t]); }
+        });
+      }
+      for (std::thread &thread : threads) { thread.join(); }
+      for (uint64_t object : objects) { LOADER_CHECK(object != 0); }
+      LOADER_CHECK(!segment->IsUploadDeferred());
+      LOADER_CHECK(context.copies == 1);
+      LOADER_CHECK(KernelObject(executable, "k7.kd") != 0);
+      LOADER_CHECK(context.copies == 1);
+    }
+    LOADER_CHECK(!AllZero(segment));
+    LOADER_CHECK(ExecutableImages(executable) == reference);
+    loader->DestroyExecutable(executable);
+  }
+
+  loader->DestroyExecutable(eager);
+  Loader::Destroy(loader);
+}
+
+void TestImagesMatch(const std::string &dir)
+{
+  // b imports two kernel descriptors of a, so loading b relocates against a.
+  const std::vector<char> a = BuildCodeObject(6, 31, "a");
+  const std::vector<char> b = BuildCodeObject(4, 32, "b", { "a1.kd", "a5.kd" });
+  const std::vector<const std::vector<char>*> objects = { &a, &b };
+  const std::string cache_option = " -prelink-cache-dir=" + dir;
+
+  TestLoaderContext context;
+  Loader *loader = Loader::Create(&context);
+  context.copies = 0;
+  Executable *eager = LoadAll(loader, objects, "");
+  const size_t uncached_copies = context.copies;
+  LOADER_CHECK(eager != nullptr);
+  if (eager == nullptr) { Loader::Destroy(loader); return; }
+
+  // b holds the addresses of a's descriptors.
+  std::vector<Segment*> segments = Segments(eager);
+  LOADER_CHECK(segments.size() == 2);
+  for (const char *name : { "a1.kd", "a5.kd" }) {
+    const uint64_t address = KernelObject(eager, name);
+    const uint8_t *image = static_cast<const uint8_t*>(segments[1]->Ptr());
+    size_t found = 0;
+    for (size_t i = 0; i + sizeof(uint64_t) <= segments[1]->Size(); i += sizeof(uint64_t)) {
+      uint64_t word;
+      memcpy(&word, image + i, sizeof(word));
+      found += word == address;
+    }
+    LOADER_CHECK(address != 0 && found == 1);
+  }
+  const std::vector<std::vector<uint8_t>> reference = ExecutableImages(eager);
+
+  for (const char *mode : kModes) {
+    Executable *executable = LoadAll(loader, objects, mode);
+    LOADER_CHECK(executable != nullptr);
+    if (executable == nullptr) { continue; }
+    LOADER_CHECK(ExecutableImages(executable) == reference);
+    loader->DestroyExecutable(executable);
+  }
+
+  // An entry stored by a load in one mode is hit by a load in any mode. Only
+  // a is cacheable; b's relocations leave its segment.
+  for (const char *store_mode : kModes) {
+    for (const char *hit_mode : kModes) {
+      std::remove(EntryPath(dir, a).c_str());
+      Executable *cold = LoadAll(loader, objects, store_mode + cache_option);
+      LOADER_CHECK(cold != nullptr);
+      LOADER_CHECK(std::ifstream(EntryPath(dir, a)).good());
+      LOADER_CHECK(!std::ifstream(EntryPath(dir, b)).good());
+
+      context.copies = 0;
+      Executable *warm = LoadAll(loader, objects, hit_mode + cache_option);
+      const size_t warm_copies = context.copies;
+      LOADER_CHECK(warm != nullptr);
+      if (cold != nullptr && warm != nullptr) {
+        LOADER_CHECK(ExecutableImages(cold) == reference);
+        LOADER_CHECK(ExecutableImages(warm) == reference);
+        // An eager hit writes a with one copy instead of one per relocation.
+        if (*hit_mode == '\0') {
+          LOADER_CHECK(warm_copies < uncached_copies);
+        }
+      }
+      for (Executable *executable : { cold, warm }) {
+        if (executable != nullptr) { loader->DestroyExecutable(executable); }
+      }
+    }
+  }
+  std::remove(EntryPath(dir, a).c_str());
+
+  loader->DestroyExecutable(eager);
+  Loader::Destroy(loader);
+}
+
+} // namespace anonymous
+
+int main(int argc, char **argv)
+{
+  QuietStdout();
+  const std::string dir = argc > 1 ? argv[1] : ".";
+  TestDeferral();
+  TestImagesMatch(dir);
+  if (failures != 0) {
+    fprintf(stderr, "lazy_upload_test: %d checks failed\n", failures);
+    return 1;
+  }
+  printf("lazy_upload_test: passed\n");
+  return 0;
+}
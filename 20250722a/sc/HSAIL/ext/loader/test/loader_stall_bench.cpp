@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+
+// Loader stalls under segment queries: one thread loads, freezes and
+// destroys executables while reader threads poll QuerySegmentDescriptors
+// (count then fill) as a profiler or debugger would. Reports the writer's
+// cycle latency percentiles and the readers' query rate, so readers that
+// block loads, or loads that block readers, show up as tail latency.
+//
+// Usage: loader_stall_bench [ms per row] [executables kept loaded]
+
+#include "loader_test.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+using namespace amd::hsa::loader;
+using namespace amd::hsa::loader::test;
+
+int main(int argc, char **argv)
+{
+  QuietStdout();
+  const int row_ms = argc > 1 ? atoi(argv[1]) : 1000;
+  const unsigned resident = argc > 2 ? unsigned(atoi(argv[2])) : 32;
+
+  printf("%u hardware threads, %u executables kept loaded\n", std::thread::hardware_concurrency(), resident);
+  printf("%8s %8s %10s %10s %10s %12s\n", "readers", "cycles", "p50 us", "p99 us", "max us", "queries/s");
+  for (unsigned readers : { 0u, 1u, 2u, 4u, 8u }) {
+    LockingLoaderContext context;
+    Loader *loader = Loader::Create(&context);
+
+    // Resident executables make each snapshot, and each query, bigger.
+    std::vector<std::vector<char>> resident_objects;
+    std::vector<Executable*> executables;
+    for (unsigned i = 0; i < resident; ++i) {
+      resident_objects.push_back(BuildCodeObject(4, i, "r" + std::to_string(i) + "k"));
+      executables.push_back(LoadExecutable(loader, resident_objects.back()));
+    }
+    const std::vector<char> code_object = BuildCodeObject(16, 1000);
+
+    std::atomic<bool> stop(false);
+    std::atomic<uint64_t> queries(0);
+    std::vector<std::thread> threads;
+    for (unsigned r = 0; r < readers; ++r) {
+      threads.emplace_back([&]() {
+        std::vector<hsa_ven_amd_loader_segment_descriptor_t> descriptors;
+        uint64_t local = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+          size_t count = 0;
+          loader->QuerySegmentDescriptors(nullptr, &count);
+          descriptors.resize(count);
+          if (count != 0) {
+            loader->QuerySegmentDescriptors(descriptors.data(), &count);
+          }
+          ++local;
+        }
+        queries.fetch_add(local);
+      });
+    }
+
+    std::vector<double> cycle_us;
+    const auto start = std::chrono::steady_clock::now();
+    while (ElapsedUs(start) < row_ms * 1000.0) {
+      const auto cycle_start = std::chrono::steady_clock::now();
+      Executable *executable = LoadExecutable(loader, code_object);
+      if (executable == nullptr) {
+        fprintf(stderr, "loader_stall_bench: load failed\n");
+        return 1;
+      }
+      loader->DestroyExecutable(executable);
+      cycle_us.push_back(ElapsedUs(cycle_start));
+    }
+    const double seconds = ElapsedUs(start) / 1e6;
+    stop.store(true);
+    for (std::thread &thread : threads) { thread.join(); }
+
+    std::sort(cycle_us.begin(), cycle_us.end());
+    printf("%8u %8zu %10.1f %10.1f %10.1f %12.0f\n", readers, cycle_us.size(), cycle_us[cycle_us.size() / 2],
+           cycle_us[cycle_us.size() * 99 / 100], cycle_us.back(), queries.load() / seconds);
+
+    for (Executable *executable : executables) {
+      if (executable) { loader->DestroyExecutable(executable); }
+    }
+    Loader::Destroy(loader);
+  }
+  return 0;
+}
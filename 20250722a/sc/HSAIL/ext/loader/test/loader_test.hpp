@@ -0,0 +1,381 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+// Helpers shared by the loader tests and benchmarks: in-memory code object
+// builders, an offline loader context and a snapshot of loaded segments.
+
+#ifndef HSA_RUNTIME_CORE_LOADER_TEST_LOADER_TEST_HPP_
+#define HSA_RUNTIME_CORE_LOADER_TEST_LOADER_TEST_HPP_
+
+#include "executable.hpp"
+#include "loaders.hpp"
+#include "amd_hsa_kernel_code.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace amd {
+namespace hsa {
+namespace loader {
+namespace test {
+
+static int failures = 0;
+
+#define LOADER_CHECK(cond)                                                      \
+  do {                                                                          \
+    if (!(cond)) {                                                              \
+      fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);  \
+      ++amd::hsa::loader::test::failures;                                       \
+    }                                                                           \
+  } while (false)
+
+inline double ElapsedUs(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// @brief Builds a gfx900 code object v4 with @p kernels kernels named
+/// <prefix><i>, filled with pseudo-random code from @p seed.
+///
+/// Each kernel has 256 bytes of code in .text and a kernel descriptor
+/// <prefix><i>.kd in .rodata. .data holds, per kernel, an R_AMDGPU_64
+/// relocation against the descriptor and an R_AMDGPU_RELATIVE64 relocation
+/// to the code, so every load applies 2 * @p kernels relocations.
+/// Each name in @p imports becomes an undefined symbol with an R_AMDGPU_64
+/// relocation in .data, to be resolved against another code object.
+inline std::vector<char> BuildCodeObject(unsigned kernels, uint32_t seed, const std::string &prefix = "k",
+                                         const std::vector<std::string> &imports = std::vector<std::string>())
+{
+  struct Ehdr {
+    uint8_t ident[16];
+    uint16_t type, machine;
+    uint32_t version;
+    uint64_t entry, phoff, shoff;
+    uint32_t flags;
+    uint16_t ehsize, phentsize, phnum, shentsize, shnum, shstrndx;
+  };
+  struct Phdr { uint32_t type, flags; uint64_t offset, vaddr, paddr, filesz, memsz, align; };
+  struct Shdr { uint32_t name, type; uint64_t flags, addr, offset, size; uint32_t link, info; uint64_t addralign, entsize; };
+  struct Sym { uint32_t name; uint8_t info, other; uint16_t shndx; uint64_t value, size; };
+  struct Rela { uint64_t offset, info; int64_t addend; };
+
+  enum { kText = 1, kRodata, kData, kRelaDyn, kDynsym, kDynstr, kSymtab, kStrtab, kShstrtab, kSectionCount };
+  const uint64_t kPage = 0x1000, kCodeSize = 256, kDescriptorSize = 64, kDataSize = 16;
+  auto align = [](uint64_t v, uint64_t a) { return (v + a - 1) & ~(a - 1); };
+
+  std::mt19937 random(seed);
+  const uint64_t text = 0;
+  const uint64_t rodata = align(text + kernels * kCodeSize, kPage);
+  const uint64_t data = align(rodata + kernels * kDescriptorSize, kPage);
+
+  std::vector<uint8_t> code(kernels * kCodeSize);
+  for (uint8_t &b : code) { b = uint8_t(random()); }
+  std::vector<uint8_t> descriptors(kernels * kDescriptorSize);
+  for (unsigned i = 0; i < kernels; ++i) {
+    uint8_t *kd = &descriptors[i * kDescriptorSize];
+    const uint32_t group_segment_size = random() % 1024;
+    const uint32_t kernarg_size = (random() % 256) * 8;
+    const int64_t entry = int64_t(text + i * kCodeSize) - int64_t(rodata + i * kDescriptorSize);
+    memcpy(kd + 0, &group_segment_size, sizeof(group_segment_size));
+    memcpy(kd + 8, &kernarg_size, sizeof(kernarg_size));
+    memcpy(kd + 16, &entry, sizeof(entry));
+  }
+
+  std::string dynstr(1, '\0'), strtab(1, '\0');
+  std::vector<Sym> dynsym(1), symtab(1);
+  std::vector<Rela> relocs;
+  for (unsigned i = 0; i < kernels; ++i) {
+    const std::string name = prefix + std::to_string(i);
+    Sym kd = { 0, (STB_GLOBAL << 4) | STT_OBJECT, 0, kRodata, rodata + i * kDescriptorSize, kDescriptorSize };
+    kd.name = uint32_t(dynstr.size());
+    dynstr += name + ".kd" + '\0';
+    dynsym.push_back(kd);
+    kd.name = uint32_t(strtab.size());
+    strtab += name + ".kd" + '\0';
+    symtab.push_back(kd);
+    Sym fn = { uint32_t(strtab.size()), (STB_GLOBAL << 4) | STT_FUNC, 0, kText, text + i * kCodeSize, kCodeSize };
+    strtab += name + '\0';
+    symtab.push_back(fn);
+
+    relocs.push_back({ data + i * kDataSize, (uint64_t(i + 1) << 32) | R_AMDGPU_64, 0 });
+    relocs.push_back({ data + i * kDataSize + 8, R_AMDGPU_RELATIVE64, int64_t(text + i * kCodeSize) });
+  }
+  for (size_t i = 0; i < imports.size(); ++i) {
+    const Sym undefined = { uint32_t(dynstr.size()), (STB_GLOBAL << 4) | STT_NOTYPE, 0, 0, 0, 0 };
+    dynstr += imports[i] + '\0';
+    dynsym.push_back(undefined);
+    relocs.push_back({ data + kernels * kDataSize + i * 8, (uint64_t(dynsym.size() - 1) << 32) | R_AMDGPU_64, 0 });
+  }
+
+  static const char *const names[kSectionCount] = {
+    "", ".text", ".rodata", ".data", ".rela.dyn", ".dynsym", ".dynstr", ".symtab", ".strtab", ".shstrtab"
+  };
+  std::string shstrtab;
+  uint32_t name_offsets[kSectionCount];
+  for (int i = 0; i < kSectionCount; ++i) {
+    name_offsets[i] = uint32_t(shstrtab.size());
+    shstrtab += std::string(names[i]) + '\0';
+  }
+
+  // Loaded sections sit at file offset kPage + vaddr; the rest follow.
+  std::vector<char> elf;
+  std::vector<Shdr> shdrs(kSectionCount);
+  auto append = [&](int index, uint32_t type, uint64_t flags, uint64_t addr, const void *bytes, size_t size,
+                    uint64_t addralign, uint64_t entsize, uint32_t link, uint32_t info) {
+    const uint64_t offset = flags & SHF_ALLOC && index <= kData ? kPage + addr : align(elf.size(), addralign);
+    elf.resize(offset, 0);
+    elf.insert(elf.end(), static_cast<const char*>(bytes), static_cast<const char*>(bytes) + size);
+    shdrs[index] = { name_offsets[index], type, flags, addr, offset, size, link, info, addralign, entsize };
+  };
+  elf.resize(kPage, 0);
+  append(kText, SHT_PROGBITS, SHF_ALLOC | SHF_EXECINSTR, text, code.data(), code.size(), kPage, 0, 0, 0);
+  append(kRodata, SHT_PROGBITS, SHF_ALLOC, rodata, descriptors.data(), descriptors.size(), kPage, 0, 0, 0);
+  const std::vector<uint8_t> zeros(kernels * kDataSize + imports.size() * 8);
+  append(kData, SHT_PROGBITS, SHF_ALLOC | SHF_WRITE, data, zeros.data(), zeros.size(), kPage, 0, 0, 0);
+  append(kRelaDyn, SHT_RELA, SHF_ALLOC, 0, relocs.data(), relocs.size() * sizeof(Rela), 8, sizeof(Rela), kDynsym, 0);
+  append(kDynsym, SHT_DYNSYM, SHF_ALLOC, 0, dynsym.data(), dynsym.size() * sizeof(Sym), 8, sizeof(Sym), kDynstr, 1);
+  append(kDynstr, SHT_STRTAB, SHF_ALLOC, 0, dynstr.data(), dynstr.size(), 1, 0, 0, 0);
+  append(kSymtab, SHT_SYMTAB, 0, 0, symtab.data(), symtab.size() * sizeof(Sym), 8, sizeof(Sym), kStrtab, 1);
+  append(kStrtab, SHT_STRTAB, 0, 0, strtab.data(), strtab.size(), 1, 0, 0, 0);
+  append(kShstrtab, SHT_STRTAB, 0, 0, shstrtab.data(), shstrtab.size(), 1, 0, 0, 0);
+  const uint64_t shoff = align(elf.size(), 8);
+  elf.resize(shoff, 0);
+  elf.insert(elf.end(), reinterpret_cast<const char*>(shdrs.data()),
+             reinterpret_cast<const char*>(shdrs.data() + shdrs.size()));
+
+  Ehdr ehdr = {};
+  const uint8_t ident[] = { 0x7f, 'E', 'L', 'F', ELFCLASS64, ELFDATA2LSB, EV_CURRENT,
+                            ELF::ELFOSABI_AMDGPU_HSA, ELF::ELFABIVERSION_AMDGPU_HSA_V4 };
+  memcpy(ehdr.ident, ident, sizeof(ident));
+  ehdr.type = ET_DYN;
+  ehdr.machine = ELF::EM_AMDGPU;
+  ehdr.version = EV_CURRENT;
+  ehdr.phoff = sizeof(Ehdr);
+  ehdr.shoff = shoff;
+  ehdr.flags = ELF::EF_AMDGPU_MACH_AMDGCN_GFX900 | ELF::EF_AMDGPU_FEATURE_XNACK_ANY_V4;
+  ehdr.ehsize = sizeof(Ehdr);
+  ehdr.phentsize = sizeof(Phdr);
+  ehdr.phnum = 3;
+  ehdr.shentsize = sizeof(Shdr);
+  ehdr.shnum = kSectionCount;
+  ehdr.shstrndx = kShstrtab;
+  memcpy(elf.data(), &ehdr, sizeof(ehdr));
+
+  const uint32_t phdr_flags[3] = { PF_R | PF_X, PF_R, PF_R | PF_W };
+  for (int i = 0; i < 3; ++i) {
+    const Shdr &s = shdrs[kText + i];
+    const Phdr phdr = { PT_LOAD, phdr_flags[i], s.offset, s.addr, s.addr, s.size, s.size, kPage };
+    memcpy(elf.data() + sizeof(Ehdr) + i * sizeof(Phdr), &phdr, sizeof(phdr));
+  }
+  return elf;
+}
+
+/// @brief Builds a code object v1 with @p kernels kernels in .hsatext, each an
+/// amd_kernel_code_t followed by @p isa_size bytes of pseudo-random code.
+inline std::vector<char> BuildHsaTextCodeObject(unsigned kernels, size_t isa_size, uint32_t seed)
+{
+  std::mt19937 random(seed);
+  code::AmdHsaCode code;
+  code.InitNew();
+  code.AddNoteCodeObjectVersion(1, 0);
+  code.AddNoteIsa("AMD", "AMDGPU", 8, 0, 3);
+  code.InitHsaSegment(AMDGPU_HSA_SEGMENT_CODE_AGENT, false);
+  code.AddCodeSection(code.HsaSegment(AMDGPU_HSA_SEGMENT_CODE_AGENT, false));
+  for (unsigned i = 0; i < kernels; ++i) {
+    std::vector<uint8_t> blob(sizeof(amd_kernel_code_t) + isa_size);
+    for (uint8_t &b : blob) { b = uint8_t(random()); }
+    amd_kernel_code_t akc;
+    memset(&akc, 0, sizeof(akc));
+    akc.amd_kernel_code_version_major = 1;
+    akc.kernel_code_entry_byte_offset = sizeof(amd_kernel_code_t);
+    akc.kernarg_segment_byte_size = (random() % 256) * 8;
+    akc.workgroup_group_segment_byte_size = random() % 1024;
+    akc.kernarg_segment_alignment = 4;
+    memcpy(blob.data(), &akc, sizeof(akc));
+    code::Symbol *sym =
+      code.AddExecutableSymbol("&k" + std::to_string(i), STT_AMDGPU_HSA_KERNEL, STB_GLOBAL, 0, nullptr);
+    code.AddKernelCode(sym->AsKernelSymbol(), blob.data(), blob.size());
+  }
+  code.AddHsaSegments();
+  code.Freeze();
+  std::vector<char> elf(code.ElfSize());
+  code.WriteToBuffer(elf.data());
+  return elf;
+}
+
+/// @brief Runs each part of AmdHsaCode::PrintParallel() on its own thread.
+class ThreadPrintRunner : public code::PrintTaskRunner {
+public:
+  void Spawn(std::function<void()> task) override { threads_.emplace_back(task); }
+  void Wait() override
+  {
+    for (std::thread &t : threads_) { t.join(); }
+    threads_.clear();
+  }
+
+private:
+  std::vector<std::thread> threads_;
+};
+
+/// @brief Offline context that keeps segments in host memory without
+/// logging, and counts segment copies.
+class TestLoaderContext : public OfflineLoaderContext {
+public:
+  TestLoaderContext() : copies(0) {}
+
+  bool SegmentCopy(amdgpu_hsa_elf_segment_t, hsa_agent_t, void *dst, size_t offset, const void *src,
+                   size_t size) override
+  {
+    ++copies;
+    memcpy(static_cast<char*>(dst) + offset, src, size);
+    return true;
+  }
+
+  void* SegmentAddress(amdgpu_hsa_elf_segment_t, hsa_agent_t, void *seg, size_t offset) override
+  {
+    return static_cast<char*>(seg) + offset;
+  }
+
+  void* SegmentHostAddress(amdgpu_hsa_elf_segment_t, hsa_agent_t, void *seg, size_t offset) override
+  {
+    return static_cast<char*>(seg) + offset;
+  }
+
+  bool SegmentFreeze(amdgpu_hsa_elf_segment_t, hsa_agent_t, void*, size_t) override { return true; }
+
+  size_t copies;
+};
+
+/// @brief TestLoaderContext that can be shared by threads loading into
+/// different executables.
+class LockingLoaderContext : public TestLoaderContext {
+public:
+  void* SegmentAlloc(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent, size_t size, size_t align,
+                     bool zero) override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return TestLoaderContext::SegmentAlloc(segment, agent, size, align, zero);
+  }
+
+  bool SegmentCopy(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent, void *dst, size_t offset, const void *src,
+                   size_t size) override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return TestLoaderContext::SegmentCopy(segment, agent, dst, offset, src, size);
+  }
+
+  void SegmentFree(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent, void *seg, size_t size) override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    TestLoaderContext::SegmentFree(segment, agent, seg, size);
+  }
+
+private:
+  std::mutex mutex_;
+};
+
+/// @brief Loaded segment contents with every 64-bit word that points into the
+/// segment rewritten relative to its base, so loads at different addresses
+/// compare equal.
+inline std::vector<std::vector<uint8_t>> SegmentImages(Executable *executable)
+{
+  std::vector<std::vector<uint8_t>> images;
+  executable->IterateLoadedCodeObjects(
+    [](hsa_executable_t, hsa_loaded_code_object_t object, void *data) -> hsa_status_t {
+      return LoadedCodeObject::Object(object)->IterateLoadedSegments(
+        [](amd_loaded_segment_t handle, void *data) -> hsa_status_t {
+          Segment *segment = static_cast<Segment*>(LoadedSegment::Object(handle));
+          segment->Upload();
+          const uint8_t *base = static_cast<const uint8_t*>(segment->Ptr());
+          std::vector<uint8_t> image(base, base + segment->Size());
+          for (size_t i = 0; i + sizeof(uint64_t) <= image.size(); i += sizeof(uint64_t)) {
+            uint64_t word;
+            memcpy(&word, &image[i], sizeof(word));
+            if (word >= uint64_t(base) && word < uint64_t(base) + image.size()) {
+              word -= uint64_t(base);
+              memcpy(&image[i], &word, sizeof(word));
+            }
+          }
+          static_cast<std::vector<std::vector<uint8_t>>*>(data)->push_back(image);
+          return HSA_STATUS_SUCCESS;
+        }, data);
+    }, &images);
+  return images;
+}
+
+/// @brief Loads @p code_object with @p options into a new executable of
+/// @p loader created with @p executable_options. Returns nullptr on failure.
+inline Executable* LoadExecutable(Loader *loader, const std::vector<char> &code_object, const char *options = "",
+                                  const char *executable_options = nullptr)
+{
+  Executable *executable = loader->CreateExecutable(HSA_PROFILE_FULL, executable_options);
+  if (executable == nullptr) { return nullptr; }
+  const hsa_agent_t agent = { 1 };
+  const hsa_code_object_t handle = { uint64_t(code_object.data()) };
+  if (executable->LoadCodeObject(agent, handle, code_object.size(), options, nullptr) != HSA_STATUS_SUCCESS ||
+      executable->Freeze(nullptr) != HSA_STATUS_SUCCESS) {
+    loader->DestroyExecutable(executable);
+    return nullptr;
+  }
+  return executable;
+}
+
+/// @brief Silences the offline context's logging to std::cout.
+inline void QuietStdout()
+{
+  std::cout.setstate(std::ios::failbit);
+}
+
+} // namespace test
+} // namespace loader
+} // namespace hsa
+} // namespace amd
+
+#endif // HSA_RUNTIME_CORE_LOADER_TEST_LOADER_TEST_HPP_
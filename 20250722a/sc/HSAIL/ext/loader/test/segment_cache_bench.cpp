@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+// Times code object loads without the prelinked segment cache, with a cold
+// cache (miss and store) and with a warm cache (hit).
+//
+// Usage: segment_cache_bench <cache directory> [repetitions] [copy us]
+//
+// Segments live in host memory, so a SegmentCopy is a memcpy. Pass a cost in
+// microseconds per SegmentCopy to model copies to agent memory.
+
+#include "loader_test.hpp"
+#include "segment_cache.hpp"
+
+#include <algorithm>
+
+using namespace amd::hsa::loader;
+using namespace amd::hsa::loader::test;
+
+namespace {
+
+class BenchLoaderContext : public TestLoaderContext {
+public:
+  explicit BenchLoaderContext(double copy_us) : copy_us_(copy_us) {}
+
+  bool SegmentCopy(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent, void *dst, size_t offset, const void *src,
+                   size_t size) override
+  {
+    const auto start = std::chrono::steady_clock::now();
+    TestLoaderContext::SegmentCopy(segment, agent, dst, offset, src, size);
+    while (ElapsedUs(start) < copy_us_) {}
+    return true;
+  }
+
+private:
+  const double copy_us_;
+};
+
+// Best time in microseconds of loading and freezing @p code_object.
+double TimeLoad(Loader *loader, const std::vector<char> &code_object, const std::string &options,
+                const std::string &entry_path, bool cold, int repetitions)
+{
+  double best = 1e30;
+  for (int i = 0; i < repetitions; ++i) {
+    if (cold) { std::remove(entry_path.c_str()); }
+    const auto start = std::chrono::steady_clock::now();
+    Executable *executable = LoadExecutable(loader, code_object, options.c_str());
+    best = std::min(best, ElapsedUs(start));
+    if (executable == nullptr) { return -1; }
+    loader->DestroyExecutable(executable);
+  }
+  return best;
+}
+
+} // namespace anonymous
+
+int main(int argc, char **argv)
+{
+  QuietStdout();
+  const std::string dir = argc > 1 ? argv[1] : ".";
+  const int repetitions = argc > 2 ? atoi(argv[2]) : 20;
+  const double copy_us = argc > 3 ? atof(argv[3]) : 0;
+  const std::string options = "-prelink-cache-dir=" + dir;
+
+  printf("SegmentCopy cost: %.1f us\n", copy_us);
+  printf("%8s %10s %14s %14s %14s\n", "kernels", "relocs", "uncached us", "cold us", "warm us");
+  for (unsigned kernels : { 16u, 256u, 4096u }) {
+    const std::vector<char> code_object = BuildCodeObject(kernels, kernels);
+    const std::string entry_path =
+      dir + "/" + PrelinkedSegmentCache::Key(code_object.data(), code_object.size(),
+                                             "amdgcn-amd-amdhsa--gfx900") + ".prelink";
+    BenchLoaderContext context(copy_us);
+    Loader *loader = Loader::Create(&context);
+    const double uncached = TimeLoad(loader, code_object, "", entry_path, false, repetitions);
+    const double cold = TimeLoad(loader, code_object, options, entry_path, true, repetitions);
+    const double warm = TimeLoad(loader, code_object, options, entry_path, false, repetitions);
+    Loader::Destroy(loader);
+    std::remove(entry_path.c_str());
+    if (uncached < 0 || cold < 0 || warm < 0) {
+      fprintf(stderr, "segment_cache_bench: load failed\n");
+      return 1;
+    }
+    printf("%8u %10u %14.1f %14.1f %14.1f\n", kernels, kernels * 2, uncached, cold, warm);
+  }
+  return 0;
+}
@@ -0,0 +1,208 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+// Checks that segments loaded through the prelinked segment cache match an
+// uncached load, and that entries are never used for another code object.
+//
+// Usage: segment_cache_test <cache directory>
+
+#include "loader_test.hpp"
+#include "segment_cache.hpp"
+
+#include <fstream>
+#include <iterator>
+
+using namespace amd::hsa::loader;
+using namespace amd::hsa::loader::test;
+
+namespace {
+
+const char kIsa[] = "amdgcn-amd-amdhsa--gfx900";
+
+std::string EntryPath(const std::string &dir, const std::vector<char> &code_object)
+{
+  return dir + "/" + PrelinkedSegmentCache::Key(code_object.data(), code_object.size(), kIsa) + ".prelink";
+}
+
+void TestKey()
+{
+  const std::vector<char> a = BuildCodeObject(16, 1);
+  const std::vector<char> b = BuildCodeObject(16, 2);
+  LOADER_CHECK(a.size() == b.size());
+  LOADER_CHECK(PrelinkedSegmentCache::Key(a.data(), a.size(), kIsa) !=
+               PrelinkedSegmentCache::Key(b.data(), b.size(), kIsa));
+  LOADER_CHECK(PrelinkedSegmentCache::Key(a.data(), a.size(), kIsa) !=
+               PrelinkedSegmentCache::Key(a.data(), a.size(), "amdgcn-amd-amdhsa--gfx906"));
+  LOADER_CHECK(PrelinkedSegmentCache::Key(a.data(), a.size() - 1, kIsa) !=
+               PrelinkedSegmentCache::Key(a.data(), a.size(), kIsa));
+}
+
+void TestEntryValidation(const std::string &dir)
+{
+  PrelinkedSegmentCache cache(dir);
+  PrelinkedSegment segment;
+  segment.image.assign(64, 0xA5);
+  segment.fixups.push_back({ 8, R_AMDGPU_RELATIVE64, 0, 32 });
+
+  const char one[] = "one", two[] = "two";
+  const std::string key = PrelinkedSegmentCache::Key(one, 3, kIsa);
+  const std::string other_key = PrelinkedSegmentCache::Key(two, 3, kIsa);
+  const std::string path = dir + "/" + key + ".prelink";
+  const std::string other_path = dir + "/" + other_key + ".prelink";
+  std::remove(other_path.c_str());
+
+  LOADER_CHECK(cache.Store(key, one, 3, kIsa, segment) || std::ifstream(path).good());
+  PrelinkedSegment loaded;
+  LOADER_CHECK(cache.Load(key, one, 3, kIsa, 64, &loaded));
+  LOADER_CHECK(loaded.image == segment.image);
+  LOADER_CHECK(loaded.fixups.size() == 1 && loaded.fixups[0].value == 32);
+  LOADER_CHECK(!cache.Load(key, one, 3, "amdgcn-amd-amdhsa--gfx906", 64, &loaded));
+  LOADER_CHECK(!cache.Load(key, one, 3, kIsa, 128, &loaded));
+
+  // A key collision must not return the entry of another code object.
+  LOADER_CHECK(!cache.Load(key, two, 3, kIsa, 64, &loaded));
+  LOADER_CHECK(!cache.Load(key, one, 2, kIsa, 64, &loaded));
+
+  // Nor may an entry copied under the key of another code object.
+  std::ifstream in(path, std::ios::binary);
+  std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  {
+    std::ofstream out(other_path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), bytes.size());
+  }
+  LOADER_CHECK(!cache.Load(other_key, two, 3, kIsa, 64, &loaded));
+
+  // Nor may a corrupt one.
+  bytes[bytes.size() - 1] ^= 1;
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), bytes.size());
+  }
+  LOADER_CHECK(!cache.Load(key, one, 3, kIsa, 64, &loaded));
+
+  std::remove(path.c_str());
+  std::remove(other_path.c_str());
+}
+
+void TestCachedLoadMatchesUncached(const std::string &dir)
+{
+  const std::string options = "-prelink-cache-dir=" + dir;
+  for (unsigned kernels : { 1u, 16u, 300u }) {
+    const std::vector<char> code_object = BuildCodeObject(kernels, kernels);
+    const std::string path = EntryPath(dir, code_object);
+    std::remove(path.c_str());
+
+    TestLoaderContext context;
+    Loader *loader = Loader::Create(&context);
+
+    Executable *uncached = LoadExecutable(loader, code_object);
+    LOADER_CHECK(uncached != nullptr);
+    if (uncached == nullptr) { Loader::Destroy(loader); continue; }
+    const std::vector<std::vector<uint8_t>> reference = SegmentImages(uncached);
+
+    context.copies = 0;
+    Executable *cold = LoadExecutable(loader, code_object, options.c_str());
+    const size_t cold_copies = context.copies;
+    LOADER_CHECK(cold != nullptr);
+    LOADER_CHECK(std::ifstream(path).good());
+
+    context.copies = 0;
+    Executable *warm = LoadExecutable(loader, code_object, options.c_str());
+    const size_t warm_copies = context.copies;
+    LOADER_CHECK(warm != nullptr);
+
+    if (cold != nullptr && warm != nullptr) {
+      LOADER_CHECK(SegmentImages(cold) == reference);
+      LOADER_CHECK(SegmentImages(warm) == reference);
+      // A hit writes the segment with one copy instead of one per relocation.
+      LOADER_CHECK(warm_copies < cold_copies);
+
+      hsa_agent_t agent = { 1 };
+      const std::string name = "k" + std::to_string(kernels - 1) + ".kd";
+      uint64_t cold_object = 0, warm_object = 0;
+      Symbol *cold_symbol = cold->GetSymbol(name.c_str(), &agent);
+      Symbol *warm_symbol = warm->GetSymbol(name.c_str(), &agent);
+      LOADER_CHECK(cold_symbol != nullptr && warm_symbol != nullptr);
+      if (cold_symbol != nullptr && warm_symbol != nullptr) {
+        LOADER_CHECK(cold_symbol->GetInfo(HSA_EXECUTABLE_SYMBOL_INFO_KERNEL_OBJECT, &cold_object));
+        LOADER_CHECK(warm_symbol->GetInfo(HSA_EXECUTABLE_SYMBOL_INFO_KERNEL_OBJECT, &warm_object));
+        LOADER_CHECK(cold_object != 0 && warm_object != 0 && cold_object != warm_object);
+      }
+    }
+
+    // A code object of the same size with different contents misses.
+    const std::vector<char> other = BuildCodeObject(kernels, kernels + 1000);
+    LOADER_CHECK(other.size() == code_object.size());
+    std::remove(EntryPath(dir, other).c_str());
+    Executable *other_uncached = LoadExecutable(loader, other);
+    Executable *other_cached = LoadExecutable(loader, other, options.c_str());
+    LOADER_CHECK(other_uncached != nullptr && other_cached != nullptr);
+    if (other_uncached != nullptr && other_cached != nullptr) {
+      LOADER_CHECK(SegmentImages(other_cached) == SegmentImages(other_uncached));
+      LOADER_CHECK(SegmentImages(other_cached) != reference);
+    }
+
+    for (Executable *executable : { uncached, cold, warm, other_uncached, other_cached }) {
+      if (executable != nullptr) { loader->DestroyExecutable(executable); }
+    }
+    Loader::Destroy(loader);
+    std::remove(path.c_str());
+    std::remove(EntryPath(dir, other).c_str());
+  }
+}
+
+} // namespace anonymous
+
+int main(int argc, char **argv)
+{
+  QuietStdout();
+  const std::string dir = argc > 1 ? argv[1] : ".";
+  TestKey();
+  TestEntryValidation(dir);
+  TestCachedLoadMatchesUncached(dir);
+  if (failures != 0) {
+    fprintf(stderr, "segment_cache_test: %d checks failed\n", failures);
+    return 1;
+  }
+  printf("segment_cache_test: passed\n");
+  return 0;
+}
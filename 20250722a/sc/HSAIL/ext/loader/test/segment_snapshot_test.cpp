@@ -0,0 +1,236 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+
+// Checks the lock-free segment snapshot: while writers load, freeze and
+// destroy executables, readers doing count-then-fill
+// QuerySegmentDescriptors calls only ever see whole, consistent snapshots,
+// a count mismatch always comes with a generation change, and every
+// executable's segments are visible between its load and its destruction.
+//
+// Usage: segment_snapshot_test
+
+#include "loader_test.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+using namespace amd::hsa::loader;
+using namespace amd::hsa::loader::test;
+
+namespace {
+
+typedef hsa_ven_amd_loader_segment_descriptor_t Descriptor;
+
+// Code objects v2 and later load as one segment.
+const size_t kSegmentsPerObject = 1;
+
+size_t CountExecutable(const std::vector<Descriptor> &descriptors, hsa_executable_t executable)
+{
+  return std::count_if(descriptors.begin(), descriptors.end(),
+                       [&](const Descriptor &d) { return d.executable.handle == executable.handle; });
+}
+
+void TestArguments()
+{
+  TestLoaderContext context;
+  Loader *loader = Loader::Create(&context);
+  Descriptor descriptor;
+  size_t count = 0;
+  LOADER_CHECK(loader->QuerySegmentDescriptors(nullptr, nullptr) == HSA_STATUS_ERROR_INVALID_ARGUMENT);
+  LOADER_CHECK(loader->QuerySegmentDescriptors(&descriptor, &count) == HSA_STATUS_ERROR_INVALID_ARGUMENT);
+  count = 1;
+  LOADER_CHECK(loader->QuerySegmentDescriptors(nullptr, &count) == HSA_STATUS_ERROR_INVALID_ARGUMENT);
+  count = 0;
+  LOADER_CHECK(loader->QuerySegmentDescriptors(nullptr, &count) == HSA_STATUS_SUCCESS && count == 0);
+
+  const uint64_t generation = loader->SegmentGeneration();
+  LOADER_CHECK(!loader->SegmentsChangedSince(generation));
+  const std::vector<char> code_object = BuildCodeObject(4, 1);
+  Executable *executable = LoadExecutable(loader, code_object);
+  LOADER_CHECK(executable != nullptr);
+  LOADER_CHECK(loader->SegmentsChangedSince(generation));
+  LOADER_CHECK(loader->QuerySegmentDescriptors(nullptr, &count) == HSA_STATUS_SUCCESS);
+  LOADER_CHECK(count == kSegmentsPerObject);
+  count = 2;
+  Descriptor too_many[2];
+  LOADER_CHECK(loader->QuerySegmentDescriptors(too_many, &count) == HSA_STATUS_ERROR_INCOMPATIBLE_ARGUMENTS);
+
+  std::shared_ptr<const SegmentSnapshot> snapshot = loader->GetSegmentSnapshot();
+  LOADER_CHECK(snapshot->Generation() == loader->SegmentGeneration());
+  loader->DestroyExecutable(executable);
+
+  // A snapshot stays valid after the loader moves on.
+  LOADER_CHECK(snapshot->Descriptors().size() == kSegmentsPerObject);
+  LOADER_CHECK(loader->GetSegmentSnapshot()->Descriptors().empty());
+  LOADER_CHECK(loader->GetSegmentSnapshot()->Generation() > snapshot->Generation());
+  Loader::Destroy(loader);
+}
+
+void TestConcurrentQueries(unsigned writers, unsigned readers, int cycles)
+{
+  LockingLoaderContext context;
+  Loader *loader = Loader::Create(&context);
+
+  // Stays loaded throughout, so every snapshot must contain it.
+  const std::vector<char> base_object = BuildCodeObject(4, 1, "base");
+  Executable *base = LoadExecutable(loader, base_object);
+  LOADER_CHECK(base != nullptr);
+  if (!base) { Loader::Destroy(loader); return; }
+  const hsa_executable_t base_handle = Executable::Handle(base);
+  const uint64_t start_generation = loader->SegmentGeneration();
+
+  std::vector<std::vector<char>> code_objects;
+  for (unsigned w = 0; w < writers; ++w) {
+    code_objects.push_back(BuildCodeObject(8, 100 + w, "w" + std::to_string(w) + "k"));
+  }
+
+  std::atomic<unsigned> writers_left(writers);
+  std::vector<int> thread_failures(writers + readers, 0);
+  std::vector<uint64_t> mismatches(readers, 0), fills(readers, 0);
+  std::vector<std::thread> threads;
+
+  for (unsigned r = 0; r < readers; ++r) {
+    threads.emplace_back([&, r]() {
+      int &failed = thread_failures[writers + r];
+      std::vector<Descriptor> descriptors;
+      uint64_t last_generation = 0;
+      while (writers_left.load() != 0) {
+        const uint64_t generation = loader->SegmentGeneration();
+        if (generation < last_generation) { ++failed; }
+        last_generation = generation;
+
+        std::shared_ptr<const SegmentSnapshot> snapshot = loader->GetSegmentSnapshot();
+        if (snapshot->Generation() < generation) { ++failed; }
+        if (CountExecutable(snapshot->Descriptors(), base_handle) != kSegmentsPerObject) { ++failed; }
+
+        size_t count = 0;
+        if (loader->QuerySegmentDescriptors(nullptr, &count) != HSA_STATUS_SUCCESS || count < kSegmentsPerObject) {
+          ++failed;
+          continue;
+        }
+        descriptors.assign(count, Descriptor());
+        const hsa_status_t status = loader->QuerySegmentDescriptors(descriptors.data(), &count);
+        if (status == HSA_STATUS_ERROR_INCOMPATIBLE_ARGUMENTS) {
+          // The count can only go stale if something was published.
+          ++mismatches[r];
+          if (!loader->SegmentsChangedSince(generation)) { ++failed; }
+          continue;
+        }
+        ++fills[r];
+        if (status != HSA_STATUS_SUCCESS || CountExecutable(descriptors, base_handle) != kSegmentsPerObject) {
+          ++failed;
+        }
+        for (const Descriptor &d : descriptors) {
+          if (d.segment_base == 0 || d.segment_size == 0 || d.code_object_storage_base == nullptr) {
+            ++failed;
+          }
+        }
+      }
+    });
+  }
+
+  for (unsigned w = 0; w < writers; ++w) {
+    threads.emplace_back([&, w]() {
+      int &failed = thread_failures[w];
+      const std::vector<char> &code_object = code_objects[w];
+      const hsa_agent_t agent = { 1 };
+      const hsa_code_object_t handle = { uint64_t(code_object.data()) };
+      for (int c = 0; c < cycles; ++c) {
+        Executable *executable = loader->CreateExecutable(HSA_PROFILE_FULL, nullptr);
+        if (!executable) { ++failed; break; }
+        const hsa_executable_t executable_handle = Executable::Handle(executable);
+
+        // Visible from the load on, and still after the freeze.
+        if (executable->LoadCodeObject(agent, handle, code_object.size(), "", nullptr) != HSA_STATUS_SUCCESS ||
+            CountExecutable(loader->GetSegmentSnapshot()->Descriptors(), executable_handle) != kSegmentsPerObject) {
+          ++failed;
+        }
+        if (executable->Freeze(nullptr) != HSA_STATUS_SUCCESS ||
+            CountExecutable(loader->GetSegmentSnapshot()->Descriptors(), executable_handle) != kSegmentsPerObject) {
+          ++failed;
+        }
+        loader->DestroyExecutable(executable);
+      }
+      writers_left.fetch_sub(1);
+    });
+  }
+
+  for (std::thread &thread : threads) { thread.join(); }
+  for (int failures_in_thread : thread_failures) { LOADER_CHECK(failures_in_thread == 0); }
+
+  // Each cycle publishes on load, freeze and destroy.
+  LOADER_CHECK(loader->SegmentGeneration() - start_generation >= uint64_t(3) * writers * cycles);
+  size_t count = 0;
+  LOADER_CHECK(loader->QuerySegmentDescriptors(nullptr, &count) == HSA_STATUS_SUCCESS);
+  LOADER_CHECK(count == kSegmentsPerObject);
+  std::vector<Descriptor> descriptors(count);
+  LOADER_CHECK(loader->QuerySegmentDescriptors(descriptors.data(), &count) == HSA_STATUS_SUCCESS);
+  LOADER_CHECK(CountExecutable(descriptors, base_handle) == kSegmentsPerObject);
+
+  uint64_t total_mismatches = 0, total_fills = 0;
+  for (unsigned r = 0; r < readers; ++r) {
+    total_mismatches += mismatches[r];
+    total_fills += fills[r];
+  }
+  printf("%u writers x %d cycles, %u readers: %llu fills, %llu count mismatches\n", writers, cycles, readers,
+         static_cast<unsigned long long>(total_fills), static_cast<unsigned long long>(total_mismatches));
+
+  loader->DestroyExecutable(base);
+  Loader::Destroy(loader);
+}
+
+} // namespace anonymous
+
+int main()
+{
+  QuietStdout();
+  TestArguments();
+  TestConcurrentQueries(1, 1, 500);
+  TestConcurrentQueries(2, 4, 300);
+  TestConcurrentQueries(4, 2, 200);
+  if (failures != 0) {
+    fprintf(stderr, "segment_snapshot_test: %d checks failed\n", failures);
+    return 1;
+  }
+  printf("segment_snapshot_test: passed\n");
+  return 0;
+}
@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+// Load/destroy churn with and without -suballocate-segments: each cycle
+// creates an executable, loads several small code objects into it, freezes
+// and destroys it. Reports the wrapped context's SegmentAlloc calls and wall
+// time per cycle.
+//
+// Usage: segment_suballocator_bench [cycles] [alloc us]
+//
+// Segments live in host memory. Pass a cost in microseconds per SegmentAlloc
+// and SegmentFree to model allocations of agent memory.
+
+#include "loader_test.hpp"
+
+using namespace amd::hsa::loader;
+using namespace amd::hsa::loader::test;
+
+namespace {
+
+class BenchLoaderContext : public TestLoaderContext {
+public:
+  explicit BenchLoaderContext(double alloc_us) : allocs(0), alloc_us_(alloc_us) {}
+
+  void* SegmentAlloc(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent, size_t size, size_t align,
+                     bool zero) override
+  {
+    const auto start = std::chrono::steady_clock::now();
+    ++allocs;
+    void *ptr = TestLoaderContext::SegmentAlloc(segment, agent, size, align, zero);
+    while (ElapsedUs(start) < alloc_us_) {}
+    return ptr;
+  }
+
+  void SegmentFree(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent, void *seg, size_t size) override
+  {
+    const auto start = std::chrono::steady_clock::now();
+    TestLoaderContext::SegmentFree(segment, agent, seg, size);
+    while (ElapsedUs(start) < alloc_us_) {}
+  }
+
+  size_t allocs;
+
+private:
+  const double alloc_us_;
+};
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  QuietStdout();
+  const int cycles = argc > 1 ? atoi(argv[1]) : 200;
+  const double alloc_us = argc > 2 ? atof(argv[2]) : 0;
+
+  printf("SegmentAlloc/SegmentFree cost: %.1f us\n", alloc_us);
+  printf("%8s %8s %22s %14s %14s\n", "objects", "kernels", "executable options", "allocs/cycle", "us/cycle");
+  for (unsigned objects : { 1u, 8u, 32u }) {
+    for (unsigned kernels : { 4u, 64u }) {
+      std::vector<std::vector<char>> code_objects;
+      for (unsigned i = 0; i < objects; ++i) {
+        code_objects.push_back(BuildCodeObject(kernels, i, "o" + std::to_string(i) + "k"));
+      }
+      for (const char *executable_options : { "", "-suballocate-segments" }) {
+        BenchLoaderContext context(alloc_us);
+        Loader *loader = Loader::Create(&context);
+        const hsa_agent_t agent = { 1 };
+        const auto start = std::chrono::steady_clock::now();
+        for (int c = 0; c < cycles; ++c) {
+          Executable *executable = loader->CreateExecutable(HSA_PROFILE_FULL, executable_options);
+          for (const std::vector<char> &code_object : code_objects) {
+            const hsa_code_object_t handle = { uint64_t(code_object.data()) };
+            if (executable->LoadCodeObject(agent, handle, code_object.size(), "", nullptr) != HSA_STATUS_SUCCESS) {
+              fprintf(stderr, "segment_suballocator_bench: load failed\n");
+              return 1;
+            }
+          }
+          if (executable->Freeze(nullptr) != HSA_STATUS_SUCCESS) {
+            fprintf(stderr, "segment_suballocator_bench: freeze failed\n");
+            return 1;
+          }
+          loader->DestroyExecutable(executable);
+        }
+        const double us = ElapsedUs(start);
+        Loader::Destroy(loader);
+        printf("%8u %8u %22s %14.1f %14.1f\n", objects, kernels, *executable_options ? executable_options : "(none)",
+               double(context.allocs) / cycles, us / cycles);
+      }
+    }
+  }
+  return 0;
+}
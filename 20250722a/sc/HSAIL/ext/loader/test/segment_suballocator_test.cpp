@@ -0,0 +1,274 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+// Checks the suballocating context: blocks do not overlap and merge back,
+// slabs are reused across contexts, and freezing a segment never freezes
+// memory of another executable.
+//
+// Usage: segment_suballocator_test
+
+#include "loader_test.hpp"
+#include "segment_suballocator.hpp"
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+using namespace amd::hsa::loader;
+using namespace amd::hsa::loader::test;
+
+namespace {
+
+const amdgpu_hsa_elf_segment_t kSegment = AMDGPU_HSA_SEGMENT_GLOBAL_AGENT;
+const hsa_agent_t kAgent = { 1 };
+
+/// @brief Context that counts allocations and checks that nothing is copied
+/// into memory it has frozen.
+class FreezeCheckingContext : public TestLoaderContext {
+public:
+  FreezeCheckingContext() : allocs(0), copies_to_frozen(0) {}
+
+  void* SegmentAlloc(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent, size_t size, size_t align,
+                     bool zero) override
+  {
+    ++allocs;
+    void *ptr = TestLoaderContext::SegmentAlloc(segment, agent, size, align, zero);
+    sizes[ptr] = size;
+    return ptr;
+  }
+
+  void SegmentFree(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent, void *seg, size_t size) override
+  {
+    sizes.erase(seg);
+    frozen.erase(seg);
+    TestLoaderContext::SegmentFree(segment, agent, seg, size);
+  }
+
+  bool SegmentCopy(amdgpu_hsa_elf_segment_t segment, hsa_agent_t agent, void *dst, size_t offset,
+                   const void *src, size_t size) override
+  {
+    if (frozen.count(dst)) { ++copies_to_frozen; }
+    return TestLoaderContext::SegmentCopy(segment, agent, dst, offset, src, size);
+  }
+
+  bool SegmentFreeze(amdgpu_hsa_elf_segment_t, hsa_agent_t, void *seg, size_t size) override
+  {
+    LOADER_CHECK(sizes.count(seg) && sizes[seg] == size);
+    frozen.insert(seg);
+    return true;
+  }
+
+  size_t allocs;
+  size_t copies_to_frozen;
+  std::map<void*, size_t> sizes;
+  std::set<void*> frozen;
+};
+
+void TestBlocks()
+{
+  FreezeCheckingContext base;
+  {
+    std::shared_ptr<SegmentSlabPool> pool = std::make_shared<SegmentSlabPool>(&base, 1 << 16, 1);
+    SuballocatingContext context(pool, 256);
+    std::mt19937 random(7);
+    struct Block { char *ptr; size_t size; char fill; };
+    std::vector<Block> live;
+    for (int i = 0; i < 20000; ++i) {
+      if (live.empty() || random() % 3) {
+        const size_t size = 1 + random() % 9000;
+        const size_t align = size_t(1) << (random() % 13);
+        const bool zero = random() % 2;
+        char *ptr = static_cast<char*>(context.SegmentAlloc(kSegment, kAgent, size, align, zero));
+        LOADER_CHECK(ptr && uintptr_t(ptr) % align == 0);
+        if (!ptr) { continue; }
+        if (zero) {
+          LOADER_CHECK(std::all_of(ptr, ptr + size, [](char c) { return c == 0; }));
+        }
+        const std::vector<char> fill(size, char(random()));
+        LOADER_CHECK(context.SegmentCopy(kSegment, kAgent, ptr, 0, fill.data(), size));
+        LOADER_CHECK(context.SegmentHostAddress(kSegment, kAgent, ptr, 5) == ptr + 5);
+        live.push_back({ ptr, size, fill[0] });
+      } else {
+        const size_t k = random() % live.size();
+        const Block block = live[k];
+        live[k] = live.back();
+        live.pop_back();
+        LOADER_CHECK(std::all_of(block.ptr, block.ptr + block.size, [&](char c) { return c == block.fill; }));
+        context.SegmentFree(kSegment, kAgent, block.ptr, block.size);
+      }
+    }
+
+    // Larger than a slab: passed through.
+    void *large = context.SegmentAlloc(AMDGPU_HSA_SEGMENT_CODE_AGENT, kAgent, 1 << 17, 256, true);
+    LOADER_CHECK(base.sizes.count(large) == 1);
+    context.SegmentFree(AMDGPU_HSA_SEGMENT_CODE_AGENT, kAgent, large, 1 << 17);
+
+    for (const Block &block : live) {
+      context.SegmentFree(kSegment, kAgent, block.ptr, block.size);
+    }
+    LOADER_CHECK(context.SlabBytes() == 0);
+    LOADER_CHECK(pool->SlabBytes() == (1 << 16));
+
+    // Every block merged back, so the idle slab serves a whole-slab request.
+    const size_t allocs = base.allocs;
+    void *whole = context.SegmentAlloc(kSegment, kAgent, 1 << 16, 1, false);
+    LOADER_CHECK(base.allocs == allocs && base.sizes.count(whole) == 1);
+    context.SegmentFree(kSegment, kAgent, whole, 1 << 16);
+  }
+  LOADER_CHECK(base.sizes.empty());
+}
+
+void TestFreezeIsolation()
+{
+  FreezeCheckingContext base;
+  std::shared_ptr<SegmentSlabPool> pool = std::make_shared<SegmentSlabPool>(&base, 1 << 16, 1);
+  {
+    SuballocatingContext a(pool, 256), b(pool, 256);
+    char *a1 = static_cast<char*>(a.SegmentAlloc(kSegment, kAgent, 1000, 256, true));
+    char *a2 = static_cast<char*>(a.SegmentAlloc(kSegment, kAgent, 1000, 256, true));
+    char *b1 = static_cast<char*>(b.SegmentAlloc(kSegment, kAgent, 1000, 256, true));
+    LOADER_CHECK(a1 && a2 && b1);
+    LOADER_CHECK(base.allocs == 2);
+
+    // The slab is frozen only once both of a's segments are.
+    LOADER_CHECK(a.SegmentFreeze(kSegment, kAgent, a1, 1000));
+    LOADER_CHECK(base.frozen.empty());
+    LOADER_CHECK(a.SegmentFreeze(kSegment, kAgent, a2, 1000));
+    LOADER_CHECK(base.frozen.size() == 1);
+
+    // b's slab is not affected, and a no longer allocates from its frozen
+    // slab.
+    const char data[16] = {};
+    LOADER_CHECK(b.SegmentCopy(kSegment, kAgent, b1, 0, data, sizeof(data)));
+    char *a3 = static_cast<char*>(a.SegmentAlloc(kSegment, kAgent, 1000, 256, true));
+    LOADER_CHECK(a.SegmentCopy(kSegment, kAgent, a3, 0, data, sizeof(data)));
+    LOADER_CHECK(base.copies_to_frozen == 0);
+    LOADER_CHECK(a.SlabBytes() == 2 << 16 && b.SlabBytes() == 1 << 16);
+
+    a.SegmentFree(kSegment, kAgent, a1, 1000);
+    a.SegmentFree(kSegment, kAgent, a2, 1000);
+    a.SegmentFree(kSegment, kAgent, a3, 1000);
+    LOADER_CHECK(b.SegmentFreeze(kSegment, kAgent, b1, 1000));
+    b.SegmentFree(kSegment, kAgent, b1, 1000);
+  }
+  // The slab that was never frozen is kept idle, the frozen ones returned.
+  LOADER_CHECK(pool->SlabBytes() == 1 << 16);
+  LOADER_CHECK(base.sizes.size() == 1 && base.frozen.empty());
+
+  // A later context reuses the idle slab.
+  {
+    SuballocatingContext c(pool, 256);
+    void *c1 = c.SegmentAlloc(kSegment, kAgent, 1000, 256, true);
+    LOADER_CHECK(base.allocs == 3);
+    c.SegmentFree(kSegment, kAgent, c1, 1000);
+  }
+
+  // Frozen slabs are kept only when the pool may reuse them.
+  std::shared_ptr<SegmentSlabPool> reusing = std::make_shared<SegmentSlabPool>(&base, 1 << 16, 1, true);
+  for (int i = 0; i < 3; ++i) {
+    SuballocatingContext d(reusing, 256);
+    void *d1 = d.SegmentAlloc(kSegment, kAgent, 1000, 256, true);
+    LOADER_CHECK(d.SegmentFreeze(kSegment, kAgent, d1, 1000));
+    d.SegmentFree(kSegment, kAgent, d1, 1000);
+  }
+  LOADER_CHECK(base.allocs == 4);
+}
+
+void TestLoaderPath()
+{
+  const std::vector<char> code_object = BuildCodeObject(16, 3);
+  std::vector<std::vector<uint8_t>> expected;
+  {
+    TestLoaderContext context;
+    Loader *loader = Loader::Create(&context);
+    Executable *executable = LoadExecutable(loader, code_object);
+    LOADER_CHECK(executable);
+    if (executable) {
+      expected = SegmentImages(executable);
+      loader->DestroyExecutable(executable);
+    }
+    Loader::Destroy(loader);
+  }
+
+  FreezeCheckingContext base;
+  Loader *loader = Loader::Create(&base);
+  for (const char *options : { "", "-lazy-upload", "-lazy-upload -upload-at-freeze" }) {
+    // Two live executables at a time, each loaded after the previous one was
+    // frozen.
+    std::vector<Executable*> executables;
+    for (int i = 0; i < 4; ++i) {
+      Executable *executable = LoadExecutable(loader, code_object, options, "-suballocate-segments");
+      LOADER_CHECK(executable);
+      if (!executable) { continue; }
+      LOADER_CHECK(SegmentImages(executable) == expected);
+      executables.push_back(executable);
+      if (executables.size() > 2) {
+        loader->DestroyExecutable(executables.front());
+        executables.erase(executables.begin());
+      }
+    }
+    for (Executable *executable : executables) {
+      loader->DestroyExecutable(executable);
+    }
+  }
+  LOADER_CHECK(base.copies_to_frozen == 0);
+  // Only slabs that were never frozen may stay behind.
+  LOADER_CHECK(std::none_of(base.sizes.begin(), base.sizes.end(),
+                            [&](const std::pair<void* const, size_t> &s) { return base.frozen.count(s.first); }));
+  Loader::Destroy(loader);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  QuietStdout();
+  TestBlocks();
+  TestFreezeIsolation();
+  TestLoaderPath();
+  if (failures != 0) {
+    fprintf(stderr, "segment_suballocator_test: %d checks failed\n", failures);
+    return 1;
+  }
+  printf("segment_suballocator_test: passed\n");
+  return 0;
+}
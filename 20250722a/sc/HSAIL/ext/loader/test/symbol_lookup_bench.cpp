@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+// Reports the allocations and heap bytes used to load a code object with
+// many kernels, and times GetSymbol for names that are and are not defined.
+//
+// Usage: symbol_lookup_bench [kernels] [lookups]
+
+#include "loader_test.hpp"
+#include "alloc_counter.hpp"
+
+using namespace amd::hsa::loader;
+using namespace amd::hsa::loader::test;
+
+int main(int argc, char **argv)
+{
+  QuietStdout();
+  const unsigned kernels = argc > 1 ? unsigned(atoi(argv[1])) : 20000;
+  const unsigned lookups = argc > 2 ? unsigned(atoi(argv[2])) : 1000000;
+
+  const std::vector<char> code_object = BuildCodeObject(kernels, 1);
+  std::vector<std::string> hits(kernels), misses(kernels);
+  for (unsigned i = 0; i < kernels; ++i) {
+    hits[i] = "k" + std::to_string(i) + ".kd";
+    misses[i] = "m" + std::to_string(i) + ".kd";
+  }
+  // Scatter the lookup order so consecutive queries touch unrelated entries.
+  std::vector<unsigned> order(kernels);
+  for (unsigned i = 0; i < kernels; ++i) { order[i] = unsigned((uint64_t(i) * 2654435761u) % kernels); }
+
+  TestLoaderContext context;
+  Loader *loader = Loader::Create(&context);
+
+  const uint64_t allocations_before = allocations.load();
+  const int64_t bytes_before = live_bytes.load();
+  auto start = std::chrono::steady_clock::now();
+  Executable *executable = LoadExecutable(loader, code_object);
+  const double load_us = ElapsedUs(start);
+  if (executable == nullptr) {
+    fprintf(stderr, "symbol_lookup_bench: load failed\n");
+    return 1;
+  }
+  const uint64_t load_allocations = allocations.load() - allocations_before;
+  const int64_t load_bytes = live_bytes.load() - bytes_before;
+
+  printf("kernels                %u\n", kernels);
+  printf("load                   %.1f ms, %.0f ns/kernel\n", load_us / 1000, load_us * 1000 / kernels);
+  printf("allocations to load    %llu (%.1f per kernel)\n",
+         (unsigned long long)load_allocations, double(load_allocations) / kernels);
+  printf("heap held after load   %.2f MiB (%.0f bytes per kernel, excluding segments)\n",
+         load_bytes / 1048576.0, double(load_bytes) / kernels);
+
+  hsa_agent_t agent = { 1 };
+  for (int miss = 0; miss < 2; ++miss) {
+    const std::vector<std::string> &names = miss ? misses : hits;
+    std::vector<const char*> queries(kernels);
+    for (unsigned i = 0; i < kernels; ++i) { queries[i] = names[order[i]].c_str(); }
+
+    size_t found = 0;
+    const uint64_t lookup_allocations_before = allocations.load();
+    start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < lookups; ++i) {
+      found += executable->GetSymbol(queries[i % kernels], &agent) != nullptr;
+    }
+    const double us = ElapsedUs(start);
+    const uint64_t lookup_allocations = allocations.load() - lookup_allocations_before;
+    if (found != (miss ? 0 : lookups)) {
+      fprintf(stderr, "symbol_lookup_bench: unexpected lookup result\n");
+      return 1;
+    }
+    printf("GetSymbol %-4s         %.1f ns/call, %.2f allocations/call\n", miss ? "miss" : "hit",
+           us * 1000 / lookups, double(lookup_allocations) / lookups);
+  }
+
+  loader->DestroyExecutable(executable);
+  Loader::Destroy(loader);
+  return 0;
+}
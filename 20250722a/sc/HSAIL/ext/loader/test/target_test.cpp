@@ -0,0 +1,354 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+// Checks target name parsing against every known processor and feature
+// setting, the code object v2 names against the rules of the original
+// ConvertOldTargetNameToNew(), and the ISA handles of OfflineLoaderContext.
+
+#include "loader_test.hpp"
+#include "amd_hsa_target.hpp"
+
+#include <set>
+#include <thread>
+
+using namespace amd::hsa;
+using namespace amd::hsa::loader;
+using namespace amd::hsa::loader::test;
+
+namespace {
+
+const char *const kFeatureSuffixes[] = { "", "+", "-" };
+
+bool SameTargetId(const TargetId &a, const TargetId &b)
+{
+  return a.processor == b.processor && a.sramecc == b.sramecc && a.xnack == b.xnack;
+}
+
+TargetFeatureSetting ExpectedSetting(bool supported, const char *suffix)
+{
+  if (!supported) { return TARGET_FEATURE_UNSUPPORTED; }
+  if (*suffix == '\0') { return TARGET_FEATURE_ANY; }
+  return *suffix == '+' ? TARGET_FEATURE_ON : TARGET_FEATURE_OFF;
+}
+
+void TestProcessors()
+{
+  size_t count = 0;
+  const TargetProcessor *processors = TargetProcessors(&count);
+  LOADER_CHECK(count != 0);
+  for (size_t i = 0; i < count; ++i) {
+    const TargetProcessor &p = processors[i];
+    LOADER_CHECK(FindTargetProcessor(p.name, strlen(p.name)) == &p);
+    LOADER_CHECK(FindTargetProcessorByMach(p.mach) == &p);
+    if (i != 0) { LOADER_CHECK(strcmp(processors[i - 1].name, p.name) < 0); }
+
+    // Every combination of feature settings, with and without the triple.
+    for (const char *sramecc : kFeatureSuffixes) {
+      for (const char *xnack : kFeatureSuffixes) {
+        std::string suffix;
+        if (*sramecc) { suffix += std::string(":sramecc") + sramecc; }
+        if (*xnack) { suffix += std::string(":xnack") + xnack; }
+        const bool valid = (*sramecc == '\0' || p.sramecc_supported) && (*xnack == '\0' || p.xnack_supported);
+        for (const char *triple : { "", "amdgcn-amd-amdhsa--" }) {
+          const std::string name = triple + std::string(p.name) + suffix;
+          TargetId id = TargetId();
+          const bool parsed = ParseTargetId(name.c_str(), &id);
+          LOADER_CHECK(parsed == valid);
+          if (!parsed || !valid) {
+            LOADER_CHECK(id.processor == nullptr);
+            continue;
+          }
+          LOADER_CHECK(id.processor == &p);
+          LOADER_CHECK(id.sramecc == ExpectedSetting(p.sramecc_supported, sramecc));
+          LOADER_CHECK(id.xnack == ExpectedSetting(p.xnack_supported, xnack));
+          LOADER_CHECK(TargetIdToString(id) == std::string(p.name) + suffix);
+        }
+      }
+    }
+
+    // Malformed feature lists.
+    const std::string name = p.name;
+    for (const char *suffix : { ":", ":xnack", ":xnack*", ":sramecc", ":foo+", ":xnack+:xnack+",
+                                ":sramecc-:sramecc-", ":xnack+:sramecc+", ":xnack+:" }) {
+      TargetId id = TargetId();
+      LOADER_CHECK(!ParseTargetId((name + suffix).c_str(), &id));
+      LOADER_CHECK(id.processor == nullptr);
+    }
+  }
+
+  for (const char *name : { "", "gfx", "gfx9", "gfx9000", "gfx90", "GFX900", "amdgcn-amd-amdhsa--",
+                            "amdgcn-amd-amdhsa-gfx900", "gfx900 ", " gfx900", "AMD:AMDGPU:9:0" }) {
+    TargetId id = TargetId();
+    LOADER_CHECK(!ParseTargetId(name, &id));
+    LOADER_CHECK(id.processor == nullptr);
+  }
+}
+
+// Code object v2 names and the processor each converts to, per the original
+// ConvertOldTargetNameToNew().
+struct LegacyName {
+  const char *name;
+  const char *processor;
+  bool finalizer_only;
+  bool xnack_on;  // Implied by the name for the lightning compiler.
+};
+
+const LegacyName kLegacyNames[] = {
+  { "AMD:AMDGPU:7:0:0",  "gfx700",  false, false },
+  { "AMD:AMDGPU:7:0:1",  "gfx701",  false, false },
+  { "AMD:AMDGPU:7:0:2",  "gfx702",  false, false },
+  { "AMD:AMDGPU:7:0:3",  "gfx703",  false, false },
+  { "AMD:AMDGPU:7:0:4",  "gfx704",  false, false },
+  { "AMD:AMDGPU:8:0:0",  "gfx802",  false, false },
+  { "AMD:AMDGPU:8:0:1",  "gfx801",  false, true  },
+  { "AMD:AMDGPU:8:0:2",  "gfx802",  false, false },
+  { "AMD:AMDGPU:8:0:3",  "gfx803",  false, false },
+  { "AMD:AMDGPU:8:0:4",  "gfx803",  false, false },
+  { "AMD:AMDGPU:8:1:0",  "gfx810",  false, true  },
+  { "AMD:AMDGPU:9:0:0",  "gfx900",  false, false },
+  { "AMD:AMDGPU:9:0:1",  "gfx900",  false, true  },
+  { "AMD:AMDGPU:9:0:2",  "gfx902",  false, false },
+  { "AMD:AMDGPU:9:0:3",  "gfx902",  false, true  },
+  { "AMD:AMDGPU:9:0:4",  "gfx904",  false, false },
+  { "AMD:AMDGPU:9:0:5",  "gfx904",  false, true  },
+  { "AMD:AMDGPU:9:0:6",  "gfx906",  false, false },
+  { "AMD:AMDGPU:9:0:7",  "gfx906",  false, true  },
+  { "AMD:AMDGPU:9:0:12", "gfx90c",  false, false },
+  { "AMD:AMDGPU:9:0:13", "gfx90c",  false, true  },
+  { "AMD:AMDGPU:10:0:0", "gfx1000", true,  false },
+  { "AMD:AMDGPU:10:1:0", "gfx1010", true,  false },
+  { "AMD:AMDGPU:10:1:1", "gfx1011", true,  false },
+  { "AMD:AMDGPU:10:1:2", "gfx1012", true,  false },
+  { "AMD:AMDGPU:10:3:0", "gfx1030", true,  false },
+  { "AMD:AMDGPU:10:3:1", "gfx1031", true,  false },
+  { "AMD:AMDGPU:10:3:2", "gfx1032", true,  false },
+  { "AMD:AMDGPU:10:3:3", "gfx1033", true,  false },
+  { "AMD:AMDGPU:10:3:4", "gfx1034", true,  false },
+  { "AMD:AMDGPU:10:3:5", "gfx1035", true,  false },
+  { "AMD:AMDGPU:10:3:6", "gfx1036", true,  false },
+  // Only known when the library is built with GFX11/12/40_BUILD.
+  { "AMD:AMDGPU:11:0:0", "gfx1100", true,  false },
+  { "AMD:AMDGPU:11:0:1", "gfx1101", true,  false },
+  { "AMD:AMDGPU:11:0:2", "gfx1102", true,  false },
+  { "AMD:AMDGPU:11:0:3", "gfx1103", true,  false },
+  { "AMD:AMDGPU:11:5:0", "gfx1150", true,  false },
+  { "AMD:AMDGPU:11:5:1", "gfx1151", true,  false },
+  { "AMD:AMDGPU:12:0:0", "gfx1200", true,  false },
+  { "AMD:AMDGPU:12:0:1", "gfx1201", true,  false },
+  { "AMD:AMDGPU:40:0:0", "gfx4000", true,  false },
+  { "AMD:AMDGPU:40:1:0", "gfx4010", true,  false },
+  { "AMD:AMDGPU:40:2:0", "gfx4020", true,  false },
+  { "AMD:AMDGPU:40:3:0", "gfx4030", true,  false },
+};
+
+// The name the original code returned, or "" where it failed.
+std::string ExpectedLegacyTarget(const LegacyName &legacy, bool is_finalizer, uint32_t e_flags)
+{
+  const TargetProcessor *p = FindTargetProcessor(legacy.processor, strlen(legacy.processor));
+  if (p == nullptr || (legacy.finalizer_only && !is_finalizer)) { return ""; }
+  std::string name = p->name;
+  if (p->sramecc_supported) { name += ":sramecc-"; }
+  const bool xnack_on = is_finalizer ? (e_flags & ELF::EF_AMDGPU_FEATURE_XNACK_V2) != 0 : legacy.xnack_on;
+  if (xnack_on) {
+    name += ":xnack+";
+  } else if (p->xnack_supported) {
+    name += ":xnack-";
+  }
+  return name;
+}
+
+void TestLegacyNames()
+{
+  std::set<std::string> known;
+  for (const LegacyName &legacy : kLegacyNames) {
+    known.insert(legacy.name);
+    for (bool is_finalizer : { false, true }) {
+      for (uint32_t e_flags : { 0u, uint32_t(ELF::EF_AMDGPU_FEATURE_XNACK_V2) }) {
+        const std::string expected = ExpectedLegacyTarget(legacy, is_finalizer, e_flags);
+        TargetId id = TargetId();
+        const bool parsed = ParseLegacyTargetName(legacy.name, is_finalizer, e_flags, &id);
+        LOADER_CHECK(parsed == !expected.empty());
+        if (parsed) { LOADER_CHECK(TargetIdToString(id) == expected); }
+      }
+    }
+    // ParseTargetId() accepts the finalizer-only names too, with xnack as
+    // implied by the name.
+    LegacyName any_producer = legacy;
+    any_producer.finalizer_only = false;
+    const std::string expected = ExpectedLegacyTarget(any_producer, false, 0);
+    TargetId id = TargetId();
+    LOADER_CHECK(ParseTargetId(legacy.name, &id) == !expected.empty());
+    if (!expected.empty()) { LOADER_CHECK(TargetIdToString(id) == expected); }
+  }
+
+  // Every other AMD:AMDGPU:M:m:s name is unknown.
+  for (int major = 0; major <= 45; ++major) {
+    for (int minor = 0; minor <= 6; ++minor) {
+      for (int stepping = 0; stepping <= 14; ++stepping) {
+        const std::string name = "AMD:AMDGPU:" + std::to_string(major) + ":" + std::to_string(minor) + ":" +
+                                 std::to_string(stepping);
+        if (known.count(name) != 0) { continue; }
+        TargetId id = TargetId();
+        LOADER_CHECK(!ParseLegacyTargetName(name, true, 0, &id));
+        LOADER_CHECK(!ParseLegacyTargetName(name, false, 0, &id));
+        LOADER_CHECK(!ParseTargetId(name.c_str(), &id));
+      }
+    }
+  }
+}
+
+void TestIsaFromName()
+{
+  OfflineLoaderContext context;
+
+  // Handles of the code object v2 names are fixed, one per name.
+  const struct { const char *name; uint64_t handle; } legacy_handles[] = {
+    { "AMD:AMDGPU:7:0:0", 700 },   { "AMD:AMDGPU:7:0:1", 701 },   { "AMD:AMDGPU:8:0:0", 800 },
+    { "AMD:AMDGPU:8:0:1", 801 },   { "AMD:AMDGPU:8:0:2", 802 },   { "AMD:AMDGPU:8:0:3", 803 },
+    { "AMD:AMDGPU:8:0:4", 804 },   { "AMD:AMDGPU:8:1:0", 810 },   { "AMD:AMDGPU:9:0:0", 900 },
+    { "AMD:AMDGPU:9:0:1", 901 },   { "AMD:AMDGPU:9:0:2", 902 },   { "AMD:AMDGPU:9:0:3", 903 },
+    { "AMD:AMDGPU:9:0:4", 904 },   { "AMD:AMDGPU:9:0:5", 905 },   { "AMD:AMDGPU:9:0:6", 906 },
+    { "AMD:AMDGPU:9:0:7", 907 },   { "AMD:AMDGPU:10:0:0", 1000 }, { "AMD:AMDGPU:10:0:1", 1001 },
+    { "AMD:AMDGPU:10:1:0", 1010 }, { "AMD:AMDGPU:10:1:1", 1011 }, { "AMD:AMDGPU:10:1:2", 1012 },
+    { "AMD:AMDGPU:10:3:0", 1030 }, { "AMD:AMDGPU:40:0:0", 4000 },
+  };
+  for (const auto &legacy : legacy_handles) {
+    LOADER_CHECK(context.IsaFromName(legacy.name).handle == legacy.handle);
+  }
+
+  // Target IDs get one nonzero handle per processor and feature setting, and
+  // never one of the legacy handles.
+  std::set<uint64_t> handles;
+  size_t count = 0;
+  const TargetProcessor *processors = TargetProcessors(&count);
+  size_t names = 0;
+  for (size_t i = 0; i < count; ++i) {
+    for (const char *sramecc : kFeatureSuffixes) {
+      for (const char *xnack : kFeatureSuffixes) {
+        if ((*sramecc && !processors[i].sramecc_supported) || (*xnack && !processors[i].xnack_supported)) {
+          continue;
+        }
+        std::string name = std::string("amdgcn-amd-amdhsa--") + processors[i].name;
+        if (*sramecc) { name += std::string(":sramecc") + sramecc; }
+        if (*xnack) { name += std::string(":xnack") + xnack; }
+        const uint64_t handle = context.IsaFromName(name.c_str()).handle;
+        LOADER_CHECK(handle > 4000);
+        LOADER_CHECK(context.IsaFromName(name.c_str()).handle == handle);
+        LOADER_CHECK(context.IsaFromName(name.c_str() + strlen("amdgcn-amd-amdhsa--")).handle == handle);
+        handles.insert(handle);
+        ++names;
+      }
+    }
+  }
+  LOADER_CHECK(handles.size() == names);
+
+  for (const char *name : { "", "gfx9000", "gfx900:xnack", "gfx700:xnack+", "AMD:AMDGPU:9:0:8",
+                            "AMD:AMDGPU:8:0:5", "amdgcn-amd-amdhsa--gfx906:xnack+:sramecc+" }) {
+    LOADER_CHECK(context.IsaFromName(name).handle == 0);
+  }
+}
+
+void TestCache()
+{
+  TargetIdCache cache;
+  size_t count = 0;
+  const TargetProcessor *processors = TargetProcessors(&count);
+
+  // More distinct names than the cache holds, each looked up repeatedly.
+  for (int round = 0; round < 3; ++round) {
+    for (size_t i = 0; i < count; ++i) {
+      const std::string name = std::string(processors[i].name) + (processors[i].xnack_supported ? ":xnack+" : "");
+      TargetId expected = TargetId(), id = TargetId();
+      LOADER_CHECK(ParseTargetId(name.c_str(), &expected));
+      LOADER_CHECK(cache.Find(name.c_str(), &id));
+      LOADER_CHECK(SameTargetId(id, expected));
+    }
+  }
+
+  // A failed parse, cached or not, yields a value-initialized ID.
+  for (int round = 0; round < 2; ++round) {
+    TargetId id = { &processors[0], TARGET_FEATURE_ON, TARGET_FEATURE_ON };
+    LOADER_CHECK(!cache.Find("gfx900:foo+", &id));
+    LOADER_CHECK(id.processor == nullptr && id.sramecc == 0 && id.xnack == 0);
+  }
+
+  // Names longer than an entry are parsed, not cached.
+  const std::string long_name = "amdgcn-amd-amdhsa--gfx906:sramecc+:xnack-" + std::string(40, 'x');
+  TargetId id = TargetId();
+  LOADER_CHECK(!cache.Find(long_name.c_str(), &id));
+
+  // Concurrent lookups of a mix of cached, new and invalid names.
+  TargetIdCache shared;
+  int thread_failures[4] = {};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < 20000; ++i) {
+        const TargetProcessor &p = processors[(i * 7 + t) % count];
+        const std::string name = (i % 5 == 0) ? std::string(p.name) + ":bad+" : std::string(p.name);
+        TargetId expected = TargetId(), found = TargetId();
+        const bool valid = ParseTargetId(name.c_str(), &expected);
+        if (shared.Find(name.c_str(), &found) != valid || !SameTargetId(found, expected)) {
+          ++thread_failures[t];
+        }
+      }
+    });
+  }
+  for (std::thread &thread : threads) { thread.join(); }
+  for (int failures_in_thread : thread_failures) { LOADER_CHECK(failures_in_thread == 0); }
+}
+
+} // namespace anonymous
+
+int main()
+{
+  TestProcessors();
+  TestLegacyNames();
+  TestIsaFromName();
+  TestCache();
+  if (failures != 0) {
+    fprintf(stderr, "target_test: %d checks failed\n", failures);
+    return 1;
+  }
+  printf("target_test: passed\n");
+  return 0;
+}
@@ -90,6 +90,7 @@ mes of its
 #include <memory>
 #include <sstream>
 #include <cassert>
+#include <functional>
 #include <unordered_map>
 
 namespace amd {
@@ -212,6 +213,15 @@ namespace code {
       hsa_status_t GetInfo(hsa_code_symbol_info_t attribute, void *value) override;
     };
 
+    /// @brief Runs the parts of AmdHsaCode::PrintParallel(). Spawn() may run
+    /// @p task on any thread; Wait() returns once every spawned task is done.
+    class PrintTaskRunner {
+    public:
+      virtual ~PrintTaskRunner() {}
+      virtual void Spawn(std::function<void()> task) = 0;
+      virtual void Wait() = 0;
+    };
+
     class AmdHsaCode {
     private:
       std::ostringstream out;
@@ -255,6 +265,10 @@ namespace code {
       void PrintSection(std::ostream& out, Section* section);
       void PrintRawData(std::ostream& out, Section* section);
       void PrintRawData(std::ostream& out, const unsigned char *data, size_t size);
+      // Prints the rows of PrintRawData() for bytes [begin, end) of @p data.
+      // @p begin must be a multiple of 16.
+      static void PrintRawData(std::ostream& out, const unsigned char *data, size_t size, size_t begin, size_t end);
+      static void PrintKernelCode(std::ostream& out, const std::string& name, const amd_kernel_code_t& kernel_code);
       void PrintRelocationData(std::ostream& out, RelocationSection* section);
       void PrintSymbol(std::ostream& out, Symbol* sym);
       void PrintDisassembly(std::ostream& out, const unsigned char *isa, size_t size, uint32_t isa_offset = 0);
@@ -295,6 +309,12 @@ namespace code {
       void PrintMachineCode(std::ostream& out);
       void PrintMachineCode(std::ostream& out, KernelSymbol* sym);
       bool PrintToFile(const std::string& filename);
+      // Prints the same text as Print(). The amd_kernel_code_t blocks and the
+      // machine code listing are split into up to @p max_parts parts that are
+      // rendered through @p runner from a private copy of the machine code
+      // section, then concatenated in order. The ELF image is only read by the
+      // calling thread.
+      void PrintParallel(std::ostream& out, PrintTaskRunner& runner, size_t max_parts);
 
       void AddNoteCodeObjectVersion(uint32_t major, uint32_t minor);
       bool GetNoteCodeObjectVersion(std::string& version);
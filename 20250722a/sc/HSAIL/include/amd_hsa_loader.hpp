@@ -49,8 +49,10 @@
 #include "hsa_ext_image.h"
 #include "hsa_ven_amd_loader.h"
 #include "amd_hsa_elf.h"
+#include <memory>
 #include <string>
 #include <mutex>
+#include <utility>
 #include <vector>
 
 #if defined(_WIN32) || defined(_WIN64)
@@ -441,6 +443,35 @@ private:
   static std::mutex executables_mutex;
 };
 
+/// @class SegmentSnapshot
+/// @brief Immutable list of the segment descriptors of all executables of a
+/// loader, in the order QuerySegmentDescriptors reports them.
+///
+/// The loader publishes a new snapshot with a higher generation whenever a code
+/// object is loaded or an executable is frozen or destroyed. Readers keep a
+/// reference for as long as they need the snapshot and never block loads.
+class SegmentSnapshot final {
+public:
+  SegmentSnapshot(uint64_t generation,
+                  std::vector<hsa_ven_amd_loader_segment_descriptor_t> &&descriptors)
+    : generation_(generation), descriptors_(std::move(descriptors)) {}
+
+  /// @returns Generation this snapshot was published with.
+  uint64_t Generation() const { return generation_; }
+
+  /// @returns Segment descriptors of all executables.
+  const std::vector<hsa_ven_amd_loader_segment_descriptor_t>& Descriptors() const {
+    return descriptors_;
+  }
+
+private:
+  SegmentSnapshot(const SegmentSnapshot&);
+  SegmentSnapshot& operator=(const SegmentSnapshot&);
+
+  const uint64_t generation_;
+  const std::vector<hsa_ven_amd_loader_segment_descriptor_t> descriptors_;
+};
+
 /// @class Loader
 class Loader {
 public:
@@ -488,6 +519,19 @@ public:
     hsa_ven_amd_loader_segment_descriptor_t *segment_descriptors,
     size_t *num_segment_descriptors) = 0;
 
+  /// @brief Returns the current segment snapshot without taking the loader
+  /// lock. Never null.
+  virtual std::shared_ptr<const SegmentSnapshot> GetSegmentSnapshot() const = 0;
+
+  /// @brief Returns the generation of the current segment snapshot.
+  virtual uint64_t SegmentGeneration() const = 0;
+
+  /// @returns True if segments were loaded, frozen or destroyed since
+  /// @p generation was observed.
+  bool SegmentsChangedSince(uint64_t generation) const {
+    return SegmentGeneration() != generation;
+  }
+
   /// @brief Finds the handle of executable to which @p device_address
   /// belongs. Return NULL handle if device address is invalid.
   virtual hsa_executable_t FindExecutable(uint64_t device_address) = 0;